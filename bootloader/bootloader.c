@@ -10,12 +10,12 @@
 //==============================================================================
 
 /*
- * Bootloader - Runs from SPRAM/ROM at 0x40000
+ * Bootloader - Runs from BRAM ROM at 0x80000
  *
  * Memory Layout:
- *   0x00000000 - 0x0003FFFF : Main firmware space (256KB)
- *   0x00040000 - 0x00041FFF : This bootloader (8KB ROM)
- *   0x00042000 - 0x0007FFFF : Heap/Stack (~248KB)
+ *   0x00000000 - 0x0007EFFF : Main firmware space (508KB)
+ *   0x0007F000 - 0x0007FFFF : Bootloader BSS/stack (4KB)
+ *   0x00080000 - 0x00081FFF : This bootloader (8KB ROM)
  *
  * Protocol (matches firmware_loader.v and fw_upload.c):
  *   1. PC sends "upload\r" to shell → shell starts firmware_loader
@@ -26,62 +26,30 @@
  *   6. Bootloader sends ACK + 4-byte calculated CRC
  *   7. Bootloader jumps to 0x0
  *
+ * Streaming mode (fw_upload --stream): the PC sends 'S' instead of 'R' and
+ * the whole image in step 4 without waiting for chunk ACKs. In a UART_FLOW=1
+ * bitstream the UART holds the PC off with RTS# when the 256-byte RX FIFO
+ * fills, so nothing is lost; the final ACK in step 6 is 'C'.
+ *
  * CRC32 is calculated over data only (not size bytes)
  */
 
 #include <stdint.h>
 
-// MMIO Addresses
-#define UART_TX_DATA   (*(volatile uint32_t *)0x80000000)
-#define UART_TX_STATUS (*(volatile uint32_t *)0x80000004)
-#define UART_RX_DATA   (*(volatile uint32_t *)0x80000008)
-#define UART_RX_STATUS (*(volatile uint32_t *)0x8000000C)
-#define LED_CONTROL    (*(volatile uint32_t *)0x80000010)
-#define BUTTON_STATUS  (*(volatile uint32_t *)0x80000018)
+// CRC32 from lib/crc32: only the const 1 KB byte table is linked (ROM)
+#include "crc32.h"
+
+// UART and LED drivers from lib/hal (inlined: nothing else is linked)
+#include "hal.h"
 
 // Target firmware location
 #define FIRMWARE_BASE  0x00000000
-#define MAX_FIRMWARE_SIZE (256 * 1024)  // 256KB max
+#define MAX_FIRMWARE_SIZE 0x0007F000     // 508KB, up to the bootloader's BSS/stack
 #define CHUNK_SIZE 64  // Match fw_upload.c
 
 // External assembly function
 extern void jump_to_firmware(uint32_t addr);
 
-//=============================================================================
-// UART Functions
-//=============================================================================
-
-static void uart_putc(uint8_t c) {
-    while (UART_TX_STATUS & 1);  // Wait while busy
-    UART_TX_DATA = c;
-}
-
-static uint8_t uart_getc(void) {
-    while (!(UART_RX_STATUS & 1));  // Wait until data available
-    return UART_RX_DATA & 0xFF;
-}
-
-//=============================================================================
-// CRC32 Calculation (matches firmware_loader.v and fw_upload.c)
-//=============================================================================
-
-static uint32_t crc32_table[256];
-
-static void crc32_init(void) {
-    for (uint32_t i = 0; i < 256; i++) {
-        uint32_t crc = i;
-        for (int j = 0; j < 8; j++) {
-            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
-        }
-        crc32_table[i] = crc;
-    }
-}
-
-// Calculate CRC32 incrementally (for on-the-fly calculation)
-static uint32_t crc32_update(uint32_t crc, uint8_t byte) {
-    return (crc >> 8) ^ crc32_table[(crc ^ byte) & 0xFF];
-}
-
 //=============================================================================
 // Main Bootloader - Implements firmware_loader.v protocol
 //=============================================================================
@@ -91,22 +59,23 @@ void bootloader_main(void) {
     uint32_t packet_size = 0;
     uint32_t bytes_received = 0;
     uint32_t expected_crc;
-    uint32_t calculated_crc = 0xFFFFFFFF;  // CRC32 initial value
+    uint32_t calculated_crc = crc32_init();
     uint8_t ack_char = 'A';  // Starting ACK character
-    uint8_t chunk_count = 0;
-
-    // Initialize CRC32 lookup table
-    crc32_init();
+    uint8_t stream = 0;      // 1 = no per-chunk ACKs (RTS/CTS paced)
 
     // LED pattern: LED1 on = waiting for upload
-    LED_CONTROL = 0x01;
+    led_set(LED1);
 
-    // Step 1: Wait for 'R' (Ready) command
+    // Step 1: Wait for 'R' (Ready) or 'S' (Stream) command
     while (1) {
         uint8_t cmd = uart_getc();
         if (cmd == 'R' || cmd == 'r') {
             break;
         }
+        if (cmd == 'S' || cmd == 's') {
+            stream = 1;
+            break;
+        }
     }
 
     // Step 2: Send ACK 'A' for Ready
@@ -114,7 +83,7 @@ void bootloader_main(void) {
     ack_char = 'B';  // Next ACK will be 'B'
 
     // LED pattern: LED2 on = downloading
-    LED_CONTROL = 0x02;
+    led_set(LED2);
 
     // Step 3: Receive 4-byte packet size (little-endian)
     for (int i = 0; i < 4; i++) {
@@ -128,7 +97,7 @@ void bootloader_main(void) {
 
     // Validate size
     if (packet_size == 0 || packet_size > MAX_FIRMWARE_SIZE) {
-        LED_CONTROL = 0x00;  // Turn off LEDs = error
+        led_set(0);  // Turn off LEDs = error
         while (1);  // Halt on error
     }
 
@@ -142,32 +111,34 @@ void bootloader_main(void) {
             firmware[bytes_received] = byte;
 
             // Update CRC32 incrementally
-            calculated_crc = crc32_update(calculated_crc, byte);
+            calculated_crc = crc32_update_u8(calculated_crc, byte);
 
             bytes_received++;
             chunk_bytes++;
         }
 
         // Send ACK after each chunk (C, D, E, ... Z, then wrap to A)
-        uart_putc(ack_char);
-        ack_char++;
-        if (ack_char > 'Z') ack_char = 'A';  // Wrap around
+        if (!stream) {
+            uart_putc(ack_char);
+            ack_char++;
+            if (ack_char > 'Z') ack_char = 'A';  // Wrap around
+        }
 
         // Toggle LED1 to show progress
         if ((bytes_received / CHUNK_SIZE) & 1) {
-            LED_CONTROL = 0x03;  // Both LEDs
+            led_set(LED1 | LED2);  // Both LEDs
         } else {
-            LED_CONTROL = 0x02;  // LED2 only
+            led_set(LED2);  // LED2 only
         }
     }
 
     // Finalize CRC32
-    calculated_crc = ~calculated_crc;
+    calculated_crc = crc32_final(calculated_crc);
 
     // Step 6: Wait for 'C' (CRC command)
     uint8_t crc_cmd = uart_getc();
     if (crc_cmd != 'C') {
-        LED_CONTROL = 0x00;  // Error
+        led_set(0);  // Error
         while (1);
     }
 
@@ -189,12 +160,12 @@ void bootloader_main(void) {
 
     // Step 9: Verify CRC match
     if (calculated_crc != expected_crc) {
-        LED_CONTROL = 0x00;  // Error - CRC mismatch
+        led_set(0);  // Error - CRC mismatch
         while (1);  // Halt on CRC error
     }
 
     // Success! Turn off LEDs before jumping
-    LED_CONTROL = 0x00;
+    led_set(0);
 
     // Step 10: Jump to firmware at 0x0
     jump_to_firmware(FIRMWARE_BASE);
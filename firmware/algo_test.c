@@ -10,30 +10,48 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdarg.h>
+
+#include "bench.h"
+#include "crc32.h"
+
+// Batch mode repetitions per test (make BATCH_REPS=n)
+#ifndef BATCH_REPS
+#define BATCH_REPS 3
+#endif
 
 // UART direct access
-#define UART_RX_DATA   (*(volatile unsigned int*)0x80000008)
-#define UART_RX_STATUS (*(volatile unsigned int*)0x8000000C)
+#include "hal.h"
 
 static int getch(void) {
-    while (!(UART_RX_STATUS & 0x01));
-    return UART_RX_DATA & 0xFF;
+    return uart_getc();
+}
+
+// Test output, silenced while the batch runner times a test
+__attribute__((format(printf, 1, 2)))
+static void tprintf(const char *fmt, ...) {
+    va_list ap;
+
+    if (bench_quiet) return;
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
 }
 
 //==============================================================================
 // Prime Number Generation (Sieve of Eratosthenes)
 //==============================================================================
 
-static void test_prime_sieve(void) {
-    printf("\r\n=== Prime Number Sieve ===\r\n");
-    printf("Finding all primes up to 100,000 (~20 seconds)...\r\n");
+static int test_prime_sieve(void) {
+    tprintf("\r\n=== Prime Number Sieve ===\r\n");
+    tprintf("Finding all primes up to 100,000 (~20 seconds)...\r\n");
     fflush(stdout);
 
     const int limit = 100000;
     unsigned char *sieve = malloc(limit + 1);
     if (!sieve) {
-        printf("FAIL: malloc failed\r\n");
-        return;
+        tprintf("FAIL: malloc failed\r\n");
+        return 0;
     }
 
     // Initialize sieve
@@ -49,7 +67,7 @@ static void test_prime_sieve(void) {
         }
 
         if (p % 1000 == 0) {
-            printf("  Processing p=%d...\r\n", p);
+            tprintf("  Processing p=%d...\r\n", p);
             fflush(stdout);
         }
     }
@@ -60,31 +78,32 @@ static void test_prime_sieve(void) {
         if (sieve[i]) count++;
     }
 
-    printf("\r\nPrimes found: %d\r\n", count);
-    printf("Expected: 9592\r\n");
-    printf("%s\r\n", (count == 9592) ? "PASS" : "FAIL");
+    tprintf("\r\nPrimes found: %d\r\n", count);
+    tprintf("Expected: 9592\r\n");
+    tprintf("%s\r\n", (count == 9592) ? "PASS" : "FAIL");
 
     // Show first 20 primes
-    printf("First 20 primes: ");
+    tprintf("First 20 primes: ");
     int shown = 0;
     for (int i = 0; i <= limit && shown < 20; i++) {
         if (sieve[i]) {
-            printf("%d ", i);
+            tprintf("%d ", i);
             shown++;
         }
     }
-    printf("\r\n");
+    tprintf("\r\n");
 
     free(sieve);
+    return count == 9592;
 }
 
 //==============================================================================
 // Fibonacci Numbers (Iterative with modulo to prevent overflow)
 //==============================================================================
 
-static void test_fibonacci(void) {
-    printf("\r\n=== Fibonacci Sequence ===\r\n");
-    printf("Computing first 10,000 Fibonacci numbers (mod 1000000)...\r\n");
+static int test_fibonacci(void) {
+    tprintf("\r\n=== Fibonacci Sequence ===\r\n");
+    tprintf("Computing first 10,000 Fibonacci numbers (mod 1000000)...\r\n");
     fflush(stdout);
 
     const int count = 10000;
@@ -97,14 +116,15 @@ static void test_fibonacci(void) {
         fib_curr = fib_next;
 
         if (i % 1000 == 0) {
-            printf("  n=%d, fib=%u\r\n", i, fib_curr);
+            tprintf("  n=%d, fib=%u\r\n", i, fib_curr);
             fflush(stdout);
         }
     }
 
-    printf("\r\nF(10000) mod 1000000 = %u\r\n", fib_curr);
-    printf("Expected: 366875 (verified locally)\r\n");
-    printf("%s\r\n", (fib_curr == 366875) ? "PASS" : "FAIL");
+    tprintf("\r\nF(10000) mod 1000000 = %u\r\n", fib_curr);
+    tprintf("Expected: 366875 (verified locally)\r\n");
+    tprintf("%s\r\n", (fib_curr == 366875) ? "PASS" : "FAIL");
+    return fib_curr == 366875;
 }
 
 //==============================================================================
@@ -138,16 +158,16 @@ static void quicksort(int *arr, int low, int high) {
     }
 }
 
-static void test_sorting(void) {
-    printf("\r\n=== QuickSort Test ===\r\n");
-    printf("Sorting 20,000 random numbers (~10 seconds)...\r\n");
+static int test_sorting(void) {
+    tprintf("\r\n=== QuickSort Test ===\r\n");
+    tprintf("Sorting 20,000 random numbers (~10 seconds)...\r\n");
     fflush(stdout);
 
     const int count = 20000;  // Reduced from 50K to fit in 240KB heap
     int *arr = malloc(count * sizeof(int));
     if (!arr) {
-        printf("FAIL: malloc failed\r\n");
-        return;
+        tprintf("FAIL: malloc failed\r\n");
+        return 0;
     }
 
     // Generate pseudo-random data
@@ -157,13 +177,13 @@ static void test_sorting(void) {
         arr[i] = (int)(seed % 100000);
     }
 
-    printf("Generated %d random numbers\r\n", count);
-    printf("First 10: ");
-    for (int i = 0; i < 10; i++) printf("%d ", arr[i]);
-    printf("\r\n");
+    tprintf("Generated %d random numbers\r\n", count);
+    tprintf("First 10: ");
+    for (int i = 0; i < 10; i++) tprintf("%d ", arr[i]);
+    tprintf("\r\n");
 
     // Sort
-    printf("Sorting...\r\n");
+    tprintf("Sorting...\r\n");
     fflush(stdout);
     quicksort(arr, 0, count - 1);
 
@@ -172,90 +192,110 @@ static void test_sorting(void) {
     for (int i = 1; i < count; i++) {
         if (arr[i] < arr[i-1]) {
             sorted = 0;
-            printf("FAIL: Not sorted at index %d (%d < %d)\r\n",
+            tprintf("FAIL: Not sorted at index %d (%d < %d)\r\n",
                    i, arr[i], arr[i-1]);
             break;
         }
     }
 
-    printf("Sorted first 10: ");
-    for (int i = 0; i < 10; i++) printf("%d ", arr[i]);
-    printf("\r\n");
-    printf("Sorted last 10: ");
-    for (int i = count - 10; i < count; i++) printf("%d ", arr[i]);
-    printf("\r\n");
+    tprintf("Sorted first 10: ");
+    for (int i = 0; i < 10; i++) tprintf("%d ", arr[i]);
+    tprintf("\r\n");
+    tprintf("Sorted last 10: ");
+    for (int i = count - 10; i < count; i++) tprintf("%d ", arr[i]);
+    tprintf("\r\n");
 
-    printf("%s\r\n", sorted ? "PASS" : "FAIL");
+    tprintf("%s\r\n", sorted ? "PASS" : "FAIL");
     free(arr);
+    return sorted;
 }
 
 //==============================================================================
-// CRC32 Checksum (Standard polynomial)
+// CRC32 Checksum (Standard polynomial, lib/crc32)
 //==============================================================================
 
-static unsigned int crc32_table[256];
+#define CRC32_DATA_SIZE (100 * 1024)
 
-static void crc32_init(void) {
-    for (unsigned int i = 0; i < 256; i++) {
-        unsigned int crc = i;
-        for (int j = 0; j < 8; j++) {
-            crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
-        }
-        crc32_table[i] = crc;
-    }
-}
+// 100KB pseudo-random test block (same pattern as lib/crc32/crc32_test.c)
+static unsigned char *crc32_test_data(void) {
+    unsigned char *data = malloc(CRC32_DATA_SIZE);
+    if (!data) return NULL;
 
-static unsigned int crc32(const unsigned char *data, size_t len) {
-    unsigned int crc = 0xFFFFFFFF;
-    for (size_t i = 0; i < len; i++) {
-        crc = (crc >> 8) ^ crc32_table[(crc ^ data[i]) & 0xFF];
+    unsigned int seed = 0x12345678;
+    for (size_t i = 0; i < CRC32_DATA_SIZE; i++) {
+        seed = seed * 1664525 + 1013904223;
+        data[i] = (unsigned char)(seed & 0xFF);
     }
-    return ~crc;
+    return data;
 }
 
-static void test_crc32(void) {
-    printf("\r\n=== CRC32 Checksum Test ===\r\n");
-    printf("Computing CRC32 of large data block...\r\n");
+static int test_crc32(void) {
+    tprintf("\r\n=== CRC32 Checksum Test ===\r\n");
+    tprintf("Computing CRC32 of large data block...\r\n");
     fflush(stdout);
 
-    crc32_init();
-
-    // Allocate 100KB test data
-    const size_t data_size = 100 * 1024;
-    unsigned char *data = malloc(data_size);
+    const size_t data_size = CRC32_DATA_SIZE;
+    unsigned char *data = crc32_test_data();
     if (!data) {
-        printf("FAIL: malloc failed\r\n");
-        return;
-    }
-
-    // Fill with pattern
-    unsigned int seed = 0x12345678;
-    for (size_t i = 0; i < data_size; i++) {
-        seed = seed * 1664525 + 1013904223;
-        data[i] = (unsigned char)(seed & 0xFF);
+        tprintf("FAIL: malloc failed\r\n");
+        return 0;
     }
 
     // Compute CRC32
-    printf("Computing CRC32 of %u bytes...\r\n", (unsigned int)data_size);
+    tprintf("Computing CRC32 of %u bytes...\r\n", (unsigned int)data_size);
     fflush(stdout);
     unsigned int crc = crc32(data, data_size);
 
-    printf("CRC32: 0x%08X\r\n", crc);
+    tprintf("CRC32: 0x%08X\r\n", crc);
 
     // Known good CRC for this seed/pattern (verified locally)
-    printf("Expected: 0xA9C0AAD0\r\n");
-    printf("%s\r\n", (crc == 0xA9C0AAD0) ? "PASS" : "FAIL");
+    tprintf("Expected: 0xA9C0AAD0\r\n");
+    tprintf("%s\r\n", (crc == 0xA9C0AAD0) ? "PASS" : "FAIL");
+
+    free(data);
+    return crc == 0xA9C0AAD0;
+}
+
+// Every lib/crc32 backend on the same block: result and bytes per cycle
+static int test_crc32_backends(void) {
+    int pass = 1;
+
+    printf("\r\n=== CRC32 Backends (%u bytes) ===\r\n", (unsigned int)CRC32_DATA_SIZE);
+    unsigned char *data = crc32_test_data();
+    if (!data) {
+        printf("FAIL: malloc failed\r\n");
+        return 0;
+    }
+
+    bench_timer_init();
+    printf("%-8s %8s %10s %11s %10s\r\n", "backend", "table", "CRC32", "cycles", "bytes/cyc");
+    for (int i = 0; i < crc32_num_backends; i++) {
+        const crc32_backend_t *b = &crc32_backends[i];
+
+        uint64_t t0 = bench_cycles();
+        uint32_t crc = crc32_final(b->update(crc32_init(), data, CRC32_DATA_SIZE));
+        uint32_t cycles = (uint32_t)(bench_cycles() - t0);
+
+        int ok = crc == 0xA9C0AAD0;
+        pass &= ok;
+        printf("%-8s %6u B 0x%08X %11lu %10.4f %s\r\n", b->name, (unsigned int)b->table_bytes,
+               (unsigned int)crc, (unsigned long)cycles,
+               cycles ? (double)CRC32_DATA_SIZE / cycles : 0.0, ok ? "" : "FAIL");
+    }
+    printf("crc32() uses slice8 on this target\r\n");
+    printf("%s\r\n", pass ? "PASS" : "FAIL");
 
     free(data);
+    return pass;
 }
 
 //==============================================================================
 // Matrix Multiplication (floating point)
 //==============================================================================
 
-static void test_matrix_multiply(void) {
-    printf("\r\n=== Matrix Multiplication Test ===\r\n");
-    printf("Multiplying two 50x50 matrices (~5 seconds)...\r\n");
+static int test_matrix_multiply(void) {
+    tprintf("\r\n=== Matrix Multiplication Test ===\r\n");
+    tprintf("Multiplying two 50x50 matrices (~5 seconds)...\r\n");
     fflush(stdout);
 
     const int N = 50;  // Reduced from 100 to fit in 240KB heap (3*50*50*8 = 60KB)
@@ -266,9 +306,9 @@ static void test_matrix_multiply(void) {
     double *C = malloc(N * N * sizeof(double));
 
     if (!A || !B || !C) {
-        printf("FAIL: malloc failed\r\n");
+        tprintf("FAIL: malloc failed\r\n");
         free(A); free(B); free(C);
-        return;
+        return 0;
     }
 
     // Initialize A and B with better pattern
@@ -278,7 +318,7 @@ static void test_matrix_multiply(void) {
     }
 
     // Matrix multiply: C = A * B
-    printf("Computing C = A * B...\r\n");
+    tprintf("Computing C = A * B...\r\n");
     fflush(stdout);
 
     for (int i = 0; i < N; i++) {
@@ -291,7 +331,7 @@ static void test_matrix_multiply(void) {
         }
 
         if ((i + 1) % 10 == 0) {
-            printf("  Row %d/%d complete\r\n", i + 1, N);
+            tprintf("  Row %d/%d complete\r\n", i + 1, N);
             fflush(stdout);
         }
     }
@@ -302,26 +342,29 @@ static void test_matrix_multiply(void) {
     // B[0,50,100,...] = B[k*50] = 1,1,1,1,1,... (all 1s because (k*50*7)%10 = 0, +1 = 1)
     // So C[0][0] = (1+2+3+4+5+6+7+8+9+10)*5*1 = 55*5 = 275
     double expected_c00 = 275.0;  // Verified locally for N=50
-    printf("\r\nC[0][0] = %.1f\r\n", C[0]);
-    printf("Expected: %.1f\r\n", expected_c00);
-    printf("%s\r\n", (fabs(C[0] - expected_c00) < 0.1) ? "PASS" : "FAIL");
+    tprintf("\r\nC[0][0] = %.1f\r\n", C[0]);
+    tprintf("Expected: %.1f\r\n", expected_c00);
+    int pass = fabs(C[0] - expected_c00) < 0.1;
+    tprintf("%s\r\n", pass ? "PASS" : "FAIL");
 
     free(A);
     free(B);
     free(C);
+    return pass;
 }
 
 //==============================================================================
 // Stress Test - Combined Algorithms
 //==============================================================================
 
-static void test_combined_stress(void) {
-    printf("\r\n=== Combined Algorithm Stress Test (30 seconds) ===\r\n");
-    printf("Running multiple algorithms in sequence...\r\n");
+static int test_combined_stress(void) {
+    tprintf("\r\n=== Combined Algorithm Stress Test (30 seconds) ===\r\n");
+    tprintf("Running multiple algorithms in sequence...\r\n");
     fflush(stdout);
+    int pass = 1;
 
     // Quick prime check
-    printf("\n1. Quick prime sieve (10,000)...\r\n");
+    tprintf("\n1. Quick prime sieve (10,000)...\r\n");
     const int limit = 10000;
     unsigned char *sieve = malloc(limit + 1);
     if (sieve) {
@@ -333,13 +376,16 @@ static void test_combined_stress(void) {
         }
         int count = 0;
         for (int i = 2; i <= limit; i++) if (sieve[i]) count++;
-        printf("   Found %d primes (expected 1229): %s\r\n", count,
+        tprintf("   Found %d primes (expected 1229): %s\r\n", count,
                (count == 1229) ? "PASS" : "FAIL");
+        pass &= (count == 1229);
         free(sieve);
+    } else {
+        pass = 0;
     }
 
     // Quick sort
-    printf("\n2. Sorting 10,000 numbers...\r\n");
+    tprintf("\n2. Sorting 10,000 numbers...\r\n");
     int *arr = malloc(10000 * sizeof(int));
     if (arr) {
         unsigned int seed = 42;
@@ -352,20 +398,42 @@ static void test_combined_stress(void) {
         for (int i = 1; i < 10000; i++) {
             if (arr[i] < arr[i-1]) { sorted = 0; break; }
         }
-        printf("   %s\r\n", sorted ? "PASS" : "FAIL");
+        tprintf("   %s\r\n", sorted ? "PASS" : "FAIL");
+        pass &= sorted;
         free(arr);
+    } else {
+        pass = 0;
     }
 
     // Math computations
-    printf("\n3. Math computations (10,000 iterations)...\r\n");
+    tprintf("\n3. Math computations (10,000 iterations)...\r\n");
     double sum = 0.0;
     for (int i = 1; i <= 10000; i++) {
         double x = (double)i / 100.0;
         sum += sin(x) + cos(x) + sqrt(x) + log(x);
     }
-    printf("   Sum = %.6f (computed)\r\n", sum);
+    tprintf("   Sum = %.6f (computed)\r\n", sum);
+
+    tprintf("\r\nCombined stress test complete!\r\n");
+    return pass;
+}
 
-    printf("\r\nCombined stress test complete!\r\n");
+//==============================================================================
+// Batch Mode - every test with fixed seeds, timed in CPU cycles
+//==============================================================================
+
+static const bench_case_t batch_cases[] = {
+    { "sieve",     test_prime_sieve,     100000, 100001 },
+    { "fibonacci", test_fibonacci,       10000,  0      },
+    { "quicksort", test_sorting,         20000,  80000  },
+    { "crc32",     test_crc32,           102400, 102400 },
+    { "matmul",    test_matrix_multiply, 125000, 60000  },
+    { "combined",  test_combined_stress, 10000,  0      },
+};
+
+static void run_batch(void) {
+    bench_run_cases("algo", batch_cases, sizeof(batch_cases) / sizeof(batch_cases[0]), BATCH_REPS);
+    bench_done();
 }
 
 //==============================================================================
@@ -381,9 +449,11 @@ static void show_menu(void) {
     printf("2. Fibonacci sequence\r\n");
     printf("3. QuickSort test (~10s)\r\n");
     printf("4. CRC32 checksum\r\n");
+    printf("c. CRC32 backends (bytes/cycle)\r\n");
     printf("5. Matrix multiply (~5s)\r\n");
     printf("6. Combined stress test (~30s)\r\n");
     printf("7. Run all tests\r\n");
+    printf("b. Batch benchmark (CSV/JSON, %d repetitions)\r\n", BATCH_REPS);
     printf("h. Show this menu\r\n");
     printf("q. Quit\r\n");
     printf("========================================\r\n");
@@ -398,6 +468,15 @@ int main(void) {
     printf("  Known results, 20-30s runtime\r\n");
     printf("========================================\r\n");
     printf("\r\n");
+
+#ifdef BATCH_MODE
+    // BATCH=1 build: no terminal needed
+    run_batch();
+    while (1) {
+        __asm__ volatile ("wfi");
+    }
+#endif
+
     printf("Press any key to start...\r\n");
 
     getch();
@@ -433,6 +512,12 @@ int main(void) {
                 show_menu();
                 break;
 
+            case 'c':
+            case 'C':
+                test_crc32_backends();
+                show_menu();
+                break;
+
             case '5':
                 test_matrix_multiply();
                 show_menu();
@@ -457,6 +542,12 @@ int main(void) {
                 show_menu();
                 break;
 
+            case 'b':
+            case 'B':
+                run_batch();
+                show_menu();
+                break;
+
             case 'h':
             case 'H':
                 show_menu();
@@ -0,0 +1,40 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// app_image.h - Resident Application Image Header
+//
+// APP=1 builds (app.ld) start with this header instead of the reset/IRQ
+// vectors. The image is linked at 0 with its relocations kept; fw_upload
+// --base relocates it for the address the launcher loads it at, header
+// words included, so every field below is an absolute address.
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#ifndef APP_IMAGE_H
+#define APP_IMAGE_H
+
+#define APP_MAGIC       0x50504152  // "RAPP"
+#define APP_NAME_LEN    24          // Target name, NUL-padded
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t magic;                 // APP_MAGIC
+    uint32_t base;                  // Address the image was relocated for
+    uint32_t entry;                 // _start, called as int (*)(void)
+    uint32_t irq;                   // irq_handler(irqs, pc, fp) of the app
+    uint32_t data_start;            // .data, restored before every run
+    uint32_t data_end;
+    uint32_t end;                   // End of .bss, heap and stack
+    char     name[APP_NAME_LEN];
+} app_header_t;
+
+#endif // __ASSEMBLER__
+
+#endif // APP_IMAGE_H
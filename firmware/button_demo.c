@@ -15,62 +15,25 @@
  * Features: Button-controlled LEDs, button state display, debouncing
  */
 
-#define UART_TX_DATA   (*(volatile unsigned int *)0x80000000)
-#define UART_TX_STATUS (*(volatile unsigned int *)0x80000004)
-#define UART_RX_DATA   (*(volatile unsigned int *)0x80000008)
-#define UART_RX_STATUS (*(volatile unsigned int *)0x8000000C)
-#define LED_CONTROL    (*(volatile unsigned int *)0x80000010)
-#define MODE_CONTROL   (*(volatile unsigned int *)0x80000014)
-#define BUTTON_INPUT   (*(volatile unsigned int *)0x80000018)
-
-// Button bits (active-high after synchronization)
-#define BUT1_MASK      0x01
-#define BUT2_MASK      0x02
-
-// UART functions
-void putc(char c) {
-    while (UART_TX_STATUS & 1);  // Wait while busy
-    UART_TX_DATA = c;
-}
+#include "hal.h"
 
+// Console output with "\n" -> "\r\n"
 void puts(const char *s) {
     while (*s) {
-        if (*s == '\n') putc('\r');
-        putc(*s++);
+        if (*s == '\n') uart_putc('\r');
+        uart_putc(*s++);
     }
 }
 
-int getc_available(void) {
-    return UART_RX_STATUS & 1;
-}
-
 char getc_nonblocking(void) {
-    if (getc_available())
+    if (uart_getc_available())
         return UART_RX_DATA & 0xFF;
     return 0;
 }
 
 // LED functions
 void set_leds(int led1, int led2) {
-    LED_CONTROL = (led2 << 1) | led1;
-}
-
-// Button functions
-unsigned int read_buttons(void) {
-    return BUTTON_INPUT & 0x03;  // Bits [1:0]
-}
-
-int button1_pressed(void) {
-    return (BUTTON_INPUT & BUT1_MASK) ? 1 : 0;
-}
-
-int button2_pressed(void) {
-    return (BUTTON_INPUT & BUT2_MASK) ? 1 : 0;
-}
-
-// Mode switching
-void switch_to_shell(void) {
-    MODE_CONTROL = 0;  // 0 = Shell mode
+    led_set((led2 << 1) | led1);
 }
 
 // Simple delay
@@ -81,7 +44,7 @@ void delay(unsigned int count) {
 // Print hex digit
 void print_hex_digit(unsigned int value) {
     char hex[] = "0123456789ABCDEF";
-    putc(hex[value & 0xF]);
+    uart_putc(hex[value & 0xF]);
 }
 
 // Print 8-bit hex value
@@ -99,7 +62,6 @@ void print_hex32(unsigned int value) {
 
 int main(void) {
     unsigned int btn_prev = 0;  // Previous button state for edge detection
-    unsigned int counter = 0;
     int mode = 0;  // 0=direct, 1=toggle, 2=count
 
     puts("\n");
@@ -121,7 +83,7 @@ int main(void) {
 
     while (1) {
         // Read current button state
-        unsigned int btn_now = read_buttons();
+        unsigned int btn_now = button_read();
 
         // Detect button edges (press = 0->1 transition)
         unsigned int btn_press = btn_now & ~btn_prev;
@@ -173,14 +135,14 @@ int main(void) {
         char c = getc_nonblocking();
 
         if (c) {
-            putc(c);  // Echo
-            putc('\r');
-            putc('\n');
+            uart_putc(c);  // Echo
+            uart_putc('\r');
+            uart_putc('\n');
 
             if (c == 's' || c == 'S') {
                 puts("Switching to SHELL mode...\n");
                 delay(100000);
-                switch_to_shell();
+                mode_set(0);  // 0 = Shell mode
                 puts("ERROR: Still in APP mode!\n");
             }
             else if (c == '0') {
@@ -197,13 +159,13 @@ int main(void) {
                 puts("Mode: Counter (count button presses)\n");
             }
             else if (c == 'b' || c == 'B') {
-                unsigned int btn = read_buttons();
+                unsigned int btn = button_read();
                 puts("Button State: 0x");
                 print_hex8(btn);
                 puts(" (BUT1=");
-                putc((btn & BUT1_MASK) ? '1' : '0');
+                uart_putc((btn & BUT1_MASK) ? '1' : '0');
                 puts(", BUT2=");
-                putc((btn & BUT2_MASK) ? '1' : '0');
+                uart_putc((btn & BUT2_MASK) ? '1' : '0');
                 puts(")\n");
             }
             else {
@@ -9,53 +9,63 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
 
-// UART direct access for menu (no echo, no buffering)
-#define UART_RX_DATA   (*(volatile unsigned int*)0x80000008)
-#define UART_RX_STATUS (*(volatile unsigned int*)0x8000000C)
+#include "bench.h"
+#include "memstat.h"
 
-// Timer peripheral registers (MMIO)
-#define TIMER_CR   (*(volatile unsigned int*)0x80000020)  // Control register
-#define TIMER_SR   (*(volatile unsigned int*)0x80000024)  // Status register
-#define TIMER_PSC  (*(volatile unsigned int*)0x80000028)  // Prescaler
-#define TIMER_ARR  (*(volatile unsigned int*)0x8000002C)  // Auto-reload register
-#define TIMER_CNT  (*(volatile unsigned int*)0x80000030)  // Counter
+// Batch mode repetitions per test (make BATCH_REPS=n)
+#ifndef BATCH_REPS
+#define BATCH_REPS 3
+#endif
 
-// Heap symbols from linker script
+// UART (menu input: no echo, no buffering), timer, IRQ mask and SRAM BIST
+#include "hal.h"
+
+// Heap and stack symbols from linker script
 extern char __heap_start;
 extern char __heap_end;
+extern char __stack_bottom;
+extern char __stack_top;
+
+// Large allocation test: more than the old 256KB APPSRAM region, so the
+// block has to run through 0x40000-0x41FFF (where the boot ROM used to be)
+#define LARGE_ALLOC_SIZE (320 * 1024)
+#define OLD_ROM_START    0x00040000u
+#define OLD_ROM_END      0x00042000u
 
 // Throughput measurement globals
 static volatile unsigned int bytes_processed = 0;
 static volatile unsigned int seconds_elapsed = 0;
 static volatile unsigned int new_second = 0;  // Flag: new second ready to display
+static volatile unsigned int pattern_sink;    // Read tests accumulate here
 
 // Direct UART getch - no echo, no buffering
 static int getch(void) {
-    while (!(UART_RX_STATUS & 0x01));
-    return UART_RX_DATA & 0xFF;
-}
-
-// Enable CPU interrupts (clear IRQ mask - all interrupts enabled)
-static inline void irq_enable(void) {
-    unsigned int dummy;
-    __asm__ volatile (".insn r 0x0B, 6, 3, %0, %1, x0" : "=r"(dummy) : "r"(0));
-}
-
-// Disable CPU interrupts (set IRQ mask to all 1s - all interrupts masked)
-static inline void irq_disable(void) {
-    unsigned int dummy;
-    __asm__ volatile (".insn r 0x0B, 6, 3, %0, %1, x0" : "=r"(dummy) : "r"(0xFFFFFFFF));
+    return uart_getc();
 }
 
 // IRQ handler - called at 1 Hz (every 1 second)
 // ABSOLUTE MINIMUM - just clear interrupt and set flag
 // Do NOT do any math, increment, or processing here!
-void irq_handler(void) {
-    TIMER_SR = 0x00000001;  // Clear timer interrupt flag (required)
+// (lib/memstat's stack guard check is a bounded scan of its band)
+void irq_handler(unsigned int irqs, unsigned int pc) {
+    memstat_guard_irq(irqs, pc);
+    timer_clear_irq();       // Clear timer interrupt flag (required)
     new_second = 1;          // Signal main loop (single store)
 }
 
+// Test output, silenced while the batch runner times a test
+__attribute__((format(printf, 1, 2)))
+static void tprintf(const char *fmt, ...) {
+    va_list ap;
+
+    if (bench_quiet) return;
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+}
+
 //==============================================================================
 // Memory Test Patterns
 //==============================================================================
@@ -64,7 +74,7 @@ static int test_pattern_walking_ones(void *ptr, size_t size) {
     unsigned int *data = (unsigned int*)ptr;
     size_t words = size / sizeof(unsigned int);
 
-    printf("  Walking ones pattern...\r\n");
+    tprintf("  Walking ones pattern...\r\n");
 
     // Write walking ones
     for (size_t i = 0; i < words; i++) {
@@ -74,7 +84,7 @@ static int test_pattern_walking_ones(void *ptr, size_t size) {
     // Verify
     for (size_t i = 0; i < words; i++) {
         if (data[i] != (1U << (i % 32))) {
-            printf("  FAIL at offset %u: expected 0x%08X, got 0x%08X\r\n",
+            tprintf("  FAIL at offset %u: expected 0x%08X, got 0x%08X\r\n",
                    (unsigned int)i * 4, 1U << (i % 32), data[i]);
             return 0;
         }
@@ -87,7 +97,7 @@ static int test_pattern_walking_zeros(void *ptr, size_t size) {
     unsigned int *data = (unsigned int*)ptr;
     size_t words = size / sizeof(unsigned int);
 
-    printf("  Walking zeros pattern...\r\n");
+    tprintf("  Walking zeros pattern...\r\n");
 
     // Write walking zeros
     for (size_t i = 0; i < words; i++) {
@@ -97,7 +107,7 @@ static int test_pattern_walking_zeros(void *ptr, size_t size) {
     // Verify
     for (size_t i = 0; i < words; i++) {
         if (data[i] != ~(1U << (i % 32))) {
-            printf("  FAIL at offset %u\r\n", (unsigned int)i * 4);
+            tprintf("  FAIL at offset %u\r\n", (unsigned int)i * 4);
             return 0;
         }
     }
@@ -109,7 +119,7 @@ static int test_pattern_checkerboard(void *ptr, size_t size) {
     unsigned int *data = (unsigned int*)ptr;
     size_t words = size / sizeof(unsigned int);
 
-    printf("  Checkerboard pattern...\r\n");
+    tprintf("  Checkerboard pattern...\r\n");
 
     // Write 0xAAAAAAAA and 0x55555555
     for (size_t i = 0; i < words; i++) {
@@ -120,7 +130,7 @@ static int test_pattern_checkerboard(void *ptr, size_t size) {
     for (size_t i = 0; i < words; i++) {
         unsigned int expected = (i & 1) ? 0x55555555 : 0xAAAAAAAA;
         if (data[i] != expected) {
-            printf("  FAIL at offset %u\r\n", (unsigned int)i * 4);
+            tprintf("  FAIL at offset %u\r\n", (unsigned int)i * 4);
             return 0;
         }
     }
@@ -132,7 +142,7 @@ static int test_pattern_address_in_address(void *ptr, size_t size) {
     unsigned int *data = (unsigned int*)ptr;
     size_t words = size / sizeof(unsigned int);
 
-    printf("  Address-in-address pattern...\r\n");
+    tprintf("  Address-in-address pattern...\r\n");
 
     // Write address as data
     for (size_t i = 0; i < words; i++) {
@@ -142,7 +152,7 @@ static int test_pattern_address_in_address(void *ptr, size_t size) {
     // Verify
     for (size_t i = 0; i < words; i++) {
         if (data[i] != (unsigned int)&data[i]) {
-            printf("  FAIL at offset %u\r\n", (unsigned int)i * 4);
+            tprintf("  FAIL at offset %u\r\n", (unsigned int)i * 4);
             return 0;
         }
     }
@@ -155,7 +165,7 @@ static int test_pattern_random(void *ptr, size_t size) {
     size_t words = size / sizeof(unsigned int);
     unsigned int seed = 0xDEADBEEF;
 
-    printf("  Random pattern (PRNG)...\r\n");
+    tprintf("  Random pattern (PRNG)...\r\n");
 
     // Write pseudo-random data (simple LCG)
     unsigned int rng = seed;
@@ -169,7 +179,7 @@ static int test_pattern_random(void *ptr, size_t size) {
     for (size_t i = 0; i < words; i++) {
         rng = rng * 1664525 + 1013904223;
         if (data[i] != rng) {
-            printf("  FAIL at offset %u\r\n", (unsigned int)i * 4);
+            tprintf("  FAIL at offset %u\r\n", (unsigned int)i * 4);
             return 0;
         }
     }
@@ -186,27 +196,31 @@ static void test_heap_info(void) {
     unsigned int heap_end = (unsigned int)&__heap_end;
     unsigned int heap_size = heap_end - heap_start;
 
-    printf("\r\n");
-    printf("=== Heap Information ===\r\n");
-    printf("Heap start:     0x%08X\r\n", heap_start);
-    printf("Heap end:       0x%08X\r\n", heap_end);
-    printf("Heap size:      %u bytes (%u KB)\r\n", heap_size, heap_size / 1024);
-    printf("Stack region:   0x00042000 - 0x00080000 (248 KB)\r\n");
+    tprintf("\r\n");
+    tprintf("=== Heap Information ===\r\n");
+    tprintf("Heap start:     0x%08X\r\n", heap_start);
+    tprintf("Heap end:       0x%08X\r\n", heap_end);
+    tprintf("Heap size:      %u bytes (%u KB)\r\n", heap_size, heap_size / 1024);
+    tprintf("Stack region:   0x%08X - 0x%08X (%u KB)\r\n",
+            (unsigned int)&__stack_bottom, (unsigned int)&__stack_top,
+            ((unsigned int)&__stack_top - (unsigned int)&__stack_bottom) / 1024);
 }
 
-static void test_single_allocation(void) {
-    printf("\r\n");
-    printf("=== Single Allocation Test ===\r\n");
+static int test_single_allocation(void) {
+    tprintf("\r\n");
+    tprintf("=== Single Allocation Test ===\r\n");
 
     size_t sizes[] = {16, 64, 256, 1024, 4096, 16384};
+    int all_ok = 1;
 
     for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++) {
-        printf("Allocating %u bytes... ", (unsigned int)sizes[i]);
+        tprintf("Allocating %u bytes... ", (unsigned int)sizes[i]);
         fflush(stdout);
 
         void *ptr = malloc(sizes[i]);
         if (!ptr) {
-            printf("FAIL (malloc returned NULL)\r\n");
+            tprintf("FAIL (malloc returned NULL)\r\n");
+            all_ok = 0;
             continue;
         }
 
@@ -221,150 +235,214 @@ static void test_single_allocation(void) {
         }
 
         free(ptr);
-        printf("%s\r\n", ok ? "PASS" : "FAIL");
+        tprintf("%s\r\n", ok ? "PASS" : "FAIL");
+        all_ok &= ok;
     }
+    return all_ok;
 }
 
-static void test_multiple_allocations(void) {
-    printf("\r\n");
-    printf("=== Multiple Allocations Test ===\r\n");
+static int test_multiple_allocations(void) {
+    tprintf("\r\n");
+    tprintf("=== Multiple Allocations Test ===\r\n");
 
     #define NUM_ALLOCS 10
     void *ptrs[NUM_ALLOCS];
 
-    printf("Allocating %d blocks of 1KB each...\r\n", NUM_ALLOCS);
+    tprintf("Allocating %d blocks of 1KB each...\r\n", NUM_ALLOCS);
 
     for (int i = 0; i < NUM_ALLOCS; i++) {
         ptrs[i] = malloc(1024);
         if (!ptrs[i]) {
-            printf("FAIL: malloc returned NULL at block %d\r\n", i);
+            tprintf("FAIL: malloc returned NULL at block %d\r\n", i);
             for (int j = 0; j < i; j++) free(ptrs[j]);
-            return;
+            return 0;
         }
         memset(ptrs[i], i & 0xFF, 1024);
     }
 
-    printf("Verifying data...\r\n");
+    tprintf("Verifying data...\r\n");
     int ok = 1;
     for (int i = 0; i < NUM_ALLOCS; i++) {
         for (int j = 0; j < 1024; j++) {
             if (((unsigned char*)ptrs[i])[j] != (unsigned char)(i & 0xFF)) {
-                printf("FAIL: corruption in block %d\r\n", i);
+                tprintf("FAIL: corruption in block %d\r\n", i);
                 ok = 0;
                 break;
             }
         }
     }
 
-    printf("Freeing all blocks...\r\n");
+    tprintf("Freeing all blocks...\r\n");
     for (int i = 0; i < NUM_ALLOCS; i++) {
         free(ptrs[i]);
     }
 
-    printf("%s\r\n", ok ? "PASS" : "FAIL");
+    tprintf("%s\r\n", ok ? "PASS" : "FAIL");
+    return ok;
 }
 
-static void test_fragmentation(void) {
-    printf("\r\n");
-    printf("=== Fragmentation Test ===\r\n");
+static int test_fragmentation(void) {
+    tprintf("\r\n");
+    tprintf("=== Fragmentation Test ===\r\n");
 
     #define FRAG_ALLOCS 20
     void *ptrs[FRAG_ALLOCS];
 
-    printf("Allocating %d blocks...\r\n", FRAG_ALLOCS);
+    tprintf("Allocating %d blocks...\r\n", FRAG_ALLOCS);
     for (int i = 0; i < FRAG_ALLOCS; i++) {
         ptrs[i] = malloc(512);
         if (!ptrs[i]) {
-            printf("FAIL: malloc at block %d\r\n", i);
+            tprintf("FAIL: malloc at block %d\r\n", i);
             for (int j = 0; j < i; j++) if (ptrs[j]) free(ptrs[j]);
-            return;
+            return 0;
         }
     }
 
-    printf("Freeing every other block...\r\n");
+    tprintf("Freeing every other block...\r\n");
     for (int i = 0; i < FRAG_ALLOCS; i += 2) {
         free(ptrs[i]);
         ptrs[i] = NULL;
     }
 
-    printf("Re-allocating freed blocks...\r\n");
+    tprintf("Re-allocating freed blocks...\r\n");
     for (int i = 0; i < FRAG_ALLOCS; i += 2) {
         ptrs[i] = malloc(512);
         if (!ptrs[i]) {
-            printf("FAIL: re-malloc at block %d\r\n", i);
+            tprintf("FAIL: re-malloc at block %d\r\n", i);
             for (int j = 0; j < FRAG_ALLOCS; j++) if (ptrs[j]) free(ptrs[j]);
-            return;
+            return 0;
         }
     }
 
-    printf("Freeing all blocks...\r\n");
+    tprintf("Freeing all blocks...\r\n");
     for (int i = 0; i < FRAG_ALLOCS; i++) {
         if (ptrs[i]) free(ptrs[i]);
     }
 
-    printf("PASS\r\n");
+    tprintf("PASS\r\n");
+    return 1;
 }
 
-static void test_memory_patterns(void) {
-    printf("\r\n");
-    printf("=== Memory Pattern Test ===\r\n");
+// Largest block malloc will hand out: start with 90% of the heap and
+// shrink by 10% until it fits
+static void *alloc_largest(unsigned int heap_total, size_t *size) {
+    size_t test_size = (heap_total * 9) / 10;
+    void *ptr = NULL;
+
+    while (test_size > 4096 && !ptr) {
+        ptr = malloc(test_size);
+        if (!ptr) {
+            test_size = (test_size * 9) / 10;  // Reduce by 10%
+        }
+    }
+
+    *size = test_size;
+    return ptr;
+}
+
+// The five software patterns, each writing and reading the whole block
+static int run_software_patterns(void *ptr, size_t size) {
+    int all_pass = 1;
+
+    all_pass &= test_pattern_walking_ones(ptr, size);
+    all_pass &= test_pattern_walking_zeros(ptr, size);
+    all_pass &= test_pattern_checkerboard(ptr, size);
+    all_pass &= test_pattern_address_in_address(ptr, size);
+    all_pass &= test_pattern_random(ptr, size);
+    return all_pass;
+}
+
+static int test_memory_patterns(void) {
+    tprintf("\r\n");
+    tprintf("=== Memory Pattern Test ===\r\n");
 
     // Calculate available heap space
     unsigned int heap_start = (unsigned int)&__heap_start;
     unsigned int heap_end = (unsigned int)&__heap_end;
     unsigned int heap_total = heap_end - heap_start;
 
-    printf("Total heap space: %u bytes (%u KB)\r\n", heap_total, heap_total / 1024);
+    tprintf("Total heap space: %u bytes (%u KB)\r\n", heap_total, heap_total / 1024);
 
     // Try to allocate maximum available heap
-    // Start with 90% of total, reduce if fails
-    size_t test_size = (heap_total * 9) / 10;
-    void *ptr = NULL;
+    size_t test_size;
 
-    printf("Attempting to allocate maximum available heap...\r\n");
+    tprintf("Attempting to allocate maximum available heap...\r\n");
     fflush(stdout);
 
-    while (test_size > 4096 && !ptr) {
-        ptr = malloc(test_size);
-        if (!ptr) {
-            test_size = (test_size * 9) / 10;  // Reduce by 10%
-        }
-    }
+    void *ptr = alloc_largest(heap_total, &test_size);
 
     if (!ptr) {
-        printf("FAIL: Unable to allocate even 4KB of heap\r\n");
-        return;
+        tprintf("FAIL: Unable to allocate even 4KB of heap\r\n");
+        return 0;
     }
 
-    printf("Allocated %u bytes (%u KB, %.1f%% of heap)\r\n",
+    tprintf("Allocated %u bytes (%u KB, %.1f%% of heap)\r\n",
            (unsigned int)test_size,
            (unsigned int)(test_size / 1024),
            (float)test_size * 100.0 / heap_total);
-    printf("Testing entire allocated region with 5 patterns...\r\n");
+    tprintf("Testing entire allocated region with 5 patterns...\r\n");
     fflush(stdout);
 
-    int all_pass = 1;
-    all_pass &= test_pattern_walking_ones(ptr, test_size);
-    all_pass &= test_pattern_walking_zeros(ptr, test_size);
-    all_pass &= test_pattern_checkerboard(ptr, test_size);
-    all_pass &= test_pattern_address_in_address(ptr, test_size);
-    all_pass &= test_pattern_random(ptr, test_size);
+    int all_pass = run_software_patterns(ptr, test_size);
 
     free(ptr);
-    printf("\r\n");
-    printf("%s\r\n", all_pass ? "ALL PATTERNS PASS" : "SOME PATTERNS FAILED");
+    tprintf("\r\n");
+    tprintf("%s\r\n", all_pass ? "ALL PATTERNS PASS" : "SOME PATTERNS FAILED");
+
+    // 5 patterns, each writes and reads the whole block
+    bench_set_bytes((uint32_t)test_size * 10);
+    return all_pass;
 }
 
-static void test_stress_allocations(void) {
-    printf("\r\n");
-    printf("=== Stress Test (30 seconds) ===\r\n");
-    printf("Rapid malloc/free cycles with verification...\r\n");
-    printf("This will take ~30 seconds...\r\n");
+// One block bigger than 256KB, only possible with linear SRAM
+static int test_large_allocation(void) {
+    unsigned int heap_total = (unsigned int)&__heap_end - (unsigned int)&__heap_start;
+
+    tprintf("\r\n");
+    tprintf("=== Large Allocation Test (> 256 KB) ===\r\n");
+
+    if (heap_total < LARGE_ALLOC_SIZE) {
+        tprintf("SKIP: heap is only %u KB\r\n", heap_total / 1024);
+        return 1;
+    }
+
+    tprintf("Allocating %u KB... ", LARGE_ALLOC_SIZE / 1024);
+    fflush(stdout);
+
+    unsigned char *ptr = malloc(LARGE_ALLOC_SIZE);
+    if (!ptr) {
+        tprintf("FAIL (malloc returned NULL)\r\n");
+        return 0;
+    }
+
+    unsigned int lo = (unsigned int)ptr;
+    unsigned int hi = lo + LARGE_ALLOC_SIZE;
+    tprintf("0x%08X - 0x%08X\r\n", lo, hi);
+    if (lo <= OLD_ROM_START && hi >= OLD_ROM_END) {
+        tprintf("Block covers 0x%08X - 0x%08X (old boot ROM window)\r\n",
+                OLD_ROM_START, OLD_ROM_END - 1);
+    }
+
+    // Address-in-address catches any window that aliases or reads back ROM
+    int ok = test_pattern_address_in_address(ptr, LARGE_ALLOC_SIZE);
+    ok &= test_pattern_random(ptr, LARGE_ALLOC_SIZE);
+
+    free(ptr);
+    tprintf("%s\r\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+static int test_stress_allocations(void) {
+    tprintf("\r\n");
+    tprintf("=== Stress Test (30 seconds) ===\r\n");
+    tprintf("Rapid malloc/free cycles with verification...\r\n");
+    tprintf("This will take ~30 seconds...\r\n");
     fflush(stdout);
 
     unsigned int iterations = 10000;
     unsigned int seed = 0x12345678;
     int failures = 0;
+    uint32_t bytes = 0;
 
     for (unsigned int i = 0; i < iterations; i++) {
         // Pseudo-random size (100 - 2000 bytes)
@@ -380,6 +458,7 @@ static void test_stress_allocations(void) {
         // Fill with pattern
         unsigned char pattern = (unsigned char)(seed & 0xFF);
         memset(ptr, pattern, size);
+        bytes += 2 * size;
 
         // Verify
         for (size_t j = 0; j < size; j++) {
@@ -393,22 +472,208 @@ static void test_stress_allocations(void) {
 
         // Progress indicator every 1000 iterations
         if ((i + 1) % 1000 == 0) {
-            printf("  %u iterations complete...\r\n", i + 1);
+            tprintf("  %u iterations complete...\r\n", i + 1);
             fflush(stdout);
         }
     }
 
-    printf("\r\n");
-    printf("Completed %u iterations\r\n", iterations);
-    printf("Failures: %u\r\n", failures);
-    printf("%s\r\n", failures == 0 ? "PASS" : "FAIL");
+    tprintf("\r\n");
+    tprintf("Completed %u iterations\r\n", iterations);
+    tprintf("Failures: %u\r\n", failures);
+    tprintf("%s\r\n", failures == 0 ? "PASS" : "FAIL");
+
+    bench_set_bytes(bytes);
+    return failures == 0;
+}
+
+//==============================================================================
+// Hardware SRAM BIST - same heap block, tested by hdl/sram_bist.v
+//==============================================================================
+
+typedef struct {
+    const char *name;
+    unsigned int mask;              // BIST_CTRL_* test bit
+    unsigned int ops_per_halfword;  // 16-bit accesses per halfword
+} bist_test_t;
+
+static const bist_test_t bist_tests[] = {
+    { "March C-",        BIST_CTRL_MARCH, 10 },
+    { "Walking 1/0",     BIST_CTRL_WALK,  4  },
+    { "Address unique",  BIST_CTRL_ADDR,  4  },
+};
+
+// One BIST run over [start, end). The CPU fetches from SRAM, so it stalls on
+// its next instruction until the run is over; the busy loop is a formality.
+static int bist_run(unsigned int start, unsigned int end, unsigned int mask,
+                    unsigned int *cycles) {
+    BIST_START = start;
+    BIST_END = end;
+    BIST_PATTERN = 0x0000;
+    BIST_CTRL = mask | BIST_CTRL_START;
+    while (BIST_STATUS & BIST_STATUS_BUSY);
+
+    unsigned int status = BIST_STATUS;
+    *cycles = BIST_CYCLES;
+
+    if (status & BIST_STATUS_RANGE) {
+        tprintf("  FAIL: range 0x%08X-0x%08X rejected\r\n", start, end);
+        return 0;
+    }
+    if (status & BIST_STATUS_FAIL) {
+        unsigned int fail_data = BIST_FAIL_DATA;
+        tprintf("  FAIL at 0x%08X (step %u): expected 0x%04X, read 0x%04X, %u error(s)\r\n",
+               BIST_FAIL_ADDR, BIST_STATUS_STEP(status),
+               fail_data >> 16, fail_data & 0xFFFF, BIST_ERRORS);
+        return 0;
+    }
+    return 1;
+}
+
+// KB/s (1000 bytes) at BENCH_CPU_HZ
+static unsigned int rate_kbps(uint64_t bytes, uint64_t cycles) {
+    if (cycles == 0) return 0;
+    return (unsigned int)(bytes * (BENCH_CPU_HZ / 1000) / cycles);
+}
+
+static int test_hw_bist(void) {
+    tprintf("\r\n");
+    tprintf("=== Hardware SRAM BIST vs Software Patterns ===\r\n");
+
+    unsigned int id = BIST_ID;
+    if (id != BIST_ID_VALUE) {
+        tprintf("SRAM BIST not present in this bitstream (ID 0x%08X)\r\n", id);
+        return 0;
+    }
+
+    unsigned int heap_total = (unsigned int)&__heap_end - (unsigned int)&__heap_start;
+    size_t size;
+    void *ptr = alloc_largest(heap_total, &size);
+    if (!ptr) {
+        tprintf("FAIL: Unable to allocate even 4KB of heap\r\n");
+        return 0;
+    }
+
+    unsigned int start = (unsigned int)ptr;
+    unsigned int end = start + (unsigned int)size;
+    tprintf("Region 0x%08X-0x%08X (%u KB)\r\n", start, end, (unsigned int)(size / 1024));
+
+    bench_timer_init();
+
+    // Software: five patterns, 32-bit writes then reads of the whole block
+    tprintf("Software patterns (CPU through mem_controller)...\r\n");
+    fflush(stdout);
+    uint64_t t0 = bench_cycles();
+    int sw_pass = run_software_patterns(ptr, size);
+    uint64_t sw_cycles = bench_cycles() - t0;
+    uint64_t sw_bytes = (uint64_t)size * 10;
+
+    // Hardware: each BIST test on its own, timed by the engine
+    int hw_pass = 1;
+    uint64_t hw_cycles = 0, hw_bytes = 0;
+    unsigned int cycles[sizeof(bist_tests) / sizeof(bist_tests[0])];
+
+    tprintf("Hardware BIST (16-bit accesses at driver speed)...\r\n");
+    fflush(stdout);
+    for (unsigned int i = 0; i < sizeof(bist_tests) / sizeof(bist_tests[0]); i++) {
+        hw_pass &= bist_run(start, end, bist_tests[i].mask, &cycles[i]);
+        hw_cycles += cycles[i];
+        hw_bytes += (uint64_t)size * bist_tests[i].ops_per_halfword;
+    }
+
+    free(ptr);
+
+    tprintf("\r\n");
+    // Kcycles, not cycles: newlib-nano printf has no %llu
+    tprintf("  %-16s %10s %8s %8s\r\n", "Test", "Kcycles", "ms", "KB/s");
+    tprintf("  %-16s %10u %8u %8u\r\n", "Software (5)",
+           (unsigned int)(sw_cycles / 1000), (unsigned int)(sw_cycles / (BENCH_CPU_HZ / 1000)),
+           rate_kbps(sw_bytes, sw_cycles));
+    for (unsigned int i = 0; i < sizeof(bist_tests) / sizeof(bist_tests[0]); i++) {
+        uint64_t bytes = (uint64_t)size * bist_tests[i].ops_per_halfword;
+        tprintf("  %-16s %10u %8u %8u\r\n", bist_tests[i].name, cycles[i] / 1000,
+               cycles[i] / (BENCH_CPU_HZ / 1000), rate_kbps(bytes, cycles[i]));
+    }
+    tprintf("  %-16s %10u %8u %8u\r\n", "BIST total",
+           (unsigned int)(hw_cycles / 1000), (unsigned int)(hw_cycles / (BENCH_CPU_HZ / 1000)),
+           rate_kbps(hw_bytes, hw_cycles));
+
+    // Per byte touched: the BIST does more passes than the software set
+    if (hw_cycles > 0 && sw_bytes > 0) {
+        uint64_t speedup = (sw_cycles * hw_bytes * 10) / (hw_cycles * sw_bytes);
+        tprintf("  Speedup per byte accessed: %u.%ux\r\n",
+               (unsigned int)(speedup / 10), (unsigned int)(speedup % 10));
+    }
+
+    tprintf("\r\n");
+    tprintf("Software: %s, BIST: %s\r\n", sw_pass ? "PASS" : "FAIL", hw_pass ? "PASS" : "FAIL");
+    return sw_pass && hw_pass;
+}
+
+// One pass over the buffer with the given access width (0 = memcpy).
+// Returns 1 if check_key is set and a key was pressed during the pass.
+static int pattern_pass(void *src, void *dst, size_t buf_size,
+                        int is_read_test, int access_width, int check_key) {
+    if (is_read_test) {
+        // READ test - read from memory
+        if (access_width == 1) {
+            unsigned char *ptr = (unsigned char*)src;
+            for (size_t i = 0; i < buf_size; i++) {
+                pattern_sink += ptr[i];
+                if (check_key && (i & 0x3FF) == 0 && uart_getc_available()) return 1;
+            }
+        } else if (access_width == 2) {
+            unsigned short *ptr = (unsigned short*)src;
+            size_t halfwords = buf_size / 2;
+            for (size_t i = 0; i < halfwords; i++) {
+                pattern_sink += ptr[i];
+                if (check_key && (i & 0x3FF) == 0 && uart_getc_available()) return 1;
+            }
+        } else if (access_width == 4) {
+            unsigned int *ptr = (unsigned int*)src;
+            size_t words = buf_size / 4;
+            for (size_t i = 0; i < words; i++) {
+                pattern_sink += ptr[i];
+                if (check_key && (i & 0x3FF) == 0 && uart_getc_available()) return 1;
+            }
+        } else {
+            // memcpy (copy operation)
+            memcpy(dst, src, buf_size);
+        }
+    } else {
+        // WRITE test - write to memory
+        if (access_width == 1) {
+            unsigned char *ptr = (unsigned char*)dst;
+            for (size_t i = 0; i < buf_size; i++) {
+                ptr[i] = 0xAA;
+                if (check_key && (i & 0x3FF) == 0 && uart_getc_available()) return 1;
+            }
+        } else if (access_width == 2) {
+            unsigned short *ptr = (unsigned short*)dst;
+            size_t halfwords = buf_size / 2;
+            for (size_t i = 0; i < halfwords; i++) {
+                ptr[i] = 0xAAAA;
+                if (check_key && (i & 0x3FF) == 0 && uart_getc_available()) return 1;
+            }
+        } else if (access_width == 4) {
+            unsigned int *ptr = (unsigned int*)dst;
+            size_t words = buf_size / 4;
+            for (size_t i = 0; i < words; i++) {
+                ptr[i] = 0xAAAAAAAA;
+                if (check_key && (i & 0x3FF) == 0 && uart_getc_available()) return 1;
+            }
+        } else {
+            // memcpy (copy operation)
+            memcpy(dst, src, buf_size);
+        }
+    }
+    return 0;
 }
 
 // Helper function to run a throughput test pattern
 static void run_pattern_test(const char *pattern_name,
                               void *src, void *dst, size_t buf_size,
                               int is_read_test, int access_width) {
-    printf("\r\n--- %s: %s (10 seconds) ---\r\n",
+    tprintf("\r\n--- %s: %s (10 seconds) ---\r\n",
            is_read_test ? "READ" : "WRITE", pattern_name);
     fflush(stdout);
 
@@ -418,84 +683,13 @@ static void run_pattern_test(const char *pattern_name,
     unsigned int last_bytes = 0;
 
     // Enable timer
-    TIMER_CR = 0x00000001;
+    timer_start();
 
     // Run test for 10 seconds or until keypress
-    volatile unsigned int dummy = 0;
     int exit_requested = 0;
 
     while (seconds_elapsed < 10 && !exit_requested) {
-        if (is_read_test) {
-            // READ test - read from memory
-            if (access_width == 1) {
-                unsigned char *ptr = (unsigned char*)src;
-                for (size_t i = 0; i < buf_size; i++) {
-                    dummy += ptr[i];
-                    if ((i & 0x3FF) == 0 && (UART_RX_STATUS & 0x01)) {
-                        exit_requested = 1;
-                        break;
-                    }
-                }
-            } else if (access_width == 2) {
-                unsigned short *ptr = (unsigned short*)src;
-                size_t halfwords = buf_size / 2;
-                for (size_t i = 0; i < halfwords; i++) {
-                    dummy += ptr[i];
-                    if ((i & 0x3FF) == 0 && (UART_RX_STATUS & 0x01)) {
-                        exit_requested = 1;
-                        break;
-                    }
-                }
-            } else if (access_width == 4) {
-                unsigned int *ptr = (unsigned int*)src;
-                size_t words = buf_size / 4;
-                for (size_t i = 0; i < words; i++) {
-                    dummy += ptr[i];
-                    if ((i & 0x3FF) == 0 && (UART_RX_STATUS & 0x01)) {
-                        exit_requested = 1;
-                        break;
-                    }
-                }
-            } else {
-                // memcpy (copy operation)
-                memcpy(dst, src, buf_size);
-            }
-        } else {
-            // WRITE test - write to memory
-            if (access_width == 1) {
-                unsigned char *ptr = (unsigned char*)dst;
-                for (size_t i = 0; i < buf_size; i++) {
-                    ptr[i] = 0xAA;
-                    if ((i & 0x3FF) == 0 && (UART_RX_STATUS & 0x01)) {
-                        exit_requested = 1;
-                        break;
-                    }
-                }
-            } else if (access_width == 2) {
-                unsigned short *ptr = (unsigned short*)dst;
-                size_t halfwords = buf_size / 2;
-                for (size_t i = 0; i < halfwords; i++) {
-                    ptr[i] = 0xAAAA;
-                    if ((i & 0x3FF) == 0 && (UART_RX_STATUS & 0x01)) {
-                        exit_requested = 1;
-                        break;
-                    }
-                }
-            } else if (access_width == 4) {
-                unsigned int *ptr = (unsigned int*)dst;
-                size_t words = buf_size / 4;
-                for (size_t i = 0; i < words; i++) {
-                    ptr[i] = 0xAAAAAAAA;
-                    if ((i & 0x3FF) == 0 && (UART_RX_STATUS & 0x01)) {
-                        exit_requested = 1;
-                        break;
-                    }
-                }
-            } else {
-                // memcpy (copy operation)
-                memcpy(dst, src, buf_size);
-            }
-        }
+        exit_requested = pattern_pass(src, dst, buf_size, is_read_test, access_width, 1);
 
         bytes_processed += buf_size;
 
@@ -508,12 +702,12 @@ static void run_pattern_test(const char *pattern_name,
             last_bytes = bytes_processed;
 
             if (bytes_this_sec >= 1000000) {
-                printf("  [%2us] %u.%02u MB/s\r\n",
+                tprintf("  [%2us] %u.%02u MB/s\r\n",
                        seconds_elapsed,
                        bytes_this_sec / 1000000,
                        (bytes_this_sec % 1000000) / 10000);
             } else {
-                printf("  [%2us] %u.%02u KB/s\r\n",
+                tprintf("  [%2us] %u.%02u KB/s\r\n",
                        seconds_elapsed,
                        bytes_this_sec / 1000,
                        (bytes_this_sec % 1000) / 10);
@@ -523,25 +717,23 @@ static void run_pattern_test(const char *pattern_name,
     }
 
     // Stop timer - timer stays off until next test
-    TIMER_CR = 0x00000000;
+    timer_stop();
 
     // Calculate average
     if (seconds_elapsed > 0) {
         unsigned int avg = bytes_processed / seconds_elapsed;
-        printf("  Average: %u.%02u MB/s\r\n",
+        tprintf("  Average: %u.%02u MB/s\r\n",
                avg / 1000000,
                (avg % 1000000) / 10000);
     }
-
-    (void)dummy;  // Prevent optimization
 }
 
 static void test_throughput(void) {
-    printf("\r\n");
-    printf("=== Memory Throughput Test ===\r\n");
-    printf("Tests READ and WRITE with different access widths\r\n");
-    printf("Each pattern runs for 10 seconds\r\n");
-    printf("Press 's' to start, 'q' to quit\r\n");
+    tprintf("\r\n");
+    tprintf("=== Memory Throughput Test ===\r\n");
+    tprintf("Tests READ and WRITE with different access widths\r\n");
+    tprintf("Each pattern runs for 10 seconds\r\n");
+    tprintf("Press 's' to start, 'q' to quit\r\n");
     fflush(stdout);
 
     // Wait for 's' to start
@@ -551,8 +743,8 @@ static void test_throughput(void) {
         if (ch == 'q' || ch == 'Q') return;
     }
 
-    printf("\r\nStarting throughput benchmark...\r\n");
-    printf("Press any key to skip current test\r\n");
+    tprintf("\r\nStarting throughput benchmark...\r\n");
+    tprintf("Press any key to skip current test\r\n");
     fflush(stdout);
 
     // Allocate test buffers (64KB each)
@@ -561,7 +753,7 @@ static void test_throughput(void) {
     void *dst = malloc(buf_size);
 
     if (!src || !dst) {
-        printf("FAIL: malloc failed\r\n");
+        tprintf("FAIL: malloc failed\r\n");
         free(src);
         free(dst);
         return;
@@ -571,37 +763,34 @@ static void test_throughput(void) {
     memset(src, 0xAA, buf_size);
 
     // Setup timer for 1 Hz interrupts
-    TIMER_PSC = 49;
-    TIMER_ARR = 999999;
+    timer_config(49, 999999);
 
     // Enable interrupts
     irq_enable();
 
     // Run all test patterns
-    printf("\r\n========== READ TESTS ==========\r\n");
+    tprintf("\r\n========== READ TESTS ==========\r\n");
     run_pattern_test("memcpy (copy)", src, dst, buf_size, 1, 0);
     run_pattern_test("8-bit reads", src, dst, buf_size, 1, 1);
     run_pattern_test("16-bit reads", src, dst, buf_size, 1, 2);
     run_pattern_test("32-bit reads", src, dst, buf_size, 1, 4);
 
-    printf("\r\n========== WRITE TESTS ==========\r\n");
+    tprintf("\r\n========== WRITE TESTS ==========\r\n");
     run_pattern_test("memcpy (copy)", src, dst, buf_size, 0, 0);
     run_pattern_test("8-bit writes", src, dst, buf_size, 0, 1);
     run_pattern_test("16-bit writes", src, dst, buf_size, 0, 2);
     run_pattern_test("32-bit writes", src, dst, buf_size, 0, 4);
 
-    printf("\r\n========================================\r\n");
-    printf("Throughput benchmark complete!\r\n");
-    printf("========================================\r\n");
+    tprintf("\r\n========================================\r\n");
+    tprintf("Throughput benchmark complete!\r\n");
+    tprintf("========================================\r\n");
 
     // Simple clean shutdown - just stop timer and disable interrupts
-    TIMER_CR = 0x00000000;      // Stop timer
+    timer_stop();               // Stop timer
     irq_disable();              // Disable interrupts
 
     // Drain UART buffer of any keypresses during tests
-    while (UART_RX_STATUS & 0x01) {
-        (void)(UART_RX_DATA);
-    }
+    uart_flush_rx();
 
     // Reset global state
     new_second = 0;
@@ -612,6 +801,65 @@ static void test_throughput(void) {
     free(dst);
 }
 
+//==============================================================================
+// Batch Mode - every test with fixed seeds, timed in CPU cycles
+//==============================================================================
+
+// Throughput cases: fixed passes over 64KB instead of 10 s per pattern
+#define BATCH_BUF_SIZE  65536
+#define BATCH_PASSES    4
+#define BATCH_BYTES     (BATCH_BUF_SIZE * BATCH_PASSES)
+
+static void *batch_src, *batch_dst;
+
+static int batch_throughput(int is_read_test, int access_width) {
+    for (int p = 0; p < BATCH_PASSES; p++) {
+        pattern_pass(batch_src, batch_dst, BATCH_BUF_SIZE, is_read_test, access_width, 0);
+    }
+    return 1;
+}
+
+static int batch_memcpy(void)  { return batch_throughput(1, 0); }
+static int batch_read8(void)   { return batch_throughput(1, 1); }
+static int batch_read16(void)  { return batch_throughput(1, 2); }
+static int batch_read32(void)  { return batch_throughput(1, 4); }
+static int batch_write8(void)  { return batch_throughput(0, 1); }
+static int batch_write16(void) { return batch_throughput(0, 2); }
+static int batch_write32(void) { return batch_throughput(0, 4); }
+
+static const bench_case_t batch_cases[] = {
+    { "single_alloc",   test_single_allocation,    6,                  21840       },
+    { "multi_alloc",    test_multiple_allocations, 10,                 20480       },
+    { "fragmentation",  test_fragmentation,        30,                 0           },
+    { "patterns",       test_memory_patterns,      5,                  0           },
+    { "stress",         test_stress_allocations,   10000,              0           },
+    { "memcpy",         batch_memcpy,              BATCH_BYTES,        BATCH_BYTES },
+    { "read8",          batch_read8,               BATCH_BYTES,        BATCH_BYTES },
+    { "read16",         batch_read16,              BATCH_BYTES / 2,    BATCH_BYTES },
+    { "read32",         batch_read32,              BATCH_BYTES / 4,    BATCH_BYTES },
+    { "write8",         batch_write8,              BATCH_BYTES,        BATCH_BYTES },
+    { "write16",        batch_write16,             BATCH_BYTES / 2,    BATCH_BYTES },
+    { "write32",        batch_write32,             BATCH_BYTES / 4,    BATCH_BYTES },
+};
+
+static void run_batch(void) {
+    batch_src = malloc(BATCH_BUF_SIZE);
+    batch_dst = malloc(BATCH_BUF_SIZE);
+    if (!batch_src || !batch_dst) {
+        printf("FAIL: malloc failed\r\n");
+        free(batch_src);
+        free(batch_dst);
+        return;
+    }
+    memset(batch_src, 0xAA, BATCH_BUF_SIZE);
+
+    bench_run_cases("heap", batch_cases, sizeof(batch_cases) / sizeof(batch_cases[0]), BATCH_REPS);
+    bench_done();
+
+    free(batch_src);
+    free(batch_dst);
+}
+
 //==============================================================================
 // Main Menu
 //==============================================================================
@@ -629,6 +877,10 @@ static void show_menu(void) {
     printf("6. Stress test (30 seconds)\r\n");
     printf("7. Throughput test (real-time)\r\n");
     printf("8. Run all tests\r\n");
+    printf("9. Hardware SRAM BIST vs software patterns\r\n");
+    printf("l. Large allocation test (> 256 KB)\r\n");
+    printf("m. Memory usage (stack/heap high-water marks)\r\n");
+    printf("b. Batch benchmark (CSV/JSON, %d repetitions)\r\n", BATCH_REPS);
     printf("h. Show this menu\r\n");
     printf("q. Quit\r\n");
     printf("========================================\r\n");
@@ -643,6 +895,18 @@ int main(void) {
     printf("  malloc/free stress testing\r\n");
     printf("========================================\r\n");
     printf("\r\n");
+
+#ifdef BATCH_MODE
+    // BATCH=1 build: no terminal needed
+    run_batch();
+    while (1) {
+        __asm__ volatile ("wfi");
+    }
+#endif
+
+    // Stack guard, checked from the throughput test's 1 Hz timer IRQ
+    memstat_guard_enable(0);
+
     printf("Press any key to start...\r\n");
 
     getch();
@@ -699,8 +963,11 @@ int main(void) {
                 test_multiple_allocations();
                 test_fragmentation();
                 test_memory_patterns();
+                test_large_allocation();
                 test_stress_allocations();
+                test_hw_bist();
                 test_throughput();
+                memstat_print();
                 printf("\r\n");
                 printf("========================================\r\n");
                 printf("All heap tests complete!\r\n");
@@ -708,6 +975,29 @@ int main(void) {
                 show_menu();
                 break;
 
+            case '9':
+                test_hw_bist();
+                show_menu();
+                break;
+
+            case 'l':
+            case 'L':
+                test_large_allocation();
+                show_menu();
+                break;
+
+            case 'm':
+            case 'M':
+                memstat_print();
+                show_menu();
+                break;
+
+            case 'b':
+            case 'B':
+                run_batch();
+                show_menu();
+                break;
+
             case 'h':
             case 'H':
                 show_menu();
@@ -716,11 +1006,15 @@ int main(void) {
             case 'q':
             case 'Q':
                 printf("Quitting...\r\n");
+#ifdef APP_IMAGE
+                return 0;   // Back to the launcher
+#else
                 printf("Entering infinite loop (WFI).\r\n");
                 while (1) {
                     __asm__ volatile ("wfi");
                 }
                 break;
+#endif
 
             default:
                 printf("Invalid option: '%c'. Press 'h' for menu.\r\n", choice);
@@ -23,26 +23,12 @@
 #include <stdio.h>
 #include <ctype.h>
 #include "../lib/simple_upload/simple_upload.h"
+#include "../lib/crc32/crc32.h"
+#include "../lib/trace/trace.h"
+#include "../lib/uartmux/uartmux.h"
 #include "../lib/microrl/microrl.h"
 #include "../lib/incurses/curses.h"
-
-// Hardware addresses
-#define UART_TX_DATA   (*(volatile uint32_t *)0x80000000)
-#define UART_TX_STATUS (*(volatile uint32_t *)0x80000004)
-#define UART_RX_DATA   (*(volatile uint32_t *)0x80000008)
-#define UART_RX_STATUS (*(volatile uint32_t *)0x8000000C)
-
-// Timer registers
-#define TIMER_BASE          0x80000020
-#define TIMER_CR            (*(volatile uint32_t*)(TIMER_BASE + 0x00))
-#define TIMER_SR            (*(volatile uint32_t*)(TIMER_BASE + 0x04))
-#define TIMER_PSC           (*(volatile uint32_t*)(TIMER_BASE + 0x08))
-#define TIMER_ARR           (*(volatile uint32_t*)(TIMER_BASE + 0x0C))
-#define TIMER_CNT           (*(volatile uint32_t*)(TIMER_BASE + 0x10))
-
-#define TIMER_CR_ENABLE     (1 << 0)
-#define TIMER_CR_ONE_SHOT   (1 << 1)
-#define TIMER_SR_UIF        (1 << 0)
+#include "hal.h"
 
 // Clock state (updated by interrupt at 60 Hz)
 volatile uint32_t clock_frames = 0;   // Frame counter (0-59, increments at 60 Hz)
@@ -52,41 +38,26 @@ volatile uint32_t clock_hours = 0;    // Hours counter (0-23)
 volatile uint8_t clock_updated = 0;   // Flag: clock changed
 volatile uint8_t clock_enabled = 0;   // Flag: clock display enabled (0=off, 1=on)
 
+// Set by 'x' in APP=1 builds: main returns to the launcher
+static uint8_t exit_requested = 0;
+
 // Millisecond counter for timeouts (updated by interrupt)
 volatile uint32_t millis = 0;         // Total milliseconds since start
 
 // Memory layout (based on linker script)
-// Physical memory: 0x00000000 - 0x0007FFFF (512KB SRAM)
-// Application:     0x00000000 - 0x0003FFFF (256KB for code/data/bss)
-// Heap:            End of BSS - 0x00042000
-// Stack:           0x00042000 - 0x00080000 (grows down from 0x80000)
-#define HEAP_END       0x00042000   // Heap ends here (from linker script)
+// Physical memory: 0x00000000 - 0x0007FFFF (512KB SRAM, one linear region)
+// Application:     0x00000000 - end of BSS (code/data/bss)
+// Heap:            End of BSS - __heap_end
+// Stack:           __stack_size bytes below 0x80000 (grows down)
 
 // File transfer configuration
 #define ZM_MAX_RECEIVE    (128 * 1024)          // 128KB max transfer
-#define ZM_BUFFER_OFFSET  (140 * 1024)          // 140KB before heap end
-#define ZM_BUFFER_ADDR    (HEAP_END - ZM_BUFFER_OFFSET)
-
-//==============================================================================
-// PicoRV32 Interrupt Control (custom instructions)
-//==============================================================================
-
-// Enable interrupts (clear IRQ mask)
-static inline void irq_enable(void) {
-    uint32_t dummy;
-    __asm__ volatile (".insn r 0x0B, 6, 3, %0, %1, x0" : "=r"(dummy) : "r"(0));
-}
-
-// Disable interrupts (set IRQ mask to all 1s)
-static inline void irq_disable(void) {
-    uint32_t dummy;
-    __asm__ volatile (".insn r 0x0B, 6, 3, %0, %1, x0" : "=r"(dummy) : "r"(~0));
-}
+#define ZM_BUFFER_ADDR    0x0001F000            // Default upload buffer (in the heap)
 
 //==============================================================================
 // Forward Declarations
 //==============================================================================
-void timer_init(void);
+void clock_init(void);
 uint32_t get_time_ms(void);
 void execute_command(const char *cmd);
 
@@ -95,42 +66,44 @@ static uint32_t last_dump_addr = 0;
 static uint32_t last_dump_len = 0x100;  // 256 bytes
 
 //==============================================================================
-// UART Functions
+// Console Functions
+//
+// The console goes through lib/uartmux: unframed on a plain terminal, the
+// console channel while tools/uartmux/uartmux.py is attached.
 //==============================================================================
 
-void uart_putc(char c) {
-    while (UART_TX_STATUS & 1);  // Wait while busy
-    UART_TX_DATA = c;
+void console_putc(char c) {
+    uartmux_putc(UARTMUX_CH_CONSOLE, (uint8_t)c);
 }
 
-void uart_puts(const char *s) {
+void console_puts(const char *s) {
     while (*s) {
-        if (*s == '\n') uart_putc('\r');
-        uart_putc(*s++);
+        if (*s == '\n') console_putc('\r');
+        console_putc(*s++);
     }
 }
 
-int uart_getc_available(void) {
-    return UART_RX_STATUS & 1;
+int console_getc_available(void) {
+    return uartmux_available(UARTMUX_CH_CONSOLE) != 0;
 }
 
-char uart_getc(void) {
-    while (!uart_getc_available());
-    return UART_RX_DATA & 0xFF;
+char console_getc(void) {
+    return (char)uartmux_getc(UARTMUX_CH_CONSOLE);
 }
 
 // Flush UART RX buffer (discard all pending data)
-void uart_flush_rx(void) {
-    while (uart_getc_available()) {
-        (void)UART_RX_DATA;  // Discard byte
+void console_flush_rx(void) {
+    uint8_t discard;
+    while (console_getc_available()) {
+        uartmux_read(UARTMUX_CH_CONSOLE, &discard, 1);
     }
 }
 
 int getc_timeout(uint32_t timeout_ms) {
     uint32_t start = get_time_ms();
     while ((get_time_ms() - start) < timeout_ms) {
-        if (uart_getc_available()) {
-            return (int)(UART_RX_DATA & 0xFF);  // Return byte as positive int
+        if (console_getc_available()) {
+            return (int)(uint8_t)console_getc();  // Return byte as positive int
         }
     }
     return -1;  // Timeout - returns proper -1 as int
@@ -143,8 +116,11 @@ int getc_timeout(uint32_t timeout_ms) {
 void irq_handler(uint32_t irqs) {
     // Check if Timer interrupt (IRQ[0])
     if (irqs & (1 << 0)) {
+        TRACE_IRQ_ENTER("timer");
+
         // CRITICAL: Clear the interrupt source FIRST
-        TIMER_SR = TIMER_SR_UIF;  // Write 1 to clear
+        timer_clear_irq();        // Write 1 to clear
+        TRACE_TIMER_IRQ();        // Trace timestamps count timer periods
 
         // Update millisecond counter (60 Hz = ~16.67ms per tick)
         millis += 17;  // Approximate: 1000ms / 60Hz ≈ 16.67ms
@@ -174,6 +150,7 @@ void irq_handler(uint32_t irqs) {
         }
 
         clock_updated = 1;  // Signal main loop
+        TRACE_IRQ_EXIT("timer");
     }
 }
 
@@ -182,23 +159,19 @@ void irq_handler(uint32_t irqs) {
 //==============================================================================
 
 // Initialize timer for 60 Hz interrupts (50MHz system clock)
-void timer_init(void) {
-    // Stop timer if running
-    TIMER_CR = 0x00000000;
-
-    // Clear any pending interrupt
-    TIMER_SR = 0x00000001;
+void clock_init(void) {
+    // Stop timer if running, clear any pending interrupt
+    timer_init();
 
     // Configure for 60 Hz (16.67ms period)
     // System clock: 50 MHz
     // Prescaler: 49 (divide by 50) → 1 MHz tick rate
     // Auto-reload: 16666 → 1,000,000 / 16,667 = 59.998 Hz ≈ 60 Hz
-    TIMER_PSC = 49;
-    TIMER_ARR = 16666;
+    timer_config(49, 16666);
     TIMER_CNT = 0;
 
     // Start timer (continuous mode, generates interrupts)
-    TIMER_CR = 0x00000001;
+    timer_start();
 }
 
 // Get current time in milliseconds
@@ -221,8 +194,8 @@ int hex_to_val(char c) {
 // Print hex byte
 void print_hex_byte(uint8_t b) {
     const char hex[] = "0123456789ABCDEF";
-    uart_putc(hex[b >> 4]);
-    uart_putc(hex[b & 0x0F]);
+    console_putc(hex[b >> 4]);
+    console_putc(hex[b & 0x0F]);
 }
 
 // Print hex word (32-bit)
@@ -239,7 +212,7 @@ void print_dec(uint32_t n) {
     int i = 0;
 
     if (n == 0) {
-        uart_putc('0');
+        console_putc('0');
         return;
     }
 
@@ -249,7 +222,7 @@ void print_dec(uint32_t n) {
     }
 
     while (i > 0) {
-        uart_putc(buf[--i]);
+        console_putc(buf[--i]);
     }
 }
 
@@ -263,28 +236,28 @@ void cmd_dump(uint32_t addr, uint32_t len) {
     for (uint32_t i = 0; i < len; i += 16) {
         // Print address
         print_hex_word(addr + i);
-        uart_puts(": ");
+        console_puts(": ");
 
         // Print hex bytes
         for (int j = 0; j < 16 && (i + j) < len; j++) {
             print_hex_byte(ptr[i + j]);
-            uart_putc(' ');
+            console_putc(' ');
         }
 
         // Padding for short lines
         for (int j = len - i; j < 16 && j >= 0; j++) {
-            uart_puts("   ");
+            console_puts("   ");
         }
 
-        uart_puts(" |");
+        console_puts(" |");
 
         // Print ASCII
         for (int j = 0; j < 16 && (i + j) < len; j++) {
             char c = ptr[i + j];
-            uart_putc((c >= 32 && c < 127) ? c : '.');
+            console_putc((c >= 32 && c < 127) ? c : '.');
         }
 
-        uart_puts("|\n");
+        console_puts("|\n");
     }
 
     // Save for pagination
@@ -295,77 +268,91 @@ void cmd_dump(uint32_t addr, uint32_t len) {
 void cmd_write(uint32_t addr, uint8_t value) {
     uint8_t *ptr = (uint8_t *)addr;
     *ptr = value;
-    uart_puts("Wrote 0x");
+    console_puts("Wrote 0x");
     print_hex_byte(value);
-    uart_puts(" to 0x");
+    console_puts(" to 0x");
     print_hex_word(addr);
-    uart_puts("\n");
+    console_puts("\n");
 }
 
 void cmd_read(uint32_t addr) {
     uint8_t *ptr = (uint8_t *)addr;
-    uart_puts("0x");
+    console_puts("0x");
     print_hex_word(addr);
-    uart_puts(" = 0x");
+    console_puts(" = 0x");
     print_hex_byte(*ptr);
-    uart_puts("\n");
+    console_puts("\n");
 }
 
 void cmd_copy(uint32_t src, uint32_t dst, uint32_t len) {
-    uart_puts("Copying ");
+    console_puts("Copying ");
     print_dec(len);
-    uart_puts(" bytes from 0x");
+    console_puts(" bytes from 0x");
     print_hex_word(src);
-    uart_puts(" to 0x");
+    console_puts(" to 0x");
     print_hex_word(dst);
-    uart_puts("\n");
+    console_puts("\n");
 
     // Use memmove for safe overlapping copy
     memmove((void *)dst, (void *)src, len);
 
-    uart_puts("Done.\n");
+    console_puts("Done.\n");
 }
 
 void cmd_fill(uint32_t addr, uint32_t len, uint8_t value) {
     memset((void *)addr, value, len);
-    uart_puts("Filled ");
+    console_puts("Filled ");
     print_dec(len);
-    uart_puts(" bytes at 0x");
+    console_puts(" bytes at 0x");
     print_hex_word(addr);
-    uart_puts(" with 0x");
+    console_puts(" with 0x");
     print_hex_byte(value);
-    uart_puts("\n");
+    console_puts("\n");
 }
 
 //==============================================================================
 // Simple Upload Protocol Commands
 //==============================================================================
 
-// UART callbacks for simple_upload
+// UART callbacks for simple_upload: the uartmux data channel while the
+// host demultiplexer is attached (console stays usable), else the raw UART
 static void simple_uart_putc(uint8_t c) {
-    while (UART_TX_STATUS & 1);  // Wait while busy
-    UART_TX_DATA = c;
+    if (uartmux_framed()) {
+        uartmux_write(UARTMUX_CH_DATA, &c, 1);
+        return;
+    }
+    uart_putc(c);
 }
 
 static uint8_t simple_uart_getc(void) {
-    while (!(UART_RX_STATUS & 1));  // Wait until data available
-    return UART_RX_DATA & 0xFF;
+    if (uartmux_framed()) {
+        return uartmux_getc(UARTMUX_CH_DATA);
+    }
+    return uart_getc();
 }
 
 void cmd_simple_upload(uint32_t addr) {
     // Flush UART RX buffer FIRST
-    uart_flush_rx();
+    console_flush_rx();
+    if (uartmux_framed()) {
+        uint8_t discard;
+        while (uartmux_read(UARTMUX_CH_DATA, &discard, 1));
+    }
 
-    uart_puts("\n");
-    uart_puts("=== Simple Upload (bootloader protocol) ===\n");
-    uart_puts("Receiving file to address: 0x");
+    console_puts("\n");
+    console_puts("=== Simple Upload (bootloader protocol) ===\n");
+    console_puts("Receiving file to address: 0x");
     print_hex_word(addr);
-    uart_puts("\n");
-    uart_puts("Max size: ");
+    console_puts("\n");
+    console_puts("Max size: ");
     print_dec(ZM_MAX_RECEIVE);
-    uart_puts(" bytes\n");
-    uart_puts("\n");
-    uart_puts("Start fw_upload on your PC now...\n");
+    console_puts(" bytes\n");
+    console_puts("\n");
+    if (uartmux_framed()) {
+        console_puts("Start fw_upload on the uartmux data channel now...\n");
+    } else {
+        console_puts("Start fw_upload on your PC now...\n");
+    }
 
     // Set up callbacks
     simple_callbacks_t callbacks = {
@@ -377,51 +364,30 @@ void cmd_simple_upload(uint32_t addr) {
     int32_t bytes = simple_receive(&callbacks, (uint8_t *)addr, ZM_MAX_RECEIVE);
 
     if (bytes > 0) {
-        uart_puts("\n");
-        uart_puts("*** Upload SUCCESS ***\n");
-        uart_puts("Received: ");
+        console_puts("\n");
+        console_puts("*** Upload SUCCESS ***\n");
+        console_puts("Received: ");
         print_dec((uint32_t)bytes);
-        uart_puts(" bytes\n");
-        uart_puts("Address: 0x");
+        console_puts(" bytes\n");
+        console_puts("Address: 0x");
         print_hex_word(addr);
-        uart_puts("\n");
+        console_puts("\n");
     } else {
-        uart_puts("\n");
-        uart_puts("*** Upload FAILED ***\n");
-        uart_puts("Error code: ");
+        console_puts("\n");
+        console_puts("*** Upload FAILED ***\n");
+        console_puts("Error code: ");
         print_dec((uint32_t)(-bytes));
-        uart_puts("\n");
+        console_puts("\n");
     }
 }
 
 //==============================================================================
-// CRC32 Helper Functions (matches simple_upload.c polynomial)
+// CRC32 Helper Functions (lib/crc32, same polynomial as simple_upload.c)
 //==============================================================================
 
-static uint32_t crc32_table[256];
-static int crc32_initialized = 0;
-
-static void crc32_init(void) {
-    if (crc32_initialized) return;
-    for (int i = 0; i < 256; i++) {
-        uint32_t crc = i;
-        for (int j = 0; j < 8; j++) {
-            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
-        }
-        crc32_table[i] = crc;
-    }
-    crc32_initialized = 1;
-}
-
 // Calculate CRC32 of a memory block
 static uint32_t calculate_crc32(uint32_t start_addr, uint32_t end_addr) {
-    crc32_init();
-    uint32_t crc = 0xFFFFFFFF;
-    for (uint32_t addr = start_addr; addr <= end_addr; addr++) {
-        uint8_t byte = *((uint8_t *)addr);
-        crc = (crc >> 8) ^ crc32_table[(crc ^ byte) & 0xFF];
-    }
-    return ~crc;
+    return crc32((const void *)start_addr, end_addr - start_addr + 1);
 }
 
 //==============================================================================
@@ -1320,7 +1286,7 @@ void cmd_visual(uint32_t start_addr) {
 // Output callback for microRL - print string to UART
 int microrl_output(microrl_t *mrl, const char *str) {
     (void)mrl;  // Unused
-    uart_puts(str);
+    console_puts(str);
     return 0;
 }
 
@@ -1348,7 +1314,9 @@ int microrl_execute(microrl_t *mrl, int argc, const char* const *argv) {
     cmdline[pos] = '\0';
 
     // Execute using existing parser
+    TRACE_BEGIN("command");
     execute_command(cmdline);
+    TRACE_END("command");
 
     return 0;
 }
@@ -1357,6 +1325,13 @@ int microrl_execute(microrl_t *mrl, int argc, const char* const *argv) {
 // Command Parser Utilities
 //==============================================================================
 
+#ifdef TRACE_ENABLED
+// Trace dumps on the uartmux trace channel while the demultiplexer is attached
+static void trace_mux_putc(uint8_t c) {
+    uartmux_putc(UARTMUX_CH_TRACE, c);
+}
+#endif
+
 // Parse hex number from string
 uint32_t parse_hex(const char *str, const char **end) {
     uint32_t val = 0;
@@ -1430,7 +1405,7 @@ void execute_command(const char *cmd) {
             if (len > 0) {
                 cmd_copy(src, dst, len);
             } else {
-                uart_puts("Usage: c <src> <dst> <len>\n");
+                console_puts("Usage: c <src> <dst> <len>\n");
             }
             break;
         }
@@ -1445,7 +1420,7 @@ void execute_command(const char *cmd) {
             if (len > 0) {
                 cmd_fill(addr, len, value);
             } else {
-                uart_puts("Usage: f <addr> <len> <value>\n");
+                console_puts("Usage: f <addr> <len> <value>\n");
             }
             break;
         }
@@ -1462,27 +1437,45 @@ void execute_command(const char *cmd) {
                 }
                 cmd_simple_upload(addr);
             } else {
-                uart_puts("Upload command:\n");
-                uart_puts("  up [addr]  - Upload file (bootloader protocol)\n");
-                uart_puts("               Default addr: 0x");
+                console_puts("Upload command:\n");
+                console_puts("  up [addr]  - Upload file (bootloader protocol)\n");
+                console_puts("               Default addr: 0x");
                 print_hex_word(ZM_BUFFER_ADDR);
-                uart_puts("\n");
+                console_puts("\n");
             }
             break;
         }
 
         case 't':  // Toggle clock display
         case 'T': {
+            // Check if this is 'tr' (dump the event trace)
+            if (*cmd == 'r' || *cmd == 'R') {
+#ifdef TRACE_ENABLED
+                if (uartmux_framed()) {
+                    trace_set_output(trace_mux_putc);
+                    TRACE_DUMP();
+                    uartmux_flush(UARTMUX_CH_TRACE);
+                    trace_set_output(NULL);
+                    console_puts("Trace sent on the uartmux trace channel\n");
+                    break;
+                }
+                console_puts("Capture the UART, then: tools/trace/trace2json.py capture.bin -o trace.json\n");
+                TRACE_DUMP();
+#else
+                console_puts("Event trace not built in (make TARGET=hexedit TRACE=1)\n");
+#endif
+                break;
+            }
             clock_enabled = !clock_enabled;
             if (clock_enabled) {
-                uart_puts("Clock display enabled\n");
+                console_puts("Clock display enabled\n");
             } else {
-                uart_puts("Clock display disabled\n");
+                console_puts("Clock display disabled\n");
                 // Clear the clock area
-                uart_puts("\033[s");         // Save cursor
-                uart_puts("\033[1;60H");     // Move to clock position
-                uart_puts("               ");  // Clear with spaces
-                uart_puts("\033[u");         // Restore cursor
+                console_puts("\033[s");         // Save cursor
+                console_puts("\033[1;60H");     // Move to clock position
+                console_puts("               ");  // Clear with spaces
+                console_puts("\033[u");         // Restore cursor
             }
             break;
         }
@@ -1495,38 +1488,49 @@ void execute_command(const char *cmd) {
             }
             cmd_visual(addr);
             // After exiting visual mode, clear screen and show prompt
-            uart_puts("\033[2J\033[H");  // Clear screen, home cursor
-            uart_puts("Exited visual mode\n");
+            console_puts("\033[2J\033[H");  // Clear screen, home cursor
+            console_puts("Exited visual mode\n");
             break;
         }
 
+#ifdef APP_IMAGE
+        case 'x':  // Exit to the launcher
+        case 'X':
+            exit_requested = 1;
+            break;
+#endif
+
         case 'h':  // Help
         case 'H':
         case '?': {
-            uart_puts("\n");
-            uart_puts("Commands:\n");
-            uart_puts("  d <addr> [len]           - Dump memory (hex+ASCII)\n");
-            uart_puts("  SPACE                    - Page to next 256 bytes\n");
-            uart_puts("  r <addr>                 - Read byte\n");
-            uart_puts("  w <addr> <value>         - Write byte\n");
-            uart_puts("  c <src> <dst> <len>      - Copy memory block\n");
-            uart_puts("  f <addr> <len> <val>     - Fill memory\n");
-            uart_puts("  v [addr]                 - Visual hex editor (curses)\n");
-            uart_puts("  t                        - Toggle clock display on/off\n");
-            uart_puts("  up [addr]                - Upload file (bootloader protocol)\n");
-            uart_puts("  h or ?                   - This help\n");
-            uart_puts("\n");
-            uart_puts("Addresses and values in hex (0x optional)\n");
-            uart_puts("Default dump: 256 bytes (0x100)\n");
-            uart_puts("Transfer buffer at: 0x");
+            console_puts("\n");
+            console_puts("Commands:\n");
+            console_puts("  d <addr> [len]           - Dump memory (hex+ASCII)\n");
+            console_puts("  SPACE                    - Page to next 256 bytes\n");
+            console_puts("  r <addr>                 - Read byte\n");
+            console_puts("  w <addr> <value>         - Write byte\n");
+            console_puts("  c <src> <dst> <len>      - Copy memory block\n");
+            console_puts("  f <addr> <len> <val>     - Fill memory\n");
+            console_puts("  v [addr]                 - Visual hex editor (curses)\n");
+            console_puts("  t                        - Toggle clock display on/off\n");
+            console_puts("  up [addr]                - Upload file (bootloader protocol)\n");
+            console_puts("  tr                       - Dump event trace (TRACE=1 builds)\n");
+#ifdef APP_IMAGE
+            console_puts("  x                        - Exit to the launcher\n");
+#endif
+            console_puts("  h or ?                   - This help\n");
+            console_puts("\n");
+            console_puts("Addresses and values in hex (0x optional)\n");
+            console_puts("Default dump: 256 bytes (0x100)\n");
+            console_puts("Transfer buffer at: 0x");
             print_hex_word(ZM_BUFFER_ADDR);
-            uart_puts(" (128KB max)\n");
-            uart_puts("\n");
+            console_puts(" (128KB max)\n");
+            console_puts("\n");
             break;
         }
 
         default:
-            uart_puts("Unknown command. Type 'h' for help.\n");
+            console_puts("Unknown command. Type 'h' for help.\n");
             break;
     }
 }
@@ -1537,10 +1541,10 @@ void execute_command(const char *cmd) {
 
 void print_clock(void) {
     // Save cursor position
-    uart_puts("\033[s");
+    console_puts("\033[s");
 
     // Move to top-right (row 1, col 60)
-    uart_puts("\033[1;60H");
+    console_puts("\033[1;60H");
 
     // Print clock: HH:MM:SS:FF
     char buf[16];
@@ -1549,10 +1553,32 @@ void print_clock(void) {
              (unsigned int)clock_minutes,
              (unsigned int)clock_seconds,
              (unsigned int)clock_frames);
-    uart_puts(buf);
+    console_puts(buf);
 
     // Restore cursor position
-    uart_puts("\033[u");
+    console_puts("\033[u");
+}
+
+// Once a second on the uartmux telemetry channel; never sent to a plain
+// terminal, so it cannot land in the middle of the console
+static void send_telemetry(void) {
+    static uint32_t last_second = 0xFFFFFFFF;
+    char buf[96];
+
+    if (!uartmux_framed() || clock_seconds == last_second) {
+        return;
+    }
+    last_second = clock_seconds;
+
+    const uartmux_stats_t *st = uartmux_stats();
+    int n = snprintf(buf, sizeof(buf), "uptime %02u:%02u:%02u frames rx %lu tx %lu errors %lu\n",
+                     (unsigned int)clock_hours,
+                     (unsigned int)clock_minutes,
+                     (unsigned int)clock_seconds,
+                     (unsigned long)st->rx_frames,
+                     (unsigned long)st->tx_frames,
+                     (unsigned long)st->rx_errors);
+    uartmux_try_write(UARTMUX_CH_TELEMETRY, buf, (uint32_t)n);
 }
 
 //==============================================================================
@@ -1562,43 +1588,51 @@ void print_clock(void) {
 int main(void) {
     microrl_t mrl;
 
+    // Plain console until tools/uartmux/uartmux.py attaches
+    uartmux_init();
+
     // Initialize hardware timer for 60 Hz interrupts
-    timer_init();
+    clock_init();
+    TRACE_INIT();   // Timestamps from the 60 Hz timer (1 us ticks)
 
     // Enable Timer IRQ (IRQ[0])
-    uart_puts("Enabling timer interrupts...\n");
+    console_puts("Enabling timer interrupts...\n");
     irq_enable();
 
     // Initialize microRL
     microrl_init(&mrl, microrl_output, microrl_execute);
     microrl_set_prompt(&mrl, "> ");
 
-    uart_puts("\n");
-    uart_puts("===========================================\n");
-    uart_puts("  PicoRV32 Hex Editor + microRL\n");
-    uart_puts("===========================================\n");
-    uart_puts("Type 'h' for help, 't' to toggle clock display\n");
-    uart_puts("Features: Command history (UP/DOWN), line editing\n");
-    uart_puts("\n");
+    console_puts("\n");
+    console_puts("===========================================\n");
+    console_puts("  PicoRV32 Hex Editor + microRL\n");
+    console_puts("===========================================\n");
+    console_puts("Type 'h' for help, 't' to toggle clock display\n");
+    console_puts("Features: Command history (UP/DOWN), line editing\n");
+    console_puts("\n");
 
-    while (1) {
+    while (!exit_requested) {
         // Update clock display if timer interrupt fired and enabled
         if (clock_updated && clock_enabled) {
             clock_updated = 0;
+            TRACE_BEGIN("print_clock");
             print_clock();
+            TRACE_END("print_clock");
         }
 
+        send_telemetry();
+
         // Check for UART input (non-blocking)
-        if (!uart_getc_available()) {
+        if (!console_getc_available()) {
             continue;  // No input yet, keep checking clock
         }
 
-        char c = uart_getc();
+        char c = console_getc();
 
         // Spacebar: page to next 256 bytes (special handling before microRL)
         if (c == ' ' && mrl.cmdlen == 0) {
             // Only handle spacebar if command line is empty
-            uart_puts("\n");
+            console_puts("\n");
             uint32_t next_addr = last_dump_addr + last_dump_len;
             cmd_dump(next_addr, 0x100);
             microrl_set_prompt(&mrl, "> ");  // Reprint prompt
@@ -14,53 +14,25 @@
  * Demonstrates Shell <-> CPU mode switching
  */
 
-#define UART_TX_DATA   (*(volatile unsigned int *)0x80000000)
-#define UART_TX_STATUS (*(volatile unsigned int *)0x80000004)
-#define UART_RX_DATA   (*(volatile unsigned int *)0x80000008)
-#define UART_RX_STATUS (*(volatile unsigned int *)0x8000000C)
-#define LED_CONTROL    (*(volatile unsigned int *)0x80000010)
-#define MODE_CONTROL   (*(volatile unsigned int *)0x80000014)
-
-// UART functions
-void putc(char c) {
-    while (UART_TX_STATUS & 1);  // Wait while busy
-    UART_TX_DATA = c;
-}
+#include "hal.h"
 
+// Console output with "\n" -> "\r\n"
 void puts(const char *s) {
     while (*s) {
-        if (*s == '\n') putc('\r');
-        putc(*s++);
+        if (*s == '\n') uart_putc('\r');
+        uart_putc(*s++);
     }
 }
 
-int getc_available(void) {
-    return UART_RX_STATUS & 1;  // Returns 1 if data available
-}
-
-char getc(void) {
-    while (!getc_available());  // Wait for data
-    return UART_RX_DATA & 0xFF;
-}
-
 char getc_nonblocking(void) {
-    if (getc_available())
+    if (uart_getc_available())
         return UART_RX_DATA & 0xFF;
     return 0;
 }
 
 // LED functions
 void set_leds(int led1, int led2) {
-    LED_CONTROL = (led2 << 1) | led1;
-}
-
-// Mode switching
-void switch_to_shell(void) {
-    MODE_CONTROL = 0;  // 0 = Shell mode
-}
-
-void switch_to_app(void) {
-    MODE_CONTROL = 1;  // 1 = App mode (should already be set)
+    led_set((led2 << 1) | led1);
 }
 
 // Simple delay
@@ -91,14 +63,14 @@ int main(void) {
         char c = getc_nonblocking();
 
         if (c) {
-            putc(c);  // Echo
-            putc('\r');
-            putc('\n');
+            uart_putc(c);  // Echo
+            uart_putc('\r');
+            uart_putc('\n');
 
             if (c == 's' || c == 'S') {
                 puts("Switching to SHELL mode...\n");
                 delay(100000);  // Let message finish
-                switch_to_shell();
+                mode_set(0);  // 0 = Shell mode
                 // If we get here, switch didn't work
                 puts("ERROR: Still in APP mode!\n");
             }
@@ -124,7 +96,7 @@ int main(void) {
                 // Print as hex (no division needed)
                 char hex[] = "0123456789ABCDEF";
                 for (int i = 28; i >= 0; i -= 4) {
-                    putc(hex[(counter >> i) & 0xF]);
+                    uart_putc(hex[(counter >> i) & 0xF]);
                 }
                 counter++;
                 puts("\n");
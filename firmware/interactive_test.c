@@ -6,12 +6,6 @@
 // Email: mikewolak@gmail.com, mike@epromfoundry.com
 //===============================================================================
 
-// UART Register Definitions
-#define UART_TX_DATA   (*(volatile unsigned int*)0x80000000)
-#define UART_TX_STATUS (*(volatile unsigned int*)0x80000004)
-#define UART_RX_DATA   (*(volatile unsigned int*)0x80000008)
-#define UART_RX_STATUS (*(volatile unsigned int*)0x8000000C)
-
 // External syscall prototypes
 extern int _write(int file, char *ptr, int len);
 extern int _read(int file, char *ptr, int len);
@@ -45,11 +39,6 @@ static char getchar_blocking(void) {
     return c;
 }
 
-// Check if RX data is available (non-blocking)
-static int uart_available(void) {
-    return !(UART_RX_STATUS & 0x01);
-}
-
 static void print_hex(unsigned int n) {
     const char *digits = "0123456789ABCDEF";
     print("0x");
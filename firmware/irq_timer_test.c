@@ -3,28 +3,16 @@
 
 #include <stdint.h>
 
-// Timer peripheral registers (MMIO)
-#define TIMER_CR   ((volatile uint32_t*)0x80000020)  // Control register
-#define TIMER_SR   ((volatile uint32_t*)0x80000024)  // Status register
-#define TIMER_PSC  ((volatile uint32_t*)0x80000028)  // Prescaler
-#define TIMER_ARR  ((volatile uint32_t*)0x8000002C)  // Auto-reload register
-#define TIMER_CNT  ((volatile uint32_t*)0x80000030)  // Counter
-
-#define LED_CONTROL ((volatile uint32_t*)0x80000008)
+#include "hal.h"
 
 volatile uint32_t interrupt_count = 0;
 
-static inline void irq_enable(void) {
-    uint32_t dummy;
-    __asm__ volatile (".insn r 0x0B, 6, 3, %0, x0, x0" : "=r"(dummy));
-}
-
 void irq_handler(void) {
     // Increment counter
     interrupt_count++;
 
     // Clear timer interrupt flag (write 1 to clear UIF bit)
-    *TIMER_SR = 0x00000001;
+    timer_clear_irq();
 }
 
 int main(void) {
@@ -36,9 +24,8 @@ int main(void) {
     // PSC = 9 → divide by 10 → 5 MHz tick
     // ARR = 499 → 500 ticks → 10 kHz IRQ → 100us period
 
-    *TIMER_PSC = 9;         // Prescaler: divide by 10
-    *TIMER_ARR = 499;       // Auto-reload: 500 ticks (10kHz for fast simulation)
-    *TIMER_CR  = 0x00000001; // Enable timer
+    // Prescaler: divide by 10; auto-reload: 500 ticks (10kHz for fast simulation)
+    timer_periodic(9, 499);
 
     // Wait for 10 interrupts
     while (interrupt_count < 10) {
@@ -46,10 +33,10 @@ int main(void) {
     }
 
     // Disable timer
-    *TIMER_CR = 0x00000000;
+    timer_stop();
 
     // Signal completion with LEDs
-    *LED_CONTROL = 0x3;
+    led_set(LED1 | LED2);
 
     // Infinite loop
     while (1) {
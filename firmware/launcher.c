@@ -0,0 +1,376 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// launcher.c - Resident Multi-Application Launcher
+//
+// Keeps several APP=1 applications in SRAM at once and starts any of them
+// without going back through the bootloader. Each app is received with the
+// bootloader protocol (lib/simple_upload) at an address the launcher picks;
+// fw_upload --base relocates the app for that address before sending it.
+// A run restores the app's .data from a copy taken at load time, start.S
+// clears its .bss and switches to the app's own stack, and returning from
+// main (or exit()) comes back here. Interrupts taken while an app runs are
+// forwarded to its irq_handler.
+//
+// Memory (linker.ld places the launcher itself at 0x0):
+//   launcher .text/.data/.bss/stdio buffers
+//   app arena      rest of the heap, up to __heap_end
+//   launcher stack __stack_size bytes below 0x00080000
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hal.h"
+#include "simple_upload.h"
+#include "app_image.h"
+
+// App arena
+#define APP_ALIGN       256         // Load addresses
+#define APP_MIN_FREE    (16 * 1024) // Smaller gaps are not offered by 'l'
+#define MAX_APPS        8
+
+typedef struct {
+    uint32_t start;
+    uint32_t end;
+} arena_t;
+
+typedef struct {
+    const app_header_t *hdr;        // At the load address
+    uint32_t top;                   // End of footprint, .data copy included
+    const uint8_t *data_copy;       // .data as loaded
+} app_slot_t;
+
+typedef void (*app_irq_t)(uint32_t irqs, uint32_t pc, uint32_t fp);
+
+extern char __heap_end[];           // Launcher stack reservation above
+
+static arena_t arena;
+static app_slot_t apps[MAX_APPS];
+static int app_count;
+
+// Handler of the running app (NULL while the launcher itself runs)
+static volatile app_irq_t app_irq;
+
+//==============================================================================
+// Console
+//==============================================================================
+
+// Line input with echo and backspace
+static void read_line(char *buf, int size) {
+    int len = 0;
+
+    fflush(stdout);
+    while (1) {
+        char c = (char)uart_getc();
+        if (c == '\r' || c == '\n') {
+            break;
+        }
+        if ((c == 8 || c == 127) && len > 0) {
+            len--;
+            printf("\b \b");
+        } else if (c >= 32 && c < 127 && len < size - 1) {
+            buf[len++] = c;
+            putchar(c);
+        }
+        fflush(stdout);
+    }
+    buf[len] = '\0';
+    printf("\r\n");
+}
+
+//==============================================================================
+// Interrupts
+//==============================================================================
+
+// Called from start.S irq_vec; the app's handler clears its sources
+void irq_handler(uint32_t irqs, uint32_t pc, uint32_t fp) {
+    app_irq_t handler = app_irq;
+
+    if (handler) {
+        handler(irqs, pc, fp);
+    }
+}
+
+// Leave no interrupt source running after an app returns
+static void irq_quiesce(void) {
+    irq_disable();
+    timer_init();
+    app_irq = NULL;
+}
+
+//==============================================================================
+// Arenas
+//==============================================================================
+
+static uint32_t align_up(uint32_t value, uint32_t align) {
+    return (value + align - 1) & ~(align - 1);
+}
+
+// Called after the banner, once newlib has allocated its stdio buffers:
+// the rest of the heap becomes the app arena, and later mallocs fail
+// cleanly instead of growing into an app
+static void arena_init(void) {
+    uint32_t brk = (uint32_t)sbrk(0);
+
+    arena.start = align_up(brk, APP_ALIGN);
+    arena.end = (uint32_t)__heap_end;
+    if (arena.start >= arena.end) {
+        arena.start = arena.end;
+    } else {
+        sbrk(arena.end - brk);
+    }
+}
+
+// First address above `addr` taken by an app (or the arena end)
+static uint32_t next_used(uint32_t addr) {
+    uint32_t limit = arena.end;
+
+    for (int i = 0; i < app_count; i++) {
+        uint32_t base = apps[i].hdr->base;
+        if (base >= addr && base < limit) {
+            limit = base;
+        }
+    }
+    return limit;
+}
+
+// App occupying `addr`, or -1
+static int app_at(uint32_t addr) {
+    for (int i = 0; i < app_count; i++) {
+        if (addr >= apps[i].hdr->base && addr < apps[i].top) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Lowest free address with at least APP_MIN_FREE bytes after it
+static uint32_t find_free(void) {
+    uint32_t addr = arena.start;
+
+    while (addr < arena.end) {
+        int i = app_at(addr);
+        if (i >= 0) {
+            addr = align_up(apps[i].top, APP_ALIGN);
+            continue;
+        }
+        uint32_t limit = next_used(addr);
+        if (limit - addr >= APP_MIN_FREE) {
+            return addr;
+        }
+        addr = limit;
+    }
+    return 0;
+}
+
+//==============================================================================
+// Commands
+//==============================================================================
+
+static void cmd_list(void) {
+    printf("\r\n");
+    printf("  #  Name                      Address    Footprint\r\n");
+    for (int i = 0; i < app_count; i++) {
+        const app_header_t *hdr = apps[i].hdr;
+        printf("  %d  %-24.24s  0x%05lX    %lu bytes\r\n", i + 1, hdr->name,
+               (unsigned long)hdr->base, (unsigned long)(apps[i].top - hdr->base));
+    }
+    if (app_count == 0) {
+        printf("  (no apps loaded)\r\n");
+    }
+    printf("  Arena: 0x%05lX - 0x%05lX\r\n",
+           (unsigned long)arena.start, (unsigned long)arena.end);
+    printf("\r\n");
+}
+
+static void cmd_load(uint32_t base) {
+    simple_callbacks_t callbacks = {
+        .putc = uart_putc,
+        .getc = uart_getc
+    };
+
+    if (app_count == MAX_APPS) {
+        printf("All %d app slots in use, 'd' one first\r\n", MAX_APPS);
+        return;
+    }
+    if (base == 0) {
+        base = find_free();
+        if (base == 0) {
+            printf("No free space left, 'd' an app first\r\n");
+            return;
+        }
+    }
+
+    if (base < arena.start || base >= arena.end || (base & 3) || app_at(base) >= 0) {
+        printf("0x%05lX is not free app memory\r\n", (unsigned long)base);
+        return;
+    }
+    uint32_t limit = next_used(base);
+
+    printf("\r\nLoad address 0x%05lX, up to %lu bytes\r\n",
+           (unsigned long)base, (unsigned long)(limit - base));
+    printf("Start on your PC now:\r\n");
+    printf("  fw_upload -p <port> --base 0x%lX <name>.app.elf\r\n", (unsigned long)base);
+    fflush(stdout);
+
+    uart_flush_rx();
+    int32_t bytes = simple_receive(&callbacks, (uint8_t *)base, limit - base);
+    if (bytes <= 0) {
+        printf("\r\n*** Upload FAILED (error %ld) ***\r\n", (long)-bytes);
+        return;
+    }
+
+    // The image must carry a header relocated for this very address
+    const app_header_t *hdr = (const app_header_t *)base;
+    if (hdr->magic != APP_MAGIC) {
+        printf("\r\nNot an app image (build it with APP=1)\r\n");
+        return;
+    }
+    if (hdr->base != base) {
+        printf("\r\nImage relocated for 0x%05lX, not 0x%05lX (fw_upload --base)\r\n",
+               (unsigned long)hdr->base, (unsigned long)base);
+        return;
+    }
+    if (hdr->entry < base || hdr->entry >= base + (uint32_t)bytes ||
+        hdr->data_start > hdr->data_end || hdr->data_end > hdr->end) {
+        printf("\r\nCorrupt app header\r\n");
+        return;
+    }
+
+    uint32_t data_size = hdr->data_end - hdr->data_start;
+    uint32_t copy = align_up(hdr->end, 4);
+    uint32_t top = copy + data_size;
+    if (top > limit) {
+        printf("\r\n%s needs %lu bytes here, only %lu free\r\n", hdr->name,
+               (unsigned long)(top - base), (unsigned long)(limit - base));
+        return;
+    }
+
+    memcpy((void *)copy, (const void *)hdr->data_start, data_size);
+    apps[app_count].hdr = hdr;
+    apps[app_count].top = top;
+    apps[app_count].data_copy = (const uint8_t *)copy;
+    app_count++;
+
+    printf("\r\nLoaded %.24s as app %d (%ld bytes image, %lu bytes footprint)\r\n",
+           hdr->name, app_count, (long)bytes, (unsigned long)(top - base));
+}
+
+static void cmd_delete(int n) {
+    if (n < 1 || n > app_count) {
+        printf("No app %d\r\n", n);
+        return;
+    }
+    printf("Removed %.24s\r\n", apps[n - 1].hdr->name);
+    memmove(&apps[n - 1], &apps[n], (app_count - n) * sizeof(apps[0]));
+    app_count--;
+}
+
+static void app_run(int n) {
+    if (n < 1 || n > app_count) {
+        printf("No app %d\r\n", n);
+        return;
+    }
+
+    const app_slot_t *app = &apps[n - 1];
+    const app_header_t *hdr = app->hdr;
+
+    printf("Starting %.24s...\r\n", hdr->name);
+    fflush(stdout);
+
+    // Fresh .data every run; start.S clears .bss and sets the app's stack
+    memcpy((void *)hdr->data_start, app->data_copy, hdr->data_end - hdr->data_start);
+    app_irq = (app_irq_t)hdr->irq;
+    int status = ((int (*)(void))hdr->entry)();
+    irq_quiesce();
+
+    printf("\r\n%.24s exited with status %d\r\n", hdr->name, status);
+}
+
+static void show_help(void) {
+    printf("\r\n");
+    printf("Commands:\r\n");
+    printf("  l [addr]   - Load an app (default: first free address)\r\n");
+    printf("  1-%d        - Run app n\r\n", MAX_APPS);
+    printf("  a          - List apps and the arena\r\n");
+    printf("  d <n>      - Remove app n\r\n");
+    printf("  h or ?     - This help\r\n");
+    printf("\r\n");
+    printf("Build apps with: make -C firmware apps (or TARGET=name USE_NEWLIB=1 APP=1)\r\n");
+    printf("\r\n");
+}
+
+//==============================================================================
+// Main
+//==============================================================================
+
+int main(void) {
+    char line[32];
+
+    irq_quiesce();
+
+    printf("\r\n\r\n");
+    printf("========================================\r\n");
+    printf("  Resident App Launcher\r\n");
+    printf("========================================\r\n");
+    fflush(stdout);
+
+    arena_init();
+    show_help();
+
+    while (1) {
+        printf("launcher> ");
+        read_line(line, sizeof(line));
+
+        const char *arg = line;
+        while (*arg == ' ') arg++;
+        char op = *arg;
+        if (op == '\0') {
+            continue;
+        }
+        arg++;
+
+        if (op >= '1' && op <= '9') {
+            app_run(op - '0');
+            continue;
+        }
+
+        switch (op) {
+            case 'l':
+            case 'L':
+                cmd_load((uint32_t)strtoul(arg, NULL, 16));
+                break;
+
+            case 'a':
+            case 'A':
+                cmd_list();
+                break;
+
+            case 'd':
+            case 'D':
+                cmd_delete((int)strtol(arg, NULL, 10));
+                break;
+
+            case 'h':
+            case 'H':
+            case '?':
+                show_help();
+                break;
+
+            default:
+                printf("Unknown command '%c', 'h' for help\r\n", op);
+                break;
+        }
+    }
+
+    return 0;
+}
@@ -5,6 +5,7 @@
 // Controls:
 //   R: Reset to default view
 //   +/-: Adjust max iterations
+//   T: Dump event trace (TRACE=1 builds, see tools/trace)
 //   Q: Quit
 //==============================================================================
 
@@ -13,28 +14,8 @@
 #include <stdbool.h>
 #include <curses.h>
 #include "timer_ms.h"
-
-//==============================================================================
-// Hardware UART (required by incurses)
-//==============================================================================
-#define UART_TX_DATA   (*(volatile uint32_t *)0x80000000)
-#define UART_TX_STATUS (*(volatile uint32_t *)0x80000004)
-#define UART_RX_DATA   (*(volatile uint32_t *)0x80000008)
-#define UART_RX_STATUS (*(volatile uint32_t *)0x8000000C)
-
-void uart_putc(char c) {
-    while (UART_TX_STATUS & 1);
-    UART_TX_DATA = c;
-}
-
-int uart_getc_available(void) {
-    return UART_RX_STATUS & 1;
-}
-
-char uart_getc(void) {
-    while (!uart_getc_available());
-    return UART_RX_DATA & 0xFF;
-}
+#include "../lib/trace/trace.h"
+#include "hal.h"
 
 //==============================================================================
 // VT100 Terminal Size Detection
@@ -111,7 +92,10 @@ static bool query_terminal_size(void) {
 //==============================================================================
 void irq_handler(uint32_t irqs) {
     if (irqs & (1 << 0)) {
+        TRACE_IRQ_ENTER("timer");
         timer_ms_irq_handler();
+        TRACE_TIMER_IRQ();
+        TRACE_IRQ_EXIT("timer");
     }
 }
 
@@ -205,6 +189,7 @@ static void draw_mandelbrot(WINDOW *win) {
 
     // TIMING START - Only measure calculation, not UART display!
     uint32_t start_time = get_millis();
+    TRACE_BEGIN("render");
 
     int32_t imag = state.min_imag;
 
@@ -246,13 +231,16 @@ static void draw_mandelbrot(WINDOW *win) {
         }
 
         imag += imag_step;  // Just integer add!
+        TRACE_COUNTER("iterations", total_iters);
     }
 
     // TIMING END - Stop before UART display
+    TRACE_END("render");
     state.last_calc_time_ms = get_millis() - start_time;
     state.last_total_iters = total_iters;
 
     // Now display to screen (not timed)
+    TRACE_BEGIN("display");
     for (int row = 0; row < SCREEN_HEIGHT; row++) {
         wmove(win, row, 0);
         for (int col = 0; col < SCREEN_WIDTH; col++) {
@@ -263,6 +251,7 @@ static void draw_mandelbrot(WINDOW *win) {
     }
 
     wrefresh(win);
+    TRACE_END("display");
 }
 
 //==============================================================================
@@ -331,6 +320,7 @@ int main(int argc, char **argv) {
 
     // Initialize timer (needed for query_terminal_size timeout)
     timer_ms_init();
+    TRACE_INIT();   // Timestamps from the 1 ms timer (1 us ticks)
 
     // Detect terminal size before initializing curses
     printf("Detecting terminal size...\r\n");
@@ -410,6 +400,14 @@ int main(int argc, char **argv) {
                     needs_redraw = true;
                     break;
 
+                // Dump the event trace (raw frames, redraw afterwards)
+                case 't':
+                case 'T':
+                    TRACE_DUMP();
+                    wclear(stdscr);
+                    needs_redraw = true;
+                    break;
+
                 // Adjust max iterations
                 case '+':
                 case '=':
@@ -1,10 +1,12 @@
 //==============================================================================
 // Mandelbrot Set - FLOATING-POINT VERSION
 //==============================================================================
-// Uses floating-point for coordinate calculations (software emulated on PicoRV32)
+// Uses floating-point for coordinate calculations (software emulated on PicoRV32;
+// the info bar names the runtime: lib/softfloat, or libgcc with SOFTFLOAT=0)
 // Controls:
 //   R: Reset to default view
 //   +/-: Adjust max iterations
+//   T: Dump event trace (TRACE=1 builds, see tools/trace)
 //   Q: Quit
 //==============================================================================
 
@@ -13,28 +15,13 @@
 #include <stdbool.h>
 #include <curses.h>
 #include "timer_ms.h"
+#include "../lib/trace/trace.h"
+#include "hal.h"
 
-//==============================================================================
-// Hardware UART (required by incurses)
-//==============================================================================
-#define UART_TX_DATA   (*(volatile uint32_t *)0x80000000)
-#define UART_TX_STATUS (*(volatile uint32_t *)0x80000004)
-#define UART_RX_DATA   (*(volatile uint32_t *)0x80000008)
-#define UART_RX_STATUS (*(volatile uint32_t *)0x8000000C)
-
-void uart_putc(char c) {
-    while (UART_TX_STATUS & 1);
-    UART_TX_DATA = c;
-}
-
-int uart_getc_available(void) {
-    return UART_RX_STATUS & 1;
-}
-
-char uart_getc(void) {
-    while (!uart_getc_available());
-    return UART_RX_DATA & 0xFF;
-}
+// Soft-float runtime this build links (set by the Makefile)
+#ifndef FLOAT_RUNTIME
+#define FLOAT_RUNTIME "libgcc"
+#endif
 
 //==============================================================================
 // VT100 Terminal Size Detection
@@ -111,7 +98,10 @@ static bool query_terminal_size(void) {
 //==============================================================================
 void irq_handler(uint32_t irqs) {
     if (irqs & (1 << 0)) {
+        TRACE_IRQ_ENTER("timer");
         timer_ms_irq_handler();
+        TRACE_TIMER_IRQ();
+        TRACE_IRQ_EXIT("timer");
     }
 }
 
@@ -230,6 +220,7 @@ static void draw_mandelbrot(WINDOW *win) {
 
     // TIMING START - Only measure calculation, not UART display!
     uint32_t start_time = get_millis();
+    TRACE_BEGIN("render");
 
     for (int row = 0; row < SCREEN_HEIGHT; row++) {
         for (int col = 0; col < SCREEN_WIDTH; col++) {
@@ -245,13 +236,16 @@ static void draw_mandelbrot(WINDOW *win) {
                 render_buffer[row][col] = ch[0];
             }
         }
+        TRACE_COUNTER("iterations", total_iters);
     }
 
     // TIMING END - Stop before UART display
+    TRACE_END("render");
     state.last_calc_time_ms = get_millis() - start_time;
     state.last_total_iters = total_iters;
 
     // Now display to screen (not timed)
+    TRACE_BEGIN("display");
     for (int row = 0; row < SCREEN_HEIGHT; row++) {
         wmove(win, row, 0);
         for (int col = 0; col < SCREEN_WIDTH; col++) {
@@ -262,6 +256,7 @@ static void draw_mandelbrot(WINDOW *win) {
     }
 
     wrefresh(win);
+    TRACE_END("display");
 }
 
 //==============================================================================
@@ -302,8 +297,8 @@ static void draw_info_bar(void) {
         mips = (double)state.last_total_iters / (double)state.last_calc_time_ms / 1000.0;
     }
 
-    printw("FLOATING-POINT | Display: %dx%d | Iter: %d | Time: %lums | %.2fM iter/s",
-           g_term_cols, g_term_rows, state.max_iter,
+    printw("FLOATING-POINT (%s) | Display: %dx%d | Iter: %d | Time: %lums | %.2fM iter/s",
+           FLOAT_RUNTIME, g_term_cols, g_term_rows, state.max_iter,
            (unsigned long)state.last_calc_time_ms, mips);
 
     move(SCREEN_HEIGHT + 1, 0);
@@ -328,6 +323,7 @@ int main(int argc, char **argv) {
 
     // Initialize timer (needed for query_terminal_size timeout)
     timer_ms_init();
+    TRACE_INIT();   // Timestamps from the 1 ms timer (1 us ticks)
 
     // Detect terminal size before initializing curses
     printf("Detecting terminal size...\r\n");
@@ -407,6 +403,14 @@ int main(int argc, char **argv) {
                     needs_redraw = true;
                     break;
 
+                // Dump the event trace (raw frames, redraw afterwards)
+                case 't':
+                case 'T':
+                    TRACE_DUMP();
+                    wclear(stdscr);
+                    needs_redraw = true;
+                    break;
+
                 // Adjust max iterations
                 case '+':
                 case '=':
@@ -451,6 +455,7 @@ int main(int argc, char **argv) {
     endwin();
 
     printf("\r\n\r\nMandelbrot Explorer (FLOATING-POINT) exited.\r\n");
+    printf("Float runtime: %s\r\n", FLOAT_RUNTIME);
     printf("Max iterations: %d\r\n", state.max_iter);
     printf("Last calculation time: %lu ms\r\n", (unsigned long)state.last_calc_time_ms);
     printf("Performance: %.2f M iter/s\r\n",
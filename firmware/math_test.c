@@ -9,27 +9,45 @@
 #include <stdio.h>
 #include <math.h>
 #include <float.h>
+#include <stdarg.h>
+
+#include "bench.h"
+#include "fixmath.h"
+
+// Batch mode repetitions per test (make BATCH_REPS=n)
+#ifndef BATCH_REPS
+#define BATCH_REPS 3
+#endif
 
 // UART direct access for menu (no echo, no buffering)
-#define UART_RX_DATA   (*(volatile unsigned int*)0x80000008)
-#define UART_RX_STATUS (*(volatile unsigned int*)0x8000000C)
+#include "hal.h"
 
 #define TOLERANCE 0.0001
 
 static int getch(void) {
-    while (!(UART_RX_STATUS & 0x01));
-    return UART_RX_DATA & 0xFF;
+    return uart_getc();
+}
+
+// Test output, silenced while the batch runner times a test
+__attribute__((format(printf, 1, 2)))
+static void tprintf(const char *fmt, ...) {
+    va_list ap;
+
+    if (bench_quiet) return;
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
 }
 
 static int check_float(const char *name, double result, double expected) {
     double diff = fabs(result - expected);
     int pass = (diff < TOLERANCE) || (fabs(diff / expected) < TOLERANCE);
 
-    printf("  %s: ", name);
+    tprintf("  %s: ", name);
     if (pass) {
-        printf("PASS (%.6f)\r\n", result);
+        tprintf("PASS (%.6f)\r\n", result);
     } else {
-        printf("FAIL (got %.6f, expected %.6f, diff %.6f)\r\n",
+        tprintf("FAIL (got %.6f, expected %.6f, diff %.6f)\r\n",
                result, expected, diff);
     }
     return pass;
@@ -39,8 +57,8 @@ static int check_float(const char *name, double result, double expected) {
 // Test Functions
 //==============================================================================
 
-static void test_basic_operations(void) {
-    printf("\r\n=== Basic Operations ===\r\n");
+static int test_basic_operations(void) {
+    tprintf("\r\n=== Basic Operations ===\r\n");
     int pass = 0, total = 0;
 
     total++; pass += check_float("sqrt(4)", sqrt(4.0), 2.0);
@@ -53,11 +71,12 @@ static void test_basic_operations(void) {
     total++; pass += check_float("floor(3.7)", floor(3.7), 3.0);
     total++; pass += check_float("fmod(5.3,2)", fmod(5.3, 2.0), 1.3);
 
-    printf("Result: %d/%d passed\r\n", pass, total);
+    tprintf("Result: %d/%d passed\r\n", pass, total);
+    return pass == total;
 }
 
-static void test_trigonometry(void) {
-    printf("\r\n=== Trigonometry ===\r\n");
+static int test_trigonometry(void) {
+    tprintf("\r\n=== Trigonometry ===\r\n");
     int pass = 0, total = 0;
 
     total++; pass += check_float("sin(0)", sin(0.0), 0.0);
@@ -73,11 +92,12 @@ static void test_trigonometry(void) {
     total++; pass += check_float("atan(1)", atan(1.0), M_PI/4);
     total++; pass += check_float("atan2(1,1)", atan2(1.0, 1.0), M_PI/4);
 
-    printf("Result: %d/%d passed\r\n", pass, total);
+    tprintf("Result: %d/%d passed\r\n", pass, total);
+    return pass == total;
 }
 
-static void test_hyperbolic(void) {
-    printf("\r\n=== Hyperbolic Functions ===\r\n");
+static int test_hyperbolic(void) {
+    tprintf("\r\n=== Hyperbolic Functions ===\r\n");
     int pass = 0, total = 0;
 
     total++; pass += check_float("sinh(0)", sinh(0.0), 0.0);
@@ -90,11 +110,12 @@ static void test_hyperbolic(void) {
     total++; pass += check_float("acosh(2)", acosh(2.0), 1.316957897);
     total++; pass += check_float("atanh(0.5)", atanh(0.5), 0.549306144);
 
-    printf("Result: %d/%d passed\r\n", pass, total);
+    tprintf("Result: %d/%d passed\r\n", pass, total);
+    return pass == total;
 }
 
-static void test_exponential_log(void) {
-    printf("\r\n=== Exponential & Logarithmic ===\r\n");
+static int test_exponential_log(void) {
+    tprintf("\r\n=== Exponential & Logarithmic ===\r\n");
     int pass = 0, total = 0;
 
     total++; pass += check_float("exp(0)", exp(0.0), 1.0);
@@ -109,41 +130,43 @@ static void test_exponential_log(void) {
     total++; pass += check_float("exp2(3)", exp2(3.0), 8.0);
     total++; pass += check_float("log2(8)", log2(8.0), 3.0);
 
-    printf("Result: %d/%d passed\r\n", pass, total);
+    tprintf("Result: %d/%d passed\r\n", pass, total);
+    return pass == total;
 }
 
-static void test_special_values(void) {
-    printf("\r\n=== Special Values ===\r\n");
+static int test_special_values(void) {
+    tprintf("\r\n=== Special Values ===\r\n");
     int pass = 0, total = 0;
 
     // Test infinity
     double inf = INFINITY;
     double ninf = -INFINITY;
 
-    printf("  INFINITY: %s\r\n", isinf(inf) ? "PASS" : "FAIL");
-    total++; pass += isinf(inf);
+    tprintf("  INFINITY: %s\r\n", isinf(inf) ? "PASS" : "FAIL");
+    total++; pass += isinf(inf) != 0;
 
-    printf("  -INFINITY: %s\r\n", isinf(ninf) ? "PASS" : "FAIL");
-    total++; pass += isinf(ninf);
+    tprintf("  -INFINITY: %s\r\n", isinf(ninf) ? "PASS" : "FAIL");
+    total++; pass += isinf(ninf) != 0;
 
     // Test NaN
     double nan_val = NAN;
-    printf("  NAN: %s\r\n", isnan(nan_val) ? "PASS" : "FAIL");
-    total++; pass += isnan(nan_val);
+    tprintf("  NAN: %s\r\n", isnan(nan_val) ? "PASS" : "FAIL");
+    total++; pass += isnan(nan_val) != 0;
 
-    printf("  sqrt(-1) -> NAN: %s\r\n", isnan(sqrt(-1.0)) ? "PASS" : "FAIL");
-    total++; pass += isnan(sqrt(-1.0));
+    tprintf("  sqrt(-1) -> NAN: %s\r\n", isnan(sqrt(-1.0)) ? "PASS" : "FAIL");
+    total++; pass += isnan(sqrt(-1.0)) != 0;
 
     // Test zero
     total++; pass += check_float("copysign(1,-1)", copysign(1.0, -1.0), -1.0);
     total++; pass += check_float("fmax(3,5)", fmax(3.0, 5.0), 5.0);
     total++; pass += check_float("fmin(3,5)", fmin(3.0, 5.0), 3.0);
 
-    printf("Result: %d/%d passed\r\n", pass, total);
+    tprintf("Result: %d/%d passed\r\n", pass, total);
+    return pass == total;
 }
 
-static void test_rounding(void) {
-    printf("\r\n=== Rounding Functions ===\r\n");
+static int test_rounding(void) {
+    tprintf("\r\n=== Rounding Functions ===\r\n");
     int pass = 0, total = 0;
 
     total++; pass += check_float("ceil(3.1)", ceil(3.1), 4.0);
@@ -155,12 +178,13 @@ static void test_rounding(void) {
     total++; pass += check_float("round(3.5)", round(3.5), 4.0);
     total++; pass += check_float("round(3.4)", round(3.4), 3.0);
 
-    printf("Result: %d/%d passed\r\n", pass, total);
+    tprintf("Result: %d/%d passed\r\n", pass, total);
+    return pass == total;
 }
 
-static void test_stress_computation(void) {
-    printf("\r\n=== Stress Test (30 seconds) ===\r\n");
-    printf("Computing 100,000 mixed math operations...\r\n");
+static int test_stress_computation(void) {
+    tprintf("\r\n=== Stress Test (30 seconds) ===\r\n");
+    tprintf("Computing 100,000 mixed math operations...\r\n");
     fflush(stdout);
 
     unsigned int iterations = 100000;
@@ -174,14 +198,157 @@ static void test_stress_computation(void) {
         sum += result;
 
         if (i % 10000 == 0) {
-            printf("  %u iterations complete...\r\n", i);
+            tprintf("  %u iterations complete...\r\n", i);
             fflush(stdout);
         }
     }
 
-    printf("\r\nCompleted %u iterations\r\n", iterations);
-    printf("Final sum: %.10f\r\n", sum);
-    printf("PASS (no crashes)\r\n");
+    tprintf("\r\nCompleted %u iterations\r\n", iterations);
+    tprintf("Final sum: %.10f\r\n", sum);
+    tprintf("PASS (no crashes)\r\n");
+    return !isnan(sum);
+}
+
+//==============================================================================
+// lib/fixmath vs. libm - accuracy and cycles per call
+//==============================================================================
+
+#define FIX_SAMPLES 64
+
+static int32_t fix_a[FIX_SAMPLES], fix_b[FIX_SAMPLES], fix_out[FIX_SAMPLES];
+static double dbl_a[FIX_SAMPLES], dbl_b[FIX_SAMPLES], dbl_out[FIX_SAMPLES];
+
+// One timed loop per implementation; inputs are identical values
+#define FIX_CASE(id, fix_expr, ref_expr)                                    \
+    static uint64_t id##_fix(void) {                                        \
+        uint64_t t0 = bench_cycles();                                       \
+        for (int i = 0; i < FIX_SAMPLES; i++) fix_out[i] = (fix_expr);      \
+        return bench_cycles() - t0;                                         \
+    }                                                                       \
+    static uint64_t id##_ref(void) {                                        \
+        uint64_t t0 = bench_cycles();                                       \
+        for (int i = 0; i < FIX_SAMPLES; i++) dbl_out[i] = (ref_expr);      \
+        return bench_cycles() - t0;                                         \
+    }
+
+FIX_CASE(mul,   fix16_mul(fix_a[i], fix_b[i]),   dbl_a[i] * dbl_b[i])
+FIX_CASE(div,   fix16_div(fix_a[i], fix_b[i]),   dbl_a[i] / dbl_b[i])
+FIX_CASE(sqrt,  fix16_sqrt(fix_a[i]),            sqrt(dbl_a[i]))
+FIX_CASE(sin,   fix16_sin(fix_a[i]),             sin(dbl_a[i]))
+FIX_CASE(cos,   fix16_cos(fix_a[i]),             cos(dbl_a[i]))
+FIX_CASE(tan,   fix16_tan(fix_a[i]),             tan(dbl_a[i]))
+FIX_CASE(atan2, fix16_atan2(fix_a[i], fix_b[i]), atan2(dbl_a[i], dbl_b[i]))
+FIX_CASE(exp,   fix16_exp(fix_a[i]),             exp(dbl_a[i]))
+FIX_CASE(log,   fix16_log(fix_a[i]),             log(dbl_a[i]))
+FIX_CASE(mul28, fix28_mul(fix_a[i], fix_b[i]),   dbl_a[i] * dbl_b[i])
+FIX_CASE(sqrt28, fix28_sqrt(fix_a[i]),           sqrt(dbl_a[i]))
+FIX_CASE(sin28, fix28_sin(fix_a[i]),             sin(dbl_a[i]))
+
+typedef struct {
+    const char *name;
+    uint64_t (*fix)(void);
+    uint64_t (*ref)(void);
+    double a_lo, a_hi;          // Input ranges (b unused by one-argument cases)
+    double b_lo, b_hi;
+    int q28;                    // Q4.28 instead of Q16.16
+    double bound;               // Max error in ulps of the result (fixmath.h)
+} fix_case_t;
+
+static const fix_case_t fix_cases[] = {
+    { "mul",       mul_fix,    mul_ref,    -100.0, 100.0,  -100.0, 100.0, 0, 0.5 },
+    { "div",       div_fix,    div_ref,    -100.0, 100.0,  1.0,    50.0,  0, 0.5 },
+    { "sqrt",      sqrt_fix,   sqrt_ref,   0.0,    30000.0, 0.0,   0.0,   0, 0.5 },
+    { "sin",       sin_fix,    sin_ref,    -10.0,  10.0,   0.0,    0.0,   0, 1.0 },
+    { "cos",       cos_fix,    cos_ref,    -10.0,  10.0,   0.0,    0.0,   0, 1.0 },
+    { "tan",       tan_fix,    tan_ref,    -1.4,   1.4,    0.0,    0.0,   0, 1.0 },
+    { "atan2",     atan2_fix,  atan2_ref,  -100.0, 100.0,  -100.0, 100.0, 0, 1.0 },
+    { "exp",       exp_fix,    exp_ref,    -10.0,  6.9,    0.0,    0.0,   0, 1.0 },
+    { "log",       log_fix,    log_ref,    0.001,  30000.0, 0.0,   0.0,   0, 1.0 },
+    { "q4.28 mul", mul28_fix,  mul28_ref,  -2.0,   2.0,    -2.0,   2.0,   1, 0.5 },
+    { "q4.28 sqrt", sqrt28_fix, sqrt28_ref, 0.0,   7.9,    0.0,    0.0,   1, 0.5 },
+    { "q4.28 sin", sin28_fix,  sin28_ref,  -3.14,  3.14,   0.0,    0.0,   1, 6.0 },
+};
+
+#define FIX_NUM_CASES (int)(sizeof(fix_cases) / sizeof(fix_cases[0]))
+
+// Fills both input sets with the same values (fixed seed, exact conversion)
+static void fix_inputs(const fix_case_t *c, uint32_t *seed) {
+    for (int i = 0; i < FIX_SAMPLES; i++) {
+        *seed = *seed * 1664525u + 1013904223u;
+        double ua = (double)(*seed >> 8) / 16777216.0;
+        *seed = *seed * 1664525u + 1013904223u;
+        double ub = (double)(*seed >> 8) / 16777216.0;
+        double a = c->a_lo + (c->a_hi - c->a_lo) * ua;
+        double b = c->b_lo + (c->b_hi - c->b_lo) * ub;
+
+        if (c->q28) {
+            fix_a[i] = fix28_from_double(a);
+            fix_b[i] = fix28_from_double(b);
+            dbl_a[i] = fix28_to_double(fix_a[i]);
+            dbl_b[i] = fix28_to_double(fix_b[i]);
+        } else {
+            fix_a[i] = fix16_from_double(a);
+            fix_b[i] = fix16_from_double(b);
+            dbl_a[i] = fix16_to_double(fix_a[i]);
+            dbl_b[i] = fix16_to_double(fix_b[i]);
+        }
+    }
+}
+
+static int test_fixmath(void) {
+    uint32_t seed = 0x13579BDF;
+    int failed = 0;
+
+    tprintf("\r\n=== lib/fixmath vs. libm (%d inputs per function) ===\r\n", FIX_SAMPLES);
+    tprintf("%-11s %10s %7s %11s %11s %8s\r\n",
+            "function", "max err", "bound", "fix cyc", "libm cyc", "speedup");
+    tprintf("----------- ---------- ------- ----------- ----------- --------\r\n");
+
+    for (int n = 0; n < FIX_NUM_CASES; n++) {
+        const fix_case_t *c = &fix_cases[n];
+        double scale = c->q28 ? 268435456.0 : 65536.0;
+        double max_err = 0.0;
+
+        fix_inputs(c, &seed);
+        uint32_t fix_cyc = (uint32_t)c->fix();
+        uint32_t ref_cyc = (uint32_t)c->ref();
+
+        // Error in ulps of the fixed-point result
+        for (int i = 0; i < FIX_SAMPLES; i++) {
+            double err = fabs((double)fix_out[i] - dbl_out[i] * scale);
+            if (err > max_err) max_err = err;
+        }
+
+        int pass = max_err <= c->bound;
+        if (!pass) failed++;
+        tprintf("%-11s %6.3f ulp %7.1f %11lu %11lu %7.1fx %s\r\n", c->name, max_err, c->bound,
+                (unsigned long)(fix_cyc / FIX_SAMPLES), (unsigned long)(ref_cyc / FIX_SAMPLES),
+                fix_cyc ? (double)ref_cyc / fix_cyc : 0.0, pass ? "" : "FAIL");
+    }
+
+    tprintf("Cycles per call include the loop; ulp = 2^-16 (Q16.16) or 2^-28 (Q4.28)\r\n");
+    tprintf("%s\r\n", failed ? "FAIL: error above the documented bound" : "PASS: all within bounds");
+    return failed == 0;
+}
+
+//==============================================================================
+// Batch Mode - every test with fixed inputs, timed in CPU cycles
+//==============================================================================
+
+static const bench_case_t batch_cases[] = {
+    { "basic",       test_basic_operations,   9,      0 },
+    { "trig",        test_trigonometry,       12,     0 },
+    { "hyperbolic",  test_hyperbolic,         9,      0 },
+    { "explog",      test_exponential_log,    11,     0 },
+    { "special",     test_special_values,     7,      0 },
+    { "rounding",    test_rounding,           8,      0 },
+    { "stress",      test_stress_computation, 100000, 0 },
+    { "fixmath",     test_fixmath,            FIX_NUM_CASES * FIX_SAMPLES * 2, 0 },
+};
+
+static void run_batch(void) {
+    bench_run_cases("math", batch_cases, sizeof(batch_cases) / sizeof(batch_cases[0]), BATCH_REPS);
+    bench_done();
 }
 
 //==============================================================================
@@ -201,6 +368,8 @@ static void show_menu(void) {
     printf("6. Rounding functions\r\n");
     printf("7. Stress test (30 seconds)\r\n");
     printf("8. Run all tests\r\n");
+    printf("x. lib/fixmath vs. libm (accuracy, cycles per call)\r\n");
+    printf("b. Batch benchmark (CSV/JSON, %d repetitions)\r\n", BATCH_REPS);
     printf("h. Show this menu\r\n");
     printf("q. Quit\r\n");
     printf("========================================\r\n");
@@ -215,6 +384,15 @@ int main(void) {
     printf("  Testing newlib math library\r\n");
     printf("========================================\r\n");
     printf("\r\n");
+
+#ifdef BATCH_MODE
+    // BATCH=1 build: no terminal needed
+    run_batch();
+    while (1) {
+        __asm__ volatile ("wfi");
+    }
+#endif
+
     printf("Press any key to start...\r\n");
 
     getch();
@@ -283,6 +461,19 @@ int main(void) {
                 show_menu();
                 break;
 
+            case 'x':
+            case 'X':
+                bench_timer_init();
+                test_fixmath();
+                show_menu();
+                break;
+
+            case 'b':
+            case 'B':
+                run_batch();
+                show_menu();
+                break;
+
             case 'h':
             case 'H':
                 show_menu();
@@ -0,0 +1,248 @@
+//===============================================================================
+// Memory Latency and Bandwidth Characterization
+// Cycles per access for every load/store width, alignment, stride and
+// access pattern through mem_controller -> sram_proc_new -> sram_driver_new
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//===============================================================================
+//
+// Every row runs a 16x unrolled inline-asm kernel and divides the cycles
+// (lib/bench, timer peripheral) by the number of operations:
+//
+//   cyc/op  : total cycles per instruction, loop overhead amortized over 16
+//   extra   : cyc/op minus the 'nop' row, i.e. the data access cost on top
+//             of fetching and executing an ALU instruction from SRAM
+//   MB/s    : bytes moved per second at 50 MHz
+//
+// PicoRV32 is not pipelined and has no cache, so every instruction pays its
+// own fetch (one 32-bit SRAM read) and a load/store pays a second memory
+// transaction. 32-bit SRAM reads/writes are two 16-bit accesses; sb/sh are a
+// read-modify-write in sram_proc_new. The stride and pointer-chase rows should
+// therefore be flat - any change there points at the memory controller.
+//
+// Build/run:
+//   make TARGET=mem_latency USE_NEWLIB=1 single-target
+//   tools/rvsim/rvsim --no-stdin --uart-fast firmware/mem_latency.elf   (model)
+//   make sim SIM_FW=../firmware/mem_latency.elf SIM_ARGS=--stdio        (RTL)
+//===============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "bench.h"
+#include "hal.h"
+
+#define ITERS       256                 // Loop iterations per kernel (x16 ops)
+#define OPS         (ITERS * 16)
+#define BUF_SIZE    65536               // Stride / pointer-chase working set
+
+#define BOOT_ROM    0x00080000u         // Bootloader BRAM (above SRAM)
+#define UART_STATUS (HAL_UART_BASE + 0x0C)  // UART RX status (no read side effects)
+
+#define REP4(x)     x x x x
+#define REP16(x)    REP4(x) REP4(x) REP4(x) REP4(x)
+
+// Cost of the two bench_cycles() calls around a kernel
+static uint64_t timer_overhead;
+
+// nop row result (hundredths of a cycle), the 'extra' baseline
+static uint32_t alu_cyc100;
+
+//==============================================================================
+// Kernels - each returns cycles for n x 16 operations
+//==============================================================================
+
+#define KERNEL(name, insn)                                                  \
+    static uint64_t name(uintptr_t p, uintptr_t stride, uint32_t n) {       \
+        uint64_t t0 = bench_cycles();                                       \
+        __asm__ volatile (                                                  \
+            "1:\n"                                                          \
+            REP16(insn "\n")                                                \
+            "addi %1, %1, -1\n"                                             \
+            "bnez %1, 1b\n"                                                 \
+            : "+r"(p), "+r"(n) : "r"(stride) : "t0", "t1", "memory");      \
+        return bench_cycles() - t0;                                         \
+    }
+
+KERNEL(k_nop,   "addi x0, x0, 0")
+KERNEL(k_lw,    "lw t0, 0(%0)")
+KERNEL(k_lh0,   "lh t0, 0(%0)")
+KERNEL(k_lh2,   "lh t0, 2(%0)")
+KERNEL(k_lhu,   "lhu t0, 0(%0)")
+KERNEL(k_lb0,   "lb t0, 0(%0)")
+KERNEL(k_lb1,   "lb t0, 1(%0)")
+KERNEL(k_lb2,   "lb t0, 2(%0)")
+KERNEL(k_lb3,   "lb t0, 3(%0)")
+KERNEL(k_lbu,   "lbu t0, 0(%0)")
+KERNEL(k_sw,    "sw zero, 0(%0)")
+KERNEL(k_sh0,   "sh zero, 0(%0)")
+KERNEL(k_sh2,   "sh zero, 2(%0)")
+KERNEL(k_sb0,   "sb zero, 0(%0)")
+KERNEL(k_sb1,   "sb zero, 1(%0)")
+KERNEL(k_sb2,   "sb zero, 2(%0)")
+KERNEL(k_sb3,   "sb zero, 3(%0)")
+KERNEL(k_raw,   "sw t0, 0(%0)\n lw t1, 0(%0)")          // 2 ops per slot
+KERNEL(k_war,   "lw t1, 0(%0)\n sw t1, 0(%0)")          // 2 ops per slot
+KERNEL(k_stride,"lw t0, 0(%0)\n add %0, %0, %2")        // 2 ops per slot
+KERNEL(k_chase, "lw %0, 0(%0)")                         // Dependent loads
+
+//==============================================================================
+// Reporting
+//==============================================================================
+
+typedef uint64_t (*kernel_fn)(uintptr_t p, uintptr_t stride, uint32_t n);
+
+static void print_header(const char *title) {
+    printf("\r\n%-28s %9s %9s %9s\r\n", title, "cyc/op", "extra", "MB/s");
+    printf("---------------------------- --------- --------- ---------\r\n");
+}
+
+// ops: operations counted for cyc/op, bytes: bytes moved per operation
+static uint32_t report(const char *name, uint64_t cycles, uint32_t ops, uint32_t bytes) {
+    if (cycles > timer_overhead) cycles -= timer_overhead;
+    uint32_t cyc100 = (uint32_t)((cycles * 100 + ops / 2) / ops);
+    int32_t extra = (int32_t)cyc100 - (int32_t)alu_cyc100;
+    uint32_t kbps = cycles ? (uint32_t)((uint64_t)ops * bytes * (BENCH_CPU_HZ / 1000) / cycles) : 0;
+
+    printf("%-28s %6lu.%02lu %c%5ld.%02ld %5lu.%03lu\r\n", name,
+           (unsigned long)(cyc100 / 100), (unsigned long)(cyc100 % 100),
+           extra < 0 ? '-' : ' ',
+           (long)((extra < 0 ? -extra : extra) / 100), (long)((extra < 0 ? -extra : extra) % 100),
+           (unsigned long)(kbps / 1000), (unsigned long)(kbps % 1000));
+    return cyc100;
+}
+
+// Best of three runs of n x 16 operations
+static uint64_t run_n(kernel_fn k, uintptr_t p, uintptr_t stride, uint32_t n) {
+    uint64_t best = ~0ull;
+    for (int i = 0; i < 3; i++) {
+        uint64_t c = k(p, stride, n);
+        if (c < best) best = c;
+    }
+    return best;
+}
+
+static uint64_t run(kernel_fn k, uintptr_t p, uintptr_t stride) {
+    return run_n(k, p, stride, ITERS);
+}
+
+//==============================================================================
+// Pointer chase setup: one cycle through every word of the buffer, either in
+// address order or shuffled (Sattolo, fixed seed)
+//==============================================================================
+
+static void build_chase(uint32_t *buf, uint32_t words, int shuffle) {
+    static uint32_t order[BUF_SIZE / 4];
+    uint32_t seed = 0x2545F491;
+
+    for (uint32_t i = 0; i < words; i++) order[i] = i;
+    if (shuffle) {
+        for (uint32_t i = words - 1; i > 0; i--) {
+            seed = seed * 1664525 + 1013904223;
+            uint32_t j = (seed >> 8) % i;
+            uint32_t t = order[i];
+            order[i] = order[j];
+            order[j] = t;
+        }
+    }
+    for (uint32_t i = 0; i < words; i++) {
+        buf[order[i]] = (uint32_t)(uintptr_t)&buf[order[(i + 1) % words]];
+    }
+}
+
+//==============================================================================
+// Main
+//==============================================================================
+
+int main(void) {
+    char name[40];
+    uint32_t *buf = malloc(BUF_SIZE);
+    uintptr_t p;
+
+    printf("\r\n\r\n");
+    printf("========================================\r\n");
+    printf("  Memory Latency Characterization\r\n");
+    printf("  %d ops per row, best of 3, 50 MHz\r\n", OPS);
+    printf("========================================\r\n");
+
+    if (!buf) {
+        printf("FAIL: malloc(%d) failed\r\n", BUF_SIZE);
+        bench_done();
+        while (1) __asm__ volatile ("wfi");
+    }
+    for (uint32_t i = 0; i < BUF_SIZE / 4; i++) buf[i] = 0;
+    p = (uintptr_t)buf;
+
+    bench_timer_init();
+    {
+        uint64_t best = ~0ull;
+        for (int i = 0; i < 8; i++) {
+            uint64_t t0 = bench_cycles();
+            uint64_t c = bench_cycles() - t0;
+            if (c < best) best = c;
+        }
+        timer_overhead = best;
+    }
+    printf("Timer read overhead: %lu cycles (subtracted)\r\n", (unsigned long)timer_overhead);
+
+    print_header("Instruction fetch");
+    alu_cyc100 = report("nop (ALU, SRAM fetch)", run(k_nop, p, 0), OPS, 4);
+
+    print_header("Loads (SRAM)");
+    report("lw", run(k_lw, p, 0), OPS, 4);
+    report("lh  +0", run(k_lh0, p, 0), OPS, 2);
+    report("lh  +2", run(k_lh2, p, 0), OPS, 2);
+    report("lhu +0", run(k_lhu, p, 0), OPS, 2);
+    report("lb  +0", run(k_lb0, p, 0), OPS, 1);
+    report("lb  +1", run(k_lb1, p, 0), OPS, 1);
+    report("lb  +2", run(k_lb2, p, 0), OPS, 1);
+    report("lb  +3", run(k_lb3, p, 0), OPS, 1);
+    report("lbu +0", run(k_lbu, p, 0), OPS, 1);
+
+    print_header("Stores (SRAM)");
+    report("sw", run(k_sw, p, 0), OPS, 4);
+    report("sh  +0 (RMW)", run(k_sh0, p, 0), OPS, 2);
+    report("sh  +2 (RMW)", run(k_sh2, p, 0), OPS, 2);
+    report("sb  +0 (RMW)", run(k_sb0, p, 0), OPS, 1);
+    report("sb  +1 (RMW)", run(k_sb1, p, 0), OPS, 1);
+    report("sb  +2 (RMW)", run(k_sb2, p, 0), OPS, 1);
+    report("sb  +3 (RMW)", run(k_sb3, p, 0), OPS, 1);
+
+    print_header("Dependent pairs (per pair)");
+    report("sw -> lw (read after write)", run(k_raw, p, 0), OPS, 8);
+    report("lw -> sw (write after read)", run(k_war, p, 0), OPS, 8);
+
+    print_header("Other targets (lw)");
+    report("boot ROM (BRAM)", run(k_lw, BOOT_ROM, 0), OPS, 4);
+    report("MMIO (UART status)", run(k_lw, UART_STATUS, 0), OPS, 4);
+
+    // n x 16 loads must stay inside the buffer: fewer ops at large strides
+    print_header("Strided lw (lw + add per op)");
+    for (uint32_t stride = 4; stride <= BUF_SIZE / 16; stride <<= 1) {
+        uint32_t n = BUF_SIZE / (stride * 16);
+        if (n > ITERS) n = ITERS;
+        snprintf(name, sizeof(name), "stride %lu", (unsigned long)stride);
+        report(name, run_n(k_stride, p, stride, n), n * 16, 4);
+    }
+
+    print_header("Pointer chase (dependent lw)");
+    build_chase(buf, BUF_SIZE / 4, 0);
+    report("sequential, 64KB", run(k_chase, p, 0), OPS, 4);
+    build_chase(buf, BUF_SIZE / 4, 1);
+    report("random, 64KB", run(k_chase, p, 0), OPS, 4);
+
+    printf("\r\nextra = cycles on top of the nop row; MB/s at %lu MHz\r\n",
+           (unsigned long)(BENCH_CPU_HZ / 1000000));
+    bench_done();
+
+    free(buf);
+    while (1) {
+        __asm__ volatile ("wfi");
+    }
+    return 0;
+}
@@ -139,6 +139,10 @@ static inline void irq_disable_bit(uint32_t bit) {
 //
 // This function is called by the assembly IRQ handler in start.S
 // It receives the current IRQ bitmask showing which interrupts fired.
+// start.S also passes the interrupted PC (q0) in a1 and the interrupted
+// frame pointer (s0) in a2, so a handler may be declared as
+//   void irq_handler(uint32_t irqs, uint32_t pc, uint32_t fp);
+// to feed lib/profiler.
 //
 // Handler should:
 //   1. Check which IRQ(s) are set in the 'irqs' parameter
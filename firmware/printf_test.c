@@ -11,8 +11,7 @@
 #include <math.h>
 
 // UART direct access for menu (no echo, no buffering)
-#define UART_RX_DATA   (*(volatile unsigned int*)0x80000008)
-#define UART_RX_STATUS (*(volatile unsigned int*)0x8000000C)
+#include "hal.h"
 
 // Custom print functions for comparison
 extern int _write(int file, char *ptr, int len);
@@ -30,9 +29,7 @@ static void println(const char *s) {
 
 // Direct UART getch - no echo, no buffering (for menu input)
 static int getch(void) {
-    // Wait for RX data available (bit is 1 when data available)
-    while (!(UART_RX_STATUS & 0x01));
-    return UART_RX_DATA & 0xFF;
+    return uart_getc();
 }
 
 //==============================================================================
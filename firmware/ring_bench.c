@@ -0,0 +1,324 @@
+//===============================================================================
+// SPSC Ring Benchmark and IRQ Stress Test
+// Cost per element of lib/ring single, batch and zero-copy calls, then an
+// interrupt handler and the main loop exchanging data through two rings
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//===============================================================================
+//
+// Part 1 (interrupts masked): a 256 x uint32_t ring is filled and drained
+// CHUNK elements at a time with push/pop, push_n/pop_n and the write/read
+// spans; cycles per element are timed with lib/bench.
+//
+// Part 2 (interrupts on): the PicoRV32 cycle timer interrupts every
+// IRQ_PERIOD cycles. Each interrupt writes a burst of sequence numbers into
+// the rx ring (IRQ -> main, write span) and drains the event ring
+// (main -> IRQ). The main loop consumes rx with read spans and pop_n, checks
+// the sequence is unbroken, and posts one event per chunk it received. Every
+// STALL_EVERY items the main loop stops reading for a while, so the rx ring
+// runs full and the handler has to drop (the sequence only advances for
+// elements that were stored, so drops never show up as gaps).
+//
+// The timer peripheral is lib/bench's cycle counter, so the load comes from
+// the CPU's own timer (cpu_timer), which shares IRQ 0 with it.
+//
+// Build/run:
+//   make TARGET=ring_bench USE_NEWLIB=1 single-target
+//   make bench-ring                                       (top level, rvsim)
+//   make sim SIM_FW=../firmware/ring_bench.elf SIM_ARGS=--stdio        (RTL)
+//===============================================================================
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "bench.h"
+#include "hal.h"
+#include "ring.h"
+
+#define CHUNK           64              // Part 1: elements per fill/drain
+#define ROUNDS          64              // Part 1: CHUNK x ROUNDS elements per row
+
+#define IRQ_PERIOD      2000            // Cycles between interrupts
+#define BURST           8               // Elements per interrupt
+#define STRESS_ITEMS    65536           // Part 2: elements through the rx ring
+#define STALL_EVERY     16384           // Main loop stops reading every ... items
+#define STALL_SPINS     40000           // ... for this many loop iterations
+
+typedef struct {
+    uint32_t seq;
+    uint32_t received;                  // rx elements the main loop had seen
+} event_t;
+
+RING_DEFINE(bench_ring, uint32_t, 256)
+RING_DEFINE(rx_ring, uint32_t, 256)     // IRQ -> main
+RING_DEFINE(ev_ring, event_t, 16)       // main -> IRQ
+
+static bench_ring_t ring;
+static rx_ring_t rx;
+static ev_ring_t ev;
+
+// Written by the interrupt handler only
+static volatile uint32_t irq_count;
+static volatile uint32_t produced;      // Sequence number of the next element
+static volatile uint32_t dropped;       // Elements the rx ring had no room for
+static volatile uint32_t ev_taken;
+static volatile uint32_t ev_errors;     // Events out of order
+
+static int failures;
+
+//==============================================================================
+// Part 1 - Single Context
+//==============================================================================
+
+static uint32_t src[CHUNK];
+static uint32_t dst[CHUNK];
+
+// Each returns the sum of the elements read back, checked against the sum
+// of what was written
+
+static uint32_t run_single(void) {
+    uint32_t sum = 0;
+
+    for (uint32_t r = 0; r < ROUNDS; r++) {
+        for (uint32_t i = 0; i < CHUNK; i++) {
+            uint32_t v = r + i;
+            bench_ring_push(&ring, &v);
+        }
+        for (uint32_t i = 0; i < CHUNK; i++) {
+            uint32_t v = 0;
+            bench_ring_pop(&ring, &v);
+            sum += v;
+        }
+    }
+    return sum;
+}
+
+static uint32_t run_batch(void) {
+    uint32_t sum = 0;
+
+    for (uint32_t r = 0; r < ROUNDS; r++) {
+        for (uint32_t i = 0; i < CHUNK; i++) {
+            src[i] = r + i;
+        }
+        bench_ring_push_n(&ring, src, CHUNK);
+        bench_ring_pop_n(&ring, dst, CHUNK);
+        for (uint32_t i = 0; i < CHUNK; i++) {
+            sum += dst[i];
+        }
+    }
+    return sum;
+}
+
+// Producer and consumer work in the ring memory itself; a chunk that
+// crosses the buffer end takes two spans
+static uint32_t run_span(void) {
+    uint32_t sum = 0;
+
+    for (uint32_t r = 0; r < ROUNDS; r++) {
+        uint32_t done = 0;
+        while (done < CHUNK) {
+            uint32_t *p;
+            uint32_t n = bench_ring_write_span(&ring, &p);
+            if (n > CHUNK - done) {
+                n = CHUNK - done;
+            }
+            for (uint32_t i = 0; i < n; i++) {
+                p[i] = r + done + i;
+            }
+            bench_ring_write_commit(&ring, n);
+            done += n;
+        }
+        done = 0;
+        while (done < CHUNK) {
+            uint32_t *p;
+            uint32_t n = bench_ring_read_span(&ring, &p);
+            for (uint32_t i = 0; i < n; i++) {
+                sum += p[i];
+            }
+            bench_ring_read_commit(&ring, n);
+            done += n;
+        }
+    }
+    return sum;
+}
+
+static void time_row(const char *title, const char *name, uint32_t (*run)(void)) {
+    // Sum of r + i over all rounds and elements
+    const uint32_t expect = CHUNK * (ROUNDS * (ROUNDS - 1) / 2) + ROUNDS * (CHUNK * (CHUNK - 1) / 2);
+    const uint32_t items = CHUNK * ROUNDS;
+
+    // Start half way round so every row crosses the buffer end
+    bench_ring_init(&ring);
+    ring.head = ring.tail = 256 - CHUNK / 2;
+
+    uint64_t t0 = bench_cycles();
+    uint32_t sum = run();
+    uint64_t cycles = bench_cycles() - t0;
+
+    int valid = sum == expect && bench_ring_count(&ring) == 0;
+    uint32_t cyc100 = (uint32_t)(cycles * 100 / items);
+
+    printf("%-24s %6lu.%02lu cycles/element%s\r\n", title,
+           (unsigned long)(cyc100 / 100), (unsigned long)(cyc100 % 100),
+           valid ? "" : "  FAIL (data)");
+    bench_report(name, "items", items, cycles, 1, "items/MHz", valid);
+    failures += !valid;
+}
+
+//==============================================================================
+// Part 2 - Interrupt Handler and Main Loop
+//==============================================================================
+
+// Called from start.S irq_vec
+void irq_handler(uint32_t irqs, uint32_t pc, uint32_t fp) {
+    (void)pc;
+    (void)fp;
+
+    if (!(irqs & 1)) {
+        return;
+    }
+
+    // A count left means the timer peripheral raised IRQ 0: put it back
+    uint32_t left = cpu_timer(IRQ_PERIOD);
+    if (left != 0) {
+        cpu_timer(left);
+        return;
+    }
+    irq_count++;
+
+    // Burst into rx, two spans when it crosses the buffer end
+    uint32_t seq = produced;
+    uint32_t want = STRESS_ITEMS - seq < BURST ? STRESS_ITEMS - seq : BURST;
+    while (want) {
+        uint32_t *p;
+        uint32_t n = rx_ring_write_span(&rx, &p);
+        if (n == 0) {
+            break;
+        }
+        if (n > want) {
+            n = want;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            p[i] = seq + i;
+        }
+        rx_ring_write_commit(&rx, n);
+        seq += n;
+        want -= n;
+    }
+    produced = seq;
+    dropped += want;
+
+    // Everything the main loop posted since the last interrupt
+    event_t e;
+    while (ev_ring_pop(&ev, &e)) {
+        if (e.seq != ev_taken) {
+            ev_errors++;
+        }
+        ev_taken++;
+    }
+}
+
+static void stress(void) {
+    uint32_t expect = 0;
+    uint32_t gaps = 0;
+    uint32_t ev_sent = 0;
+    uint32_t ev_full = 0;
+    uint32_t round = 0;
+    uint32_t next_stall = STALL_EVERY;
+    uint32_t buf[16];
+
+    rx_ring_init(&rx);
+    ev_ring_init(&ev);
+    irq_count = produced = dropped = ev_taken = ev_errors = 0;
+
+    printf("\r\nIRQ every %d cycles, %d elements per IRQ, %d through a %d-slot ring\r\n",
+           IRQ_PERIOD, BURST, STRESS_ITEMS, 256);
+
+    uint64_t t0 = bench_cycles();
+    irq_setmask(~1u);                   // IRQ 0 only
+    cpu_timer(IRQ_PERIOD);
+
+    while (expect < STRESS_ITEMS) {
+        uint32_t n;
+
+        if (round++ & 1) {
+            uint32_t *p;
+            n = rx_ring_read_span(&rx, &p);
+            for (uint32_t i = 0; i < n; i++) {
+                gaps += p[i] != expect + i;
+            }
+            rx_ring_read_commit(&rx, n);
+        } else {
+            n = rx_ring_pop_n(&rx, buf, 16);
+            for (uint32_t i = 0; i < n; i++) {
+                gaps += buf[i] != expect + i;
+            }
+        }
+        if (n == 0) {
+            continue;
+        }
+        expect += n;
+
+        event_t e = { ev_sent, expect };
+        if (ev_ring_push(&ev, &e)) {
+            ev_sent++;
+        } else {
+            ev_full++;
+        }
+
+        if (expect >= next_stall) {
+            next_stall += STALL_EVERY;
+            for (volatile uint32_t i = 0; i < STALL_SPINS; i++);
+        }
+    }
+
+    cpu_timer(0);
+    irq_disable();
+    uint64_t cycles = bench_cycles() - t0;
+
+    // Events posted after the last interrupt are still queued
+    uint32_t ev_left = ev_ring_count(&ev);
+    int valid = gaps == 0 && ev_errors == 0 && ev_taken + ev_left == ev_sent &&
+                rx_ring_count(&rx) == 0;
+
+    printf("  interrupts      %lu\r\n", (unsigned long)irq_count);
+    printf("  received        %lu (%lu out of sequence)\r\n",
+           (unsigned long)expect, (unsigned long)gaps);
+    printf("  dropped (full)  %lu\r\n", (unsigned long)dropped);
+    printf("  events          %lu sent, %lu taken, %lu queued, %lu ring full, %lu out of order\r\n",
+           (unsigned long)ev_sent, (unsigned long)ev_taken, (unsigned long)ev_left,
+           (unsigned long)ev_full, (unsigned long)ev_errors);
+    printf("  cycles          %lu (%lu per element)\r\n",
+           (unsigned long)cycles, (unsigned long)(cycles / expect));
+    bench_report("ring_irq", "items", expect, cycles, 1, "items/MHz", valid);
+    failures += !valid;
+}
+
+//==============================================================================
+// Main
+//==============================================================================
+
+int main(void) {
+    irq_disable();
+    bench_timer_init();
+
+    printf("\r\n\r\n");
+    printf("========================================\r\n");
+    printf("  SPSC Ring Benchmark (lib/ring)\r\n");
+    printf("  %d elements per row, 50 MHz\r\n", CHUNK * ROUNDS);
+    printf("========================================\r\n\r\n");
+
+    time_row("push / pop", "ring_single", run_single);
+    time_row("push_n / pop_n (64)", "ring_batch", run_batch);
+    time_row("write / read span", "ring_span", run_span);
+
+    stress();
+
+    printf("\r\n%s\r\n", failures ? "FAIL" : "PASS");
+    bench_done();
+    return 0;
+}
@@ -11,73 +11,7 @@
 
 #include <stdint.h>
 
-// Memory-mapped I/O register addresses
-#define MMIO_BASE           0x80000000
-#define UART_TX_DATA        (*(volatile uint32_t*)(MMIO_BASE + 0x00))
-#define UART_TX_STATUS      (*(volatile uint32_t*)(MMIO_BASE + 0x04))
-#define UART_RX_DATA        (*(volatile uint32_t*)(MMIO_BASE + 0x08))
-#define UART_RX_STATUS      (*(volatile uint32_t*)(MMIO_BASE + 0x0C))
-#define LED_CONTROL         (*(volatile uint32_t*)(MMIO_BASE + 0x10))
-
-// Timer peripheral registers (base 0x80000020)
-#define TIMER_BASE          0x80000020
-#define TIMER_CR            (*(volatile uint32_t*)(TIMER_BASE + 0x00))
-#define TIMER_SR            (*(volatile uint32_t*)(TIMER_BASE + 0x04))
-#define TIMER_PSC           (*(volatile uint32_t*)(TIMER_BASE + 0x08))
-#define TIMER_ARR           (*(volatile uint32_t*)(TIMER_BASE + 0x0C))
-#define TIMER_CNT           (*(volatile uint32_t*)(TIMER_BASE + 0x10))
-
-// Timer control bits
-#define TIMER_CR_ENABLE     (1 << 0)
-#define TIMER_CR_ONE_SHOT   (1 << 1)
-#define TIMER_SR_UIF        (1 << 0)
-
-//==============================================================================
-// PicoRV32 Custom IRQ Instructions (inline assembly macros)
-//==============================================================================
-
-// Enable all interrupts (clear IRQ mask)
-static inline void irq_enable(void) {
-    uint32_t dummy;
-    __asm__ volatile (".insn r 0x0B, 6, 3, %0, %1, x0" : "=r"(dummy) : "r"(0));
-}
-
-//==============================================================================
-// UART Functions
-//==============================================================================
-
-static void uart_putc(char c) {
-    while (UART_TX_STATUS & 1);  // Wait while TX busy
-    UART_TX_DATA = c;
-}
-
-static void uart_puts(const char *s) {
-    while (*s) {
-        uart_putc(*s++);
-    }
-}
-
-//==============================================================================
-// Timer Helper Functions
-//==============================================================================
-
-static void timer_init(void) {
-    TIMER_CR = 0;               // Disable timer
-    TIMER_SR = TIMER_SR_UIF;    // Clear any pending interrupt
-}
-
-static void timer_config(uint16_t psc, uint32_t arr) {
-    TIMER_PSC = psc;
-    TIMER_ARR = arr;
-}
-
-static void timer_start(void) {
-    TIMER_CR = TIMER_CR_ENABLE;  // Enable, continuous mode
-}
-
-static void timer_clear_irq(void) {
-    TIMER_SR = TIMER_SR_UIF;     // Write 1 to clear
-}
+#include "hal.h"
 
 //==============================================================================
 // Clock State (updated by interrupt)
@@ -11,24 +11,7 @@
 #include "timer_ms.h"
 #include <stdint.h>
 
-// Timer peripheral registers (base 0x80000020)
-#define TIMER_BASE          0x80000020
-#define TIMER_CR            (*(volatile uint32_t*)(TIMER_BASE + 0x00))
-#define TIMER_SR            (*(volatile uint32_t*)(TIMER_BASE + 0x04))
-#define TIMER_PSC           (*(volatile uint32_t*)(TIMER_BASE + 0x08))
-#define TIMER_ARR           (*(volatile uint32_t*)(TIMER_BASE + 0x0C))
-#define TIMER_CNT           (*(volatile uint32_t*)(TIMER_BASE + 0x10))
-
-// Timer control bits
-#define TIMER_CR_ENABLE     (1 << 0)
-#define TIMER_CR_ONE_SHOT   (1 << 1)
-#define TIMER_SR_UIF        (1 << 0)
-
-// PicoRV32 Custom IRQ Enable instruction
-static inline void irq_enable(void) {
-    uint32_t dummy;
-    __asm__ volatile (".insn r 0x0B, 6, 3, %0, %1, x0" : "=r"(dummy) : "r"(0));
-}
+#include "hal.h"
 
 // Global millisecond counter (wraps every ~49 days)
 volatile uint32_t millis_counter = 0;
@@ -42,15 +25,11 @@ volatile uint32_t millis_counter = 0;
 // Auto-reload: 999 → 1,000,000 / 1000 = 1000 Hz = 1ms period
 //==============================================================================
 void timer_ms_init(void) {
-    // Disable timer
-    TIMER_CR = 0;
-
-    // Clear any pending interrupt
-    TIMER_SR = TIMER_SR_UIF;
+    // Disable timer and clear any pending interrupt
+    timer_init();
 
     // Configure for 1 kHz (1ms)
-    TIMER_PSC = 49;   // Prescaler: 50 MHz / 50 = 1 MHz
-    TIMER_ARR = 999;  // Auto-reload: 1 MHz / 1000 = 1 kHz
+    timer_config(49, 999);  // 50 MHz / 50 = 1 MHz, 1 MHz / 1000 = 1 kHz
 
     // Reset counter
     millis_counter = 0;
@@ -59,7 +38,7 @@ void timer_ms_init(void) {
     irq_enable();
 
     // Start timer in continuous mode
-    TIMER_CR = TIMER_CR_ENABLE;
+    timer_start();
 }
 
 //==============================================================================
@@ -67,7 +46,7 @@ void timer_ms_init(void) {
 //==============================================================================
 void timer_ms_irq_handler(void) {
     // Clear interrupt flag
-    TIMER_SR = TIMER_SR_UIF;
+    timer_clear_irq();
 
     // Increment millisecond counter
     millis_counter++;
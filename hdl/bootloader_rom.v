@@ -10,7 +10,7 @@
 //==============================================================================
 
 /*
- * Bootloader ROM - 8KB at 0x40000
+ * Bootloader ROM - 8KB at 0x80000
  *
  * READ-ONLY BRAM initialized from bootloader.hex at synthesis time
  *
@@ -18,9 +18,8 @@
  * synthesis via $readmemh. Yosys will infer this as SB_RAM40_4K blocks.
  *
  * Memory map:
- *   0x00000000 - 0x0003FFFF : Main firmware (256KB SRAM)
- *   0x00040000 - 0x00041FFF : Bootloader ROM (8KB BRAM) ← THIS MODULE
- *   0x00042000 - 0x0007FFFF : Heap/Stack (~248KB SRAM)
+ *   0x00000000 - 0x0007FFFF : Firmware code/data/heap/stack (512KB SRAM)
+ *   0x00080000 - 0x00081FFF : Bootloader ROM (8KB BRAM) ← THIS MODULE
  *
  * Interface:
  *   - 32-bit read-only interface
@@ -21,7 +21,8 @@ module circular_buffer #(
     output wire full,
     input wire rd_en,
     output wire [DATA_WIDTH-1:0] rd_data,
-    output wire empty
+    output wire empty,
+    output wire [ADDR_BITS:0] level     // Bytes held (UART RTS# threshold)
 );
 
     localparam DEPTH = 1 << ADDR_BITS;
@@ -35,6 +36,7 @@ module circular_buffer #(
 
     assign full = (count == DEPTH);
     assign empty = (count == 0);
+    assign level = count;
     assign rd_data = rd_data_reg;  // Drive from register instead of combinational
 
     always @(posedge clk) begin
@@ -9,7 +9,9 @@
 // Educational and research purposes only
 //==============================================================================
 
-module firmware_loader (
+module firmware_loader #(
+    parameter VERBOSE = 0          // 1 = per-access $display trace (simulation)
+) (
     input wire clk,
     input wire resetn,
     
@@ -158,7 +160,7 @@ module firmware_loader (
                         buffer_data_valid <= 1'b1;
                         buffer_read_state <= 1'b0;
                         // synthesis translate_off
-                        $display("[BUF] Read byte: 0x%02x", buffer_rd_data);
+                        if (VERBOSE) $display("[BUF] Read byte: 0x%02x", buffer_rd_data);
                         // synthesis translate_on
                     end
                 endcase
@@ -291,21 +293,21 @@ module firmware_loader (
                             2'd0: begin
                                 crc_current_word[7:0] <= current_rx_byte;
                                 // synthesis translate_off
-                                $display("[FW] CRC byte 0: 0x%02x, pos 0->1", current_rx_byte);
+                                if (VERBOSE) $display("[FW] CRC byte 0: 0x%02x, pos 0->1", current_rx_byte);
                                 // synthesis translate_on
                                 crc_word_pos <= 2'd1;
                             end
                             2'd1: begin
                                 crc_current_word[15:8] <= current_rx_byte;
                                 // synthesis translate_off
-                                $display("[FW] CRC byte 1: 0x%02x, pos 1->2", current_rx_byte);
+                                if (VERBOSE) $display("[FW] CRC byte 1: 0x%02x, pos 1->2", current_rx_byte);
                                 // synthesis translate_on
                                 crc_word_pos <= 2'd2;
                             end
                             2'd2: begin
                                 crc_current_word[23:16] <= current_rx_byte;
                                 // synthesis translate_off
-                                $display("[FW] CRC byte 2: 0x%02x, pos 2->3", current_rx_byte);
+                                if (VERBOSE) $display("[FW] CRC byte 2: 0x%02x, pos 2->3", current_rx_byte);
                                 // synthesis translate_on
                                 crc_word_pos <= 2'd3;
                             end
@@ -314,9 +316,9 @@ module firmware_loader (
                                 crc_din <= {current_rx_byte, crc_current_word[23:0]};
                                 crc_calc_pulse <= 1'b1;
                                 // synthesis translate_off
-                                $display("[FW] CRC word: 0x%08x (bytes: 0x%02x 0x%02x 0x%02x 0x%02x)",
-                                         {current_rx_byte, crc_current_word[23:0]},
-                                         crc_current_word[7:0], crc_current_word[15:8], crc_current_word[23:16], current_rx_byte);
+                                if (VERBOSE) $display("[FW] CRC word: 0x%08x (bytes: 0x%02x 0x%02x 0x%02x 0x%02x)",
+                                                      {current_rx_byte, crc_current_word[23:0]},
+                                                      crc_current_word[7:0], crc_current_word[15:8], crc_current_word[23:16], current_rx_byte);
                                 // synthesis translate_on
                                 crc_word_pos <= 2'd0;
                             end
@@ -370,7 +372,7 @@ module firmware_loader (
                         sram_we <= 1'b1;
                         sram_valid <= 1'b1;
                         // synthesis translate_off
-                        $display("[FW] STORE_WORD: Writing to sram_addr_16=0x%05x (word_addr=0x%08x) data=0x%04x", word_addr[18:0], word_addr, data_word);
+                        if (VERBOSE) $display("[FW] STORE_WORD: Writing to sram_addr_16=0x%05x (word_addr=0x%08x) data=0x%04x", word_addr[18:0], word_addr, data_word);
                         // synthesis translate_on
                     end else if (sram_ready) begin
                         sram_valid <= 1'b0;
@@ -379,7 +381,7 @@ module firmware_loader (
 
                         if (bytes_received >= packet_size) begin
                             // synthesis translate_off
-                            $display("[FW] STORE_WORD: bytes_received=%d >= packet_size=%d, sending ACK, going to CRC_CMD", bytes_received, packet_size);
+                            if (VERBOSE) $display("[FW] STORE_WORD: bytes_received=%d >= packet_size=%d, sending ACK, going to CRC_CMD", bytes_received, packet_size);
                             // synthesis translate_on
                             response_char <= 8'h41 + ack_counter;  // Rotating ACK
                             ack_counter <= (ack_counter == 5'd25) ? 5'd0 : ack_counter + 1;
@@ -388,7 +390,7 @@ module firmware_loader (
                             state <= STATE_SEND_RESP;
                         end else if (chunk_byte_count >= 7'd64) begin
                             // synthesis translate_off
-                            $display("[FW] STORE_WORD: chunk_byte_count=%d >= 64, sending chunk ACK", chunk_byte_count);
+                            if (VERBOSE) $display("[FW] STORE_WORD: chunk_byte_count=%d >= 64, sending chunk ACK", chunk_byte_count);
                             // synthesis translate_on
                             response_char <= 8'h41 + ack_counter;  // Rotating ACK
                             ack_counter <= (ack_counter == 5'd25) ? 5'd0 : ack_counter + 1;
@@ -398,7 +400,7 @@ module firmware_loader (
                             state <= STATE_SEND_RESP;
                         end else begin
                             // synthesis translate_off
-                            $display("[FW] STORE_WORD: bytes=%d, chunk=%d, continuing to RECV_DATA", bytes_received, chunk_byte_count);
+                            if (VERBOSE) $display("[FW] STORE_WORD: bytes=%d, chunk=%d, continuing to RECV_DATA", bytes_received, chunk_byte_count);
                             // synthesis translate_on
                             state <= STATE_RECV_DATA;
                         end
@@ -431,11 +433,11 @@ module firmware_loader (
                 
                 STATE_VERIFY_CRC: begin
                     // synthesis translate_off
-                    $display("[FW] CRC Verify: calculated=0x%08x, expected=0x%08x", crc_result, expected_crc);
+                    if (VERBOSE) $display("[FW] CRC Verify: calculated=0x%08x, expected=0x%08x", crc_result, expected_crc);
                     // synthesis translate_on
                     if (crc_result == expected_crc) begin
                         // synthesis translate_off
-                        $display("[FW] CRC Match! Sending ACK");
+                        if (VERBOSE) $display("[FW] CRC Match! Sending ACK");
                         // synthesis translate_on
                         response_char <= 8'h41 + ack_counter;  // Rotating ACK
                         ack_counter <= (ack_counter == 5'd25) ? 5'd0 : ack_counter + 1;
@@ -443,7 +445,7 @@ module firmware_loader (
                         next_state <= STATE_COMPLETE;
                     end else begin
                         // synthesis translate_off
-                        $display("[FW] CRC Mismatch! Sending NAK");
+                        if (VERBOSE) $display("[FW] CRC Mismatch! Sending NAK");
                         // synthesis translate_on
                         response_char <= 8'h4E;  // NAK
                         send_response <= 1'b1;
@@ -9,7 +9,12 @@
 // Educational and research purposes only
 //==============================================================================
 
-module ice40_picorv32_top (
+module ice40_picorv32_top #(
+    parameter ENABLE_TRACE = 0,     // PicoRV32 trace port (simulation trace sink)
+    parameter VERBOSE = 0,          // Per-access $display in memory/MMIO modules
+    parameter SRAM_FUSED = 0,       // 1 = sram_fused32 engine (no BIST), 0 = proc/BIST/driver
+    parameter UART_CTS = 0          // 1 = UART TX waits for UART_CTS_N (UART_FLOW_CONTROL only)
+) (
     // Clock and Reset
     input wire EXTCLK,          // 100MHz external clock (J3)
 
@@ -22,6 +27,11 @@ module ice40_picorv32_top (
     // UART Interface
     input wire UART_RX,         // UART Receive (E4)
     output wire UART_TX,        // UART Transmit (B2)
+`ifdef UART_FLOW_CONTROL
+    // Hardware flow control (make UART_FLOW=1, ice40_picorv32_flow.pcf)
+    output wire UART_RTS_N,     // UART RTS#, low = host may send
+    input wire UART_CTS_N,      // UART CTS#, low = host ready (used when UART_CTS=1)
+`endif
 
     // SRAM Interface (K6R4016V1D-TC10)
     output wire [17:0] SA,      // SRAM Address bus
@@ -76,6 +86,7 @@ module ice40_picorv32_top (
     assign LED2 = led2_mmio;
 
     // UART signals
+    wire [8:0] buffer_level;
     wire [7:0] uart_rx_data;
     wire uart_rx_data_valid;
     wire uart_tx_busy, uart_rx_busy, uart_rx_error;
@@ -89,6 +100,12 @@ module ice40_picorv32_top (
     wire [7:0] uart_tx_data_mux = mmio_uart_tx_data;
     wire uart_tx_valid_mux = mmio_uart_tx_valid;
 
+`ifndef UART_FLOW_CONTROL
+    // No handshake pins: RTS# goes nowhere, CTS# always reads ready
+    wire UART_RTS_N;
+    wire UART_CTS_N = 1'b0;
+`endif
+
     // UART Core (50 MHz clock after divide-by-2)
     uart #(
         .CLK_FREQ(50_000_000),
@@ -96,7 +113,12 @@ module ice40_picorv32_top (
         .OS_RATE(16),
         .D_WIDTH(8),
         .PARITY(0),
-        .PARITY_EO(1'b0)
+        .PARITY_EO(1'b0),
+        .LEVEL_BITS(9),
+        .RX_STOP_LEVEL(192),    // 64 bytes of headroom after RTS# rises
+        .RX_GO_LEVEL(128),
+        .CTS_ENABLE(UART_CTS),
+        .VERBOSE(VERBOSE)
     ) uart_core (
         .clk(clk),
         .reset_n(global_resetn),
@@ -108,7 +130,10 @@ module ice40_picorv32_top (
         .rx_data(uart_rx_data),
         .rx_data_valid(uart_rx_data_valid),
         .tx_busy(uart_tx_busy),
-        .tx(UART_TX)
+        .tx(UART_TX),
+        .rx_level(buffer_level),
+        .rts_n(UART_RTS_N),
+        .cts_n(UART_CTS_N)
     );
 
     // Circular Buffer for UART RX
@@ -132,7 +157,8 @@ module ice40_picorv32_top (
         .full(buffer_full),
         .rd_en(buffer_rd_en),
         .rd_data(buffer_rd_data),
-        .empty(buffer_empty)
+        .empty(buffer_empty),
+        .level(buffer_level)
     );
 
     // SRAM 16-bit driver interface
@@ -142,26 +168,19 @@ module ice40_picorv32_top (
     wire [15:0] sram_rdata_16;
     wire sram_we_cpu;
     wire sram_valid_16_cpu;
-    wire sram_ready_16;
+    wire sram_ready_16_cpu;
 
-    // SRAM direct connection - no arbiter needed (bootloader handles uploads via CPU)
+    // Driver side of the SRAM BIST (CPU commands pass through while idle)
+    wire [18:0] sram_addr_16;
+    wire [15:0] sram_wdata_16;
+    wire sram_we;
+    wire sram_valid_16;
+    wire sram_ready_16;
 
-    // *** CLEAN-ROOM SRAM Driver with COOLDOWN fix ***
-    sram_driver_new sram_drv (
-        .clk(clk),
-        .resetn(global_resetn),
-        .valid(sram_valid_16_cpu),
-        .ready(sram_ready_16),
-        .we(sram_we_cpu),
-        .addr(sram_addr_16_cpu),
-        .wdata(sram_wdata_16_cpu),
-        .rdata(sram_rdata_16),
-        .sram_addr(SA),
-        .sram_data(SD),
-        .sram_cs_n(SRAM_CS_N),
-        .sram_oe_n(SRAM_OE_N),
-        .sram_we_n(SRAM_WE_N)
-    );
+    // SRAM BIST MMIO signals
+    wire        bist_mmio_valid;
+    wire [31:0] bist_mmio_rdata;
+    wire        bist_mmio_ready;
 
     // ========================================
     // PicoRV32 CPU + Memory-Mapped I/O
@@ -179,8 +198,13 @@ module ice40_picorv32_top (
     // Timer interrupt signal
     wire timer_irq;
 
+    // Instruction trace (PicoRV32 ENABLE_TRACE), tapped hierarchically by
+    // the simulation trace sink (sim/trace_sink.sv)
+    wire        cpu_trace_valid;
+    wire [35:0] cpu_trace_data;
+
     // PicoRV32 CPU Core - RV32I (32 regs) with MUL/DIV, barrel shifter, and interrupts
-    // Boots from bootloader at 0x40000, which then jumps to firmware at 0x0
+    // Boots from bootloader at 0x80000, which then jumps to firmware at 0x0
     picorv32 #(
         .ENABLE_COUNTERS(0),
         .ENABLE_COUNTERS64(0),
@@ -201,14 +225,14 @@ module ice40_picorv32_top (
         .ENABLE_IRQ(1),                 // Enable interrupt support
         .ENABLE_IRQ_QREGS(1),           // Enable IRQ shadow registers (q0-q3)
         .ENABLE_IRQ_TIMER(1),           // Enable IRQ timer register
-        .ENABLE_TRACE(0),
+        .ENABLE_TRACE(ENABLE_TRACE),
         .REGS_INIT_ZERO(1),
         .MASKED_IRQ(32'h00000000),
         .LATCHED_IRQ(32'hffffffff),
 `ifdef SIMULATION
         .PROGADDR_RESET(32'h00000000),  // SIMULATION: Start from SRAM (firmware pre-loaded)
 `else
-        .PROGADDR_RESET(32'h00040000),  // HARDWARE: Start from bootloader ROM
+        .PROGADDR_RESET(32'h00080000),  // HARDWARE: Start from bootloader ROM
 `endif
         .PROGADDR_IRQ(32'h00000010),    // IRQ handler at 0x10
         .STACKADDR(32'h00080000)
@@ -241,7 +265,10 @@ module ice40_picorv32_top (
         .pcpi_ready(1'b0),
 
         .irq({31'h0, timer_irq}),  // IRQ[0] = Timer interrupt
-        .eoi()
+        .eoi(),
+
+        .trace_valid(cpu_trace_valid),
+        .trace_data(cpu_trace_data)
     );
 
     // Bootloader ROM signals
@@ -249,7 +276,7 @@ module ice40_picorv32_top (
     wire [12:0] boot_addr;
     wire [31:0] boot_rdata;
 
-    // Bootloader ROM - 8KB BRAM at 0x40000
+    // Bootloader ROM - 8KB BRAM at 0x80000 (above the 512KB SRAM)
     // Initialized from bootloader.hex at synthesis time via $readmemh
     bootloader_rom boot_rom (
         .clk(clk),
@@ -279,7 +306,9 @@ module ice40_picorv32_top (
     wire        mmio_ready;
 
     // Memory Controller - Routes CPU to SRAM, Bootloader ROM, or MMIO
-    mem_controller mem_ctrl (
+    mem_controller #(
+        .VERBOSE(VERBOSE)
+    ) mem_ctrl (
         .clk(clk),
         .resetn(cpu_resetn),
 
@@ -317,35 +346,128 @@ module ice40_picorv32_top (
         .mmio_ready(mmio_ready)
     );
 
-    // SRAM Processor for CPU (via Memory Controller)
-    sram_proc_new sram_proc_cpu (
-        .clk(clk),
-        .resetn(cpu_resetn),
-        .start(mem_ctrl_sram_start),
-        .cmd(mem_ctrl_sram_cmd),
-        .addr_in(mem_ctrl_sram_addr),
-        .data_in(mem_ctrl_sram_wdata),
-        .mem_wstrb(mem_ctrl_sram_wstrb),
-        .busy(mem_ctrl_sram_busy),
-        .done(mem_ctrl_sram_done),
-        .result(mem_ctrl_sram_rdata),
-        .result_low(),
-        .result_high(),
-        .rx_byte(8'h00),
-        .rx_valid(1'b0),
-        .tx_data(),
-        .tx_valid(),
-        .tx_ready(1'b1),
-        .sram_valid(sram_valid_16_cpu),
-        .sram_ready(sram_ready_16),
-        .sram_we(sram_we_cpu),
-        .sram_addr_16(sram_addr_16_cpu),
-        .sram_wdata_16(sram_wdata_16_cpu),
-        .sram_rdata_16(sram_rdata_16)
-    );
+    generate if (SRAM_FUSED) begin : g_sram_fused
+        // Fused 32-bit SRAM engine: commands straight to the pins, both
+        // halves pipelined, sequential reads fetched ahead
+        sram_fused32 #(
+            .VERBOSE(VERBOSE)
+        ) sram_fused (
+            .clk(clk),
+            .resetn(cpu_resetn),
+            .start(mem_ctrl_sram_start),
+            .cmd(mem_ctrl_sram_cmd),
+            .addr_in(mem_ctrl_sram_addr),
+            .data_in(mem_ctrl_sram_wdata),
+            .mem_wstrb(mem_ctrl_sram_wstrb),
+            .busy(mem_ctrl_sram_busy),
+            .done(mem_ctrl_sram_done),
+            .result(mem_ctrl_sram_rdata),
+            .result_low(),
+            .result_high(),
+            .rx_byte(8'h00),
+            .rx_valid(1'b0),
+            .tx_data(),
+            .tx_valid(),
+            .tx_ready(1'b1),
+            .sram_addr(SA),
+            .sram_data(SD),
+            .sram_cs_n(SRAM_CS_N),
+            .sram_oe_n(SRAM_OE_N),
+            .sram_we_n(SRAM_WE_N)
+        );
+
+        // No BIST in this variant: the window reads as zero (BIST_ID check
+        // fails) and never stalls the bus
+        assign bist_mmio_rdata = 32'h0;
+        assign bist_mmio_ready = bist_mmio_valid;
+    end else begin : g_sram_split
+        // SRAM Processor for CPU (via Memory Controller)
+        sram_proc_new #(
+            .VERBOSE(VERBOSE)
+        ) sram_proc_cpu (
+            .clk(clk),
+            .resetn(cpu_resetn),
+            .start(mem_ctrl_sram_start),
+            .cmd(mem_ctrl_sram_cmd),
+            .addr_in(mem_ctrl_sram_addr),
+            .data_in(mem_ctrl_sram_wdata),
+            .mem_wstrb(mem_ctrl_sram_wstrb),
+            .busy(mem_ctrl_sram_busy),
+            .done(mem_ctrl_sram_done),
+            .result(mem_ctrl_sram_rdata),
+            .result_low(),
+            .result_high(),
+            .rx_byte(8'h00),
+            .rx_valid(1'b0),
+            .tx_data(),
+            .tx_valid(),
+            .tx_ready(1'b1),
+            .sram_valid(sram_valid_16_cpu),
+            .sram_ready(sram_ready_16_cpu),
+            .sram_we(sram_we_cpu),
+            .sram_addr_16(sram_addr_16_cpu),
+            .sram_wdata_16(sram_wdata_16_cpu),
+            .sram_rdata_16(sram_rdata_16)
+        );
+
+        // SRAM BIST - March C-, walking and address tests at driver speed,
+        // started and read back through MMIO at 0x80000040
+        sram_bist #(
+            .VERBOSE(VERBOSE)
+        ) sram_bist_inst (
+            .clk(clk),
+            .resetn(cpu_resetn),
+
+            // MMIO Interface
+            .mmio_valid(bist_mmio_valid),
+            .mmio_write(mmio_write),
+            .mmio_addr(mmio_addr),
+            .mmio_wdata(mmio_wdata),
+            .mmio_wstrb(mmio_wstrb),
+            .mmio_rdata(bist_mmio_rdata),
+            .mmio_ready(bist_mmio_ready),
+
+            // From sram_proc_new
+            .proc_valid(sram_valid_16_cpu),
+            .proc_busy(mem_ctrl_sram_busy),
+            .proc_ready(sram_ready_16_cpu),
+            .proc_we(sram_we_cpu),
+            .proc_addr(sram_addr_16_cpu),
+            .proc_wdata(sram_wdata_16_cpu),
+
+            // To sram_driver_new
+            .drv_valid(sram_valid_16),
+            .drv_ready(sram_ready_16),
+            .drv_we(sram_we),
+            .drv_addr(sram_addr_16),
+            .drv_wdata(sram_wdata_16),
+            .drv_rdata(sram_rdata_16)
+        );
+
+        // *** CLEAN-ROOM SRAM Driver with COOLDOWN fix ***
+        sram_driver_new #(
+            .VERBOSE(VERBOSE)
+        ) sram_drv (
+            .clk(clk),
+            .resetn(global_resetn),
+            .valid(sram_valid_16),
+            .ready(sram_ready_16),
+            .we(sram_we),
+            .addr(sram_addr_16),
+            .wdata(sram_wdata_16),
+            .rdata(sram_rdata_16),
+            .sram_addr(SA),
+            .sram_data(SD),
+            .sram_cs_n(SRAM_CS_N),
+            .sram_oe_n(SRAM_OE_N),
+            .sram_we_n(SRAM_WE_N)
+        );
+    end endgenerate
 
     // MMIO Peripherals - UART, LED, Button, and Timer registers
-    mmio_peripherals mmio (
+    mmio_peripherals #(
+        .VERBOSE(VERBOSE)
+    ) mmio (
         .clk(clk),
         .resetn(cpu_resetn),
 
@@ -381,6 +503,11 @@ module ice40_picorv32_top (
         .mode_wdata(),  // Unconnected
         .mode_rdata(32'h00000001),  // Always returns 1 (app mode)
 
+        // SRAM BIST registers
+        .bist_valid(bist_mmio_valid),
+        .bist_rdata(bist_mmio_rdata),
+        .bist_ready(bist_mmio_ready),
+
         // Timer Interrupt Output
         .timer_irq(timer_irq)
     );
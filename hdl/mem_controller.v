@@ -9,7 +9,9 @@
 // Educational and research purposes only
 //==============================================================================
 
-module mem_controller (
+module mem_controller #(
+    parameter VERBOSE = 0          // 1 = per-access $display trace (simulation)
+) (
     input wire clk,
     input wire resetn,
 
@@ -50,8 +52,8 @@ module mem_controller (
     // Memory Map
     localparam SRAM_BASE = 32'h00000000;
     localparam SRAM_END  = 32'h0007FFFF;  // 512 KB
-    localparam BOOT_BASE = 32'h00040000;  // Bootloader ROM (after 256KB code)
-    localparam BOOT_END  = 32'h00041FFF;  // 8 KB
+    localparam BOOT_BASE = 32'h00080000;  // Bootloader ROM (above SRAM, keeps it linear)
+    localparam BOOT_END  = 32'h00081FFF;  // 8 KB
     localparam MMIO_BASE = 32'h80000000;
     localparam MMIO_END  = 32'h800000FF;
 
@@ -115,7 +117,7 @@ module mem_controller (
                             state <= STATE_BOOT_WAIT;
 
                             // synthesis translate_off
-                            // $display("[MEM_CTRL] BOOT ROM read: addr=0x%08x", cpu_mem_addr);
+                            if (VERBOSE) $display("[MEM_CTRL] BOOT ROM read: addr=0x%08x", cpu_mem_addr);
                             // synthesis translate_on
 
                         end else if (addr_is_sram) begin
@@ -128,9 +130,9 @@ module mem_controller (
                             state <= STATE_SRAM_WAIT;
 
                             // synthesis translate_off
-                            // $display("[MEM_CTRL] SRAM access: addr=0x%08x %s data=0x%08x wstrb=0x%01x",
-                            //          cpu_mem_addr, |cpu_mem_wstrb ? "WRITE" : "READ",
-                            //          cpu_mem_wdata, cpu_mem_wstrb);
+                            if (VERBOSE) $display("[MEM_CTRL] SRAM access: addr=0x%08x %s data=0x%08x wstrb=0x%01x",
+                                                  cpu_mem_addr, |cpu_mem_wstrb ? "WRITE" : "READ",
+                                                  cpu_mem_wdata, cpu_mem_wstrb);
                             // synthesis translate_on
 
                         end else if (addr_is_mmio) begin
@@ -143,9 +145,9 @@ module mem_controller (
                             state <= STATE_MMIO_WAIT;
 
                             // synthesis translate_off
-                            // $display("[MEM_CTRL] MMIO access: addr=0x%08x %s data=0x%08x",
-                            //          cpu_mem_addr, |cpu_mem_wstrb ? "WRITE" : "READ",
-                            //          cpu_mem_wdata);
+                            if (VERBOSE) $display("[MEM_CTRL] MMIO access: addr=0x%08x %s data=0x%08x",
+                                                  cpu_mem_addr, |cpu_mem_wstrb ? "WRITE" : "READ",
+                                                  cpu_mem_wdata);
                             // synthesis translate_on
 
                         end else begin
@@ -154,7 +156,7 @@ module mem_controller (
                             cpu_mem_ready <= 1'b1;
 
                             // synthesis translate_off
-                            // $display("[MEM_CTRL] Invalid address: 0x%08x", cpu_mem_addr);
+                            if (VERBOSE) $display("[MEM_CTRL] Invalid address: 0x%08x", cpu_mem_addr);
                             // synthesis translate_on
                         end
                     end
@@ -172,7 +174,7 @@ module mem_controller (
                     state <= STATE_IDLE;
 
                     // synthesis translate_off
-                    // $display("[MEM_CTRL] BOOT ROM read complete: data=0x%08x", boot_rdata);
+                    if (VERBOSE) $display("[MEM_CTRL] BOOT ROM read complete: data=0x%08x", boot_rdata);
                     // synthesis translate_on
                 end
 
@@ -184,7 +186,7 @@ module mem_controller (
 
                         // synthesis translate_off
                         if (!saved_is_write) begin
-                            // $display("[MEM_CTRL] SRAM read complete: data=0x%08x", sram_rdata);
+                            if (VERBOSE) $display("[MEM_CTRL] SRAM read complete: data=0x%08x", sram_rdata);
                         end
                         // synthesis translate_on
                     end
@@ -198,7 +200,7 @@ module mem_controller (
 
                         // synthesis translate_off
                         if (!saved_is_write) begin
-                            // $display("[MEM_CTRL] MMIO read complete: data=0x%08x", mmio_rdata);
+                            if (VERBOSE) $display("[MEM_CTRL] MMIO read complete: data=0x%08x", mmio_rdata);
                         end
                         // synthesis translate_on
                     end
@@ -9,7 +9,9 @@
 // Educational and research purposes only
 //==============================================================================
 
-module mmio_peripherals (
+module mmio_peripherals #(
+    parameter VERBOSE = 0          // 1 = per-access $display trace (simulation)
+) (
     input wire clk,
     input wire resetn,
 
@@ -45,6 +47,11 @@ module mmio_peripherals (
     output reg [31:0] mode_wdata,
     input wire [31:0] mode_rdata,
 
+    // SRAM BIST registers (sram_bist.v, beside the SRAM datapath)
+    output wire        bist_valid,
+    input wire  [31:0] bist_rdata,
+    input wire         bist_ready,
+
     // Interrupt Output
     output wire timer_irq
 );
@@ -58,6 +65,7 @@ module mmio_peripherals (
     localparam ADDR_MODE_CONTROL   = 32'h80000014;  // Bit 0: 0=Shell, 1=App
     localparam ADDR_BUTTON_INPUT   = 32'h80000018;  // Bit 0: BUT1, Bit 1: BUT2 (1=pressed)
     localparam ADDR_TIMER_BASE     = 32'h80000020;  // Timer registers (0x20-0x2F)
+    localparam ADDR_BIST_BASE      = 32'h80000040;  // SRAM BIST registers (0x40-0x7F)
 
     // LED Control Register
     reg [1:0] led_reg;
@@ -71,7 +79,9 @@ module mmio_peripherals (
     wire addr_is_timer = (mmio_addr[31:4] == 28'h8000002);
 
     // Timer Peripheral Instance
-    timer_peripheral timer (
+    timer_peripheral #(
+        .VERBOSE(VERBOSE)
+    ) timer (
         .clk(clk),
         .resetn(resetn),
         .mmio_valid(timer_valid),
@@ -86,6 +96,11 @@ module mmio_peripherals (
 
     assign timer_valid = mmio_valid && addr_is_timer;
 
+    // Address decode for SRAM BIST (0x80000040-0x8000007F)
+    wire addr_is_bist = (mmio_addr[31:6] == 26'h2000001);
+
+    assign bist_valid = mmio_valid && addr_is_bist;
+
     always @(posedge clk) begin
         if (!resetn) begin
             mmio_rdata <= 32'h0;
@@ -113,10 +128,14 @@ module mmio_peripherals (
                 // Route timer addresses to timer peripheral
                 if (addr_is_timer) begin
                     // synthesis translate_off
-                    $display("[MMIO_PERIPH] Routing to timer: addr=0x%08x write=%b ready=%b", mmio_addr, mmio_write, timer_ready);
+                    if (VERBOSE) $display("[MMIO_PERIPH] Routing to timer: addr=0x%08x write=%b ready=%b", mmio_addr, mmio_write, timer_ready);
                     // synthesis translate_on
                     mmio_rdata <= timer_rdata;
                     mmio_ready <= timer_ready;
+                end else if (addr_is_bist) begin
+                    // Route BIST addresses to sram_bist (combinational rdata)
+                    mmio_rdata <= bist_rdata;
+                    mmio_ready <= bist_ready;
                 end else if (mmio_write) begin
                     // ============ WRITE OPERATIONS ============
                     case (mmio_addr)
@@ -128,9 +147,9 @@ module mmio_peripherals (
                                 mmio_ready <= 1'b1;
 
                                 // synthesis translate_off
-                                $display("[MMIO] UART TX: 0x%02x ('%c')",
-                                         mmio_wdata[7:0],
-                                         (mmio_wdata[7:0] >= 32 && mmio_wdata[7:0] < 127) ? mmio_wdata[7:0] : 8'h2E);
+                                if (VERBOSE) $display("[MMIO] UART TX: 0x%02x ('%c')",
+                                                      mmio_wdata[7:0],
+                                                      (mmio_wdata[7:0] >= 32 && mmio_wdata[7:0] < 127) ? mmio_wdata[7:0] : 8'h2E);
                                 // synthesis translate_on
                             end
                             // If busy, don't ack - CPU must retry
@@ -144,8 +163,8 @@ module mmio_peripherals (
                             mmio_ready <= 1'b1;
 
                             // synthesis translate_off
-                            $display("[MMIO] LED control: 0x%02x (LED1=%b LED2=%b)",
-                                     mmio_wdata[1:0], mmio_wdata[0], mmio_wdata[1]);
+                            if (VERBOSE) $display("[MMIO] LED control: 0x%02x (LED1=%b LED2=%b)",
+                                                  mmio_wdata[1:0], mmio_wdata[0], mmio_wdata[1]);
                             // synthesis translate_on
                         end
 
@@ -156,8 +175,8 @@ module mmio_peripherals (
                             mmio_ready <= 1'b1;
 
                             // synthesis translate_off
-                            $display("[MMIO] Mode control write: 0x%08x (app_mode=%b)",
-                                     mmio_wdata, mmio_wdata[0]);
+                            if (VERBOSE) $display("[MMIO] Mode control write: 0x%08x (app_mode=%b)",
+                                                  mmio_wdata, mmio_wdata[0]);
                             // synthesis translate_on
                         end
 
@@ -184,9 +203,9 @@ module mmio_peripherals (
                                 mmio_ready <= 1'b1;
 
                                 // synthesis translate_off
-                                $display("[MMIO] UART RX: 0x%02x ('%c')",
-                                         uart_rx_data,
-                                         (uart_rx_data >= 32 && uart_rx_data < 127) ? uart_rx_data : 8'h2E);
+                                if (VERBOSE) $display("[MMIO] UART RX: 0x%02x ('%c')",
+                                                      uart_rx_data,
+                                                      (uart_rx_data >= 32 && uart_rx_data < 127) ? uart_rx_data : 8'h2E);
                                 // synthesis translate_on
                             end else begin
                                 // Buffer empty - return 0
@@ -201,7 +220,7 @@ module mmio_peripherals (
                             mmio_ready <= 1'b1;
 
                             // synthesis translate_off
-                            $display("[MMIO] UART RX STATUS: empty=%b, returning %b", uart_rx_empty, ~uart_rx_empty);
+                            if (VERBOSE) $display("[MMIO] UART RX STATUS: empty=%b, returning %b", uart_rx_empty, ~uart_rx_empty);
                             // synthesis translate_on
                         end
 
@@ -0,0 +1,387 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// sram_bist.v - SRAM Built-In Self-Test Engine
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Sits between sram_proc_new and sram_driver_new. Idle, it passes the
+// processor's 16-bit driver commands straight through; started over MMIO it
+// takes the driver and runs March C-, walking-bit and address-uniqueness
+// passes over a byte range at one 16-bit access per driver transaction
+// (5 clocks), instead of the ~11-clock 32-bit accesses (plus RMW for bytes)
+// a software test gets through mem_controller.
+//
+// The CPU fetches from SRAM, so its next SRAM access simply waits until the
+// run ends: a START write effectively blocks. The range must therefore not
+// cover code, data or stack - it is overwritten.
+//
+// Tests (16-bit words, B = PATTERN background, w = word address):
+//   March C-   ⇑w(B) ⇑r(B)w(~B) ⇑r(~B)w(B) ⇓r(B)w(~B) ⇓r(~B)w(B) ⇑r(B)   10N
+//   Walking    ⇑w(1<<w[3:0]) ⇑r  then  ⇑w(~(1<<w[3:0])) ⇑r                4N
+//   Address    ⇑w(w[15:0]) ⇑r    then  ⇑w(~w[17:2]) ⇑r                    4N
+// The two address passes give every word of the 512 KB a distinct value
+// pair, so any decoder alias or shorted address line reads back wrong.
+//
+//==============================================================================
+
+module sram_bist #(
+    parameter VERBOSE = 0          // 1 = start/fail/done $display trace (simulation)
+) (
+    input wire clk,
+    input wire resetn,
+
+    // MMIO Interface (0x80000040-0x8000007F)
+    input wire        mmio_valid,
+    input wire        mmio_write,
+    input wire [31:0] mmio_addr,
+    input wire [31:0] mmio_wdata,
+    input wire [ 3:0] mmio_wstrb,
+    output reg [31:0] mmio_rdata,
+    output wire       mmio_ready,
+
+    // Driver commands from sram_proc_new (passed through while idle)
+    input wire        proc_valid,
+    input wire        proc_busy,    // sram_proc_new.busy: a 32-bit access is in progress
+    output wire       proc_ready,
+    input wire        proc_we,
+    input wire [18:0] proc_addr,
+    input wire [15:0] proc_wdata,
+
+    // sram_driver_new command interface (rdata goes to both masters)
+    output wire        drv_valid,
+    input wire         drv_ready,
+    output wire        drv_we,
+    output wire [18:0] drv_addr,
+    output wire [15:0] drv_wdata,
+    input wire  [15:0] drv_rdata
+);
+
+    // =========================================================================
+    // Register Map
+    // Base: 0x80000040
+    // =========================================================================
+    // +0x00: CTRL      (R/W) [0]=START (write 1), [6:4]=test mask (March,
+    //                      walking, address; 0 = all)
+    // +0x04: STATUS    (R) [0]=BUSY [1]=DONE [2]=FAIL [3]=RANGE (bad range),
+    //                      [11:8]=step of the first failure (see step table)
+    // +0x08: START     (R/W) First byte address (halfword aligned)
+    // +0x0C: END       (R/W) End byte address, exclusive (max 0x00080000)
+    // +0x10: PATTERN   (R/W) [15:0] March C- background
+    // +0x14: FAIL_ADDR (R) Byte address of the first failing halfword
+    // +0x18: FAIL_DATA (R) [31:16]=expected, [15:0]=read
+    // +0x1C: ERRORS    (R) Failing reads in the last run (saturates)
+    // +0x20: CYCLES    (R) Clock cycles the last run held the driver
+    // +0x24: ID        (R) 0x42495354 ("BIST")
+    // =========================================================================
+
+    localparam ADDR_CTRL      = 6'h00;
+    localparam ADDR_STATUS    = 6'h04;
+    localparam ADDR_START     = 6'h08;
+    localparam ADDR_END       = 6'h0C;
+    localparam ADDR_PATTERN   = 6'h10;
+    localparam ADDR_FAIL_ADDR = 6'h14;
+    localparam ADDR_FAIL_DATA = 6'h18;
+    localparam ADDR_ERRORS    = 6'h1C;
+    localparam ADDR_CYCLES    = 6'h20;
+    localparam ADDR_ID        = 6'h24;
+
+    localparam BIST_ID = 32'h42495354;
+
+    // States
+    localparam STATE_IDLE  = 2'd0;
+    localparam STATE_GRANT = 2'd1;  // Wait for sram_proc_new to leave the driver
+    localparam STATE_RUN   = 2'd2;
+
+    // Steps: 0-5 March C- elements, 6-9 walking, 10-13 address, 15 = end
+    localparam STEP_MARCH = 4'd0;
+    localparam STEP_WALK  = 4'd6;
+    localparam STEP_ADDR  = 4'd10;
+    localparam STEP_END   = 4'd15;
+
+    // Data selects
+    localparam D_BG    = 3'd0;      // Background
+    localparam D_NBG   = 3'd1;      // Inverted background
+    localparam D_WALK1 = 3'd2;      // One bit set, position from the address
+    localparam D_WALK0 = 3'd3;      // One bit clear
+    localparam D_ADDRL = 3'd4;      // Word address bits 15:0
+    localparam D_ADDRH = 3'd5;      // Inverted word address bits 17:2
+
+    reg [1:0]  state;
+    reg        owner;               // 1 = the BIST drives sram_driver_new
+    reg        bist_valid;
+
+    // Configuration
+    reg [2:0]  test_mask;
+    reg [19:0] start_addr;
+    reg [19:0] end_addr;
+    reg [15:0] pattern;
+
+    // Results
+    reg        done;
+    reg        fail;
+    reg        range_err;
+    reg [3:0]  fail_step;
+    reg [18:0] fail_addr;
+    reg [31:0] fail_data;
+    reg [31:0] errors;
+    reg [31:0] cycles;
+
+    // Sequencer
+    reg [3:0]  step;
+    reg        op;                  // Second operation of a read-write element
+    reg [17:0] waddr;
+    reg [17:0] first_w;
+    reg [17:0] last_w;
+
+    // MMIO ready - combinational response (same cycle)
+    assign mmio_ready = mmio_valid;
+
+    // Driver ownership
+    assign drv_valid  = owner ? bist_valid : proc_valid;
+    assign proc_ready = owner ? 1'b0 : drv_ready;
+
+    // -------------------------------------------------------------------------
+    // Step table
+    // -------------------------------------------------------------------------
+    reg       st_down;              // Descending addresses
+    reg       st_two;               // Read then write at each address
+    reg       st_read;              // First operation is a read
+    reg [2:0] st_d0;                // Data of the first operation
+    reg [2:0] st_d1;                // Data of the second (always a write)
+
+    always @(*) begin
+        st_down = 1'b0;
+        st_two  = 1'b0;
+        st_read = 1'b1;
+        st_d0   = D_BG;
+        st_d1   = D_BG;
+        case (step)
+            4'd0:  begin st_read = 1'b0; st_d0 = D_BG; end
+            4'd1:  begin st_two = 1'b1;  st_d0 = D_BG;  st_d1 = D_NBG; end
+            4'd2:  begin st_two = 1'b1;  st_d0 = D_NBG; st_d1 = D_BG;  end
+            4'd3:  begin st_down = 1'b1; st_two = 1'b1; st_d0 = D_BG;  st_d1 = D_NBG; end
+            4'd4:  begin st_down = 1'b1; st_two = 1'b1; st_d0 = D_NBG; st_d1 = D_BG;  end
+            4'd5:  st_d0 = D_BG;
+            4'd6:  begin st_read = 1'b0; st_d0 = D_WALK1; end
+            4'd7:  st_d0 = D_WALK1;
+            4'd8:  begin st_read = 1'b0; st_d0 = D_WALK0; end
+            4'd9:  st_d0 = D_WALK0;
+            4'd10: begin st_read = 1'b0; st_d0 = D_ADDRL; end
+            4'd11: st_d0 = D_ADDRL;
+            4'd12: begin st_read = 1'b0; st_d0 = D_ADDRH; end
+            4'd13: st_d0 = D_ADDRH;
+            default: ;
+        endcase
+    end
+
+    // Current operation
+    wire [2:0] cur_dsel = op ? st_d1 : st_d0;
+    wire       cur_we   = op | ~st_read;
+    reg [15:0] cur_data;
+
+    always @(*) begin
+        case (cur_dsel)
+            D_BG:    cur_data = pattern;
+            D_NBG:   cur_data = ~pattern;
+            D_WALK1: cur_data = 16'h0001 << waddr[3:0];
+            D_WALK0: cur_data = ~(16'h0001 << waddr[3:0]);
+            D_ADDRL: cur_data = waddr[15:0];
+            D_ADDRH: cur_data = ~waddr[17:2];
+            default: cur_data = 16'h0000;
+        endcase
+    end
+
+    assign drv_we    = owner ? cur_we : proc_we;
+    assign drv_addr  = owner ? {1'b0, waddr} : proc_addr;
+    assign drv_wdata = owner ? cur_data : proc_wdata;
+
+    // Last address of the current pass
+    wire at_end = st_down ? (waddr == first_w) : (waddr == last_w);
+
+    // First step of the first enabled test at or after 'from'
+    function [3:0] first_step;
+        input [3:0] from;
+        input [2:0] mask;
+        begin
+            if (from <= STEP_MARCH && mask[0])
+                first_step = STEP_MARCH;
+            else if (from <= STEP_WALK && mask[1])
+                first_step = STEP_WALK;
+            else if (from <= STEP_ADDR && mask[2])
+                first_step = STEP_ADDR;
+            else
+                first_step = STEP_END;
+        end
+    endfunction
+
+    // Step after the current one
+    wire       test_last = (step == 4'd5) || (step == 4'd9) || (step == 4'd13);
+    wire [3:0] next_step = test_last ? first_step(step + 4'd1, test_mask) : step + 4'd1;
+    wire       next_down = (next_step == 4'd3) || (next_step == 4'd4);
+
+    // Range check for START (END is exclusive, at most the 512 KB top)
+    wire [19:0] wr_end    = (mmio_wdata[19:0] > 20'h80000 || mmio_wdata[31:20] != 12'h0) ?
+                            20'h80000 : mmio_wdata[19:0];
+    wire        range_ok  = (start_addr < end_addr) && (start_addr < 20'h80000);
+    wire [2:0]  wr_mask   = (mmio_wdata[6:4] == 3'b000) ? 3'b111 : mmio_wdata[6:4];
+
+    // -------------------------------------------------------------------------
+    // Sequencer and registers
+    // -------------------------------------------------------------------------
+    always @(posedge clk) begin
+        if (!resetn) begin
+            state <= STATE_IDLE;
+            owner <= 1'b0;
+            bist_valid <= 1'b0;
+            test_mask <= 3'b111;
+            start_addr <= 20'h0;
+            end_addr <= 20'h0;
+            pattern <= 16'h0000;
+            done <= 1'b0;
+            fail <= 1'b0;
+            range_err <= 1'b0;
+            fail_step <= 4'h0;
+            fail_addr <= 19'h0;
+            fail_data <= 32'h0;
+            errors <= 32'h0;
+            cycles <= 32'h0;
+            step <= STEP_END;
+            op <= 1'b0;
+            waddr <= 18'h0;
+            first_w <= 18'h0;
+            last_w <= 18'h0;
+        end else begin
+            case (state)
+                STATE_IDLE: begin
+                    if (mmio_valid && mmio_write && mmio_wstrb[0]) begin
+                        case (mmio_addr[5:0])
+                            ADDR_START:   start_addr <= {mmio_wdata[19:1], 1'b0};
+                            ADDR_END:     end_addr <= {wr_end[19:1], 1'b0};
+                            ADDR_PATTERN: pattern <= mmio_wdata[15:0];
+                            ADDR_CTRL: begin
+                                test_mask <= wr_mask;
+                                if (mmio_wdata[0]) begin
+                                    done <= 1'b0;
+                                    fail <= 1'b0;
+                                    fail_step <= 4'h0;
+                                    fail_addr <= 19'h0;
+                                    fail_data <= 32'h0;
+                                    errors <= 32'h0;
+                                    cycles <= 32'h0;
+                                    op <= 1'b0;
+                                    step <= first_step(STEP_MARCH, wr_mask);
+                                    waddr <= start_addr[18:1];
+                                    first_w <= start_addr[18:1];
+                                    last_w <= end_addr[18:1] - 18'd1;
+
+                                    if (range_ok) begin
+                                        range_err <= 1'b0;
+                                        state <= STATE_GRANT;
+                                    end else begin
+                                        range_err <= 1'b1;
+                                        done <= 1'b1;
+                                    end
+
+                                    // synthesis translate_off
+                                    if (VERBOSE) $display("[SRAM_BIST] START: 0x%05x-0x%05x mask=%b pattern=0x%04x",
+                                                          start_addr, end_addr, wr_mask, pattern);
+                                    // synthesis translate_on
+                                end
+                            end
+                            default: ;
+                        endcase
+                    end
+                end
+
+                STATE_GRANT: begin
+                    cycles <= cycles + 32'd1;
+
+                    // Valid drops between the two halves (and around the
+                    // read-modify-write) of a 32-bit access, so also wait
+                    // for sram_proc_new to go idle before taking the driver
+                    if (!proc_valid && !proc_busy) begin
+                        owner <= 1'b1;
+                        bist_valid <= 1'b1;
+                        state <= STATE_RUN;
+                    end
+                end
+
+                STATE_RUN: begin
+                    cycles <= cycles + 32'd1;
+
+                    if (drv_ready) begin
+                        // Check the read that just completed
+                        if (!cur_we && drv_rdata != cur_data) begin
+                            if (errors != 32'hFFFFFFFF)
+                                errors <= errors + 32'd1;
+                            if (!fail) begin
+                                fail <= 1'b1;
+                                fail_step <= step;
+                                fail_addr <= {waddr, 1'b0};
+                                fail_data <= {cur_data, drv_rdata};
+
+                                // synthesis translate_off
+                                if (VERBOSE) $display("[SRAM_BIST] FAIL: step %0d addr=0x%05x expected=0x%04x read=0x%04x",
+                                                      step, {waddr, 1'b0}, cur_data, drv_rdata);
+                                // synthesis translate_on
+                            end
+                        end
+
+                        // Next operation: valid stays high, the driver
+                        // latches the new command when it returns to IDLE
+                        if (st_two && !op) begin
+                            op <= 1'b1;
+                        end else begin
+                            op <= 1'b0;
+                            if (!at_end) begin
+                                waddr <= st_down ? waddr - 18'd1 : waddr + 18'd1;
+                            end else if (next_step != STEP_END) begin
+                                step <= next_step;
+                                waddr <= next_down ? last_w : first_w;
+                            end else begin
+                                step <= STEP_END;
+                                bist_valid <= 1'b0;
+                                owner <= 1'b0;
+                                done <= 1'b1;
+                                state <= STATE_IDLE;
+
+                                // synthesis translate_off
+                                if (VERBOSE) $display("[SRAM_BIST] DONE: %0d cycles, %0d errors",
+                                                      cycles + 1, errors);
+                                // synthesis translate_on
+                            end
+                        end
+                    end
+                end
+
+                default: state <= STATE_IDLE;
+            endcase
+        end
+    end
+
+    // -------------------------------------------------------------------------
+    // MMIO reads (combinational, sampled by mmio_peripherals)
+    // -------------------------------------------------------------------------
+    always @(*) begin
+        case (mmio_addr[5:0])
+            ADDR_CTRL:      mmio_rdata = {25'h0, test_mask, 4'h0};
+            ADDR_STATUS:    mmio_rdata = {20'h0, fail_step, 4'h0,
+                                          range_err, fail, done, (state != STATE_IDLE)};
+            ADDR_START:     mmio_rdata = {12'h0, start_addr};
+            ADDR_END:       mmio_rdata = {12'h0, end_addr};
+            ADDR_PATTERN:   mmio_rdata = {16'h0, pattern};
+            ADDR_FAIL_ADDR: mmio_rdata = {13'h0, fail_addr};
+            ADDR_FAIL_DATA: mmio_rdata = fail_data;
+            ADDR_ERRORS:    mmio_rdata = errors;
+            ADDR_CYCLES:    mmio_rdata = cycles;
+            ADDR_ID:        mmio_rdata = BIST_ID;
+            default:        mmio_rdata = 32'h0;
+        endcase
+    end
+
+endmodule
@@ -9,7 +9,9 @@
 // Educational and research purposes only
 //==============================================================================
 
-module sram_driver_new (
+module sram_driver_new #(
+    parameter VERBOSE = 0          // 1 = per-access $display trace (simulation)
+) (
     input wire clk,
     input wire resetn,
 
@@ -75,8 +77,8 @@ module sram_driver_new (
                         we_reg <= we;
 
                         // synthesis translate_off
-                        $display("[SRAM_DRIVER] IDLE->SETUP: addr=0x%05x data=0x%04x we=%b",
-                                 addr[17:0], wdata, we);
+                        if (VERBOSE) $display("[SRAM_DRIVER] IDLE->SETUP: addr=0x%05x data=0x%04x we=%b",
+                                              addr[17:0], wdata, we);
                         // synthesis translate_on
 
                         state <= SETUP;
@@ -97,8 +99,8 @@ module sram_driver_new (
                         sram_oe_n <= 1'b1;  // OE must be high during write
 
                         // synthesis translate_off
-                        $display("[SRAM_DRIVER] SETUP(WRITE): addr=0x%05x data=0x%04x",
-                                 addr_reg, wdata_reg);
+                        if (VERBOSE) $display("[SRAM_DRIVER] SETUP(WRITE): addr=0x%05x data=0x%04x",
+                                              addr_reg, wdata_reg);
                         // synthesis translate_on
                     end else begin
                         // READ: Assert OE, keep WE high
@@ -107,7 +109,7 @@ module sram_driver_new (
                         data_oe <= 1'b0;
 
                         // synthesis translate_off
-                        $display("[SRAM_DRIVER] SETUP(READ): addr=0x%05x", addr_reg);
+                        if (VERBOSE) $display("[SRAM_DRIVER] SETUP(READ): addr=0x%05x", addr_reg);
                         // synthesis translate_on
                     end
 
@@ -129,8 +131,8 @@ module sram_driver_new (
                         data_oe <= 1'b1;
 
                         // synthesis translate_off
-                        $display("[SRAM_DRIVER] ACTIVE(WRITE): WE asserted, addr=0x%05x data=0x%04x",
-                                 addr_reg, wdata_reg);
+                        if (VERBOSE) $display("[SRAM_DRIVER] ACTIVE(WRITE): WE asserted, addr=0x%05x data=0x%04x",
+                                              addr_reg, wdata_reg);
                         // synthesis translate_on
                     end else begin
                         // READ: Sample data from SRAM
@@ -140,7 +142,7 @@ module sram_driver_new (
                         rdata <= sram_data;
 
                         // synthesis translate_off
-                        $display("[SRAM_DRIVER] ACTIVE(READ): Sampling data=0x%04x", sram_data);
+                        if (VERBOSE) $display("[SRAM_DRIVER] ACTIVE(READ): Sampling data=0x%04x", sram_data);
                         // synthesis translate_on
                     end
 
@@ -159,7 +161,7 @@ module sram_driver_new (
                         data_oe <= 1'b0;  // Release bus
 
                         // synthesis translate_off
-                        $display("[SRAM_DRIVER] RECOVERY(WRITE): Complete");
+                        if (VERBOSE) $display("[SRAM_DRIVER] RECOVERY(WRITE): Complete");
                         // synthesis translate_on
                     end else begin
                         // READ: Complete, data already sampled
@@ -168,7 +170,7 @@ module sram_driver_new (
                         sram_we_n <= 1'b1;
 
                         // synthesis translate_off
-                        $display("[SRAM_DRIVER] RECOVERY(READ): Complete, rdata=0x%04x", rdata);
+                        if (VERBOSE) $display("[SRAM_DRIVER] RECOVERY(READ): Complete, rdata=0x%04x", rdata);
                         // synthesis translate_on
                     end
 
@@ -185,7 +187,7 @@ module sram_driver_new (
                     data_oe <= 1'b0;
 
                     // synthesis translate_off
-                    $display("[SRAM_DRIVER] COOLDOWN");
+                    if (VERBOSE) $display("[SRAM_DRIVER] COOLDOWN");
                     // synthesis translate_on
 
                     state <= IDLE;
@@ -11,7 +11,9 @@
 // OPTIMIZATION: Reduced from 5-cycle to 2-cycle access for 2.5x speedup
 //==============================================================================
 
-module sram_driver_new (
+module sram_driver_new #(
+    parameter VERBOSE = 0          // 1 = per-access $display trace (simulation)
+) (
     input wire clk,
     input wire resetn,
 
@@ -75,8 +77,8 @@ module sram_driver_new (
                         we_reg <= we;
 
                         // synthesis translate_off
-                        $display("[SRAM_2CYC] IDLE->ACTIVE: addr=0x%05x data=0x%04x we=%b t=%0t",
-                                 addr[17:0], wdata, we, $time);
+                        if (VERBOSE) $display("[SRAM_2CYC] IDLE->ACTIVE: addr=0x%05x data=0x%04x we=%b t=%0t",
+                                              addr[17:0], wdata, we, $time);
                         // synthesis translate_on
 
                         state <= ACTIVE;
@@ -103,8 +105,8 @@ module sram_driver_new (
                         sram_oe_n <= 1'b1;  // OE must be HIGH during writes
 
                         // synthesis translate_off
-                        $display("[SRAM_2CYC] ACTIVE(WRITE): addr=0x%05x data=0x%04x WE=0 t=%0t",
-                                 addr_reg, wdata_reg, $time);
+                        if (VERBOSE) $display("[SRAM_2CYC] ACTIVE(WRITE): addr=0x%05x data=0x%04x WE=0 t=%0t",
+                                              addr_reg, wdata_reg, $time);
                         // synthesis translate_on
                     end else begin
                         // READ: Assert address, CS, and OE simultaneously
@@ -115,8 +117,8 @@ module sram_driver_new (
                         data_oe <= 1'b0;    // Tri-state our output
 
                         // synthesis translate_off
-                        $display("[SRAM_2CYC] ACTIVE(READ): addr=0x%05x OE=0 t=%0t",
-                                 addr_reg, $time);
+                        if (VERBOSE) $display("[SRAM_2CYC] ACTIVE(READ): addr=0x%05x OE=0 t=%0t",
+                                              addr_reg, $time);
                         // synthesis translate_on
                     end
 
@@ -141,7 +143,7 @@ module sram_driver_new (
                         ready <= 1'b1;          // Signal completion
 
                         // synthesis translate_off
-                        $display("[SRAM_2CYC] COMPLETE(WRITE): WE=1 (write latched) ready=1 t=%0t", $time);
+                        if (VERBOSE) $display("[SRAM_2CYC] COMPLETE(WRITE): WE=1 (write latched) ready=1 t=%0t", $time);
                         // synthesis translate_on
                     end else begin
                         // READ COMPLETION:
@@ -155,8 +157,8 @@ module sram_driver_new (
                         ready <= 1'b1;          // Signal completion
 
                         // synthesis translate_off
-                        $display("[SRAM_2CYC] COMPLETE(READ): data=0x%04x ready=1 t=%0t",
-                                sram_data, $time);
+                        if (VERBOSE) $display("[SRAM_2CYC] COMPLETE(READ): data=0x%04x ready=1 t=%0t",
+                                             sram_data, $time);
                         // synthesis translate_on
                     end
 
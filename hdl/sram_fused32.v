@@ -0,0 +1,470 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// sram_fused32.v - Fused 32-bit SRAM Engine (pipelined halves, read-ahead)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//
+// Drop-in replacement for sram_proc_new + sram_driver_new: the same command
+// interface on one side, the K6R4016 pins on the other, with no 16-bit
+// valid/ready handshake in between. Selected with SRAM_FUSED=1 on
+// ice40_picorv32_top (make SRAM_FUSED=1 synth).
+//
+// READ  (CS#/OE# stay low, one halfword per clock):
+//   edge 0: start seen, SA <= low half
+//   edge 1: capture low half, SA <= high half
+//   edge 2: capture high half, done
+//   With PREFETCH=1 the engine keeps CS#/OE# low and reads the next word
+//   (edges 2-4) while mem_controller and the CPU turn around. A read of
+//   that word is answered on the edge its start is seen, and the following
+//   word is fetched behind it, so straight-line code streams at one
+//   request per CPU fetch with no per-transaction SRAM turnaround.
+//
+// WRITE (two clocks per halfword):
+//   SETUP: SA and SD driven, WE# high
+//   PULSE: WE# low from the rising edge to the falling edge (10 ns)
+//   SA/SD change only on the next rising edge, so tAS, tWR and tDH are all
+//   10-20 ns instead of the 0 ns allowed by the datasheet. Byte and
+//   halfword stores read both halves first (read-modify-write) and only
+//   write back the halves with strobes set.
+//
+// CRC (CMD_CRC, addr_in = start, data_in = end): streams the range at one
+// halfword per clock; the CRC of each word is folded in on the following
+// clock, off the pad-to-register path.
+//
+// Bus turnaround: OE# is high for a full clock before SD is driven, and SD
+// is released for a full clock before OE# goes low again.
+// See docs/SRAM_2CYCLE_TIMING.md ("Fused 32-bit Engine") for the timing.
+//==============================================================================
+
+module sram_fused32 #(
+    parameter VERBOSE = 0,         // 1 = per-access $display trace (simulation)
+    parameter PREFETCH = 1         // 1 = read the next word ahead after a read
+) (
+    input wire clk,
+    input wire resetn,
+
+    // Command interface (same as sram_proc_new)
+    input wire start,
+    input wire [7:0] cmd,
+    input wire [31:0] addr_in,      // Byte address
+    input wire [31:0] data_in,      // 32-bit data (end address for CMD_CRC)
+    input wire [3:0] mem_wstrb,     // Write strobes: [3]=byte3 ... [0]=byte0
+    output reg busy,
+    output reg done,
+    output reg [31:0] result,
+    output reg [15:0] result_low,
+    output reg [15:0] result_high,
+
+    // UART interface (unused, kept for sram_proc_new compatibility)
+    input wire [7:0] rx_byte,
+    input wire rx_valid,
+    output reg [7:0] tx_data,
+    output reg tx_valid,
+    input wire tx_ready,
+
+    // SRAM Physical Interface (same as sram_driver_new)
+    output reg [17:0] sram_addr,
+    inout wire [15:0] sram_data,
+    output reg sram_cs_n,
+    output reg sram_oe_n,
+    output wire sram_we_n
+);
+
+    // Command codes
+    localparam CMD_READ  = 8'h01;
+    localparam CMD_WRITE = 8'h02;
+    localparam CMD_CRC   = 8'h04;
+
+    // States (named for what the SRAM pins do during the cycle)
+    localparam S_IDLE     = 4'd0;   // CS#/OE#/WE# high, SD released
+    localparam S_RD_LO    = 4'd1;   // Low half addressed
+    localparam S_RD_HI    = 4'd2;   // High half addressed, low half captured
+    localparam S_PF_LO    = 4'd3;   // Read-ahead: low half addressed
+    localparam S_PF_HI    = 4'd4;   // Read-ahead: high half addressed
+    localparam S_TURN     = 4'd5;   // OE# high, SD released (read -> write)
+    localparam S_WR_SETUP = 4'd6;   // SA/SD driven, WE# high
+    localparam S_WR_PULSE = 4'd7;   // WE# low for the first half of the cycle
+    localparam S_CRC_LO   = 4'd8;
+    localparam S_CRC_HI   = 4'd9;
+    localparam S_CRC_DONE = 4'd10;  // Last word folded in, result out
+
+    reg [3:0] state;
+
+    // Request seen while not idle (mem_controller pulses start once)
+    reg        req;
+    reg [7:0]  req_cmd;
+    reg [31:0] req_addr;
+    reg [31:0] req_data;
+    reg [3:0]  req_wstrb;
+
+    wire        go       = start | req;
+    wire [7:0]  go_cmd   = req ? req_cmd   : cmd;
+    wire [31:0] go_addr  = req ? req_addr  : addr_in;
+    wire [31:0] go_data  = req ? req_data  : data_in;
+    wire [3:0]  go_wstrb = req ? req_wstrb : mem_wstrb;
+
+    // Current word
+    reg [16:0] w_addr;              // Word index (byte address [18:2])
+    reg [31:0] w_data;
+    reg [3:0]  w_wstrb;
+    reg [15:0] w_lo;                // Captured low half
+    reg        rmw;                 // Read is the first half of a partial store
+    reg        wr_hi;               // Half being written (0 = low)
+    reg        wr_more;             // High half still to write after the low
+
+    // Read-ahead buffer
+    reg [16:0] pf_addr;
+    reg [31:0] pf_data;
+    reg        pf_valid;
+
+    // CRC32 stream
+    reg [31:0] crc_value;
+    reg [31:0] crc_addr;
+    reg [31:0] crc_end;
+    reg [31:0] crc_word;
+    reg        crc_pend;
+
+    // Data bus and WE# pulse
+    reg [15:0] data_out;
+    reg        data_oe;
+    reg        we_p;                // Set for an S_WR_PULSE cycle (rising edge)
+    reg        we_neg;              // we_p seen on the falling edge
+
+    assign sram_data = data_oe ? data_out : 16'hzzzz;
+
+    // WE# falls on the rising edge that starts S_WR_PULSE and rises on the
+    // falling edge of the same cycle. The two inputs change on opposite clock
+    // edges, so the gate cannot glitch.
+    assign sram_we_n = ~(we_p & ~we_neg);
+
+    always @(negedge clk) begin
+        if (!resetn)
+            we_neg <= 1'b0;
+        else
+            we_neg <= we_p;
+    end
+
+    // CRC32 calculation (Ethernet polynomial, as in sram_proc_new)
+    function [31:0] crc32_update;
+        input [31:0] crc;
+        input [31:0] data;
+        integer i;
+        reg [31:0] temp_crc;
+        reg [31:0] temp_data;
+        begin
+            temp_crc = crc;
+            temp_data = data;
+            for (i = 0; i < 32; i = i + 1) begin
+                if (temp_crc[0] ^ temp_data[0])
+                    temp_crc = (temp_crc >> 1) ^ 32'hEDB88320;
+                else
+                    temp_crc = temp_crc >> 1;
+                temp_data = temp_data >> 1;
+            end
+            crc32_update = temp_crc;
+        end
+    endfunction
+
+    // Store strobes: which halves are written, and whether a half needs its
+    // old contents first
+    wire go_wr_lo   = |go_wstrb[1:0];
+    wire go_wr_hi   = |go_wstrb[3:2];
+    wire go_partial = (go_wr_lo && go_wstrb[1:0] != 2'b11) ||
+                      (go_wr_hi && go_wstrb[3:2] != 2'b11);
+
+    always @(posedge clk) begin
+        if (!resetn) begin
+            state <= S_IDLE;
+            busy <= 1'b0;
+            done <= 1'b0;
+            result <= 32'h0;
+            result_low <= 16'h0;
+            result_high <= 16'h0;
+            tx_data <= 8'h0;
+            tx_valid <= 1'b0;
+            sram_addr <= 18'h0;
+            sram_cs_n <= 1'b1;
+            sram_oe_n <= 1'b1;
+            data_out <= 16'h0;
+            data_oe <= 1'b0;
+            we_p <= 1'b0;
+            req <= 1'b0;
+            req_cmd <= 8'h0;
+            req_addr <= 32'h0;
+            req_data <= 32'h0;
+            req_wstrb <= 4'h0;
+            w_addr <= 17'h0;
+            w_data <= 32'h0;
+            w_wstrb <= 4'h0;
+            w_lo <= 16'h0;
+            rmw <= 1'b0;
+            wr_hi <= 1'b0;
+            wr_more <= 1'b0;
+            pf_addr <= 17'h0;
+            pf_data <= 32'h0;
+            pf_valid <= 1'b0;
+            crc_value <= 32'hFFFFFFFF;
+            crc_addr <= 32'h0;
+            crc_end <= 32'h0;
+            crc_word <= 32'h0;
+            crc_pend <= 1'b0;
+        end else begin
+            done <= 1'b0;
+            tx_valid <= 1'b0;
+
+            // Hold a request that arrives mid-sequence for S_IDLE
+            if (start && state != S_IDLE) begin
+                req <= 1'b1;
+                req_cmd <= cmd;
+                req_addr <= addr_in;
+                req_data <= data_in;
+                req_wstrb <= mem_wstrb;
+            end
+
+            // Fold the previous CRC word in, one clock after its capture
+            if (crc_pend) begin
+                crc_value <= crc32_update(crc_value, crc_word);
+                crc_pend <= 1'b0;
+            end
+
+            case (state)
+                S_IDLE: begin
+                    sram_cs_n <= 1'b1;
+                    sram_oe_n <= 1'b1;
+                    data_oe <= 1'b0;
+                    we_p <= 1'b0;
+                    busy <= 1'b0;
+
+                    if (go) begin
+                        req <= 1'b0;
+                        busy <= 1'b1;
+                        w_addr <= go_addr[18:2];
+                        w_data <= go_data;
+                        w_wstrb <= go_wstrb;
+                        rmw <= 1'b0;
+
+                        // synthesis translate_off
+                        if (VERBOSE) $display("[SRAM_FUSED] START: cmd=0x%02x addr=0x%08x data=0x%08x wstrb=0x%01x",
+                                              go_cmd, go_addr, go_data, go_wstrb);
+                        // synthesis translate_on
+
+                        case (go_cmd)
+                            CMD_READ: begin
+                                if (pf_valid && pf_addr == go_addr[18:2]) begin
+                                    // Read-ahead hit: answer now, fetch the next word
+                                    result <= pf_data;
+                                    result_low <= pf_data[15:0];
+                                    result_high <= pf_data[31:16];
+                                    done <= 1'b1;
+                                    busy <= 1'b0;
+                                    pf_valid <= 1'b0;
+                                    pf_addr <= pf_addr + 17'd1;
+                                    sram_addr <= {pf_addr + 17'd1, 1'b0};
+                                    sram_cs_n <= 1'b0;
+                                    sram_oe_n <= 1'b0;
+                                    state <= S_PF_LO;
+
+                                    // synthesis translate_off
+                                    if (VERBOSE) $display("[SRAM_FUSED] READ hit: data=0x%08x", pf_data);
+                                    // synthesis translate_on
+                                end else begin
+                                    sram_addr <= {go_addr[18:2], 1'b0};
+                                    sram_cs_n <= 1'b0;
+                                    sram_oe_n <= 1'b0;
+                                    state <= S_RD_LO;
+                                end
+                            end
+
+                            CMD_WRITE: begin
+                                if (pf_addr == go_addr[18:2])
+                                    pf_valid <= 1'b0;
+
+                                if (go_partial) begin
+                                    // Old contents first, merged in S_RD_HI
+                                    rmw <= 1'b1;
+                                    sram_addr <= {go_addr[18:2], 1'b0};
+                                    sram_cs_n <= 1'b0;
+                                    sram_oe_n <= 1'b0;
+                                    state <= S_RD_LO;
+                                end else if (go_wr_lo || go_wr_hi) begin
+                                    wr_hi <= !go_wr_lo;
+                                    wr_more <= go_wr_lo && go_wr_hi;
+                                    sram_addr <= {go_addr[18:2], !go_wr_lo};
+                                    data_out <= go_wr_lo ? go_data[15:0] : go_data[31:16];
+                                    data_oe <= 1'b1;
+                                    sram_cs_n <= 1'b0;
+                                    state <= S_WR_SETUP;
+                                end else begin
+                                    // No strobes: nothing to store
+                                    result <= 32'h0;
+                                    done <= 1'b1;
+                                    busy <= 1'b0;
+                                end
+                            end
+
+                            CMD_CRC: begin
+                                crc_value <= 32'hFFFFFFFF;
+                                crc_pend <= 1'b0;
+                                crc_addr <= go_addr;
+                                crc_end <= go_data;
+                                sram_addr <= {go_addr[18:2], 1'b0};
+                                sram_cs_n <= 1'b0;
+                                sram_oe_n <= 1'b0;
+                                state <= S_CRC_LO;
+                            end
+
+                            default: begin
+                                done <= 1'b1;
+                                busy <= 1'b0;
+                            end
+                        endcase
+                    end
+                end
+
+                // ============ READ (one halfword per clock) ============
+                S_RD_LO: begin
+                    w_lo <= sram_data;
+                    sram_addr <= {w_addr, 1'b1};
+                    state <= S_RD_HI;
+                end
+
+                S_RD_HI: begin
+                    if (rmw) begin
+                        // Merge the store into the old word, then turn the bus
+                        w_data[7:0]   <= w_wstrb[0] ? w_data[7:0]   : w_lo[7:0];
+                        w_data[15:8]  <= w_wstrb[1] ? w_data[15:8]  : w_lo[15:8];
+                        w_data[23:16] <= w_wstrb[2] ? w_data[23:16] : sram_data[7:0];
+                        w_data[31:24] <= w_wstrb[3] ? w_data[31:24] : sram_data[15:8];
+                        sram_oe_n <= 1'b1;
+                        state <= S_TURN;
+
+                        // synthesis translate_off
+                        if (VERBOSE) $display("[SRAM_FUSED] RMW old=0x%08x wstrb=0x%01x",
+                                              {sram_data, w_lo}, w_wstrb);
+                        // synthesis translate_on
+                    end else begin
+                        result <= {sram_data, w_lo};
+                        result_low <= w_lo;
+                        result_high <= sram_data;
+                        done <= 1'b1;
+                        busy <= 1'b0;
+
+                        // synthesis translate_off
+                        if (VERBOSE) $display("[SRAM_FUSED] READ: word=0x%05x data=0x%08x",
+                                              w_addr, {sram_data, w_lo});
+                        // synthesis translate_on
+
+                        if (PREFETCH) begin
+                            // Stay selected and read the next word ahead
+                            pf_valid <= 1'b0;
+                            pf_addr <= w_addr + 17'd1;
+                            sram_addr <= {w_addr + 17'd1, 1'b0};
+                            state <= S_PF_LO;
+                        end else begin
+                            sram_cs_n <= 1'b1;
+                            sram_oe_n <= 1'b1;
+                            state <= S_IDLE;
+                        end
+                    end
+                end
+
+                S_PF_LO: begin
+                    w_lo <= sram_data;
+                    sram_addr <= {pf_addr, 1'b1};
+                    state <= S_PF_HI;
+                end
+
+                S_PF_HI: begin
+                    pf_data <= {sram_data, w_lo};
+                    pf_valid <= 1'b1;
+                    sram_cs_n <= 1'b1;
+                    sram_oe_n <= 1'b1;
+                    state <= S_IDLE;
+                end
+
+                // ============ WRITE (two clocks per halfword) ============
+                S_TURN: begin
+                    // OE# has been high for this whole cycle: drive SD now
+                    wr_hi <= !(|w_wstrb[1:0]);
+                    wr_more <= (|w_wstrb[1:0]) && (|w_wstrb[3:2]);
+                    sram_addr <= {w_addr, !(|w_wstrb[1:0])};
+                    data_out <= (|w_wstrb[1:0]) ? w_data[15:0] : w_data[31:16];
+                    data_oe <= 1'b1;
+                    state <= S_WR_SETUP;
+                end
+
+                S_WR_SETUP: begin
+                    we_p <= 1'b1;
+                    state <= S_WR_PULSE;
+                end
+
+                S_WR_PULSE: begin
+                    // WE# rose at the falling edge; SA/SD may move now
+                    we_p <= 1'b0;
+
+                    // synthesis translate_off
+                    if (VERBOSE) $display("[SRAM_FUSED] WRITE: half=0x%05x data=0x%04x",
+                                          {w_addr, wr_hi}, data_out);
+                    // synthesis translate_on
+
+                    if (wr_more) begin
+                        wr_more <= 1'b0;
+                        wr_hi <= 1'b1;
+                        sram_addr <= {w_addr, 1'b1};
+                        data_out <= w_data[31:16];
+                        state <= S_WR_SETUP;
+                    end else begin
+                        result <= 32'h0;
+                        done <= 1'b1;
+                        busy <= 1'b0;
+                        data_oe <= 1'b0;
+                        sram_cs_n <= 1'b1;
+                        state <= S_IDLE;
+                    end
+                end
+
+                // ============ CRC32 (streamed) ============
+                S_CRC_LO: begin
+                    w_lo <= sram_data;
+                    sram_addr <= {crc_addr[18:2], 1'b1};
+                    state <= S_CRC_HI;
+                end
+
+                S_CRC_HI: begin
+                    crc_word <= {sram_data, w_lo};
+                    crc_pend <= 1'b1;
+                    crc_addr <= crc_addr + 32'd4;
+
+                    if (crc_addr + 32'd4 >= crc_end) begin
+                        sram_cs_n <= 1'b1;
+                        sram_oe_n <= 1'b1;
+                        state <= S_CRC_DONE;
+                    end else begin
+                        sram_addr <= {crc_addr[18:2] + 17'd1, 1'b0};
+                        state <= S_CRC_LO;
+                    end
+                end
+
+                S_CRC_DONE: begin
+                    if (!crc_pend) begin
+                        result <= ~crc_value;
+                        done <= 1'b1;
+                        busy <= 1'b0;
+                        state <= S_IDLE;
+
+                        // synthesis translate_off
+                        if (VERBOSE) $display("[SRAM_FUSED] CRC: result=0x%08x", ~crc_value);
+                        // synthesis translate_on
+                    end
+                end
+
+                default: state <= S_IDLE;
+            endcase
+        end
+    end
+
+endmodule
@@ -9,7 +9,9 @@
 // Educational and research purposes only
 //==============================================================================
 
-module sram_proc_new (
+module sram_proc_new #(
+    parameter VERBOSE = 0          // 1 = per-access $display trace (simulation)
+) (
     input wire clk,
     input wire resetn,
 
@@ -152,8 +154,8 @@ module sram_proc_new (
                         current_wstrb <= mem_wstrb;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] START: cmd=0x%02x addr=0x%08x data=0x%08x wstrb=0x%01x",
-                                 cmd, addr_in, data_in, mem_wstrb);
+                        if (VERBOSE) $display("[SRAM_PROC] START: cmd=0x%02x addr=0x%08x data=0x%08x wstrb=0x%01x",
+                                              cmd, addr_in, data_in, mem_wstrb);
                         // synthesis translate_on
 
                         case (cmd)
@@ -191,15 +193,15 @@ module sram_proc_new (
                         sram_valid <= 1'b1;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] READ_LOW: byte_addr=0x%08x word_addr=0x%05x",
-                                 current_addr, current_addr[18:1]);
+                        if (VERBOSE) $display("[SRAM_PROC] READ_LOW: byte_addr=0x%08x word_addr=0x%05x",
+                                              current_addr, current_addr[18:1]);
                         // synthesis translate_on
                     end else if (sram_ready) begin
                         temp_low_word <= sram_rdata_16;
                         sram_valid <= 1'b0;  // Clear valid immediately when ready seen
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] READ_LOW complete: data=0x%04x", sram_rdata_16);
+                        if (VERBOSE) $display("[SRAM_PROC] READ_LOW complete: data=0x%04x", sram_rdata_16);
                         // synthesis translate_on
 
                         state <= STATE_READ_WAIT1;
@@ -217,8 +219,8 @@ module sram_proc_new (
                     sram_we <= 1'b0;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] READ_SETUP_HIGH: word_addr=0x%05x",
-                             current_addr[18:1] + 18'd1);
+                    if (VERBOSE) $display("[SRAM_PROC] READ_SETUP_HIGH: word_addr=0x%05x",
+                                          current_addr[18:1] + 18'd1);
                     // synthesis translate_on
 
                     state <= STATE_READ_HIGH;
@@ -230,7 +232,7 @@ module sram_proc_new (
                         sram_valid <= 1'b1;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] READ_HIGH: Starting high word read");
+                        if (VERBOSE) $display("[SRAM_PROC] READ_HIGH: Starting high word read");
                         // synthesis translate_on
                     end else if (sram_ready) begin
                         read_word[31:16] <= sram_rdata_16;
@@ -238,7 +240,7 @@ module sram_proc_new (
                         sram_valid <= 1'b0;  // Clear valid immediately when ready seen
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] READ_HIGH complete: data=0x%04x", sram_rdata_16);
+                        if (VERBOSE) $display("[SRAM_PROC] READ_HIGH complete: data=0x%04x", sram_rdata_16);
                         // synthesis translate_on
 
                         state <= STATE_READ_WAIT2;
@@ -257,7 +259,7 @@ module sram_proc_new (
                     result <= read_word;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] COMPLETE: result=0x%08x", read_word);
+                    if (VERBOSE) $display("[SRAM_PROC] COMPLETE: result=0x%08x", read_word);
                     // synthesis translate_on
 
                     state <= STATE_DONE;
@@ -274,8 +276,8 @@ module sram_proc_new (
                         sram_valid <= 1'b1;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] WRITE_LOW: byte_addr=0x%08x word_addr=0x%05x data=0x%04x",
-                                 current_addr, current_addr[18:1], current_data[15:0]);
+                        if (VERBOSE) $display("[SRAM_PROC] WRITE_LOW: byte_addr=0x%08x word_addr=0x%05x data=0x%04x",
+                                              current_addr, current_addr[18:1], current_data[15:0]);
                         // synthesis translate_on
                     end else if (sram_ready) begin
                         sram_valid <= 1'b0;  // Clear valid immediately when ready seen
@@ -303,8 +305,8 @@ module sram_proc_new (
                         sram_valid <= 1'b1;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] WRITE_HIGH: word_addr=0x%05x data=0x%04x",
-                                 {1'b0, current_addr[18:1]} + 19'd1, current_data[31:16]);
+                        if (VERBOSE) $display("[SRAM_PROC] WRITE_HIGH: word_addr=0x%05x data=0x%04x",
+                                              {1'b0, current_addr[18:1]} + 19'd1, current_data[31:16]);
                         // synthesis translate_on
                     end else if (sram_ready) begin
                         result <= 32'h00000000;
@@ -328,7 +330,7 @@ module sram_proc_new (
                         sram_valid <= 1'b1;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] RMW_READ_LOW: word_addr=0x%05x", current_addr[18:1]);
+                        if (VERBOSE) $display("[SRAM_PROC] RMW_READ_LOW: word_addr=0x%05x", current_addr[18:1]);
                         // synthesis translate_on
                     end else if (sram_ready) begin
                         old_data[15:0] <= sram_rdata_16;
@@ -350,7 +352,7 @@ module sram_proc_new (
                         sram_valid <= 1'b1;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] RMW_READ_HIGH: word_addr=0x%05x", current_addr[18:1] + 18'd1);
+                        if (VERBOSE) $display("[SRAM_PROC] RMW_READ_HIGH: word_addr=0x%05x", current_addr[18:1] + 18'd1);
                         // synthesis translate_on
                     end else if (sram_ready) begin
                         old_data[31:16] <= sram_rdata_16;
@@ -376,8 +378,8 @@ module sram_proc_new (
                     current_data[31:24] <= current_wstrb[3] ? current_data[31:24] : old_data[31:24];
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] RMW_MERGE: old=0x%08x new=0x%08x wstrb=0x%01x",
-                             old_data, current_data, current_wstrb);
+                    if (VERBOSE) $display("[SRAM_PROC] RMW_MERGE: old=0x%08x new=0x%08x wstrb=0x%01x",
+                                          old_data, current_data, current_wstrb);
                     // synthesis translate_on
 
                     // Now proceed with normal write sequence
@@ -445,7 +447,7 @@ module sram_proc_new (
                     sram_we <= 1'b0;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] DONE: result=0x%08x", result);
+                    if (VERBOSE) $display("[SRAM_PROC] DONE: result=0x%08x", result);
                     // synthesis translate_on
 
                     state <= STATE_IDLE;
@@ -24,7 +24,9 @@
 // = 140ns @ 50MHz instead of 220ns
 //==============================================================================
 
-module sram_proc_optimized (
+module sram_proc_optimized #(
+    parameter VERBOSE = 0          // 1 = per-access $display trace (simulation)
+) (
     input wire clk,
     input wire resetn,
 
@@ -159,8 +161,8 @@ module sram_proc_optimized (
                         current_wstrb <= mem_wstrb;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] START: cmd=0x%02x addr=0x%08x data=0x%08x wstrb=0x%01x",
-                                 cmd, addr_in, data_in, mem_wstrb);
+                        if (VERBOSE) $display("[SRAM_PROC] START: cmd=0x%02x addr=0x%08x data=0x%08x wstrb=0x%01x",
+                                              cmd, addr_in, data_in, mem_wstrb);
                         // synthesis translate_on
 
                         case (cmd)
@@ -195,8 +197,8 @@ module sram_proc_optimized (
                     sram_valid <= 1'b1;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] READ_LOW: byte_addr=0x%08x word_addr=0x%05x",
-                             current_addr, current_addr[18:1]);
+                    if (VERBOSE) $display("[SRAM_PROC] READ_LOW: byte_addr=0x%08x word_addr=0x%05x",
+                                          current_addr, current_addr[18:1]);
                     // synthesis translate_on
 
                     if (sram_ready) begin
@@ -204,7 +206,7 @@ module sram_proc_optimized (
                         temp_low_word <= sram_rdata_16;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] READ_LOW complete: data=0x%04x", sram_rdata_16);
+                        if (VERBOSE) $display("[SRAM_PROC] READ_LOW complete: data=0x%04x", sram_rdata_16);
                         // synthesis translate_on
 
                         state <= STATE_WAIT;
@@ -223,8 +225,8 @@ module sram_proc_optimized (
                         state <= STATE_WRITE_HIGH;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] WAIT: Setup WRITE high word_addr=0x%05x data=0x%04x",
-                                 current_addr[18:1] + 18'd1, current_data[31:16]);
+                        if (VERBOSE) $display("[SRAM_PROC] WAIT: Setup WRITE high word_addr=0x%05x data=0x%04x",
+                                              current_addr[18:1] + 18'd1, current_data[31:16]);
                         // synthesis translate_on
                     end else begin
                         // Setup for read high
@@ -232,8 +234,8 @@ module sram_proc_optimized (
                         state <= STATE_READ_HIGH;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] WAIT: Setup READ high word_addr=0x%05x",
-                                 current_addr[18:1] + 18'd1);
+                        if (VERBOSE) $display("[SRAM_PROC] WAIT: Setup READ high word_addr=0x%05x",
+                                              current_addr[18:1] + 18'd1);
                         // synthesis translate_on
                     end
                 end
@@ -243,7 +245,7 @@ module sram_proc_optimized (
                     sram_valid <= 1'b1;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] READ_HIGH: Starting high word read");
+                    if (VERBOSE) $display("[SRAM_PROC] READ_HIGH: Starting high word read");
                     // synthesis translate_on
 
                     if (sram_ready) begin
@@ -253,7 +255,7 @@ module sram_proc_optimized (
                         sram_valid <= 1'b0;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] READ_HIGH complete: data=0x%04x", sram_rdata_16);
+                        if (VERBOSE) $display("[SRAM_PROC] READ_HIGH complete: data=0x%04x", sram_rdata_16);
                         // synthesis translate_on
 
                         state <= STATE_COMPLETE;
@@ -269,7 +271,7 @@ module sram_proc_optimized (
                     busy <= 1'b0;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] COMPLETE: result=0x%08x (done)", read_word);
+                    if (VERBOSE) $display("[SRAM_PROC] COMPLETE: result=0x%08x (done)", read_word);
                     // synthesis translate_on
 
                     state <= STATE_IDLE;
@@ -285,14 +287,14 @@ module sram_proc_optimized (
                     sram_valid <= 1'b1;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] WRITE_LOW: byte_addr=0x%08x word_addr=0x%05x data=0x%04x",
-                             current_addr, current_addr[18:1], current_data[15:0]);
+                    if (VERBOSE) $display("[SRAM_PROC] WRITE_LOW: byte_addr=0x%08x word_addr=0x%05x data=0x%04x",
+                                          current_addr, current_addr[18:1], current_data[15:0]);
                     // synthesis translate_on
 
                     if (sram_ready) begin
                         // Cycle 2: Driver completed write
                         // synthesis translate_off
-                        $display("[SRAM_PROC] WRITE_LOW complete");
+                        if (VERBOSE) $display("[SRAM_PROC] WRITE_LOW complete");
                         // synthesis translate_on
 
                         state <= STATE_WAIT;
@@ -305,8 +307,8 @@ module sram_proc_optimized (
                     sram_valid <= 1'b1;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] WRITE_HIGH: word_addr=0x%05x data=0x%04x",
-                             current_addr[18:1] + 18'd1, current_data[31:16]);
+                    if (VERBOSE) $display("[SRAM_PROC] WRITE_HIGH: word_addr=0x%05x data=0x%04x",
+                                          current_addr[18:1] + 18'd1, current_data[31:16]);
                     // synthesis translate_on
 
                     if (sram_ready) begin
@@ -318,7 +320,7 @@ module sram_proc_optimized (
                         busy <= 1'b0;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] WRITE_HIGH complete (done)");
+                        if (VERBOSE) $display("[SRAM_PROC] WRITE_HIGH complete (done)");
                         // synthesis translate_on
 
                         state <= STATE_IDLE;
@@ -333,7 +335,7 @@ module sram_proc_optimized (
                     sram_valid <= 1'b1;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] RMW_READ_LOW: word_addr=0x%05x", current_addr[18:1]);
+                    if (VERBOSE) $display("[SRAM_PROC] RMW_READ_LOW: word_addr=0x%05x", current_addr[18:1]);
                     // synthesis translate_on
 
                     if (sram_ready) begin
@@ -345,7 +347,7 @@ module sram_proc_optimized (
                         state <= STATE_WRITE_RMW_READ_HIGH;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] RMW_READ_LOW complete: data=0x%04x", sram_rdata_16);
+                        if (VERBOSE) $display("[SRAM_PROC] RMW_READ_LOW complete: data=0x%04x", sram_rdata_16);
                         // synthesis translate_on
                     end
                 end
@@ -355,7 +357,7 @@ module sram_proc_optimized (
                     sram_valid <= 1'b1;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] RMW_READ_HIGH: word_addr=0x%05x", current_addr[18:1] + 18'd1);
+                    if (VERBOSE) $display("[SRAM_PROC] RMW_READ_HIGH: word_addr=0x%05x", current_addr[18:1] + 18'd1);
                     // synthesis translate_on
 
                     if (sram_ready) begin
@@ -364,7 +366,7 @@ module sram_proc_optimized (
                         state <= STATE_WRITE_RMW_MERGE;
 
                         // synthesis translate_off
-                        $display("[SRAM_PROC] RMW_READ_HIGH complete: data=0x%04x", sram_rdata_16);
+                        if (VERBOSE) $display("[SRAM_PROC] RMW_READ_HIGH complete: data=0x%04x", sram_rdata_16);
                         // synthesis translate_on
                     end
                 end
@@ -381,8 +383,8 @@ module sram_proc_optimized (
                     current_data[31:24] <= current_wstrb[3] ? current_data[31:24] : old_data[31:24];
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] RMW_MERGE: old=0x%08x new=0x%08x wstrb=0x%01x",
-                             old_data, current_data, current_wstrb);
+                    if (VERBOSE) $display("[SRAM_PROC] RMW_MERGE: old=0x%08x new=0x%08x wstrb=0x%01x",
+                                          old_data, current_data, current_wstrb);
                     // synthesis translate_on
 
                     // Now proceed with normal write sequence
@@ -451,7 +453,7 @@ module sram_proc_optimized (
                     sram_we <= 1'b0;
 
                     // synthesis translate_off
-                    $display("[SRAM_PROC] DONE: result=0x%08x", result);
+                    if (VERBOSE) $display("[SRAM_PROC] DONE: result=0x%08x", result);
                     // synthesis translate_on
 
                     state <= STATE_IDLE;
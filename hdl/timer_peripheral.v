@@ -9,7 +9,9 @@
 // Educational and research purposes only
 //==============================================================================
 
-module timer_peripheral (
+module timer_peripheral #(
+    parameter VERBOSE = 0          // 1 = per-access $display trace (simulation)
+) (
     input wire clk,              // System clock (50 MHz)
     input wire resetn,
 
@@ -122,12 +124,12 @@ module timer_peripheral (
             end
 
             if (cr_enable && (debug_cycle_count == 1000 || debug_cycle_count == 10000 || debug_cycle_count == 100000)) begin
-                $display("[TIMER_PERIPH] After %0d cycles: psc_counter=%0d cnt_value=%0d | MMIO: %0d cycles (%.1f%%) | Counting: %0d cycles (%.1f%%)",
-                         debug_cycle_count, psc_counter, cnt_value,
-                         debug_mmio_cycles, (debug_mmio_cycles * 100.0) / debug_cycle_count,
-                         debug_count_cycles, (debug_count_cycles * 100.0) / debug_cycle_count);
-                $display("[TIMER_PERIPH]   PSC ticks: %0d (expected: ~%0d) | Counter decrements: %0d (expected: ~%0d)",
-                         debug_psc_ticks, debug_count_cycles / 10, debug_decrements, debug_psc_ticks);
+                if (VERBOSE) $display("[TIMER_PERIPH] After %0d cycles: psc_counter=%0d cnt_value=%0d | MMIO: %0d cycles (%.1f%%) | Counting: %0d cycles (%.1f%%)",
+                                      debug_cycle_count, psc_counter, cnt_value,
+                                      debug_mmio_cycles, (debug_mmio_cycles * 100.0) / debug_cycle_count,
+                                      debug_count_cycles, (debug_count_cycles * 100.0) / debug_cycle_count);
+                if (VERBOSE) $display("[TIMER_PERIPH]   PSC ticks: %0d (expected: ~%0d) | Counter decrements: %0d (expected: ~%0d)",
+                                      debug_psc_ticks, debug_count_cycles / 10, debug_decrements, debug_psc_ticks);
             end
             // synthesis translate_on
             // Default: Clear IRQ pulse (single-cycle pulse)
@@ -144,9 +146,9 @@ module timer_peripheral (
                         irq_pulse <= 1'b1;
                         sr_uif <= 1'b1;
                         // synthesis translate_off
-                        $display("[%0t] [TIMER_PERIPH] Counter reached 0 - generating IRQ pulse", $time);
-                        $display("[%0t] [TIMER_PERIPH]   cr_enable=%b cr_one_shot=%b arr_value=%0d",
-                                 $time, cr_enable, cr_one_shot, arr_value);
+                        if (VERBOSE) $display("[%0t] [TIMER_PERIPH] Counter reached 0 - generating IRQ pulse", $time);
+                        if (VERBOSE) $display("[%0t] [TIMER_PERIPH]   cr_enable=%b cr_one_shot=%b arr_value=%0d",
+                                              $time, cr_enable, cr_one_shot, arr_value);
                         // synthesis translate_on
 
                         if (cr_one_shot) begin
@@ -157,8 +159,8 @@ module timer_peripheral (
                             // Continuous mode: Auto-reload and continue
                             cnt_value <= arr_value;
                             // synthesis translate_off
-                            $display("[%0t] [TIMER_PERIPH]   Reloading: cnt_value <= %0d (continuous mode)",
-                                     $time, arr_value);
+                            if (VERBOSE) $display("[%0t] [TIMER_PERIPH]   Reloading: cnt_value <= %0d (continuous mode)",
+                                                  $time, arr_value);
                             // synthesis translate_on
                         end
                     end else begin
@@ -174,7 +176,7 @@ module timer_peripheral (
             // MMIO handling - can override timer updates if needed (e.g., during enable)
             if (mmio_valid && mmio_write) begin
                 // synthesis translate_off
-                $display("[TIMER] WRITE: addr=0x%08x data=0x%08x", mmio_addr, mmio_wdata);
+                if (VERBOSE) $display("[TIMER] WRITE: addr=0x%08x data=0x%08x", mmio_addr, mmio_wdata);
                 // synthesis translate_on
 
                 case (mmio_addr[4:0])
@@ -187,8 +189,8 @@ module timer_peripheral (
                                 cnt_value <= arr_value;
                                 psc_counter <= psc_value;
                                 // synthesis translate_off
-                                $display("[TIMER_PERIPH] Timer enabled: cnt=%0d psc_counter=%0d arr=%0d psc_value=%0d",
-                                         arr_value, psc_value, arr_value, psc_value);
+                                if (VERBOSE) $display("[TIMER_PERIPH] Timer enabled: cnt=%0d psc_counter=%0d arr=%0d psc_value=%0d",
+                                                      arr_value, psc_value, arr_value, psc_value);
                                 // synthesis translate_on
                             end
                         end
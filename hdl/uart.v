@@ -15,7 +15,12 @@ module uart #(
     parameter OS_RATE = 16,            // oversampling rate to find center of receive bits
     parameter D_WIDTH = 8,             // data bus width
     parameter PARITY = 0,              // 0 for no parity, 1 for parity
-    parameter PARITY_EO = 1'b0         // 1'b0 for even, 1'b1 for odd parity
+    parameter PARITY_EO = 1'b0,        // 1'b0 for even, 1'b1 for odd parity
+    parameter LEVEL_BITS = 9,          // width of rx_level
+    parameter RX_STOP_LEVEL = 192,     // deassert RTS# at this RX FIFO level...
+    parameter RX_GO_LEVEL = 128,       // ...and reassert it at or below this one
+    parameter CTS_ENABLE = 0,          // 1 = hold TX while CTS# is high
+    parameter VERBOSE = 0              // 1 = per-byte $display trace (simulation)
 ) (
     input wire clk,                           // system clock
     input wire reset_n,                       // asynchronous reset
@@ -27,15 +32,21 @@ module uart #(
     output reg [D_WIDTH-1:0] rx_data,         // data received
     output reg rx_data_valid,                 // pulse when new byte received
     output reg tx_busy,                       // transmission in progress
-    output reg tx                             // transmit pin
+    output reg tx,                            // transmit pin
+
+    // Hardware flow control (active-low, RS-232 sense)
+    input wire [LEVEL_BITS-1:0] rx_level,     // RX FIFO fill level
+    output reg rts_n,                         // 0 = peer may send
+    input wire cts_n                          // 0 = peer ready to receive
 );
 
     // State machine types
-    localparam TX_IDLE = 1'b0, TX_TRANSMIT = 1'b1;
+    localparam TX_IDLE = 2'd0, TX_TRANSMIT = 2'd1, TX_HOLD = 2'd2;
     localparam RX_IDLE = 1'b0, RX_RECEIVE = 1'b1;
     
     // State machine registers
-    reg tx_state, rx_state;
+    reg [1:0] tx_state;
+    reg rx_state;
     
     // Clock enable pulses
     reg baud_pulse;
@@ -86,6 +97,31 @@ module uart #(
         end
     end
     
+    // RTS#: stop the peer when the RX FIFO reaches RX_STOP_LEVEL, let it
+    // resume once the reader has drained it to RX_GO_LEVEL. The gap leaves
+    // room for the bytes a USB-serial bridge sends after RTS# rises.
+    always @(posedge clk or negedge reset_n) begin
+        if (!reset_n) begin
+            rts_n <= 1'b1;
+        end else begin
+            if (rx_level >= RX_STOP_LEVEL)
+                rts_n <= 1'b1;
+            else if (rx_level <= RX_GO_LEVEL)
+                rts_n <= 1'b0;
+        end
+    end
+
+    // CTS# synchronizer (asynchronous pin)
+    reg [1:0] cts_sync;
+    always @(posedge clk or negedge reset_n) begin
+        if (!reset_n)
+            cts_sync <= 2'b11;
+        else
+            cts_sync <= {cts_sync[0], cts_n};
+    end
+
+    wire tx_clear = (CTS_ENABLE == 0) || !cts_sync[1];
+
     // Receive state machine
     always @(posedge clk or negedge reset_n) begin
         if (!reset_n) begin
@@ -180,15 +216,22 @@ module uart #(
                         end
                         tx_busy <= 1'b1;
                         tx_count <= 0;
-                        tx_state <= TX_TRANSMIT;
+                        // Wait for CTS# before the start bit
+                        tx_state <= tx_clear ? TX_TRANSMIT : TX_HOLD;
                         // synthesis translate_off
-                        $display("[UART] TX starting: data=0x%02x, tx_busy=1", tx_data);
+                        if (VERBOSE) $display("[UART] TX starting: data=0x%02x, tx_busy=1", tx_data);
                         // synthesis translate_on
                     end else begin
                         tx_busy <= 1'b0;
                         tx_state <= TX_IDLE;
                     end
                 end
+
+                TX_HOLD: begin
+                    // Byte latched, line idle (tx_buffer[0] is the stop bit)
+                    if (tx_clear)
+                        tx_state <= TX_TRANSMIT;
+                end
                 
                 TX_TRANSMIT: begin
                     if (baud_pulse) begin
@@ -201,10 +244,12 @@ module uart #(
                         tx_state <= TX_IDLE;
                         tx_busy <= 1'b0;  // Clear busy flag when transmission completes
                         // synthesis translate_off
-                        $display("[UART] TX complete, returning to IDLE");
+                        if (VERBOSE) $display("[UART] TX complete, returning to IDLE");
                         // synthesis translate_on
                     end
                 end
+
+                default: tx_state <= TX_IDLE;
             endcase
             tx <= tx_buffer[0];
         end
@@ -0,0 +1,143 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// bench.c - Benchmark Port Layer (cycle timing + result reporting)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "bench.h"
+
+#include <stdio.h>
+
+#include "../hal/hal.h"
+
+static uint32_t bench_wraps;
+static uint32_t bench_bytes_override;
+
+int bench_quiet;
+
+void bench_timer_init(void) {
+    timer_init();
+    timer_config(0, 0xFFFFFFFFu);
+    bench_wraps = 0;
+    timer_start();                  // Loads CNT = ARR
+}
+
+uint64_t bench_cycles(void) {
+    uint32_t cnt = timer_read_counter();
+
+    // A wrap between the two reads is picked up by re-reading CNT; one after
+    // the SR read is seen on the next call
+    if (timer_irq_pending()) {
+        timer_clear_irq();
+        bench_wraps++;
+        cnt = timer_read_counter();
+    }
+    return ((uint64_t)bench_wraps << 32) | (uint32_t)(0xFFFFFFFFu - cnt);
+}
+
+// newlib-nano printf has no %llu
+static const char *u64_str(char *buf, uint64_t v) {
+    char *p = buf + 20;
+    *p = '\0';
+    do {
+        *--p = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    return p;
+}
+
+void bench_report(const char *name, const char *work_name, uint32_t work,
+                  uint64_t cycles, uint32_t divisor, const char *unit, int valid) {
+    char cbuf[21];
+    uint64_t den = cycles * divisor;
+    uint32_t milli = den ? (uint32_t)(((uint64_t)work * 1000000000ull + den / 2) / den) : 0;
+
+    printf("\r\n%s: %lu %s in %s cycles\r\n", name, (unsigned long)work, work_name,
+           u64_str(cbuf, cycles));
+    printf("%s: %lu.%03lu%s\r\n", unit, (unsigned long)(milli / 1000),
+           (unsigned long)(milli % 1000), valid ? "" : " (INVALID RUN)");
+    printf("@@BENCH name=%s %s=%lu cycles=%s per_mhz=%lu.%03lu unit=%s valid=%d\r\n",
+           name, work_name, (unsigned long)work, u64_str(cbuf, cycles),
+           (unsigned long)(milli / 1000), (unsigned long)(milli % 1000), unit, valid);
+}
+
+void bench_done(void) {
+    printf("@@BENCH END\r\n");
+    fflush(stdout);
+}
+
+void bench_set_bytes(uint32_t bytes) {
+    bench_bytes_override = bytes;
+}
+
+// value / div with three decimals
+static const char *milli_str(char *buf, size_t len, uint64_t value, uint64_t div) {
+    char ibuf[21];
+    uint64_t m = div ? (value * 1000 + div / 2) / div : 0;
+
+    snprintf(buf, len, "%s.%03lu", u64_str(ibuf, m / 1000), (unsigned long)(m % 1000));
+    return buf;
+}
+
+static void bench_result(const char *suite, const bench_case_t *c, uint32_t reps,
+                         uint32_t bytes, uint64_t cmin, uint64_t ctotal, int pass) {
+    char mbuf[21], abuf[21], bbuf[21], cpi[32];
+    uint64_t bps = cmin ? ((uint64_t)bytes * BENCH_CPU_HZ + cmin / 2) / cmin : 0;
+    const char *min_s = u64_str(mbuf, cmin);
+    const char *avg_s = u64_str(abuf, reps ? ctotal / reps : 0);
+    const char *bps_s = u64_str(bbuf, bps);
+
+    milli_str(cpi, sizeof(cpi), cmin, c->iterations);
+
+    printf("@@CSV %s,%s,%lu,%lu,%lu,%s,%s,%s,%s,%d\r\n", suite, c->name,
+           (unsigned long)reps, (unsigned long)c->iterations, (unsigned long)bytes,
+           min_s, avg_s, cpi, bps_s, pass);
+    printf("@@JSON {\"suite\":\"%s\",\"test\":\"%s\",\"reps\":%lu,\"iterations\":%lu,"
+           "\"bytes\":%lu,\"cycles_min\":%s,\"cycles_avg\":%s,\"cycles_per_iter\":%s,"
+           "\"bytes_per_sec\":%s,\"pass\":%d}\r\n", suite, c->name,
+           (unsigned long)reps, (unsigned long)c->iterations, (unsigned long)bytes,
+           min_s, avg_s, cpi, bps_s, pass);
+}
+
+int bench_run_cases(const char *suite, const bench_case_t *cases, int count, uint32_t reps) {
+    int failed = 0;
+
+    if (reps == 0) reps = 1;
+    printf("\r\n=== %s: %d tests x %lu repetitions ===\r\n", suite, count, (unsigned long)reps);
+    printf("@@CSV suite,test,reps,iterations,bytes,cycles_min,cycles_avg,"
+           "cycles_per_iter,bytes_per_sec,pass\r\n");
+    fflush(stdout);
+
+    bench_timer_init();
+    for (int i = 0; i < count; i++) {
+        const bench_case_t *c = &cases[i];
+        uint64_t cmin = ~0ull, ctotal = 0;
+        uint32_t bytes = c->bytes;
+        int pass = 1;
+
+        for (uint32_t r = 0; r < reps; r++) {
+            bench_bytes_override = 0;
+            bench_quiet = 1;
+            uint64_t t0 = bench_cycles();
+            int ok = c->run();
+            uint64_t dt = bench_cycles() - t0;
+            bench_quiet = 0;
+
+            if (!ok) pass = 0;
+            if (bench_bytes_override) bytes = bench_bytes_override;
+            if (dt < cmin) cmin = dt;
+            ctotal += dt;
+        }
+        if (!pass) failed++;
+        bench_result(suite, c, reps, bytes, cmin, ctotal, pass);
+        fflush(stdout);
+    }
+
+    printf("%s: %d/%d passed\r\n", suite, count - failed, count);
+    return failed;
+}
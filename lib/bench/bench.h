@@ -0,0 +1,82 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// bench.h - Benchmark Port Layer (cycle timing + result reporting)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Shared by the CoreMark and Dhrystone ports in lib/bench and the batch mode
+// of algo_test, math_test and heap_test. PicoRV32 is built with
+// ENABLE_COUNTERS=0 (no rdcycle), so cycles are counted by the timer
+// peripheral with PSC=0: CNT counts down from ARR=0xFFFFFFFF once per CPU
+// clock and the UIF wrap flag extends it to 64 bits. At least one
+// bench_cycles() call per 2^32 cycles (~86 s at 50 MHz) is required.
+//
+// Results are printed twice: a human readable line and a machine readable
+// one for tools/bench/run_bench.sh and rvsim/Verilator log scraping:
+//
+//   @@BENCH name=coremark iterations=200 cycles=612345678 per_mhz=0.326 unit=CoreMark/MHz valid=1
+//
+// The timer peripheral is taken over while a benchmark runs; its IRQ stays
+// masked (nothing here touches the PicoRV32 IRQ mask).
+//
+//==============================================================================
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+#define BENCH_CPU_HZ    50000000u       // System clock (EXTCLK / 2)
+
+// Start the free-running cycle counter (restarts it if already running)
+void bench_timer_init(void);
+
+// CPU cycles since bench_timer_init()
+uint64_t bench_cycles(void);
+
+// Print a result. 'work' units (iterations, runs) took 'cycles'; the
+// per-MHz score is work * 1e6 / (cycles * divisor), printed with three
+// decimals (divisor 1 for CoreMark, 1757 for Dhrystone -> DMIPS).
+void bench_report(const char *name, const char *work_name, uint32_t work,
+                  uint64_t cycles, uint32_t divisor, const char *unit, int valid);
+
+// Printed after the last result of a firmware image
+void bench_done(void);
+
+//==============================================================================
+// Batch runner (algo_test / math_test / heap_test 'b' menu option)
+//
+// Runs each case 'reps' times with silenced output and prints one CSV and
+// one JSON line per case (tools/bench/bench_compare.py reads either):
+//
+//   @@CSV suite,test,reps,iterations,bytes,cycles_min,cycles_avg,cycles_per_iter,bytes_per_sec,pass
+//   @@CSV algo,crc32,3,102400,102400,4815162,4815170,47.023,1063303,1
+//   @@JSON {"suite":"algo","test":"crc32","reps":3,...,"pass":1}
+//
+// cycles_min is the figure to compare run-to-run; bytes_per_sec assumes
+// BENCH_CPU_HZ and uses cycles_min.
+//==============================================================================
+
+typedef struct {
+    const char *name;
+    int (*run)(void);           // Returns non-zero on PASS
+    uint32_t iterations;        // Work units per run (elements, operations, ...)
+    uint32_t bytes;             // Bytes touched per run (0 = not a memory test)
+} bench_case_t;
+
+// Set while a batch case runs; test code prints only when it is clear
+extern int bench_quiet;
+
+// Overrides bench_case_t.bytes from inside run() when the size is only
+// known at run time (e.g. largest heap block)
+void bench_set_bytes(uint32_t bytes);
+
+// Runs all cases, returns the number that failed
+int bench_run_cases(const char *suite, const bench_case_t *cases, int count, uint32_t reps);
+
+#endif // BENCH_H
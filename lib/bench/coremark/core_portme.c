@@ -0,0 +1,80 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// core_portme.c - CoreMark Port Layer for PicoRV32 (RV32IM, newlib-nano)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "coremark.h"
+#include "core_portme.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 0                    // 0 = calibrate to >= 10 s (slow in simulation)
+#endif
+
+#if VALIDATION_RUN
+volatile ee_s32 seed1_volatile = 0x3415;
+volatile ee_s32 seed2_volatile = 0x3415;
+volatile ee_s32 seed3_volatile = 0x66;
+#endif
+#if PERFORMANCE_RUN
+volatile ee_s32 seed1_volatile = 0x0;
+volatile ee_s32 seed2_volatile = 0x0;
+volatile ee_s32 seed3_volatile = 0x66;
+#endif
+#if PROFILE_RUN
+volatile ee_s32 seed1_volatile = 0x8;
+volatile ee_s32 seed2_volatile = 0x8;
+volatile ee_s32 seed3_volatile = 0x8;
+#endif
+volatile ee_s32 seed4_volatile = ITERATIONS;
+volatile ee_s32 seed5_volatile = 0;
+
+ee_u32 default_num_contexts = 1;
+
+static uint64_t start_time_val, stop_time_val;
+
+void start_time(void) {
+    start_time_val = bench_cycles();
+}
+
+void stop_time(void) {
+    stop_time_val = bench_cycles();
+}
+
+CORE_TICKS get_time(void) {
+    return (CORE_TICKS)(stop_time_val - start_time_val);
+}
+
+secs_ret time_in_secs(CORE_TICKS ticks) {
+    return (secs_ret)ticks / (secs_ret)EE_TICKS_PER_SEC;
+}
+
+void portable_init(core_portable *p, int *argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+
+    if (sizeof(ee_ptr_int) != sizeof(ee_u8 *))
+        ee_printf("ERROR! Please define ee_ptr_int to a type that holds a pointer!\n");
+    if (sizeof(ee_u32) != 4)
+        ee_printf("ERROR! Please define ee_u32 to a 32b unsigned type!\n");
+
+    bench_timer_init();
+    p->portable_id = 1;
+}
+
+// Called last from main(); the iteration count and CRC error count live in
+// the enclosing core_results, which 'p' is a member of.
+void portable_fini(core_portable *p) {
+    core_results *res = (core_results *)((char *)p - offsetof(core_results, port));
+    uint32_t iterations = (uint32_t)(res->iterations * default_num_contexts);
+
+    bench_report("coremark", "iterations", iterations, stop_time_val - start_time_val,
+                 1, "CoreMark/MHz", res->err == 0);
+    bench_done();
+    p->portable_id = 0;
+}
@@ -0,0 +1,98 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// core_portme.h - CoreMark Port Layer for PicoRV32 (RV32IM, newlib-nano)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// The CoreMark sources themselves (core_main.c, core_list_join.c, ...) are
+// not vendored: 'make coremark-fetch' clones the EEMBC repository into
+// lib/bench/coremark/upstream and firmware/Makefile builds them against this
+// port (TARGET=coremark). Timing is CPU cycles from lib/bench, so
+// EE_TICKS_PER_SEC is the core clock and the score comes out per MHz
+// directly.
+//
+//==============================================================================
+
+#ifndef CORE_PORTME_H
+#define CORE_PORTME_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "bench.h"
+
+// Build configuration
+#define HAS_FLOAT       0               // No FPU; keep soft-float out of timing
+#define HAS_TIME_H      0
+#define USE_CLOCK       0
+#define HAS_STDIO       1
+#define HAS_PRINTF      1               // ee_printf -> newlib printf
+
+#ifndef COMPILER_VERSION
+#ifdef __GNUC__
+#define COMPILER_VERSION "GCC"__VERSION__
+#else
+#define COMPILER_VERSION "unknown"
+#endif
+#endif
+#ifndef COMPILER_FLAGS
+#define COMPILER_FLAGS FLAGS_STR        // Set by firmware/Makefile
+#endif
+#ifndef MEM_LOCATION
+#define MEM_LOCATION "STATIC (SRAM .bss)"
+#endif
+
+// Data types (ILP32)
+typedef signed short    ee_s16;
+typedef unsigned short  ee_u16;
+typedef signed int      ee_s32;
+typedef double          ee_f32;
+typedef unsigned char   ee_u8;
+typedef unsigned int    ee_u32;
+typedef ee_u32          ee_ptr_int;
+typedef size_t          ee_size_t;
+
+#define align_mem(x) (void *)(4 + (((ee_ptr_int)(x) - 1) & ~3))
+
+// Timing: CPU cycles (wraps after ~86 s at 50 MHz, far beyond a sim run)
+#define CORETIMETYPE    ee_u32
+typedef ee_u32 CORE_TICKS;
+#define EE_TICKS_PER_SEC BENCH_CPU_HZ
+
+// Seeds come from volatiles so the compiler cannot fold the workload
+#define SEED_METHOD     SEED_VOLATILE
+#define MEM_METHOD      MEM_STATIC
+
+// Single core, main(void), main returns
+#define MULTITHREAD         1
+#define USE_PTHREAD         0
+#define USE_FORK            0
+#define USE_SOCKET          0
+#define MAIN_HAS_NOARGC     1
+#define MAIN_HAS_NORETURN   0
+
+extern ee_u32 default_num_contexts;
+
+typedef struct CORE_PORTABLE_S {
+    ee_u8 portable_id;
+} core_portable;
+
+void portable_init(core_portable *p, int *argc, char *argv[]);
+void portable_fini(core_portable *p);
+
+#if !defined(PROFILE_RUN) && !defined(PERFORMANCE_RUN) && !defined(VALIDATION_RUN)
+#if (TOTAL_DATA_SIZE == 1200)
+#define PROFILE_RUN 1
+#elif (TOTAL_DATA_SIZE == 2000)
+#define PERFORMANCE_RUN 1
+#else
+#define VALIDATION_RUN 1
+#endif
+#endif
+
+#endif // CORE_PORTME_H
@@ -0,0 +1,96 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// dhry.h - Dhrystone 2.1 Global Declarations
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Dhrystone Benchmark, Version 2.1 (C), Reinhold P. Weicker, 1988.
+// The benchmark code is unchanged apart from ANSI prototypes; only the
+// timing and output (lib/bench/bench.h) are ported.
+//
+// Rules that keep the result comparable with published DMIPS figures:
+//   - dhry_1.c and dhry_2.c are compiled separately (no cross-file inlining)
+//   - no -flto; strcpy/strcmp stay library calls (firmware uses -fno-builtin)
+//   - DMIPS = Dhrystones per second / 1757 (VAX 11/780 score)
+//
+//==============================================================================
+
+#ifndef DHRY_H
+#define DHRY_H
+
+#include <string.h>
+#include <stdlib.h>
+
+// Number of passes through the main loop (no scanf on this target)
+#ifndef DHRY_RUNS
+#define DHRY_RUNS       50000
+#endif
+
+#define Null            0
+#define true            1
+#define false           0
+
+#define structassign(d, s)      d = s
+
+typedef enum { Ident_1, Ident_2, Ident_3, Ident_4, Ident_5 } Enumeration;
+
+typedef int     One_Thirty;
+typedef int     One_Fifty;
+typedef char    Capital_Letter;
+typedef int     Boolean;
+typedef char    Str_30[31];
+typedef int     Arr_1_Dim[50];
+typedef int     Arr_2_Dim[50][50];
+
+typedef struct record {
+    struct record *Ptr_Comp;
+    Enumeration    Discr;
+    union {
+        struct {
+            Enumeration Enum_Comp;
+            int         Int_Comp;
+            char        Str_Comp[31];
+        } var_1;
+        struct {
+            Enumeration E_Comp_2;
+            char        Str_2_Comp[31];
+        } var_2;
+        struct {
+            char        Ch_1_Comp;
+            char        Ch_2_Comp;
+        } var_3;
+    } variant;
+} Rec_Type, *Rec_Pointer;
+
+// Globals (defined in dhry_1.c)
+extern Rec_Pointer  Ptr_Glob;
+extern Rec_Pointer  Next_Ptr_Glob;
+extern int          Int_Glob;
+extern Boolean      Bool_Glob;
+extern char         Ch_1_Glob;
+extern char         Ch_2_Glob;
+extern int          Arr_1_Glob[50];
+extern int          Arr_2_Glob[50][50];
+
+// dhry_1.c
+void Proc_1(Rec_Pointer Ptr_Val_Par);
+void Proc_2(One_Fifty *Int_Par_Ref);
+void Proc_3(Rec_Pointer *Ptr_Ref_Par);
+void Proc_4(void);
+void Proc_5(void);
+
+// dhry_2.c
+void Proc_6(Enumeration Enum_Val_Par, Enumeration *Enum_Ref_Par);
+void Proc_7(One_Fifty Int_1_Par_Val, One_Fifty Int_2_Par_Val, One_Fifty *Int_Par_Ref);
+void Proc_8(Arr_1_Dim Arr_1_Par_Ref, Arr_2_Dim Arr_2_Par_Ref,
+            int Int_1_Par_Val, int Int_2_Par_Val);
+Enumeration Func_1(Capital_Letter Ch_1_Par_Val, Capital_Letter Ch_2_Par_Val);
+Boolean Func_2(Str_30 Str_1_Par_Ref, Str_30 Str_2_Par_Ref);
+Boolean Func_3(Enumeration Enum_Par_Val);
+
+#endif // DHRY_H
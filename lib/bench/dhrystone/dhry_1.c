@@ -0,0 +1,196 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// dhry_1.c - Dhrystone 2.1 Main Program and Proc_1..Proc_5
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Dhrystone Benchmark, Version 2.1 (C), Reinhold P. Weicker, 1988.
+// Build: make -C firmware TARGET=dhrystone USE_NEWLIB=1 [DHRY_RUNS=n]
+//
+//==============================================================================
+
+#include <stdio.h>
+
+#include "dhry.h"
+#include "bench.h"
+
+Rec_Pointer     Ptr_Glob;
+Rec_Pointer     Next_Ptr_Glob;
+int             Int_Glob;
+Boolean         Bool_Glob;
+char            Ch_1_Glob;
+char            Ch_2_Glob;
+int             Arr_1_Glob[50];
+int             Arr_2_Glob[50][50];
+
+static int check_int(const char *what, int got, int want) {
+    printf("  %-26s %d (should be %d)%s\r\n", what, got, want, got == want ? "" : "  <-- WRONG");
+    return got == want;
+}
+
+static int check_str(const char *what, const char *got, const char *want) {
+    int ok = strcmp(got, want) == 0;
+    printf("  %-26s %s%s\r\n", what, got, ok ? "" : "  <-- WRONG");
+    return ok;
+}
+
+int main(void) {
+    One_Fifty       Int_1_Loc;
+    One_Fifty       Int_2_Loc;
+    One_Fifty       Int_3_Loc;
+    char            Ch_Index;
+    Enumeration     Enum_Loc;
+    Str_30          Str_1_Loc;
+    Str_30          Str_2_Loc;
+    int             Run_Index;
+    int             Number_Of_Runs = DHRY_RUNS;
+    uint64_t        Begin_Time, End_Time;
+    int             ok = 1;
+
+    // Initializations
+    Next_Ptr_Glob = (Rec_Pointer)malloc(sizeof(Rec_Type));
+    Ptr_Glob = (Rec_Pointer)malloc(sizeof(Rec_Type));
+
+    Ptr_Glob->Ptr_Comp = Next_Ptr_Glob;
+    Ptr_Glob->Discr = Ident_1;
+    Ptr_Glob->variant.var_1.Enum_Comp = Ident_3;
+    Ptr_Glob->variant.var_1.Int_Comp = 40;
+    strcpy(Ptr_Glob->variant.var_1.Str_Comp, "DHRYSTONE PROGRAM, SOME STRING");
+    strcpy(Str_1_Loc, "DHRYSTONE PROGRAM, 1'ST STRING");
+
+    Arr_2_Glob[8][7] = 10;
+
+    printf("\r\nDhrystone Benchmark, Version 2.1 (Language: C)\r\n");
+    printf("Execution starts, %d runs through Dhrystone\r\n", Number_Of_Runs);
+
+    bench_timer_init();
+    Begin_Time = bench_cycles();
+
+    for (Run_Index = 1; Run_Index <= Number_Of_Runs; ++Run_Index) {
+        Proc_5();
+        Proc_4();
+        // Ch_1_Glob == 'A', Ch_2_Glob == 'B', Bool_Glob == true
+        Int_1_Loc = 2;
+        Int_2_Loc = 3;
+        strcpy(Str_2_Loc, "DHRYSTONE PROGRAM, 2'ND STRING");
+        Enum_Loc = Ident_2;
+        Bool_Glob = !Func_2(Str_1_Loc, Str_2_Loc);
+        // Bool_Glob == 1
+        while (Int_1_Loc < Int_2_Loc) {     // loop body executed once
+            Int_3_Loc = 5 * Int_1_Loc - Int_2_Loc;
+            // Int_3_Loc == 7
+            Proc_7(Int_1_Loc, Int_2_Loc, &Int_3_Loc);
+            // Int_3_Loc == 7
+            Int_1_Loc += 1;
+        }
+        // Int_1_Loc == 3, Int_2_Loc == 3, Int_3_Loc == 7
+        Proc_8(Arr_1_Glob, Arr_2_Glob, Int_1_Loc, Int_3_Loc);
+        // Int_Glob == 5
+        Proc_1(Ptr_Glob);
+        for (Ch_Index = 'A'; Ch_Index <= Ch_2_Glob; ++Ch_Index) {   // loop body executed twice
+            if (Enum_Loc == Func_1(Ch_Index, 'C')) {                // then, not executed
+                Proc_6(Ident_1, &Enum_Loc);
+                strcpy(Str_2_Loc, "DHRYSTONE PROGRAM, 3'RD STRING");
+                Int_2_Loc = Run_Index;
+                Int_Glob = Run_Index;
+            }
+        }
+        // Int_1_Loc == 3, Int_2_Loc == 3, Int_3_Loc == 7
+        Int_2_Loc = Int_2_Loc * Int_1_Loc;
+        Int_1_Loc = Int_2_Loc / Int_3_Loc;
+        Int_2_Loc = 7 * (Int_2_Loc - Int_3_Loc) - Int_1_Loc;
+        // Int_1_Loc == 1, Int_2_Loc == 13, Int_3_Loc == 7
+        Proc_2(&Int_1_Loc);
+        // Int_1_Loc == 5
+    }
+
+    End_Time = bench_cycles();
+
+    printf("Execution ends\r\n\r\nFinal values of the variables used in the benchmark:\r\n");
+    ok &= check_int("Int_Glob:", Int_Glob, 5);
+    ok &= check_int("Bool_Glob:", Bool_Glob, 1);
+    ok &= check_int("Ch_1_Glob:", Ch_1_Glob, 'A');
+    ok &= check_int("Ch_2_Glob:", Ch_2_Glob, 'B');
+    ok &= check_int("Arr_1_Glob[8]:", Arr_1_Glob[8], 7);
+    ok &= check_int("Arr_2_Glob[8][7]:", Arr_2_Glob[8][7], Number_Of_Runs + 10);
+    ok &= check_int("Ptr_Glob->Discr:", Ptr_Glob->Discr, 0);
+    ok &= check_int("  Enum_Comp:", Ptr_Glob->variant.var_1.Enum_Comp, 2);
+    ok &= check_int("  Int_Comp:", Ptr_Glob->variant.var_1.Int_Comp, 17);
+    ok &= check_str("  Str_Comp:", Ptr_Glob->variant.var_1.Str_Comp, "DHRYSTONE PROGRAM, SOME STRING");
+    ok &= check_int("Next_Ptr_Glob->Discr:", Next_Ptr_Glob->Discr, 0);
+    ok &= check_int("  Enum_Comp:", Next_Ptr_Glob->variant.var_1.Enum_Comp, 1);
+    ok &= check_int("  Int_Comp:", Next_Ptr_Glob->variant.var_1.Int_Comp, 18);
+    ok &= check_str("  Str_Comp:", Next_Ptr_Glob->variant.var_1.Str_Comp, "DHRYSTONE PROGRAM, SOME STRING");
+    ok &= check_int("Int_1_Loc:", Int_1_Loc, 5);
+    ok &= check_int("Int_2_Loc:", Int_2_Loc, 13);
+    ok &= check_int("Int_3_Loc:", Int_3_Loc, 7);
+    ok &= check_int("Enum_Loc:", Enum_Loc, 1);
+    ok &= check_str("Str_1_Loc:", Str_1_Loc, "DHRYSTONE PROGRAM, 1'ST STRING");
+    ok &= check_str("Str_2_Loc:", Str_2_Loc, "DHRYSTONE PROGRAM, 2'ND STRING");
+
+    bench_report("dhrystone", "runs", (uint32_t)Number_Of_Runs, End_Time - Begin_Time,
+                 1757, "DMIPS/MHz", ok);
+    bench_done();
+
+    while (1) {
+        __asm__ volatile ("wfi");
+    }
+    return 0;
+}
+
+void Proc_1(Rec_Pointer Ptr_Val_Par) {
+    Rec_Pointer Next_Record = Ptr_Val_Par->Ptr_Comp;    // == Ptr_Glob_Next
+
+    structassign(*Ptr_Val_Par->Ptr_Comp, *Ptr_Glob);
+    Ptr_Val_Par->variant.var_1.Int_Comp = 5;
+    Next_Record->variant.var_1.Int_Comp = Ptr_Val_Par->variant.var_1.Int_Comp;
+    Next_Record->Ptr_Comp = Ptr_Val_Par->Ptr_Comp;
+    Proc_3(&Next_Record->Ptr_Comp);
+    // Ptr_Val_Par->Ptr_Comp->Ptr_Comp == Ptr_Glob->Ptr_Comp
+    if (Next_Record->Discr == Ident_1) {    // then, executed
+        Next_Record->variant.var_1.Int_Comp = 6;
+        Proc_6(Ptr_Val_Par->variant.var_1.Enum_Comp, &Next_Record->variant.var_1.Enum_Comp);
+        Next_Record->Ptr_Comp = Ptr_Glob->Ptr_Comp;
+        Proc_7(Next_Record->variant.var_1.Int_Comp, 10, &Next_Record->variant.var_1.Int_Comp);
+    } else {                                // not executed
+        structassign(*Ptr_Val_Par, *Ptr_Val_Par->Ptr_Comp);
+    }
+}
+
+void Proc_2(One_Fifty *Int_Par_Ref) {
+    One_Fifty   Int_Loc;
+    Enumeration Enum_Loc = Ident_2;         // Original leaves this unset; the loop sets it
+
+    Int_Loc = *Int_Par_Ref + 10;
+    do {                                    // executed once
+        if (Ch_1_Glob == 'A') {             // then, executed
+            Int_Loc -= 1;
+            *Int_Par_Ref = Int_Loc - Int_Glob;
+            Enum_Loc = Ident_1;
+        }
+    } while (Enum_Loc != Ident_1);          // true
+}
+
+void Proc_3(Rec_Pointer *Ptr_Ref_Par) {
+    if (Ptr_Glob != Null)                   // then, executed
+        *Ptr_Ref_Par = Ptr_Glob->Ptr_Comp;
+    Proc_7(10, Int_Glob, &Ptr_Glob->variant.var_1.Int_Comp);
+}
+
+void Proc_4(void) {
+    Boolean Bool_Loc;
+
+    Bool_Loc = Ch_1_Glob == 'A';
+    Bool_Glob = Bool_Loc | Bool_Glob;
+    Ch_2_Glob = 'B';
+}
+
+void Proc_5(void) {
+    Ch_1_Glob = 'A';
+    Bool_Glob = false;
+}
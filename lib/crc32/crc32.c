@@ -0,0 +1,37 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// crc32.c - CRC-32 Byte Backend and Default Dispatch
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "crc32.h"
+
+// PicoRV32: every load costs the same, so the gain of slice16 over slice8
+// does not pay for another 8 KB of tables. A host has the cache for it.
+#if defined(__riscv)
+#define CRC32_DEFAULT   crc32_update_slice8
+#else
+#define CRC32_DEFAULT   crc32_update_slice16
+#endif
+
+uint32_t crc32_update_byte(uint32_t crc, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+
+    while (len--) {
+        crc = crc32_update_u8(crc, *p++);
+    }
+    return crc;
+}
+
+uint32_t crc32_update(uint32_t crc, const void *data, size_t len) {
+    return CRC32_DEFAULT(crc, data, len);
+}
+
+uint32_t crc32(const void *data, size_t len) {
+    return crc32_final(CRC32_DEFAULT(CRC32_INIT, data, len));
+}
@@ -0,0 +1,84 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// crc32.h - CRC-32 (IEEE 802.3 / PKZIP) for Firmware, Bootloader and Host
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// The checksum of the upload protocol (bootloader, lib/simple_upload,
+// tools/uploader/fw_upload) and of hexedit's mark range: reflected
+// polynomial 0xEDB88320, initial value and final XOR 0xFFFFFFFF.
+//
+//   uint32_t crc = crc32_init();
+//   crc = crc32_update(crc, buf, len);      // any number of times
+//   crc = crc32_final(crc);                 // == crc32(whole, total_len)
+//
+// The lookup tables are const data generated by gen_crc32_tables.py, so
+// there is no table setup at boot and no RAM used for them. Backends:
+//
+//   crc32_update_byte     1 KB  one table lookup per byte
+//   crc32_update_slice4   4 KB  one 32-bit load, four lookups per word
+//   crc32_update_slice8   8 KB  two words per step, eight independent lookups
+//   crc32_update_slice16 16 KB  four words per step (host)
+//
+// crc32_update() uses slice8 on the target and slice16 on a host. The
+// slicing backends read aligned words after a byte-wise head, so any buffer
+// address works (PicoRV32 traps on misaligned loads); big-endian hosts fall
+// back to the byte loop. crc32_update_u8() is the inline single-byte step
+// for streams (UART receive) and needs only the 1 KB table.
+//
+//==============================================================================
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CRC32_POLY      0xEDB88320u
+#define CRC32_INIT      0xFFFFFFFFu
+
+// Generated tables (T[0], T[1..7], T[8..15])
+extern const uint32_t crc32_table[256];
+extern const uint32_t crc32_table_slice8[7][256];
+extern const uint32_t crc32_table_slice16[8][256];
+
+static inline uint32_t crc32_init(void) {
+    return CRC32_INIT;
+}
+
+static inline uint32_t crc32_update_u8(uint32_t crc, uint8_t byte) {
+    return (crc >> 8) ^ crc32_table[(crc ^ byte) & 0xFF];
+}
+
+static inline uint32_t crc32_final(uint32_t crc) {
+    return ~crc;
+}
+
+// Default backend, and the one-shot checksum of a buffer
+uint32_t crc32_update(uint32_t crc, const void *data, size_t len);
+uint32_t crc32(const void *data, size_t len);
+
+// Individual backends (same result, different speed and table size)
+uint32_t crc32_update_byte(uint32_t crc, const void *data, size_t len);
+uint32_t crc32_update_slice4(uint32_t crc, const void *data, size_t len);
+uint32_t crc32_update_slice8(uint32_t crc, const void *data, size_t len);
+uint32_t crc32_update_slice16(uint32_t crc, const void *data, size_t len);
+
+// Backend list for benchmarks (crc32_backends.c)
+typedef uint32_t (*crc32_fn_t)(uint32_t crc, const void *data, size_t len);
+
+typedef struct {
+    const char *name;
+    crc32_fn_t update;
+    uint32_t table_bytes;
+} crc32_backend_t;
+
+extern const crc32_backend_t crc32_backends[];
+extern const int crc32_num_backends;
+
+#endif // CRC32_H
@@ -0,0 +1,26 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// crc32_backends.c - CRC-32 Backend List (benchmarks only)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Referencing this list links every backend and all 16 KB of tables; normal
+// users call crc32()/crc32_update() and get only the default.
+//
+//==============================================================================
+
+#include "crc32.h"
+
+const crc32_backend_t crc32_backends[] = {
+    { "byte",    crc32_update_byte,    1024  },
+    { "slice4",  crc32_update_slice4,  4096  },
+    { "slice8",  crc32_update_slice8,  8192  },
+    { "slice16", crc32_update_slice16, 16384 },
+};
+
+const int crc32_num_backends = (int)(sizeof(crc32_backends) / sizeof(crc32_backends[0]));
@@ -0,0 +1,70 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// crc32_slice.c - CRC-32 Slicing-by-4 and Slicing-by-8
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Table T[k] advances a byte by k further zero bytes, so each byte of a
+// word (or two words) is looked up independently and the results are
+// XORed: one step per 4 or 8 bytes instead of a dependent chain per byte.
+//
+//==============================================================================
+
+#include "crc32_word.h"
+
+#define T0  crc32_table
+#define T1  crc32_table_slice8[0]
+#define T2  crc32_table_slice8[1]
+#define T3  crc32_table_slice8[2]
+#define T4  crc32_table_slice8[3]
+#define T5  crc32_table_slice8[4]
+#define T6  crc32_table_slice8[5]
+#define T7  crc32_table_slice8[6]
+
+uint32_t crc32_update_slice4(uint32_t crc, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+
+    if (CRC32_WORDS) {
+        size_t head = crc32_head(p, len);
+        crc = crc32_update_byte(crc, p, head);
+        p += head;
+        len -= head;
+
+        const crc32_word_t *w = (const crc32_word_t *)p;
+        for (; len >= 4; len -= 4) {
+            crc ^= *w++;
+            crc = T3[crc & 0xFF] ^ T2[(crc >> 8) & 0xFF] ^
+                  T1[(crc >> 16) & 0xFF] ^ T0[crc >> 24];
+        }
+        p = (const uint8_t *)w;
+    }
+    return crc32_update_byte(crc, p, len);
+}
+
+uint32_t crc32_update_slice8(uint32_t crc, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+
+    if (CRC32_WORDS) {
+        size_t head = crc32_head(p, len);
+        crc = crc32_update_byte(crc, p, head);
+        p += head;
+        len -= head;
+
+        const crc32_word_t *w = (const crc32_word_t *)p;
+        for (; len >= 8; len -= 8) {
+            uint32_t lo = *w++ ^ crc;
+            uint32_t hi = *w++;
+            crc = T7[lo & 0xFF] ^ T6[(lo >> 8) & 0xFF] ^
+                  T5[(lo >> 16) & 0xFF] ^ T4[lo >> 24] ^
+                  T3[hi & 0xFF] ^ T2[(hi >> 8) & 0xFF] ^
+                  T1[(hi >> 16) & 0xFF] ^ T0[hi >> 24];
+        }
+        p = (const uint8_t *)w;
+    }
+    return crc32_update_byte(crc, p, len);
+}
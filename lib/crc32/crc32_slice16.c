@@ -0,0 +1,50 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// crc32_slice16.c - CRC-32 Slicing-by-16 (Host Default)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Four words per step, sixteen independent lookups. Plain C so it builds
+// with every uploader compiler (clang, gcc, MinGW, MSVC) on any CPU.
+//
+//==============================================================================
+
+#include "crc32_word.h"
+
+#define T0  crc32_table
+#define T(k) ((k) < 8 ? crc32_table_slice8[(k) - 1] : crc32_table_slice16[(k) - 8])
+
+uint32_t crc32_update_slice16(uint32_t crc, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+
+    if (CRC32_WORDS) {
+        size_t head = crc32_head(p, len);
+        crc = crc32_update_byte(crc, p, head);
+        p += head;
+        len -= head;
+
+        const crc32_word_t *w = (const crc32_word_t *)p;
+        for (; len >= 16; len -= 16) {
+            uint32_t w0 = w[0] ^ crc;
+            uint32_t w1 = w[1];
+            uint32_t w2 = w[2];
+            uint32_t w3 = w[3];
+            w += 4;
+            crc = T(15)[w0 & 0xFF] ^ T(14)[(w0 >> 8) & 0xFF] ^
+                  T(13)[(w0 >> 16) & 0xFF] ^ T(12)[w0 >> 24] ^
+                  T(11)[w1 & 0xFF] ^ T(10)[(w1 >> 8) & 0xFF] ^
+                  T(9)[(w1 >> 16) & 0xFF] ^ T(8)[w1 >> 24] ^
+                  T(7)[w2 & 0xFF] ^ T(6)[(w2 >> 8) & 0xFF] ^
+                  T(5)[(w2 >> 16) & 0xFF] ^ T(4)[w2 >> 24] ^
+                  T(3)[w3 & 0xFF] ^ T(2)[(w3 >> 8) & 0xFF] ^
+                  T(1)[(w3 >> 16) & 0xFF] ^ T0[w3 >> 24];
+        }
+        p = (const uint8_t *)w;
+    }
+    return crc32_update_byte(crc, p, len);
+}
@@ -0,0 +1,41 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// crc32_word.h - Word Access for the Slicing Backends
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// The slicing backends XOR the CRC into little-endian 32-bit words. Loads
+// are always aligned (the head is done byte by byte) and go through a
+// may_alias type, because memcpy() is a real call under -fno-builtin.
+//
+//==============================================================================
+
+#ifndef CRC32_WORD_H
+#define CRC32_WORD_H
+
+#include "crc32.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define CRC32_WORDS     0       // Byte loop only
+#else
+#define CRC32_WORDS     1
+#endif
+
+#if defined(__GNUC__)
+typedef uint32_t __attribute__((may_alias)) crc32_word_t;
+#else
+typedef uint32_t crc32_word_t;
+#endif
+
+// Bytes before p is 4-byte aligned (at most len)
+static inline size_t crc32_head(const uint8_t *p, size_t len) {
+    size_t head = (size_t)(-(uintptr_t)p & 3);
+    return head < len ? head : len;
+}
+
+#endif // CRC32_WORD_H
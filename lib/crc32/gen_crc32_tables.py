@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+#===============================================================================
+# Olimex iCE40HX8K-EVB RISC-V Platform
+# gen_crc32_tables.py - Generate the Constant CRC-32 Lookup Tables
+#
+# Copyright (c) October 2025 Michael Wolak
+# Email: mikewolak@gmail.com, mike@epromfoundry.com
+#
+# NOT FOR COMMERCIAL USE
+# Educational and research purposes only
+#===============================================================================
+#
+# Writes the slicing tables of the reflected CRC-32 (polynomial 0xEDB88320)
+# as const arrays, one file per backend group so a firmware links only the
+# tables it uses:
+#
+#   crc32_table.c           T[0]        crc32_table          1 KB  (byte)
+#   crc32_table_slice8.c    T[1..7]     crc32_table_slice8   7 KB  (slice4/8)
+#   crc32_table_slice16.c   T[8..15]    crc32_table_slice16  8 KB  (slice16)
+#
+# T[0][n] is the CRC of byte n; T[k][n] = (T[k-1][n] >> 8) ^ T[0][T[k-1][n] & 0xFF]
+# is the same byte followed by k zero bytes.
+#
+# Usage: gen_crc32_tables.py [output_dir]     ('make tables' in lib/crc32)
+#===============================================================================
+
+import os
+import sys
+
+POLY = 0xEDB88320
+
+
+def make_tables(count):
+    t0 = []
+    for n in range(256):
+        crc = n
+        for _ in range(8):
+            crc = (crc >> 1) ^ (POLY if crc & 1 else 0)
+        t0.append(crc)
+    tables = [t0]
+    for _ in range(1, count):
+        prev = tables[-1]
+        tables.append([(v >> 8) ^ t0[v & 0xFF] for v in prev])
+    return tables
+
+
+def format_table(table, indent):
+    lines = []
+    for i in range(0, 256, 6):
+        row = ", ".join("0x%08Xu" % v for v in table[i:i + 6])
+        lines.append(indent + row + ("," if i + 6 < 256 else ""))
+    return "\n".join(lines)
+
+
+def write_file(path, name, desc, decl, tables, first):
+    out = []
+    out.append("//" + "=" * 78)
+    out.append("// Olimex iCE40HX8K-EVB RISC-V Platform")
+    out.append("// %s - %s" % (name, desc))
+    out.append("//")
+    out.append("// Copyright (c) October 2025 Michael Wolak")
+    out.append("// Email: mikewolak@gmail.com, mike@epromfoundry.com")
+    out.append("//")
+    out.append("// NOT FOR COMMERCIAL USE")
+    out.append("// Educational and research purposes only")
+    out.append("//" + "=" * 78)
+    out.append("//")
+    out.append("// Generated by gen_crc32_tables.py - do not edit.")
+    out.append("//")
+    out.append("//" + "=" * 78)
+    out.append("")
+    out.append('#include "crc32.h"')
+    out.append("")
+    if len(tables) == 1:
+        out.append("%s = {" % decl)
+        out.append(format_table(tables[0], "    "))
+        out.append("};")
+    else:
+        out.append("%s = {" % decl)
+        for k, table in enumerate(tables):
+            out.append("    {   // T[%d]" % (first + k))
+            out.append(format_table(table, "        "))
+            out.append("    }" + ("," if k + 1 < len(tables) else ""))
+        out.append("};")
+    out.append("")
+    with open(path, "w") as f:
+        f.write("\n".join(out))
+
+
+def main():
+    outdir = sys.argv[1] if len(sys.argv) > 1 else os.path.dirname(os.path.abspath(__file__))
+    tables = make_tables(16)
+
+    write_file(os.path.join(outdir, "crc32_table.c"), "crc32_table.c",
+               "CRC-32 Byte Table T[0]",
+               "const uint32_t crc32_table[256]", tables[0:1], 0)
+    write_file(os.path.join(outdir, "crc32_table_slice8.c"), "crc32_table_slice8.c",
+               "CRC-32 Slicing Tables T[1..7]",
+               "const uint32_t crc32_table_slice8[7][256]", tables[1:8], 1)
+    write_file(os.path.join(outdir, "crc32_table_slice16.c"), "crc32_table_slice16.c",
+               "CRC-32 Slicing Tables T[8..15]",
+               "const uint32_t crc32_table_slice16[8][256]", tables[8:16], 8)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
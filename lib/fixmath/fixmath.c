@@ -0,0 +1,310 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// fixmath.c - Q16.16 / Q4.28 Fixed-Point Math (saturating, CORDIC)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Internal format for the transcendentals is Q2.30 (range [-2, 2)): CORDIC
+// state, angles up to pi/2 and the exp/log series all fit, and results are
+// rounded once into Q16.16 or Q4.28 at the end.
+//
+//==============================================================================
+
+#include "fixmath.h"
+
+#define Q30_ONE         (1 << 30)
+#define Q30_HALF_PI     1686629713      // pi/2
+#define Q30_LN2         744261118       // ln 2
+#define Q30_SQRT2       1518500250      // sqrt(2)
+#define Q28_TWO_PI      1686629713      // 2 pi
+#define CORDIC_STEPS    30
+#define CORDIC_GAIN_INV 652032874       // prod 1/sqrt(1 + 2^-2i), Q2.30
+
+// atan(2^-i) in Q2.30
+static const int32_t cordic_atan[CORDIC_STEPS] = {
+    843314857, 497837829, 263043837, 133525159, 67021687, 33543516,
+    16775851, 8388437, 4194283, 2097149, 1048576, 524288,
+    262144, 131072, 65536, 32768, 16384, 8192,
+    4096, 2048, 1024, 512, 256, 128,
+    64, 32, 16, 8, 4, 2,
+};
+
+static inline int32_t mul30(int32_t a, int32_t b) {
+    return (int32_t)(((int64_t)a * b + (1 << 29)) >> 30);
+}
+
+// Q2.30 -> Q16.16 / Q4.28, rounded
+static inline int32_t q30_to_16(int32_t v) {
+    return (int32_t)(((int64_t)v + (1 << 13)) >> 14);
+}
+
+static inline int32_t q30_to_28(int32_t v) {
+    return (int32_t)(((int64_t)v + 2) >> 2);
+}
+
+//==============================================================================
+// Division and square root
+//==============================================================================
+
+// (a << shift) / b rounded to nearest, saturating
+static int32_t div_shift(int32_t a, int32_t b, int shift) {
+    if (b == 0) return a < 0 ? INT32_MIN : INT32_MAX;
+
+    int neg = (a < 0) != (b < 0);
+    uint64_t n = (uint64_t)(a < 0 ? -(int64_t)a : a) << shift;
+    uint64_t d = (uint64_t)(b < 0 ? -(int64_t)b : b);
+    uint64_t q = (n + d / 2) / d;
+
+    if (neg) return q > (uint64_t)INT32_MAX + 1 ? INT32_MIN : (int32_t)(0 - q);
+    return q > INT32_MAX ? INT32_MAX : (int32_t)q;
+}
+
+fix16_t fix16_div(fix16_t a, fix16_t b) {
+    return div_shift(a, b, 16);
+}
+
+fix16_t fix16_recip(fix16_t a) {
+    return div_shift(FIX16_ONE, a, 16);
+}
+
+fix28_t fix28_div(fix28_t a, fix28_t b) {
+    return div_shift(a, b, 28);
+}
+
+// floor(sqrt(n)) rounded to nearest, digit by digit (no multiply)
+static uint32_t isqrt64_round(uint64_t n) {
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > n) bit >>= 2;
+    while (bit) {
+        if (n >= res + bit) {
+            n -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    // Remainder > res means sqrt >= res + 0.5
+    if (n > res) res++;
+    return (uint32_t)res;
+}
+
+fix16_t fix16_sqrt(fix16_t a) {
+    if (a < 0) return FIX16_MIN;
+    return (fix16_t)isqrt64_round((uint64_t)a << 16);
+}
+
+fix28_t fix28_sqrt(fix28_t a) {
+    if (a < 0) return FIX28_MIN;
+    return (fix28_t)isqrt64_round((uint64_t)a << 28);
+}
+
+//==============================================================================
+// CORDIC
+//==============================================================================
+
+// Rotation mode: z in [-pi/2, pi/2] (Q2.30) -> cos, sin (Q2.30)
+static void cordic_rotate(int32_t z, int32_t *c, int32_t *s) {
+    int32_t x = CORDIC_GAIN_INV, y = 0;
+
+    for (int i = 0; i < CORDIC_STEPS; i++) {
+        int32_t xs = x >> i, ys = y >> i;
+        if (z >= 0) {
+            x -= ys;
+            y += xs;
+            z -= cordic_atan[i];
+        } else {
+            x += ys;
+            y -= xs;
+            z += cordic_atan[i];
+        }
+    }
+    *c = x;
+    *s = y;
+}
+
+// Vectoring mode: atan(y / x) for x, y >= 0, not both zero -> [0, pi/2] (Q2.30)
+static int32_t cordic_atan_q1(uint32_t x, uint32_t y) {
+    // Scale the larger one into [2^28, 2^29): the CORDIC gain (1.65) times
+    // sqrt(2) must stay below 2^31
+    uint32_t m = x > y ? x : y;
+    int sh = __builtin_clz(m) - 3;
+    if (sh >= 0) {
+        x <<= sh;
+        y <<= sh;
+    } else {
+        x >>= -sh;
+        y >>= -sh;
+    }
+
+    int32_t vx = (int32_t)x, vy = (int32_t)y, z = 0;
+    for (int i = 0; i < CORDIC_STEPS; i++) {
+        int32_t xs = vx >> i, ys = vy >> i;
+        if (vy > 0) {
+            vx += ys;
+            vy -= xs;
+            z += cordic_atan[i];
+        } else {
+            vx -= ys;
+            vy += xs;
+            z -= cordic_atan[i];
+        }
+    }
+    return z;
+}
+
+// Reduced angle r in Q4.28, [-pi, pi] -> cos, sin in Q2.30
+static void sincos_q28(int32_t r, int32_t *c, int32_t *s) {
+    int flip = 0;
+
+    // Fold into [-pi/2, pi/2]; cos changes sign, sin does not
+    if (r > FIX28_HALF_PI) {
+        r = FIX28_PI - r;
+        flip = 1;
+    } else if (r < -FIX28_HALF_PI) {
+        r = -FIX28_PI - r;
+        flip = 1;
+    }
+    cordic_rotate(r << 2, c, s);
+    if (flip) *c = -*c;
+}
+
+// Q4.28 angle reduced into [-pi, pi]
+static int32_t reduce_q28(int64_t r) {
+    if (r > FIX28_PI || r < -FIX28_PI) {
+        int64_t k = r / Q28_TWO_PI;
+        r -= k * Q28_TWO_PI;
+        if (r > FIX28_PI) r -= Q28_TWO_PI;
+        else if (r < -FIX28_PI) r += Q28_TWO_PI;
+    }
+    return (int32_t)r;
+}
+
+void fix16_sincos(fix16_t rad, fix16_t *s, fix16_t *c) {
+    int32_t c30, s30;
+
+    // Q16.16 -> Q4.28 in 64 bits, so the reduction loses nothing
+    sincos_q28(reduce_q28((int64_t)rad << 12), &c30, &s30);
+    if (s) *s = q30_to_16(s30);
+    if (c) *c = q30_to_16(c30);
+}
+
+fix16_t fix16_sin(fix16_t rad) {
+    fix16_t s;
+    fix16_sincos(rad, &s, 0);
+    return s;
+}
+
+fix16_t fix16_cos(fix16_t rad) {
+    fix16_t c;
+    fix16_sincos(rad, 0, &c);
+    return c;
+}
+
+fix16_t fix16_tan(fix16_t rad) {
+    int32_t c30, s30;
+
+    sincos_q28(reduce_q28((int64_t)rad << 12), &c30, &s30);
+    return div_shift(s30, c30, 16);
+}
+
+void fix28_sincos(fix28_t rad, fix28_t *s, fix28_t *c) {
+    int32_t c30, s30;
+
+    sincos_q28(reduce_q28(rad), &c30, &s30);
+    if (s) *s = q30_to_28(s30);
+    if (c) *c = q30_to_28(c30);
+}
+
+fix28_t fix28_sin(fix28_t rad) {
+    fix28_t s;
+    fix28_sincos(rad, &s, 0);
+    return s;
+}
+
+fix28_t fix28_cos(fix28_t rad) {
+    fix28_t c;
+    fix28_sincos(rad, 0, &c);
+    return c;
+}
+
+// atan2 as [0, pi/2] (Q2.30) plus the quadrant, into 'frac' fraction bits
+static int32_t atan2_frac(int32_t y, int32_t x, int frac) {
+    if (x == 0 && y == 0) return 0;
+
+    uint32_t ux = x < 0 ? 0u - (uint32_t)x : (uint32_t)x;
+    uint32_t uy = y < 0 ? 0u - (uint32_t)y : (uint32_t)y;
+    int64_t a = cordic_atan_q1(ux, uy);
+
+    // pi in Q2.30 does not fit 32 bits: finish in 64
+    if (x < 0) a = ((int64_t)Q30_HALF_PI << 1) - a;
+    if (y < 0) a = -a;
+    int sh = 30 - frac;
+    return (int32_t)((a + ((int64_t)1 << (sh - 1))) >> sh);
+}
+
+fix16_t fix16_atan2(fix16_t y, fix16_t x) {
+    return atan2_frac(y, x, 16);
+}
+
+fix16_t fix16_atan(fix16_t a) {
+    return atan2_frac(a, FIX16_ONE, 16);
+}
+
+fix28_t fix28_atan2(fix28_t y, fix28_t x) {
+    return atan2_frac(y, x, 28);
+}
+
+//==============================================================================
+// exp / log
+//==============================================================================
+
+fix16_t fix16_exp(fix16_t a) {
+    if (a >= F16(10.39721)) return FIX16_MAX;          // e^a > 32768 - 2^-16
+    if (a <= F16(-11.7835021)) return 0;               // e^a < 2^-17
+
+    // a = k ln2 + r, |r| <= ln2 / 2, r in Q2.30
+    int32_t v = a + FIX16_LN2 / 2;
+    int32_t k = v >= 0 ? v / FIX16_LN2 : -((FIX16_LN2 - 1 - v) / FIX16_LN2);
+    int32_t r = (int32_t)(((int64_t)a << 14) - (int64_t)k * Q30_LN2);
+
+    // e^r = 1 + r(1 + r/2(1 + r/3(... (1 + r/9)))), |r|^10/10! < 2^-32
+    int32_t p = Q30_ONE;
+    for (int n = 9; n >= 1; n--) p = Q30_ONE + mul30(r, p) / n;
+
+    // p * 2^k in Q2.30 -> Q16.16
+    int sh = 14 - k;
+    if (sh <= 0) return fix_sat64((int64_t)p << -sh);
+    if (sh >= 63) return 0;
+    return (fix16_t)(((int64_t)p + ((int64_t)1 << (sh - 1))) >> sh);
+}
+
+fix16_t fix16_log(fix16_t a) {
+    if (a <= 0) return FIX16_MIN;
+
+    // a = m 2^e, m in [sqrt(2)/2, sqrt(2)) as Q2.30
+    int lz = __builtin_clz((uint32_t)a);
+    int32_t m = (int32_t)((uint32_t)a << (lz - 1));
+    int32_t e = 15 - lz;
+    if (m > Q30_SQRT2) {
+        m = (int32_t)((uint32_t)m >> 1);
+        e++;
+    }
+
+    // ln m = 2 atanh(s) = 2 (s + s^3/3 + ... + s^13/13), s = (m-1)/(m+1), |s| < 0.172
+    int64_t num = (int64_t)(m - Q30_ONE) << 30, den = (int64_t)m + Q30_ONE;
+    int32_t s = (int32_t)((num + (num < 0 ? -den : den) / 2) / den);
+    int32_t s2 = mul30(s, s);
+    int32_t t = 0;
+    for (int n = 13; n >= 3; n -= 2) t = mul30(s2, Q30_ONE / n + t);
+    int64_t ln = 2 * ((int64_t)s + mul30(s, t)) + (int64_t)e * Q30_LN2;
+
+    return (fix16_t)((ln + (1 << 13)) >> 14);
+}
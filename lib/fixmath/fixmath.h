@@ -0,0 +1,190 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// fixmath.h - Q16.16 / Q4.28 Fixed-Point Math (saturating, CORDIC)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// PicoRV32 is rv32im without an FPU, so every libm call goes through
+// soft-float double (thousands of cycles). These routines use only 32x32
+// multiplies (mul/mulh) and shifts:
+//
+//   fix16_t  Q16.16  range [-32768, 32768)   1 ulp = 2^-16 ~ 1.5e-5
+//   fix28_t  Q4.28   range [-8, 8)           1 ulp = 2^-28 ~ 3.7e-9
+//
+// Arithmetic saturates at FIX16_MAX / FIX16_MIN (FIX28_MAX / FIX28_MIN)
+// instead of wrapping. Domain errors (sqrt of a negative number, log of a
+// value <= 0) return FIX16_MIN.
+//
+// sin/cos/atan2 run a 30-step CORDIC in Q2.30; exp/log reduce by ln 2 and
+// evaluate a short series in Q2.30. Error bounds below are the maximum
+// absolute error against double-precision libm over the whole input range
+// (measured with math_test option 'x' and a host sweep), in ulps of the
+// result type:
+//
+//   fix16_mul, fix16_div, fix16_sqrt, fix16_recip  <= 0.5 ulp (correctly rounded)
+//   fix16_sin, fix16_cos                           <= 1 ulp
+//   fix16_tan                                      <= 1 ulp for |tan| < 16; near
+//                                                     the poles ~0.5 ulp x (1 + tan^2)
+//                                                     (the slope, not the CORDIC)
+//   fix16_atan2, fix16_atan                        <= 1 ulp
+//   fix16_exp                                      <= 1 ulp below 1024, 2^-27
+//                                                     relative above
+//   fix16_log                                      <= 1 ulp
+//   fix28_mul, fix28_div, fix28_sqrt               <= 0.5 ulp
+//   fix28_sin, fix28_cos                           <= 6 ulp (2.2e-8)
+//   fix28_atan2                                    <= 10 ulp
+//
+//==============================================================================
+
+#ifndef FIXMATH_H
+#define FIXMATH_H
+
+#include <stdint.h>
+
+typedef int32_t fix16_t;        // Q16.16
+typedef int32_t fix28_t;        // Q4.28
+
+#define FIX16_ONE       ((fix16_t)0x00010000)
+#define FIX16_MAX       ((fix16_t)0x7FFFFFFF)
+#define FIX16_MIN       ((fix16_t)0x80000000)
+#define FIX16_PI        ((fix16_t)205887)
+#define FIX16_TWO_PI    ((fix16_t)411775)
+#define FIX16_HALF_PI   ((fix16_t)102944)
+#define FIX16_E         ((fix16_t)178145)
+#define FIX16_LN2       ((fix16_t)45426)
+
+#define FIX28_ONE       ((fix28_t)0x10000000)
+#define FIX28_MAX       ((fix28_t)0x7FFFFFFF)
+#define FIX28_MIN       ((fix28_t)0x80000000)
+#define FIX28_PI        ((fix28_t)843314857)
+#define FIX28_HALF_PI   ((fix28_t)421657428)
+
+// Compile-time constant from a literal: F16(1.5), F28(-0.25)
+#define F16(x)  ((fix16_t)((x) * 65536.0 + ((x) >= 0 ? 0.5 : -0.5)))
+#define F28(x)  ((fix28_t)((x) * 268435456.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+//==============================================================================
+// Conversions
+//==============================================================================
+
+static inline fix16_t fix16_from_int(int32_t a) {
+    if (a > 32767) return FIX16_MAX;
+    if (a < -32768) return FIX16_MIN;
+    return (fix16_t)((uint32_t)a << 16);
+}
+
+// Rounds to nearest (half away from zero)
+static inline int32_t fix16_to_int(fix16_t a) {
+    return a >= 0 ? (int32_t)((a + 0x8000) >> 16) : -(int32_t)((0x8000 - (int64_t)a) >> 16);
+}
+
+// Soft-float on this CPU - for I/O and test references only
+static inline fix16_t fix16_from_double(double d) {
+    d = d * 65536.0 + (d >= 0 ? 0.5 : -0.5);
+    if (d >= 2147483647.0) return FIX16_MAX;
+    if (d <= -2147483648.0) return FIX16_MIN;
+    return (fix16_t)d;
+}
+
+static inline double fix16_to_double(fix16_t a) {
+    return (double)a / 65536.0;
+}
+
+static inline fix28_t fix28_from_double(double d) {
+    d = d * 268435456.0 + (d >= 0 ? 0.5 : -0.5);
+    if (d >= 2147483647.0) return FIX28_MAX;
+    if (d <= -2147483648.0) return FIX28_MIN;
+    return (fix28_t)d;
+}
+
+static inline double fix28_to_double(fix28_t a) {
+    return (double)a / 268435456.0;
+}
+
+// Q16.16 -> Q4.28 saturates outside [-8, 8); Q4.28 -> Q16.16 rounds
+static inline fix28_t fix28_from_fix16(fix16_t a) {
+    if (a >= (8 << 16)) return FIX28_MAX;
+    if (a < -(8 << 16)) return FIX28_MIN;
+    return (fix28_t)((uint32_t)a << 12);
+}
+
+static inline fix16_t fix16_from_fix28(fix28_t a) {
+    return (fix16_t)(((int64_t)a + 0x800) >> 12);
+}
+
+//==============================================================================
+// Saturating arithmetic
+//==============================================================================
+
+static inline int32_t fix_sat64(int64_t v) {
+    if (v > INT32_MAX) return INT32_MAX;
+    if (v < INT32_MIN) return INT32_MIN;
+    return (int32_t)v;
+}
+
+static inline fix16_t fix16_add(fix16_t a, fix16_t b) {
+    int32_t r;
+    if (__builtin_add_overflow(a, b, &r)) return a < 0 ? FIX16_MIN : FIX16_MAX;
+    return r;
+}
+
+static inline fix16_t fix16_sub(fix16_t a, fix16_t b) {
+    int32_t r;
+    if (__builtin_sub_overflow(a, b, &r)) return a < 0 ? FIX16_MIN : FIX16_MAX;
+    return r;
+}
+
+static inline fix16_t fix16_abs(fix16_t a) {
+    return a == FIX16_MIN ? FIX16_MAX : (a < 0 ? -a : a);
+}
+
+// Rounded to nearest, saturating (mul + mulh)
+static inline fix16_t fix16_mul(fix16_t a, fix16_t b) {
+    return fix_sat64(((int64_t)a * b + 0x8000) >> 16);
+}
+
+// Truncating, wraps on overflow: for inner loops whose range is known
+// (Mandelbrot iteration with |z| <= 2)
+static inline fix16_t fix16_mul_fast(fix16_t a, fix16_t b) {
+    return (fix16_t)(((int64_t)a * b) >> 16);
+}
+
+#define fix28_add   fix16_add
+#define fix28_sub   fix16_sub
+#define fix28_abs   fix16_abs
+
+static inline fix28_t fix28_mul(fix28_t a, fix28_t b) {
+    return fix_sat64(((int64_t)a * b + (1 << 27)) >> 28);
+}
+
+//==============================================================================
+// Functions (fixmath.c)
+//==============================================================================
+
+fix16_t fix16_div(fix16_t a, fix16_t b);        // b == 0 saturates by sign of a
+fix16_t fix16_recip(fix16_t a);                 // 1 / a
+fix16_t fix16_sqrt(fix16_t a);                  // a < 0 -> FIX16_MIN
+
+fix16_t fix16_sin(fix16_t rad);                 // any angle, exact reduction
+fix16_t fix16_cos(fix16_t rad);
+void    fix16_sincos(fix16_t rad, fix16_t *s, fix16_t *c);
+fix16_t fix16_tan(fix16_t rad);                 // saturates near +-pi/2
+fix16_t fix16_atan2(fix16_t y, fix16_t x);      // [-pi, pi], atan2(0, 0) = 0
+fix16_t fix16_atan(fix16_t a);
+
+fix16_t fix16_exp(fix16_t a);                   // saturates above ln(32768)
+fix16_t fix16_log(fix16_t a);                   // natural log, a <= 0 -> FIX16_MIN
+
+fix28_t fix28_div(fix28_t a, fix28_t b);
+fix28_t fix28_sqrt(fix28_t a);                  // a < 0 -> FIX28_MIN
+fix28_t fix28_sin(fix28_t rad);                 // rad in [-8, 8)
+fix28_t fix28_cos(fix28_t rad);
+void    fix28_sincos(fix28_t rad, fix28_t *s, fix28_t *c);
+fix28_t fix28_atan2(fix28_t y, fix28_t x);
+
+#endif // FIXMATH_H
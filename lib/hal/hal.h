@@ -0,0 +1,305 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// hal.h - Header-Only Hardware Abstraction Layer
+//
+// Registers and drivers for the MMIO peripherals of hdl/mmio_peripherals.v
+// (UART, LEDs, mode control, buttons, timer, SRAM BIST) and the PicoRV32
+// IRQ mask.
+// Everything is a macro or a static inline function: a call compiles to the
+// same lui/lw/sw sequence as a hand-written register access, and a firmware
+// only pays for what it uses. Taking the address of a driver (e.g. for
+// simple_callbacks_t) emits one local out-of-line copy.
+//
+// Peripheral bases are compile-time constants. Define HAL_MMIO_BASE, or one
+// HAL_<PERIPHERAL>_BASE, with -D to build for a different memory map.
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//==============================================================================
+// Configuration
+//==============================================================================
+
+#ifndef HAL_MMIO_BASE
+#define HAL_MMIO_BASE       0x80000000u
+#endif
+#ifndef HAL_UART_BASE
+#define HAL_UART_BASE       (HAL_MMIO_BASE + 0x00)
+#endif
+#ifndef HAL_LED_BASE
+#define HAL_LED_BASE        (HAL_MMIO_BASE + 0x10)
+#endif
+#ifndef HAL_MODE_BASE
+#define HAL_MODE_BASE       (HAL_MMIO_BASE + 0x14)
+#endif
+#ifndef HAL_BUTTON_BASE
+#define HAL_BUTTON_BASE     (HAL_MMIO_BASE + 0x18)
+#endif
+#ifndef HAL_TIMER_BASE
+#define HAL_TIMER_BASE      (HAL_MMIO_BASE + 0x20)
+#endif
+#ifndef HAL_BIST_BASE
+#define HAL_BIST_BASE       (HAL_MMIO_BASE + 0x40)
+#endif
+#ifndef HAL_CLK_HZ
+#define HAL_CLK_HZ          50000000u   // System clock (timer input)
+#endif
+
+//==============================================================================
+// Register Access
+//==============================================================================
+
+#define HAL_REG(addr)       (*(volatile uint32_t *)(addr))
+
+static inline uint32_t hal_read(uint32_t addr) {
+    return HAL_REG(addr);
+}
+
+static inline void hal_write(uint32_t addr, uint32_t value) {
+    HAL_REG(addr) = value;
+}
+
+// UART
+#define UART_TX_DATA        HAL_REG(HAL_UART_BASE + 0x00)   // Write stalls while busy
+#define UART_TX_STATUS      HAL_REG(HAL_UART_BASE + 0x04)   // [0] = TX busy
+#define UART_RX_DATA        HAL_REG(HAL_UART_BASE + 0x08)   // Read pops the RX FIFO
+#define UART_RX_STATUS      HAL_REG(HAL_UART_BASE + 0x0C)   // [0] = data available
+
+#define UART_TX_BUSY        (1u << 0)
+#define UART_RX_AVAIL       (1u << 0)
+
+// LEDs, mode control, buttons
+#define LED_CONTROL         HAL_REG(HAL_LED_BASE)           // [1:0] = LED2, LED1
+#define MODE_CONTROL        HAL_REG(HAL_MODE_BASE)          // 0 = shell, 1 = app
+#define BUTTON_INPUT        HAL_REG(HAL_BUTTON_BASE)        // [1:0] = BUT2, BUT1 (synchronized)
+
+#define LED1                (1u << 0)
+#define LED2                (1u << 1)
+#define BUT1_MASK           (1u << 0)
+#define BUT2_MASK           (1u << 1)
+
+// Timer (hdl/timer_peripheral.v, STM32-style)
+#define TIMER_CR            HAL_REG(HAL_TIMER_BASE + 0x00)  // Control
+#define TIMER_SR            HAL_REG(HAL_TIMER_BASE + 0x04)  // Status (write 1 to clear)
+#define TIMER_PSC           HAL_REG(HAL_TIMER_BASE + 0x08)  // Prescaler, clock / (PSC+1)
+#define TIMER_ARR           HAL_REG(HAL_TIMER_BASE + 0x0C)  // Auto-reload, period ARR+1 ticks
+#define TIMER_CNT           HAL_REG(HAL_TIMER_BASE + 0x10)  // Counter (counts down)
+
+#define TIMER_CR_ENABLE     (1u << 0)   // 1 = running
+#define TIMER_CR_ONE_SHOT   (1u << 1)   // 1 = stop after one period
+#define TIMER_SR_UIF        (1u << 0)   // Update interrupt flag (IRQ[0])
+
+// SRAM BIST (hdl/sram_bist.v). START stalls the CPU's next SRAM access,
+// including instruction fetch, until the run ends.
+#define BIST_CTRL           HAL_REG(HAL_BIST_BASE + 0x00)   // Start, test mask
+#define BIST_STATUS         HAL_REG(HAL_BIST_BASE + 0x04)   // Busy/done/fail, failing step
+#define BIST_START          HAL_REG(HAL_BIST_BASE + 0x08)   // First byte address
+#define BIST_END            HAL_REG(HAL_BIST_BASE + 0x0C)   // End byte address (exclusive)
+#define BIST_PATTERN        HAL_REG(HAL_BIST_BASE + 0x10)   // [15:0] March C- background
+#define BIST_FAIL_ADDR      HAL_REG(HAL_BIST_BASE + 0x14)   // First failing halfword
+#define BIST_FAIL_DATA      HAL_REG(HAL_BIST_BASE + 0x18)   // [31:16] = expected, [15:0] = read
+#define BIST_ERRORS         HAL_REG(HAL_BIST_BASE + 0x1C)   // Failing reads (saturates)
+#define BIST_CYCLES         HAL_REG(HAL_BIST_BASE + 0x20)   // Clocks of the last run
+#define BIST_ID             HAL_REG(HAL_BIST_BASE + 0x24)   // Reads BIST_ID_VALUE
+
+#define BIST_CTRL_START     (1u << 0)   // Write 1 to start a run
+#define BIST_CTRL_MARCH     (1u << 4)   // Test mask (all clear = all tests)
+#define BIST_CTRL_WALK      (1u << 5)
+#define BIST_CTRL_ADDR      (1u << 6)
+#define BIST_STATUS_BUSY    (1u << 0)
+#define BIST_STATUS_DONE    (1u << 1)
+#define BIST_STATUS_FAIL    (1u << 2)
+#define BIST_STATUS_RANGE   (1u << 3)   // START/END rejected, nothing ran
+#define BIST_STATUS_STEP(s) (((s) >> 8) & 0xFu)     // Step of the first failure
+#define BIST_ID_VALUE       0x42495354u             // "BIST"
+
+//==============================================================================
+// PicoRV32 IRQ Mask
+//
+// maskirq (.insn r 0x0B, 6, 3): a 1 bit masks (disables) that IRQ. The "J"
+// constraint lets a constant 0 use x0, so irq_enable() is one instruction.
+//==============================================================================
+
+// Set the IRQ mask, returning the previous one
+static inline uint32_t irq_setmask(uint32_t mask) {
+    uint32_t old;
+    __asm__ volatile (".insn r 0x0B, 6, 3, %0, %z1, x0" : "=r"(old) : "rJ"(mask) : "memory");
+    return old;
+}
+
+static inline void irq_enable(void) {
+    (void)irq_setmask(0);
+}
+
+static inline void irq_disable(void) {
+    (void)irq_setmask(~0u);
+}
+
+// PicoRV32 cycle timer (.insn r 0x0B, 6, 5): raises IRQ 0 once after
+// `cycles` clocks, 0 stops it. Returns the count that was left, which reads
+// 0 in the handler of its own interrupt (the timer peripheral shares IRQ 0).
+static inline uint32_t cpu_timer(uint32_t cycles) {
+    uint32_t left;
+    __asm__ volatile (".insn r 0x0B, 6, 5, %0, %z1, x0" : "=r"(left) : "rJ"(cycles) : "memory");
+    return left;
+}
+
+//==============================================================================
+// UART
+//==============================================================================
+
+static inline int uart_tx_busy(void) {
+    return UART_TX_STATUS & UART_TX_BUSY;
+}
+
+static inline int uart_getc_available(void) {
+    return UART_RX_STATUS & UART_RX_AVAIL;
+}
+
+static inline void uart_putc(uint8_t c) {
+    while (uart_tx_busy());
+    UART_TX_DATA = c;
+}
+
+// Blocking read
+static inline uint8_t uart_getc(void) {
+    while (!uart_getc_available());
+    return (uint8_t)UART_RX_DATA;
+}
+
+// Bytes as they are (no '\n' -> "\r\n" translation)
+static inline void uart_puts(const char *s) {
+    while (*s) {
+        uart_putc((uint8_t)*s++);
+    }
+}
+
+// Send a whole buffer
+static inline void uart_write(const void *buf, size_t len) {
+    const uint8_t *p = (const uint8_t *)buf;
+
+    while (len--) {
+        uart_putc(*p++);
+    }
+}
+
+// Fill a whole buffer (blocking)
+static inline void uart_read(void *buf, size_t len) {
+    uint8_t *p = (uint8_t *)buf;
+
+    while (len--) {
+        *p++ = uart_getc();
+    }
+}
+
+// Drain what is already in the RX FIFO, up to max bytes; returns the count
+static inline size_t uart_read_available(void *buf, size_t max) {
+    uint8_t *p = (uint8_t *)buf;
+    size_t n = 0;
+
+    while (n < max && uart_getc_available()) {
+        p[n++] = (uint8_t)UART_RX_DATA;
+    }
+    return n;
+}
+
+// Discard pending input
+static inline void uart_flush_rx(void) {
+    while (uart_getc_available()) {
+        (void)UART_RX_DATA;
+    }
+}
+
+//==============================================================================
+// LEDs, Mode, Buttons
+//==============================================================================
+
+static inline void led_set(uint32_t leds) {
+    LED_CONTROL = leds;
+}
+
+static inline uint32_t led_get(void) {
+    return LED_CONTROL & (LED1 | LED2);
+}
+
+static inline uint32_t button_read(void) {
+    return BUTTON_INPUT & (BUT1_MASK | BUT2_MASK);
+}
+
+static inline void mode_set(uint32_t mode) {
+    MODE_CONTROL = mode;
+}
+
+//==============================================================================
+// Timer
+//==============================================================================
+
+// mmio_peripherals registers the timer's read mux one access late: a read
+// returns the value latched by the previous timer access. The first read
+// latches, the second returns the register as of the first.
+static inline uint32_t timer_read(volatile uint32_t *reg) {
+    (void)*reg;
+    return *reg;
+}
+
+// Stop and clear any pending interrupt
+static inline void timer_init(void) {
+    TIMER_CR = 0;
+    TIMER_SR = TIMER_SR_UIF;
+}
+
+// IRQ rate = HAL_CLK_HZ / (psc+1) / (arr+1)
+static inline void timer_config(uint32_t psc, uint32_t arr) {
+    TIMER_PSC = psc;
+    TIMER_ARR = arr;
+}
+
+static inline void timer_start(void) {
+    TIMER_CR = TIMER_CR_ENABLE;
+}
+
+static inline void timer_start_oneshot(void) {
+    TIMER_CR = TIMER_CR_ENABLE | TIMER_CR_ONE_SHOT;
+}
+
+static inline void timer_stop(void) {
+    TIMER_CR = 0;
+}
+
+static inline void timer_clear_irq(void) {
+    TIMER_SR = TIMER_SR_UIF;
+}
+
+static inline uint32_t timer_irq_pending(void) {
+    return timer_read(&TIMER_SR) & TIMER_SR_UIF;
+}
+
+static inline uint32_t timer_read_counter(void) {
+    return timer_read(&TIMER_CNT);
+}
+
+// Stop, clear, configure and start in continuous mode: the whole periodic
+// interrupt setup in one call
+static inline void timer_periodic(uint32_t psc, uint32_t arr) {
+    timer_init();
+    timer_config(psc, arr);
+    timer_start();
+}
+
+// Periodic interrupt at `hz` from a 1 MHz tick (constant hz folds at
+// compile time)
+static inline void timer_periodic_hz(uint32_t hz) {
+    timer_periodic(HAL_CLK_HZ / 1000000u - 1, 1000000u / hz - 1);
+}
+
+#endif // HAL_H
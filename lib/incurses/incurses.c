@@ -165,10 +165,14 @@ _mbedserial_puts(const char *str)
  *      RISC-V / Embedded UART driver (direct hardware access)
  *      Bypasses stdio to get unbuffered character input for curses
  *-----------------------------------------------------------------------*/
-// External UART functions (defined in application)
-extern char uart_getc(void);
-extern void uart_putc(char c);
-extern int uart_getc_available(void);
+#include "../hal/hal.h"
+#include "../uartmux/uartmux.h"
+
+// lib/uartmux, when the firmware links it, carries curses I/O on its
+// console channel (weak: the UART through lib/hal otherwise)
+void uartmux_putc(uint32_t ch, uint8_t c) __attribute__((weak));
+uint32_t uartmux_available(uint32_t ch) __attribute__((weak));
+uint8_t uartmux_getc(uint32_t ch) __attribute__((weak));
 
 // Global timeout setting for getch()
 static int g_getch_timeout = -1;  // -1 = blocking, 0 = non-blocking
@@ -177,6 +181,12 @@ static int
 _embeddedserial_getc(int timeout_ms)
 {
     /* Direct UART access for unbuffered input */
+    if (uartmux_getc) {
+        if (timeout_ms <= 0 && !uartmux_available(UARTMUX_CH_CONSOLE)) {
+            return ERR;
+        }
+        return (int)uartmux_getc(UARTMUX_CH_CONSOLE);
+    }
 
     // If non-blocking (timeout <= 0) and no data available, return ERR
     if (timeout_ms <= 0 && !uart_getc_available()) {
@@ -191,7 +201,11 @@ static void
 _embeddedserial_putc(int c)
 {
     DBGC(c);
-    uart_putc((char)c);
+    if (uartmux_putc) {
+        uartmux_putc(UARTMUX_CH_CONSOLE, (uint8_t)c);
+    } else {
+        uart_putc((uint8_t)c);
+    }
 }
 
 static void
@@ -0,0 +1,197 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// memstat.c - Stack/Heap High-Water Marks and Stack Guard Checker
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include <stddef.h>
+#include <stdio.h>
+#include "memstat.h"
+
+#include "../hal/hal.h"
+
+// Layout from linker.ld
+extern char __heap_start[];
+extern char __heap_end[];
+extern char __stack_bottom[];
+extern char __stack_top[];
+
+// _sbrk accounting kept by lib/syscalls.c
+extern char *sbrk_peak;
+extern unsigned int sbrk_calls;
+extern unsigned int sbrk_fails;
+void *_sbrk(int incr);
+
+// Defined by start.S (MEMSTAT=1) and memstat_wrap.c (pulled in by the
+// MEMSTAT=1 --wrap link flags); weak so plain builds still link
+extern uint32_t __stack_painted __attribute__((weak));
+void *__wrap_malloc(size_t size) __attribute__((weak));
+
+// Allocation counters, incremented by memstat_wrap.c
+volatile uint32_t memstat_mallocs;
+volatile uint32_t memstat_frees;
+volatile uint32_t memstat_reallocs;
+volatile uint32_t memstat_alloc_fails;
+
+static volatile uint32_t guard_bytes;
+static volatile uint32_t guard_hits;
+static volatile uint32_t guard_pc;
+static volatile uint32_t guard_addr;
+
+static int stack_painted(void) {
+    return &__stack_painted != 0 && __stack_painted == MEMSTAT_PAINT;
+}
+
+uint32_t memstat_stack_peak(void) {
+    const uint32_t *p = (const uint32_t *)__stack_bottom;
+    const uint32_t *top = (const uint32_t *)__stack_top;
+
+    if (!stack_painted()) return 0;
+
+    // Stack grows down: the first unpainted word from the bottom is the
+    // deepest one ever written
+    while (p < top && *p == MEMSTAT_PAINT) p++;
+    return (uint32_t)((const char *)top - (const char *)p);
+}
+
+void memstat_get(memstat_t *m) {
+    char *brk = _sbrk(0);
+
+    m->stack_size = (uint32_t)(__stack_top - __stack_bottom);
+    m->stack_painted = stack_painted();
+    m->stack_peak = memstat_stack_peak();
+    m->stack_overflow = m->stack_painted && m->stack_peak == m->stack_size;
+    m->heap_size = (uint32_t)(__heap_end - __heap_start);
+    m->heap_used = (uint32_t)(brk - __heap_start);
+    m->heap_peak = (uint32_t)(sbrk_peak - __heap_start);
+    m->sbrk_calls = sbrk_calls;
+    m->sbrk_fails = sbrk_fails;
+    m->allocs_tracked = __wrap_malloc != 0;
+    m->mallocs = memstat_mallocs;
+    m->frees = memstat_frees;
+    m->reallocs = memstat_reallocs;
+    m->alloc_fails = memstat_alloc_fails;
+    m->guard_bytes = guard_bytes;
+    m->guard_hits = guard_hits;
+    m->guard_pc = guard_pc;
+    m->guard_addr = guard_addr;
+}
+
+static uint32_t pct(uint32_t part, uint32_t whole) {
+    return whole ? (uint32_t)((uint64_t)part * 100 / whole) : 0;
+}
+
+void memstat_print(void) {
+    memstat_t m;
+
+    memstat_get(&m);
+
+    printf("\r\n=== Memory Usage ===\r\n");
+    printf("Heap:   0x%08X - 0x%08X  %6u bytes\r\n",
+           (unsigned int)__heap_start, (unsigned int)__heap_end, (unsigned int)m.heap_size);
+    printf("  now   %6u bytes (%u%%)\r\n", (unsigned int)m.heap_used, (unsigned int)pct(m.heap_used, m.heap_size));
+    printf("  peak  %6u bytes (%u%%)\r\n", (unsigned int)m.heap_peak, (unsigned int)pct(m.heap_peak, m.heap_size));
+    printf("  _sbrk %u calls, %u refused\r\n", (unsigned int)m.sbrk_calls, (unsigned int)m.sbrk_fails);
+    if (m.allocs_tracked) {
+        printf("  malloc %u  free %u  realloc %u  failed %u  live %d\r\n",
+               (unsigned int)m.mallocs, (unsigned int)m.frees, (unsigned int)m.reallocs,
+               (unsigned int)m.alloc_fails, (int)(m.mallocs - m.frees));
+    } else {
+        printf("  malloc/free counts: build with MEMSTAT=1\r\n");
+    }
+
+    printf("Stack:  0x%08X - 0x%08X  %6u bytes\r\n",
+           (unsigned int)__stack_bottom, (unsigned int)__stack_top, (unsigned int)m.stack_size);
+    if (m.stack_painted) {
+        printf("  peak  %6u bytes (%u%%)%s\r\n", (unsigned int)m.stack_peak,
+               (unsigned int)pct(m.stack_peak, m.stack_size),
+               m.stack_overflow ? "  ** OVERFLOW **" : "");
+        printf("  never touched: %u bytes\r\n", (unsigned int)(m.stack_size - m.stack_peak));
+    } else {
+        printf("  peak: stack not painted, build with MEMSTAT=1\r\n");
+    }
+
+    if (m.guard_bytes) {
+        printf("Guard:  %u bytes, %u hit(s)", (unsigned int)m.guard_bytes, (unsigned int)m.guard_hits);
+        if (m.guard_hits)
+            printf(", first at pc 0x%08X addr 0x%08X", (unsigned int)m.guard_pc, (unsigned int)m.guard_addr);
+        printf("\r\n");
+    }
+
+    printf("@@MEMSTAT heap_size=%u heap_used=%u heap_peak=%u sbrk_calls=%u sbrk_fails=%u"
+           " mallocs=%u frees=%u stack_size=%u stack_peak=%u painted=%u guard_hits=%u\r\n",
+           (unsigned int)m.heap_size, (unsigned int)m.heap_used, (unsigned int)m.heap_peak,
+           (unsigned int)m.sbrk_calls, (unsigned int)m.sbrk_fails,
+           (unsigned int)m.mallocs, (unsigned int)m.frees,
+           (unsigned int)m.stack_size, (unsigned int)m.stack_peak,
+           (unsigned int)m.stack_painted, (unsigned int)m.guard_hits);
+}
+
+//==============================================================================
+// Guard checker (timer IRQ context: no printf, direct UART only)
+//==============================================================================
+
+static void guard_puthex(uint32_t v) {
+    for (int i = 28; i >= 0; i -= 4)
+        uart_putc("0123456789abcdef"[(v >> i) & 0xF]);
+}
+
+void memstat_guard_enable(uint32_t bytes) {
+    uint32_t size = (uint32_t)(__stack_top - __stack_bottom);
+
+    if (bytes == 0) bytes = MEMSTAT_GUARD_BYTES;
+    if (bytes > size) bytes = size;
+    guard_hits = 0;
+    guard_pc = 0;
+    guard_addr = 0;
+    guard_bytes = bytes & ~3u;
+}
+
+void memstat_guard_disable(void) {
+    guard_bytes = 0;
+}
+
+int memstat_guard_irq(uint32_t irqs, uint32_t pc) {
+    uint32_t lo = (uint32_t)__stack_bottom;
+    uint32_t hi = lo + guard_bytes;
+    uint32_t sp, addr = 0;
+
+    if (!(irqs & 1) || guard_bytes == 0) return 0;
+
+    // The handler runs on the interrupted stack, so its own sp is at most
+    // a frame below the application's
+    __asm__ volatile ("mv %0, sp" : "=r"(sp));
+    if (sp < hi) {
+        addr = sp;
+    } else if (stack_painted()) {
+        // Scan from the top of the band down: a deep excursion that has
+        // already returned still leaves its highest dirty word here
+        for (uint32_t a = hi; a > lo; a -= 4) {
+            if (*(volatile uint32_t *)(a - 4) != MEMSTAT_PAINT) {
+                addr = a - 4;
+                break;
+            }
+        }
+    }
+    if (addr == 0) return 0;
+
+    if (guard_hits++) return 0;             // Report only the first one
+    guard_pc = pc & ~1u;
+    guard_addr = addr;
+
+    uart_puts("\r\n*** MEMSTAT: stack guard hit at 0x");
+    guard_puthex(addr);
+    uart_puts(" (band 0x");
+    guard_puthex(lo);
+    uart_puts("-0x");
+    guard_puthex(hi);
+    uart_puts(") pc=0x");
+    guard_puthex(guard_pc);
+    uart_puts(" ***\r\n");
+    return 1;
+}
@@ -0,0 +1,97 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// memstat.h - Stack/Heap High-Water Marks and Stack Guard Checker
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Reports how much of the linker.ld memory layout a firmware really uses:
+//
+//   heap  : __heap_start .. __heap_end    (_sbrk break, after .bss)
+//   stack : __stack_bottom .. __stack_top (STACK region, grows down)
+//
+// Build with 'make TARGET=<name> USE_NEWLIB=1 MEMSTAT=1'. That does three
+// things:
+//   - start.S paints the whole STACK region with MEMSTAT_PAINT before main(),
+//     so the deepest stack use is the lowest word no longer painted
+//   - malloc/free/calloc/realloc are linked through memstat_wrap.c
+//     (-Wl,--wrap), which counts the calls the application makes
+//   - the objects go to a -memstat build directory
+// The _sbrk break, its peak and the call/refusal counts come from
+// lib/syscalls.c and are available in every newlib build. Without MEMSTAT=1
+// the stack and allocation fields read 0 and memstat_print() says so.
+//
+// The guard checker watches the lowest 'bytes' of the STACK region (the end
+// nearest the heap) from the timer interrupt the application already runs:
+//
+//   void irq_handler(uint32_t irqs, uint32_t pc) {
+//       memstat_guard_irq(irqs, pc);
+//       if ((irqs & 1) && (TIMER_SR & TIMER_SR_UIF))
+//           timer_ms_irq_handler();
+//   }
+//
+//   memstat_guard_enable(0);   // default band, MEMSTAT_GUARD_BYTES
+//   ...
+//   memstat_print();           // table plus one @@MEMSTAT line
+//
+// The first hit is printed straight to the UART with the interrupted PC and
+// latched; later ticks do nothing until memstat_guard_enable() re-arms it.
+//
+//==============================================================================
+
+#ifndef MEMSTAT_H
+#define MEMSTAT_H
+
+#include <stdint.h>
+
+// Stack paint word (start.S writes the same value)
+#define MEMSTAT_PAINT        0xDEADBEEFu
+
+// Default guard band at the bottom of the stack region (bytes)
+#define MEMSTAT_GUARD_BYTES  1024
+
+typedef struct {
+    uint32_t stack_size;        // Bytes in the STACK region
+    uint32_t stack_peak;        // Deepest stack use since reset (bytes)
+    uint32_t stack_painted;     // 1 if start.S painted the stack (MEMSTAT=1)
+    uint32_t stack_overflow;    // 1 if the lowest stack word was overwritten
+    uint32_t heap_size;         // Bytes between __heap_start and __heap_end
+    uint32_t heap_used;         // Current _sbrk break - __heap_start
+    uint32_t heap_peak;         // Highest break - __heap_start
+    uint32_t sbrk_calls;        // _sbrk calls (malloc growing the arena)
+    uint32_t sbrk_fails;        // _sbrk calls refused with ENOMEM
+    uint32_t allocs_tracked;    // 1 if malloc/free are counted (MEMSTAT=1)
+    uint32_t mallocs;           // malloc/calloc calls that returned memory
+    uint32_t frees;             // free calls with a non-NULL pointer
+    uint32_t reallocs;          // realloc calls
+    uint32_t alloc_fails;       // malloc/calloc/realloc calls returning NULL
+    uint32_t guard_bytes;       // Armed guard band (0 = checker off)
+    uint32_t guard_hits;        // Guard violations seen (latched after the first)
+    uint32_t guard_pc;          // Interrupted PC of the first violation
+    uint32_t guard_addr;        // Stack pointer or dirty guard word at that time
+} memstat_t;
+
+// Fill 'm' with the current figures (scans the painted stack region)
+void memstat_get(memstat_t *m);
+
+// Print the figures as a table plus a '@@MEMSTAT key=value ...' line
+void memstat_print(void);
+
+// Deepest stack use in bytes (0 if the stack was not painted)
+uint32_t memstat_stack_peak(void);
+
+// Arm the guard checker over the lowest 'bytes' of the stack region
+// (0 = MEMSTAT_GUARD_BYTES); clears a latched violation
+void memstat_guard_enable(uint32_t bytes);
+void memstat_guard_disable(void);
+
+// Call from irq_handler with the IRQ bitmask and interrupted PC that start.S
+// passes. Checks on irq 0 only and never clears the timer. Returns 1 when
+// this tick found a new violation.
+int memstat_guard_irq(uint32_t irqs, uint32_t pc);
+
+#endif // MEMSTAT_H
@@ -0,0 +1,56 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// memstat_wrap.c - malloc/free Call Counting (MEMSTAT=1 --wrap link)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Only linked when the firmware Makefile passes
+// -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc (MEMSTAT=1):
+// the wrapped references are what pull this object out of libmemstat.a.
+// Calls newlib makes internally (_malloc_r from stdio) are not counted.
+//
+//==============================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+
+void *__real_malloc(size_t size);
+void __real_free(void *ptr);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+extern volatile uint32_t memstat_mallocs;
+extern volatile uint32_t memstat_frees;
+extern volatile uint32_t memstat_reallocs;
+extern volatile uint32_t memstat_alloc_fails;
+
+void *__wrap_malloc(size_t size) {
+    void *p = __real_malloc(size);
+    if (p) memstat_mallocs++;
+    else memstat_alloc_fails++;
+    return p;
+}
+
+void __wrap_free(void *ptr) {
+    if (ptr) memstat_frees++;
+    __real_free(ptr);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+    void *p = __real_calloc(n, size);
+    if (p) memstat_mallocs++;
+    else memstat_alloc_fails++;
+    return p;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    void *p = __real_realloc(ptr, size);
+    memstat_reallocs++;
+    if (!p && size) memstat_alloc_fails++;
+    return p;
+}
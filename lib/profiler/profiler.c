@@ -0,0 +1,134 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// profiler.c - Timer-IRQ PC Sampling Profiler
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "profiler.h"
+#include "../hal/hal.h"
+
+// Stack region from linker.ld: frame pointers outside it end the walk
+extern char __heap_end[];
+extern char __stack_top[];
+
+// Sample record: [depth] [pc] [ret0] ... [ret(depth-1)]
+static uint32_t prof_buf[PROF_BUF_WORDS];
+static volatile uint32_t prof_used;
+static volatile uint32_t prof_count;
+static volatile uint32_t prof_lost;
+static volatile uint32_t prof_interval;
+static volatile int prof_running;
+
+void prof_start(uint32_t interval) {
+    uint32_t old;
+
+    if (interval < PROF_MIN_INTERVAL) interval = PROF_MIN_INTERVAL;
+    prof_used = 0;
+    prof_count = 0;
+    prof_lost = 0;
+    prof_interval = interval;
+    prof_running = 1;
+
+    cpu_timer(interval);
+    old = irq_setmask(0);                   // Read current mask...
+    irq_setmask(old & ~1u);                 // ...and unmask irq 0
+}
+
+void prof_stop(void) {
+    prof_running = 0;
+    cpu_timer(0);
+}
+
+int prof_irq(uint32_t irqs, uint32_t pc, uint32_t fp) {
+    uint32_t left;
+    uint32_t lo = (uint32_t)__heap_end;
+    uint32_t hi = (uint32_t)__stack_top;
+    uint32_t depth = 0;
+    uint32_t *rec;
+
+    if (!(irqs & 1) || !prof_running) return 0;
+
+    // The timer reads 0 once it has fired; anything else means irq 0 came
+    // from the timer peripheral, so put the remaining count back
+    left = cpu_timer(prof_interval);
+    if (left != 0) {
+        cpu_timer(left);
+        return 0;
+    }
+
+    if (prof_used + 2 + PROF_MAX_DEPTH > PROF_BUF_WORDS) {
+        prof_lost++;
+        return 1;
+    }
+
+    rec = &prof_buf[prof_used];
+    rec[1] = pc & ~1u;                      // q0 bit 0 flags a compressed insn
+
+    // Frame layout with -fno-omit-frame-pointer: ra at fp-4, caller fp at fp-8
+    while (depth < PROF_MAX_DEPTH && fp > lo && fp <= hi && !(fp & 3)) {
+        uint32_t ra = ((uint32_t *)fp)[-1];
+        uint32_t next = ((uint32_t *)fp)[-2];
+        if (ra == 0) break;
+        rec[2 + depth++] = ra;
+        if (next <= fp) break;              // Stack grows down: callers are higher
+        fp = next;
+    }
+
+    rec[0] = depth;
+    prof_used += 2 + depth;
+    prof_count++;
+    return 1;
+}
+
+static void prof_puthex(uint32_t v) {
+    for (int i = 28; i >= 0; i -= 4)
+        uart_putc("0123456789abcdef"[(v >> i) & 0xF]);
+}
+
+static void prof_putdec(uint32_t v) {
+    char buf[11];
+    int n = 0;
+    do { buf[n++] = '0' + v % 10; v /= 10; } while (v);
+    while (n) uart_putc(buf[--n]);
+}
+
+void prof_dump(void) {
+    uint32_t i = 0;
+
+    prof_stop();
+
+    uart_puts("\r\n@@PROF BEGIN source=hw interval=");
+    prof_putdec(prof_interval);
+    uart_puts(" samples=");
+    prof_putdec(prof_count);
+    uart_puts(" dropped=");
+    prof_putdec(prof_lost);
+    uart_puts("\r\n");
+
+    while (i < prof_used) {
+        uint32_t depth = prof_buf[i];
+        uart_puts("S 1 ");
+        prof_puthex(prof_buf[i + 1]);
+        for (uint32_t k = 0; k < depth; k++) {
+            uart_putc(' ');
+            prof_puthex(prof_buf[i + 2 + k]);
+        }
+        uart_puts("\r\n");
+        i += 2 + depth;
+    }
+
+    uart_puts("@@PROF END\r\n");
+}
+
+uint32_t prof_samples(void) {
+    return prof_count;
+}
+
+uint32_t prof_dropped(void) {
+    return prof_lost;
+}
@@ -0,0 +1,73 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// profiler.h - Timer-IRQ PC Sampling Profiler
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Samples the interrupted PC and a frame-pointer call stack from the
+// PicoRV32 internal timer interrupt (the 'timer' custom instruction), so the
+// timer peripheral stays free for the application. Samples are buffered in
+// RAM and streamed over UART by prof_dump() in the text format read by
+// tools/profile/rvprof.py (the same format rvsim --profile writes).
+//
+// Build with 'make TARGET=<name> PROFILE=1' - this adds
+// -fno-omit-frame-pointer -mno-omit-leaf-frame-pointer so every function
+// keeps ra at fp-4 and the caller's fp at fp-8.
+//
+// The PicoRV32 internal timer and the timer peripheral share irq[0]; start.S
+// passes the interrupted PC (q0) and s0 to irq_handler as extra arguments:
+//
+//   void irq_handler(uint32_t irqs, uint32_t pc, uint32_t fp) {
+//       prof_irq(irqs, pc, fp);
+//       if ((irqs & 1) && (TIMER_SR & TIMER_SR_UIF))
+//           timer_ms_irq_handler();
+//   }
+//
+//   prof_start(50000);     // 1 kHz at 50 MHz
+//   run_workload();
+//   prof_dump();           // "@@PROF BEGIN ... @@PROF END" on the UART
+//
+//==============================================================================
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+// Sample buffer size in words (each sample takes 2 + stack depth words)
+#ifndef PROF_BUF_WORDS
+#define PROF_BUF_WORDS      8192
+#endif
+
+// Maximum return addresses recorded per sample
+#ifndef PROF_MAX_DEPTH
+#define PROF_MAX_DEPTH      16
+#endif
+
+// Shortest sampling interval accepted (cycles); the handler itself takes
+// several hundred cycles from SRAM
+#define PROF_MIN_INTERVAL   2000
+
+// Start sampling every 'interval' CPU cycles (clears the buffer, unmasks irq 0)
+void prof_start(uint32_t interval);
+
+// Stop sampling (buffer is kept)
+void prof_stop(void);
+
+// Call from irq_handler with the arguments start.S passes. Returns 1 if
+// this interrupt was a profiler tick.
+int prof_irq(uint32_t irqs, uint32_t pc, uint32_t fp);
+
+// Stop sampling and stream all samples over the UART
+void prof_dump(void);
+
+// Number of samples recorded / dropped because the buffer was full
+uint32_t prof_samples(void);
+uint32_t prof_dropped(void);
+
+#endif // PROFILER_H
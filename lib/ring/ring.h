@@ -0,0 +1,188 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// ring.h - Lock-Free Single-Producer/Single-Consumer Ring Buffers
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Moves data between an interrupt handler and the main loop (either
+// direction) without masking interrupts: one side only ever writes `head`,
+// the other only `tail`. Header-only; RING_DEFINE generates a ring type and
+// its functions for one element type and power-of-two capacity, so element
+// size, index mask and copy loops are all compile-time constants.
+//
+//   RING_DEFINE(rx_ring, uint8_t, 256)           // rx_ring_t, rx_ring_push(), ...
+//   static rx_ring_t rx;
+//
+//   void irq_handler(uint32_t irqs) {            // producer
+//       uint8_t c = UART_RX_DATA;
+//       if (!rx_ring_push(&rx, &c)) overruns++;
+//   }
+//
+//   uint8_t *p;                                  // consumer, zero-copy
+//   uint32_t n = rx_ring_read_span(&rx, &p);     // contiguous bytes at p
+//   parse(p, n);
+//   rx_ring_read_commit(&rx, n);
+//
+// Functions, for RING_DEFINE(name, type, capacity):
+//
+//   name_init(r)                     empty the ring (no other side active)
+//   name_count(r) / name_space(r)    elements queued / free slots
+//   name_push(r, &v) / name_pop(r, &v)          one element, 0 if full/empty
+//   name_push_n(r, src, n) / name_pop_n(r, dst, n)
+//                                    up to n elements, returns the number moved
+//   name_write_span(r, &p) / name_write_commit(r, n)
+//   name_read_span(r, &p)  / name_read_commit(r, n)
+//                                    zero-copy: the span is the contiguous
+//                                    run up to the end of the buffer; commit
+//                                    at most the returned count
+//
+// head and tail run freely and wrap at 2^32; count = head - tail. Capacity
+// must be a power of two up to 2^31. The producer functions (push*, write_*)
+// belong to one context and the consumer functions (pop*, read_*) to
+// another; count and space may be read from either.
+//
+//==============================================================================
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdint.h>
+
+// Orders element accesses against the index store that publishes them.
+// PicoRV32 is one in-order core without a cache, so only the compiler must
+// be stopped from moving them; the host test runs the two sides as threads.
+#if defined(__riscv)
+#define RING_ACQUIRE()  __asm__ volatile ("" ::: "memory")
+#define RING_RELEASE()  __asm__ volatile ("" ::: "memory")
+#else
+#define RING_ACQUIRE()  __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define RING_RELEASE()  __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
+
+#define RING_DEFINE(name, type, capacity)                                       \
+                                                                                \
+_Static_assert((capacity) >= 2 && (capacity) <= 0x80000000u &&                  \
+               ((capacity) & ((capacity) - 1)) == 0,                            \
+               #name ": capacity must be a power of two");                      \
+                                                                                \
+typedef struct {                                                                \
+    volatile uint32_t head;             /* Written by the producer only */      \
+    volatile uint32_t tail;             /* Written by the consumer only */      \
+    type buf[capacity];                                                         \
+} name##_t;                                                                     \
+                                                                                \
+static inline void name##_init(name##_t *r) {                                   \
+    r->head = 0;                                                                \
+    r->tail = 0;                                                                \
+}                                                                               \
+                                                                                \
+static inline uint32_t name##_count(const name##_t *r) {                        \
+    return r->head - r->tail;                                                   \
+}                                                                               \
+                                                                                \
+static inline uint32_t name##_space(const name##_t *r) {                        \
+    return (capacity) - (r->head - r->tail);                                    \
+}                                                                               \
+                                                                                \
+/* Producer */                                                                  \
+                                                                                \
+static inline uint32_t name##_write_span(name##_t *r, type **span) {            \
+    uint32_t head = r->head;                                                    \
+    uint32_t room = (capacity) - (head - r->tail);                              \
+    uint32_t to_end = (capacity) - (head & ((capacity) - 1));                   \
+    RING_ACQUIRE();                     /* Slots are free once tail moved */    \
+    *span = &r->buf[head & ((capacity) - 1)];                                   \
+    return room < to_end ? room : to_end;                                       \
+}                                                                               \
+                                                                                \
+static inline void name##_write_commit(name##_t *r, uint32_t n) {               \
+    RING_RELEASE();                     /* Elements before the index */         \
+    r->head = r->head + n;                                                      \
+}                                                                               \
+                                                                                \
+static inline int name##_push(name##_t *r, const type *v) {                     \
+    uint32_t head = r->head;                                                    \
+    if (head - r->tail == (capacity)) {                                         \
+        return 0;                                                               \
+    }                                                                           \
+    RING_ACQUIRE();                                                             \
+    r->buf[head & ((capacity) - 1)] = *v;                                       \
+    RING_RELEASE();                                                             \
+    r->head = head + 1;                                                         \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+static inline uint32_t name##_push_n(name##_t *r, const type *src, uint32_t n) { \
+    uint32_t done = 0;                                                          \
+    while (done < n) {                  /* At most two spans (wrap) */          \
+        type *p;                                                                \
+        uint32_t k = name##_write_span(r, &p);                                  \
+        if (k == 0) {                                                           \
+            break;                                                              \
+        }                                                                       \
+        if (k > n - done) {                                                     \
+            k = n - done;                                                       \
+        }                                                                       \
+        for (uint32_t i = 0; i < k; i++) {                                      \
+            p[i] = src[done + i];                                               \
+        }                                                                       \
+        name##_write_commit(r, k);                                              \
+        done += k;                                                              \
+    }                                                                           \
+    return done;                                                                \
+}                                                                               \
+                                                                                \
+/* Consumer */                                                                  \
+                                                                                \
+static inline uint32_t name##_read_span(name##_t *r, type **span) {             \
+    uint32_t tail = r->tail;                                                    \
+    uint32_t used = r->head - tail;                                             \
+    uint32_t to_end = (capacity) - (tail & ((capacity) - 1));                   \
+    RING_ACQUIRE();                     /* Elements after the index */          \
+    *span = &r->buf[tail & ((capacity) - 1)];                                   \
+    return used < to_end ? used : to_end;                                       \
+}                                                                               \
+                                                                                \
+static inline void name##_read_commit(name##_t *r, uint32_t n) {                \
+    RING_RELEASE();                     /* Done reading before freeing */       \
+    r->tail = r->tail + n;                                                      \
+}                                                                               \
+                                                                                \
+static inline int name##_pop(name##_t *r, type *v) {                            \
+    uint32_t tail = r->tail;                                                    \
+    if (r->head == tail) {                                                      \
+        return 0;                                                               \
+    }                                                                           \
+    RING_ACQUIRE();                                                             \
+    *v = r->buf[tail & ((capacity) - 1)];                                       \
+    RING_RELEASE();                                                             \
+    r->tail = tail + 1;                                                         \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+static inline uint32_t name##_pop_n(name##_t *r, type *dst, uint32_t n) {       \
+    uint32_t done = 0;                                                          \
+    while (done < n) {                                                          \
+        type *p;                                                                \
+        uint32_t k = name##_read_span(r, &p);                                   \
+        if (k == 0) {                                                           \
+            break;                                                              \
+        }                                                                       \
+        if (k > n - done) {                                                     \
+            k = n - done;                                                       \
+        }                                                                       \
+        for (uint32_t i = 0; i < k; i++) {                                      \
+            dst[done + i] = p[i];                                               \
+        }                                                                       \
+        name##_read_commit(r, k);                                               \
+        done += k;                                                              \
+    }                                                                           \
+    return done;                                                                \
+}
+
+#endif // RING_H
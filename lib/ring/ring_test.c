@@ -0,0 +1,311 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// ring_test.c - lib/ring Host Test (indexing, spans, two-thread stress)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Single-threaded checks of full/empty, ordering, spans at the buffer end,
+// batches split across the wrap and free-running indices wrapping at 2^32.
+// Then a producer and a consumer thread each mix single, batch and span
+// calls on one small ring; the consumer checks it sees an unbroken sequence.
+//
+// Usage: ring_test [items]
+//
+//==============================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "ring.h"
+
+RING_DEFINE(ring8, uint32_t, 8)
+RING_DEFINE(stress, uint32_t, 64)
+
+typedef struct {
+    uint16_t id;
+    uint8_t flags;
+    uint32_t value;
+} event_t;
+
+RING_DEFINE(evq, event_t, 4)
+
+static int failures;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+//==============================================================================
+// Single Thread
+//==============================================================================
+
+static void test_fill_empty(void) {
+    ring8_t r;
+    uint32_t v;
+
+    ring8_init(&r);
+    CHECK(ring8_count(&r) == 0 && ring8_space(&r) == 8, "new ring not empty");
+    CHECK(!ring8_pop(&r, &v), "pop from an empty ring");
+
+    for (uint32_t i = 0; i < 8; i++) {
+        CHECK(ring8_push(&r, &i), "push %u of 8", i);
+    }
+    v = 99;
+    CHECK(!ring8_push(&r, &v), "push into a full ring");
+    CHECK(ring8_count(&r) == 8 && ring8_space(&r) == 0, "full ring count %u", ring8_count(&r));
+
+    for (uint32_t i = 0; i < 8; i++) {
+        CHECK(ring8_pop(&r, &v) && v == i, "pop %u returned %u", i, v);
+    }
+    CHECK(!ring8_pop(&r, &v), "pop after draining");
+}
+
+static void test_spans(void) {
+    ring8_t r;
+    uint32_t *p;
+    uint32_t v;
+
+    // Move the indices to 6 so the free run ends two slots later
+    ring8_init(&r);
+    for (uint32_t i = 0; i < 6; i++) {
+        ring8_push(&r, &i);
+        ring8_pop(&r, &v);
+    }
+
+    uint32_t n = ring8_write_span(&r, &p);
+    CHECK(n == 2 && p == &r.buf[6], "write span %u at slot %d", n, (int)(p - r.buf));
+    p[0] = 100;
+    p[1] = 101;
+    ring8_write_commit(&r, 2);
+
+    n = ring8_write_span(&r, &p);
+    CHECK(n == 6 && p == &r.buf[0], "write span after wrap %u", n);
+    for (uint32_t i = 0; i < 3; i++) {
+        p[i] = 102 + i;
+    }
+    ring8_write_commit(&r, 3);
+
+    n = ring8_read_span(&r, &p);
+    CHECK(n == 2 && p[0] == 100 && p[1] == 101, "read span %u up to the end", n);
+    ring8_read_commit(&r, 1);                       // Partial commit
+    n = ring8_read_span(&r, &p);
+    CHECK(n == 1 && p[0] == 101, "read span after partial commit %u", n);
+    ring8_read_commit(&r, 1);
+    n = ring8_read_span(&r, &p);
+    CHECK(n == 3 && p[0] == 102 && p[2] == 104, "read span after wrap %u", n);
+    ring8_read_commit(&r, n);
+
+    n = ring8_read_span(&r, &p);
+    CHECK(n == 0, "read span of an empty ring %u", n);
+}
+
+static void test_batches(void) {
+    ring8_t r;
+    uint32_t src[12], dst[12];
+    uint32_t v;
+
+    for (uint32_t i = 0; i < 12; i++) {
+        src[i] = 1000 + i;
+    }
+
+    ring8_init(&r);
+    for (uint32_t i = 0; i < 5; i++) {
+        ring8_push(&r, &i);
+        ring8_pop(&r, &v);
+    }
+
+    // 5 + 7 crosses the buffer end; only 8 fit
+    uint32_t n = ring8_push_n(&r, src, 12);
+    CHECK(n == 8, "push_n into 8 free slots moved %u", n);
+    n = ring8_push_n(&r, src, 1);
+    CHECK(n == 0, "push_n into a full ring moved %u", n);
+
+    n = ring8_pop_n(&r, dst, 3);
+    CHECK(n == 3 && dst[0] == 1000 && dst[2] == 1002, "pop_n 3 moved %u", n);
+    n = ring8_pop_n(&r, dst, 12);
+    CHECK(n == 5 && dst[0] == 1003 && dst[4] == 1007, "pop_n rest moved %u", n);
+    n = ring8_pop_n(&r, dst, 12);
+    CHECK(n == 0, "pop_n from an empty ring moved %u", n);
+}
+
+static void test_index_wrap(void) {
+    ring8_t r;
+    uint32_t v = 99;
+
+    // Indices just below 2^32: count and space must survive the wrap
+    ring8_init(&r);
+    r.head = r.tail = 0xFFFFFFFCu;
+    for (uint32_t i = 0; i < 8; i++) {
+        CHECK(ring8_push(&r, &i), "push %u across the index wrap", i);
+    }
+    CHECK(r.head == 4 && ring8_count(&r) == 8 && ring8_space(&r) == 0,
+          "count %u after the index wrap", ring8_count(&r));
+    CHECK(!ring8_push(&r, &v), "push into a full ring across the index wrap");
+    for (uint32_t i = 0; i < 8; i++) {
+        CHECK(ring8_pop(&r, &v) && v == i, "pop %u across the index wrap returned %u", i, v);
+    }
+    CHECK(ring8_count(&r) == 0, "count %u after draining", ring8_count(&r));
+}
+
+static void test_struct_elements(void) {
+    evq_t q;
+    event_t e = { 7, 0x5A, 0xDEADBEEF };
+    event_t out;
+
+    evq_init(&q);
+    CHECK(evq_push(&q, &e), "push a struct element");
+    CHECK(evq_pop(&q, &out) && out.id == 7 && out.flags == 0x5A && out.value == 0xDEADBEEF,
+          "struct element came back changed");
+}
+
+//==============================================================================
+// Two Threads
+//
+// A side that finds the ring full or empty yields, so the test also makes
+// progress on a single CPU.
+//==============================================================================
+
+static stress_t shared;
+static uint32_t stress_items;
+
+static void *producer(void *arg) {
+    uint32_t seq = 0;
+    uint32_t round = 0;
+    uint32_t batch[16];
+
+    (void)arg;
+    while (seq < stress_items) {
+        uint32_t left = stress_items - seq;
+        uint32_t before = seq;
+        switch (round++ % 3) {
+            case 0:
+                if (stress_push(&shared, &seq)) {
+                    seq++;
+                }
+                break;
+
+            case 1: {
+                uint32_t n = left < 16 ? left : 1 + round % 16;
+                for (uint32_t i = 0; i < n; i++) {
+                    batch[i] = seq + i;
+                }
+                seq += stress_push_n(&shared, batch, n);
+                break;
+            }
+
+            default: {
+                uint32_t *p;
+                uint32_t n = stress_write_span(&shared, &p);
+                if (n > left) {
+                    n = left;
+                }
+                for (uint32_t i = 0; i < n; i++) {
+                    p[i] = seq + i;
+                }
+                stress_write_commit(&shared, n);
+                seq += n;
+                break;
+            }
+        }
+        if (seq == before) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg) {
+    uint32_t expect = 0;
+    uint32_t round = 0;
+    uint32_t batch[16];
+    uint32_t *errors = arg;
+
+    while (expect < stress_items) {
+        uint32_t before = expect;
+        uint32_t v;
+        switch (round++ % 3) {
+            case 0:
+                if (stress_pop(&shared, &v)) {
+                    *errors += v != expect;
+                    expect++;
+                }
+                break;
+
+            case 1: {
+                uint32_t n = stress_pop_n(&shared, batch, 1 + round % 16);
+                for (uint32_t i = 0; i < n; i++) {
+                    *errors += batch[i] != expect + i;
+                }
+                expect += n;
+                break;
+            }
+
+            default: {
+                uint32_t *p;
+                uint32_t n = stress_read_span(&shared, &p);
+                for (uint32_t i = 0; i < n; i++) {
+                    *errors += p[i] != expect + i;
+                }
+                stress_read_commit(&shared, n);
+                expect += n;
+                break;
+            }
+        }
+        if (expect == before) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void test_threads(uint32_t items) {
+    pthread_t prod, cons;
+    uint32_t errors = 0;
+
+    stress_init(&shared);
+    shared.head = shared.tail = 0xFFFFF000u;        // Index wrap partway
+    stress_items = items;
+
+    pthread_create(&cons, NULL, consumer, &errors);
+    pthread_create(&prod, NULL, producer, NULL);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+
+    CHECK(errors == 0, "%u of %u items out of sequence", errors, items);
+    CHECK(stress_count(&shared) == 0, "%u items left over", stress_count(&shared));
+    printf("threads: %u items through a %u-slot ring\n", items, 64);
+}
+
+//==============================================================================
+// Main
+//==============================================================================
+
+int main(int argc, char **argv) {
+    uint32_t items = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 2000000;
+
+    test_fill_empty();
+    test_spans();
+    test_batches();
+    test_index_wrap();
+    test_struct_elements();
+    test_threads(items);
+
+    if (failures) {
+        printf("FAILED: %d check(s)\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -7,32 +7,9 @@
 //===============================================================================
 
 #include "simple_upload.h"
+#include "../crc32/crc32.h"
 #include <string.h>
 
-//===============================================================================
-// CRC32 Calculation (matches bootloader and fw_upload.c)
-//===============================================================================
-
-static uint32_t crc32_table[256];
-static int crc32_initialized = 0;
-
-static void crc32_init(void) {
-    if (crc32_initialized) return;
-
-    for (uint32_t i = 0; i < 256; i++) {
-        uint32_t crc = i;
-        for (int j = 0; j < 8; j++) {
-            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
-        }
-        crc32_table[i] = crc;
-    }
-    crc32_initialized = 1;
-}
-
-static uint32_t crc32_update(uint32_t crc, uint8_t byte) {
-    return (crc >> 8) ^ crc32_table[(crc ^ byte) & 0xFF];
-}
-
 //===============================================================================
 // Receive File (Device acts as bootloader)
 //===============================================================================
@@ -41,18 +18,20 @@ int32_t simple_receive(simple_callbacks_t *callbacks, uint8_t *buffer, uint32_t
     uint32_t packet_size = 0;
     uint32_t bytes_received = 0;
     uint32_t expected_crc;
-    uint32_t calculated_crc = 0xFFFFFFFF;  // CRC32 initial value
+    uint32_t calculated_crc = crc32_init();
     uint8_t ack_char = 'A';
+    uint8_t stream = 0;
 
-    // Initialize CRC32 lookup table
-    crc32_init();
-
-    // Step 1: Wait for 'R' (Ready) command
+    // Step 1: Wait for 'R' (Ready) or 'S' (Stream: no per-chunk ACKs)
     while (1) {
         uint8_t cmd = callbacks->getc();
         if (cmd == 'R' || cmd == 'r') {
             break;
         }
+        if (cmd == 'S' || cmd == 's') {
+            stream = 1;
+            break;
+        }
         // Check for Ctrl-C cancel
         if (cmd == 0x03) {
             return -SIMPLE_ERROR_CANCEL;
@@ -88,20 +67,22 @@ int32_t simple_receive(simple_callbacks_t *callbacks, uint8_t *buffer, uint32_t
             buffer[bytes_received] = byte;
 
             // Update CRC32 incrementally
-            calculated_crc = crc32_update(calculated_crc, byte);
+            calculated_crc = crc32_update_u8(calculated_crc, byte);
 
             bytes_received++;
             chunk_bytes++;
         }
 
         // Send ACK after each chunk (C, D, E, ... Z, then wrap to A)
-        callbacks->putc(ack_char);
-        ack_char++;
-        if (ack_char > 'Z') ack_char = 'A';  // Wrap around
+        if (!stream) {
+            callbacks->putc(ack_char);
+            ack_char++;
+            if (ack_char > 'Z') ack_char = 'A';  // Wrap around
+        }
     }
 
     // Finalize CRC32
-    calculated_crc = ~calculated_crc;
+    calculated_crc = crc32_final(calculated_crc);
 
     // Step 6: Wait for 'C' (CRC command)
     uint8_t crc_cmd = callbacks->getc();
@@ -139,13 +120,10 @@ int32_t simple_receive(simple_callbacks_t *callbacks, uint8_t *buffer, uint32_t
 //===============================================================================
 
 simple_error_t simple_send(simple_callbacks_t *callbacks, const uint8_t *buffer, uint32_t size) {
-    uint32_t calculated_crc = 0xFFFFFFFF;  // CRC32 initial value
+    uint32_t calculated_crc = crc32_init();
     uint8_t expected_ack = 'A';
     uint32_t bytes_sent = 0;
 
-    // Initialize CRC32 lookup table
-    crc32_init();
-
     // Step 1: Send 'R' (Ready) to initiate transfer
     callbacks->putc('R');
 
@@ -179,7 +157,7 @@ simple_error_t simple_send(simple_callbacks_t *callbacks, const uint8_t *buffer,
             callbacks->putc(byte);
 
             // Update CRC32 incrementally
-            calculated_crc = crc32_update(calculated_crc, byte);
+            calculated_crc = crc32_update_u8(calculated_crc, byte);
 
             bytes_sent++;
             chunk_bytes++;
@@ -196,7 +174,7 @@ simple_error_t simple_send(simple_callbacks_t *callbacks, const uint8_t *buffer,
     }
 
     // Finalize CRC32
-    calculated_crc = ~calculated_crc;
+    calculated_crc = crc32_final(calculated_crc);
 
     // Step 6: Send 'C' (CRC command)
     callbacks->putc('C');
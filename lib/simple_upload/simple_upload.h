@@ -17,6 +17,7 @@
 
 #define SIMPLE_CHUNK_SIZE   64      // Data sent in 64-byte chunks
 #define SIMPLE_CMD_READY    'R'     // Host ready to send
+#define SIMPLE_CMD_STREAM   'S'     // Host sends without chunk ACKs (RTS/CTS paced)
 #define SIMPLE_CMD_CRC      'C'     // CRC check command
 
 //===============================================================================
@@ -43,7 +44,7 @@ typedef enum {
 // API Functions
 //===============================================================================
 
-// Receive file from host
+// Receive file from host ('R': ACK per chunk, 'S': stream, final ACK only)
 // Returns number of bytes received on success, negative error code on failure
 int32_t simple_receive(simple_callbacks_t *callbacks, uint8_t *buffer, uint32_t max_size);
 
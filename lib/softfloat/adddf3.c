@@ -0,0 +1,66 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// adddf3.c - Soft-Float Double Precision Add / Subtract
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "sf_common.h"
+
+static uint64_t f64_add(uint64_t a, uint64_t b) {
+    uint64_t aa = a & ~F64_SIGN, ba = b & ~F64_SIGN;
+
+    if (f64_special(aa) || f64_special(ba)) {
+        if (aa > F64_INF || ba > F64_INF) return F64_QNAN;
+        if (aa == F64_INF) return (ba == F64_INF && ((a ^ b) & F64_SIGN)) ? F64_QNAN : a;
+        if (ba == F64_INF) return b;
+        if (!aa) return ba ? b : a & b;         // -0 + -0 = -0, else +0
+        if (!ba) return a;
+        // Subnormals: the normal path below handles them with exp = 1
+    }
+
+    // Larger magnitude first
+    if (ba > aa) {
+        uint64_t t = a; a = b; b = t;
+        t = aa; aa = ba; ba = t;
+    }
+
+    int32_t ea = (int32_t)(aa >> 52), eb = (int32_t)(ba >> 52);
+    uint64_t ma = aa & F64_FRAC, mb = ba & F64_FRAC;
+    if (ea) ma |= F64_IMPLICIT; else ea = 1;
+    if (eb) mb |= F64_IMPLICIT; else eb = 1;
+    ma <<= 3;
+    mb <<= 3;
+
+    uint32_t d = ea - eb;
+    if (d) mb = d < 64 ? (mb >> d) | ((mb << (64 - d)) != 0) : 1;
+
+    if ((a ^ b) & F64_SIGN) {
+        ma -= mb;
+        if (!ma) return 0;                      // x - x = +0
+        if (ma < F64_IMPLICIT << 3) {
+            int sh = clz64(ma) - 8;
+            ma <<= sh;
+            ea -= sh;
+        }
+    } else {
+        ma += mb;
+        if (ma >= F64_IMPLICIT << 4) {
+            ma = (ma >> 1) | (ma & 1);
+            ea++;
+        }
+    }
+    return f64_round_pack(a & F64_SIGN, ea, ma);
+}
+
+double SF_NAME(adddf3)(double a, double b) {
+    return f64_from(f64_add(f64_bits(a), f64_bits(b)));
+}
+
+double SF_NAME(subdf3)(double a, double b) {
+    return f64_from(f64_add(f64_bits(a), f64_bits(b) ^ F64_SIGN));
+}
@@ -0,0 +1,66 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// addsf3.c - Soft-Float Single Precision Add / Subtract
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "sf_common.h"
+
+static uint32_t f32_add(uint32_t a, uint32_t b) {
+    uint32_t aa = a & ~F32_SIGN, ba = b & ~F32_SIGN;
+
+    if (f32_special(aa) || f32_special(ba)) {
+        if (aa > F32_INF || ba > F32_INF) return F32_QNAN;
+        if (aa == F32_INF) return (ba == F32_INF && ((a ^ b) & F32_SIGN)) ? F32_QNAN : a;
+        if (ba == F32_INF) return b;
+        if (!aa) return ba ? b : a & b;         // -0 + -0 = -0, else +0
+        if (!ba) return a;
+        // Subnormals: the normal path below handles them with exp = 1
+    }
+
+    // Larger magnitude first
+    if (ba > aa) {
+        uint32_t t = a; a = b; b = t;
+        t = aa; aa = ba; ba = t;
+    }
+
+    int32_t ea = aa >> 23, eb = ba >> 23;
+    uint32_t ma = aa & F32_FRAC, mb = ba & F32_FRAC;
+    if (ea) ma |= F32_IMPLICIT; else ea = 1;
+    if (eb) mb |= F32_IMPLICIT; else eb = 1;
+    ma <<= 3;
+    mb <<= 3;
+
+    uint32_t d = ea - eb;
+    if (d) mb = d < 32 ? (mb >> d) | ((mb << (32 - d)) != 0) : 1;
+
+    if ((a ^ b) & F32_SIGN) {
+        ma -= mb;
+        if (!ma) return 0;                      // x - x = +0
+        if (ma < F32_IMPLICIT << 3) {
+            int sh = __builtin_clz(ma) - 5;
+            ma <<= sh;
+            ea -= sh;
+        }
+    } else {
+        ma += mb;
+        if (ma >= F32_IMPLICIT << 4) {
+            ma = (ma >> 1) | (ma & 1);
+            ea++;
+        }
+    }
+    return f32_round_pack(a & F32_SIGN, ea, ma);
+}
+
+float SF_NAME(addsf3)(float a, float b) {
+    return f32_from(f32_add(f32_bits(a), f32_bits(b)));
+}
+
+float SF_NAME(subsf3)(float a, float b) {
+    return f32_from(f32_add(f32_bits(a), f32_bits(b) ^ F32_SIGN));
+}
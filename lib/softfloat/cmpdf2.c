@@ -0,0 +1,51 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// cmpdf2.c - Soft-Float Double Precision Comparisons
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "sf_common.h"
+
+// -1, 0, 1, or 'unordered' if either is NaN
+static int f64_cmp(uint64_t a, uint64_t b, int unordered) {
+    uint64_t aa = a & ~F64_SIGN, ba = b & ~F64_SIGN;
+
+    if (aa > F64_INF || ba > F64_INF) return unordered;
+    if (!(aa | ba)) return 0;                   // +0 == -0
+    if ((int64_t)(a & b) < 0)                   // both negative: reversed
+        return a > b ? -1 : a != b;
+    return (int64_t)a < (int64_t)b ? -1 : a != b;
+}
+
+int SF_NAME(eqdf2)(double a, double b) {
+    return f64_cmp(f64_bits(a), f64_bits(b), 1) != 0;
+}
+
+int SF_NAME(nedf2)(double a, double b) {
+    return f64_cmp(f64_bits(a), f64_bits(b), 1) != 0;
+}
+
+int SF_NAME(ltdf2)(double a, double b) {
+    return f64_cmp(f64_bits(a), f64_bits(b), 2);
+}
+
+int SF_NAME(ledf2)(double a, double b) {
+    return f64_cmp(f64_bits(a), f64_bits(b), 2);
+}
+
+int SF_NAME(gtdf2)(double a, double b) {
+    return f64_cmp(f64_bits(a), f64_bits(b), -2);
+}
+
+int SF_NAME(gedf2)(double a, double b) {
+    return f64_cmp(f64_bits(a), f64_bits(b), -2);
+}
+
+int SF_NAME(unorddf2)(double a, double b) {
+    return (f64_bits(a) & ~F64_SIGN) > F64_INF || (f64_bits(b) & ~F64_SIGN) > F64_INF;
+}
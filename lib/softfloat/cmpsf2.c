@@ -0,0 +1,51 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// cmpsf2.c - Soft-Float Single Precision Comparisons
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "sf_common.h"
+
+// -1, 0, 1, or 'unordered' if either is NaN
+static int f32_cmp(uint32_t a, uint32_t b, int unordered) {
+    uint32_t aa = a & ~F32_SIGN, ba = b & ~F32_SIGN;
+
+    if (aa > F32_INF || ba > F32_INF) return unordered;
+    if (!(aa | ba)) return 0;                   // +0 == -0
+    if ((int32_t)(a & b) < 0)                   // both negative: reversed
+        return a > b ? -1 : a != b;
+    return (int32_t)a < (int32_t)b ? -1 : a != b;
+}
+
+int SF_NAME(eqsf2)(float a, float b) {
+    return f32_cmp(f32_bits(a), f32_bits(b), 1) != 0;
+}
+
+int SF_NAME(nesf2)(float a, float b) {
+    return f32_cmp(f32_bits(a), f32_bits(b), 1) != 0;
+}
+
+int SF_NAME(ltsf2)(float a, float b) {
+    return f32_cmp(f32_bits(a), f32_bits(b), 2);
+}
+
+int SF_NAME(lesf2)(float a, float b) {
+    return f32_cmp(f32_bits(a), f32_bits(b), 2);
+}
+
+int SF_NAME(gtsf2)(float a, float b) {
+    return f32_cmp(f32_bits(a), f32_bits(b), -2);
+}
+
+int SF_NAME(gesf2)(float a, float b) {
+    return f32_cmp(f32_bits(a), f32_bits(b), -2);
+}
+
+int SF_NAME(unordsf2)(float a, float b) {
+    return (f32_bits(a) & ~F32_SIGN) > F32_INF || (f32_bits(b) & ~F32_SIGN) > F32_INF;
+}
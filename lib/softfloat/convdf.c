@@ -0,0 +1,91 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// convdf.c - Soft-Float Double Precision Conversions (integer, single)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "sf_common.h"
+
+// Every 32-bit integer is exact in double: no rounding
+static uint64_t f64_from_u32(uint64_t sign, uint32_t m) {
+    if (!m) return sign;
+
+    int top = 31 - __builtin_clz(m);
+    return sign | (((uint64_t)(F64_BIAS + top - 1) << 52) + ((uint64_t)m << (52 - top)));
+}
+
+double SF_NAME(floatsidf)(int32_t i) {
+    return f64_from(i < 0 ? f64_from_u32(F64_SIGN, 0u - (uint32_t)i) : f64_from_u32(0, (uint32_t)i));
+}
+
+double SF_NAME(floatunsidf)(uint32_t i) {
+    return f64_from(f64_from_u32(0, i));
+}
+
+// |a| as an integer, for a biased exponent e in [bias, bias + 31]: only the
+// high word of the significand matters below 2^21
+static inline uint32_t f64_int_part(uint64_t aa, int32_t e) {
+    uint64_t m = (aa & F64_FRAC) | F64_IMPLICIT;
+    int sh = 52 - (e - F64_BIAS);
+    if (sh >= 32) return (uint32_t)(m >> 32) >> (sh - 32);
+    return (uint32_t)(m >> sh);
+}
+
+int32_t SF_NAME(fixdfsi)(double fa) {
+    uint64_t a = f64_bits(fa), aa = a & ~F64_SIGN;
+    int32_t e = (int32_t)(aa >> 52);
+
+    if (e < F64_BIAS) return 0;                 // |a| < 1
+    if (e >= F64_BIAS + 31)                     // overflow, Inf, NaN
+        return (int64_t)a < 0 ? INT32_MIN : INT32_MAX;
+    uint32_t r = f64_int_part(aa, e);
+    return (int64_t)a < 0 ? -(int32_t)r : (int32_t)r;
+}
+
+uint32_t SF_NAME(fixunsdfsi)(double fa) {
+    uint64_t a = f64_bits(fa), aa = a & ~F64_SIGN;
+    int32_t e = (int32_t)(aa >> 52);
+
+    if (e < F64_BIAS || (int64_t)a < 0) return 0;
+    if (e >= F64_BIAS + 32) return UINT32_MAX;  // overflow, +Inf, +NaN
+    return f64_int_part(aa, e);
+}
+
+double SF_NAME(extendsfdf2)(float fa) {
+    uint32_t a = f32_bits(fa), aa = a & ~F32_SIGN;
+    uint64_t sign = (uint64_t)(a & F32_SIGN) << 32;
+
+    // Normal: move the fields into place and rebias the exponent
+    if (!f32_special(aa))
+        return f64_from(sign | (((uint64_t)aa << 29) + ((uint64_t)(F64_BIAS - F32_BIAS) << 52)));
+    if (aa >= F32_INF)                          // Inf; NaN keeps its payload, made quiet
+        return f64_from(sign | F64_INF | ((uint64_t)(aa & F32_FRAC) << 29) |
+                        (aa > F32_INF ? F64_QUIET : 0));
+    if (!aa) return f64_from(sign);
+
+    int32_t e;
+    uint32_t m = f32_normalize(aa, &e);
+    return f64_from(sign | (((uint64_t)(e + F64_BIAS - F32_BIAS - 1) << 52) + ((uint64_t)m << 29)));
+}
+
+float SF_NAME(truncdfsf2)(double fa) {
+    uint64_t a = f64_bits(fa), aa = a & ~F64_SIGN;
+    uint32_t sign = (uint32_t)(a >> 32) & F32_SIGN;
+
+    if (aa >= F64_INF) {                        // Inf; NaN keeps the top of its payload
+        if (aa == F64_INF) return f32_from(sign | F32_INF);
+        return f32_from(sign | F32_INF | F32_QUIET | (uint32_t)((aa & F64_FRAC) >> 29));
+    }
+    int32_t e = (int32_t)(aa >> 52);
+    if (!e) return f32_from(sign);              // double subnormals round to 0
+
+    // 53-bit significand -> implicit bit at 26, sticky from the low 26 bits
+    uint64_t m = (aa & F64_FRAC) | F64_IMPLICIT;
+    uint32_t sig = (uint32_t)(m >> 26) | (((uint32_t)m & 0x3FFFFFF) != 0);
+    return f32_from(f32_round_pack(sign, e - F64_BIAS + F32_BIAS, sig));
+}
@@ -0,0 +1,59 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// convsf.c - Soft-Float Single Precision <-> Integer Conversions
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "sf_common.h"
+
+static uint32_t f32_from_u32(uint32_t sign, uint32_t m) {
+    if (!m) return sign;
+
+    int top = 31 - __builtin_clz(m);
+    if (top <= 23)                              // exact: no rounding
+        return sign | (((uint32_t)(F32_BIAS + top - 1) << 23) + (m << (23 - top)));
+
+    int sh = top - 26;
+    uint32_t sig = sh > 0 ? (m >> sh) | ((m << (32 - sh)) != 0) : m << -sh;
+    return f32_round_pack(sign, F32_BIAS + top, sig);
+}
+
+float SF_NAME(floatsisf)(int32_t i) {
+    return f32_from(i < 0 ? f32_from_u32(F32_SIGN, 0u - (uint32_t)i) : f32_from_u32(0, (uint32_t)i));
+}
+
+float SF_NAME(floatunsisf)(uint32_t i) {
+    return f32_from(f32_from_u32(0, i));
+}
+
+// |a| as an integer, for a biased exponent e in [bias, bias + 31]
+static inline uint32_t f32_int_part(uint32_t aa, int32_t e) {
+    uint32_t m = (aa & F32_FRAC) | F32_IMPLICIT;
+    int sh = e - F32_BIAS - 23;
+    return sh >= 0 ? m << sh : m >> -sh;
+}
+
+int32_t SF_NAME(fixsfsi)(float fa) {
+    uint32_t a = f32_bits(fa), aa = a & ~F32_SIGN;
+    int32_t e = aa >> 23;
+
+    if (e < F32_BIAS) return 0;                 // |a| < 1
+    if (e >= F32_BIAS + 31)                     // overflow, Inf, NaN
+        return (int32_t)a < 0 ? INT32_MIN : INT32_MAX;
+    uint32_t r = f32_int_part(aa, e);
+    return (int32_t)a < 0 ? -(int32_t)r : (int32_t)r;
+}
+
+uint32_t SF_NAME(fixunssfsi)(float fa) {
+    uint32_t a = f32_bits(fa), aa = a & ~F32_SIGN;
+    int32_t e = aa >> 23;
+
+    if (e < F32_BIAS || (int32_t)a < 0) return 0;
+    if (e >= F32_BIAS + 32) return UINT32_MAX;  // overflow, +Inf, +NaN
+    return f32_int_part(aa, e);
+}
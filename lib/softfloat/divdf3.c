@@ -0,0 +1,74 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// divdf3.c - Soft-Float Double Precision Divide
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// The 54-bit quotient is built as two digits (28 + 26 bits). Each digit is
+// estimated from a 29-bit reciprocal of the divisor (never too large), then
+// corrected against the exact remainder, which is computed modulo 2^64 -
+// exact because the true remainder is known to be small. One divu and
+// eleven mul/mulhu in total, against 54 shift-subtract steps.
+//
+//==============================================================================
+
+#include "sf_common.h"
+
+// Low 64 bits of q * m
+static inline uint64_t mul_lo64(uint32_t q, uint64_t m) {
+    return (uint64_t)q * (uint32_t)m + ((uint64_t)(q * (uint32_t)(m >> 32)) << 32);
+}
+
+double SF_NAME(divdf3)(double fa, double fb) {
+    uint64_t a = f64_bits(fa), b = f64_bits(fb);
+    uint64_t sign = (a ^ b) & F64_SIGN;
+    uint64_t aa = a & ~F64_SIGN, ba = b & ~F64_SIGN;
+    int32_t ea = (int32_t)(aa >> 52), eb = (int32_t)(ba >> 52);
+    uint64_t ma = aa & F64_FRAC, mb = ba & F64_FRAC;
+
+    if (f64_special(aa) || f64_special(ba)) {
+        if (aa > F64_INF || ba > F64_INF) return f64_from(F64_QNAN);
+        if (aa == F64_INF) return f64_from(ba == F64_INF ? F64_QNAN : sign | F64_INF);
+        if (ba == F64_INF) return f64_from(sign);
+        if (!aa) return f64_from(ba ? sign : F64_QNAN);
+        if (!ba) return f64_from(sign | F64_INF);
+        if (!ea) ma = f64_normalize(ma, &ea);
+        if (!eb) mb = f64_normalize(mb, &eb);
+    }
+    ma |= F64_IMPLICIT;
+    mb |= F64_IMPLICIT;
+
+    int32_t exp = ea - eb + F64_BIAS;
+    if (ma < mb) {
+        ma <<= 1;
+        exp--;
+    }
+
+    // v ~ 2^84 / mb from the top 32 bits of mb
+    uint32_t v = sf_recip32((uint32_t)(mb >> 21));
+
+    // q1 = floor(ma 2^27 / mb), 28 bits
+    uint32_t q1 = (uint32_t)(((uint64_t)(uint32_t)(ma >> 22) * v) >> 35);
+    uint64_t r = (ma << 27) - mul_lo64(q1, mb);
+    while (r >= mb) {
+        r -= mb;
+        q1++;
+    }
+
+    // q2 = floor(r 2^26 / mb), 26 bits
+    uint32_t q2 = (uint32_t)(((uint64_t)(uint32_t)(r >> 21) * v) >> 37);
+    r = (r << 26) - mul_lo64(q2, mb);
+    while (r >= mb) {
+        r -= mb;
+        q2++;
+    }
+
+    // q in [2^53, 2^54): 53 bits plus the round bit, sticky from r
+    uint64_t q = ((uint64_t)q1 << 26) + q2;
+    return f64_from(f64_round_pack(sign, exp, (q << 2) | (r != 0)));
+}
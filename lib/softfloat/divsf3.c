@@ -0,0 +1,49 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// divsf3.c - Soft-Float Single Precision Divide
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "sf_common.h"
+
+float SF_NAME(divsf3)(float fa, float fb) {
+    uint32_t a = f32_bits(fa), b = f32_bits(fb);
+    uint32_t sign = (a ^ b) & F32_SIGN;
+    uint32_t aa = a & ~F32_SIGN, ba = b & ~F32_SIGN;
+    int32_t ea = aa >> 23, eb = ba >> 23;
+    uint32_t ma = aa & F32_FRAC, mb = ba & F32_FRAC;
+
+    if (f32_special(aa) || f32_special(ba)) {
+        if (aa > F32_INF || ba > F32_INF) return f32_from(F32_QNAN);
+        if (aa == F32_INF) return f32_from(ba == F32_INF ? F32_QNAN : sign | F32_INF);
+        if (ba == F32_INF) return f32_from(sign);
+        if (!aa) return f32_from(ba ? sign : F32_QNAN);
+        if (!ba) return f32_from(sign | F32_INF);
+        if (!ea) ma = f32_normalize(ma, &ea);
+        if (!eb) mb = f32_normalize(mb, &eb);
+    }
+    ma |= F32_IMPLICIT;
+    mb |= F32_IMPLICIT;
+
+    int32_t exp = ea - eb + F32_BIAS;
+    if (ma < mb) {
+        ma <<= 1;
+        exp--;
+    }
+
+    // q = floor(ma 2^24 / mb) in [2^24, 2^25): reciprocal estimate from
+    // below (at most 2 short), then fix up against the exact remainder
+    uint32_t v = sf_recip32(mb << 8);
+    uint32_t q = (uint32_t)(((uint64_t)(ma << 7) * v) >> 38);
+    uint32_t r = (ma << 24) - q * mb;           // exact mod 2^32: r < 3 mb
+    while (r >= mb) {
+        r -= mb;
+        q++;
+    }
+    return f32_from(f32_round_pack(sign, exp, (q << 2) | (r != 0)));
+}
@@ -0,0 +1,57 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// muldf3.c - Soft-Float Double Precision Multiply
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "sf_common.h"
+
+double SF_NAME(muldf3)(double fa, double fb) {
+    uint64_t a = f64_bits(fa), b = f64_bits(fb);
+    uint64_t sign = (a ^ b) & F64_SIGN;
+    uint64_t aa = a & ~F64_SIGN, ba = b & ~F64_SIGN;
+    int32_t ea = (int32_t)(aa >> 52), eb = (int32_t)(ba >> 52);
+    uint64_t ma = aa & F64_FRAC, mb = ba & F64_FRAC;
+
+    if (f64_special(aa) || f64_special(ba)) {
+        if (aa > F64_INF || ba > F64_INF) return f64_from(F64_QNAN);
+        if (aa == F64_INF) return f64_from(ba ? sign | F64_INF : F64_QNAN);
+        if (ba == F64_INF) return f64_from(aa ? sign | F64_INF : F64_QNAN);
+        if (!aa || !ba) return f64_from(sign);
+        if (!ea) ma = f64_normalize(ma, &ea);
+        if (!eb) mb = f64_normalize(mb, &eb);
+    }
+    ma |= F64_IMPLICIT;
+    mb |= F64_IMPLICIT;
+
+    // 106-bit product from 21/32-bit halves (mul + mulhu each). A zero low
+    // word (integers, 0.5, 65536.0, ...) skips its two partial products.
+    uint32_t ah = (uint32_t)(ma >> 32), al = (uint32_t)ma;
+    uint32_t bh = (uint32_t)(mb >> 32), bl = (uint32_t)mb;
+    uint64_t hi = (uint64_t)ah * bh, mid = 0, lo = 0;
+    if (bl) mid = (uint64_t)ah * bl;
+    if (al) {
+        mid += (uint64_t)al * bh;               // < 2^54, no carry out
+        if (bl) lo = (uint64_t)al * bl;
+    }
+    uint64_t t = lo + (mid << 32);
+    hi += (mid >> 32) + (t < lo);
+    lo = t;
+
+    // Product in [2^104, 2^106): keep bits 105..49 with the implicit bit at
+    // 55 or 56, the rest is sticky
+    uint64_t sig = (hi << 15) | (lo >> 49);
+    uint32_t sticky = (lo << 15) != 0;
+    int32_t exp = ea + eb - F64_BIAS;
+    if (sig >> 56) {
+        sticky |= (uint32_t)sig & 1;
+        sig >>= 1;
+        exp++;
+    }
+    return f64_from(f64_round_pack(sign, exp, sig | sticky));
+}
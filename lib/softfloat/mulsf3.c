@@ -0,0 +1,43 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// mulsf3.c - Soft-Float Single Precision Multiply
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "sf_common.h"
+
+float SF_NAME(mulsf3)(float fa, float fb) {
+    uint32_t a = f32_bits(fa), b = f32_bits(fb);
+    uint32_t sign = (a ^ b) & F32_SIGN;
+    uint32_t aa = a & ~F32_SIGN, ba = b & ~F32_SIGN;
+    int32_t ea = aa >> 23, eb = ba >> 23;
+    uint32_t ma = aa & F32_FRAC, mb = ba & F32_FRAC;
+
+    if (f32_special(aa) || f32_special(ba)) {
+        if (aa > F32_INF || ba > F32_INF) return f32_from(F32_QNAN);
+        if (aa == F32_INF) return f32_from(ba ? sign | F32_INF : F32_QNAN);
+        if (ba == F32_INF) return f32_from(aa ? sign | F32_INF : F32_QNAN);
+        if (!aa || !ba) return f32_from(sign);
+        if (!ea) ma = f32_normalize(ma, &ea);
+        if (!eb) mb = f32_normalize(mb, &eb);
+    }
+    ma |= F32_IMPLICIT;
+    mb |= F32_IMPLICIT;
+
+    // [2^46, 2^48): mul + mulhu
+    uint64_t p = (uint64_t)ma * mb;
+    int32_t exp = ea + eb - F32_BIAS;
+    uint32_t sig;
+    if (p >> 47) {
+        sig = (uint32_t)(p >> 21) | (((uint32_t)p & 0x1FFFFF) != 0);
+        exp++;
+    } else {
+        sig = (uint32_t)(p >> 20) | (((uint32_t)p & 0xFFFFF) != 0);
+    }
+    return f32_from(f32_round_pack(sign, exp, sig));
+}
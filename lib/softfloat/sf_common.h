@@ -0,0 +1,119 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// sf_common.h - Soft-Float Internals (bit access, rounding, reciprocal)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Nothing in lib/softfloat may use float or double arithmetic: it would
+// compile into a call to the routine being defined. Values are handled as
+// their IEEE-754 bit patterns only.
+//
+// Working significands carry 3 extra low bits (guard, round, sticky): the
+// implicit bit sits at bit 26 for float and bit 55 for double, and any
+// nonzero bit shifted out is ORed into bit 0.
+//
+//==============================================================================
+
+#ifndef SF_COMMON_H
+#define SF_COMMON_H
+
+#include <stdint.h>
+#include "softfloat.h"
+
+#define F32_SIGN        0x80000000u
+#define F32_INF         0x7F800000u
+#define F32_QNAN        0x7FC00000u             // canonical NaN
+#define F32_QUIET       0x00400000u
+#define F32_FRAC        0x007FFFFFu
+#define F32_IMPLICIT    0x00800000u
+#define F32_BIAS        127
+
+#define F64_SIGN        0x8000000000000000ull
+#define F64_INF         0x7FF0000000000000ull
+#define F64_QNAN        0x7FF8000000000000ull   // canonical NaN
+#define F64_QUIET       0x0008000000000000ull
+#define F64_FRAC        0x000FFFFFFFFFFFFFull
+#define F64_IMPLICIT    0x0010000000000000ull
+#define F64_BIAS        1023
+
+typedef union { float f;  uint32_t u; } sf_f32_t;
+typedef union { double d; uint64_t u; } sf_f64_t;
+
+static inline uint32_t f32_bits(float f)     { sf_f32_t v; v.f = f; return v.u; }
+static inline float    f32_from(uint32_t u)  { sf_f32_t v; v.u = u; return v.f; }
+static inline uint64_t f64_bits(double d)    { sf_f64_t v; v.d = d; return v.u; }
+static inline double   f64_from(uint64_t u)  { sf_f64_t v; v.u = u; return v.d; }
+
+// Zero, subnormal, Inf or NaN: one compare on the biased exponent
+static inline int f32_special(uint32_t abs) {
+    return abs - F32_IMPLICIT >= F32_INF - F32_IMPLICIT;
+}
+
+static inline int f64_special(uint64_t abs) {
+    return (uint32_t)(abs >> 32) - 0x00100000u >= 0x7FF00000u - 0x00100000u;
+}
+
+static inline int clz64(uint64_t v) {
+    uint32_t hi = (uint32_t)(v >> 32);
+    return hi ? __builtin_clz(hi) : 32 + __builtin_clz((uint32_t)v);
+}
+
+// Subnormal significand (no implicit bit, nonzero) -> normalized, *exp set
+static inline uint32_t f32_normalize(uint32_t frac, int32_t *exp) {
+    int sh = __builtin_clz(frac) - 8;
+    *exp = 1 - sh;
+    return frac << sh;
+}
+
+static inline uint64_t f64_normalize(uint64_t frac, int32_t *exp) {
+    int sh = clz64(frac) - 11;
+    *exp = 1 - sh;
+    return frac << sh;
+}
+
+// Round to nearest even and pack. sig has the implicit bit at 26 (or is
+// below it when exp <= 1), exp is biased; handles overflow to Inf and
+// gradual underflow.
+static inline uint32_t f32_round_pack(uint32_t sign, int32_t exp, uint32_t sig) {
+    if (exp >= 0xFF) return sign | F32_INF;
+    if (exp <= 0) {
+        uint32_t sh = 1 - exp;
+        sig = sh < 32 ? (sig >> sh) | ((sig << (32 - sh)) != 0) : (sig != 0);
+        exp = 1;
+    }
+    // (exp - 1) << 23 plus the implicit bit gives the exponent field; a
+    // significand below the implicit bit packs as a subnormal
+    uint32_t r = ((uint32_t)(exp - 1) << 23) + (sig >> 3);
+    uint32_t rb = sig & 7;
+    if (rb > 4 || (rb == 4 && (r & 1))) r++;
+    return sign | r;
+}
+
+static inline uint64_t f64_round_pack(uint64_t sign, int32_t exp, uint64_t sig) {
+    if (exp >= 0x7FF) return sign | F64_INF;
+    if (exp <= 0) {
+        uint32_t sh = 1 - exp;
+        sig = sh < 64 ? (sig >> sh) | ((sig << (64 - sh)) != 0) : (sig != 0);
+        exp = 1;
+    }
+    uint64_t r = ((uint64_t)(exp - 1) << 52) + (sig >> 3);
+    uint32_t rb = (uint32_t)sig & 7;
+    if (rb > 4 || (rb == 4 && (r & 1))) r++;
+    return sign | r;
+}
+
+// Reciprocal of d in [2^31, 2^32): v <= 2^63 / (d + 1), about 29 bits.
+// 15-bit estimate from one divu, then one Newton-Raphson step; every
+// truncation rounds down, so quotient digits built from v never overshoot.
+static inline uint32_t sf_recip32(uint32_t d) {
+    uint32_t v = (0xFFFFFFFFu / ((d >> 16) + 1)) << 15;
+    uint64_t e = ((uint64_t)1 << 63) - ((uint64_t)v * d + v);
+    return v + (uint32_t)(((uint64_t)v * (uint32_t)(e >> 17)) >> 46);
+}
+
+#endif // SF_COMMON_H
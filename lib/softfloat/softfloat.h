@@ -0,0 +1,95 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// softfloat.h - IEEE-754 Soft-Float Runtime for RV32IM (libgcc ABI)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// PicoRV32 has no FPU: GCC turns every float/double operation into a call to
+// a libgcc routine (__adddf3, __muldf3, ...). This library provides the same
+// routines, linked ahead of libgcc, so nothing in the firmware changes:
+//
+//   add/sub/mul/div      __addsf3 __subsf3 __mulsf3 __divsf3
+//                        __adddf3 __subdf3 __muldf3 __divdf3
+//   compare              __eq/__ne/__lt/__le/__gt/__ge/__unord  sf2, df2
+//   convert              __floatsisf __floatunsisf __fixsfsi __fixunssfsi
+//                        __floatsidf __floatunsidf __fixdfsi __fixunsdfsi
+//                        __extendsfdf2 __truncdfsf2
+//
+// Results are bit-identical to libgcc's soft-fp on RISC-V: round to nearest
+// even, gradual underflow, canonical quiet NaN (0x7FC00000 /
+// 0x7FF8000000000000) from arithmetic, NaN payload kept by extend/truncate,
+// float-to-int conversions saturate. No exception flags (there is no fcsr).
+//
+// Where the time goes: the mantissa products use mul/mulhu on 32-bit halves
+// and skip the halves that are zero (integers and short constants), and
+// division starts from a one-divu reciprocal refined by a Newton-Raphson step
+// instead of a bit-per-iteration loop. Zero/Inf/NaN/subnormal operands are
+// rejected with one unsigned compare per operand, so normal operands take
+// the short path. lib/softfloat/softfloat_test.c checks every routine against
+// the host FPU ('make softfloat-test').
+//
+// SOFTFLOAT_HOST_TEST renames the routines to sf_<name> so the host test can
+// call them next to its own (hardware) float operations.
+//
+//==============================================================================
+
+#ifndef SOFTFLOAT_H
+#define SOFTFLOAT_H
+
+#include <stdint.h>
+
+#ifdef SOFTFLOAT_HOST_TEST
+#define SF_NAME(name)   sf_##name
+#else
+#define SF_NAME(name)   __##name
+#endif
+
+// Arithmetic
+float  SF_NAME(addsf3)(float a, float b);
+float  SF_NAME(subsf3)(float a, float b);
+float  SF_NAME(mulsf3)(float a, float b);
+float  SF_NAME(divsf3)(float a, float b);
+double SF_NAME(adddf3)(double a, double b);
+double SF_NAME(subdf3)(double a, double b);
+double SF_NAME(muldf3)(double a, double b);
+double SF_NAME(divdf3)(double a, double b);
+
+// Comparisons (libgcc return values):
+//   eq/ne  0 if equal, 1 otherwise (also unordered)
+//   lt/le  -1, 0, 1; unordered 2
+//   gt/ge  -1, 0, 1; unordered -2
+//   unord  1 if either operand is NaN
+int SF_NAME(eqsf2)(float a, float b);
+int SF_NAME(nesf2)(float a, float b);
+int SF_NAME(ltsf2)(float a, float b);
+int SF_NAME(lesf2)(float a, float b);
+int SF_NAME(gtsf2)(float a, float b);
+int SF_NAME(gesf2)(float a, float b);
+int SF_NAME(unordsf2)(float a, float b);
+int SF_NAME(eqdf2)(double a, double b);
+int SF_NAME(nedf2)(double a, double b);
+int SF_NAME(ltdf2)(double a, double b);
+int SF_NAME(ledf2)(double a, double b);
+int SF_NAME(gtdf2)(double a, double b);
+int SF_NAME(gedf2)(double a, double b);
+int SF_NAME(unorddf2)(double a, double b);
+
+// Conversions (to int: truncate, saturate by sign, NaN by its sign bit;
+// to unsigned: negative -> 0)
+float    SF_NAME(floatsisf)(int32_t i);
+float    SF_NAME(floatunsisf)(uint32_t i);
+int32_t  SF_NAME(fixsfsi)(float a);
+uint32_t SF_NAME(fixunssfsi)(float a);
+double   SF_NAME(floatsidf)(int32_t i);
+double   SF_NAME(floatunsidf)(uint32_t i);
+int32_t  SF_NAME(fixdfsi)(double a);
+uint32_t SF_NAME(fixunsdfsi)(double a);
+double   SF_NAME(extendsfdf2)(float a);
+float    SF_NAME(truncdfsf2)(double a);
+
+#endif // SOFTFLOAT_H
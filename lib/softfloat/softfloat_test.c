@@ -0,0 +1,415 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// softfloat_test.c - Randomized Bit-Exact Test of lib/softfloat (host)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Builds the library for the host (SOFTFLOAT_HOST_TEST, routines renamed to
+// sf_*) and compares every routine with the host FPU, which rounds to
+// nearest even with gradual underflow like the RISC-V soft-fp in libgcc.
+// Where the two differ by design the expected value follows libgcc:
+//
+//   - arithmetic returns the canonical NaN, not the host's propagated payload
+//   - float-to-int saturates by sign (NaN by its sign bit), unsigned clamps
+//     negative values to 0, instead of the host's 0x80000000 "indefinite"
+//
+// Operands are a mix of special values, uniformly random bit patterns and
+// values with close exponents, short significands and ties, so cancellation,
+// rounding carries, subnormal results and the zero-skipping fast paths are
+// all exercised.
+//
+// Usage: softfloat_test [iterations per routine] [seed]
+//
+//==============================================================================
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "softfloat.h"
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rng(void) {
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1Dull;
+}
+
+static uint32_t f2u(float f)    { uint32_t u; memcpy(&u, &f, 4); return u; }
+static float    u2f(uint32_t u) { float f; memcpy(&f, &u, 4); return f; }
+static uint64_t d2u(double d)   { uint64_t u; memcpy(&u, &d, 8); return u; }
+static double   u2d(uint64_t u) { double d; memcpy(&d, &u, 8); return d; }
+
+//==============================================================================
+// Operand generators
+//==============================================================================
+
+static const uint32_t f32_specials[] = {
+    0x00000000, 0x80000000, 0x3F800000, 0xBF800000, 0x7F800000, 0xFF800000,
+    0x7FC00000, 0xFFC00000, 0x7F800001, 0x7FBFFFFF, 0x00000001, 0x80000001,
+    0x007FFFFF, 0x00800000, 0x00800001, 0x7F7FFFFF, 0xFF7FFFFF, 0x3F7FFFFF,
+    0x3F800001, 0x4B000000, 0x4EFFFFFF, 0x4F000000, 0x4F7FFFFF, 0x4F800000,
+    0xCF000000, 0xCF000001, 0x3F000000, 0x33800000, 0x34000000,
+};
+
+static const uint64_t f64_specials[] = {
+    0x0000000000000000ull, 0x8000000000000000ull, 0x3FF0000000000000ull,
+    0xBFF0000000000000ull, 0x7FF0000000000000ull, 0xFFF0000000000000ull,
+    0x7FF8000000000000ull, 0xFFF8000000000000ull, 0x7FF0000000000001ull,
+    0x7FF7FFFFFFFFFFFFull, 0x0000000000000001ull, 0x8000000000000001ull,
+    0x000FFFFFFFFFFFFFull, 0x0010000000000000ull, 0x0010000000000001ull,
+    0x7FEFFFFFFFFFFFFFull, 0xFFEFFFFFFFFFFFFFull, 0x3FEFFFFFFFFFFFFFull,
+    0x3FF0000000000001ull, 0x41DFFFFFFFC00000ull, 0x41E0000000000000ull,
+    0x41EFFFFFFFE00000ull, 0x41F0000000000000ull, 0xC1E0000000000000ull,
+    0xC1E0000000200000ull, 0x3FE0000000000000ull, 0x36A0000000000000ull,
+    0x3690000000000000ull, 0x47EFFFFFE0000000ull, 0x47EFFFFFF0000000ull,
+    0x380FFFFFFFFFFFFFull, 0x3690000000000001ull, 0x40F0000000000000ull,
+};
+
+#define NUM(a) (int)(sizeof(a) / sizeof(a[0]))
+
+// Significand with few set bits (short constants, integers, exact ties)
+static uint64_t short_frac(int bits) {
+    uint64_t f = rng();
+    int keep = (int)(rng() % (unsigned)bits);
+    return keep ? f & ~((1ull << (bits - keep)) - 1) : 0;
+}
+
+static uint32_t gen_f32_exp(int exp) {
+    uint32_t frac = (rng() & 3) ? (uint32_t)rng() : (uint32_t)short_frac(23);
+    return ((uint32_t)rng() & 0x80000000u) | ((uint32_t)exp << 23) | (frac & 0x7FFFFF);
+}
+
+static uint32_t gen_f32(void) {
+    switch (rng() % 8) {
+    case 0:  return f32_specials[rng() % NUM(f32_specials)];
+    case 1:  return (uint32_t)rng();
+    case 2:  return gen_f32_exp((int)(rng() % 8));          // subnormal range
+    case 3:  return gen_f32_exp(254 - (int)(rng() % 8));    // overflow range
+    default: return gen_f32_exp(127 - 40 + (int)(rng() % 80));
+    }
+}
+
+// Second operand: often within a few binades of the first
+static uint32_t gen_f32_near(uint32_t a) {
+    if (rng() % 2) return gen_f32();
+    int exp = (int)((a >> 23) & 0xFF) + (int)(rng() % 61) - 30;
+    if (exp < 0) exp = 0;
+    if (exp > 254) exp = 254;
+    uint32_t b = gen_f32_exp(exp);
+    if (rng() % 4 == 0) b = (b & 0xFF800000u) | ((a & 0x7FFFFF) ^ ((uint32_t)rng() & 0x7));
+    return b;
+}
+
+static uint64_t gen_f64_exp(int exp) {
+    uint64_t frac = (rng() & 3) ? rng() : short_frac(52);
+    return (rng() & 0x8000000000000000ull) | ((uint64_t)exp << 52) | (frac & 0xFFFFFFFFFFFFFull);
+}
+
+static uint64_t gen_f64(void) {
+    switch (rng() % 8) {
+    case 0:  return f64_specials[rng() % NUM(f64_specials)];
+    case 1:  return rng();
+    case 2:  return gen_f64_exp((int)(rng() % 8));
+    case 3:  return gen_f64_exp(2046 - (int)(rng() % 8));
+    default: return gen_f64_exp(1023 - 60 + (int)(rng() % 120));
+    }
+}
+
+static uint64_t gen_f64_near(uint64_t a) {
+    if (rng() % 2) return gen_f64();
+    int exp = (int)((a >> 52) & 0x7FF) + (int)(rng() % 121) - 60;
+    if (exp < 0) exp = 0;
+    if (exp > 2046) exp = 2046;
+    uint64_t b = gen_f64_exp(exp);
+    if (rng() % 4 == 0) b = (b & 0xFFF0000000000000ull) | ((a & 0xFFFFFFFFFFFFFull) ^ (rng() & 0x7));
+    return b;
+}
+
+static uint32_t gen_i32(void) {
+    switch (rng() % 4) {
+    case 0:  return (uint32_t)rng() >> (rng() % 32);
+    case 1:  return (uint32_t)short_frac(32) >> (rng() % 8);
+    default: return (uint32_t)rng();
+    }
+}
+
+//==============================================================================
+// Expected results (host FPU, libgcc rules where they differ)
+//==============================================================================
+
+static uint32_t canon32(float r)  { return isnan(r) ? 0x7FC00000u : f2u(r); }
+static uint64_t canon64(double r) { return isnan(r) ? 0x7FF8000000000000ull : d2u(r); }
+
+static int32_t ref_fix32(double x) {
+    if (isnan(x)) return signbit(x) ? INT32_MIN : INT32_MAX;
+    if (x >= 2147483648.0) return INT32_MAX;
+    if (x <= -2147483648.0) return INT32_MIN;
+    return (int32_t)x;
+}
+
+static uint32_t ref_fixuns32(double x) {
+    if (isnan(x)) return signbit(x) ? 0 : UINT32_MAX;
+    if (x <= -1.0) return 0;
+    if (x >= 4294967296.0) return UINT32_MAX;
+    return x < 1.0 ? 0 : (uint32_t)x;
+}
+
+static int ref_cmp(double a, double b, int unordered) {
+    if (isnan(a) || isnan(b)) return unordered;
+    return a < b ? -1 : a > b;
+}
+
+//==============================================================================
+// Test loop
+//==============================================================================
+
+typedef enum { T_F32, T_F64, T_I32, T_U32 } ty_t;
+
+typedef struct {
+    const char *name;
+    int nargs;
+    ty_t in, out;
+    int (*check)(uint64_t a, uint64_t b, uint64_t *got, uint64_t *exp);
+} test_t;
+
+#define F32_OP2(id, expr)                                                     \
+    static int t_##id(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) { \
+        volatile float a = u2f((uint32_t)ua), b = u2f((uint32_t)ub);          \
+        *got = f2u(sf_##id(a, b));                                            \
+        *exp = canon32(expr);                                                 \
+        return *got == *exp;                                                  \
+    }
+
+#define F64_OP2(id, expr)                                                     \
+    static int t_##id(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) { \
+        volatile double a = u2d(ua), b = u2d(ub);                             \
+        *got = d2u(sf_##id(a, b));                                            \
+        *exp = canon64(expr);                                                 \
+        return *got == *exp;                                                  \
+    }
+
+#define CMP(id, conv, unordered, expr)                                        \
+    static int t_##id(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) { \
+        *got = (uint64_t)(int64_t)sf_##id(conv(ua), conv(ub));                \
+        double a = conv(ua), b = conv(ub);                                    \
+        int c = ref_cmp(a, b, unordered);                                     \
+        (void)c;                                                              \
+        *exp = (uint64_t)(int64_t)(expr);                                     \
+        return *got == *exp;                                                  \
+    }
+
+#define U2F(u) u2f((uint32_t)(u))
+
+F32_OP2(addsf3, a + b)
+F32_OP2(subsf3, a - b)
+F32_OP2(mulsf3, a * b)
+F32_OP2(divsf3, a / b)
+F64_OP2(adddf3, a + b)
+F64_OP2(subdf3, a - b)
+F64_OP2(muldf3, a * b)
+F64_OP2(divdf3, a / b)
+
+CMP(eqsf2, U2F, 1, c != 0)
+CMP(nesf2, U2F, 1, c != 0)
+CMP(ltsf2, U2F, 2, c)
+CMP(lesf2, U2F, 2, c)
+CMP(gtsf2, U2F, -2, c)
+CMP(gesf2, U2F, -2, c)
+CMP(unordsf2, U2F, 1, isnan(a) || isnan(b))
+CMP(eqdf2, u2d, 1, c != 0)
+CMP(nedf2, u2d, 1, c != 0)
+CMP(ltdf2, u2d, 2, c)
+CMP(ledf2, u2d, 2, c)
+CMP(gtdf2, u2d, -2, c)
+CMP(gedf2, u2d, -2, c)
+CMP(unorddf2, u2d, 1, isnan(a) || isnan(b))
+
+static int t_floatsisf(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) {
+    (void)ub;
+    *got = f2u(sf_floatsisf((int32_t)ua));
+    *exp = f2u((float)(int32_t)ua);
+    return *got == *exp;
+}
+
+static int t_floatunsisf(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) {
+    (void)ub;
+    *got = f2u(sf_floatunsisf((uint32_t)ua));
+    *exp = f2u((float)(uint32_t)ua);
+    return *got == *exp;
+}
+
+static int t_floatsidf(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) {
+    (void)ub;
+    *got = d2u(sf_floatsidf((int32_t)ua));
+    *exp = d2u((double)(int32_t)ua);
+    return *got == *exp;
+}
+
+static int t_floatunsidf(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) {
+    (void)ub;
+    *got = d2u(sf_floatunsidf((uint32_t)ua));
+    *exp = d2u((double)(uint32_t)ua);
+    return *got == *exp;
+}
+
+static int t_fixsfsi(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) {
+    (void)ub;
+    *got = (uint32_t)sf_fixsfsi(U2F(ua));
+    *exp = (uint32_t)ref_fix32(U2F(ua));
+    return *got == *exp;
+}
+
+static int t_fixunssfsi(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) {
+    (void)ub;
+    *got = sf_fixunssfsi(U2F(ua));
+    *exp = ref_fixuns32(U2F(ua));
+    return *got == *exp;
+}
+
+static int t_fixdfsi(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) {
+    (void)ub;
+    *got = (uint32_t)sf_fixdfsi(u2d(ua));
+    *exp = (uint32_t)ref_fix32(u2d(ua));
+    return *got == *exp;
+}
+
+static int t_fixunsdfsi(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) {
+    (void)ub;
+    *got = sf_fixunsdfsi(u2d(ua));
+    *exp = ref_fixuns32(u2d(ua));
+    return *got == *exp;
+}
+
+// NaN payloads pass through the conversion on both sides
+static int t_extendsfdf2(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) {
+    (void)ub;
+    *got = d2u(sf_extendsfdf2(U2F(ua)));
+    *exp = d2u((double)(volatile float)U2F(ua));
+    return *got == *exp;
+}
+
+static int t_truncdfsf2(uint64_t ua, uint64_t ub, uint64_t *got, uint64_t *exp) {
+    (void)ub;
+    *got = f2u(sf_truncdfsf2(u2d(ua)));
+    *exp = f2u((float)(volatile double)u2d(ua));
+    return *got == *exp;
+}
+
+static const test_t tests[] = {
+    { "addsf3",      2, T_F32, T_F32, t_addsf3 },
+    { "subsf3",      2, T_F32, T_F32, t_subsf3 },
+    { "mulsf3",      2, T_F32, T_F32, t_mulsf3 },
+    { "divsf3",      2, T_F32, T_F32, t_divsf3 },
+    { "adddf3",      2, T_F64, T_F64, t_adddf3 },
+    { "subdf3",      2, T_F64, T_F64, t_subdf3 },
+    { "muldf3",      2, T_F64, T_F64, t_muldf3 },
+    { "divdf3",      2, T_F64, T_F64, t_divdf3 },
+    { "eqsf2",       2, T_F32, T_I32, t_eqsf2 },
+    { "nesf2",       2, T_F32, T_I32, t_nesf2 },
+    { "ltsf2",       2, T_F32, T_I32, t_ltsf2 },
+    { "lesf2",       2, T_F32, T_I32, t_lesf2 },
+    { "gtsf2",       2, T_F32, T_I32, t_gtsf2 },
+    { "gesf2",       2, T_F32, T_I32, t_gesf2 },
+    { "unordsf2",    2, T_F32, T_I32, t_unordsf2 },
+    { "eqdf2",       2, T_F64, T_I32, t_eqdf2 },
+    { "nedf2",       2, T_F64, T_I32, t_nedf2 },
+    { "ltdf2",       2, T_F64, T_I32, t_ltdf2 },
+    { "ledf2",       2, T_F64, T_I32, t_ledf2 },
+    { "gtdf2",       2, T_F64, T_I32, t_gtdf2 },
+    { "gedf2",       2, T_F64, T_I32, t_gedf2 },
+    { "unorddf2",    2, T_F64, T_I32, t_unorddf2 },
+    { "floatsisf",   1, T_I32, T_F32, t_floatsisf },
+    { "floatunsisf", 1, T_U32, T_F32, t_floatunsisf },
+    { "floatsidf",   1, T_I32, T_F64, t_floatsidf },
+    { "floatunsidf", 1, T_U32, T_F64, t_floatunsidf },
+    { "fixsfsi",     1, T_F32, T_I32, t_fixsfsi },
+    { "fixunssfsi",  1, T_F32, T_U32, t_fixunssfsi },
+    { "fixdfsi",     1, T_F64, T_I32, t_fixdfsi },
+    { "fixunsdfsi",  1, T_F64, T_U32, t_fixunsdfsi },
+    { "extendsfdf2", 1, T_F32, T_F64, t_extendsfdf2 },
+    { "truncdfsf2",  1, T_F64, T_F32, t_truncdfsf2 },
+};
+
+static void print_val(ty_t t, uint64_t v) {
+    switch (t) {
+    case T_F32: printf("%08X (%.9g)", (uint32_t)v, u2f((uint32_t)v)); break;
+    case T_F64: printf("%016llX (%.17g)", (unsigned long long)v, u2d(v)); break;
+    case T_I32: printf("%d", (int32_t)v); break;
+    case T_U32: printf("%u", (uint32_t)v); break;
+    }
+}
+
+// Operand pairs: all special x special, then random
+static void operands(const test_t *t, long i, uint64_t *a, uint64_t *b) {
+    int ns = t->in == T_F32 ? NUM(f32_specials) : NUM(f64_specials);
+    if (t->in == T_F32 && i < (long)ns * ns) {
+        *a = f32_specials[i / ns];
+        *b = f32_specials[i % ns];
+    } else if (t->in == T_F64 && i < (long)ns * ns) {
+        *a = f64_specials[i / ns];
+        *b = f64_specials[i % ns];
+    } else if (t->in == T_F32) {
+        *a = gen_f32();
+        *b = gen_f32_near((uint32_t)*a);
+    } else if (t->in == T_F64) {
+        *a = gen_f64();
+        *b = gen_f64_near(*a);
+    } else {
+        *a = gen_i32();
+        *b = 0;
+    }
+}
+
+int main(int argc, char **argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 1000000;
+    uint64_t seed = argc > 2 ? strtoull(argv[2], NULL, 0) : 0;
+    rng_state ^= seed;
+
+    int failed = 0;
+    printf("lib/softfloat vs. host FPU: %ld operand sets per routine, seed 0x%llX\n",
+           iterations, (unsigned long long)seed);
+
+    for (int n = 0; n < NUM(tests); n++) {
+        const test_t *t = &tests[n];
+        long errors = 0;
+
+        for (long i = 0; i < iterations; i++) {
+            uint64_t a, b, got, exp;
+            operands(t, i, &a, &b);
+            if (t->check(a, b, &got, &exp)) continue;
+            if (errors++ < 5) {
+                printf("  %s(", t->name);
+                print_val(t->in, a);
+                if (t->nargs == 2) {
+                    printf(", ");
+                    print_val(t->in, b);
+                }
+                printf(")\n      got ");
+                print_val(t->out, got);
+                printf("\n      exp ");
+                print_val(t->out, exp);
+                printf("\n");
+            }
+        }
+        if (errors) {
+            printf("✗ %-12s %ld of %ld mismatched\n", t->name, errors, iterations);
+            failed++;
+        } else {
+            printf("✓ %-12s %ld bit-exact\n", t->name, iterations);
+        }
+    }
+
+    printf("%s\n", failed ? "FAIL" : "PASS: all routines bit-exact");
+    return failed ? 1 : 0;
+}
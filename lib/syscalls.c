@@ -20,27 +20,12 @@ struct stat {
 // errno variable
 int errno;
 
-// UART Register Definitions
-#define UART_TX_DATA   (*(volatile unsigned int*)0x80000000)
-#define UART_TX_STATUS (*(volatile unsigned int*)0x80000004)
-#define UART_RX_DATA   (*(volatile unsigned int*)0x80000008)
-#define UART_RX_STATUS (*(volatile unsigned int*)0x8000000C)
+// UART drivers (uart_putc, uart_getc)
+#include "hal/hal.h"
 
-//===============================================================================
-// Low-level UART functions
-//===============================================================================
-
-static void uart_putc(char c) {
-    // Wait for TX ready
-    while (UART_TX_STATUS & 0x01);
-    UART_TX_DATA = c;
-}
-
-static char uart_getc(void) {
-    // Wait for RX data available (bit is 1 when data available)
-    while (!(UART_RX_STATUS & 0x01));
-    return UART_RX_DATA & 0xFF;
-}
+// lib/uartmux, when the firmware links it, carries stdout and stderr on
+// its console channel (weak: plain UART output otherwise)
+void uartmux_stdio_putc(char c) __attribute__((weak));
 
 //===============================================================================
 // Syscall: _write
@@ -58,7 +43,11 @@ int _write(int file, char *ptr, int len) {
 
     // Write each character to UART
     for (int i = 0; i < len; i++) {
-        uart_putc(*ptr++);
+        if (uartmux_stdio_putc) {
+            uartmux_stdio_putc(*ptr++);
+        } else {
+            uart_putc(*ptr++);
+        }
         written++;
     }
 
@@ -153,16 +142,31 @@ extern char __heap_end;    // Defined in linker script
 
 static char *heap_ptr = &__heap_start;
 
+// Heap accounting read by lib/memstat (highest break, calls, refusals)
+char *sbrk_peak = &__heap_start;
+unsigned int sbrk_calls;
+unsigned int sbrk_fails;
+
+// The heap and the stack share one linear SRAM region (linker.ld): the
+// break may grow up to the stack reservation at __heap_end, and never past
+// the live stack pointer should the stack have outgrown its reservation.
 void *_sbrk(int incr) {
     char *prev_heap_ptr = heap_ptr;
+    char *sp;
+
+    sbrk_calls++;
+
+    __asm__ volatile ("mv %0, sp" : "=r"(sp));
 
     // Check if we would exceed heap
-    if (heap_ptr + incr > &__heap_end) {
+    if (heap_ptr + incr > &__heap_end || heap_ptr + incr > sp) {
+        sbrk_fails++;
         errno = ENOMEM;
         return (void *)-1;
     }
 
     heap_ptr += incr;
+    if (heap_ptr > sbrk_peak) sbrk_peak = heap_ptr;
     return (void *)prev_heap_ptr;
 }
 
@@ -190,8 +194,14 @@ int _getpid(void) {
 // Called when program exits
 //===============================================================================
 
+// Resident apps (firmware APP=1 builds) return to the launcher instead;
+// start.S defines __app_exit only in those builds
+void __app_exit(int status) __attribute__((weak, noreturn));
+
 void _exit(int status) {
-    (void)status;
+    if (__app_exit) {
+        __app_exit(status);
+    }
     // Infinite loop - no operating system to return to
     while (1) {
         __asm__ volatile ("wfi");  // Wait for interrupt
@@ -0,0 +1,324 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// trace.c - Timestamped Event Trace Ring (Chrome trace export)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Wire format of trace_dump() (little-endian), between the text lines
+// "@@TRACE BEGIN" and "@@TRACE END":
+//
+//   frame   = A5 5A <type> <len:u16> <payload[len]> <crc32:u32>
+//             crc32 (lib/crc32) over type, len and payload
+//
+//   'H'     version:u8 tick_hz:u32 events:u32 dropped:u32
+//   'N'     id:varint name bytes           (before the first event using id)
+//   'E'     events, each:
+//             flags:u8     bits 0-1 type, bit 2 track (1 = IRQ), bit 3 arg
+//             id:varint    name
+//             dt:varint    ticks since the previous event (mod 2^32)
+//             arg:varint   zigzag-encoded, only with flag bit 3
+//   'Z'     events:u32                     (end of dump)
+//
+// varint = 7 bits per byte, low group first, bit 7 set on all but the last.
+// A typical event takes 3-5 bytes on the wire instead of 16 in the ring.
+//
+//==============================================================================
+
+#include "trace.h"
+#include "../crc32/crc32.h"
+
+#define TRACE_VERSION       1
+#define TRACE_FRAME_MAX     128     // Payload bytes per frame
+
+#ifdef TRACE_HOST_TEST
+// Host test: timer and UART supplied by trace_test.c
+uint32_t trace_host_timer_read(uint32_t reg);
+void trace_host_timer_write(uint32_t reg, uint32_t value);
+void trace_host_putc(uint8_t c);
+#define timer_read(reg)         trace_host_timer_read(reg)
+#define timer_write(reg, v)     trace_host_timer_write(reg, v)
+#define trace_uart_putc         trace_host_putc
+#define TIMER_CR    0x00
+#define TIMER_SR    0x04
+#define TIMER_PSC   0x08
+#define TIMER_ARR   0x0C
+#define TIMER_CNT   0x10
+#else
+// Timer peripheral (hdl/timer_peripheral.v, base 0x80000020)
+#define TIMER_REG(off)  (*(volatile uint32_t *)(0x80000020u + (off)))
+#define TIMER_CR    0x00
+#define TIMER_SR    0x04
+#define TIMER_PSC   0x08
+#define TIMER_ARR   0x0C
+#define TIMER_CNT   0x10
+
+// UART registers (base 0x80000000)
+#define UART_TX_DATA   (*(volatile uint32_t *)0x80000000)
+#define UART_TX_STATUS (*(volatile uint32_t *)0x80000004)
+
+// mmio_peripherals registers the timer's read mux one access late: the
+// first read latches, the second returns the register as of the first
+static inline uint32_t timer_read(uint32_t off) {
+    (void)TIMER_REG(off);
+    return TIMER_REG(off);
+}
+
+static inline void timer_write(uint32_t off, uint32_t value) {
+    TIMER_REG(off) = value;
+}
+
+static void trace_uart_putc(uint8_t c) {
+    while (UART_TX_STATUS & 1);
+    UART_TX_DATA = c;
+}
+#endif
+
+// Dump output, the UART unless trace_set_output() chose another byte sink
+static void (*trace_putc)(uint8_t c) = trace_uart_putc;
+
+#define TIMER_CR_ENABLE 0x1u
+#define TIMER_SR_UIF    0x1u
+
+typedef struct {
+    trace_rec_t *rec;
+    uint32_t mask;
+    volatile uint32_t head;     // Events ever written (slot = head & mask)
+    uint32_t tail;              // Oldest event still to dump
+} trace_ring_t;
+
+static trace_rec_t trace_main_buf[TRACE_RING_MAIN];
+static trace_rec_t trace_irq_buf[TRACE_RING_IRQ];
+
+static trace_ring_t trace_rings[2] = {
+    { trace_main_buf, TRACE_RING_MAIN - 1, 0, 0 },
+    { trace_irq_buf,  TRACE_RING_IRQ - 1,  0, 0 },
+};
+
+static volatile uint32_t trace_track;   // Ring of the running context
+static volatile int trace_on;
+static uint32_t trace_period;           // ARR + 1, 0 when free-running
+static volatile uint32_t trace_base;    // Ticks at the start of the period
+static uint32_t trace_arr;
+static uint32_t trace_hz;
+
+void trace_init(void) {
+    trace_on = 0;
+
+    if (timer_read(TIMER_CR) & TIMER_CR_ENABLE) {
+        // The application's periodic timer: extend it with its IRQ
+        trace_arr = timer_read(TIMER_ARR);
+        trace_period = trace_arr + 1;
+        trace_hz = TRACE_CPU_HZ / (timer_read(TIMER_PSC) + 1);
+    } else {
+        // Nobody uses the timer: run it free at the CPU clock
+        timer_write(TIMER_CR, 0);
+        timer_write(TIMER_PSC, 0);
+        timer_write(TIMER_ARR, 0xFFFFFFFFu);
+        timer_write(TIMER_SR, TIMER_SR_UIF);
+        timer_write(TIMER_CR, TIMER_CR_ENABLE);
+        trace_arr = 0xFFFFFFFFu;
+        trace_period = 0;
+        trace_hz = TRACE_CPU_HZ;
+    }
+
+    trace_base = 0;
+    trace_track = TRACE_TRACK_MAIN;
+    for (int i = 0; i < 2; i++) {
+        trace_rings[i].head = 0;
+        trace_rings[i].tail = 0;
+    }
+    trace_on = 1;
+}
+
+void trace_timer_irq(void) {
+    trace_base += trace_period;
+}
+
+uint32_t trace_now(void) {
+    uint32_t base, cnt, pending;
+
+    // An IRQ between the base and counter reads moves the base: retry
+    do {
+        base = trace_base;
+        cnt = timer_read(TIMER_CNT);
+        pending = 0;
+
+        // Wrapped but the IRQ has not run yet (masked, or this is the
+        // handler before TRACE_TIMER_IRQ): count the finished period
+        if (trace_period && (timer_read(TIMER_SR) & TIMER_SR_UIF)) {
+            cnt = timer_read(TIMER_CNT);
+            pending = trace_period;
+        }
+    } while (base != trace_base);
+
+    return base + pending + (trace_arr - cnt);
+}
+
+void trace_set_output(void (*putc)(uint8_t c)) {
+    trace_putc = putc ? putc : trace_uart_putc;
+}
+
+uint32_t trace_tick_hz(void) {
+    return trace_hz;
+}
+
+static void trace_put(uint32_t track, uint32_t type, const char *name, int32_t arg) {
+    trace_ring_t *ring = &trace_rings[track];
+    uint32_t head = ring->head;
+    trace_rec_t *r = &ring->rec[head & ring->mask];
+
+    r->time = trace_now();
+    r->name = name;
+    r->arg = arg;
+    r->type = (uint8_t)type;
+    ring->head = head + 1;      // Publish after the record is complete
+}
+
+void trace_event(uint32_t type, const char *name, int32_t arg) {
+    if (trace_on) trace_put(trace_track, type, name, arg);
+}
+
+void trace_irq_enter(const char *name) {
+    trace_track = TRACE_TRACK_IRQ;
+    if (trace_on) trace_put(TRACE_TRACK_IRQ, TRACE_EV_BEGIN, name, 0);
+}
+
+void trace_irq_exit(const char *name) {
+    if (trace_on) trace_put(TRACE_TRACK_IRQ, TRACE_EV_END, name, 0);
+    trace_track = TRACE_TRACK_MAIN;
+}
+
+static uint32_t ring_lost(const trace_ring_t *ring) {
+    uint32_t n = ring->head - ring->tail;
+    return n > ring->mask + 1 ? n - (ring->mask + 1) : 0;
+}
+
+uint32_t trace_dropped(void) {
+    return ring_lost(&trace_rings[0]) + ring_lost(&trace_rings[1]);
+}
+
+//==============================================================================
+// Dump
+//==============================================================================
+
+static uint8_t frame_buf[TRACE_FRAME_MAX];
+static uint32_t frame_len;
+
+static void frame_send(uint8_t type, const uint8_t *payload, uint32_t len) {
+    uint8_t hdr[3] = { type, (uint8_t)len, (uint8_t)(len >> 8) };
+    uint32_t crc = crc32_update_byte(crc32_init(), hdr, 3);
+    crc = crc32_final(crc32_update_byte(crc, payload, len));
+
+    trace_putc(0xA5);
+    trace_putc(0x5A);
+    for (int i = 0; i < 3; i++) trace_putc(hdr[i]);
+    for (uint32_t i = 0; i < len; i++) trace_putc(payload[i]);
+    for (int i = 0; i < 32; i += 8) trace_putc((uint8_t)(crc >> i));
+}
+
+static uint32_t put_u32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+    return 4;
+}
+
+static uint32_t put_varint(uint8_t *p, uint32_t v) {
+    uint32_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static void trace_puts(const char *s) {
+    while (*s) trace_putc((uint8_t)*s++);
+}
+
+void trace_dump(void) {
+    const char *names[TRACE_MAX_NAMES];
+    uint32_t num_names = 0;
+    uint32_t idx[2], end[2];
+    uint32_t count = 0, prev = 0;
+    uint8_t buf[16];
+
+    trace_on = 0;
+
+    // Oldest surviving event of each ring
+    for (int i = 0; i < 2; i++) {
+        trace_ring_t *ring = &trace_rings[i];
+        end[i] = ring->head;
+        idx[i] = ring->tail + ring_lost(ring);
+        count += end[i] - idx[i];
+    }
+
+    trace_puts("\r\n@@TRACE BEGIN\r\n");
+
+    uint32_t n = 0;
+    buf[n++] = TRACE_VERSION;
+    n += put_u32(buf + n, trace_hz);
+    n += put_u32(buf + n, count);
+    n += put_u32(buf + n, trace_dropped());
+    frame_send('H', buf, n);
+
+    frame_len = 0;
+    while (idx[0] != end[0] || idx[1] != end[1]) {
+        const trace_rec_t *r0 = idx[0] != end[0] ? &trace_rings[0].rec[idx[0] & trace_rings[0].mask] : 0;
+        const trace_rec_t *r1 = idx[1] != end[1] ? &trace_rings[1].rec[idx[1] & trace_rings[1].mask] : 0;
+
+        // Merge in time order (wrap-safe compare)
+        int track = !r0 || (r1 && (int32_t)(r1->time - r0->time) < 0);
+        const trace_rec_t *r = track ? r1 : r0;
+        idx[track]++;
+
+        // Name id, announcing new names in their own frame first
+        uint32_t id = 0;
+        while (id < num_names && names[id] != r->name) id++;
+        if (id == num_names) {
+            if (frame_len) {
+                frame_send('E', frame_buf, frame_len);
+                frame_len = 0;
+            }
+            if (num_names < TRACE_MAX_NAMES) {
+                names[num_names++] = r->name;
+            } else {
+                id = TRACE_MAX_NAMES - 1;   // Reuse the last slot
+                names[id] = r->name;
+            }
+            uint32_t len = put_varint(frame_buf, id);
+            for (const char *s = r->name; *s && len < TRACE_FRAME_MAX; s++) {
+                frame_buf[len++] = (uint8_t)*s;
+            }
+            frame_send('N', frame_buf, len);
+        }
+
+        // Encode the event, flushing the frame when it could overflow
+        if (frame_len + 1 + 5 + 5 + 5 > TRACE_FRAME_MAX) {
+            frame_send('E', frame_buf, frame_len);
+            frame_len = 0;
+        }
+        int has_arg = r->arg != 0 || r->type == TRACE_EV_COUNTER;
+        uint32_t zz = ((uint32_t)r->arg << 1) ^ (uint32_t)(r->arg >> 31);
+        frame_buf[frame_len++] = (uint8_t)(r->type | (track << 2) | (has_arg << 3));
+        frame_len += put_varint(frame_buf + frame_len, id);
+        frame_len += put_varint(frame_buf + frame_len, r->time - prev);
+        if (has_arg) frame_len += put_varint(frame_buf + frame_len, zz);
+        prev = r->time;
+    }
+    if (frame_len) frame_send('E', frame_buf, frame_len);
+
+    put_u32(buf, count);
+    frame_send('Z', buf, 4);
+    trace_puts("\r\n@@TRACE END\r\n");
+
+    // Start over with empty rings
+    for (int i = 0; i < 2; i++) {
+        trace_rings[i].tail = end[i];
+    }
+    trace_on = 1;
+}
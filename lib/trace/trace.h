@@ -0,0 +1,134 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// trace.h - Timestamped Event Trace Ring (Chrome trace export)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Records begin/end/instant/counter events with a timer timestamp into RAM
+// rings and streams them over the UART in a binary framing that
+// tools/trace/trace2json.py turns into Chrome trace-event JSON (open it in
+// chrome://tracing or ui.perfetto.dev).
+//
+// Build with 'make TARGET=<name> TRACE=1': this defines TRACE_ENABLED and
+// links lib/trace. Without it every TRACE_* macro compiles to nothing.
+//
+//   TRACE_INIT();                      // after the app has started its timer
+//
+//   void irq_handler(uint32_t irqs) {
+//       TRACE_IRQ_ENTER("timer");      // IRQ events go to their own ring
+//       TIMER_SR = TIMER_SR_UIF;
+//       TRACE_TIMER_IRQ();             // extends the timestamp past ARR
+//       ...
+//       TRACE_IRQ_EXIT("timer");
+//   }
+//
+//   TRACE_BEGIN("render");
+//   ...
+//   TRACE_COUNTER("iterations", total);
+//   TRACE_END("render");
+//
+//   TRACE_DUMP();                      // "@@TRACE BEGIN", frames, "@@TRACE END"
+//
+// Timestamps are ticks of the timer peripheral (50 MHz / (PSC + 1), 1 us
+// for the usual PSC = 49): the period base advanced by TRACE_TIMER_IRQ()
+// plus the elapsed part of the current period. If the timer is stopped at
+// TRACE_INIT(), it is started free-running at the CPU clock instead (no IRQ
+// needed; the host unwraps the 32-bit time).
+//
+// Each ring has a single writer - main code or IRQ handlers, which do not
+// nest on PicoRV32 - so recording needs no locking and no interrupt
+// masking. Event calls inside an IRQ handler must therefore sit between
+// TRACE_IRQ_ENTER and TRACE_IRQ_EXIT. The rings keep the most recent
+// events (oldest overwritten); TRACE_DUMP() pauses recording, streams both
+// rings merged in time order, clears them and resumes.
+//
+// Names must be string literals (or other strings that live forever): the
+// ring stores the pointer, the dump sends each distinct string once.
+//
+//==============================================================================
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+// Ring sizes in events (powers of two, 16 bytes per event)
+#ifndef TRACE_RING_MAIN
+#define TRACE_RING_MAIN     256
+#endif
+
+#ifndef TRACE_RING_IRQ
+#define TRACE_RING_IRQ      128
+#endif
+
+// Distinct event names per dump
+#ifndef TRACE_MAX_NAMES
+#define TRACE_MAX_NAMES     64
+#endif
+
+#define TRACE_CPU_HZ        50000000u
+
+// Event types (also the wire encoding)
+#define TRACE_EV_BEGIN      0
+#define TRACE_EV_END        1
+#define TRACE_EV_INSTANT    2
+#define TRACE_EV_COUNTER    3
+
+// Tracks (Chrome trace thread ids)
+#define TRACE_TRACK_MAIN    0
+#define TRACE_TRACK_IRQ     1
+
+typedef struct {
+    uint32_t time;
+    const char *name;
+    int32_t arg;
+    uint8_t type;
+    uint8_t pad[3];
+} trace_rec_t;
+
+void trace_init(void);
+void trace_timer_irq(void);
+void trace_event(uint32_t type, const char *name, int32_t arg);
+void trace_irq_enter(const char *name);
+void trace_irq_exit(const char *name);
+void trace_dump(void);
+
+// Current timestamp in ticks and the tick rate
+uint32_t trace_now(void);
+uint32_t trace_tick_hz(void);
+
+// Events overwritten since the last dump (main + IRQ rings)
+uint32_t trace_dropped(void);
+
+// Send dumps through putc instead of the UART (e.g. a lib/uartmux
+// channel); NULL restores the UART
+void trace_set_output(void (*putc)(uint8_t c));
+
+#ifdef TRACE_ENABLED
+#define TRACE_INIT()                trace_init()
+#define TRACE_TIMER_IRQ()           trace_timer_irq()
+#define TRACE_BEGIN(name)           trace_event(TRACE_EV_BEGIN, (name), 0)
+#define TRACE_END(name)             trace_event(TRACE_EV_END, (name), 0)
+#define TRACE_INSTANT(name, arg)    trace_event(TRACE_EV_INSTANT, (name), (int32_t)(arg))
+#define TRACE_COUNTER(name, value)  trace_event(TRACE_EV_COUNTER, (name), (int32_t)(value))
+#define TRACE_IRQ_ENTER(name)       trace_irq_enter(name)
+#define TRACE_IRQ_EXIT(name)        trace_irq_exit(name)
+#define TRACE_DUMP()                trace_dump()
+#else
+#define TRACE_INIT()                ((void)0)
+#define TRACE_TIMER_IRQ()           ((void)0)
+#define TRACE_BEGIN(name)           ((void)0)
+#define TRACE_END(name)             ((void)0)
+#define TRACE_INSTANT(name, arg)    ((void)0)
+#define TRACE_COUNTER(name, value)  ((void)0)
+#define TRACE_IRQ_ENTER(name)       ((void)0)
+#define TRACE_IRQ_EXIT(name)        ((void)0)
+#define TRACE_DUMP()                ((void)0)
+#endif
+
+#endif // TRACE_H
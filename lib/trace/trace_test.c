@@ -0,0 +1,221 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// trace_test.c - lib/trace Host Test (ring, timestamps, wire format)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Runs lib/trace against a simulated timer peripheral (1 MHz ticks, 1 ms
+// period, down-counting, UIF on reload) and a UART that writes to a file.
+// Main-code events, timer "interrupts" and counters are recorded past the
+// ring sizes, dumped twice with console text around the dumps, and every
+// event is also logged here with its true time. The Makefile decodes the
+// capture with tools/trace/trace2json.py --text and compares it with the
+// events the rings should still hold.
+//
+// Usage: trace_test capture.bin expected.txt
+//
+//==============================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "trace.h"
+
+#define SIM_PSC     49
+#define SIM_ARR     999
+
+typedef struct {
+    uint32_t time;
+    int track;
+    int type;
+    const char *name;
+    int32_t arg;
+    uint32_t seq;
+} expect_t;
+
+#define MAX_LOG     4096
+
+static expect_t log_buf[MAX_LOG];
+static uint32_t log_count;
+
+static uint32_t sim_ticks;          // True time since trace_init
+static uint32_t sim_cnt = SIM_ARR;
+static int sim_uif;
+static FILE *uart;
+
+//==============================================================================
+// Simulated hardware
+//==============================================================================
+
+uint32_t trace_host_timer_read(uint32_t reg) {
+    switch (reg) {
+    case 0x00: return 1;                    // CR: enabled by the "application"
+    case 0x04: return (uint32_t)sim_uif;
+    case 0x08: return SIM_PSC;
+    case 0x0C: return SIM_ARR;
+    case 0x10: return sim_cnt;
+    }
+    return 0;
+}
+
+void trace_host_timer_write(uint32_t reg, uint32_t value) {
+    (void)reg;
+    (void)value;
+}
+
+void trace_host_putc(uint8_t c) {
+    fputc(c, uart);
+}
+
+static void advance(uint32_t ticks) {
+    while (ticks--) {
+        sim_ticks++;
+        if (sim_cnt == 0) {
+            sim_cnt = SIM_ARR;
+            sim_uif = 1;
+        } else {
+            sim_cnt--;
+        }
+    }
+}
+
+//==============================================================================
+// Recording with a reference log
+//==============================================================================
+
+static int current_track;
+
+static void logged(int type, const char *name, int32_t arg) {
+    if (log_count < MAX_LOG) {
+        expect_t *e = &log_buf[log_count];
+        e->time = sim_ticks;
+        e->track = current_track;
+        e->type = type;
+        e->name = name;
+        e->arg = arg;
+        e->seq = log_count;
+        log_count++;
+    }
+}
+
+static void ev(int type, const char *name, int32_t arg) {
+    logged(type, name, arg);
+    trace_event((uint32_t)type, name, arg);
+}
+
+// Timer IRQ in the order the header documents
+static void timer_irq(void) {
+    current_track = TRACE_TRACK_IRQ;
+    logged(TRACE_EV_BEGIN, "timer", 0);
+    trace_irq_enter("timer");
+    sim_uif = 0;
+    trace_timer_irq();
+    advance(3);
+    ev(TRACE_EV_INSTANT, "tick", (int32_t)(sim_ticks / 1000));
+    advance(2);
+    logged(TRACE_EV_END, "timer", 0);
+    trace_irq_exit("timer");
+    current_track = TRACE_TRACK_MAIN;
+}
+
+// Advance time, taking the timer IRQ whenever UIF is set
+static void run(uint32_t ticks) {
+    while (ticks--) {
+        advance(1);
+        if (sim_uif) timer_irq();
+    }
+}
+
+//==============================================================================
+// Expected content of one dump
+//==============================================================================
+
+static int cmp_expect(const void *a, const void *b) {
+    const expect_t *x = a, *y = b;
+    if (x->time != y->time) return x->time < y->time ? -1 : 1;
+    if (x->track != y->track) return x->track - y->track;
+    return x->seq < y->seq ? -1 : 1;
+}
+
+static void write_expected(FILE *f) {
+    static expect_t keep[MAX_LOG];
+    uint32_t n = 0;
+    uint32_t room[2] = { TRACE_RING_MAIN, TRACE_RING_IRQ };
+    static const char *types[] = { "B", "E", "i", "C" };
+    static const char *tracks[] = { "main", "irq" };
+
+    // The newest events of each track survive
+    for (int32_t i = (int32_t)log_count - 1; i >= 0; i--) {
+        if (room[log_buf[i].track]) {
+            room[log_buf[i].track]--;
+            keep[n++] = log_buf[i];
+        }
+    }
+    qsort(keep, n, sizeof(keep[0]), cmp_expect);
+
+    for (uint32_t i = 0; i < n; i++) {
+        const expect_t *e = &keep[i];
+        int has_arg = e->arg != 0 || e->type == TRACE_EV_COUNTER;
+        fprintf(f, "%u %s %s %s", e->time, tracks[e->track], types[e->type], e->name);
+        if (has_arg) fprintf(f, " %d", e->arg);
+        fprintf(f, "\n");
+    }
+    log_count = 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: trace_test capture.bin expected.txt\n");
+        return 2;
+    }
+    uart = fopen(argv[1], "wb");
+    FILE *exp = fopen(argv[2], "w");
+    if (!uart || !exp) {
+        perror("trace_test");
+        return 2;
+    }
+
+    trace_init();
+    if (trace_tick_hz() != 1000000) {
+        fprintf(stderr, "FAIL: tick rate %u, expected 1000000\n", trace_tick_hz());
+        return 1;
+    }
+
+    // Dump 1: more main events than the ring holds, IRQs every 1000 ticks
+    fputs("console text before the first dump\r\n", uart);
+    for (int frame = 0; frame < 200; frame++) {
+        ev(TRACE_EV_BEGIN, "render", 0);
+        run(370);
+        ev(TRACE_EV_COUNTER, "iterations", frame * 1000 - 150000);
+        run(10);
+        ev(TRACE_EV_END, "render", 0);
+        run(frame % 7 * 90 + 3);
+    }
+    if (trace_dropped() == 0) {
+        fprintf(stderr, "FAIL: ring did not overflow\n");
+        return 1;
+    }
+    write_expected(exp);
+    trace_dump();
+
+    // Dump 2: few events after the rings were cleared; a long gap makes
+    // the first delta a multi-byte varint
+    fputs("more console text\r\n", uart);
+    run(123457);
+    ev(TRACE_EV_INSTANT, "key", 'q');
+    ev(TRACE_EV_INSTANT, "plain", 0);
+    ev(TRACE_EV_COUNTER, "zero", 0);
+    write_expected(exp);
+    trace_dump();
+    fputs("after\r\n", uart);
+
+    fclose(uart);
+    fclose(exp);
+    return 0;
+}
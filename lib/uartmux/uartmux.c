@@ -0,0 +1,439 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// uartmux.c - Framed Logical Channels over the One UART
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Wire format (both directions, little-endian):
+//
+//   frame   = C0 <body, C0 sent as DB DC and DB as DB DD> C0     (SLIP)
+//   body    = hdr:u8 payload crc32:u32     crc32 (lib/crc32) of hdr+payload
+//   hdr     = type << 4 | channel
+//
+//   type 0  DATA    1..UARTMUX_MTU bytes of the channel's stream
+//   type 1  CREDIT  consumed:u16 - the receiver freed that much buffer,
+//                   the sender may send as many more bytes
+//   type 2  HELLO   version:u8 channels:u8 window:u16 per channel
+//                   host: attach, windows = its receive space per channel
+//                   device: reply, windows = UARTMUX_RX_* buffers
+//   type 3  BYE     host: detach, back to plain mode
+//
+// A sender starts with the peer's HELLO windows as credit and sends no DATA
+// beyond it, so a channel whose reader stalls (a telemetry log nobody reads,
+// an upload buffer the firmware is not draining) stops only that channel.
+//
+// 0xC0 never occurs in ASCII or UTF-8 terminal input, so in plain mode it
+// can only be the start of a host frame. Bytes outside frames in framed
+// mode mean a plain terminal has taken the port over: fall back to plain.
+//
+//==============================================================================
+
+#include "uartmux.h"
+#include "../crc32/crc32.h"
+
+#define UARTMUX_VERSION     1
+
+#define SLIP_END            0xC0
+#define SLIP_ESC            0xDB
+#define SLIP_ESC_END        0xDC
+#define SLIP_ESC_ESC        0xDD
+
+#define TYPE_DATA           0
+#define TYPE_CREDIT         1
+#define TYPE_HELLO          2
+#define TYPE_BYE            3
+
+#ifdef UARTMUX_HOST_TEST
+// Host test: UART supplied by uartmux_test.c
+int uartmux_host_rx_ready(void);
+uint8_t uartmux_host_rx_read(void);
+int uartmux_host_tx_busy(void);
+void uartmux_host_tx_write(uint8_t c);
+#define uart_rx_ready()     uartmux_host_rx_ready()
+#define uart_rx_read()      uartmux_host_rx_read()
+#define uart_tx_busy()      uartmux_host_tx_busy()
+#define uart_tx_write(c)    uartmux_host_tx_write(c)
+#else
+#include "../hal/hal.h"
+#define uart_rx_ready()     uart_getc_available()
+#define uart_rx_read()      ((uint8_t)UART_RX_DATA)
+#define uart_tx_write(c)    (UART_TX_DATA = (c))
+#endif
+
+typedef struct {
+    uint8_t *rx;                // Receive ring
+    uint16_t rx_size;
+    uint16_t rx_head;           // Free-running indexes
+    uint16_t rx_tail;
+    uint16_t rx_unacked;        // Consumed, not yet returned as credit
+    uint32_t tx_credit;         // Bytes the host has room for
+    uint8_t tx_len;
+    uint8_t tx[UARTMUX_MTU];    // Output not yet framed
+} mux_chan_t;
+
+static uint8_t rx_console[UARTMUX_RX_CONSOLE];
+static uint8_t rx_data[UARTMUX_RX_DATA];
+static uint8_t rx_telemetry[UARTMUX_RX_TELEMETRY];
+static uint8_t rx_trace[UARTMUX_RX_TRACE];
+
+static mux_chan_t chans[UARTMUX_CHANNELS] = {
+    { rx_console,   UARTMUX_RX_CONSOLE,   0, 0, 0, 0, 0, {0} },
+    { rx_data,      UARTMUX_RX_DATA,      0, 0, 0, 0, 0, {0} },
+    { rx_telemetry, UARTMUX_RX_TELEMETRY, 0, 0, 0, 0, 0, {0} },
+    { rx_trace,     UARTMUX_RX_TRACE,     0, 0, 0, 0, 0, {0} },
+};
+
+static int framed;
+static int hello_pending;           // Reply owed to the host's HELLO
+static uartmux_stats_t stats;
+
+// Frame parser
+static uint8_t rx_body[1 + UARTMUX_MTU + 4];
+static uint32_t rx_len;
+static int rx_in_frame;
+static int rx_esc;
+
+//==============================================================================
+// Receive
+//==============================================================================
+
+static uint32_t rx_count(const mux_chan_t *c) {
+    return (uint16_t)(c->rx_head - c->rx_tail);
+}
+
+static void rx_put(mux_chan_t *c, uint8_t b) {
+    if (rx_count(c) >= c->rx_size) {
+        stats.rx_overflow++;
+        return;
+    }
+    c->rx[c->rx_head & (c->rx_size - 1)] = b;
+    c->rx_head++;
+}
+
+static void chan_reset(mux_chan_t *c) {
+    c->rx_head = c->rx_tail = 0;
+    c->rx_unacked = 0;
+    c->tx_len = 0;
+    c->tx_credit = 0;
+}
+
+static void frame_received(void) {
+    if (rx_len < 5) {
+        stats.rx_errors++;
+        return;
+    }
+    uint32_t len = rx_len - 4;
+    uint32_t crc = (uint32_t)rx_body[len] | ((uint32_t)rx_body[len + 1] << 8) |
+                   ((uint32_t)rx_body[len + 2] << 16) | ((uint32_t)rx_body[len + 3] << 24);
+    if (crc32_final(crc32_update_byte(crc32_init(), rx_body, len)) != crc) {
+        stats.rx_errors++;
+        return;
+    }
+
+    uint32_t type = rx_body[0] >> 4;
+    uint32_t ch = rx_body[0] & 0x0F;
+    const uint8_t *p = rx_body + 1;
+    len--;
+
+    if (type == TYPE_HELLO && len >= 2 && p[0] == UARTMUX_VERSION) {
+        // (Re)attach: fresh credits both ways, input of the old session dropped
+        uint32_t n = p[1] < UARTMUX_CHANNELS ? p[1] : UARTMUX_CHANNELS;
+        for (uint32_t i = 0; i < UARTMUX_CHANNELS; i++) {
+            uint8_t keep = chans[i].tx_len;
+            chan_reset(&chans[i]);
+            chans[i].tx_len = keep;         // Output still goes out, framed
+            if (i < n && len >= 2 + 2 * (i + 1)) {
+                chans[i].tx_credit = p[2 + 2 * i] | (p[3 + 2 * i] << 8);
+            }
+        }
+        framed = 1;
+        hello_pending = 1;
+    } else if (!framed || ch >= UARTMUX_CHANNELS) {
+        stats.rx_errors++;
+        return;
+    } else if (type == TYPE_DATA) {
+        for (uint32_t i = 0; i < len; i++) rx_put(&chans[ch], p[i]);
+    } else if (type == TYPE_CREDIT && len == 2) {
+        chans[ch].tx_credit += p[0] | (p[1] << 8);
+    } else if (type == TYPE_BYE) {
+        framed = 0;
+    } else {
+        stats.rx_errors++;
+        return;
+    }
+    stats.rx_frames++;
+}
+
+static void rx_byte(uint8_t b) {
+    if (b == SLIP_END) {
+        if (rx_in_frame && rx_len) {
+            frame_received();
+            rx_in_frame = 0;        // The next C0 opens the next frame
+        } else {
+            rx_in_frame = 1;
+        }
+        rx_len = 0;
+        rx_esc = 0;
+        return;
+    }
+
+    if (!rx_in_frame) {
+        // Terminal text: console input in plain mode, a takeover in framed
+        if (framed) framed = 0;
+        rx_put(&chans[UARTMUX_CH_CONSOLE], b);
+        return;
+    }
+
+    if (rx_esc) {
+        rx_esc = 0;
+        if (b == SLIP_ESC_END) {
+            b = SLIP_END;
+        } else if (b == SLIP_ESC_ESC) {
+            b = SLIP_ESC;
+        }
+    } else if (b == SLIP_ESC) {
+        rx_esc = 1;
+        return;
+    }
+
+    if (rx_len < sizeof(rx_body)) {
+        rx_body[rx_len++] = b;
+    } else {
+        // Not a frame of ours: drop it and treat what follows as text
+        stats.rx_errors++;
+        rx_in_frame = 0;
+        rx_len = 0;
+    }
+}
+
+// Move bytes from the UART FIFO into the parser. In plain mode stop when
+// the console buffer is full, leaving the rest in the FIFO (a paste into
+// the terminal is not lost before the application reads it).
+static void rx_drain(void) {
+    mux_chan_t *con = &chans[UARTMUX_CH_CONSOLE];
+    while (uart_rx_ready()) {
+        if (!framed && !rx_in_frame && rx_count(con) >= con->rx_size) break;
+        rx_byte(uart_rx_read());
+    }
+}
+
+//==============================================================================
+// Transmit
+//==============================================================================
+
+static void tx_raw(uint8_t c) {
+    while (uart_tx_busy()) rx_drain();
+    uart_tx_write(c);
+}
+
+static void tx_esc(uint8_t c) {
+    if (c == SLIP_END) {
+        tx_raw(SLIP_ESC);
+        tx_raw(SLIP_ESC_END);
+    } else if (c == SLIP_ESC) {
+        tx_raw(SLIP_ESC);
+        tx_raw(SLIP_ESC_ESC);
+    } else {
+        tx_raw(c);
+    }
+}
+
+static void tx_frame(uint32_t type, uint32_t ch, const uint8_t *p, uint32_t len) {
+    uint8_t hdr = (uint8_t)(type << 4 | ch);
+    uint32_t crc = crc32_update_u8(crc32_init(), hdr);
+    crc = crc32_final(crc32_update_byte(crc, p, len));
+
+    tx_raw(SLIP_END);
+    tx_esc(hdr);
+    for (uint32_t i = 0; i < len; i++) tx_esc(p[i]);
+    for (int i = 0; i < 32; i += 8) tx_esc((uint8_t)(crc >> i));
+    tx_raw(SLIP_END);
+    stats.tx_frames++;
+}
+
+static void send_credit(uint32_t ch) {
+    mux_chan_t *c = &chans[ch];
+    uint8_t p[2] = { (uint8_t)c->rx_unacked, (uint8_t)(c->rx_unacked >> 8) };
+    c->rx_unacked = 0;
+    tx_frame(TYPE_CREDIT, ch, p, 2);
+}
+
+// Control traffic owed to the host; never called in the middle of a frame
+static void send_control(void) {
+    if (hello_pending && framed) {
+        uint8_t p[2 + 2 * UARTMUX_CHANNELS];
+        p[0] = UARTMUX_VERSION;
+        p[1] = UARTMUX_CHANNELS;
+        for (uint32_t i = 0; i < UARTMUX_CHANNELS; i++) {
+            p[2 + 2 * i] = (uint8_t)chans[i].rx_size;
+            p[3 + 2 * i] = (uint8_t)(chans[i].rx_size >> 8);
+        }
+        hello_pending = 0;
+        tx_frame(TYPE_HELLO, 0, p, sizeof(p));
+    }
+}
+
+// Send the channel's buffered output. block = 0 sends what credit allows
+// and keeps the rest; block = 1 waits for credit (servicing the receiver)
+static void chan_flush(uint32_t ch, int block) {
+    mux_chan_t *c = &chans[ch];
+
+    while (c->tx_len) {
+        if (!framed) {
+            if (ch == UARTMUX_CH_CONSOLE) {
+                for (uint32_t i = 0; i < c->tx_len; i++) tx_raw(c->tx[i]);
+            } else {
+                stats.tx_dropped += c->tx_len;
+            }
+            c->tx_len = 0;
+            return;
+        }
+
+        send_control();
+        uint32_t n = c->tx_len < c->tx_credit ? c->tx_len : c->tx_credit;
+        if (n == 0) {
+            if (!block) return;
+            rx_drain();
+            continue;
+        }
+        tx_frame(TYPE_DATA, ch, c->tx, n);
+        // A HELLO parsed while sending may have reset the credit
+        c->tx_credit = c->tx_credit > n ? c->tx_credit - n : 0;
+        c->tx_len -= (uint8_t)n;
+        for (uint32_t i = 0; i < c->tx_len; i++) c->tx[i] = c->tx[n + i];
+    }
+}
+
+//==============================================================================
+// API
+//==============================================================================
+
+void uartmux_init(void) {
+    for (uint32_t i = 0; i < UARTMUX_CHANNELS; i++) chan_reset(&chans[i]);
+    framed = 0;
+    hello_pending = 0;
+    rx_len = 0;
+    rx_in_frame = 0;
+    rx_esc = 0;
+}
+
+int uartmux_framed(void) {
+    return framed;
+}
+
+void uartmux_poll(void) {
+    rx_drain();
+    send_control();
+    chan_flush(UARTMUX_CH_CONSOLE, 1);
+}
+
+void uartmux_putc(uint32_t ch, uint8_t c) {
+    if (ch >= UARTMUX_CHANNELS) return;
+    mux_chan_t *m = &chans[ch];
+
+    if (!framed) {
+        // Plain mode: console straight out, the rest has nowhere to go
+        if (ch == UARTMUX_CH_CONSOLE) {
+            chan_flush(ch, 1);
+            tx_raw(c);
+        } else {
+            stats.tx_dropped++;
+        }
+        return;
+    }
+
+    if (m->tx_len == UARTMUX_MTU) chan_flush(ch, 1);
+    m->tx[m->tx_len++] = c;
+    if (m->tx_len == UARTMUX_MTU || (ch == UARTMUX_CH_CONSOLE && c == '\n')) {
+        chan_flush(ch, 1);
+    }
+}
+
+void uartmux_write(uint32_t ch, const void *buf, uint32_t len) {
+    const uint8_t *p = buf;
+    if (ch >= UARTMUX_CHANNELS) return;
+    while (len--) {
+        if (chans[ch].tx_len == UARTMUX_MTU) chan_flush(ch, 1);
+        if (!framed) {
+            uartmux_putc(ch, *p++);
+            continue;
+        }
+        chans[ch].tx[chans[ch].tx_len++] = *p++;
+    }
+    chan_flush(ch, 1);
+}
+
+uint32_t uartmux_try_write(uint32_t ch, const void *buf, uint32_t len) {
+    const uint8_t *p = buf;
+    if (ch >= UARTMUX_CHANNELS) return 0;
+    mux_chan_t *c = &chans[ch];
+
+    rx_drain();
+    if (!framed) {
+        if (ch == UARTMUX_CH_CONSOLE) {
+            uartmux_write(ch, buf, len);
+            return len;
+        }
+        stats.tx_dropped += len;
+        return 0;
+    }
+
+    uint32_t n = 0;
+    while (n < len && c->tx_len < c->tx_credit && c->tx_len < UARTMUX_MTU) {
+        c->tx[c->tx_len++] = p[n++];
+        if (c->tx_len == UARTMUX_MTU) chan_flush(ch, 0);
+    }
+    chan_flush(ch, 0);
+    stats.tx_dropped += len - n;
+    return n;
+}
+
+void uartmux_flush(uint32_t ch) {
+    if (ch < UARTMUX_CHANNELS) chan_flush(ch, 1);
+}
+
+uint32_t uartmux_available(uint32_t ch) {
+    if (ch >= UARTMUX_CHANNELS) return 0;
+    uartmux_poll();
+    return rx_count(&chans[ch]);
+}
+
+uint32_t uartmux_read(uint32_t ch, void *buf, uint32_t len) {
+    uint8_t *p = buf;
+    uint32_t n = 0;
+    if (ch >= UARTMUX_CHANNELS) return 0;
+    mux_chan_t *c = &chans[ch];
+
+    uartmux_poll();
+    while (n < len && rx_count(c)) {
+        p[n++] = c->rx[c->rx_tail & (c->rx_size - 1)];
+        c->rx_tail++;
+    }
+
+    // Return credit once half the buffer has been freed
+    c->rx_unacked += (uint16_t)n;
+    if (framed && c->rx_unacked >= c->rx_size / 2) send_credit(ch);
+    if (!framed) c->rx_unacked = 0;
+    return n;
+}
+
+uint8_t uartmux_getc(uint32_t ch) {
+    uint8_t c;
+    while (uartmux_read(ch, &c, 1) == 0);
+    return c;
+}
+
+const uartmux_stats_t *uartmux_stats(void) {
+    return &stats;
+}
+
+// lib/syscalls sends stdout/stderr here when uartmux is linked, so printf
+// output travels on the console channel instead of corrupting frames
+void uartmux_stdio_putc(char c) {
+    uartmux_putc(UARTMUX_CH_CONSOLE, (uint8_t)c);
+}
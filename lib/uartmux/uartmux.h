@@ -0,0 +1,104 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// uartmux.h - Framed Logical Channels over the One UART
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Carries several byte streams (console, data, telemetry, trace) over the
+// UART with per-channel credit flow control. tools/uartmux/uartmux.py is the
+// host side: it puts the console on the terminal and every other channel on
+// its own pseudo-terminal, so fw_upload, a telemetry logger and a trace
+// capture can run while the curses console stays intact.
+//
+// Two modes:
+//
+//   plain     after uartmux_init(), or when a plain terminal sends text:
+//             console bytes go to the UART unframed, exactly as before;
+//             other channels are discarded (counted in tx_dropped)
+//   framed    after the host demultiplexer's HELLO: everything is framed
+//
+// So a firmware using uartmux still works with picocom/screen, and the
+// demultiplexer can attach and detach at any time.
+//
+//   uartmux_init();
+//   uartmux_putc(UARTMUX_CH_CONSOLE, c);         // console output
+//   if (uartmux_available(UARTMUX_CH_CONSOLE))   // console input
+//       c = uartmux_getc(UARTMUX_CH_CONSOLE);
+//   uartmux_try_write(UARTMUX_CH_TELEMETRY, buf, n);  // never blocks
+//   uartmux_poll();                              // from the main loop
+//
+// There is no UART interrupt, so received bytes are parsed whenever the
+// library runs: uartmux_poll(), any read, and every wait for the
+// transmitter or for credit. Call it from main code only (not from IRQ
+// handlers). Wire format: top of uartmux.c.
+//
+//==============================================================================
+
+#ifndef UARTMUX_H
+#define UARTMUX_H
+
+#include <stdint.h>
+
+// Channels
+#define UARTMUX_CH_CONSOLE      0
+#define UARTMUX_CH_DATA         1
+#define UARTMUX_CH_TELEMETRY    2
+#define UARTMUX_CH_TRACE        3
+#define UARTMUX_CHANNELS        4
+
+// Largest DATA payload per frame
+#define UARTMUX_MTU             64
+
+// Receive buffer per channel in bytes (powers of two). These are the
+// credits the host starts with, so keep their sum under the 256-byte UART
+// RX FIFO: then nothing is lost even while the firmware is not polling.
+#ifndef UARTMUX_RX_CONSOLE
+#define UARTMUX_RX_CONSOLE      64
+#endif
+#ifndef UARTMUX_RX_DATA
+#define UARTMUX_RX_DATA         128
+#endif
+#ifndef UARTMUX_RX_TELEMETRY
+#define UARTMUX_RX_TELEMETRY    16
+#endif
+#ifndef UARTMUX_RX_TRACE
+#define UARTMUX_RX_TRACE        16
+#endif
+
+typedef struct {
+    uint32_t rx_frames;         // Valid frames received
+    uint32_t rx_errors;         // Bad CRC, bad length or unknown type
+    uint32_t rx_overflow;       // Bytes dropped on a full channel buffer
+    uint32_t tx_frames;         // Frames sent
+    uint32_t tx_dropped;        // Bytes discarded (plain mode, no credit)
+} uartmux_stats_t;
+
+void uartmux_init(void);
+
+// 1 while the host demultiplexer is attached
+int uartmux_framed(void);
+
+// Parse received bytes, answer the host, send buffered console output
+void uartmux_poll(void);
+
+// Output. putc buffers (console sends at '\n', a full frame or the next
+// poll/read); write sends at once and waits for credit; try_write takes
+// what the host has room for and returns the count, without waiting.
+void uartmux_putc(uint32_t ch, uint8_t c);
+void uartmux_write(uint32_t ch, const void *buf, uint32_t len);
+uint32_t uartmux_try_write(uint32_t ch, const void *buf, uint32_t len);
+void uartmux_flush(uint32_t ch);
+
+// Input. read and available never block; getc waits for a byte.
+uint32_t uartmux_available(uint32_t ch);
+uint32_t uartmux_read(uint32_t ch, void *buf, uint32_t len);
+uint8_t uartmux_getc(uint32_t ch);
+
+const uartmux_stats_t *uartmux_stats(void);
+
+#endif // UARTMUX_H
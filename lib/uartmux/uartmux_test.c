@@ -0,0 +1,480 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// uartmux_test.c - lib/uartmux Host Test (framing, credits, plain fallback)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Runs lib/uartmux against a simulated UART. The test plays the host: it
+// injects frames and terminal text, and checks what the firmware side
+// sends back with its own SLIP/CRC decoder. Some host frames are held back
+// until the library has polled the receiver a number of times, to check
+// that blocked writers keep servicing the link.
+//
+// Everything the firmware sent is written to a capture file, and what the
+// application wrote to each channel to <dir>/<channel>.bin. The Makefile
+// splits the capture with tools/uartmux/uartmux.py --decode and compares.
+//
+// Usage: uartmux_test capture.bin expected_dir
+//
+//==============================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "uartmux.h"
+#include "../crc32/crc32.h"
+
+#define END     0xC0
+#define ESC     0xDB
+
+static const char *chan_names[UARTMUX_CHANNELS] = { "console", "data", "telemetry", "trace" };
+
+static int failures;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+//==============================================================================
+// Simulated UART
+//==============================================================================
+
+static uint8_t rx_q[8192];
+static uint32_t rx_head, rx_tail;
+static uint8_t held[256];           // Released after held_polls receiver polls
+static uint32_t held_len;
+static uint32_t held_polls;
+
+static uint8_t tx_buf[16384];
+static uint32_t tx_len;             // Not yet examined by the test
+static FILE *capture;
+
+int uartmux_host_rx_ready(void) {
+    if (held_len && held_polls && --held_polls == 0) {
+        memcpy(rx_q + rx_head, held, held_len);
+        rx_head += held_len;
+        held_len = 0;
+    }
+    return rx_tail != rx_head;
+}
+
+uint8_t uartmux_host_rx_read(void) {
+    return rx_q[rx_tail++];
+}
+
+int uartmux_host_tx_busy(void) {
+    return 0;
+}
+
+void uartmux_host_tx_write(uint8_t c) {
+    tx_buf[tx_len++] = c;
+    fputc(c, capture);
+}
+
+//==============================================================================
+// Host side
+//==============================================================================
+
+static uint32_t encode(uint8_t *out, uint32_t type, uint32_t ch, const uint8_t *p, uint32_t len) {
+    uint8_t body[128];
+    uint32_t n = 0, blen = 0;
+    body[blen++] = (uint8_t)(type << 4 | ch);
+    memcpy(body + blen, p, len);
+    blen += len;
+    uint32_t crc = crc32(body, blen);
+    for (int i = 0; i < 32; i += 8) body[blen++] = (uint8_t)(crc >> i);
+
+    out[n++] = END;
+    for (uint32_t i = 0; i < blen; i++) {
+        if (body[i] == END) {
+            out[n++] = ESC;
+            out[n++] = 0xDC;
+        } else if (body[i] == ESC) {
+            out[n++] = ESC;
+            out[n++] = 0xDD;
+        } else {
+            out[n++] = body[i];
+        }
+    }
+    out[n++] = END;
+    return n;
+}
+
+static void host_send(uint32_t type, uint32_t ch, const void *p, uint32_t len) {
+    rx_head += encode(rx_q + rx_head, type, ch, p, len);
+}
+
+static void host_send_later(uint32_t polls, uint32_t type, uint32_t ch, const void *p, uint32_t len) {
+    held_len = encode(held, type, ch, p, len);
+    held_polls = polls;
+}
+
+static void host_text(const char *s) {
+    while (*s) rx_q[rx_head++] = (uint8_t)*s++;
+}
+
+static void host_hello(uint16_t w0, uint16_t w1, uint16_t w2, uint16_t w3) {
+    uint8_t p[10] = { 1, 4, (uint8_t)w0, (uint8_t)(w0 >> 8), (uint8_t)w1, (uint8_t)(w1 >> 8),
+                      (uint8_t)w2, (uint8_t)(w2 >> 8), (uint8_t)w3, (uint8_t)(w3 >> 8) };
+    host_send(2, 0, p, sizeof(p));
+}
+
+static void host_credit(uint32_t ch, uint16_t n) {
+    uint8_t p[2] = { (uint8_t)n, (uint8_t)(n >> 8) };
+    host_send(1, ch, p, 2);
+}
+
+// What the firmware sent since the last call: text and decoded frames
+typedef struct {
+    int type;                       // -1 = text outside frames
+    int ch;
+    uint8_t p[128];
+    uint32_t len;
+} rx_item_t;
+
+static rx_item_t items[256];
+static uint32_t num_items;
+static uint32_t bad_frames;
+
+static void take_tx(void) {
+    uint32_t i = 0;
+    num_items = 0;
+    while (i < tx_len) {
+        rx_item_t *it = &items[num_items++];
+        it->len = 0;
+        if (tx_buf[i] != END) {
+            it->type = -1;
+            it->ch = 0;
+            while (i < tx_len && tx_buf[i] != END) it->p[it->len++] = tx_buf[i++];
+            continue;
+        }
+        uint8_t body[128];
+        uint32_t blen = 0;
+        i++;
+        while (i < tx_len && tx_buf[i] != END) {
+            uint8_t b = tx_buf[i++];
+            if (b == ESC) {
+                b = tx_buf[i++] == 0xDC ? END : ESC;
+            }
+            body[blen++] = b;
+        }
+        i++;
+        uint32_t crc = 0;
+        for (int k = 0; k < 4; k++) crc |= (uint32_t)body[blen - 4 + k] << (8 * k);
+        if (blen < 5 || crc32(body, blen - 4) != crc) {
+            bad_frames++;
+            num_items--;
+            continue;
+        }
+        it->type = body[0] >> 4;
+        it->ch = body[0] & 0x0F;
+        it->len = blen - 5;
+        memcpy(it->p, body + 1, it->len);
+    }
+    tx_len = 0;
+}
+
+static uint32_t count_items(int type, int ch) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < num_items; i++) {
+        if (items[i].type == type && (ch < 0 || items[i].ch == ch)) n++;
+    }
+    return n;
+}
+
+// Concatenated DATA payload of one channel
+static uint32_t data_of(int ch, uint8_t *out) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < num_items; i++) {
+        if (items[i].type == 0 && items[i].ch == ch) {
+            memcpy(out + n, items[i].p, items[i].len);
+            n += items[i].len;
+        }
+    }
+    return n;
+}
+
+//==============================================================================
+// Application side, with a record of everything written per channel
+//==============================================================================
+
+static uint8_t written[UARTMUX_CHANNELS][4096];
+static uint32_t written_len[UARTMUX_CHANNELS];
+
+static void app_puts(const char *s) {
+    while (*s) {
+        written[0][written_len[0]++] = (uint8_t)*s;
+        uartmux_putc(UARTMUX_CH_CONSOLE, (uint8_t)*s++);
+    }
+}
+
+static void app_write(uint32_t ch, const void *p, uint32_t len) {
+    memcpy(written[ch] + written_len[ch], p, len);
+    written_len[ch] += len;
+    uartmux_write(ch, p, len);
+}
+
+static uint32_t app_try_write(uint32_t ch, const void *p, uint32_t len) {
+    uint32_t n = uartmux_try_write(ch, p, len);
+    memcpy(written[ch] + written_len[ch], p, n);
+    written_len[ch] += n;
+    return n;
+}
+
+//==============================================================================
+// Tests
+//==============================================================================
+
+static void test_plain(void) {
+    printf("plain terminal mode\n");
+    uartmux_init();
+
+    app_puts("boot\r\n");
+    take_tx();
+    CHECK(num_items == 1 && items[0].type == -1 && items[0].len == 6 &&
+          memcmp(items[0].p, "boot\r\n", 6) == 0, "console not sent unframed");
+
+    CHECK(app_try_write(UARTMUX_CH_TELEMETRY, "t=1", 3) == 0, "telemetry accepted in plain mode");
+    uartmux_poll();
+    take_tx();
+    CHECK(num_items == 0, "telemetry reached the terminal");
+
+    host_text("ls~\r");
+    CHECK(uartmux_available(UARTMUX_CH_CONSOLE) == 4, "typed text not on the console");
+    char buf[8] = {0};
+    uartmux_read(UARTMUX_CH_CONSOLE, buf, sizeof(buf));
+    CHECK(strcmp(buf, "ls~\r") == 0, "console input '%s'", buf);
+    take_tx();
+    CHECK(num_items == 0, "plain mode sent credit or control frames");
+
+    // A paste longer than the console buffer stays in the UART FIFO
+    for (int i = 0; i < 100; i++) host_text("p");
+    uint32_t got = 0;
+    while (uartmux_available(UARTMUX_CH_CONSOLE)) got += uartmux_read(UARTMUX_CH_CONSOLE, buf, 1);
+    CHECK(got == 100 && uartmux_stats()->rx_overflow == 0, "paste: %u bytes, %u dropped",
+          got, uartmux_stats()->rx_overflow);
+}
+
+static void test_attach(void) {
+    printf("attach\n");
+    host_hello(1024, 1024, 8, 1024);
+    uartmux_poll();
+    CHECK(uartmux_framed(), "HELLO did not attach");
+    take_tx();
+    CHECK(count_items(2, -1) == 1, "no HELLO reply");
+    for (uint32_t i = 0; i < num_items; i++) {
+        if (items[i].type == 2) {
+            const uint8_t *p = items[i].p;
+            CHECK(items[i].len == 10 && p[0] == 1 && p[1] == 4, "HELLO reply header");
+            CHECK((p[2] | p[3] << 8) == UARTMUX_RX_CONSOLE && (p[4] | p[5] << 8) == UARTMUX_RX_DATA &&
+                  (p[6] | p[7] << 8) == UARTMUX_RX_TELEMETRY && (p[8] | p[9] << 8) == UARTMUX_RX_TRACE,
+                  "HELLO reply windows");
+        }
+    }
+}
+
+static void test_console_framed(void) {
+    uint8_t out[256];
+    printf("console frames\n");
+
+    app_puts("abc\n");
+    take_tx();
+    CHECK(num_items == 1 && items[0].type == 0 && items[0].ch == 0 &&
+          items[0].len == 4 && memcmp(items[0].p, "abc\n", 4) == 0, "line not one DATA frame");
+
+    app_puts("> ");
+    take_tx();
+    CHECK(num_items == 0, "prompt sent before a poll");
+    uartmux_poll();
+    take_tx();
+    CHECK(data_of(0, out) == 2 && memcmp(out, "> ", 2) == 0, "prompt not flushed by poll");
+
+    // Longer than one frame
+    char line[150];
+    for (int i = 0; i < 149; i++) line[i] = (char)('A' + i % 26);
+    line[149] = 0;
+    app_puts(line);
+    app_puts("\n");
+    take_tx();
+    CHECK(count_items(0, 0) == 3 && data_of(0, out) == 150, "150-byte line: %u frames",
+          count_items(0, 0));
+}
+
+static void test_telemetry_credit(void) {
+    uint8_t out[64];
+    printf("telemetry credit\n");
+
+    CHECK(app_try_write(UARTMUX_CH_TELEMETRY, "0123456789abcdefghij", 20) == 8,
+          "try_write beyond the host window");
+    take_tx();
+    CHECK(data_of(2, out) == 8 && memcmp(out, "01234567", 8) == 0, "telemetry frame");
+    CHECK(app_try_write(UARTMUX_CH_TELEMETRY, "x", 1) == 0, "try_write without credit");
+
+    host_credit(UARTMUX_CH_TELEMETRY, 8);
+    CHECK(app_try_write(UARTMUX_CH_TELEMETRY, "klmnopqrst", 10) == 8, "credit not applied");
+    take_tx();
+    CHECK(data_of(2, out) == 8 && memcmp(out, "klmnopqr", 8) == 0, "telemetry after credit");
+}
+
+static void test_escaping(void) {
+    uint8_t out[64];
+    static const uint8_t bin[] = { END, ESC, 0x00, END, ESC, 0xDC, 0xDD, 0xFF };
+    printf("SLIP escaping\n");
+
+    app_write(UARTMUX_CH_DATA, bin, sizeof(bin));
+    take_tx();
+    CHECK(data_of(1, out) == sizeof(bin) && memcmp(out, bin, sizeof(bin)) == 0,
+          "binary data changed on the wire");
+    CHECK(bad_frames == 0, "%u bad frames", bad_frames);
+}
+
+static void test_receive_credit(void) {
+    uint8_t in[100], got[100];
+    printf("receive and return credit\n");
+
+    for (int i = 0; i < 100; i++) in[i] = (uint8_t)(i * 37 + (i & 1 ? END : ESC));
+    host_send(0, UARTMUX_CH_DATA, in, 64);
+    host_send(0, UARTMUX_CH_DATA, in + 64, 36);
+    CHECK(uartmux_available(UARTMUX_CH_DATA) == 100, "data channel has %u bytes",
+          uartmux_available(UARTMUX_CH_DATA));
+
+    CHECK(uartmux_read(UARTMUX_CH_DATA, got, 64) == 64, "read 64");
+    take_tx();
+    CHECK(count_items(1, 1) == 1 && items[0].len == 2 && (items[0].p[0] | items[0].p[1] << 8) == 64,
+          "no CREDIT 64 after half the buffer was read");
+
+    CHECK(uartmux_read(UARTMUX_CH_DATA, got + 64, 64) == 36, "read rest");
+    take_tx();
+    CHECK(count_items(1, -1) == 0, "CREDIT before half the buffer was free");
+    CHECK(memcmp(in, got, 100) == 0, "received data differs");
+
+    // Other channels are independent: console input is still there to read
+    host_send(0, UARTMUX_CH_CONSOLE, "q", 1);
+    CHECK(uartmux_getc(UARTMUX_CH_CONSOLE) == 'q', "console input");
+}
+
+static void test_corrupt(void) {
+    uint8_t frame[32];
+    printf("corrupt frames\n");
+
+    uint32_t errors = uartmux_stats()->rx_errors;
+    uint32_t n = encode(frame, 0, UARTMUX_CH_CONSOLE, (const uint8_t *)"bad", 3);
+    frame[3] ^= 0x01;
+    memcpy(rx_q + rx_head, frame, n);
+    rx_head += n;
+    host_send(0, UARTMUX_CH_CONSOLE, "ok", 2);
+
+    char buf[8] = {0};
+    CHECK(uartmux_available(UARTMUX_CH_CONSOLE) == 2, "corrupt frame delivered");
+    uartmux_read(UARTMUX_CH_CONSOLE, buf, sizeof(buf));
+    CHECK(strcmp(buf, "ok") == 0, "good frame after corrupt one: '%s'", buf);
+    CHECK(uartmux_stats()->rx_errors == errors + 1, "error not counted");
+    CHECK(uartmux_framed(), "corrupt frame detached");
+}
+
+static void test_blocking_write(void) {
+    uint8_t out[256];
+    printf("blocking write waits for credit\n");
+
+    // Re-attach with a small console window
+    host_hello(8, 1024, 1024, 1024);
+    uartmux_poll();
+    take_tx();
+    CHECK(count_items(2, -1) == 1, "no reply to the second HELLO");
+
+    // Credit arrives while the writer is waiting
+    host_send_later(50, 1, UARTMUX_CH_CONSOLE, "\x10\x00", 2);
+    app_write(UARTMUX_CH_CONSOLE, "0123456789ABCDEFGHIJ", 20);
+    take_tx();
+    CHECK(held_len == 0, "writer did not service the receiver");
+    CHECK(data_of(0, out) == 20 && memcmp(out, "0123456789ABCDEFGHIJ", 20) == 0,
+          "blocked write incomplete");
+    for (uint32_t i = 0; i < num_items; i++) {
+        CHECK(items[i].type != 0 || items[i].len <= 16, "frame beyond the window");
+    }
+
+    host_credit(UARTMUX_CH_CONSOLE, 1000);
+    uartmux_poll();
+}
+
+static void test_takeover(void) {
+    printf("plain terminal takes over, host re-attaches, BYE\n");
+
+    host_text("x");
+    CHECK(uartmux_getc(UARTMUX_CH_CONSOLE) == 'x', "takeover text");
+    CHECK(!uartmux_framed(), "still framed after plain text");
+    app_puts("y\r\n");
+    take_tx();
+    CHECK(num_items == 1 && items[0].type == -1 && items[0].len == 3, "console not plain");
+
+    host_hello(1024, 1024, 1024, 1024);
+    uartmux_poll();
+    CHECK(uartmux_framed(), "re-attach");
+    app_write(UARTMUX_CH_TRACE, "@@TRACE", 7);
+    app_puts("done\n");
+    take_tx();
+    CHECK(count_items(0, 3) == 1 && count_items(0, 0) == 1, "trace/console frames");
+
+    host_send(3, 0, "", 0);
+    uartmux_poll();
+    CHECK(!uartmux_framed(), "BYE did not detach");
+    app_puts("bye\r\n");
+    take_tx();
+    CHECK(num_items == 1 && items[0].type == -1, "console not plain after BYE");
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: uartmux_test capture.bin expected_dir\n");
+        return 2;
+    }
+    capture = fopen(argv[1], "wb");
+    if (!capture) {
+        perror(argv[1]);
+        return 2;
+    }
+
+    test_plain();
+    test_attach();
+    test_console_framed();
+    test_telemetry_credit();
+    test_escaping();
+    test_receive_credit();
+    test_corrupt();
+    test_blocking_write();
+    test_takeover();
+    fclose(capture);
+
+    for (int ch = 0; ch < UARTMUX_CHANNELS; ch++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.bin", argv[2], chan_names[ch]);
+        FILE *f = fopen(path, "wb");
+        if (!f) {
+            perror(path);
+            return 2;
+        }
+        fwrite(written[ch], 1, written_len[ch], f);
+        fclose(f);
+    }
+
+    const uartmux_stats_t *s = uartmux_stats();
+    printf("frames rx %u tx %u, rx errors %u, overflow %u, tx dropped %u\n",
+           s->rx_frames, s->tx_frames, s->rx_errors, s->rx_overflow, s->tx_dropped);
+    if (failures) {
+        printf("FAILED: %d check(s)\n", failures);
+        return 1;
+    }
+    return 0;
+}
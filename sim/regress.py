@@ -0,0 +1,419 @@
+#!/usr/bin/env python3
+#===============================================================================
+# Olimex iCE40HX8K-EVB RISC-V Platform
+# regress.py - Parallel Testbench Regression (Icarus Verilog / Verilator)
+#
+# Copyright (c) October 2025 Michael Wolak
+# Email: mikewolak@gmail.com, mike@epromfoundry.com
+#
+# NOT FOR COMMERCIAL USE
+# Educational and research purposes only
+#===============================================================================
+#
+# Builds every testbench in TESTS with Icarus Verilog and/or Verilator
+# (--binary --timing, 5.x) and runs them in parallel, one job per
+# (simulator, test), each with its own wall-clock timeout. A job passes when
+# the simulator exits cleanly, its log matches the test's pass marker and
+# contains no fail marker.
+#
+# Each job runs in regress_out/<sim>/<test>/run with 'firmware' and
+# 'bootloader' symlinks at both run/ and run/.., so testbench paths written
+# for either the repo root or sim/ resolve unchanged, and VCDs or logs from
+# concurrent jobs never collide.
+#
+# Usage:
+#   ./regress.py                         # all active tests, every simulator found
+#   ./regress.py --sim icarus -j 8       # one simulator, 8 parallel jobs
+#   ./regress.py -k sram --slow          # filter by name, include long tests
+#   ./regress.py --shard 0/4             # CI: this machine runs every 4th job
+#   ./regress.py --rerun-failed          # only the jobs that failed last time
+#   ./regress.py --list                  # show tests and why any are skipped
+#
+# Results: summary table on stdout, regress_out/junit.xml, per-job
+# build.log/run.log, and regress_out/failed.txt for --rerun-failed.
+#===============================================================================
+
+import argparse
+import concurrent.futures
+import os
+import re
+import shutil
+import signal
+import subprocess
+import sys
+import time
+import xml.etree.ElementTree as ET
+
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(SIM_DIR)
+HDL_DIR = os.path.join(ROOT, 'hdl')
+RTL_LIST = os.path.join(HDL_DIR, 'rtl_sources.list')
+
+# Default markers; per-test 'pass_re'/'fail_re' override them
+PASS_RE = r'\bPASS(ED)?\b|✓ ALL'
+FAIL_RE = r'\bFAIL(ED|URE)?\b|\bERROR\b|\*\*\* TIMEOUT|✗'
+
+# Testbenches written for the hardware UART shell and the old app/shell mode
+# switch, both removed from ice40_picorv32_top (the bootloader is software now)
+SHELL_ERA = "drives the hardware UART shell removed from ice40_picorv32_top"
+
+#-------------------------------------------------------------------------------
+# Test table
+#   tb       testbench file in sim/ (top module = file stem)
+#   rtl      hdl/ modules outside rtl_sources.list that the testbench uses
+#   extra    additional sources from sim/
+#   needs    files (repo-relative) that must exist, e.g. firmware images
+#   timeout  wall-clock seconds per run (build excluded)
+#   slow     only run with --slow
+#   legacy   reason string: skipped unless --legacy
+#   args     simulator plusargs
+#   pass_re / fail_re  log markers (default PASS_RE / FAIL_RE)
+#-------------------------------------------------------------------------------
+TESTS = [
+    dict(name='sram_proc_crc_compare', tb='tb_sram_proc_crc_compare.sv',
+         rtl=['sram_proc_optimized.v'], timeout=600,
+         pass_re=r'\*\*\* ALL TESTS PASSED \*\*\*'),
+    dict(name='sram_bist', tb='tb_sram_bist.sv', timeout=900,
+         pass_re=r'\*\*\* ALL SRAM BIST TESTS PASSED \*\*\*'),
+    dict(name='sram_fused32', tb='tb_sram_fused32.sv', timeout=900,
+         pass_re=r'\*\*\* ALL SRAM FUSED32 TESTS PASSED \*\*\*'),
+    dict(name='uart_flow', tb='tb_uart_flow.sv', timeout=900,
+         pass_re=r'\*\*\* ALL UART FLOW TESTS PASSED \*\*\*'),
+    dict(name='firmware_upload', tb='tb_firmware_upload.sv', timeout=900,
+         pass_re=r'ALL FIRMWARE UPLOAD TESTS PASSED'),
+    dict(name='shell_integration', tb='tb_shell_integration.sv', rtl=['shell.v'], timeout=900,
+         pass_re=r'ALL SHELL INTEGRATION TESTS PASSED'),
+    dict(name='bootloader_complete', tb='tb_bootloader_complete.sv', extra=['trace_sink.sv'],
+         needs=['bootloader/bootloader.hex', 'firmware/led_blink.hex'],
+         timeout=4 * 3600, slow=True,
+         pass_re=r'TEST COMPLETE', fail_re=FAIL_RE + r'|Simulation timeout'),
+    dict(name='timer_integration', tb='tb_timer_integration.sv',
+         needs=['bootloader/bootloader.hex', 'firmware/irq_timer_test_words.hex'],
+         timeout=8 * 3600, slow=True,
+         pass_re=r'PASS: Timer generated'),
+    dict(name='cpu_run', tb='tb_cpu_run.sv', legacy=SHELL_ERA),
+    dict(name='interactive', tb='tb_interactive.sv', legacy=SHELL_ERA),
+    dict(name='r_command', tb='tb_r_command.sv', legacy=SHELL_ERA),
+    dict(name='crc_debug', tb='tb_crc_debug.sv', legacy=SHELL_ERA,
+         pass_re=r'CRC Test Complete'),
+    dict(name='shell_regression', tb='tb_shell_regression.sv', legacy=SHELL_ERA,
+         pass_re=r'ALL TESTS PASSED'),
+    dict(name='picorv32_direct', tb='tb_picorv32_direct.sv', legacy=SHELL_ERA,
+         pass_re=r'TEST PASSED'),
+    dict(name='picorv32_complete', tb='tb_picorv32_complete.sv', legacy=SHELL_ERA,
+         pass_re=r'TEST PASSED'),
+    dict(name='picorv32_modelsim', tb='tb_picorv32_modelsim.sv', legacy=SHELL_ERA,
+         pass_re=r'TEST PASSED'),
+    dict(name='picorv32_firmware', tb='tb_picorv32_firmware.sv', legacy=SHELL_ERA),
+]
+
+DEFAULT_TIMEOUT = 1800
+
+#===============================================================================
+# Simulators
+#===============================================================================
+
+def rtl_sources():
+    # hdl/rtl_sources.list, the same set the synthesis and Verilator builds
+    # use. Not a glob: hdl/ holds alternative modules with clashing names.
+    with open(RTL_LIST) as f:
+        names = [l.split('#', 1)[0].strip() for l in f]
+    return [os.path.join(HDL_DIR, n) for n in names if n]
+
+
+def sources(test):
+    srcs = rtl_sources()
+    srcs += [os.path.join(HDL_DIR, f) for f in test.get('rtl', [])]
+    srcs += [os.path.join(SIM_DIR, f) for f in test.get('extra', [])]
+    srcs.append(os.path.join(SIM_DIR, test['tb']))
+    return srcs
+
+
+def top_of(test):
+    return os.path.splitext(test['tb'])[0]
+
+
+class Icarus:
+    name = 'icarus'
+    tools = ['iverilog', 'vvp']
+
+    def build_cmd(self, test, bdir):
+        return (['iverilog', '-g2012', '-DSIMULATION', '-s', top_of(test),
+                 '-o', os.path.join(bdir, 'sim.vvp')] + sources(test))
+
+    def run_cmd(self, test, bdir):
+        return ['vvp', '-n', os.path.join(bdir, 'sim.vvp')] + test.get('args', [])
+
+
+class Verilator:
+    name = 'verilator'
+    tools = ['verilator']
+
+    def build_cmd(self, test, bdir):
+        return (['verilator', '--binary', '--timing', '-j', '0', '-DSIMULATION',
+                 '-Wno-fatal', '-Wno-lint', '-Wno-style', '-Wno-MULTIDRIVEN',
+                 '--top-module', top_of(test), '-Mdir', os.path.join(bdir, 'obj_dir'),
+                 '-o', 'Vsim'] + sources(test))
+
+    def run_cmd(self, test, bdir):
+        return [os.path.join(bdir, 'obj_dir', 'Vsim')] + test.get('args', [])
+
+
+SIMULATORS = {s.name: s for s in (Icarus(), Verilator())}
+
+
+def available(sim):
+    return all(shutil.which(t) for t in sim.tools)
+
+#===============================================================================
+# Job execution
+#===============================================================================
+
+class Job:
+    def __init__(self, sim, test, out_dir):
+        self.sim = sim
+        self.test = test
+        self.key = '%s:%s' % (sim.name, test['name'])
+        self.dir = os.path.join(out_dir, sim.name, test['name'])
+        self.status = 'NOTRUN'
+        self.detail = ''
+        self.build_time = 0.0
+        self.run_time = 0.0
+        self.log_tail = ''
+
+
+def run_cmd(cmd, cwd, log_path, timeout):
+    """Run cmd in its own process group; returns (returncode|None on timeout, seconds)."""
+    t0 = time.monotonic()
+    with open(log_path, 'w') as log:
+        log.write('$ %s\n' % ' '.join(cmd))
+        log.flush()
+        p = subprocess.Popen(cmd, cwd=cwd, stdout=log, stderr=subprocess.STDOUT,
+                             stdin=subprocess.DEVNULL, start_new_session=True)
+        try:
+            rc = p.wait(timeout=timeout)
+        except subprocess.TimeoutExpired:
+            os.killpg(p.pid, signal.SIGKILL)
+            p.wait()
+            rc = None
+    return rc, time.monotonic() - t0
+
+
+def tail(path, n=20):
+    try:
+        with open(path, errors='replace') as f:
+            return ''.join(f.readlines()[-n:])
+    except OSError:
+        return ''
+
+
+def prepare_dir(job):
+    run_dir = os.path.join(job.dir, 'run')
+    shutil.rmtree(job.dir, ignore_errors=True)
+    os.makedirs(run_dir)
+    for d in ('firmware', 'bootloader'):
+        for where in (job.dir, run_dir):
+            os.symlink(os.path.join(ROOT, d), os.path.join(where, d))
+    return run_dir
+
+
+def execute(job, timeout_scale):
+    test = job.test
+    run_dir = prepare_dir(job)
+    build_log = os.path.join(job.dir, 'build.log')
+    run_log = os.path.join(job.dir, 'run.log')
+
+    rc, job.build_time = run_cmd(job.sim.build_cmd(test, job.dir), run_dir, build_log, 3600)
+    if rc != 0:
+        job.status = 'BUILD'
+        job.detail = 'build failed' if rc is not None else 'build timed out'
+        job.log_tail = tail(build_log)
+        return job
+
+    timeout = test.get('timeout', DEFAULT_TIMEOUT) * timeout_scale
+    rc, job.run_time = run_cmd(job.sim.run_cmd(test, job.dir), run_dir, run_log, timeout)
+    job.log_tail = tail(run_log)
+
+    with open(run_log, errors='replace') as f:
+        text = f.read()
+    fail = re.search(test.get('fail_re', FAIL_RE), text)
+    passed = re.search(test.get('pass_re', PASS_RE), text)
+
+    if rc is None:
+        job.status, job.detail = 'TIMEOUT', 'killed after %.0f s' % timeout
+    elif fail:
+        job.status = 'FAIL'
+        line_start = text.rfind('\n', 0, fail.start()) + 1
+        line_end = text.find('\n', fail.start())
+        job.detail = text[line_start:line_end if line_end >= 0 else None].strip()[:100]
+    elif rc != 0:
+        job.status, job.detail = 'FAIL', 'exit status %d' % rc
+    elif not passed:
+        job.status, job.detail = 'FAIL', 'no pass marker'
+    else:
+        job.status = 'PASS'
+    return job
+
+#===============================================================================
+# Reporting
+#===============================================================================
+
+def write_junit(path, jobs, elapsed):
+    failures = sum(j.status in ('FAIL', 'TIMEOUT') for j in jobs)
+    errors = sum(j.status == 'BUILD' for j in jobs)
+    skipped = sum(j.status == 'SKIP' for j in jobs)
+    suite = ET.Element('testsuite', name='sim-regress', tests=str(len(jobs)),
+                       failures=str(failures), errors=str(errors), skipped=str(skipped),
+                       time='%.2f' % elapsed)
+    for j in jobs:
+        case = ET.SubElement(suite, 'testcase', classname='sim.' + j.sim.name,
+                             name=j.test['name'], time='%.2f' % (j.build_time + j.run_time))
+        if j.status == 'SKIP':
+            ET.SubElement(case, 'skipped', message=j.detail)
+        elif j.status == 'BUILD':
+            ET.SubElement(case, 'error', message=j.detail).text = j.log_tail
+        elif j.status in ('FAIL', 'TIMEOUT'):
+            ET.SubElement(case, 'failure', message='%s: %s' % (j.status, j.detail)).text = j.log_tail
+        if j.log_tail:
+            ET.SubElement(case, 'system-out').text = j.log_tail
+    ET.ElementTree(suite).write(path, encoding='utf-8', xml_declaration=True)
+
+
+def print_summary(jobs, elapsed):
+    w = max([len(j.test['name']) for j in jobs] + [4])
+    print('')
+    print('%-*s  %-9s  %-7s  %8s  %8s  %s' % (w, 'test', 'sim', 'result', 'build s', 'run s', 'detail'))
+    print('-' * (w + 50))
+    for j in jobs:
+        print('%-*s  %-9s  %-7s  %8.1f  %8.1f  %s' % (w, j.test['name'], j.sim.name, j.status,
+                                                     j.build_time, j.run_time, j.detail))
+    counts = {}
+    for j in jobs:
+        counts[j.status] = counts.get(j.status, 0) + 1
+    print('-' * (w + 50))
+    print('%s in %.1f s' % (', '.join('%d %s' % (n, s) for s, n in sorted(counts.items())), elapsed))
+
+#===============================================================================
+# Main
+#===============================================================================
+
+def skip_reason(test, opts):
+    if test.get('legacy') and not opts.legacy:
+        return 'legacy: ' + test['legacy']
+    if test.get('slow') and not opts.slow:
+        return 'slow (use --slow)'
+    for f in test.get('needs', []):
+        if not os.path.exists(os.path.join(ROOT, f)):
+            return 'missing ' + f
+    return None
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Run sim/ testbenches in parallel")
+    ap.add_argument('--sim', default='auto',
+                    help="icarus, verilator, comma list, or auto (every one installed)")
+    ap.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1, help="parallel jobs")
+    ap.add_argument('-k', dest='pattern', help="only tests whose name matches this regex")
+    ap.add_argument('--slow', action='store_true', help="include long full-system tests")
+    ap.add_argument('--legacy', action='store_true', help="include shell-era testbenches")
+    ap.add_argument('--shard', metavar='I/N', help="run only jobs with index %% N == I")
+    ap.add_argument('--rerun-failed', action='store_true', help="rerun jobs listed in failed.txt")
+    ap.add_argument('--timeout-scale', type=float, default=1.0, help="multiply per-test timeouts")
+    ap.add_argument('--out', default=os.path.join(SIM_DIR, 'regress_out'), help="output directory")
+    ap.add_argument('--junit', help="JUnit XML path (default OUT/junit.xml)")
+    ap.add_argument('--list', action='store_true', help="list tests and exit")
+    ap.add_argument('-v', '--verbose', action='store_true', help="print log tails of failures")
+    opts = ap.parse_args()
+
+    if opts.sim == 'auto':
+        sims = [s for s in SIMULATORS.values() if available(s)]
+    else:
+        sims = []
+        for n in opts.sim.split(','):
+            if n not in SIMULATORS:
+                ap.error("unknown simulator '%s'" % n)
+            sims.append(SIMULATORS[n])
+
+    if opts.list:
+        for t in TESTS:
+            r = skip_reason(t, opts)
+            print('%-24s %-30s %s' % (t['name'], t['tb'], r or 'active'))
+        print('\nsimulators: %s' % ', '.join('%s (%s)' % (s.name, 'found' if available(s) else 'missing')
+                                           for s in SIMULATORS.values()))
+        return 0
+
+    if not sims:
+        print("regress: no simulator found (install iverilog or verilator >= 5)", file=sys.stderr)
+        return 2
+    for s in sims:
+        if not available(s):
+            print("regress: %s not found in PATH" % s.name, file=sys.stderr)
+            return 2
+
+    failed_path = os.path.join(opts.out, 'failed.txt')
+    rerun = None
+    if opts.rerun_failed:
+        try:
+            with open(failed_path) as f:
+                rerun = set(l.strip() for l in f if l.strip())
+        except OSError:
+            rerun = set()
+        if not rerun:
+            print("regress: nothing to rerun (%s empty or missing)" % failed_path)
+            return 0
+
+    jobs = [Job(s, t, opts.out) for t in TESTS for s in sims]
+    if opts.pattern:
+        jobs = [j for j in jobs if re.search(opts.pattern, j.test['name'])]
+    if rerun is not None:
+        jobs = [j for j in jobs if j.key in rerun]
+    if opts.shard:
+        i, n = (int(x) for x in opts.shard.split('/'))
+        jobs = [j for k, j in enumerate(jobs) if k % n == i]
+
+    runnable = []
+    for j in jobs:
+        reason = None if rerun is not None else skip_reason(j.test, opts)
+        if reason:
+            j.status, j.detail = 'SKIP', reason
+        else:
+            runnable.append(j)
+
+    os.makedirs(opts.out, exist_ok=True)
+    print("Running %d job(s) on %d worker(s): %s" % (len(runnable), opts.jobs,
+                                                     ', '.join(s.name for s in sims)))
+    t0 = time.monotonic()
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, opts.jobs)) as pool:
+        futures = {pool.submit(execute, j, opts.timeout_scale): j for j in runnable}
+        for fut in concurrent.futures.as_completed(futures):
+            j = futures[fut]
+            try:
+                fut.result()
+            except Exception as e:          # Harness problem, not a test result
+                j.status, j.detail = 'BUILD', 'regress.py: %s' % e
+            print("  %-7s %-40s %7.1f s" % (j.status, j.key, j.build_time + j.run_time), flush=True)
+            if opts.verbose and j.status not in ('PASS', 'SKIP'):
+                print(j.log_tail)
+    elapsed = time.monotonic() - t0
+
+    print_summary(jobs, elapsed)
+    write_junit(opts.junit or os.path.join(opts.out, 'junit.xml'), jobs, elapsed)
+
+    # Merge into failed.txt: a filtered run (-k, --shard, --rerun-failed)
+    # only settles the jobs it ran, the rest keep their last result
+    bad = [j for j in jobs if j.status in ('FAIL', 'TIMEOUT', 'BUILD')]
+    try:
+        with open(failed_path) as f:
+            failed = set(l.strip() for l in f if l.strip())
+    except OSError:
+        failed = set()
+    failed -= set(j.key for j in runnable)
+    failed |= set(j.key for j in bad)
+    with open(failed_path, 'w') as f:
+        for key in sorted(failed):
+            f.write(key + '\n')
+    return 1 if bad else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
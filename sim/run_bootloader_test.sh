@@ -64,6 +64,11 @@ vlog -sv +define+SIMULATION -work work ../hdl/sram_driver_new.v
 echo "  - sram_proc_new.v"
 vlog -sv +define+SIMULATION -work work ../hdl/sram_proc_new.v
 
+echo "  - sram_bist.v"
+vlog -sv +define+SIMULATION -work work ../hdl/sram_bist.v
+echo "  - sram_fused32.v"
+vlog -sv +define+SIMULATION -work work ../hdl/sram_fused32.v
+
 # Peripherals
 echo "  - uart.v"
 vlog -sv +define+SIMULATION -work work ../hdl/uart.v
@@ -82,6 +87,9 @@ echo "  - ice40_picorv32_top.v"
 vlog -sv +define+SIMULATION -work work ../hdl/ice40_picorv32_top.v
 
 # Testbench
+echo "  - trace_sink.sv"
+vlog -sv +define+SIMULATION -work work trace_sink.sv
+
 echo "  - tb_bootloader_complete.sv"
 vlog -sv +define+SIMULATION -work work tb_bootloader_complete.sv
 
@@ -101,7 +109,20 @@ echo ""
 
 # Run with extended timeout (1 hour = 3600 seconds)
 # Add -do "run -all; quit -f" to auto-run and quit
-timeout 3700 vsim -c -do "run -all; quit -f" work.tb_bootloader_complete | tee simulation.log
+# VERBOSE=1 enables per-access RTL $display, TRACE=<file> writes a binary
+# instruction trace (tools/rvtrace), FIRMWARE=<hex> selects the uploaded image
+# (default ../firmware/led_blink.hex), VCD=1 dumps all signals
+VSIM_ARGS="-gVERBOSE=${VERBOSE:-0}"
+if [ -n "$TRACE" ]; then
+    VSIM_ARGS="$VSIM_ARGS +trace=$TRACE"
+fi
+if [ -n "$FIRMWARE" ]; then
+    VSIM_ARGS="$VSIM_ARGS +firmware=$FIRMWARE"
+fi
+if [ "${VCD:-0}" = "1" ]; then
+    VSIM_ARGS="$VSIM_ARGS +vcd"
+fi
+timeout 3700 vsim -c $VSIM_ARGS -do "run -all; quit -f" work.tb_bootloader_complete | tee simulation.log
 
 # Check simulation result
 if grep -q "TEST COMPLETE" simulation.log; then
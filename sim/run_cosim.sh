@@ -0,0 +1,68 @@
+#!/bin/bash
+
+#===============================================================================
+# Olimex iCE40HX8K-EVB RISC-V Platform
+# run_cosim.sh - Lockstep RTL vs. ISA Model Check of the Test Suites
+#
+# Copyright (c) October 2025 Michael Wolak
+# Email: mikewolak@gmail.com, mike@epromfoundry.com
+#
+# NOT FOR COMMERCIAL USE
+# Educational and research purposes only
+#===============================================================================
+#
+# Usage: ./run_cosim.sh [suite...]        suites: algo math (default: both)
+#
+# Runs the full algo_test / math_test suites on the Verilator SoC model with
+# --cosim: every instruction PicoRV32 retires is checked against the rvsim
+# ISA model, and the run stops at the first divergence with the last
+# instructions and the model's registers. Use after any change to the CPU
+# configuration or the memory path (mem_controller.v, sram_proc_new.v).
+# Extra simulator options can be passed in COSIM_ARGS.
+#===============================================================================
+
+set -e
+
+cd "$(dirname "$0")"
+
+SUITES=${*:-algo math}
+
+if ! command -v ${VERILATOR:-verilator} >/dev/null 2>&1; then
+    echo "ERROR: verilator not found in PATH"
+    exit 1
+fi
+
+echo "Building simulator..."
+make -C verilator --no-print-directory
+
+FAILED=""
+for suite in $SUITES; do
+    case $suite in
+        algo) ELF=../firmware/algo_test.elf; KEYS=" 7"; DONE="All algorithm tests complete!" ;;
+        math) ELF=../firmware/math_test.elf; KEYS=" 8"; DONE="All math tests complete!" ;;
+        *)    echo "ERROR: unknown suite '$suite' (algo, math)"; exit 1 ;;
+    esac
+    if [ ! -f "$ELF" ]; then
+        echo "ERROR: $ELF not found (make firmware)"
+        exit 1
+    fi
+
+    echo ""
+    echo "========================================="
+    echo "Cosim: $ELF"
+    echo "========================================="
+    if verilator/obj_dir/Vsim_top "$ELF" --stdio --cosim --input "$KEYS" \
+            --exit-on "$DONE" $COSIM_ARGS < /dev/null; then
+        echo "✓ $suite: RTL matches the ISA model"
+    else
+        echo "✗ $suite: divergence (see report above)"
+        FAILED="$FAILED $suite"
+    fi
+done
+
+echo ""
+if [ -n "$FAILED" ]; then
+    echo "FAILED:$FAILED"
+    exit 1
+fi
+echo "✓ All suites passed lockstep co-simulation"
@@ -52,6 +52,10 @@ echo "  - sram_driver_new.v"
 vlog -sv +define+SIMULATION -work work ../hdl/sram_driver_new.v
 echo "  - sram_proc_new.v"
 vlog -sv +define+SIMULATION -work work ../hdl/sram_proc_new.v
+echo "  - sram_bist.v"
+vlog -sv +define+SIMULATION -work work ../hdl/sram_bist.v
+echo "  - sram_fused32.v"
+vlog -sv +define+SIMULATION -work work ../hdl/sram_fused32.v
 
 echo "  - uart.v"
 vlog -sv +define+SIMULATION -work work ../hdl/uart.v
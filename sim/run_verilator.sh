@@ -0,0 +1,51 @@
+#!/bin/bash
+
+#===============================================================================
+# Olimex iCE40HX8K-EVB RISC-V Platform
+# run_verilator.sh - Fast Full-SoC Simulation (Verilator)
+#
+# Copyright (c) October 2025 Michael Wolak
+# Email: mikewolak@gmail.com, mike@epromfoundry.com
+#
+# NOT FOR COMMERCIAL USE
+# Educational and research purposes only
+#===============================================================================
+#
+# Usage: ./run_verilator.sh [firmware.elf|.hex|.bin] [simulator options]
+#        ./run_verilator.sh --restore CKPT [simulator options]
+#
+# Builds sim/verilator (if needed) and runs the firmware with the UART on a
+# pseudo-terminal linked at /tmp/ttyICE40. Connect with e.g.
+#   picocom -b 115200 /tmp/ttyICE40
+# or pass --stdio to use this terminal directly. See --help for all options.
+#===============================================================================
+
+set -e
+
+cd "$(dirname "$0")"
+
+# Options only (e.g. --restore CKPT): no firmware argument
+if [ $# -gt 0 ] && [ "${1#-}" != "$1" ]; then
+    FIRMWARE=""
+else
+    FIRMWARE=${1:-../firmware/interactive.elf}
+    shift || true
+fi
+
+echo "========================================="
+echo "Verilator Full-SoC Simulation"
+echo "========================================="
+
+if ! command -v ${VERILATOR:-verilator} >/dev/null 2>&1; then
+    echo "ERROR: verilator not found in PATH"
+    exit 1
+fi
+
+echo "Building simulator..."
+make -C verilator --no-print-directory
+
+if [ -n "$FIRMWARE" ]; then
+    echo "Running $FIRMWARE..."
+    exec verilator/obj_dir/Vsim_top "$FIRMWARE" "$@"
+fi
+exec verilator/obj_dir/Vsim_top "$@"
@@ -3,7 +3,7 @@
 // tb_bootloader_complete.sv
 //
 // Tests:
-// 1. Bootloader boots to 0x40000 and waits for 'r' command
+// 1. Bootloader boots to 0x80000 and waits for 'r' command
 // 2. UART protocol: send 'r\n', receive '@@@'
 // 3. Upload firmware (length + data + CRC32)
 // 4. Bootloader verifies CRC and sends 'OK\n'
@@ -15,7 +15,9 @@
 
 `timescale 1ns/1ps
 
-module tb_bootloader_complete;
+module tb_bootloader_complete #(
+    parameter VERBOSE = 0       // vsim -gVERBOSE=1 for per-access RTL $display
+);
 
     //==========================================================================
     // Clock and Reset
@@ -81,7 +83,10 @@ module tb_bootloader_complete;
     // DUT: Full Top-Level Design
     //==========================================================================
 
-    ice40_picorv32_top dut (
+    ice40_picorv32_top #(
+        .ENABLE_TRACE(1),
+        .VERBOSE(VERBOSE)
+    ) dut (
         .EXTCLK(clk_100mhz),
         .UART_RX(uart_rx),
         .UART_TX(uart_tx),
@@ -96,6 +101,14 @@ module tb_bootloader_complete;
         .SRAM_WE_N(sram_we_n)
     );
 
+    // Instruction trace, enabled with +trace=<file> (decode with tools/rvtrace)
+    trace_sink tracer (
+        .clk(dut.clk),
+        .resetn(dut.cpu_resetn),
+        .trace_valid(dut.cpu_trace_valid),
+        .trace_data(dut.cpu_trace_data)
+    );
+
     //==========================================================================
     // Clock Generation (100MHz)
     //==========================================================================
@@ -412,9 +425,18 @@ module tb_bootloader_complete;
 
     integer test_phase;
 
+    reg [1024*8-1:0] firmware_path;
+
     initial begin
-        $dumpfile("tb_bootloader_complete.vcd");
-        $dumpvars(0, tb_bootloader_complete);
+        // Full-design VCD is several GB for the 100 ms run: opt in with +vcd
+        if ($test$plusargs("vcd")) begin
+            $dumpfile("tb_bootloader_complete.vcd");
+            $dumpvars(0, tb_bootloader_complete);
+        end
+
+        // Firmware image (objcopy -O verilog), relative to sim/
+        if (!$value$plusargs("firmware=%s", firmware_path))
+            firmware_path = "../firmware/led_blink.hex";
 
         // Initialize signals
         resetn = 0;
@@ -442,7 +464,7 @@ module tb_bootloader_complete;
 
         // Wait for bootloader to initialize
         $display("[TB] Phase 1: Bootloader initialization");
-        $display("[TB] CPU should boot to 0x40000 and wait for 'r' command");
+        $display("[TB] CPU should boot to 0x80000 and wait for 'r' command");
         $display("[TB] LED1 should be ON (waiting for upload)");
 
         // Wait for LED1 to turn on (bootloader ready)
@@ -454,7 +476,7 @@ module tb_bootloader_complete;
         // Load firmware
         test_phase = 2;
         $display("\n[TB] Phase 2: Loading test firmware");
-        load_firmware_hex("/mnt/c/msys64/home/mwolak/olimex-ice40hx8k-riscv-intr/firmware/led_blink.hex");
+        load_firmware_hex(firmware_path);
 
         // Upload firmware
         test_phase = 3;
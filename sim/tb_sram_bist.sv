@@ -0,0 +1,470 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// tb_sram_bist.sv - SRAM BIST Engine Test
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//
+// DESCRIPTION:
+// Runs sram_bist against the real sram_driver_new and a behavioral SRAM with
+// fault injection, with sram_proc_new on the pass-through port.
+//
+// TESTS:
+// 1. ID register and bad-range rejection
+// 2. Clean 8 KB region: all tests pass, 5 clocks per access, neighbours kept
+// 3. Stuck-at-1 data bit: first failure in March element 1, error count
+// 4. Address alias (decoder ignores a line): March C- and address test
+// 5. Arbitration: sram_proc_new accesses before and during a run, no BIST
+//    access between the two halves of a 32-bit access
+//==============================================================================
+
+`timescale 1ns / 1ps
+
+module tb_sram_bist;
+
+    reg clk = 0;
+    reg resetn = 0;
+
+    always #10 clk = ~clk;  // 50 MHz
+
+    // Register offsets (base 0x80000040)
+    localparam BIST_BASE      = 32'h80000040;
+    localparam REG_CTRL       = 6'h00;
+    localparam REG_STATUS     = 6'h04;
+    localparam REG_START      = 6'h08;
+    localparam REG_END        = 6'h0C;
+    localparam REG_PATTERN    = 6'h10;
+    localparam REG_FAIL_ADDR  = 6'h14;
+    localparam REG_FAIL_DATA  = 6'h18;
+    localparam REG_ERRORS     = 6'h1C;
+    localparam REG_CYCLES     = 6'h20;
+    localparam REG_ID         = 6'h24;
+
+    localparam ST_BUSY  = 0;
+    localparam ST_DONE  = 1;
+    localparam ST_FAIL  = 2;
+    localparam ST_RANGE = 3;
+
+    localparam CMD_READ  = 8'h01;
+    localparam CMD_WRITE = 8'h02;
+
+    // sram_driver_new command interface (driven by sram_bist)
+    wire        drv_valid;
+    wire        drv_ready;
+    wire        drv_we;
+    wire [18:0] drv_addr;
+    wire [15:0] drv_wdata;
+    wire [15:0] drv_rdata;
+
+    //==========================================================================
+    // sram_proc_new (CPU side)
+    //==========================================================================
+    reg         proc_start = 0;
+    reg  [7:0]  proc_cmd = 0;
+    reg  [31:0] proc_addr = 0;
+    reg  [31:0] proc_data = 0;
+    wire        proc_busy;
+    wire        proc_done;
+    wire [31:0] proc_result;
+
+    wire        proc_valid16;
+    wire        proc_ready16;
+    wire        proc_we16;
+    wire [18:0] proc_addr16;
+    wire [15:0] proc_wdata16;
+
+    sram_proc_new proc (
+        .clk(clk),
+        .resetn(resetn),
+        .start(proc_start),
+        .cmd(proc_cmd),
+        .addr_in(proc_addr),
+        .data_in(proc_data),
+        .mem_wstrb(4'b1111),
+        .busy(proc_busy),
+        .done(proc_done),
+        .result(proc_result),
+        .result_low(),
+        .result_high(),
+        .rx_byte(8'h00),
+        .rx_valid(1'b0),
+        .tx_data(),
+        .tx_valid(),
+        .tx_ready(1'b1),
+        .sram_valid(proc_valid16),
+        .sram_ready(proc_ready16),
+        .sram_we(proc_we16),
+        .sram_addr_16(proc_addr16),
+        .sram_wdata_16(proc_wdata16),
+        .sram_rdata_16(drv_rdata)
+    );
+
+    //==========================================================================
+    // sram_bist (DUT)
+    //==========================================================================
+    reg         mmio_valid = 0;
+    reg         mmio_write = 0;
+    reg  [31:0] mmio_addr = 0;
+    reg  [31:0] mmio_wdata = 0;
+    wire [31:0] mmio_rdata;
+    wire        mmio_ready;
+
+    sram_bist dut (
+        .clk(clk),
+        .resetn(resetn),
+        .mmio_valid(mmio_valid),
+        .mmio_write(mmio_write),
+        .mmio_addr(mmio_addr),
+        .mmio_wdata(mmio_wdata),
+        .mmio_wstrb(4'b1111),
+        .mmio_rdata(mmio_rdata),
+        .mmio_ready(mmio_ready),
+        .proc_valid(proc_valid16),
+        .proc_busy(proc_busy),
+        .proc_ready(proc_ready16),
+        .proc_we(proc_we16),
+        .proc_addr(proc_addr16),
+        .proc_wdata(proc_wdata16),
+        .drv_valid(drv_valid),
+        .drv_ready(drv_ready),
+        .drv_we(drv_we),
+        .drv_addr(drv_addr),
+        .drv_wdata(drv_wdata),
+        .drv_rdata(drv_rdata)
+    );
+
+    //==========================================================================
+    // sram_driver_new + SRAM model with fault injection
+    //==========================================================================
+    wire [17:0] sram_addr;
+    wire [15:0] sram_data;
+    wire        sram_cs_n;
+    wire        sram_oe_n;
+    wire        sram_we_n;
+
+    sram_driver_new drv (
+        .clk(clk),
+        .resetn(resetn),
+        .valid(drv_valid),
+        .ready(drv_ready),
+        .we(drv_we),
+        .addr(drv_addr),
+        .wdata(drv_wdata),
+        .rdata(drv_rdata),
+        .sram_addr(sram_addr),
+        .sram_data(sram_data),
+        .sram_cs_n(sram_cs_n),
+        .sram_oe_n(sram_oe_n),
+        .sram_we_n(sram_we_n)
+    );
+
+    reg [15:0] sram_mem [0:262143];     // 256K x 16-bit
+    reg [15:0] sram_data_out;
+    reg        sram_data_oe;
+
+    // Faults: address lines the decoder ignores, one word with bits stuck at 1
+    reg [17:0] alias_mask = 18'h0;
+    reg [17:0] stuck_addr = 18'h0;
+    reg [15:0] stuck_bits = 16'h0;
+
+    wire [17:0] cell = sram_addr & ~alias_mask;
+
+    assign sram_data = (sram_data_oe && !sram_oe_n && !sram_cs_n) ? sram_data_out : 16'hzzzz;
+
+    always @(posedge clk) begin
+        if (!sram_cs_n && !sram_we_n)
+            sram_mem[cell] <= sram_data;
+    end
+
+    always @(*) begin
+        if (!sram_cs_n && !sram_oe_n && sram_we_n) begin
+            sram_data_out = sram_mem[cell] | ((cell == stuck_addr) ? stuck_bits : 16'h0);
+            sram_data_oe = 1'b1;
+        end else begin
+            sram_data_out = 16'hxxxx;
+            sram_data_oe = 1'b0;
+        end
+    end
+
+    //==========================================================================
+    // Helpers
+    //==========================================================================
+    integer errors = 0;
+    reg proc_finished = 0;
+    integer bist_end_time = -1;
+    integer proc_end_time = -1;
+
+    // Completion times: processor done pulse, BIST releasing the driver
+    always @(posedge clk) begin
+        if (proc_done) begin
+            proc_finished = 1;
+            proc_end_time = $time;
+        end
+    end
+
+    always @(negedge dut.owner)
+        bist_end_time = $time;
+
+    // BIST accesses that landed between the halves of a 32-bit processor
+    // access (after one half was accepted, before sram_proc_new went idle)
+    reg     proc_half_done = 0;
+    integer split_accesses = 0;
+    always @(posedge clk) begin
+        if (!proc_busy)
+            proc_half_done <= 1'b0;
+        else if (proc_valid16 && proc_ready16)
+            proc_half_done <= 1'b1;
+        if (dut.owner && drv_valid && drv_ready && proc_half_done)
+            split_accesses = split_accesses + 1;
+    end
+
+    task check;
+        input cond;
+        input [8*64-1:0] what;
+        begin
+            if (cond) begin
+                $display("  ok   %0s", what);
+            end else begin
+                $display("  FAIL %0s", what);
+                errors = errors + 1;
+            end
+        end
+    endtask
+
+    task mmio_wr;
+        input [5:0]  off;
+        input [31:0] data;
+        begin
+            @(negedge clk);
+            mmio_valid = 1;
+            mmio_write = 1;
+            mmio_addr = BIST_BASE + off;
+            mmio_wdata = data;
+            @(negedge clk);
+            mmio_valid = 0;
+            mmio_write = 0;
+        end
+    endtask
+
+    task mmio_rd;
+        input  [5:0]  off;
+        output [31:0] data;
+        begin
+            @(negedge clk);
+            mmio_valid = 1;
+            mmio_write = 0;
+            mmio_addr = BIST_BASE + off;
+            #1 data = mmio_rdata;
+            @(negedge clk);
+            mmio_valid = 0;
+        end
+    endtask
+
+    // Start a run; returns once the CTRL write has been taken
+    task bist_start;
+        input [31:0] start_addr;
+        input [31:0] end_addr;
+        input [2:0]  mask;
+        input [15:0] pattern;
+        begin
+            mmio_wr(REG_START, start_addr);
+            mmio_wr(REG_END, end_addr);
+            mmio_wr(REG_PATTERN, {16'h0, pattern});
+            mmio_wr(REG_CTRL, {25'h0, mask, 4'h1});
+        end
+    endtask
+
+    task bist_wait;
+        reg [31:0] st;
+        integer n;
+        begin
+            n = 0;
+            st = 32'h1;
+            while (st[ST_BUSY] && n < 2000000) begin
+                repeat (64) @(negedge clk);
+                mmio_rd(REG_STATUS, st);
+                n = n + 64;
+            end
+            if (st[ST_BUSY]) begin
+                $display("*** TIMEOUT waiting for the BIST");
+                $finish;
+            end
+        end
+    endtask
+
+    task bist_run;
+        input [31:0] start_addr;
+        input [31:0] end_addr;
+        input [2:0]  mask;
+        input [15:0] pattern;
+        begin
+            bist_start(start_addr, end_addr, mask, pattern);
+            bist_wait;
+        end
+    endtask
+
+    task proc_op;
+        input  [7:0]  cmd;
+        input  [31:0] addr;
+        input  [31:0] data;
+        begin
+            @(negedge clk);
+            proc_finished = 0;
+            proc_cmd = cmd;
+            proc_addr = addr;
+            proc_data = data;
+            proc_start = 1;
+            @(negedge clk);
+            proc_start = 0;
+        end
+    endtask
+
+    task proc_wait;
+        begin
+            while (!proc_finished) @(negedge clk);
+        end
+    endtask
+
+    // Accesses per word: March C- 10, walking 4, address 4
+    function integer ops_per_word;
+        input [2:0] mask;
+        begin
+            ops_per_word = (mask[0] ? 10 : 0) + (mask[1] ? 4 : 0) + (mask[2] ? 4 : 0);
+        end
+    endfunction
+
+    //==========================================================================
+    // Tests
+    //==========================================================================
+    reg [31:0] st, v, cyc;
+    integer i, ops;
+
+    initial begin
+        for (i = 0; i < 262144; i = i + 1)
+            sram_mem[i] = 16'h0000;
+
+        $display("");
+        $display("========================================");
+        $display("SRAM BIST ENGINE TEST");
+        $display("========================================");
+
+        repeat (5) @(negedge clk);
+        resetn = 1;
+        repeat (5) @(negedge clk);
+
+        // ---------------------------------------------------------------------
+        $display("\n[1] ID and range check");
+        mmio_rd(REG_ID, v);
+        check(v == 32'h42495354, "ID reads 0x42495354");
+        bist_start(32'h4000, 32'h2000, 3'b111, 16'h0);
+        mmio_rd(REG_STATUS, st);
+        check(st[ST_RANGE] && st[ST_DONE] && !st[ST_BUSY], "start >= end rejected (RANGE, not BUSY)");
+
+        // ---------------------------------------------------------------------
+        $display("\n[2] Clean 8 KB region, all tests");
+        sram_mem[18'h00FFF] = 16'hA5A5;     // Words just outside the range
+        sram_mem[18'h02000] = 16'h5A5A;
+        bist_run(32'h2000, 32'h4000, 3'b000, 16'h0000);
+        mmio_rd(REG_STATUS, st);
+        mmio_rd(REG_ERRORS, v);
+        mmio_rd(REG_CYCLES, cyc);
+        ops = 4096 * ops_per_word(3'b111);
+        check(st[ST_DONE] && !st[ST_FAIL] && !st[ST_RANGE], "DONE, no failure");
+        check(v == 0, "ERRORS = 0");
+        check(cyc >= 5 * ops && cyc <= 5 * ops + 4, "5 clocks per access");
+        $display("       %0d accesses in %0d cycles (%0d.%02d clocks/access)",
+                 ops, cyc, cyc / ops, (cyc % ops) * 100 / ops);
+        check(sram_mem[18'h00FFF] == 16'hA5A5 && sram_mem[18'h02000] == 16'h5A5A,
+              "words outside the range untouched");
+        check(sram_mem[18'h01234] == 16'hFB72, "region left holding ~w[17:2]");
+
+        // Background pattern: checkerboard
+        bist_run(32'h2000, 32'h4000, 3'b001, 16'h5555);
+        mmio_rd(REG_STATUS, st);
+        check(st[ST_DONE] && !st[ST_FAIL], "March C- with background 0x5555");
+
+        // ---------------------------------------------------------------------
+        $display("\n[3] Stuck-at-1 bit 5 at word 0x01034");
+        stuck_addr = 18'h01034;
+        stuck_bits = 16'h0020;
+        bist_run(32'h2000, 32'h4000, 3'b111, 16'h0000);
+        mmio_rd(REG_STATUS, st);
+        check(st[ST_DONE] && st[ST_FAIL], "fault detected");
+        check(st[11:8] == 4'd1, "first failure in March element 1 (r0,w1)");
+        mmio_rd(REG_FAIL_ADDR, v);
+        check(v == 32'h2068, "FAIL_ADDR = 0x2068");
+        mmio_rd(REG_FAIL_DATA, v);
+        check(v == 32'h00000020, "FAIL_DATA = expected 0x0000, read 0x0020");
+        mmio_rd(REG_ERRORS, v);
+        check(v == 4, "ERRORS = 4 (three March reads of 0, walking-one read)");
+        stuck_bits = 16'h0;
+
+        // ---------------------------------------------------------------------
+        $display("\n[4] Address alias: decoder ignores word address bit 8");
+        alias_mask = 18'h00100;
+        bist_run(32'h2000, 32'h2400, 3'b001, 16'h0000);
+        mmio_rd(REG_STATUS, st);
+        check(st[ST_FAIL] && st[11:8] == 4'd1, "March C- detects it in element 1");
+        mmio_rd(REG_FAIL_ADDR, v);
+        check(v == 32'h2200, "FAIL_ADDR = 0x2200 (first aliased word)");
+        mmio_rd(REG_FAIL_DATA, v);
+        check(v == 32'h0000FFFF, "FAIL_DATA = expected 0x0000, read 0xFFFF");
+
+        bist_run(32'h2000, 32'h2400, 3'b100, 16'h0000);
+        mmio_rd(REG_STATUS, st);
+        check(st[ST_FAIL] && st[11:8] == 4'd11, "address test detects it on its first read pass");
+        mmio_rd(REG_FAIL_ADDR, v);
+        check(v == 32'h2000, "FAIL_ADDR = 0x2000");
+        mmio_rd(REG_FAIL_DATA, v);
+        check(v == 32'h10001100, "FAIL_DATA = expected 0x1000, read 0x1100");
+        alias_mask = 18'h0;
+
+        // ---------------------------------------------------------------------
+        $display("\n[5] Arbitration with sram_proc_new");
+
+        // Processor write in flight when the run starts
+        fork
+            proc_op(CMD_WRITE, 32'h00040000, 32'hCAFEBABE);
+            begin
+                repeat (3) @(negedge clk);
+                bist_start(32'h2000, 32'h4000, 3'b010, 16'h0000);
+            end
+        join
+        proc_wait;
+        bist_wait;
+        mmio_rd(REG_STATUS, st);
+        check(st[ST_DONE] && !st[ST_FAIL], "run after a processor access is clean");
+        check(split_accesses == 0, "BIST waits for both halves of the write");
+
+        // Processor access while the BIST owns the driver: waits for it
+        bist_end_time = -1;
+        bist_start(32'h2000, 32'h4000, 3'b010, 16'h0000);
+        repeat (20) @(negedge clk);
+        proc_op(CMD_READ, 32'h00040000, 32'h0);
+        proc_wait;
+        check(bist_end_time > 0 && proc_end_time > bist_end_time, "processor read completes after the run");
+        check(proc_result == 32'hCAFEBABE, "processor read returns 0xCAFEBABE");
+        check(sram_mem[18'h20000] == 16'hBABE && sram_mem[18'h20001] == 16'hCAFE,
+              "processor write landed in SRAM");
+
+        // ---------------------------------------------------------------------
+        $display("");
+        $display("========================================");
+        if (errors == 0)
+            $display("*** ALL SRAM BIST TESTS PASSED ***");
+        else
+            $display("*** %0d SRAM BIST CHECK(S) FAILED ***", errors);
+        $display("========================================");
+        $finish;
+    end
+
+    initial begin
+        #200_000_000;
+        $display("*** TIMEOUT");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,694 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// tb_sram_fused32.sv - Fused 32-bit SRAM Engine Test and Cycles-per-Word Report
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//
+// DESCRIPTION:
+// Runs the same access patterns through the default datapath
+// (sram_proc_new + sram_driver_new) and through sram_fused32, each on its
+// own K6R4016 model that checks the datasheet timing at 0.5 ns resolution.
+// Commands are spaced the way mem_controller spaces them (next start seen
+// four clocks after done).
+//
+// TESTS (both engines):
+// 1. Word stores, sequential
+// 2. Sequential loads (instruction-fetch-like)
+// 3. Random loads
+// 4. Byte and halfword stores (read-modify-write)
+// 5. Fetch/store mix, including stores to the word being read ahead
+// 6. CMD_CRC over 1 KB, checked against a reference CRC
+// 7. Final SRAM contents, untouched guard words
+// Timing: no datasheet violation, no bus contention, fused write margins
+// (tAS, tWR, tDH) of at least one half clock.
+//==============================================================================
+
+`timescale 1ns / 1ps
+
+//==============================================================================
+// K6R4016V1D-10 model with timing checks
+//
+// Samples the pins every 0.5 ns between clock edges. Read data is valid
+// max(tAA, tACS, tOE) after the last change and held for tOH after an
+// address change; the outputs stay on for tHZ after CS#/OE# rise. A write
+// (CS# and WE# both low) stores the bus value sampled just before it ends.
+//==============================================================================
+module sram_timing_model (
+    input wire [17:0] addr,
+    inout wire [15:0] data,
+    input wire        cs_n,
+    input wire        oe_n,
+    input wire        we_n,
+    input wire        ctrl_oe           // Controller driving SD (probe)
+);
+
+    // Datasheet limits (-10 speed grade), ns
+    localparam real T_RC  = 10.0;       // Read cycle, min
+    localparam real T_AA  = 10.0;       // Address access, max
+    localparam real T_ACS = 10.0;       // CS# access, max
+    localparam real T_OE  = 5.0;        // OE# access, max
+    localparam real T_OH  = 3.0;        // Output hold from address change, min
+    localparam real T_HZ  = 5.0;        // CS#/OE# high to Hi-Z, max
+    localparam real T_AS  = 0.0;        // Address setup to write start, min
+    localparam real T_AW  = 7.0;        // Address valid to write end, min
+    localparam real T_WP  = 7.0;        // Write pulse, min
+    localparam real T_DW  = 5.0;        // Data valid to write end, min
+    localparam real T_DH  = 0.0;        // Data hold from write end, min
+    localparam real T_WR  = 0.0;        // Write recovery, min
+
+    localparam real NONE = 1.0e9;
+
+    reg [15:0] mem [0:262143];
+
+    reg [15:0] q = 16'hxxxx;
+    reg        q_en = 1'b0;
+    assign data = q_en ? q : 16'hzzzz;
+
+    integer violations = 0;
+    integer contention = 0;
+    integer writes = 0;
+
+    real min_rc = NONE, min_as = NONE, min_aw = NONE, min_wp = NONE;
+    real min_dw = NONE, min_dh = NONE, min_wr = NONE, min_turn = NONE;
+
+    // Previous sample
+    reg [17:0] p_addr = 18'h0;
+    reg [15:0] p_data = 16'hzzzz;
+    reg        p_cs_n = 1'b1, p_oe_n = 1'b1, p_we_n = 1'b1, p_ctrl_oe = 1'b0, p_q_en = 1'b0;
+
+    real t_addr = -1000.0, t_data = -1000.0, t_cs = -1000.0, t_oe = -1000.0;
+    real t_wr_start = -1000.0, t_wr_end = -1000.0, t_rd_end = -1000.0;
+    real t_q_off = -1000.0, t_ctrl_off = -1000.0;
+    reg  wait_wr = 1'b0, wait_dh = 1'b0;
+    reg  [15:0] hold_val = 16'hxxxx;
+
+    // Records the smallest value seen, counts it if below the limit
+    function real track;
+        input [8*8-1:0] name;
+        input real value;
+        input real limit;
+        input real worst;
+        begin
+            if (value < limit - 0.01) begin
+                violations = violations + 1;
+                if (violations <= 10)
+                    $display("  [%m] %0s violation at %0t: %0.2f ns < %0.2f ns", name, $time, value, limit);
+            end
+            track = (value < worst) ? value : worst;
+        end
+    endfunction
+
+    task poll;
+        real now, old_t_addr, old_t_data, valid_at;
+        reg wr, p_wr, rd, p_rd, addr_chg, data_chg;
+        begin
+            now = $realtime;
+            wr = !cs_n && !we_n;
+            p_wr = !p_cs_n && !p_we_n;
+            rd = !cs_n && !oe_n && we_n;
+            p_rd = !p_cs_n && !p_oe_n && p_we_n;
+            addr_chg = (addr !== p_addr);
+            data_chg = (ctrl_oe !== p_ctrl_oe) || (ctrl_oe && data !== p_data);
+            old_t_addr = t_addr;
+            old_t_data = t_data;
+
+            if (!cs_n && p_cs_n) t_cs = now;
+            if (!oe_n && p_oe_n) t_oe = now;
+
+            if (addr_chg) begin
+                if (p_wr && wr) begin
+                    violations = violations + 1;
+                    $display("  [%m] address changed during a write at %0t", $time);
+                end
+                if (wait_wr) begin
+                    min_wr = track("tWR", now - t_wr_end, T_WR, min_wr);
+                    wait_wr = 1'b0;
+                end
+                if (p_rd && rd)
+                    min_rc = track("tRC", now - t_addr, T_RC, min_rc);
+                hold_val = q;
+                t_addr = now;
+            end
+
+            if (data_chg) begin
+                if (wait_dh) begin
+                    min_dh = track("tDH", now - t_wr_end, T_DH, min_dh);
+                    wait_dh = 1'b0;
+                end
+                t_data = now;
+            end
+
+            // Write start / end (overlap of CS# and WE# low)
+            if (wr && !p_wr) begin
+                t_wr_start = now;
+                min_as = track("tAS", now - t_addr, T_AS, min_as);
+            end
+            if (p_wr && !wr) begin
+                min_wp = track("tWP", now - t_wr_start, T_WP, min_wp);
+                min_aw = track("tAW", now - (addr_chg ? old_t_addr : t_addr), T_AW, min_aw);
+                min_dw = track("tDW", now - (data_chg ? old_t_data : t_data), T_DW, min_dw);
+                if (!p_ctrl_oe || ^p_data === 1'bx) begin
+                    violations = violations + 1;
+                    $display("  [%m] write with SD not driven at %0t", $time);
+                end
+                mem[p_addr] = p_data;
+                writes = writes + 1;
+                t_wr_end = now;
+                if (addr_chg) min_wr = track("tWR", 0.0, T_WR, min_wr); else wait_wr = 1'b1;
+                if (data_chg) min_dh = track("tDH", 0.0, T_DH, min_dh); else wait_dh = 1'b1;
+            end
+
+            // Read outputs
+            if (rd) begin
+                if (!p_rd)
+                    hold_val = 16'hxxxx;
+                valid_at = t_addr + T_AA;
+                if (t_cs + T_ACS > valid_at) valid_at = t_cs + T_ACS;
+                if (t_oe + T_OE > valid_at) valid_at = t_oe + T_OE;
+                if (now >= valid_at)
+                    q = mem[addr];
+                else if (now < t_addr + T_OH)
+                    q = hold_val;
+                else
+                    q = 16'hxxxx;
+                q_en = 1'b1;
+            end else begin
+                if (p_rd)
+                    t_rd_end = now;
+                if (q_en && now >= t_rd_end + T_HZ)
+                    q_en = 1'b0;
+            end
+
+            // Bus ownership
+            if (q_en && !p_q_en && t_ctrl_off > -1000.0)
+                min_turn = track("turn", now - t_ctrl_off, 0.0, min_turn);
+            if (ctrl_oe && !p_ctrl_oe && t_q_off > -1000.0)
+                min_turn = track("turn", now - t_q_off, 0.0, min_turn);
+            if (!q_en && p_q_en) t_q_off = now;
+            if (!ctrl_oe && p_ctrl_oe) t_ctrl_off = now;
+            if (q_en && ctrl_oe) begin
+                contention = contention + 1;
+                if (contention == 1)
+                    $display("  [%m] bus contention at %0t", $time);
+            end
+
+            p_addr = addr;
+            p_data = data;
+            p_cs_n = cs_n;
+            p_oe_n = oe_n;
+            p_we_n = we_n;
+            p_ctrl_oe = ctrl_oe;
+            p_q_en = q_en;
+        end
+    endtask
+
+    // Sample between clock edges (edges fall on whole nanoseconds)
+    initial begin
+        #0.25;
+        forever begin
+            poll;
+            #0.5;
+        end
+    end
+
+endmodule
+
+//==============================================================================
+// Testbench
+//==============================================================================
+module tb_sram_fused32;
+
+    reg clk = 0;
+    reg resetn = 0;
+
+    always #10 clk = ~clk;  // 50 MHz
+
+    localparam CMD_READ  = 8'h01;
+    localparam CMD_WRITE = 8'h02;
+    localparam CMD_CRC   = 8'h04;
+
+    localparam BASE  = 32'h00002000;    // Test region, 4 KB
+    localparam WORDS = 1024;
+    localparam GAP   = 2;               // mem_controller: next start 4 clocks after done
+    localparam NPAT  = 6;
+
+    // Shared command bus; sel picks the engine that sees start
+    reg         sel = 0;                // 0 = sram_proc_new + sram_driver_new, 1 = sram_fused32
+    reg         start = 0;
+    reg  [7:0]  cmd = 0;
+    reg  [31:0] addr = 0;
+    reg  [31:0] wdata = 0;
+    reg  [3:0]  wstrb = 0;
+
+    wire        b_done, f_done;
+    wire [31:0] b_result, f_result;
+    wire        done = sel ? f_done : b_done;
+    wire [31:0] result = sel ? f_result : b_result;
+
+    //==========================================================================
+    // Baseline: sram_proc_new + sram_driver_new
+    //==========================================================================
+    wire        b_valid16, b_ready16, b_we16;
+    wire [18:0] b_addr16;
+    wire [15:0] b_wdata16, b_rdata16;
+
+    wire [17:0] b_sa;
+    wire [15:0] b_sd;
+    wire        b_cs_n, b_oe_n, b_we_n;
+
+    sram_proc_new base_proc (
+        .clk(clk),
+        .resetn(resetn),
+        .start(start && !sel),
+        .cmd(cmd),
+        .addr_in(addr),
+        .data_in(wdata),
+        .mem_wstrb(wstrb),
+        .busy(),
+        .done(b_done),
+        .result(b_result),
+        .result_low(),
+        .result_high(),
+        .rx_byte(8'h00),
+        .rx_valid(1'b0),
+        .tx_data(),
+        .tx_valid(),
+        .tx_ready(1'b1),
+        .sram_valid(b_valid16),
+        .sram_ready(b_ready16),
+        .sram_we(b_we16),
+        .sram_addr_16(b_addr16),
+        .sram_wdata_16(b_wdata16),
+        .sram_rdata_16(b_rdata16)
+    );
+
+    sram_driver_new base_drv (
+        .clk(clk),
+        .resetn(resetn),
+        .valid(b_valid16),
+        .ready(b_ready16),
+        .we(b_we16),
+        .addr(b_addr16),
+        .wdata(b_wdata16),
+        .rdata(b_rdata16),
+        .sram_addr(b_sa),
+        .sram_data(b_sd),
+        .sram_cs_n(b_cs_n),
+        .sram_oe_n(b_oe_n),
+        .sram_we_n(b_we_n)
+    );
+
+    wire b_ctrl_oe = base_drv.data_oe;
+
+    sram_timing_model base_mem (
+        .addr(b_sa),
+        .data(b_sd),
+        .cs_n(b_cs_n),
+        .oe_n(b_oe_n),
+        .we_n(b_we_n),
+        .ctrl_oe(b_ctrl_oe)
+    );
+
+    //==========================================================================
+    // DUT: sram_fused32
+    //==========================================================================
+    wire [17:0] f_sa;
+    wire [15:0] f_sd;
+    wire        f_cs_n, f_oe_n, f_we_n;
+
+    sram_fused32 fused (
+        .clk(clk),
+        .resetn(resetn),
+        .start(start && sel),
+        .cmd(cmd),
+        .addr_in(addr),
+        .data_in(wdata),
+        .mem_wstrb(wstrb),
+        .busy(),
+        .done(f_done),
+        .result(f_result),
+        .result_low(),
+        .result_high(),
+        .rx_byte(8'h00),
+        .rx_valid(1'b0),
+        .tx_data(),
+        .tx_valid(),
+        .tx_ready(1'b1),
+        .sram_addr(f_sa),
+        .sram_data(f_sd),
+        .sram_cs_n(f_cs_n),
+        .sram_oe_n(f_oe_n),
+        .sram_we_n(f_we_n)
+    );
+
+    wire f_ctrl_oe = fused.data_oe;
+
+    sram_timing_model fused_mem (
+        .addr(f_sa),
+        .data(f_sd),
+        .cs_n(f_cs_n),
+        .oe_n(f_oe_n),
+        .we_n(f_we_n),
+        .ctrl_oe(f_ctrl_oe)
+    );
+
+    //==========================================================================
+    // Helpers
+    //==========================================================================
+    integer errors = 0;
+    integer mismatches = 0;
+    integer cycle = 0;
+
+    always @(posedge clk) cycle <= cycle + 1;
+
+    reg [31:0] ref_mem [0:1][0:WORDS-1];
+    integer    cyc [0:1][0:NPAT-1];
+    integer    ops [0:NPAT-1];
+    reg [31:0] crc_result [0:1];
+    reg [31:0] rng;
+
+    task check;
+        input cond;
+        input [8*72-1:0] what;
+        begin
+            if (cond) begin
+                $display("  ok   %0s", what);
+            end else begin
+                $display("  FAIL %0s", what);
+                errors = errors + 1;
+            end
+        end
+    endtask
+
+    // xorshift32, reseeded per engine so both see the same sequence
+    function [31:0] next_rand;
+        input [31:0] x;
+        reg [31:0] y;
+        begin
+            y = x ^ (x << 13);
+            y = y ^ (y >> 17);
+            next_rand = y ^ (y << 5);
+        end
+    endfunction
+
+    task rand32;
+        output [31:0] v;
+        begin
+            rng = next_rand(rng);
+            v = rng;
+        end
+    endtask
+
+    function [31:0] crc32_update;
+        input [31:0] crc;
+        input [31:0] data;
+        integer i;
+        reg [31:0] c;
+        begin
+            c = crc;
+            for (i = 0; i < 32; i = i + 1)
+                c = (c[0] ^ data[i]) ? (c >> 1) ^ 32'hEDB88320 : (c >> 1);
+            crc32_update = c;
+        end
+    endfunction
+
+    // One mem_controller-style command: start for one clock, wait for done
+    task op;
+        input  [7:0]  c;
+        input  [31:0] a;
+        input  [31:0] d;
+        input  [3:0]  s;
+        output [31:0] r;
+        integer waited;
+        begin
+            @(negedge clk);
+            cmd = c;
+            addr = a;
+            wdata = d;
+            wstrb = s;
+            start = 1;
+            @(negedge clk);
+            start = 0;
+            waited = 0;
+            while (!done && waited < 5000) begin
+                @(negedge clk);
+                waited = waited + 1;
+            end
+            if (!done) begin
+                $display("  [engine %0d] no done for cmd 0x%02x addr 0x%08x", sel, c, a);
+                errors = errors + 1;
+            end
+            r = result;
+            repeat (GAP) @(negedge clk);
+        end
+    endtask
+
+    task store;
+        input [9:0]  w;
+        input [31:0] d;
+        input [3:0]  s;
+        reg [31:0] r;
+        begin
+            op(CMD_WRITE, BASE + {w, 2'b00}, d, s, r);
+            if (s[0]) ref_mem[sel][w][7:0]   = d[7:0];
+            if (s[1]) ref_mem[sel][w][15:8]  = d[15:8];
+            if (s[2]) ref_mem[sel][w][23:16] = d[23:16];
+            if (s[3]) ref_mem[sel][w][31:24] = d[31:24];
+        end
+    endtask
+
+    task load;
+        input [9:0] w;
+        reg [31:0] r;
+        begin
+            op(CMD_READ, BASE + {w, 2'b00}, 32'h0, 4'b0000, r);
+            if (r !== ref_mem[sel][w]) begin
+                mismatches = mismatches + 1;
+                if (mismatches <= 10)
+                    $display("  [engine %0d] load 0x%08x = 0x%08x, expected 0x%08x",
+                             sel, BASE + {w, 2'b00}, r, ref_mem[sel][w]);
+            end
+        end
+    endtask
+
+    // Partial store strobes: bytes and aligned halves
+    function [3:0] partial_strobe;
+        input [2:0] k;
+        begin
+            case (k)
+                3'd0: partial_strobe = 4'b0001;
+                3'd1: partial_strobe = 4'b0010;
+                3'd2: partial_strobe = 4'b0100;
+                3'd3: partial_strobe = 4'b1000;
+                3'd4: partial_strobe = 4'b0011;
+                default: partial_strobe = 4'b1100;
+            endcase
+        end
+    endfunction
+
+    // All patterns on the engine picked by sel
+    task run_patterns;
+        integer i, j, c0;
+        reg [31:0] v, a, r, crc;
+        begin
+            rng = 32'h1BADB002;
+
+            // 1. Word stores, sequential
+            c0 = cycle;
+            for (i = 0; i < 256; i = i + 1) begin
+                rand32(v);
+                store(i, v, 4'b1111);
+            end
+            cyc[sel][0] = cycle - c0;
+            ops[0] = 256;
+
+            // 2. Sequential loads
+            c0 = cycle;
+            for (i = 0; i < 512; i = i + 1)
+                load(i);
+            cyc[sel][1] = cycle - c0;
+            ops[1] = 512;
+
+            // 3. Random loads
+            c0 = cycle;
+            for (i = 0; i < 256; i = i + 1) begin
+                rand32(a);
+                load(a[9:0]);
+            end
+            cyc[sel][2] = cycle - c0;
+            ops[2] = 256;
+
+            // 4. Byte and halfword stores
+            c0 = cycle;
+            for (i = 0; i < 192; i = i + 1) begin
+                rand32(a);
+                rand32(v);
+                store(a[9:0], v, partial_strobe(a[12:10] % 6));
+            end
+            cyc[sel][3] = cycle - c0;
+            ops[3] = 192;
+
+            // 5. Fetch/store mix: runs of three sequential loads, then a store
+            //    that every fourth time hits the word after the run (the one
+            //    being read ahead), then a load of that word
+            c0 = cycle;
+            for (i = 0; i < 64; i = i + 1) begin
+                rand32(a);
+                for (j = 0; j < 3; j = j + 1)
+                    load(a[9:0] + j);
+                rand32(v);
+                if (i % 4 == 0) begin
+                    store(a[9:0] + 3, v, (i % 8 == 0) ? 4'b1111 : 4'b0100);
+                    load(a[9:0] + 3);
+                end else begin
+                    store(v[25:16], v, 4'b1111);
+                    load(v[25:16]);
+                end
+            end
+            cyc[sel][4] = cycle - c0;
+            ops[4] = 64 * 5;
+
+            // 6. CRC over 1 KB
+            crc = 32'hFFFFFFFF;
+            for (i = 0; i < 256; i = i + 1)
+                crc = crc32_update(crc, ref_mem[sel][i]);
+            c0 = cycle;
+            op(CMD_CRC, BASE, BASE + 32'h400, 4'b0000, r);
+            cyc[sel][5] = cycle - c0;
+            ops[5] = 256;
+            crc_result[sel] = r;
+            check(r == ~crc, "CRC32 over 1 KB matches the reference");
+        end
+    endtask
+
+    task print_margin;
+        input [8*4-1:0] name;
+        input real limit;
+        input real b;
+        input real f;
+        begin
+            if (b >= 1.0e8 && f >= 1.0e8)
+                $display("  %0s   >= %4.1f      n/a        n/a", name, limit);
+            else if (b >= 1.0e8)
+                $display("  %0s   >= %4.1f      n/a     %6.1f", name, limit, f);
+            else if (f >= 1.0e8)
+                $display("  %0s   >= %4.1f   %6.1f        n/a", name, limit, b);
+            else
+                $display("  %0s   >= %4.1f   %6.1f     %6.1f", name, limit, b, f);
+        end
+    endtask
+
+    //==========================================================================
+    // Test sequence
+    //==========================================================================
+    integer i, bad;
+    reg [31:0] v;
+    real b_cpw, f_cpw;
+
+    initial begin
+        $display("========================================");
+        $display("SRAM Fused 32-bit Engine Test");
+        $display("========================================");
+
+        // Same contents in both SRAMs and both reference copies
+        rng = 32'hC0FFEE01;
+        for (i = 0; i < WORDS; i = i + 1) begin
+            rand32(v);
+            ref_mem[0][i] = v;
+            ref_mem[1][i] = v;
+            base_mem.mem[18'h01000 + 2*i]     = v[15:0];
+            base_mem.mem[18'h01000 + 2*i + 1] = v[31:16];
+            fused_mem.mem[18'h01000 + 2*i]     = v[15:0];
+            fused_mem.mem[18'h01000 + 2*i + 1] = v[31:16];
+        end
+        base_mem.mem[18'h00FFF]  = 16'hA5A5;
+        base_mem.mem[18'h01800]  = 16'h5A5A;
+        fused_mem.mem[18'h00FFF] = 16'hA5A5;
+        fused_mem.mem[18'h01800] = 16'h5A5A;
+
+        repeat (5) @(posedge clk);
+        resetn = 1;
+        repeat (5) @(posedge clk);
+
+        for (i = 0; i < 2; i = i + 1) begin
+            sel = i;
+            mismatches = 0;
+            $display("\n[%0d] %0s", i + 1, i ? "sram_fused32" : "sram_proc_new + sram_driver_new");
+            run_patterns;
+            check(mismatches == 0, "all loads return the stored data");
+            errors = errors + mismatches;
+        end
+
+        // ---------------------------------------------------------------------
+        $display("\n[3] SRAM contents and timing");
+        bad = 0;
+        for (i = 0; i < WORDS; i = i + 1) begin
+            if ({base_mem.mem[18'h01000 + 2*i + 1], base_mem.mem[18'h01000 + 2*i]} !== ref_mem[0][i])
+                bad = bad + 1;
+            if ({fused_mem.mem[18'h01000 + 2*i + 1], fused_mem.mem[18'h01000 + 2*i]} !== ref_mem[1][i])
+                bad = bad + 1;
+        end
+        check(bad == 0, "both SRAMs hold the reference contents");
+        check(base_mem.mem[18'h00FFF] == 16'hA5A5 && base_mem.mem[18'h01800] == 16'h5A5A &&
+              fused_mem.mem[18'h00FFF] == 16'hA5A5 && fused_mem.mem[18'h01800] == 16'h5A5A,
+              "guard words outside the region untouched");
+        check(crc_result[0] == crc_result[1], "both engines return the same CRC");
+        check(base_mem.violations == 0, "baseline: no datasheet timing violations");
+        check(fused_mem.violations == 0, "fused: no datasheet timing violations");
+        check(base_mem.contention == 0 && fused_mem.contention == 0, "no bus contention");
+        check(fused_mem.min_as >= 10.0 && fused_mem.min_wr >= 10.0 && fused_mem.min_dh >= 10.0,
+              "fused: tAS, tWR, tDH at least 10 ns");
+        check(fused_mem.min_wp >= 10.0 && fused_mem.min_dw >= 20.0,
+              "fused: tWP at least 10 ns, tDW at least 20 ns");
+
+        // ---------------------------------------------------------------------
+        $display("");
+        $display("Cycles per word (50 MHz, mem_controller spacing included)");
+        $display("  pattern                 ops   baseline    fused   speedup");
+        for (i = 0; i < NPAT; i = i + 1) begin
+            b_cpw = cyc[0][i] * 1.0 / ops[i];
+            f_cpw = cyc[1][i] * 1.0 / ops[i];
+            case (i)
+                0: $display("  word store            %5d   %8.2f  %7.2f   %6.2fx", ops[i], b_cpw, f_cpw, b_cpw / f_cpw);
+                1: $display("  sequential load       %5d   %8.2f  %7.2f   %6.2fx", ops[i], b_cpw, f_cpw, b_cpw / f_cpw);
+                2: $display("  random load           %5d   %8.2f  %7.2f   %6.2fx", ops[i], b_cpw, f_cpw, b_cpw / f_cpw);
+                3: $display("  byte/half store       %5d   %8.2f  %7.2f   %6.2fx", ops[i], b_cpw, f_cpw, b_cpw / f_cpw);
+                4: $display("  fetch/store mix       %5d   %8.2f  %7.2f   %6.2fx", ops[i], b_cpw, f_cpw, b_cpw / f_cpw);
+                default: $display("  CRC32 (per word)      %5d   %8.2f  %7.2f   %6.2fx", ops[i], b_cpw, f_cpw, b_cpw / f_cpw);
+            endcase
+        end
+
+        $display("");
+        $display("Minimum observed SRAM timing (ns)");
+        $display("  param  limit    baseline    fused");
+        print_margin("tRC ",  10.0, base_mem.min_rc,   fused_mem.min_rc);
+        print_margin("tAS ",   0.0, base_mem.min_as,   fused_mem.min_as);
+        print_margin("tAW ",   7.0, base_mem.min_aw,   fused_mem.min_aw);
+        print_margin("tWP ",   7.0, base_mem.min_wp,   fused_mem.min_wp);
+        print_margin("tDW ",   5.0, base_mem.min_dw,   fused_mem.min_dw);
+        print_margin("tDH ",   0.0, base_mem.min_dh,   fused_mem.min_dh);
+        print_margin("tWR ",   0.0, base_mem.min_wr,   fused_mem.min_wr);
+        print_margin("turn", 0.0, base_mem.min_turn, fused_mem.min_turn);
+
+        // ---------------------------------------------------------------------
+        $display("");
+        $display("========================================");
+        if (errors == 0)
+            $display("*** ALL SRAM FUSED32 TESTS PASSED ***");
+        else
+            $display("*** %0d SRAM FUSED32 CHECK(S) FAILED ***", errors);
+        $display("========================================");
+        $finish;
+    end
+
+    initial begin
+        #200_000_000;
+        $display("*** TIMEOUT");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,435 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// tb_uart_flow.sv - UART RTS/CTS Flow Control and Streaming Upload Test
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//
+// DESCRIPTION:
+// uart.v and the 256-byte circular_buffer wired as in ice40_picorv32_top,
+// run at 1 Mbaud to keep the simulation short. The host model stops
+// starting bytes while its CTS# (the FPGA's RTS#) is high, seen three byte
+// times late like a USB-serial bridge. The target model is the bootloader's
+// streaming receive loop, slower than the line and with periodic stalls.
+//
+// TESTS:
+// 1. RTS# low after reset with an empty FIFO
+// 2. Streaming upload ('S', size, image, 'C' + CRC, no chunk ACKs):
+//    no byte dropped, CRC matches, RTS# throttled the host
+// 3. Same stream with a host that ignores CTS#: FIFO overruns
+// 4. CTS# into the target: TX holds a byte until CTS# falls and never cuts
+//    a byte in progress
+//==============================================================================
+
+`timescale 1ns / 1ps
+
+module tb_uart_flow;
+
+    reg clk = 0;
+    reg resetn = 0;
+
+    always #10 clk = ~clk;  // 50 MHz
+
+    localparam BIT_NS   = 960;          // 48 clocks per bit (CLK_FREQ / BAUD_RATE)
+    localparam BYTE_NS  = 10 * BIT_NS;
+    localparam LAG_NS   = 3 * BYTE_NS;  // Bridge reaction to CTS#
+    localparam STOP_LVL = 192;
+    localparam GO_LVL   = 128;
+    localparam IMG_SIZE = 1024;
+
+    //==========================================================================
+    // DUT: uart + circular_buffer
+    //==========================================================================
+    reg        host_line = 1'b1;        // Host -> FPGA RX
+    wire       tx_line;                 // FPGA TX -> host
+    wire       rts_n;
+    reg        host_ready_n = 1'b0;     // Host RTS# -> FPGA CTS#
+
+    reg        tx_ena = 0;
+    reg  [7:0] tx_data = 0;
+    wire       tx_busy;
+    wire [7:0] rx_data;
+    wire       rx_data_valid;
+
+    wire [8:0] level;
+    wire [7:0] fifo_data;
+    wire       fifo_full, fifo_empty;
+    reg        fifo_rd = 0;
+    reg        fifo_clear = 0;
+
+    uart #(
+        .CLK_FREQ(48_000_000),
+        .BAUD_RATE(1_000_000),
+        .OS_RATE(16),
+        .D_WIDTH(8),
+        .PARITY(0),
+        .PARITY_EO(1'b0),
+        .LEVEL_BITS(9),
+        .RX_STOP_LEVEL(STOP_LVL),
+        .RX_GO_LEVEL(GO_LVL),
+        .CTS_ENABLE(1)
+    ) dut (
+        .clk(clk),
+        .reset_n(resetn),
+        .tx_ena(tx_ena),
+        .tx_data(tx_data),
+        .rx(host_line),
+        .rx_busy(),
+        .rx_error(),
+        .rx_data(rx_data),
+        .rx_data_valid(rx_data_valid),
+        .tx_busy(tx_busy),
+        .tx(tx_line),
+        .rx_level(level),
+        .rts_n(rts_n),
+        .cts_n(host_ready_n)
+    );
+
+    circular_buffer #(
+        .DATA_WIDTH(8),
+        .ADDR_BITS(8)
+    ) fifo (
+        .clk(clk),
+        .reset_n(resetn),
+        .clear(fifo_clear),
+        .wr_en(rx_data_valid && !fifo_full),
+        .wr_data(rx_data),
+        .full(fifo_full),
+        .rd_en(fifo_rd),
+        .rd_data(fifo_data),
+        .empty(fifo_empty),
+        .level(level)
+    );
+
+    //==========================================================================
+    // Monitors
+    //==========================================================================
+    integer errors = 0;
+    integer dropped = 0;
+    integer max_level = 0;
+    integer rts_stops = 0;
+
+    always @(posedge clk) begin
+        if (rx_data_valid && fifo_full)
+            dropped = dropped + 1;
+        if (level > max_level)
+            max_level = level;
+    end
+
+    always @(posedge rts_n)
+        if (resetn) rts_stops = rts_stops + 1;
+
+    // Host CTS#: the FPGA's RTS#, seen LAG_NS late (transport delay)
+    reg host_cts_n = 1'b1;
+    always @(rts_n)
+        host_cts_n <= #(LAG_NS) rts_n;
+
+    task check;
+        input cond;
+        input [8*72-1:0] what;
+        begin
+            if (cond) begin
+                $display("  ok   %0s", what);
+            end else begin
+                $display("  FAIL %0s", what);
+                errors = errors + 1;
+            end
+        end
+    endtask
+
+    function [31:0] crc32_byte;
+        input [31:0] crc;
+        input [7:0]  b;
+        integer k;
+        reg [31:0] c;
+        begin
+            c = crc ^ {24'h0, b};
+            for (k = 0; k < 8; k = k + 1)
+                c = c[0] ? (c >> 1) ^ 32'hEDB88320 : (c >> 1);
+            crc32_byte = c;
+        end
+    endfunction
+
+    //==========================================================================
+    // Host model
+    //==========================================================================
+    reg host_honors_cts = 1;
+
+    task host_putc;
+        input [7:0] b;
+        integer k;
+        begin
+            if (host_honors_cts)
+                wait (host_cts_n == 1'b0);
+            host_line = 1'b0;
+            #(BIT_NS);
+            for (k = 0; k < 8; k = k + 1) begin
+                host_line = b[k];
+                #(BIT_NS);
+            end
+            host_line = 1'b1;
+            #(BIT_NS);
+        end
+    endtask
+
+    // Host receiver: mid-bit sampling of the FPGA TX pin
+    reg [7:0] host_rx_buf [0:63];
+    integer   host_rx_n = 0;
+    integer   host_rx_rd = 0;
+    reg [7:0] rx_shift;
+    integer   rk;
+
+    always begin
+        @(negedge tx_line);
+        #(BIT_NS / 2);
+        if (tx_line == 1'b0) begin
+            for (rk = 0; rk < 8; rk = rk + 1) begin
+                #(BIT_NS);
+                rx_shift[rk] = tx_line;
+            end
+            #(BIT_NS);
+            if (tx_line !== 1'b1)
+                $display("  host: framing error on 0x%02x", rx_shift);
+            host_rx_buf[host_rx_n % 64] = rx_shift;
+            host_rx_n = host_rx_n + 1;
+        end
+    end
+
+    task host_getc;
+        output [7:0] b;
+        begin
+            wait (host_rx_rd < host_rx_n);
+            b = host_rx_buf[host_rx_rd % 64];
+            host_rx_rd = host_rx_rd + 1;
+        end
+    endtask
+
+    //==========================================================================
+    // Target model (bootloader receive loop)
+    //==========================================================================
+    integer slow_clocks = 700;          // Per byte: line is 480 clocks/byte
+    integer stall_every = 256;          // Extra stall every N data bytes
+    integer stall_clocks = 20000;
+
+    task target_getc;
+        output [7:0] b;
+        begin
+            @(negedge clk);
+            while (fifo_empty) @(negedge clk);
+            @(negedge clk);             // rd_data is registered
+            b = fifo_data;
+            fifo_rd = 1;
+            @(negedge clk);
+            fifo_rd = 0;
+        end
+    endtask
+
+    task target_putc;
+        input [7:0] b;
+        begin
+            @(negedge clk);
+            while (tx_busy) @(negedge clk);
+            tx_data = b;
+            tx_ena = 1;
+            @(negedge clk);
+            tx_ena = 0;
+            @(negedge clk);
+        end
+    endtask
+
+    reg [7:0]  target_mem [0:IMG_SIZE-1];
+    reg [31:0] target_crc;
+    reg        target_stream;
+
+    task target_receive;
+        reg [7:0]  c;
+        reg [31:0] size, expected;
+        integer k;
+        begin
+            target_crc = 32'hFFFFFFFF;
+            c = 0;
+            while (c != "R" && c != "S")
+                target_getc(c);
+            target_stream = (c == "S");
+            target_putc("A");
+            size = 0;
+            for (k = 0; k < 4; k = k + 1) begin
+                target_getc(c);
+                size[8*k +: 8] = c;
+            end
+            target_putc("B");
+            for (k = 0; k < size; k = k + 1) begin
+                target_getc(c);
+                target_mem[k] = c;
+                target_crc = crc32_byte(target_crc, c);
+                repeat (slow_clocks) @(posedge clk);
+                if (k % stall_every == stall_every - 1)
+                    repeat (stall_clocks) @(posedge clk);
+            end
+            target_crc = ~target_crc;
+            target_getc(c);
+            if (c != "C")
+                $display("  target: expected 'C', got 0x%02x", c);
+            expected = 0;
+            for (k = 0; k < 4; k = k + 1) begin
+                target_getc(c);
+                expected[8*k +: 8] = c;
+            end
+            target_putc("C");
+            for (k = 0; k < 4; k = k + 1)
+                target_putc(target_crc[8*k +: 8]);
+        end
+    endtask
+
+    //==========================================================================
+    // Test sequence
+    //==========================================================================
+    reg [7:0]  image [0:IMG_SIZE-1];
+    reg [31:0] image_crc;
+    reg [31:0] reply_crc;
+    reg [7:0]  b;
+    reg        host_done;
+    integer    i, t0, t_start, bad;
+
+    initial begin
+        $display("========================================");
+        $display("UART RTS/CTS Flow Control Test");
+        $display("========================================");
+
+        image_crc = 32'hFFFFFFFF;
+        for (i = 0; i < IMG_SIZE; i = i + 1) begin
+            image[i] = (i * 37 + (i >> 5)) & 8'hFF;
+            image_crc = crc32_byte(image_crc, image[i]);
+        end
+        image_crc = ~image_crc;
+
+        repeat (5) @(posedge clk);
+        resetn = 1;
+        repeat (20) @(posedge clk);
+
+        // ---------------------------------------------------------------------
+        $display("\n[1] Reset state");
+        check(rts_n == 1'b0, "RTS# low (host may send) with an empty FIFO");
+
+        // ---------------------------------------------------------------------
+        $display("\n[2] Streaming upload, host honours CTS#");
+        dropped = 0;
+        max_level = 0;
+        rts_stops = 0;
+        host_honors_cts = 1;
+        t_start = $time;
+        fork
+            target_receive;
+            begin
+                host_putc("S");
+                host_getc(b);
+                check(b == "A", "ACK 'A' for Stream");
+                for (i = 0; i < 4; i = i + 1)
+                    host_putc(IMG_SIZE >> (8 * i));
+                host_getc(b);
+                check(b == "B", "ACK 'B' for size");
+                for (i = 0; i < IMG_SIZE; i = i + 1)
+                    host_putc(image[i]);
+                host_putc("C");
+                for (i = 0; i < 4; i = i + 1)
+                    host_putc(image_crc >> (8 * i));
+                host_getc(b);
+                check(b == "C", "final ACK 'C' (no chunk ACKs in between)");
+                reply_crc = 0;
+                for (i = 0; i < 4; i = i + 1) begin
+                    host_getc(b);
+                    reply_crc[8*i +: 8] = b;
+                end
+            end
+        join
+        bad = 0;
+        for (i = 0; i < IMG_SIZE; i = i + 1)
+            if (target_mem[i] !== image[i]) bad = bad + 1;
+        $display("  %0d bytes in %0d us, RTS# stops %0d, peak FIFO level %0d",
+                 IMG_SIZE, ($time - t_start) / 1000, rts_stops, max_level);
+        check(target_stream, "target in streaming mode");
+        check(dropped == 0, "no bytes dropped");
+        check(bad == 0, "image received intact");
+        check(reply_crc == image_crc, "target CRC matches host CRC");
+        check(rts_stops > 0, "RTS# throttled the host");
+        check(max_level >= STOP_LVL && max_level < 256, "FIFO reached the stop level, never full");
+        check(host_rx_n == 7, "only A, B and C + CRC sent back");
+
+        // ---------------------------------------------------------------------
+        $display("\n[3] Same stream, host ignores CTS#");
+        fifo_clear = 1;
+        @(negedge clk);
+        fifo_clear = 0;
+        repeat (10) @(posedge clk);
+        dropped = 0;
+        host_honors_cts = 0;
+        host_done = 0;
+        fork
+            begin
+                for (i = 0; i < 600; i = i + 1)
+                    host_putc(image[i]);
+                host_done = 1;
+            end
+            begin
+                // Drain at the target's pace until the host is done
+                while (!host_done || !fifo_empty) begin
+                    if (!fifo_empty) begin
+                        target_getc(b);
+                        repeat (1500) @(posedge clk);
+                    end else begin
+                        @(posedge clk);
+                    end
+                end
+            end
+        join
+        $display("  %0d of 600 bytes dropped", dropped);
+        check(dropped > 0, "RX FIFO overruns without flow control");
+        host_honors_cts = 1;
+
+        // ---------------------------------------------------------------------
+        $display("\n[4] CTS# into the target TX");
+        wait (host_cts_n == 1'b0);
+        host_ready_n = 1'b1;
+        repeat (10) @(posedge clk);
+        i = host_rx_n;
+        bad = 0;
+        target_putc("X");
+        t0 = $time;
+        while ($time - t0 < 5 * BYTE_NS) begin
+            @(posedge clk);
+            if (tx_line !== 1'b1) bad = -1;
+        end
+        check(bad != -1 && tx_busy && host_rx_n == i, "byte held while CTS# is high, TX_STATUS busy");
+        host_ready_n = 1'b0;
+        host_getc(b);
+        check(b == "X", "byte sent once CTS# falls");
+
+        target_putc("Y");
+        @(negedge tx_line);
+        #(BIT_NS * 3);
+        host_ready_n = 1'b1;            // Mid-byte: must not truncate it
+        host_getc(b);
+        check(b == "Y", "CTS# rising mid-byte does not cut the byte");
+        host_ready_n = 1'b0;
+
+        // ---------------------------------------------------------------------
+        $display("");
+        $display("========================================");
+        if (errors == 0)
+            $display("*** ALL UART FLOW TESTS PASSED ***");
+        else
+            $display("*** %0d UART FLOW CHECK(S) FAILED ***", errors);
+        $display("========================================");
+        $finish;
+    end
+
+    initial begin
+        #200_000_000;
+        $display("*** TIMEOUT");
+        $finish;
+    end
+
+endmodule
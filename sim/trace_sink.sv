@@ -0,0 +1,177 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// trace_sink.sv - PicoRV32 Trace Port to Binary Trace File (simulation only)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Captures the PicoRV32 trace port (ENABLE_TRACE=1) into a compact
+// delta-encoded binary file, enabled at run time with +trace=<file>.
+// Decode with tools/rvtrace.
+//
+// PicoRV32 emits one word per retired instruction (the branch target for
+// taken branches/jumps, otherwise the value written back - the loaded value
+// for loads, the store data for stores) plus an address word before every
+// load/store. Bit 35 is set while irq_active.
+//
+// File format (version 1, little-endian):
+//   Header: "RVTR" | u8 version | u8 flags | u16 0 | u32 start_pc
+//   Record: tag byte
+//     tag[1:0] kind: 0 = value, 1 = branch target, 2 = mem address, 3 = control
+//     tag[2]   irq_active
+//     tag[7:3] zigzag(value - previous value of the same kind) if < 31,
+//              31 = zigzag delta follows as LEB128
+//   Control records (kind 3): tag[7:3] = 0 end of trace,
+//                             tag[7:3] = 1 cycle stamp, LEB128 cycle delta
+//   A cycle stamp follows every STAMP_INTERVAL retired instructions.
+//
+//==============================================================================
+
+module trace_sink #(
+    parameter START_PC = 32'h00000000,
+    parameter STAMP_INTERVAL = 256
+) (
+    input wire        clk,
+    input wire        resetn,
+    input wire        trace_valid,
+    input wire [35:0] trace_data
+);
+
+    localparam KIND_VALUE  = 2'd0;
+    localparam KIND_BRANCH = 2'd1;
+    localparam KIND_ADDR   = 2'd2;
+    localparam KIND_CTRL   = 2'd3;
+
+    integer fd = 0;
+    reg [8*256-1:0] path;
+
+    reg [31:0] prev_value;
+    reg [31:0] prev_branch;
+    reg [31:0] prev_addr;
+    reg [63:0] cycle;
+    reg [63:0] stamp_cycle;
+    integer    since_stamp;
+    reg [63:0] n_records;
+    reg [63:0] n_bytes;
+
+    task put_byte(input [7:0] b);
+        begin
+            $fwrite(fd, "%c", b);
+            n_bytes = n_bytes + 1;
+        end
+    endtask
+
+    task put_u32(input [31:0] w);
+        begin
+            put_byte(w[7:0]);
+            put_byte(w[15:8]);
+            put_byte(w[23:16]);
+            put_byte(w[31:24]);
+        end
+    endtask
+
+    task put_leb(input [63:0] v);
+        reg [63:0] t;
+        reg        done;
+        integer    i;
+        begin
+            t = v;
+            done = 1'b0;
+            for (i = 0; i < 10; i = i + 1) begin
+                if (!done) begin
+                    if (t >= 64'd128) begin
+                        put_byte({1'b1, t[6:0]});
+                        t = t >> 7;
+                    end else begin
+                        put_byte(t[7:0]);
+                        done = 1'b1;
+                    end
+                end
+            end
+        end
+    endtask
+
+    task put_record(input [1:0] kind, input irq, input [31:0] delta);
+        reg [31:0] zz;
+        begin
+            zz = {delta[30:0], 1'b0} ^ {32{delta[31]}};
+            if (zz < 32'd31) begin
+                put_byte({zz[4:0], irq, kind});
+            end else begin
+                put_byte({5'd31, irq, kind});
+                put_leb({32'd0, zz});
+            end
+            n_records = n_records + 1;
+        end
+    endtask
+
+    initial begin
+        prev_value  = 32'd0;
+        prev_branch = START_PC;
+        prev_addr   = 32'd0;
+        cycle       = 64'd0;
+        stamp_cycle = 64'd0;
+        since_stamp = 0;
+        n_records   = 64'd0;
+        n_bytes     = 64'd0;
+
+        if ($value$plusargs("trace=%s", path)) begin
+            fd = $fopen(path, "wb");
+            if (fd == 0) begin
+                $display("[TRACE] Cannot open %0s", path);
+            end else begin
+                put_byte("R"); put_byte("V"); put_byte("T"); put_byte("R");
+                put_byte(8'd1);                         // version
+                put_byte(8'd1);                         // flags: cycle stamps
+                put_byte(8'd0); put_byte(8'd0);
+                put_u32(START_PC);
+                $display("[TRACE] Writing instruction trace to %0s", path);
+            end
+        end
+    end
+
+    always @(posedge clk) begin
+        if (resetn) cycle = cycle + 1;
+
+        if (fd != 0 && resetn && trace_valid) begin
+            if (trace_data[33]) begin
+                put_record(KIND_ADDR, trace_data[35], trace_data[31:0] - prev_addr);
+                prev_addr = trace_data[31:0];
+            end else begin
+                if (trace_data[32]) begin
+                    put_record(KIND_BRANCH, trace_data[35], trace_data[31:0] - prev_branch);
+                    prev_branch = trace_data[31:0];
+                end else begin
+                    put_record(KIND_VALUE, trace_data[35], trace_data[31:0] - prev_value);
+                    prev_value = trace_data[31:0];
+                end
+
+                since_stamp = since_stamp + 1;
+                if (since_stamp == STAMP_INTERVAL) begin
+                    put_byte({5'd1, 1'b0, KIND_CTRL});
+                    put_leb(cycle - stamp_cycle);
+                    stamp_cycle = cycle;
+                    since_stamp = 0;
+                end
+            end
+        end
+    end
+
+    final begin
+        if (fd != 0) begin
+            put_byte({5'd1, 1'b0, KIND_CTRL});
+            put_leb(cycle - stamp_cycle);
+            put_byte({5'd0, 1'b0, KIND_CTRL});
+            $fclose(fd);
+            $display("[TRACE] %0d records, %0d bytes (%0d.%02d bytes/record)",
+                     n_records, n_bytes,
+                     n_records ? n_bytes / n_records : 0,
+                     n_records ? (n_bytes * 100 / n_records) % 100 : 0);
+        end
+    end
+
+endmodule
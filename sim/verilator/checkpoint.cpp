@@ -0,0 +1,89 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// checkpoint.cpp - Full-SoC Save/Restore for the Verilator Harness
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "checkpoint.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#include "verilated_save.h"
+
+#define CKPT_MAGIC     "ICE40HX8K-SOC-CKPT"
+#define CKPT_MAGIC_LEN 18
+#define CKPT_VERSION   1u
+
+bool checkpoint_save(const std::string &path, VerilatedContext *ctx, Vsim_top *top,
+                     SramModel *sram, const UartBridge &uart, uint64_t cycles,
+                     std::string &err) {
+    VerilatedSave os;
+    os.open(path.c_str());
+    if (!os.isOpen()) {
+        err = "cannot create " + path;
+        return false;
+    }
+
+    uint32_t version = CKPT_VERSION;
+    uint64_t time = ctx->time();
+    std::string uart_state = uart.save_state();
+
+    os.write(CKPT_MAGIC, CKPT_MAGIC_LEN);
+    os << version << cycles << time;
+    os << *top;
+    os.write(sram->data(), SramModel::BYTES);
+    os << uart_state;
+    os.close();
+    return true;
+}
+
+bool checkpoint_restore(const std::string &path, VerilatedContext *ctx, Vsim_top *top,
+                        SramModel *sram, UartBridge &uart, uint64_t &cycles,
+                        std::string &err) {
+    // VerilatedRestore aborts on a short file; check it exists first
+    if (access(path.c_str(), R_OK) != 0) {
+        err = "cannot read " + path;
+        return false;
+    }
+
+    VerilatedRestore os;
+    os.open(path.c_str());
+    if (!os.isOpen()) {
+        err = "cannot open " + path;
+        return false;
+    }
+
+    char magic[CKPT_MAGIC_LEN];
+    uint32_t version = 0;
+    uint64_t time = 0;
+    std::string uart_state;
+
+    os.read(magic, CKPT_MAGIC_LEN);
+    if (memcmp(magic, CKPT_MAGIC, CKPT_MAGIC_LEN) != 0) {
+        err = path + " is not an SoC checkpoint";
+        return false;
+    }
+    os >> version;
+    if (version != CKPT_VERSION) {
+        err = path + ": unsupported checkpoint version";
+        return false;
+    }
+    os >> cycles >> time;
+    os >> *top;
+    os.read(sram->data(), SramModel::BYTES);
+    os >> uart_state;
+    os.close();
+
+    ctx->time(time);
+    if (!uart.restore_state(uart_state)) {
+        err = path + ": bad UART state";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,43 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// checkpoint.h - Full-SoC Save/Restore for the Verilator Harness
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// A checkpoint holds everything needed to resume a run bit-exactly:
+//   - the Verilated model (CPU registers, peripherals, boot ROM, FIFOs),
+//     serialized by Verilator (model built with --savable)
+//   - simulation time and the harness cycle counter
+//   - the 512KB SramModel array (it lives in C++, outside the model)
+//   - the UartBridge line state and any queued input
+// Restoring requires the same Verilated build that wrote the file; Verilator
+// rejects a checkpoint from a different model.
+//
+//==============================================================================
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdint.h>
+#include <string>
+
+#include "verilated.h"
+#include "Vsim_top.h"
+
+#include "sram_model.h"
+#include "uart_bridge.h"
+
+bool checkpoint_save(const std::string &path, VerilatedContext *ctx, Vsim_top *top,
+                     SramModel *sram, const UartBridge &uart, uint64_t cycles,
+                     std::string &err);
+
+bool checkpoint_restore(const std::string &path, VerilatedContext *ctx, Vsim_top *top,
+                        SramModel *sram, UartBridge &uart, uint64_t &cycles,
+                        std::string &err);
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,208 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// cosim.cpp - Lockstep RTL vs. ISA Model Checker for the Verilator Harness
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "cosim.h"
+
+#include <string.h>
+
+// PicoRV32 trace_data flags (picorv32.v TRACE_BRANCH/TRACE_ADDR/TRACE_IRQ)
+#define TRACE_BRANCH (1ULL << 32)
+#define TRACE_ADDR   (1ULL << 33)
+#define TRACE_IRQ    (1ULL << 35)
+
+static const char *reg_names[32] = {
+    "zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2",
+    "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+    "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7",
+    "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6",
+};
+
+static const char *op_name(uint32_t insn) {
+    switch (insn & 0x7F) {
+    case 0x37: return "lui";
+    case 0x17: return "auipc";
+    case 0x6F: return "jal";
+    case 0x67: return "jalr";
+    case 0x63: return "branch";
+    case 0x03: return "load";
+    case 0x23: return "store";
+    case 0x13: return "alu-imm";
+    case 0x33: return (insn >> 25) == 1 ? "mul/div" : "alu-reg";
+    case 0x0B: return "irq-custom";
+    case 0x0F: return "fence";
+    case 0x73: return "system";
+    default:   return "unknown";
+    }
+}
+
+Cosim::Cosim()
+    : soc(new rv_soc_t), rtl_sram(nullptr), rtl_bytes(0), phase(IDLE),
+      store_pending(false), store_addr(0), failed(false),
+      retired(0), irqs(0), adopted(0), stores(0) {
+    memset(&cur, 0, sizeof(cur));
+    memset(history, 0, sizeof(history));
+}
+
+Cosim::~Cosim() {
+    delete soc;
+}
+
+bool Cosim::init(const uint16_t *sram, uint32_t bytes, const std::string &rom,
+                 uint32_t reset_pc, std::string &err) {
+    if (bytes > SOC_SRAM_SIZE) {
+        err = "SRAM image larger than the model";
+        return false;
+    }
+    soc_init(soc);
+    if (!rom.empty() && soc_load_rom(soc, rom.c_str()) != 0) {
+        err = "cannot load boot ROM " + rom;
+        return false;
+    }
+    for (uint32_t i = 0; i < bytes / 2; i++) {
+        soc->sram[2 * i] = (uint8_t)sram[i];
+        soc->sram[2 * i + 1] = (uint8_t)(sram[i] >> 8);
+    }
+    rtl_sram = sram;
+    rtl_bytes = bytes;
+
+    rv_core_init(&core, soc, reset_pc);
+    core.lockstep = true;
+    core.retire = &cur;
+    return true;
+}
+
+// Advance the model by one instruction
+bool Cosim::step() {
+    rv_core_step(&core);
+    if (core.halt != RV_RUNNING) return false;
+    return cur.kind != RV_RET_UNTRACED;
+}
+
+bool Cosim::check_store(uint64_t cycle) {
+    store_pending = false;
+    uint32_t a = store_addr & ~3u;
+    uint32_t want = soc_rd32(&soc->sram[a]);
+    uint32_t got = (uint32_t)rtl_sram[a >> 1] | ((uint32_t)rtl_sram[(a >> 1) + 1] << 16);
+    if (got != want) {
+        char what[64];
+        snprintf(what, sizeof(what), "SRAM word 0x%05x after store", a);
+        return fail(cycle, what, want, got);
+    }
+    return true;
+}
+
+bool Cosim::push(uint64_t word, uint64_t cycle) {
+    if (failed) return false;
+
+    bool irq = (word & TRACE_IRQ) != 0;
+    uint32_t val = (uint32_t)word;
+
+    // The store's data is in the RTL SRAM by the time the next word arrives
+    if (store_pending && !check_store(cycle)) return false;
+
+    if (phase == IDLE) {
+        if (irq && !core.irq_active) {
+            rv_core_enter_irq(&core, 0);
+            irqs++;
+        }
+        if (!step()) {
+            if (core.halt != RV_RUNNING)
+                return fail(cycle, "model stopped but the RTL kept retiring", core.halt_pc, val);
+            return fail(cycle, "model executed an instruction PicoRV32 never retires", cur.insn, val);
+        }
+        phase = cur.mem ? WANT_ADDR : WANT_VALUE;
+    }
+
+    // Compared after the step: retirq's own word already has irq_active clear
+    if (irq != core.irq_active)
+        return fail(cycle, "irq_active", core.irq_active, irq);
+
+    if (phase == WANT_ADDR) {
+        if (!(word & TRACE_ADDR)) return fail(cycle, "expected a load/store address word", cur.addr, val);
+        if (val != cur.addr) return fail(cycle, "load/store address", cur.addr, val);
+        phase = WANT_VALUE;
+        return true;
+    }
+
+    if (word & TRACE_ADDR) return fail(cycle, "unexpected address word", cur.value, val);
+    if (((word & TRACE_BRANCH) != 0) != (cur.kind == RV_RET_BRANCH))
+        return fail(cycle, cur.kind == RV_RET_BRANCH ? "branch taken in model only"
+                                                     : "branch taken in RTL only", cur.value, val);
+    if (cur.external) {
+        // Value from outside the core: follow the RTL
+        if (cur.rd) core.x[cur.rd] = val;
+        adopted++;
+    } else if (val != cur.value) {
+        return fail(cycle, cur.kind == RV_RET_BRANCH ? "next PC" : "result", cur.value, val);
+    }
+    if (cur.store && soc_is_sram(cur.addr) && cur.addr < rtl_bytes) {
+        store_pending = true;
+        store_addr = cur.addr;
+        stores++;
+    }
+
+    Entry &e = history[retired % HISTORY];
+    e.cycle = cycle;
+    e.r = cur;
+    e.rtl = val;
+    retired++;
+    phase = IDLE;
+    return true;
+}
+
+bool Cosim::finish(uint64_t cycle) {
+    if (failed) return false;
+    if (store_pending) return check_store(cycle);
+    return true;
+}
+
+bool Cosim::fail(uint64_t cycle, const char *what, uint32_t expect, uint32_t got) {
+    failed = true;
+    fprintf(stderr, "\n[COSIM] DIVERGENCE after %llu instructions (cycle %llu): %s\n",
+            (unsigned long long)retired, (unsigned long long)cycle, what);
+    fprintf(stderr, "[COSIM]   model pc 0x%08x insn 0x%08x (%s): expected 0x%08x, RTL 0x%08x\n",
+            cur.pc, cur.insn, op_name(cur.insn), expect, got);
+    dump(stderr);
+    return false;
+}
+
+void Cosim::dump(FILE *f) const {
+    uint64_t n = retired < HISTORY ? retired : HISTORY;
+    fprintf(f, "[COSIM] Last %llu retired instructions (oldest first):\n", (unsigned long long)n);
+    fprintf(f, "        %12s  %-10s %-10s %-10s %-5s %-10s %s\n",
+            "cycle", "pc", "insn", "class", "rd", "value", "addr");
+    for (uint64_t i = retired - n; i < retired; i++) {
+        const Entry &e = history[i % HISTORY];
+        fprintf(f, "        %12llu  0x%08x 0x%08x %-10s %-5s 0x%08x",
+                (unsigned long long)e.cycle, e.r.pc, e.r.insn, op_name(e.r.insn),
+                e.r.rd ? reg_names[e.r.rd] : "-", e.rtl);
+        if (e.r.mem) fprintf(f, " 0x%08x", e.r.addr);
+        fprintf(f, "%s%s\n", e.r.kind == RV_RET_BRANCH ? " taken" : "",
+                e.r.external ? " (from RTL)" : "");
+    }
+
+    fprintf(f, "[COSIM] Model state after the diverging instruction:\n");
+    for (int r = 0; r < 32; r += 4) {
+        fprintf(f, "        ");
+        for (int k = r; k < r + 4; k++)
+            fprintf(f, "%-4s 0x%08x  ", reg_names[k], core.x[k]);
+        fprintf(f, "\n");
+    }
+    fprintf(f, "        pc   0x%08x  irq_active %d  irq_mask 0x%08x  q0 0x%08x  q1 0x%08x\n",
+            core.pc, core.irq_active, core.irq_mask, core.q[0], core.q[1]);
+}
+
+void Cosim::summary(FILE *f) const {
+    fprintf(f, "[COSIM] %s: %llu instructions checked, %llu IRQ entries, %llu SRAM stores verified, "
+            "%llu external values taken from the RTL\n",
+            failed ? "FAILED" : "OK", (unsigned long long)retired, (unsigned long long)irqs,
+            (unsigned long long)stores, (unsigned long long)adopted);
+}
@@ -0,0 +1,96 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// cosim.h - Lockstep RTL vs. ISA Model Checker for the Verilator Harness
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Every word PicoRV32 puts on its trace port (ENABLE_TRACE) is checked
+// against the rvsim core model (tools/rvsim) stepped in lockstep:
+//   - value word   : result / loaded value / store data of the instruction
+//   - branch word  : taken branch, jump or retirq target (next PC)
+//   - address word : load/store address
+//   - IRQ flag     : irq_active, which is also how interrupt entry is seen
+// After every SRAM store the word in the RTL's SRAM array is compared with
+// the model's, so a lost or misplaced write in mem_controller/sram_proc is
+// caught at the store rather than when the data is next read.
+//
+// The model owns no timing: it enters an interrupt when the RTL's trace
+// shows one, and values that come from outside the core (MMIO loads, getq
+// q1, waitirq, timer) are taken from the RTL instead of compared.
+//
+// The first mismatch stops the check and prints the last retired
+// instructions and the model's register file.
+//
+//==============================================================================
+
+#ifndef COSIM_H
+#define COSIM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+
+extern "C" {
+#include "rv_core.h"
+#include "rv_soc.h"
+}
+
+class Cosim {
+public:
+    static const int HISTORY = 16;
+
+    Cosim();
+    ~Cosim();
+
+    // sram/bytes: SRAM contents at reset (SramModel word array), compared
+    // against after stores. rom: bootloader hex for the model's boot ROM
+    // ("" = leave it zero).
+    bool init(const uint16_t *sram, uint32_t bytes, const std::string &rom,
+              uint32_t reset_pc, std::string &err);
+
+    // One trace port word. Returns false at the first divergence.
+    bool push(uint64_t word, uint64_t cycle);
+
+    // End of run: checks a store still waiting for its SRAM compare
+    bool finish(uint64_t cycle);
+
+    bool diverged() const { return failed; }
+    uint64_t instructions() const { return retired; }
+    void summary(FILE *f) const;
+
+private:
+    struct Entry {
+        uint64_t cycle;
+        rv_retire_t r;
+        uint32_t rtl;           // Value word seen from the RTL
+    };
+
+    bool step();
+    bool check_store(uint64_t cycle);
+    bool fail(uint64_t cycle, const char *what, uint32_t expect, uint32_t got);
+    void dump(FILE *f) const;
+
+    rv_soc_t *soc;
+    rv_core_t core;
+    rv_retire_t cur;
+    const uint16_t *rtl_sram;
+    uint32_t rtl_bytes;
+
+    enum { IDLE, WANT_ADDR, WANT_VALUE } phase;
+    bool store_pending;
+    uint32_t store_addr;
+    bool failed;
+
+    Entry history[HISTORY];
+    uint64_t retired;
+    uint64_t irqs;
+    uint64_t adopted;
+    uint64_t stores;
+};
+
+#endif // COSIM_H
@@ -0,0 +1,202 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// cosim_selftest.cpp - Lockstep Checker Self-Test (host only, no Verilator)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// A free-running rvsim core stands in for the RTL: its retire records are
+// turned into PicoRV32 trace port words and its stores are mirrored into a
+// 16-bit "RTL" SRAM array. The checker must follow it through timer
+// interrupts and MMIO reads, and must stop at exactly the instruction where
+// a fault is injected.
+//
+//==============================================================================
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "cosim.h"
+
+#define TRACE_BRANCH (1ULL << 32)
+#define TRACE_ADDR   (1ULL << 33)
+#define TRACE_IRQ    (1ULL << 35)
+
+//==============================================================================
+// Minimal encoder
+//==============================================================================
+
+enum { ZERO, RA, SP, GP, TP, T0, T1, T2, S0, S1, A0, A1, A2, A3, A4, A5 };
+
+#define R(f7, rs2, rs1, f3, rd, op) (((f7) << 25) | ((rs2) << 20) | ((rs1) << 15) | ((f3) << 12) | ((rd) << 7) | (op))
+#define I(imm, rs1, f3, rd, op)     ((((uint32_t)(imm) & 0xFFF) << 20) | ((rs1) << 15) | ((f3) << 12) | ((rd) << 7) | (op))
+#define S(imm, rs2, rs1, f3)        (((((uint32_t)(imm) >> 5) & 0x7F) << 25) | ((rs2) << 20) | ((rs1) << 15) | ((f3) << 12) | (((uint32_t)(imm) & 0x1F) << 7) | 0x23)
+
+static uint32_t B(int32_t off, int rs2, int rs1, int f3) {
+    uint32_t i = (uint32_t)off;
+    return (((i >> 12) & 1) << 31) | (((i >> 5) & 0x3F) << 25) | ((uint32_t)rs2 << 20) | ((uint32_t)rs1 << 15) |
+           ((uint32_t)f3 << 12) | (((i >> 1) & 0xF) << 8) | (((i >> 11) & 1) << 7) | 0x63;
+}
+
+static uint32_t J(int32_t off, int rd) {
+    uint32_t i = (uint32_t)off;
+    return (((i >> 20) & 1) << 31) | (((i >> 1) & 0x3FF) << 21) | (((i >> 11) & 1) << 20) |
+           (((i >> 12) & 0xFF) << 12) | ((uint32_t)rd << 7) | 0x6F;
+}
+
+#define ADDI(rd, rs1, imm)  I(imm, rs1, 0, rd, 0x13)
+#define LUI(rd, imm20)      ((((uint32_t)(imm20)) << 12) | ((rd) << 7) | 0x37)
+#define MUL(rd, a, b)       R(1, b, a, 0, rd, 0x33)
+#define LW(rd, rs1, imm)    I(imm, rs1, 2, rd, 0x03)
+#define SW(rs2, rs1, imm)   S(imm, rs2, rs1, 2)
+#define SB(rs2, rs1, imm)   S(imm, rs2, rs1, 0)
+#define BNE(a, b, off)      B(off, b, a, 1)
+#define GETQ(rd, q)         R(0, 0, q, 4, rd, 0x0B)
+#define RETIRQ              R(2, 0, 0, 0, 0, 0x0B)
+#define MASKIRQ(rd, rs1)    R(3, 0, rs1, 6, rd, 0x0B)
+
+// main: start the timer (1000-cycle period), unmask, then loop filling
+// 0x1000.. with running products. irq: count, read q1 and CNT, clear SR.
+static const uint32_t prog[] = {
+    J(0x40, ZERO),              // 0x00: j main
+    0, 0, 0,
+    ADDI(S1, S1, 1),            // 0x10: irq_vec
+    GETQ(A0, 1),
+    LUI(T0, 0x80000),
+    LW(A1, T0, 0x30),           // CNT: external value
+    ADDI(T1, ZERO, 1),
+    SW(T1, T0, 0x24),           // SR = 1 (W1C)
+    RETIRQ,
+    0, 0, 0, 0, 0,
+    LUI(T0, 0x80000),           // 0x40: main
+    SW(ZERO, T0, 0x28),         // PSC = 0
+    ADDI(T1, ZERO, 999),
+    SW(T1, T0, 0x2C),           // ARR = 999
+    ADDI(T1, ZERO, 1),
+    SW(T1, T0, 0x20),           // CR = enable
+    MASKIRQ(ZERO, ZERO),
+    LUI(S0, 0x1),               // 0x5C: outer: s0 = 0x1000
+    ADDI(A2, ZERO, 64),
+    ADDI(A3, ZERO, 3),
+    MUL(A3, A3, A2),            // 0x68: inner
+    SW(A3, S0, 0),
+    SB(A2, S0, 1),
+    LW(A4, S0, 0),
+    ADDI(S0, S0, 4),
+    ADDI(A2, A2, -1),
+    BNE(A2, ZERO, -24),
+    J(-40, ZERO),               // j outer
+};
+
+//==============================================================================
+// Stand-in RTL
+//==============================================================================
+
+enum Fault { NONE, BAD_VALUE, LOST_STORE, BAD_BRANCH, LATE_IRQ };
+
+static uint16_t rtl_sram[SOC_SRAM_SIZE / 2];
+static rv_soc_t ref_soc;
+static rv_core_t ref;
+static int failures;
+
+static void check(const char *name, bool ok) {
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) failures++;
+}
+
+// Runs n instructions; fault is injected at instruction 'at'. Returns the
+// number of instructions the checker accepted.
+static uint64_t run(Fault fault, uint64_t at, uint64_t n, bool *ok, uint64_t *irqs) {
+    soc_init(&ref_soc);
+    for (size_t i = 0; i < sizeof(prog) / 4; i++) soc_wr32(&ref_soc.sram[4 * i], prog[i]);
+    memset(rtl_sram, 0, sizeof(rtl_sram));
+    for (size_t i = 0; i < sizeof(prog) / 4; i++) {
+        rtl_sram[2 * i] = (uint16_t)prog[i];
+        rtl_sram[2 * i + 1] = (uint16_t)(prog[i] >> 16);
+    }
+
+    rv_retire_t r;
+    rv_core_init(&ref, &ref_soc, 0);
+    ref.retire = &r;
+
+    Cosim cosim;
+    std::string err;
+    if (!cosim.init(rtl_sram, SOC_SRAM_SIZE, "", 0, err)) {
+        printf("FAIL: init: %s\n", err.c_str());
+        failures++;
+        return 0;
+    }
+
+    for (uint64_t i = 0; i < n && !cosim.diverged(); i++) {
+        rv_core_step(&ref);
+        bool irq = ref.irq_active;
+
+        // Inject only where the fault can apply
+        bool here = (i >= at);
+        uint64_t f = irq ? TRACE_IRQ : 0;
+        uint32_t value = r.value;
+        if (fault == BAD_VALUE && here && r.kind == RV_RET_VALUE && !r.external && !r.mem) {
+            value ^= 0x100;
+            fault = NONE;
+        }
+        if (fault == BAD_BRANCH && here && r.kind == RV_RET_BRANCH && (r.insn & 0x7F) == 0x63) {
+            r.kind = RV_RET_VALUE;
+            fault = NONE;
+        }
+        if (fault == LATE_IRQ && here && irq && r.pc == 0x10) {
+            f = 0;                  // First handler word without irq_active
+            fault = NONE;
+        }
+
+        if (r.mem) cosim.push(f | TRACE_ADDR | r.addr, i);
+        cosim.push(f | (r.kind == RV_RET_BRANCH ? TRACE_BRANCH : 0) | value, i);
+
+        if (r.store && soc_is_sram(r.addr)) {
+            if (fault == LOST_STORE && here) {
+                fault = NONE;
+            } else {
+                uint32_t a = r.addr & ~3u;
+                uint32_t w = soc_rd32(&ref_soc.sram[a]);
+                rtl_sram[a >> 1] = (uint16_t)w;
+                rtl_sram[(a >> 1) + 1] = (uint16_t)(w >> 16);
+            }
+        }
+    }
+    *ok = cosim.finish(n);
+    if (irqs) *irqs = ref.irqs_taken;
+    return cosim.instructions();
+}
+
+int main(void) {
+    bool ok;
+    uint64_t irqs, n;
+
+    n = run(NONE, 0, 200000, &ok, &irqs);
+    check("clean run matches", ok && n == 200000);
+    check("clean run took timer irqs", irqs > 50);
+
+    printf("\n-- injected faults (divergence reports expected) --\n");
+    n = run(BAD_VALUE, 5000, 200000, &ok, nullptr);
+    check("bad result detected at the instruction", !ok && n >= 5000 && n < 5010);
+
+    n = run(LOST_STORE, 7000, 200000, &ok, nullptr);
+    check("lost SRAM store detected", !ok && n >= 7000 && n < 7020);
+
+    n = run(BAD_BRANCH, 9000, 200000, &ok, nullptr);
+    check("branch direction detected", !ok && n >= 9000 && n < 9020);
+
+    n = run(LATE_IRQ, 20000, 200000, &ok, nullptr);
+    check("irq_active mismatch detected", !ok && n >= 20000 && n < 22000);
+
+    if (failures) {
+        printf("\n%d test(s) FAILED\n", failures);
+        return 1;
+    }
+    printf("\nAll cosim self-tests passed\n");
+    return 0;
+}
@@ -0,0 +1,332 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// sim_main.cpp - Verilator Full-SoC Simulator
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Runs the complete ice40_picorv32_top (built with +define+SIMULATION, so the
+// CPU resets to 0x0) against a C++ K6R4016 model. Firmware is preloaded into
+// SRAM from an ELF, hex or bin file and the UART is bridged to a host pty or
+// to the terminal, so interactive firmware can be driven with any serial
+// terminal program:
+//
+//   ./run_verilator.sh ../firmware/hexedit.elf
+//   picocom -b 115200 /tmp/ttyICE40
+//
+// RTL $display output goes to stdout; pass --log to keep it or it is sent to
+// /dev/null. Simulator status is printed on stderr. --trace FILE is the same
+// as the +trace=FILE plusarg read by trace_sink.sv.
+//
+// Checkpoints (checkpoint.h) skip boot/upload phases on later runs:
+//
+//   Vsim_top fw.elf --stdio --exit-on "Ready" --save ready.ckpt
+//   Vsim_top --restore ready.ckpt --stdio            # resumes at "Ready"
+//   Vsim_top test.elf --restore ready.ckpt           # + backdoor-load test.elf
+//
+// --cosim checks every retired instruction against the rvsim ISA model in
+// lockstep (cosim.h) and stops at the first divergence:
+//
+//   Vsim_top ../firmware/algo_test.elf --stdio --cosim --input " 7"
+//            --exit-on "All algorithm tests complete!"
+//
+//==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "verilated.h"
+#include "Vsim_top.h"
+
+#include "sram_model.h"
+#include "uart_bridge.h"
+#include "checkpoint.h"
+#include "cosim.h"
+
+#define SYS_CLK_HZ      50000000ULL     // EXTCLK / 2
+#define UART_BIT_CYCLES 434             // 50MHz / 115200
+
+static volatile sig_atomic_t g_stop = 0;
+
+static void on_signal(int sig) {
+    (void)sig;
+    g_stop = 1;
+}
+
+static double host_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+        "Usage: %s [options] <firmware.elf|.hex|.bin>\n"
+        "       %s [options] --restore CKPT [firmware]\n"
+        "\n"
+        "Options:\n"
+        "  --pty              Bridge UART to a new pseudo-terminal (default)\n"
+        "  --link PATH        Symlink the pty slave to PATH (default /tmp/ttyICE40)\n"
+        "  --stdio            Bridge UART to this terminal instead of a pty\n"
+        "  --input STR        Send STR to the UART after reset (\\n and \\r escapes)\n"
+        "  --exit-on STR      Stop when the firmware prints STR\n"
+        "  --cycles N         Stop at system clock cycle N (0 = run forever)\n"
+        "  --log FILE         Write RTL $display output to FILE\n"
+        "  --status SEC       Print cycles/sec every SEC seconds (0 = only at exit)\n"
+        "  --trace FILE       Write a binary instruction trace (decode with tools/rvtrace)\n"
+        "  --save FILE        Write a checkpoint when the run stops\n"
+        "  --save-at N        ...or at cycle N, then keep running\n"
+        "  --restore FILE     Resume from a checkpoint; a firmware file given as well\n"
+        "                     is loaded into SRAM over the restored contents\n"
+        "  --cosim            Check each retired instruction against the rvsim model\n"
+        "  --cosim-rom FILE   Boot ROM image for the model (default ../bootloader/bootloader.hex)\n"
+        "  -h, --help         Show this help\n",
+        prog, prog);
+}
+
+static std::string unescape(const char *s) {
+    std::string out;
+    for (; *s; s++) {
+        if (*s == '\\' && s[1]) {
+            s++;
+            switch (*s) {
+                case 'n':  out.push_back('\n'); break;
+                case 'r':  out.push_back('\r'); break;
+                case 't':  out.push_back('\t'); break;
+                case '\\': out.push_back('\\'); break;
+                default:   out.push_back('\\'); out.push_back(*s); break;
+            }
+        } else {
+            out.push_back(*s);
+        }
+    }
+    return out;
+}
+
+// cycles is the absolute cycle count; run_cycles those simulated by this process
+static void report(uint64_t cycles, uint64_t run_cycles, double elapsed, const UartBridge &uart,
+                   const char *tag) {
+    double cps = elapsed > 0 ? run_cycles / elapsed : 0.0;
+    fprintf(stderr,
+        "[SIM] %s: %llu cycles (%.3f ms simulated) in %.2f s host | %.3f MHz | %.2f%% of real time | UART tx=%llu rx=%llu\n",
+        tag, (unsigned long long)cycles, cycles * 1000.0 / SYS_CLK_HZ, elapsed,
+        cps / 1e6, cps * 100.0 / SYS_CLK_HZ,
+        (unsigned long long)uart.tx_bytes(), (unsigned long long)uart.rx_bytes());
+}
+
+int main(int argc, char **argv) {
+    std::string firmware;
+    std::string link_path = "/tmp/ttyICE40";
+    std::string input;
+    std::string exit_on;
+    std::string log_path = "/dev/null";
+    bool use_stdio = false;
+    uint64_t max_cycles = 0;
+    double status_sec = 0;
+    std::string trace_arg;
+    std::string save_path;
+    std::string restore_path;
+    uint64_t save_at = 0;
+    bool cosim_on = false;
+    std::string cosim_rom = "../bootloader/bootloader.hex";    // as bootloader_rom.v
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        bool more = (i + 1 < argc);
+        if (!strcmp(a, "-h") || !strcmp(a, "--help")) { usage(argv[0]); return 0; }
+        else if (!strcmp(a, "--pty"))               use_stdio = false;
+        else if (!strcmp(a, "--stdio"))             use_stdio = true;
+        else if (!strcmp(a, "--link") && more)      link_path = argv[++i];
+        else if (!strcmp(a, "--input") && more)     input = unescape(argv[++i]);
+        else if (!strcmp(a, "--exit-on") && more)   exit_on = unescape(argv[++i]);
+        else if (!strcmp(a, "--cycles") && more)    max_cycles = strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(a, "--log") && more)       log_path = argv[++i];
+        else if (!strcmp(a, "--status") && more)    status_sec = atof(argv[++i]);
+        else if (!strcmp(a, "--trace") && more)     trace_arg = std::string("+trace=") + argv[++i];
+        else if (!strcmp(a, "--save") && more)      save_path = argv[++i];
+        else if (!strcmp(a, "--save-at") && more)   save_at = strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(a, "--restore") && more)   restore_path = argv[++i];
+        else if (!strcmp(a, "--cosim"))             cosim_on = true;
+        else if (!strcmp(a, "--cosim-rom") && more) cosim_rom = argv[++i];
+        else if (a[0] == '+')                       continue;   // Verilator plusargs
+        else if (a[0] != '-' && firmware.empty())   firmware = a;
+        else { usage(argv[0]); return 1; }
+    }
+
+    if (firmware.empty() && restore_path.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (save_at && save_path.empty()) {
+        fprintf(stderr, "[SIM] --save-at needs --save FILE\n");
+        return 1;
+    }
+    // trace_sink holds an open file descriptor, which cannot survive a restore
+    if (!trace_arg.empty() && (!save_path.empty() || !restore_path.empty())) {
+        fprintf(stderr, "[SIM] --trace cannot be combined with --save/--restore\n");
+        return 1;
+    }
+
+    // The model starts from reset; a restored CPU's registers are not visible
+    if (cosim_on && !restore_path.empty()) {
+        fprintf(stderr, "[SIM] --cosim cannot be combined with --restore\n");
+        return 1;
+    }
+
+    // RTL debug output is on stdout; keep it away from the terminal
+    if (!freopen(log_path.c_str(), "w", stdout)) {
+        fprintf(stderr, "[SIM] Cannot open log file %s\n", log_path.c_str());
+        return 1;
+    }
+
+    // SRAM model (large array, keep it off the stack)
+    std::unique_ptr<SramModel> sram(new SramModel());
+    g_sram = sram.get();
+    std::string err;
+    if (restore_path.empty()) {
+        if (!sram->load(firmware, err)) {
+            fprintf(stderr, "[SIM] Firmware load failed: %s\n", err.c_str());
+            return 1;
+        }
+        fprintf(stderr, "[SIM] Loaded %s (%u bytes)\n", firmware.c_str(), sram->loaded_bytes());
+    }
+
+    // UART bridge
+    UartBridge uart(UART_BIT_CYCLES);
+    if (use_stdio) {
+        if (!uart.open_stdio(err)) {
+            fprintf(stderr, "[SIM] %s\n", err.c_str());
+            return 1;
+        }
+        fprintf(stderr, "[SIM] UART on this terminal (Ctrl-C to stop)\n");
+    } else {
+        if (!uart.open_pty(link_path, err)) {
+            fprintf(stderr, "[SIM] %s\n", err.c_str());
+            return 1;
+        }
+        fprintf(stderr, "[SIM] UART on %s%s%s\n", uart.pty_name().c_str(),
+                link_path.empty() ? "" : " -> ", link_path.c_str());
+    }
+    // Lockstep model, started from the same SRAM image as the RTL
+    std::unique_ptr<Cosim> cosim;
+    if (cosim_on) {
+        cosim.reset(new Cosim());
+        if (!cosim->init(sram->data(), SramModel::BYTES, cosim_rom, 0, err)) {
+            fprintf(stderr, "[SIM] Cosim: %s\n", err.c_str());
+            return 1;
+        }
+        fprintf(stderr, "[SIM] Lockstep check against rvsim enabled\n");
+    }
+
+    if (!input.empty()) uart.inject(input);
+    if (!exit_on.empty()) uart.set_exit_match(exit_on);
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    // Verilated model
+    const std::unique_ptr<VerilatedContext> ctx(new VerilatedContext);
+    std::vector<const char *> vargs(argv, argv + argc);
+    if (!trace_arg.empty()) vargs.push_back(trace_arg.c_str());
+    ctx->commandArgs((int)vargs.size(), vargs.data());
+    const std::unique_ptr<Vsim_top> top(new Vsim_top(ctx.get()));
+
+    uint64_t cycles = 0;
+    if (!restore_path.empty()) {
+        if (!checkpoint_restore(restore_path, ctx.get(), top.get(), sram.get(), uart, cycles, err)) {
+            fprintf(stderr, "[SIM] Restore failed: %s\n", err.c_str());
+            return 1;
+        }
+        fprintf(stderr, "[SIM] Restored %s at cycle %llu (%.3f ms)\n", restore_path.c_str(),
+                (unsigned long long)cycles, cycles * 1000.0 / SYS_CLK_HZ);
+        if (!firmware.empty()) {
+            if (!sram->load(firmware, err)) {
+                fprintf(stderr, "[SIM] Firmware load failed: %s\n", err.c_str());
+                return 1;
+            }
+            fprintf(stderr, "[SIM] Backdoor-loaded %s (%u bytes)\n", firmware.c_str(), sram->loaded_bytes());
+        }
+    } else {
+        top->EXTCLK = 0;
+        top->BUT1 = 1;
+        top->BUT2 = 1;
+        top->UART_RX = 1;
+        top->UART_CTS_N = 0;
+        top->eval();
+    }
+
+    const uint64_t start_cycles = cycles;
+    double t_start = host_seconds();
+    double t_status = t_start;
+    const char *why = "stopped";
+
+    // One system clock = two EXTCLK periods (clk_div in ice40_picorv32_top)
+    while (!ctx->gotFinish()) {
+        for (int half = 0; half < 4; half++) {
+            top->EXTCLK = !(half & 1);
+            ctx->timeInc(5);
+            top->eval();
+        }
+        cycles++;
+        top->UART_RX = uart.tick(top->UART_TX, top->UART_RTS_N);
+
+        if (cosim && top->TRACE_VALID && !cosim->push(top->TRACE_DATA, cycles)) {
+            why = "cosim divergence";
+            break;
+        }
+
+        if ((cycles & 0xFFFF) == 0) {
+            if (g_stop) { why = "interrupted"; break; }
+            if (status_sec > 0) {
+                double now = host_seconds();
+                if (now - t_status >= status_sec) {
+                    t_status = now;
+                    report(cycles, cycles - start_cycles, now - t_start, uart, "status");
+                }
+            }
+        }
+        if (save_at && cycles == save_at) {
+            if (!checkpoint_save(save_path, ctx.get(), top.get(), sram.get(), uart, cycles, err))
+                fprintf(stderr, "[SIM] Save failed: %s\n", err.c_str());
+            else
+                fprintf(stderr, "[SIM] Checkpoint %s at cycle %llu\n", save_path.c_str(),
+                        (unsigned long long)cycles);
+        }
+        if (uart.exit_matched()) { why = "exit string seen"; break; }
+        if (max_cycles && cycles >= max_cycles) { why = "cycle limit"; break; }
+    }
+    if (ctx->gotFinish()) why = "$finish";
+
+    // Before final(): final blocks would otherwise run in the saved state
+    int rc = 0;
+    if (cosim) {
+        if (!cosim->finish(cycles)) why = "cosim divergence";
+        if (cosim->diverged()) rc = 1;
+    }
+    if (!save_path.empty() && !save_at) {
+        if (!checkpoint_save(save_path, ctx.get(), top.get(), sram.get(), uart, cycles, err)) {
+            fprintf(stderr, "[SIM] Save failed: %s\n", err.c_str());
+            rc = 1;
+        } else {
+            fprintf(stderr, "[SIM] Checkpoint %s at cycle %llu\n", save_path.c_str(),
+                    (unsigned long long)cycles);
+        }
+    }
+
+    top->final();
+    fflush(stdout);
+    fprintf(stderr, "\n");
+    report(cycles, cycles - start_cycles, host_seconds() - t_start, uart, why);
+    if (cosim) cosim->summary(stderr);
+    return rc;
+}
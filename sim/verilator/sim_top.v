@@ -0,0 +1,87 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// sim_top.v - Verilator Simulation Top (SoC + K6R4016 SRAM Shell)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Wraps ice40_picorv32_top together with the SRAM shell so the bidirectional
+// SD bus stays inside the model. Only clock, buttons, LEDs, the UART pins
+// and the PicoRV32 trace port (for --cosim) are visible to the C++ harness
+// (sim_main.cpp).
+//
+//==============================================================================
+
+module sim_top #(
+    parameter ENABLE_TRACE = 1,     // Trace port on; the sink only writes with +trace=
+    parameter VERBOSE = 0,          // Per-access RTL $display (goes to --log)
+    parameter SRAM_FUSED = 0        // 1 = fused 32-bit SRAM engine
+) (
+    input wire EXTCLK,          // 100MHz board clock (driven by harness)
+    input wire BUT1,            // Active-low buttons
+    input wire BUT2,
+    output wire LED1,
+    output wire LED2,
+    input wire UART_RX,         // Host -> FPGA
+    output wire UART_TX,        // FPGA -> Host
+    output wire UART_RTS_N,     // FPGA RX FIFO has room (bridge holds input while high)
+    input wire UART_CTS_N,      // Host ready (harness ties low)
+    output wire TRACE_VALID,    // PicoRV32 trace port, one word per clk
+    output wire [35:0] TRACE_DATA
+);
+
+    wire [17:0] SA;
+    wire [15:0] SD;
+    wire SRAM_CS_N, SRAM_OE_N, SRAM_WE_N;
+
+    ice40_picorv32_top #(
+        .ENABLE_TRACE(ENABLE_TRACE),
+        .VERBOSE(VERBOSE),
+        .SRAM_FUSED(SRAM_FUSED)
+    ) soc (
+        .EXTCLK(EXTCLK),
+        .BUT1(BUT1),
+        .BUT2(BUT2),
+        .LED1(LED1),
+        .LED2(LED2),
+        .UART_RX(UART_RX),
+        .UART_TX(UART_TX),
+        .UART_RTS_N(UART_RTS_N),
+        .UART_CTS_N(UART_CTS_N),
+        .SA(SA),
+        .SD(SD),
+        .SRAM_CS_N(SRAM_CS_N),
+        .SRAM_OE_N(SRAM_OE_N),
+        .SRAM_WE_N(SRAM_WE_N)
+    );
+
+    sram_k6r4016_dpi sram (
+        .clk(EXTCLK),
+        .addr(SA),
+        .data(SD),
+        .cs_n(SRAM_CS_N),
+        .oe_n(SRAM_OE_N),
+        .we_n(SRAM_WE_N)
+    );
+
+    generate
+        if (ENABLE_TRACE) begin : g_trace
+            trace_sink tracer (
+                .clk(soc.clk),
+                .resetn(soc.cpu_resetn),
+                .trace_valid(soc.cpu_trace_valid),
+                .trace_data(soc.cpu_trace_data)
+            );
+            assign TRACE_VALID = soc.cpu_trace_valid;
+            assign TRACE_DATA = soc.cpu_trace_data;
+        end else begin : g_no_trace
+            assign TRACE_VALID = 1'b0;
+            assign TRACE_DATA = 36'd0;
+        end
+    endgenerate
+
+endmodule
@@ -0,0 +1,51 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// sram_k6r4016_dpi.v - K6R4016 SRAM Pin Shell (storage lives in C++)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// 256K x 16 asynchronous SRAM. The array is owned by SramModel (sram_model.cpp)
+// so the harness can preload ELF/hex images and dump contents without going
+// through the bus. Behaviour matches the behavioural model in tb_cpu_run.sv:
+//   - Read data is resolved on the falling edge of EXTCLK, i.e. half a board
+//     clock after SA changes, well before sram_driver_new samples it.
+//   - Writes commit on every rising EXTCLK edge while CS_N and WE_N are low.
+//
+//==============================================================================
+
+module sram_k6r4016_dpi (
+    input wire clk,             // EXTCLK (100MHz)
+    input wire [17:0] addr,
+    inout wire [15:0] data,
+    input wire cs_n,
+    input wire oe_n,
+    input wire we_n
+);
+
+    import "DPI-C" function int sram_model_read(input int addr);
+    import "DPI-C" function void sram_model_write(input int addr, input int data);
+
+    reg [15:0] rd_data = 16'h0000;
+    integer rd_word;
+
+    assign data = (!cs_n && !oe_n && we_n) ? rd_data : 16'hzzzz;
+
+    always @(negedge clk) begin
+        if (!cs_n && !oe_n) begin
+            rd_word = sram_model_read({14'd0, addr});
+            rd_data <= rd_word[15:0];
+        end
+    end
+
+    always @(posedge clk) begin
+        if (!cs_n && !we_n) begin
+            sram_model_write({14'd0, addr}, {16'd0, data});
+        end
+    end
+
+endmodule
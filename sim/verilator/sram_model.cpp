@@ -0,0 +1,214 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// sram_model.cpp - K6R4016 SRAM Array Model for the Verilator Harness
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "sram_model.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <vector>
+
+#include "Vsim_top__Dpi.h"
+
+SramModel *g_sram = nullptr;
+
+//==============================================================================
+// DPI-C hooks (called from sram_k6r4016_dpi.v)
+//==============================================================================
+
+int sram_model_read(int addr) {
+    return g_sram ? g_sram->read16((uint32_t)addr) : 0;
+}
+
+void sram_model_write(int addr, int data) {
+    if (g_sram) g_sram->write16((uint32_t)addr, (uint16_t)data);
+}
+
+//==============================================================================
+// Array access
+//==============================================================================
+
+SramModel::SramModel() : loaded(0) {
+    clear();
+}
+
+void SramModel::clear(uint16_t fill) {
+    for (uint32_t i = 0; i < WORDS; i++) mem[i] = fill;
+    loaded = 0;
+}
+
+uint8_t SramModel::read8(uint32_t byte_addr) const {
+    uint16_t w = read16(byte_addr >> 1);
+    return (byte_addr & 1) ? (uint8_t)(w >> 8) : (uint8_t)w;
+}
+
+void SramModel::write8(uint32_t byte_addr, uint8_t v) {
+    uint16_t w = read16(byte_addr >> 1);
+    if (byte_addr & 1) w = (uint16_t)((w & 0x00FF) | (v << 8));
+    else               w = (uint16_t)((w & 0xFF00) | v);
+    write16(byte_addr >> 1, w);
+}
+
+uint32_t SramModel::read32(uint32_t byte_addr) const {
+    return (uint32_t)read16(byte_addr >> 1) | ((uint32_t)read16((byte_addr >> 1) + 1) << 16);
+}
+
+//==============================================================================
+// Loaders
+//==============================================================================
+
+static bool read_file(const std::string &path, std::vector<uint8_t> &buf, std::string &err) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) {
+        err = "cannot open " + path;
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf.resize(len > 0 ? (size_t)len : 0);
+    if (len > 0 && fread(buf.data(), 1, (size_t)len, f) != (size_t)len) {
+        fclose(f);
+        err = "short read on " + path;
+        return false;
+    }
+    fclose(f);
+    return true;
+}
+
+bool SramModel::load(const std::string &path, std::string &err) {
+    std::vector<uint8_t> head;
+    if (!read_file(path, head, err)) return false;
+
+    if (head.size() >= 4 && head[0] == 0x7F && head[1] == 'E' && head[2] == 'L' && head[3] == 'F')
+        return load_elf(path, err);
+
+    // Text hex files contain only hex digits, '@', whitespace and comments
+    bool text = !head.empty();
+    for (size_t i = 0; i < head.size() && i < 4096; i++) {
+        uint8_t c = head[i];
+        if (!(isxdigit(c) || isspace(c) || c == '@' || c == '/' || c == '_')) {
+            text = false;
+            break;
+        }
+    }
+    return text ? load_hex(path, err) : load_bin(path, err);
+}
+
+static uint16_t rd16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t rd32(const uint8_t *p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+bool SramModel::load_elf(const std::string &path, std::string &err) {
+    std::vector<uint8_t> f;
+    if (!read_file(path, f, err)) return false;
+
+    if (f.size() < 52 || f[4] != 1 /* ELFCLASS32 */ || f[5] != 1 /* little-endian */) {
+        err = path + ": not a little-endian ELF32 file";
+        return false;
+    }
+    if (rd16(&f[18]) != 243 /* EM_RISCV */) {
+        err = path + ": not a RISC-V ELF";
+        return false;
+    }
+
+    uint32_t phoff = rd32(&f[28]);
+    uint16_t phentsize = rd16(&f[42]);
+    uint16_t phnum = rd16(&f[44]);
+
+    for (uint16_t i = 0; i < phnum; i++) {
+        size_t ph = (size_t)phoff + (size_t)i * phentsize;
+        if (ph + 32 > f.size()) {
+            err = path + ": truncated program header table";
+            return false;
+        }
+        uint32_t p_type   = rd32(&f[ph + 0]);
+        uint32_t p_offset = rd32(&f[ph + 4]);
+        uint32_t p_paddr  = rd32(&f[ph + 12]);
+        uint32_t p_filesz = rd32(&f[ph + 16]);
+
+        if (p_type != 1 /* PT_LOAD */ || p_filesz == 0) continue;
+        if ((size_t)p_offset + p_filesz > f.size()) {
+            err = path + ": segment extends past end of file";
+            return false;
+        }
+        if (p_paddr >= BYTES || p_paddr + p_filesz > BYTES) {
+            err = path + ": segment outside 512KB SRAM";
+            return false;
+        }
+        for (uint32_t b = 0; b < p_filesz; b++)
+            write8(p_paddr + b, f[p_offset + b]);
+        loaded += p_filesz;
+    }
+    return true;
+}
+
+bool SramModel::load_hex(const std::string &path, std::string &err) {
+    FILE *f = fopen(path.c_str(), "r");
+    if (!f) {
+        err = "cannot open " + path;
+        return false;
+    }
+
+    // objcopy -O verilog: "@<byte addr>" then 2-digit byte tokens
+    // $readmemh word hex:  "@<word addr>" then 8-digit word tokens
+    uint32_t addr = 0;          // next load address in token units
+    uint32_t pending_at = 0;
+    bool have_at = false;
+    char tok[64];
+
+    while (fscanf(f, "%63s", tok) == 1) {
+        if (tok[0] == '/' && tok[1] == '/') {
+            int c;
+            while ((c = fgetc(f)) != EOF && c != '\n') {}
+            continue;
+        }
+        if (tok[0] == '@') {
+            pending_at = (uint32_t)strtoul(tok + 1, nullptr, 16);
+            have_at = true;
+            continue;
+        }
+        size_t n = strlen(tok);
+        uint32_t v = (uint32_t)strtoul(tok, nullptr, 16);
+        if (n <= 2) {
+            if (have_at) { addr = pending_at; have_at = false; }
+            if (addr >= BYTES) break;
+            write8(addr++, (uint8_t)v);
+            loaded += 1;
+        } else {
+            if (have_at) { addr = pending_at; have_at = false; }
+            uint32_t byte_addr = addr * 4;
+            if (byte_addr >= BYTES) break;
+            write16(byte_addr >> 1, (uint16_t)v);
+            write16((byte_addr >> 1) + 1, (uint16_t)(v >> 16));
+            addr++;
+            loaded += 4;
+        }
+    }
+    fclose(f);
+
+    if (loaded == 0) {
+        err = path + ": no data found";
+        return false;
+    }
+    return true;
+}
+
+bool SramModel::load_bin(const std::string &path, std::string &err) {
+    std::vector<uint8_t> f;
+    if (!read_file(path, f, err)) return false;
+    if (f.size() > BYTES) {
+        err = path + ": image larger than 512KB SRAM";
+        return false;
+    }
+    for (size_t b = 0; b < f.size(); b++) write8((uint32_t)b, f[b]);
+    loaded += (uint32_t)f.size();
+    return true;
+}
@@ -0,0 +1,57 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// sram_model.h - K6R4016 SRAM Array Model for the Verilator Harness
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#ifndef SRAM_MODEL_H
+#define SRAM_MODEL_H
+
+#include <stdint.h>
+#include <string>
+
+class SramModel {
+public:
+    static const uint32_t WORDS = 262144;       // 256K x 16-bit
+    static const uint32_t BYTES = WORDS * 2;    // 512KB
+
+    SramModel();
+
+    void clear(uint16_t fill = 0);
+
+    uint16_t read16(uint32_t word_addr) const { return mem[word_addr & (WORDS - 1)]; }
+    void write16(uint32_t word_addr, uint16_t v) { mem[word_addr & (WORDS - 1)] = v; }
+
+    // Byte view (little-endian, matches sram_proc_new lane order)
+    uint8_t read8(uint32_t byte_addr) const;
+    void write8(uint32_t byte_addr, uint8_t v);
+    uint32_t read32(uint32_t byte_addr) const;
+
+    // Image loaders. Format is picked from the file contents:
+    //   ELF32 (PT_LOAD segments at their LMA), objcopy -O verilog byte hex,
+    //   $readmemh-style 32-bit word hex, or raw binary at address 0.
+    // Returns false and fills err on failure.
+    bool load(const std::string &path, std::string &err);
+    bool load_elf(const std::string &path, std::string &err);
+    bool load_hex(const std::string &path, std::string &err);
+    bool load_bin(const std::string &path, std::string &err);
+
+    uint32_t loaded_bytes() const { return loaded; }
+
+    // Raw access for checkpointing / backdoor tools
+    uint16_t *data() { return mem; }
+
+private:
+    uint16_t mem[WORDS];
+    uint32_t loaded;
+};
+
+// Instance used by the DPI-C hooks in sram_k6r4016_dpi.v
+extern SramModel *g_sram;
+
+#endif // SRAM_MODEL_H
@@ -0,0 +1,234 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// uart_bridge.cpp - Bit-Level UART <-> Host pty/stdio Bridge
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "uart_bridge.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Host polling interval in system clocks (~1/4 character time)
+#define POLL_INTERVAL 1024
+
+UartBridge::UartBridge(uint32_t bit_cycles_)
+    : bit_cycles(bit_cycles_),
+      tx_active(false), tx_count_down(0), tx_bit(0), tx_shift(0), tx_prev(1),
+      rx_active(false), rx_count_down(0), rx_bit(0), rx_byte(0), rx_level(1),
+      poll_count_down(POLL_INTERVAL),
+      fd_in(-1), fd_out(-1), is_stdio(false), closed(false), termios_saved(false),
+      matched(false), tx_count(0), rx_count(0) {
+    memset(&saved_termios, 0, sizeof(saved_termios));
+}
+
+UartBridge::~UartBridge() {
+    if (termios_saved) tcsetattr(fd_in, TCSANOW, &saved_termios);
+    if (!is_stdio && fd_in >= 0) close(fd_in);
+    if (!link_name.empty()) unlink(link_name.c_str());
+}
+
+//==============================================================================
+// Host endpoints
+//==============================================================================
+
+bool UartBridge::open_pty(const std::string &link_path, std::string &err) {
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0 || grantpt(fd) < 0 || unlockpt(fd) < 0) {
+        err = std::string("posix_openpt: ") + strerror(errno);
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    const char *name = ptsname(fd);
+    slave_name = name ? name : "";
+
+    // Raw 8N1 on the slave side so terminal programs see bytes unmodified
+    struct termios t;
+    int sfd = open(slave_name.c_str(), O_RDWR | O_NOCTTY);
+    if (sfd >= 0) {
+        if (tcgetattr(sfd, &t) == 0) {
+            cfmakeraw(&t);
+            tcsetattr(sfd, TCSANOW, &t);
+        }
+        close(sfd);
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fd_in = fd_out = fd;
+
+    if (!link_path.empty()) {
+        unlink(link_path.c_str());
+        if (symlink(slave_name.c_str(), link_path.c_str()) == 0)
+            link_name = link_path;
+    }
+    return true;
+}
+
+bool UartBridge::open_stdio(std::string &err) {
+    fd_in = STDIN_FILENO;
+    fd_out = STDERR_FILENO;     // stdout is reserved for RTL $display output
+    is_stdio = true;
+
+    if (isatty(fd_in)) {
+        if (tcgetattr(fd_in, &saved_termios) != 0) {
+            err = std::string("tcgetattr: ") + strerror(errno);
+            return false;
+        }
+        termios_saved = true;
+        struct termios t = saved_termios;
+        t.c_lflag &= ~(ICANON | ECHO);      // Keep ISIG so Ctrl-C stops the sim
+        t.c_iflag &= ~(ICRNL | IXON);
+        t.c_cc[VMIN] = 0;
+        t.c_cc[VTIME] = 0;
+        tcsetattr(fd_in, TCSANOW, &t);
+    }
+    fcntl(fd_in, F_SETFL, fcntl(fd_in, F_GETFL) | O_NONBLOCK);
+    return true;
+}
+
+void UartBridge::inject(const std::string &s) {
+    for (size_t i = 0; i < s.size(); i++) rx_queue.push_back((uint8_t)s[i]);
+}
+
+void UartBridge::poll_host() {
+    if (fd_in < 0 || closed) return;
+    uint8_t buf[256];
+    ssize_t n = read(fd_in, buf, sizeof(buf));
+    if (n > 0) {
+        for (ssize_t i = 0; i < n; i++) rx_queue.push_back(buf[i]);
+    } else if (n == 0 && is_stdio && !isatty(fd_in)) {
+        closed = true;          // EOF on piped stdin
+    }
+    // EIO on a pty master just means no client has the slave open yet
+}
+
+void UartBridge::emit(uint8_t b) {
+    tx_count++;
+    if (fd_out >= 0) {
+        ssize_t r = write(fd_out, &b, 1);
+        (void)r;                // Drop output if nobody is listening
+    }
+    if (!exit_match.empty() && !matched) {
+        tail.push_back((char)b);
+        if (tail.size() > exit_match.size()) tail.erase(0, tail.size() - exit_match.size());
+        if (tail == exit_match) matched = true;
+    }
+}
+
+//==============================================================================
+// FPGA TX -> host: detect start bit, sample mid-bit
+//==============================================================================
+
+void UartBridge::tick_tx(uint8_t tx) {
+    if (!tx_active) {
+        if (tx_prev && !tx) {
+            tx_active = true;
+            tx_bit = -1;
+            tx_count_down = bit_cycles / 2;     // centre of start bit
+        }
+    } else if (--tx_count_down == 0) {
+        if (tx_bit < 0) {
+            if (tx) tx_active = false;          // glitch, not a start bit
+            else { tx_bit = 0; tx_shift = 0; }
+        } else if (tx_bit < 8) {
+            tx_shift |= (uint8_t)((tx & 1) << tx_bit);
+            tx_bit++;
+        } else {
+            emit(tx_shift);                     // stop bit (framing not checked)
+            tx_active = false;
+        }
+        tx_count_down = bit_cycles;
+    }
+    tx_prev = tx;
+}
+
+//==============================================================================
+// Host -> FPGA RX: shift queued bytes out at the configured bit rate
+//==============================================================================
+
+uint8_t UartBridge::tick_rx(uint8_t rts_n) {
+    if (!rx_active) {
+        if (rx_queue.empty()) {
+            if (--poll_count_down == 0) {
+                poll_count_down = POLL_INTERVAL;
+                poll_host();
+            }
+            return rx_level = 1;
+        }
+        if (rts_n)
+            return rx_level = 1;                // RX FIFO nearly full: hold off
+        rx_byte = rx_queue.front();
+        rx_queue.pop_front();
+        rx_active = true;
+        rx_bit = -1;
+        rx_count_down = bit_cycles;
+        rx_count++;
+        return rx_level = 0;                    // start bit
+    }
+
+    if (--rx_count_down == 0) {
+        rx_bit++;
+        rx_count_down = bit_cycles;
+        if (rx_bit < 8) {
+            rx_level = (rx_byte >> rx_bit) & 1;
+        } else if (rx_bit == 8) {
+            rx_level = 1;                       // stop bit
+        } else {
+            rx_active = false;
+            rx_level = 1;
+        }
+    }
+    return rx_level;
+}
+
+//==============================================================================
+// Checkpoint state
+//==============================================================================
+
+#define UART_STATE_VERSION 1
+
+template <typename T> static void put(std::string &s, const T &v) {
+    s.append((const char *)&v, sizeof(v));
+}
+
+template <typename T> static bool get(const std::string &s, size_t &pos, T &v) {
+    if (pos + sizeof(v) > s.size()) return false;
+    memcpy(&v, s.data() + pos, sizeof(v));
+    pos += sizeof(v);
+    return true;
+}
+
+std::string UartBridge::save_state() const {
+    std::string s;
+    put(s, (uint32_t)UART_STATE_VERSION);
+    put(s, tx_active); put(s, tx_count_down); put(s, tx_bit); put(s, tx_shift); put(s, tx_prev);
+    put(s, rx_active); put(s, rx_count_down); put(s, rx_bit); put(s, rx_byte); put(s, rx_level);
+    put(s, tx_count); put(s, rx_count);
+    put(s, (uint32_t)rx_queue.size());
+    for (size_t i = 0; i < rx_queue.size(); i++) s.push_back((char)rx_queue[i]);
+    return s;
+}
+
+bool UartBridge::restore_state(const std::string &s) {
+    size_t pos = 0;
+    uint32_t version = 0, queued = 0;
+    if (!get(s, pos, version) || version != UART_STATE_VERSION) return false;
+    bool ok = get(s, pos, tx_active) && get(s, pos, tx_count_down) && get(s, pos, tx_bit) &&
+              get(s, pos, tx_shift) && get(s, pos, tx_prev) &&
+              get(s, pos, rx_active) && get(s, pos, rx_count_down) && get(s, pos, rx_bit) &&
+              get(s, pos, rx_byte) && get(s, pos, rx_level) &&
+              get(s, pos, tx_count) && get(s, pos, rx_count) && get(s, pos, queued);
+    if (!ok || pos + queued != s.size()) return false;
+    // Restored input goes ahead of anything already injected for this run
+    for (uint32_t i = queued; i > 0; i--) rx_queue.push_front((uint8_t)s[pos + i - 1]);
+    return true;
+}
@@ -0,0 +1,98 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// uart_bridge.h - Bit-Level UART <-> Host pty/stdio Bridge
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#ifndef UART_BRIDGE_H
+#define UART_BRIDGE_H
+
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <termios.h>
+
+class UartBridge {
+public:
+    // bit_cycles: system clocks per bit (50MHz / 115200 = 434, as in uart.v)
+    explicit UartBridge(uint32_t bit_cycles = 434);
+    ~UartBridge();
+
+    // Host side. open_pty() creates a pseudo-terminal (and optional symlink
+    // to its slave); open_stdio() puts the controlling terminal in raw mode.
+    bool open_pty(const std::string &link_path, std::string &err);
+    bool open_stdio(std::string &err);
+    const std::string &pty_name() const { return slave_name; }
+
+    // Queue bytes for the FPGA RX pin (scripted input)
+    void inject(const std::string &s);
+
+    // Stop condition: returns true once the FPGA has transmitted this string
+    void set_exit_match(const std::string &s) { exit_match = s; }
+    bool exit_matched() const { return matched; }
+
+    // Advance one system clock. tx is the FPGA UART_TX pin, rts_n its
+    // UART_RTS_N (no new byte is started while it is high); returns the
+    // level to drive on UART_RX.
+    inline uint8_t tick(uint8_t tx, uint8_t rts_n = 0) {
+        tick_tx(tx);
+        return tick_rx(rts_n);
+    }
+
+    // Checkpointing: line state, queued input and byte counters. The host
+    // endpoint and exit match belong to the new run and are not saved.
+    std::string save_state() const;
+    bool restore_state(const std::string &s);
+
+    bool host_closed() const { return closed; }
+    uint64_t tx_bytes() const { return tx_count; }
+    uint64_t rx_bytes() const { return rx_count; }
+
+private:
+    void tick_tx(uint8_t tx);
+    uint8_t tick_rx(uint8_t rts_n);
+    void poll_host();
+    void emit(uint8_t b);
+
+    uint32_t bit_cycles;
+
+    // FPGA -> host receiver
+    bool tx_active;
+    uint32_t tx_count_down;
+    int tx_bit;
+    uint8_t tx_shift;
+    uint8_t tx_prev;
+
+    // Host -> FPGA transmitter
+    bool rx_active;
+    uint32_t rx_count_down;
+    int rx_bit;             // -1 = start, 0..7 data, 8 = stop
+    uint8_t rx_byte;
+    uint8_t rx_level;
+    std::deque<uint8_t> rx_queue;
+    uint32_t poll_count_down;
+
+    // Host endpoint
+    int fd_in;
+    int fd_out;
+    bool is_stdio;
+    bool closed;
+    bool termios_saved;
+    struct termios saved_termios;
+    std::string slave_name;
+    std::string link_name;
+
+    std::string exit_match;
+    std::string tail;
+    bool matched;
+
+    uint64_t tx_count;
+    uint64_t rx_count;
+};
+
+#endif // UART_BRIDGE_H
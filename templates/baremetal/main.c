@@ -6,7 +6,7 @@
 // Email: mikewolak@gmail.com, mike@epromfoundry.com
 //===============================================================================
 
-#include "../../lib/peripherals.h"
+#include "hal.h"
 
 int main(void) {
     int count = 0;
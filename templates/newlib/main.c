@@ -7,11 +7,10 @@
 //===============================================================================
 
 #include <stdio.h>
-#include "../../lib/peripherals.h"
+#include "hal.h"
 
 // Direct UART getch - no echo, no buffering (for non-echoed input)
 static int getch(void) {
-    while (!uart_available());
     return uart_getc();
 }
 
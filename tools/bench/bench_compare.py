@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#===============================================================================
+# Olimex iCE40HX8K-EVB RISC-V Platform
+# bench_compare.py - Compare Two Batch Benchmark Result Files
+#
+# Copyright (c) October 2025 Michael Wolak
+# Email: mikewolak@gmail.com, mike@epromfoundry.com
+#
+# NOT FOR COMMERCIAL USE
+# Educational and research purposes only
+#===============================================================================
+#
+# Reads the batch mode output of algo_test / math_test / heap_test
+# (lib/bench bench_run_cases()): raw UART or rvsim logs containing
+# "@@CSV ..." / "@@JSON {...}" lines, or result files written by --save
+# (JSON lines or CSV). Results are keyed by suite/test.
+#
+# Usage:
+#   bench_compare.py --save base.jsonl algo.log math.log heap.log
+#   bench_compare.py base.jsonl new.jsonl                 # 5% threshold
+#   bench_compare.py base.jsonl new.log --threshold 2 --metric bytes_per_sec
+#
+# Exit status: 0 = no regression, 1 = a test got slower than the threshold,
+# failed (pass=0) or disappeared, 2 = bad input.
+#===============================================================================
+
+import argparse
+import csv
+import json
+import sys
+
+FIELDS = ["suite", "test", "reps", "iterations", "bytes", "cycles_min",
+          "cycles_avg", "cycles_per_iter", "bytes_per_sec", "pass"]
+
+# Metric -> True if larger is better
+METRICS = {
+    "cycles_min": False,
+    "cycles_avg": False,
+    "cycles_per_iter": False,
+    "bytes_per_sec": True,
+}
+
+
+def convert(rec):
+    out = {}
+    for k in FIELDS:
+        if k not in rec:
+            raise ValueError(f"missing field '{k}'")
+        v = rec[k]
+        if k in ("suite", "test"):
+            out[k] = str(v)
+        elif k == "cycles_per_iter":
+            out[k] = float(v)
+        else:
+            out[k] = int(v)
+    return out
+
+
+def load(path):
+    """suite/test -> record; JSON lines win over CSV lines for the same test"""
+    results = {}
+    csv_results = {}
+    header = None
+    with open(path, errors="replace") as f:
+        for n, line in enumerate(f, 1):
+            line = line.strip().replace("\r", "")
+            # UART logs: the tag may follow other output on the same line
+            for tag in ("@@JSON ", "@@CSV "):
+                i = line.find(tag)
+                if i >= 0:
+                    line = tag + line[i + len(tag):]
+                    break
+            try:
+                if line.startswith("@@JSON ") or line.startswith("{"):
+                    rec = convert(json.loads(line[7:] if line.startswith("@@") else line))
+                    results[rec["suite"] + "/" + rec["test"]] = rec
+                    continue
+                row = line[6:] if line.startswith("@@CSV ") else line
+                cols = next(csv.reader([row])) if row else []
+                if cols[:2] == ["suite", "test"]:
+                    header = cols
+                elif header and len(cols) == len(header):
+                    rec = convert(dict(zip(header, cols)))
+                    csv_results[rec["suite"] + "/" + rec["test"]] = rec
+            except (ValueError, KeyError) as e:
+                raise ValueError(f"{path}:{n}: {e}")
+    for k, v in csv_results.items():
+        results.setdefault(k, v)
+    return results
+
+
+def save(path, results):
+    recs = [results[k] for k in sorted(results)]
+    with open(path, "w", newline="") as f:
+        if path.endswith(".csv"):
+            w = csv.DictWriter(f, fieldnames=FIELDS)
+            w.writeheader()
+            w.writerows(recs)
+        else:
+            for r in recs:
+                f.write(json.dumps(r) + "\n")
+
+
+def compare(base, new, metric, threshold):
+    higher_better = METRICS[metric]
+    regressions = 0
+    print(f"{'test':<24} {'base':>14} {'new':>14} {'change':>9}  status")
+    for key in sorted(set(base) | set(new)):
+        b, n = base.get(key), new.get(key)
+        if n is None:
+            print(f"{key:<24} {b[metric]:>14} {'-':>14} {'':>9}  MISSING")
+            regressions += 1
+            continue
+        if b is None:
+            print(f"{key:<24} {'-':>14} {n[metric]:>14} {'':>9}  new")
+            continue
+
+        bv, nv = b[metric], n[metric]
+        change = (nv - bv) * 100.0 / bv if bv else 0.0
+        worse = -change if higher_better else change
+        if not n["pass"]:
+            status = "FAIL"
+            regressions += 1
+        elif bv and worse > threshold:
+            status = "REGRESSION"
+            regressions += 1
+        elif bv and worse < -threshold:
+            status = "improved"
+        else:
+            status = "ok"
+        if b["iterations"] != n["iterations"] or b["bytes"] != n["bytes"]:
+            status += " (workload changed)"
+        print(f"{key:<24} {bv:>14} {nv:>14} {change:>+8.2f}%  {status}")
+
+    print(f"\n{regressions} regression(s) above {threshold:g}% in {metric}")
+    return regressions
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Compare batch benchmark results")
+    ap.add_argument("files", nargs="+", help="BASE NEW, or logs to merge with --save")
+    ap.add_argument("--save", metavar="OUT",
+                    help="merge the given logs into OUT (.csv or JSON lines)")
+    ap.add_argument("--threshold", type=float, default=5.0,
+                    help="regression threshold in percent (default 5)")
+    ap.add_argument("--metric", choices=sorted(METRICS), default="cycles_min",
+                    help="value to compare (default cycles_min)")
+    args = ap.parse_args()
+
+    try:
+        if args.save:
+            merged = {}
+            for p in args.files:
+                merged.update(load(p))
+            if not merged:
+                print("ERROR: no results found", file=sys.stderr)
+                return 2
+            save(args.save, merged)
+            failed = sum(1 for r in merged.values() if not r["pass"])
+            print(f"✓ {len(merged)} results written to {args.save}"
+                  + (f" ({failed} FAILED)" if failed else ""))
+            return 1 if failed else 0
+
+        if len(args.files) != 2:
+            ap.error("need BASE and NEW result files")
+        base, new = load(args.files[0]), load(args.files[1])
+    except (OSError, ValueError) as e:
+        print(f"ERROR: {e}", file=sys.stderr)
+        return 2
+
+    if not base or not new:
+        print("ERROR: no results in " + (args.files[0] if not base else args.files[1]),
+              file=sys.stderr)
+        return 2
+    return 1 if compare(base, new, args.metric, args.threshold) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
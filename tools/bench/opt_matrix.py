@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+#===============================================================================
+# Olimex iCE40HX8K-EVB RISC-V Platform
+# opt_matrix.py - Optimization Profile Matrix: Code Size vs. Cycles Scoreboard
+#
+# Copyright (c) October 2025 Michael Wolak
+# Email: mikewolak@gmail.com, mike@epromfoundry.com
+#
+# NOT FOR COMMERCIAL USE
+# Educational and research purposes only
+#===============================================================================
+#
+# Builds every firmware once per optimization profile (firmware/Makefile
+# OPT=<name>, see 'make -C firmware opt-profiles'), reads the text/data/bss
+# that $(SIZE) recorded next to each ELF, runs the benchmark firmware of each
+# profile in tools/rvsim and prints one scoreboard row per profile:
+#
+#   profile  text  data  bss  | dhrystone  coremark  algo_test ...  (cycles)
+#
+# Sizes are summed over all firmware of the profile; the benchmark columns
+# are CPU cycles measured by the timer peripheral (@@BENCH for Dhrystone and
+# CoreMark, sum of cycles_min over the @@CSV cases of the batch suites), so a
+# lower number is better in every column. The second line of each row is the
+# change against the first profile (O2, the default build).
+#
+# Profiles build into firmware/build/<target>-<config>-<opt>/ with PUBLISH=0,
+# so firmware/<target>.elf is not touched.
+#
+# Usage:
+#   opt_matrix.py                          # all profiles, all benchmarks
+#   opt_matrix.py --profiles O2,Os,lto --bench dhrystone,algo_test
+#   opt_matrix.py --no-build --csv matrix.csv --json matrix.json
+#
+# Exit status: 0 = scoreboard complete, 1 = a build or benchmark failed
+# (the scoreboard still shows the rest), 2 = bad arguments.
+#===============================================================================
+
+import argparse
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+FW_DIR = os.path.join(ROOT, "firmware")
+RVSIM = os.path.join(ROOT, "tools", "rvsim", "rvsim")
+
+# name -> rvsim input that starts it (None = runs at reset)
+BENCHES = {
+    "dhrystone": None,
+    "coremark": None,
+    "algo_test": " b",
+    "math_test": " b",
+    "heap_test": " b",
+}
+
+BENCH_RE = re.compile(r"^@@BENCH name=\S+ .*cycles=(\d+) .*valid=(\d)")
+
+
+def make(args, quiet=True):
+    cmd = ["make", "-C", FW_DIR, "--no-print-directory"] + args
+    out = subprocess.DEVNULL if quiet else None
+    return subprocess.call(cmd, stdout=out, stderr=subprocess.STDOUT if quiet else None) == 0
+
+
+def profiles_from_makefile():
+    out = subprocess.check_output(["make", "-s", "-C", FW_DIR, "--no-print-directory",
+                                   "opt-profiles"], text=True, stderr=subprocess.DEVNULL)
+    # $(info) banners are full sentences; profile names are single words
+    return [l.strip() for l in out.splitlines() if l.strip() and " " not in l.strip()]
+
+
+def suffix(profile):
+    return "" if profile == "O2" else "-" + profile
+
+
+def build(profile, benches, jobs):
+    """Builds all firmware plus the benchmark targets; returns error strings"""
+    base = [f"-j{jobs}", f"OPT={profile}", "PUBLISH=0"]
+    errors = []
+    print(f"Building profile {profile}...", flush=True)
+    if not make(base + ["all"]):
+        errors.append("firmware build failed")
+    extra = [f"newlib-{b}" for b in benches if b in ("dhrystone", "coremark")]
+    if extra and not make(base + extra):
+        errors.append("benchmark build failed")
+    return errors
+
+
+def sizes(profile):
+    """target -> (text, data, bss) from build/<target>-{bare,newlib}<sfx>/*.size"""
+    result = {}
+    for cfg in ("bare", "newlib"):
+        pattern = os.path.join(FW_DIR, "build", f"*-{cfg}{suffix(profile)}", "*.size")
+        for path in glob.glob(pattern):
+            target = os.path.basename(path)[:-len(".size")]
+            if os.path.basename(os.path.dirname(path)) != f"{target}-{cfg}{suffix(profile)}":
+                continue
+            with open(path) as f:
+                lines = f.read().split("\n")
+            fields = lines[1].split() if len(lines) > 1 else []
+            if len(fields) >= 3 and fields[0].isdigit():
+                result[target] = tuple(int(x) for x in fields[:3])
+    return result
+
+
+def run_bench(profile, name, max_cycles):
+    """Returns (cycles, error)"""
+    elf = os.path.join(FW_DIR, "build", f"{name}-newlib{suffix(profile)}", f"{name}.elf")
+    if not os.path.isfile(elf):
+        return None, "not built"
+    cmd = [RVSIM, "--no-stdin", "--uart-fast", "--exit-on", "@@BENCH END",
+           "--max-cycles", str(max_cycles)]
+    if BENCHES[name]:
+        cmd += ["--input", BENCHES[name]]
+    log_path = os.path.join(os.path.dirname(elf), f"{name}.opt.log")
+    try:
+        out = subprocess.run(cmd + [elf], capture_output=True, text=True,
+                             errors="replace", timeout=1800).stdout
+    except subprocess.TimeoutExpired:
+        return None, "timeout"
+    with open(log_path, "w") as f:
+        f.write(out)
+
+    total = 0
+    found = False
+    for line in out.replace("\r", "").split("\n"):
+        m = BENCH_RE.match(line)
+        if m:
+            if m.group(2) != "1":
+                return None, "invalid run"
+            return int(m.group(1)), None
+        if line.startswith("@@CSV ") and not line.startswith("@@CSV suite,"):
+            f = line[6:].split(",")
+            if len(f) < 10:
+                continue
+            if f[9].strip() != "1":
+                return None, f"{f[1]} failed"
+            total += int(f[5])
+            found = True
+    if found:
+        return total, None
+    return None, f"no result (see {os.path.relpath(log_path, ROOT)})"
+
+
+def pct(new, base):
+    if new is None or not base:
+        return ""
+    return f"{100.0 * (new - base) / base:+.1f}%"
+
+
+def print_scoreboard(rows, benches):
+    cols = ["text", "data", "bss"] + benches
+    widths = [10] * 3 + [max(12, len(b) + 2) for b in benches]
+    print("")
+    print("=" * (14 + sum(widths)))
+    print("Optimization profile scoreboard (sizes summed, benchmarks in cycles)")
+    print("=" * (14 + sum(widths)))
+    print(f"{'profile':<14}" + "".join(f"{c:>{w}}" for c, w in zip(cols, widths)))
+    print("-" * (14 + sum(widths)))
+    base = rows[0] if rows else None
+    for r in rows:
+        vals = [r["text"], r["data"], r["bss"]] + [r["cycles"].get(b) for b in benches]
+        print(f"{r['profile']:<14}" + "".join(
+            f"{('-' if v is None else v):>{w}}" for v, w in zip(vals, widths)))
+        if r is not base:
+            bvals = [base["text"], base["data"], base["bss"]] + \
+                    [base["cycles"].get(b) for b in benches]
+            print(f"{'':<14}" + "".join(
+                f"{pct(v, bv):>{w}}" for v, bv, w in zip(vals, bvals, widths)))
+    print("-" * (14 + sum(widths)))
+    print(f"Delta rows are against {base['profile'] if base else '-'}; lower is better everywhere.")
+
+    best = {}
+    for b in benches:
+        have = [r for r in rows if r["cycles"].get(b) is not None]
+        if have:
+            best[b] = min(have, key=lambda r: r["cycles"][b])["profile"]
+    have = [r for r in rows if r["text"]]
+    if have:
+        print(f"Smallest text: {min(have, key=lambda r: r['text'])['profile']}")
+    for b, p in best.items():
+        print(f"Fastest {b}: {p}")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Build all firmware per optimization profile "
+                                             "and print a size vs. cycles scoreboard")
+    ap.add_argument("--profiles", help="comma separated (default: all, from the Makefile)")
+    ap.add_argument("--bench", default=",".join(BENCHES),
+                    help="comma separated benchmarks (default: %(default)s)")
+    ap.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 4)
+    ap.add_argument("--no-build", action="store_true", help="reuse the existing builds")
+    ap.add_argument("--max-cycles", type=int, default=4000000000)
+    ap.add_argument("--csv", help="write the scoreboard as CSV")
+    ap.add_argument("--json", help="write per-profile, per-target sizes and cycles as JSON")
+    args = ap.parse_args()
+
+    profiles = args.profiles.split(",") if args.profiles else profiles_from_makefile()
+    benches = [b for b in args.bench.split(",") if b]
+    unknown = [b for b in benches if b not in BENCHES]
+    if unknown:
+        print(f"ERROR: unknown benchmark(s) {', '.join(unknown)}; choose from {', '.join(BENCHES)}")
+        return 2
+    if "coremark" in benches and not os.path.isfile(
+            os.path.join(ROOT, "lib", "bench", "coremark", "upstream", "core_main.c")):
+        print("CoreMark sources not fetched ('make coremark-fetch') - skipping coremark")
+        benches.remove("coremark")
+    if benches and not os.access(RVSIM, os.X_OK):
+        print(f"ERROR: {RVSIM} not found - run 'make rvsim'")
+        return 2
+
+    status = 0
+    rows = []
+    for p in profiles:
+        errors = [] if args.no_build else build(p, benches, args.jobs)
+        sz = sizes(p)
+        row = {
+            "profile": p,
+            "targets": len(sz),
+            "text": sum(s[0] for s in sz.values()),
+            "data": sum(s[1] for s in sz.values()),
+            "bss": sum(s[2] for s in sz.values()),
+            "sizes": {t: dict(zip(("text", "data", "bss"), s)) for t, s in sorted(sz.items())},
+            "cycles": {},
+            "errors": errors,
+        }
+        for b in benches:
+            print(f"  {p}: running {b} in rvsim...", flush=True)
+            cycles, err = run_bench(p, b, args.max_cycles)
+            row["cycles"][b] = cycles
+            if err:
+                row["errors"].append(f"{b}: {err}")
+        for e in row["errors"]:
+            print(f"✗ {p}: {e}")
+            status = 1
+        rows.append(row)
+
+    print_scoreboard(rows, benches)
+
+    if args.csv:
+        with open(args.csv, "w") as f:
+            f.write(",".join(["profile", "targets", "text", "data", "bss"] + benches) + "\n")
+            for r in rows:
+                vals = [r["profile"], r["targets"], r["text"], r["data"], r["bss"]] + \
+                       ["" if r["cycles"][b] is None else r["cycles"][b] for b in benches]
+                f.write(",".join(str(v) for v in vals) + "\n")
+        print(f"✓ Scoreboard written to {args.csv}")
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(rows, f, indent=2)
+            f.write("\n")
+        print(f"✓ Details written to {args.json}")
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,83 @@
+#!/bin/bash
+
+#===============================================================================
+# Olimex iCE40HX8K-EVB RISC-V Platform
+# run_bench.sh - Run CoreMark / Dhrystone Firmware in rvsim and Report Scores
+#
+# Copyright (c) October 2025 Michael Wolak
+# Email: mikewolak@gmail.com, mike@epromfoundry.com
+#
+# NOT FOR COMMERCIAL USE
+# Educational and research purposes only
+#===============================================================================
+#
+# Usage: ./run_bench.sh [benchmark...]   benchmarks: coremark dhrystone
+#                                         (default: both)
+#
+# Runs firmware/<benchmark>.elf in tools/rvsim until it prints "@@BENCH END",
+# keeps the full UART log in <benchmark>.bench.log and prints a summary of
+# the @@BENCH result lines (lib/bench/bench.h). Scores are per MHz, measured
+# in CPU cycles by the timer peripheral, so they do not depend on how fast
+# the simulator runs. Exits non-zero if a benchmark produced no result or
+# reported an invalid run.
+#
+# Environment: RVSIM (simulator binary), BENCH_MAX_CYCLES (run limit),
+#              BENCH_ARGS (extra rvsim options), BENCH_LOG_DIR
+#===============================================================================
+
+set -e
+
+ROOT="$(cd "$(dirname "$0")/../.." && pwd)"
+RVSIM=${RVSIM:-$ROOT/tools/rvsim/rvsim}
+MAX_CYCLES=${BENCH_MAX_CYCLES:-4000000000}
+LOG_DIR=${BENCH_LOG_DIR:-$ROOT/firmware}
+BENCHES=${*:-coremark dhrystone}
+
+if [ ! -x "$RVSIM" ]; then
+    echo "ERROR: $RVSIM not found - run 'make rvsim'"
+    exit 1
+fi
+
+status=0
+results=()
+
+for b in $BENCHES; do
+    elf="$ROOT/firmware/$b.elf"
+    log="$LOG_DIR/$b.bench.log"
+    if [ ! -f "$elf" ]; then
+        echo "ERROR: $elf not found - run 'make bench-$b'"
+        status=1
+        continue
+    fi
+
+    echo "========================================="
+    echo "Running $b in rvsim"
+    echo "========================================="
+    "$RVSIM" --no-stdin --uart-fast --exit-on "@@BENCH END" \
+        --max-cycles "$MAX_CYCLES" $BENCH_ARGS "$elf" 2>&1 | tee "$log"
+
+    line=$(tr -d '\r' < "$log" | grep "^@@BENCH name=" | tail -1)
+    if [ -z "$line" ]; then
+        echo "✗ $b: no @@BENCH result (see $log)"
+        status=1
+        continue
+    fi
+    results+=("$line")
+    case "$line" in
+        *valid=1*) ;;
+        *) echo "✗ $b: run reported INVALID"; status=1 ;;
+    esac
+done
+
+echo ""
+echo "========================================="
+echo "Benchmark Summary (per MHz, cycle counts from the timer)"
+echo "========================================="
+printf "  %-12s %-14s %-14s %s\n" "benchmark" "score" "unit" "cycles"
+for line in "${results[@]}"; do
+    field() { echo "$line" | sed -n "s/.* $1=\([^ ]*\).*/\1/p"; }
+    printf "  %-12s %-14s %-14s %s%s\n" "$(field name)" "$(field per_mhz)" "$(field unit)" \
+        "$(field cycles)" "$([ "$(field valid)" = 1 ] || echo '  (INVALID)')"
+done
+
+exit $status
@@ -0,0 +1,335 @@
+#!/usr/bin/env python3
+#===============================================================================
+# Olimex iCE40HX8K-EVB RISC-V Platform
+# rvprof.py - Profile Symbolizer, Hot Spot Report and Flamegraph Generator
+#
+# Copyright (c) October 2025 Michael Wolak
+# Email: mikewolak@gmail.com, mike@epromfoundry.com
+#
+# NOT FOR COMMERCIAL USE
+# Educational and research purposes only
+#===============================================================================
+#
+# Reads PC/call-stack samples from either source:
+#   - rvsim --profile FILE                 (tools/rvsim)
+#   - a UART capture of prof_dump() output (lib/profiler, on hardware)
+# and symbolizes them against the firmware ELF.
+#
+# Sample format (hex addresses, innermost first; return addresses are
+# looked up at ret-4, the call instruction):
+#   S <count> <pc> <ret0> <ret1> ...
+# UART captures wrap the samples in "@@PROF BEGIN ..." / "@@PROF END" and
+# may contain any other firmware output around them.
+#
+# Usage:
+#   rvprof.py firmware.elf samples.txt                 # per-function report
+#   rvprof.py firmware.elf samples.txt --lines         # + per-line hot spots
+#   rvprof.py firmware.elf samples.txt --folded out.folded --svg out.svg
+#===============================================================================
+
+import argparse
+import bisect
+import os
+import struct
+import subprocess
+import sys
+from collections import defaultdict
+
+#===============================================================================
+# ELF symbol table
+#===============================================================================
+
+SHT_SYMTAB = 2
+SHF_EXECINSTR = 0x4
+STT_NOTYPE = 0
+STT_FUNC = 2
+
+
+class Symbols:
+    """Address -> function name lookup from the ELF .symtab"""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            data = f.read()
+        if data[:4] != b'\x7fELF' or data[4] != 1 or data[5] != 1:
+            raise ValueError(f"{path}: not a little-endian ELF32 file")
+
+        (e_shoff,) = struct.unpack_from('<I', data, 0x20)
+        e_shentsize, e_shnum = struct.unpack_from('<HH', data, 0x2E)
+
+        sections = []
+        for i in range(e_shnum):
+            sections.append(struct.unpack_from('<IIIIIIIIII', data, e_shoff + i * e_shentsize))
+
+        syms = {}
+        for sh in sections:
+            if sh[1] != SHT_SYMTAB:
+                continue
+            strtab = sections[sh[6]]
+            str_off = strtab[4]
+            for off in range(sh[4], sh[4] + sh[5], 16):
+                st_name, st_value, st_size, st_info, _, st_shndx = \
+                    struct.unpack_from('<IIIBBH', data, off)
+                st_type = st_info & 0xF
+                if st_type not in (STT_FUNC, STT_NOTYPE) or st_shndx == 0 or st_shndx >= e_shnum:
+                    continue
+                if not sections[st_shndx][2] & SHF_EXECINSTR:
+                    continue
+                end = data.index(b'\0', str_off + st_name)
+                name = data[str_off + st_name:end].decode(errors='replace')
+                if not name or name.startswith('.L') or name.startswith('$'):
+                    continue
+                # Prefer FUNC symbols over assembler labels at the same address
+                prev = syms.get(st_value)
+                if prev is None or (st_type == STT_FUNC and prev[1] != STT_FUNC):
+                    syms[st_value] = (name, st_type, st_size)
+
+        self.addrs = sorted(syms)
+        self.names = [syms[a][0] for a in self.addrs]
+        self.sizes = [syms[a][2] for a in self.addrs]
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i < 0:
+            return f"0x{addr:08x}"
+        size = self.sizes[i]
+        if size and addr >= self.addrs[i] + size and \
+                (i + 1 >= len(self.addrs) or addr < self.addrs[i + 1]):
+            # Past the end of a sized symbol: padding or unnamed code
+            return f"{self.names[i]}+0x{addr - self.addrs[i]:x}"
+        return self.names[i]
+
+
+def detect_addr2line():
+    """RISC-V toolchain addr2line, falling back to the host one (multi-arch BFD)"""
+    for prefix in ('riscv64-unknown-elf-', 'riscv32-unknown-elf-', 'riscv-none-elf-', ''):
+        tool = prefix + 'addr2line'
+        for d in os.environ.get('PATH', '').split(os.pathsep):
+            if os.access(os.path.join(d, tool), os.X_OK):
+                return tool
+    return None
+
+
+def resolve_lines(elf, addrs):
+    """addr -> 'file:line' using addr2line; empty dict if unavailable"""
+    tool = detect_addr2line()
+    if not tool or not addrs:
+        return {}
+    addrs = sorted(addrs)
+    try:
+        out = subprocess.run([tool, '-e', elf], input=''.join(f"0x{a:x}\n" for a in addrs),
+                             capture_output=True, text=True, check=True).stdout.splitlines()
+    except (OSError, subprocess.CalledProcessError):
+        return {}
+    result = {}
+    for a, line in zip(addrs, out):
+        line = line.split(' (discriminator')[0]
+        if not line.startswith('??'):
+            path, _, num = line.rpartition(':')
+            result[a] = f"{os.path.basename(path)}:{num}"
+    return result
+
+#===============================================================================
+# Sample parsing
+#===============================================================================
+
+def read_samples(paths):
+    """Returns (list of (count, [pc, ret0, ...]), header info dict)"""
+    samples = []
+    info = {}
+    for path in paths:
+        with open(path, 'r', errors='replace') as f:
+            text = f.read()
+        framed = '@@PROF BEGIN' in text
+        inside = not framed
+        for raw in text.splitlines():
+            line = raw.strip()
+            if line.startswith('@@PROF BEGIN'):
+                inside = True
+                for kv in line.split()[2:]:
+                    k, _, v = kv.partition('=')
+                    info[k] = v
+                continue
+            if line.startswith('@@PROF END'):
+                inside = False
+                continue
+            if line.startswith('# rvprof'):
+                for kv in line.split()[3:]:
+                    k, _, v = kv.partition('=')
+                    info[k] = v
+                continue
+            if not inside or not line.startswith('S '):
+                continue
+            fields = line.split()
+            try:
+                count = int(fields[1])
+                frames = [int(x, 16) for x in fields[2:]]
+            except ValueError:
+                continue                    # Line garbled on the wire
+            if frames:
+                samples.append((count, frames))
+    return samples, info
+
+#===============================================================================
+# Reports
+#===============================================================================
+
+def symbolize_stack(sym, frames):
+    """Innermost-first list of function names (pc, then callers at ret-4)"""
+    names = [sym.lookup(frames[0])]
+    for ret in frames[1:]:
+        names.append(sym.lookup(ret - 4))
+    return names
+
+
+def report_functions(sym, samples, total, top):
+    self_cnt = defaultdict(int)
+    incl_cnt = defaultdict(int)
+    for count, frames in samples:
+        names = symbolize_stack(sym, frames)
+        self_cnt[names[0]] += count
+        for n in set(names):
+            incl_cnt[n] += count
+
+    print(f"{'Self':>8} {'Self%':>7} {'Total':>8} {'Total%':>7}  Function")
+    print(f"{'-' * 8} {'-' * 7} {'-' * 8} {'-' * 7}  {'-' * 40}")
+    ranked = sorted(incl_cnt, key=lambda n: (-self_cnt[n], -incl_cnt[n], n))
+    for name in ranked[:top]:
+        s, t = self_cnt[name], incl_cnt[name]
+        print(f"{s:8d} {100.0 * s / total:6.2f}% {t:8d} {100.0 * t / total:6.2f}%  {name}")
+
+
+def report_lines(sym, samples, total, top, elf):
+    pc_cnt = defaultdict(int)
+    for count, frames in samples:
+        pc_cnt[frames[0]] += count
+    lines = resolve_lines(elf, pc_cnt.keys())
+    if not lines:
+        print("(no line information: build with -g and make addr2line available)")
+        return
+
+    line_cnt = defaultdict(int)
+    line_func = {}
+    for pc, count in pc_cnt.items():
+        key = lines.get(pc, f"0x{pc:08x}")
+        line_cnt[key] += count
+        line_func.setdefault(key, sym.lookup(pc))
+
+    print(f"{'Samples':>8} {'%':>7}  {'Line':<32} Function")
+    print(f"{'-' * 8} {'-' * 7}  {'-' * 32} {'-' * 24}")
+    for key in sorted(line_cnt, key=lambda k: -line_cnt[k])[:top]:
+        c = line_cnt[key]
+        print(f"{c:8d} {100.0 * c / total:6.2f}%  {key:<32} {line_func[key]}")
+
+
+def folded_stacks(sym, samples):
+    folded = defaultdict(int)
+    for count, frames in samples:
+        names = symbolize_stack(sym, frames)
+        folded[';'.join(reversed(names))] += count
+    return folded
+
+
+def write_svg(folded, path, title):
+    """Minimal flame graph (same layout as flamegraph.pl, no JavaScript)"""
+    root = {'name': 'all', 'count': 0, 'children': {}}
+    for stack, count in folded.items():
+        node = root
+        node['count'] += count
+        for name in stack.split(';'):
+            node = node['children'].setdefault(name, {'name': name, 'count': 0, 'children': {}})
+            node['count'] += count
+
+    width, row, pad = 1200, 16, 10
+    total = root['count'] or 1
+    rects = []
+
+    def walk(node, x, depth):
+        rects.append((x, depth, node))
+        cx = x
+        for child in sorted(node['children'].values(), key=lambda n: n['name']):
+            walk(child, cx, depth + 1)
+            cx += child['count']
+
+    walk(root, 0, 0)
+    max_depth = max(d for _, d, _ in rects)
+    height = (max_depth + 1) * row + 3 * pad + row
+    scale = (width - 2 * pad) / total
+
+    def esc(s):
+        return s.replace('&', '&amp;').replace('<', '&lt;').replace('>', '&gt;').replace('"', '&quot;')
+
+    out = [f'<?xml version="1.0" standalone="no"?>',
+           f'<svg version="1.1" width="{width}" height="{height}" '
+           f'xmlns="http://www.w3.org/2000/svg" font-family="Verdana" font-size="11">',
+           f'<rect x="0" y="0" width="{width}" height="{height}" fill="#f8f8f8"/>',
+           f'<text x="{width / 2}" y="{pad + 11}" text-anchor="middle" font-size="14">{esc(title)}</text>']
+    for x, depth, node in rects:
+        w = node['count'] * scale
+        if w < 0.5:
+            continue
+        y = height - pad - (depth + 1) * row
+        h = sum(ord(ch) for ch in node['name'])
+        color = f"rgb({205 + h % 50},{80 + (h * 7) % 120},{40 + (h * 13) % 50})"
+        pct = 100.0 * node['count'] / total
+        label = node['name'] if w > 7 * len(node['name']) else node['name'][:max(int(w / 7) - 2, 0)] + '..'
+        out.append(f'<g><title>{esc(node["name"])} ({node["count"]} samples, {pct:.2f}%)</title>'
+                   f'<rect x="{pad + x * scale:.1f}" y="{y}" width="{w:.1f}" height="{row - 1}" '
+                   f'fill="{color}" rx="2"/>')
+        if w > 21:
+            out.append(f'<text x="{pad + x * scale + 3:.1f}" y="{y + 12}">{esc(label)}</text>')
+        out.append('</g>')
+    out.append('</svg>')
+    with open(path, 'w') as f:
+        f.write('\n'.join(out) + '\n')
+
+#===============================================================================
+# Main
+#===============================================================================
+
+def main():
+    ap = argparse.ArgumentParser(description="Symbolize rvsim/lib/profiler samples")
+    ap.add_argument('elf', help="firmware ELF the samples were taken from")
+    ap.add_argument('samples', nargs='+', help="rvsim --profile output or UART capture")
+    ap.add_argument('--top', type=int, default=25, help="rows per report (default 25)")
+    ap.add_argument('--lines', action='store_true', help="per-source-line hot spots")
+    ap.add_argument('--folded', metavar='FILE', help="write folded stacks (flamegraph.pl input)")
+    ap.add_argument('--svg', metavar='FILE', help="write a flame graph SVG")
+    args = ap.parse_args()
+
+    try:
+        sym = Symbols(args.elf)
+    except (OSError, ValueError) as e:
+        sys.exit(f"rvprof: {e}")
+    samples, info = read_samples(args.samples)
+    total = sum(c for c, _ in samples)
+    if not total:
+        sys.exit("rvprof: no samples found")
+
+    src = info.get('source', 'hw')
+    interval = info.get('interval', '?')
+    print(f"Profile of {os.path.basename(args.elf)}: {total} samples "
+          f"(source={src}, interval={interval} cycles)")
+    if info.get('dropped', '0') != '0':
+        print(f"WARNING: {info['dropped']} samples dropped on target (buffer full)")
+    print()
+    report_functions(sym, samples, total, args.top)
+
+    if args.lines:
+        print()
+        report_lines(sym, samples, total, args.top, args.elf)
+
+    if args.folded or args.svg:
+        folded = folded_stacks(sym, samples)
+        if args.folded:
+            with open(args.folded, 'w') as f:
+                for stack in sorted(folded):
+                    f.write(f"{stack} {folded[stack]}\n")
+            print(f"\n✓ Folded stacks: {args.folded}")
+        if args.svg:
+            write_svg(folded, args.svg, f"{os.path.basename(args.elf)} ({total} samples)")
+            print(f"✓ Flame graph:   {args.svg}")
+
+
+if __name__ == '__main__':
+    main()
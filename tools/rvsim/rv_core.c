@@ -0,0 +1,763 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rv_core.c - PicoRV32 Instruction-Set Model for rvsim
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "rv_core.h"
+
+#include <string.h>
+
+// PicoRV32 CPI, single-port register file (ENABLE_REGS_DUALPORT=0):
+// reg+reg ALU, branches and stores spend one extra cycle in ld_rs2.
+// MUL/DIV are the sequential picorv32_pcpi_mul/div units (32 steps).
+const rv_cpi_t rv_cpi_default = {
+    .alu_imm      = 3,
+    .alu_reg      = 4,
+    .jal          = 3,
+    .jalr         = 6,
+    .branch       = 4,
+    .branch_taken = 6,
+    .load         = 5,
+    .store        = 6,
+    .mul          = 40,
+    .div          = 40,
+    .irq_entry    = 2,
+    .custom       = 4,
+};
+
+static const char *halt_names[] = {
+    "running", "trap", "idle", "limit", "user",
+};
+
+const char *rv_halt_name(rv_halt_t h) {
+    return halt_names[h];
+}
+
+void rv_core_init(rv_core_t *c, rv_soc_t *soc, uint32_t reset_pc) {
+    memset(c, 0, sizeof(*c));
+    c->soc = soc;
+    c->pc = reset_pc;
+    c->x[2] = RV_STACKADDR;             // PicoRV32 STACKADDR parameter
+    c->irq_mask = 0xFFFFFFFFu;          // All IRQs masked out of reset
+    c->cpi = rv_cpi_default;
+    c->next_event = 0;
+}
+
+//==============================================================================
+// Memory path
+//==============================================================================
+
+static inline uint32_t extra(uint32_t wait) {
+    return wait ? wait - 1 : 0;         // CPI table already includes one cycle
+}
+
+static void sync_soc(rv_core_t *c) {
+    rv_soc_t *soc = c->soc;
+    soc_advance(soc, c->cycles);
+    c->irq_pending |= soc->irq_lines;   // LATCHED_IRQ: pulses stick until taken
+    soc->irq_lines = 0;
+
+    if (c->timer_deadline && c->cycles >= c->timer_deadline) {
+        c->irq_pending |= 1u << RV_IRQ_TIMER;
+        c->timer_deadline = 0;
+    }
+
+    c->next_event = soc_next_event(soc);
+    if (c->timer_deadline && c->timer_deadline < c->next_event)
+        c->next_event = c->timer_deadline;
+
+    rv_prof_t *prof = c->prof;
+    if (prof) {
+        if (c->cycles >= prof->next) {
+            uint64_t n = (c->cycles - prof->next) / prof->interval + 1;
+            rv_prof_sample(prof, c->pc, n);
+            prof->next += n * prof->interval;
+        }
+        if (prof->next < c->next_event)
+            c->next_event = prof->next;
+    }
+}
+
+static inline uint32_t mem_fetch(rv_core_t *c, uint32_t addr, uint32_t *wait) {
+    rv_soc_t *soc = c->soc;
+    addr &= ~3u;
+    if (__builtin_expect(soc_is_sram(addr), 1)) {
+        *wait = soc->timing.sram_read;
+        return soc_rd32(&soc->sram[addr]);
+    }
+    if (soc_is_boot(addr)) {
+        *wait = soc->timing.boot_read;
+        return soc_rd32(&soc->boot[addr - SOC_BOOT_BASE]);
+    }
+    if (soc_is_mmio(addr)) {
+        sync_soc(c);
+        *wait = soc->timing.mmio;
+        return soc_mmio_read(soc, addr);
+    }
+    *wait = soc->timing.unmapped;
+    return 0;
+}
+
+static uint32_t mem_load(rv_core_t *c, uint32_t addr, uint32_t *wait) {
+    return mem_fetch(c, addr, wait);
+}
+
+// wdata/wstrb already lane-aligned as PicoRV32 drives mem_wdata/mem_wstrb
+static void mem_store(rv_core_t *c, uint32_t addr, uint32_t wdata, uint32_t wstrb, uint32_t *wait) {
+    rv_soc_t *soc = c->soc;
+    addr &= ~3u;
+
+    // Writes are never decoded to the boot ROM
+    if (soc_is_sram(addr)) {
+        uint8_t *p = &soc->sram[addr];
+        if (wstrb == 0xF) {
+            soc_wr32(p, wdata);
+            *wait = soc->timing.sram_write;
+        } else {
+            for (int b = 0; b < 4; b++)
+                if (wstrb & (1u << b)) p[b] = (uint8_t)(wdata >> (8 * b));
+            *wait = soc->timing.sram_rmw;
+        }
+        return;
+    }
+    if (soc_is_mmio(addr)) {
+        uint64_t stall;
+        sync_soc(c);
+        soc_mmio_write(soc, addr, wdata, wstrb, &stall);
+        *wait = soc->timing.mmio + (uint32_t)stall;
+        c->next_event = 0;              // Timer may have been reprogrammed
+        return;
+    }
+    *wait = soc->timing.unmapped;
+}
+
+//==============================================================================
+// RV32C expansion (only used when c->rvc is set)
+//==============================================================================
+
+#define RVC_REG(r) (8 + ((r) & 7))
+
+static uint32_t enc_i(uint32_t imm, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op) {
+    return ((imm & 0xFFF) << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op;
+}
+
+static uint32_t enc_r(uint32_t f7, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op) {
+    return (f7 << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op;
+}
+
+static uint32_t enc_s(uint32_t imm, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t op) {
+    return (((imm >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | ((imm & 0x1F) << 7) | op;
+}
+
+static uint32_t enc_b(uint32_t imm, uint32_t rs2, uint32_t rs1, uint32_t f3) {
+    return (((imm >> 12) & 1) << 31) | (((imm >> 5) & 0x3F) << 25) | (rs2 << 20) | (rs1 << 15) |
+           (f3 << 12) | (((imm >> 1) & 0xF) << 8) | (((imm >> 11) & 1) << 7) | 0x63;
+}
+
+static uint32_t enc_j(uint32_t imm, uint32_t rd) {
+    return (((imm >> 20) & 1) << 31) | (((imm >> 1) & 0x3FF) << 21) | (((imm >> 11) & 1) << 20) |
+           (((imm >> 12) & 0xFF) << 12) | (rd << 7) | 0x6F;
+}
+
+static inline uint32_t bit(uint32_t v, int b) { return (v >> b) & 1; }
+
+static inline int32_t sext(uint32_t v, int bits) {
+    return (int32_t)(v << (32 - bits)) >> (32 - bits);
+}
+
+// Returns the equivalent 32-bit instruction, 0 if illegal
+static uint32_t rvc_expand(uint32_t h) {
+    uint32_t op = h & 3, f3 = (h >> 13) & 7;
+    uint32_t rd = (h >> 7) & 31, rs2 = (h >> 2) & 31;
+    uint32_t rdp = RVC_REG(h >> 2), rs1p = RVC_REG(h >> 7);
+    uint32_t imm;
+
+    if (h == 0) return 0;
+
+    switch (op) {
+    case 0:
+        switch (f3) {
+        case 0: // c.addi4spn
+            imm = (bit(h, 6) << 2) | (bit(h, 5) << 3) | (((h >> 11) & 3) << 4) | (((h >> 7) & 15) << 6);
+            return imm ? enc_i(imm, 2, 0, rdp, 0x13) : 0;
+        case 2: // c.lw
+            imm = (bit(h, 6) << 2) | (((h >> 10) & 7) << 3) | (bit(h, 5) << 6);
+            return enc_i(imm, rs1p, 2, rdp, 0x03);
+        case 6: // c.sw
+            imm = (bit(h, 6) << 2) | (((h >> 10) & 7) << 3) | (bit(h, 5) << 6);
+            return enc_s(imm, rdp, rs1p, 2, 0x23);
+        }
+        return 0;
+
+    case 1:
+        imm = (uint32_t)sext((bit(h, 12) << 5) | ((h >> 2) & 31), 6);
+        switch (f3) {
+        case 0: // c.addi / c.nop
+            return enc_i(imm, rd, 0, rd, 0x13);
+        case 1: // c.jal
+        case 5: // c.j
+        {
+            uint32_t j = (bit(h, 12) << 11) | (bit(h, 11) << 4) | (((h >> 9) & 3) << 8) |
+                         (bit(h, 8) << 10) | (bit(h, 7) << 6) | (bit(h, 6) << 7) |
+                         (((h >> 3) & 7) << 1) | (bit(h, 2) << 5);
+            return enc_j((uint32_t)sext(j, 12), f3 == 1 ? 1 : 0);
+        }
+        case 2: // c.li
+            return enc_i(imm, 0, 0, rd, 0x13);
+        case 3:
+            if (rd == 2) { // c.addi16sp
+                uint32_t i16 = (bit(h, 12) << 9) | (bit(h, 6) << 4) | (bit(h, 5) << 6) |
+                               (((h >> 3) & 3) << 7) | (bit(h, 2) << 5);
+                i16 = (uint32_t)sext(i16, 10);
+                return i16 ? enc_i(i16, 2, 0, 2, 0x13) : 0;
+            }
+            // c.lui
+            return imm ? ((imm << 12) & 0xFFFFF000u) | (rd << 7) | 0x37 : 0;
+        case 4: {
+            uint32_t sub = (h >> 10) & 3;
+            uint32_t shamt = (bit(h, 12) << 5) | ((h >> 2) & 31);
+            if (sub == 0) return bit(h, 12) ? 0 : enc_i(shamt, rs1p, 5, rs1p, 0x13);             // c.srli
+            if (sub == 1) return bit(h, 12) ? 0 : enc_i(0x400 | shamt, rs1p, 5, rs1p, 0x13);     // c.srai
+            if (sub == 2) return enc_i(imm, rs1p, 7, rs1p, 0x13);                                // c.andi
+            if (bit(h, 12)) return 0;
+            switch ((h >> 5) & 3) {
+            case 0: return enc_r(0x20, rdp, rs1p, 0, rs1p, 0x33);  // c.sub
+            case 1: return enc_r(0, rdp, rs1p, 4, rs1p, 0x33);     // c.xor
+            case 2: return enc_r(0, rdp, rs1p, 6, rs1p, 0x33);     // c.or
+            default: return enc_r(0, rdp, rs1p, 7, rs1p, 0x33);    // c.and
+            }
+        }
+        case 6: // c.beqz
+        case 7: // c.bnez
+        {
+            uint32_t b = (bit(h, 12) << 8) | (((h >> 10) & 3) << 3) | (((h >> 5) & 3) << 6) |
+                         (((h >> 3) & 3) << 1) | (bit(h, 2) << 5);
+            return enc_b((uint32_t)sext(b, 9), 0, rs1p, f3 == 6 ? 0 : 1);
+        }
+        }
+        return 0;
+
+    case 2:
+        switch (f3) {
+        case 0: // c.slli
+            return bit(h, 12) ? 0 : enc_i(rs2, rd, 1, rd, 0x13);
+        case 2: // c.lwsp
+            imm = (bit(h, 12) << 5) | (((h >> 4) & 7) << 2) | (((h >> 2) & 3) << 6);
+            return rd ? enc_i(imm, 2, 2, rd, 0x03) : 0;
+        case 4:
+            if (!bit(h, 12)) {
+                if (rs2 == 0) return rd ? enc_i(0, rd, 0, 0, 0x67) : 0;    // c.jr
+                return enc_r(0, rs2, 0, 0, rd, 0x33);                      // c.mv
+            }
+            if (rs2 == 0) {
+                if (rd == 0) return 0x00100073;                            // c.ebreak
+                return enc_i(0, rd, 0, 1, 0x67);                           // c.jalr
+            }
+            return enc_r(0, rs2, rd, 0, rd, 0x33);                         // c.add
+        case 6: // c.swsp
+            imm = (((h >> 9) & 15) << 2) | (((h >> 7) & 3) << 6);
+            return enc_s(imm, rs2, 2, 2, 0x23);
+        }
+        return 0;
+    }
+    return 0;
+}
+
+//==============================================================================
+// Helpers
+//==============================================================================
+
+static void take_irq(rv_core_t *c, uint32_t irqs) {
+    c->q[0] = c->pc;
+    c->q[1] = irqs;
+    c->irq_pending &= ~irqs;
+    c->irq_active = true;
+    if (c->prof) rv_prof_irq_enter(c->prof, c->pc);
+    c->pc = RV_PROGADDR_IRQ;
+    c->cycles += c->cpi.irq_entry;
+    c->irqs_taken++;
+}
+
+// Skip forward to the next peripheral event. Returns false if nothing can
+// ever wake the core (the caller halts).
+static bool idle_until_event(rv_core_t *c, bool need_unmasked) {
+    sync_soc(c);
+    if (need_unmasked && c->irq_active) return false;      // No nesting
+    if (c->irq_pending & (need_unmasked ? ~c->irq_mask : ~0u)) return true;
+    if (c->next_event == UINT64_MAX) return false;
+    if (need_unmasked && (c->irq_mask & (1u << RV_IRQ_TIMER))) return false;
+    if (c->next_event > c->cycles) {
+        c->cyc_idle += c->next_event - c->cycles;
+        c->cycles = c->next_event;
+    }
+    sync_soc(c);
+    return true;
+}
+
+// Fill c->retire the way PicoRV32 would report the instruction on its
+// trace port. a/b are the source operands as read before write-back.
+static void retire(rv_core_t *c, uint32_t pc, uint32_t insn, uint32_t next,
+                   uint32_t v, uint32_t a, uint32_t b, uint32_t rd) {
+    rv_retire_t *r = c->retire;
+    uint32_t op = insn & 0x7F;
+    uint32_t f7 = insn >> 25;
+
+    r->pc = pc;
+    r->insn = insn;
+    r->next_pc = next;
+    r->value = v;
+    r->addr = 0;
+    r->rd = (uint8_t)rd;
+    r->kind = RV_RET_VALUE;
+    r->mem = false;
+    r->store = false;
+    r->external = false;
+
+    switch (op) {
+    case 0x6F: // jal
+    case 0x67: // jalr
+        r->kind = RV_RET_BRANCH;
+        r->value = next;
+        break;
+    case 0x63: { // taken: target, untaken: reg_out = pc + imm from cpu_state_exec
+        uint32_t imm = (bit(insn, 31) << 12) | (bit(insn, 7) << 11) |
+                       (((insn >> 25) & 0x3F) << 5) | (((insn >> 8) & 15) << 1);
+        bool t;
+        switch ((insn >> 12) & 7) {
+        case 0: t = a == b; break;
+        case 1: t = a != b; break;
+        case 4: t = (int32_t)a < (int32_t)b; break;
+        case 5: t = (int32_t)a >= (int32_t)b; break;
+        case 6: t = a < b; break;
+        default: t = a >= b; break;
+        }
+        r->value = pc + (uint32_t)sext(imm, 13);
+        if (t) r->kind = RV_RET_BRANCH;
+        break;
+    }
+    case 0x03:
+        r->mem = true;
+        r->addr = a + (uint32_t)sext(insn >> 20, 12);
+        r->external = soc_is_mmio(r->addr);
+        break;
+    case 0x23:
+        r->mem = true;
+        r->store = true;
+        r->addr = a + (uint32_t)sext(((insn >> 25) << 5) | ((insn >> 7) & 31), 12);
+        r->value = b;               // reg_op2, before lane replication
+        break;
+    case 0x0B:
+        switch (f7) {
+        case 0x00: r->external = ((insn >> 15) & 3) == 1; break;   // getq q1
+        case 0x01: r->value = a; break;                             // setq
+        case 0x02: r->kind = RV_RET_BRANCH; r->value = next; break; // retirq
+        case 0x04:                                                  // waitirq
+        case 0x05: r->external = true; break;                       // timer
+        default: break;
+        }
+        break;
+    case 0x0F:
+    case 0x73:
+        r->kind = RV_RET_UNTRACED;
+        break;
+    default:
+        break;
+    }
+}
+
+static void halt(rv_core_t *c, rv_halt_t why, uint32_t insn) {
+    c->halt = why;
+    c->halt_pc = c->pc;
+    c->halt_insn = insn;
+}
+
+//==============================================================================
+// Decode
+//==============================================================================
+
+// One case per operation in step(), so the dispatch is a single switch
+enum {
+    RV_OP_ILLEGAL = 0,
+    RV_OP_LUI, RV_OP_AUIPC, RV_OP_JAL, RV_OP_JALR,
+    RV_OP_BEQ, RV_OP_BNE, RV_OP_BLT, RV_OP_BGE, RV_OP_BLTU, RV_OP_BGEU,
+    RV_OP_LB, RV_OP_LH, RV_OP_LW, RV_OP_LBU, RV_OP_LHU,
+    RV_OP_SB, RV_OP_SH, RV_OP_SW,
+    RV_OP_ADDI, RV_OP_SLLI, RV_OP_SLTI, RV_OP_SLTIU, RV_OP_XORI, RV_OP_SRLI,
+    RV_OP_SRAI, RV_OP_ORI, RV_OP_ANDI,
+    RV_OP_ADD, RV_OP_SUB, RV_OP_SLL, RV_OP_SLT, RV_OP_SLTU, RV_OP_XOR,
+    RV_OP_SRL, RV_OP_SRA, RV_OP_OR, RV_OP_AND,
+    RV_OP_MUL, RV_OP_MULH, RV_OP_MULHSU, RV_OP_MULHU,
+    RV_OP_DIV, RV_OP_DIVU, RV_OP_REM, RV_OP_REMU,
+    RV_OP_FENCE, RV_OP_SYSTEM, RV_OP_CUSTOM,
+};
+
+static void decode(rv_dec_t *d, uint32_t insn) {
+    uint32_t f3 = (insn >> 12) & 7;
+    uint32_t f7 = insn >> 25;
+
+    d->insn = insn;
+    d->rd = (insn >> 7) & 31;
+    d->rs1 = (insn >> 15) & 31;
+    d->rs2 = (insn >> 20) & 31;
+    d->imm = 0;
+    d->op = RV_OP_ILLEGAL;
+
+    switch (insn & 0x7F) {
+    case 0x37: d->op = RV_OP_LUI; d->imm = insn & 0xFFFFF000u; break;
+    case 0x17: d->op = RV_OP_AUIPC; d->imm = insn & 0xFFFFF000u; break;
+
+    case 0x6F:
+        d->op = RV_OP_JAL;
+        d->imm = (uint32_t)sext((bit(insn, 31) << 20) | (((insn >> 21) & 0x3FF) << 1) |
+                                (bit(insn, 20) << 11) | (((insn >> 12) & 0xFF) << 12), 21);
+        break;
+
+    case 0x67:
+        d->op = RV_OP_JALR;
+        d->imm = (uint32_t)sext(insn >> 20, 12);
+        break;
+
+    case 0x63: {
+        static const uint8_t ops[8] = {
+            RV_OP_BEQ, RV_OP_BNE, RV_OP_ILLEGAL, RV_OP_ILLEGAL,
+            RV_OP_BLT, RV_OP_BGE, RV_OP_BLTU, RV_OP_BGEU,
+        };
+        d->op = ops[f3];
+        d->imm = (uint32_t)sext((bit(insn, 31) << 12) | (bit(insn, 7) << 11) |
+                                (((insn >> 25) & 0x3F) << 5) | (((insn >> 8) & 15) << 1), 13);
+        break;
+    }
+
+    case 0x03: {
+        static const uint8_t ops[8] = {
+            RV_OP_LB, RV_OP_LH, RV_OP_LW, RV_OP_ILLEGAL,
+            RV_OP_LBU, RV_OP_LHU, RV_OP_ILLEGAL, RV_OP_ILLEGAL,
+        };
+        d->op = ops[f3];
+        d->imm = (uint32_t)sext(insn >> 20, 12);
+        break;
+    }
+
+    case 0x23: {
+        static const uint8_t ops[8] = {
+            RV_OP_SB, RV_OP_SH, RV_OP_SW, RV_OP_ILLEGAL,
+            RV_OP_ILLEGAL, RV_OP_ILLEGAL, RV_OP_ILLEGAL, RV_OP_ILLEGAL,
+        };
+        d->op = ops[f3];
+        d->imm = (uint32_t)sext(((insn >> 25) << 5) | ((insn >> 7) & 31), 12);
+        break;
+    }
+
+    case 0x13: {
+        static const uint8_t ops[8] = {
+            RV_OP_ADDI, RV_OP_SLLI, RV_OP_SLTI, RV_OP_SLTIU,
+            RV_OP_XORI, RV_OP_SRLI, RV_OP_ORI, RV_OP_ANDI,
+        };
+        d->op = ops[f3];
+        if (f3 == 1 || f3 == 5) {
+            d->imm = d->rs2;                        // shamt
+            if (f3 == 5 && (f7 & 0x20)) d->op = RV_OP_SRAI;
+        } else {
+            d->imm = (uint32_t)sext(insn >> 20, 12);
+        }
+        break;
+    }
+
+    case 0x33:
+        if (f7 == 0x01) {
+            static const uint8_t ops[8] = {
+                RV_OP_MUL, RV_OP_MULH, RV_OP_MULHSU, RV_OP_MULHU,
+                RV_OP_DIV, RV_OP_DIVU, RV_OP_REM, RV_OP_REMU,
+            };
+            d->op = ops[f3];
+        } else {
+            static const uint8_t ops[8] = {
+                RV_OP_ADD, RV_OP_SLL, RV_OP_SLT, RV_OP_SLTU,
+                RV_OP_XOR, RV_OP_SRL, RV_OP_OR, RV_OP_AND,
+            };
+            d->op = ops[f3];
+            if (f7 & 0x20) {
+                if (f3 == 0) d->op = RV_OP_SUB;
+                if (f3 == 5) d->op = RV_OP_SRA;
+            }
+        }
+        break;
+
+    case 0x0F: d->op = RV_OP_FENCE; break;
+    case 0x73: d->op = RV_OP_SYSTEM; break;
+    case 0x0B: d->op = RV_OP_CUSTOM; d->imm = f7; break;
+    default: break;
+    }
+}
+
+//==============================================================================
+// Execute
+//==============================================================================
+
+static inline __attribute__((always_inline)) rv_halt_t step(rv_core_t *c) {
+    uint32_t *x = c->x;
+    uint32_t pc = c->pc;
+    uint32_t insn, fwait, dwait = 0, cost, len = 4;
+    bool delay_next = c->irq_active;
+
+    if (c->cycles >= c->next_event) sync_soc(c);
+
+    // IRQ check at instruction launch (picorv32 cpu_state_fetch)
+    if (!c->lockstep) {
+        uint32_t irqs = c->irq_pending & ~c->irq_mask;
+        if (irqs && !c->irq_active && !c->irq_delay) {
+            take_irq(c, irqs);
+            pc = c->pc;
+            delay_next = true;
+        }
+    }
+
+    insn = mem_fetch(c, pc, &fwait);
+    if (c->rvc) {
+        if (pc & 2) insn >>= 16;
+        if ((insn & 3) != 3) {
+            insn = rvc_expand(insn & 0xFFFF);
+            len = 2;
+        } else if (pc & 2) {
+            uint32_t w2;
+            insn |= mem_fetch(c, pc + 2, &w2) << 16;
+            fwait += w2;
+        }
+    }
+
+    // Decode once per address while the word there stays the same
+    rv_dec_t *d = &c->dec[(pc >> 2) & (RV_DEC_ENTRIES - 1)];
+    if (__builtin_expect(d->insn != insn, 0)) decode(d, insn);
+
+    uint32_t rd = d->rd;
+    uint32_t rs1 = d->rs1;
+    uint32_t imm = d->imm;
+    uint32_t a = x[rs1], b = x[d->rs2];
+    uint32_t next = pc + len;
+    uint32_t v = 0;
+    bool wr = true;
+
+    switch (d->op) {
+    case RV_OP_LUI:   v = imm;      cost = c->cpi.alu_imm; break;
+    case RV_OP_AUIPC: v = pc + imm; cost = c->cpi.alu_imm; break;
+
+    case RV_OP_JAL:
+        v = next;
+        next = pc + imm;
+        cost = c->cpi.jal;
+        if (__builtin_expect(c->prof != NULL, 0) && (rd == 1 || rd == 5))
+            rv_prof_call(c->prof, v);
+        if (next == pc && rd == 0 && !c->lockstep) {
+            // j . : nothing more can happen until an IRQ arrives
+            if (!idle_until_event(c, true)) { halt(c, RV_HALT_IDLE, insn); return c->halt; }
+        }
+        break;
+
+    case RV_OP_JALR:
+        v = next;
+        next = (a + imm) & ~1u;
+        cost = c->cpi.jalr;
+        if (__builtin_expect(c->prof != NULL, 0)) {
+            if (rd == 1 || rd == 5) rv_prof_call(c->prof, v);
+            else if (rd == 0 && (rs1 == 1 || rs1 == 5)) rv_prof_ret(c->prof, next);
+        }
+        break;
+
+#define BRANCH(cond)                                                \
+        wr = false;                                                 \
+        if (cond) {                                                 \
+            next = pc + imm;                                        \
+            cost = c->cpi.branch_taken;                             \
+        } else {                                                    \
+            cost = c->cpi.branch;                                   \
+        }                                                           \
+        break;
+    case RV_OP_BEQ:  BRANCH(a == b)
+    case RV_OP_BNE:  BRANCH(a != b)
+    case RV_OP_BLT:  BRANCH((int32_t)a < (int32_t)b)
+    case RV_OP_BGE:  BRANCH((int32_t)a >= (int32_t)b)
+    case RV_OP_BLTU: BRANCH(a < b)
+    case RV_OP_BGEU: BRANCH(a >= b)
+#undef BRANCH
+
+#define LOAD(value) {                                               \
+        uint32_t addr = a + imm;                                    \
+        uint32_t w = mem_load(c, addr, &dwait);                     \
+        v = (value);                                                \
+        cost = c->cpi.load;                                         \
+        break;                                                      \
+    }
+    case RV_OP_LB:  LOAD((uint32_t)(int32_t)(int8_t)(w >> (8 * (addr & 3))))
+    case RV_OP_LH:  LOAD((uint32_t)(int32_t)(int16_t)(w >> (8 * (addr & 2))))
+    case RV_OP_LW:  LOAD(w)
+    case RV_OP_LBU: LOAD((uint8_t)(w >> (8 * (addr & 3))))
+    case RV_OP_LHU: LOAD((uint16_t)(w >> (8 * (addr & 2))))
+#undef LOAD
+
+#define STORE(wdata, wstrb) {                                       \
+        uint32_t addr = a + imm;                                    \
+        mem_store(c, addr, (wdata), (wstrb), &dwait);               \
+        wr = false;                                                 \
+        cost = c->cpi.store;                                        \
+        break;                                                      \
+    }
+    case RV_OP_SB: STORE((b & 0xFF) * 0x01010101u, 1u << (addr & 3))
+    case RV_OP_SH: STORE((b & 0xFFFF) * 0x00010001u, 3u << (addr & 2))
+    case RV_OP_SW: STORE(b, 0xF)
+#undef STORE
+
+    case RV_OP_ADDI:  v = a + imm;                          cost = c->cpi.alu_imm; break;
+    case RV_OP_SLLI:  v = a << imm;                         cost = c->cpi.alu_imm; break;
+    case RV_OP_SLTI:  v = (int32_t)a < (int32_t)imm;        cost = c->cpi.alu_imm; break;
+    case RV_OP_SLTIU: v = a < imm;                          cost = c->cpi.alu_imm; break;
+    case RV_OP_XORI:  v = a ^ imm;                          cost = c->cpi.alu_imm; break;
+    case RV_OP_SRLI:  v = a >> imm;                         cost = c->cpi.alu_imm; break;
+    case RV_OP_SRAI:  v = (uint32_t)((int32_t)a >> imm);    cost = c->cpi.alu_imm; break;
+    case RV_OP_ORI:   v = a | imm;                          cost = c->cpi.alu_imm; break;
+    case RV_OP_ANDI:  v = a & imm;                          cost = c->cpi.alu_imm; break;
+
+    case RV_OP_ADD:  v = a + b;                                 cost = c->cpi.alu_reg; break;
+    case RV_OP_SUB:  v = a - b;                                 cost = c->cpi.alu_reg; break;
+    case RV_OP_SLL:  v = a << (b & 31);                         cost = c->cpi.alu_reg; break;
+    case RV_OP_SLT:  v = (int32_t)a < (int32_t)b;               cost = c->cpi.alu_reg; break;
+    case RV_OP_SLTU: v = a < b;                                 cost = c->cpi.alu_reg; break;
+    case RV_OP_XOR:  v = a ^ b;                                 cost = c->cpi.alu_reg; break;
+    case RV_OP_SRL:  v = a >> (b & 31);                         cost = c->cpi.alu_reg; break;
+    case RV_OP_SRA:  v = (uint32_t)((int32_t)a >> (b & 31));    cost = c->cpi.alu_reg; break;
+    case RV_OP_OR:   v = a | b;                                 cost = c->cpi.alu_reg; break;
+    case RV_OP_AND:  v = a & b;                                 cost = c->cpi.alu_reg; break;
+
+    case RV_OP_MUL:    v = a * b; cost = c->cpi.mul; break;
+    case RV_OP_MULH:   v = (uint32_t)(((int64_t)(int32_t)a * (int64_t)(int32_t)b) >> 32); cost = c->cpi.mul; break;
+    case RV_OP_MULHSU: v = (uint32_t)(((int64_t)(int32_t)a * (int64_t)(uint64_t)b) >> 32); cost = c->cpi.mul; break;
+    case RV_OP_MULHU:  v = (uint32_t)(((uint64_t)a * (uint64_t)b) >> 32); cost = c->cpi.mul; break;
+    case RV_OP_DIV:
+        if (b == 0) v = 0xFFFFFFFFu;
+        else if (a == 0x80000000u && b == 0xFFFFFFFFu) v = a;
+        else v = (uint32_t)((int32_t)a / (int32_t)b);
+        cost = c->cpi.div;
+        break;
+    case RV_OP_DIVU: v = b ? a / b : 0xFFFFFFFFu; cost = c->cpi.div; break;
+    case RV_OP_REM:
+        if (b == 0) v = a;
+        else if (a == 0x80000000u && b == 0xFFFFFFFFu) v = 0;
+        else v = (uint32_t)((int32_t)a % (int32_t)b);
+        cost = c->cpi.div;
+        break;
+    case RV_OP_REMU: v = b ? a % b : a; cost = c->cpi.div; break;
+
+    case RV_OP_FENCE: // fence / fence.i: no-ops on PicoRV32
+        wr = false;
+        cost = c->cpi.alu_imm;
+        break;
+
+    case RV_OP_SYSTEM:
+        wr = false;
+        cost = c->cpi.alu_imm;
+        if (insn == 0x00000073u || insn == 0x00100073u) {
+            // ecall/ebreak raise IRQ 1 if unmasked, otherwise the core traps
+            if (!(c->irq_mask & (1u << RV_IRQ_EBREAK)) && !c->irq_active) {
+                c->irq_pending |= 1u << RV_IRQ_EBREAK;
+            } else {
+                halt(c, RV_HALT_TRAP, insn);
+                return c->halt;
+            }
+        } else if (insn == 0x10500073u) {
+            // wfi is not decoded by PicoRV32 (behaves as a no-op); use it
+            // as an idle hint so _exit() loops do not spin forever.
+            if (!c->lockstep && !idle_until_event(c, true)) { halt(c, RV_HALT_IDLE, insn); return c->halt; }
+        } else {
+            // No CSRs (ENABLE_COUNTERS=0): rdcycle etc. are not implemented
+            halt(c, RV_HALT_TRAP, insn);
+            return c->halt;
+        }
+        break;
+
+    case RV_OP_CUSTOM: // PicoRV32 custom-0 IRQ instructions (imm = funct7)
+        cost = c->cpi.custom;
+        switch (imm) {
+        case 0x00: // getq rd, qs
+            v = c->q[rs1 & 3];
+            break;
+        case 0x01: // setq qd, rs
+            c->q[rd & 3] = a;
+            wr = false;
+            break;
+        case 0x02: // retirq
+            next = c->q[0] & ~1u;
+            c->irq_active = false;
+            if (c->prof) rv_prof_irq_exit(c->prof);
+            wr = false;
+            cost = c->cpi.jalr;
+            break;
+        case 0x03: // maskirq rd, rs
+            v = c->irq_mask;
+            c->irq_mask = a;                // | MASKED_IRQ (0)
+            break;
+        case 0x04: // waitirq rd
+            sync_soc(c);
+            if (!c->irq_pending && !c->lockstep) {
+                if (!idle_until_event(c, false)) { halt(c, RV_HALT_IDLE, insn); return c->halt; }
+                if (!c->irq_pending) { next = pc; wr = false; }
+            }
+            v = c->irq_pending;
+            break;
+        case 0x05: // timer rd, rs
+            v = (c->timer_deadline > c->cycles) ? (uint32_t)(c->timer_deadline - c->cycles) : 0;
+            c->timer_deadline = a ? c->cycles + a : 0;
+            c->next_event = 0;
+            break;
+        default:
+            halt(c, RV_HALT_TRAP, insn);
+            return c->halt;
+        }
+        break;
+
+    default: // RV_OP_ILLEGAL
+        halt(c, RV_HALT_TRAP, insn);
+        return c->halt;
+    }
+
+    if (__builtin_expect(c->retire != NULL, 0)) retire(c, pc, insn, next, v, a, b, wr ? rd : 0);
+
+    if (wr && rd) x[rd] = v;
+    c->pc = next;
+    c->irq_delay = delay_next;
+
+    fwait = extra(fwait);
+    dwait = extra(dwait);
+    c->cycles += cost + fwait + dwait;
+    c->cyc_fetch_wait += fwait;
+    c->cyc_data_wait += dwait;
+    c->instret++;
+    return RV_RUNNING;
+}
+
+void rv_core_enter_irq(rv_core_t *c, uint32_t irqs) {
+    take_irq(c, irqs);
+}
+
+rv_halt_t rv_core_step(rv_core_t *c) {
+    return step(c);
+}
+
+rv_halt_t rv_core_run(rv_core_t *c, uint64_t max_cycles, uint64_t max_insns) {
+    uint64_t insn_end = max_insns ? c->instret + max_insns : UINT64_MAX;
+    uint64_t cyc_end = max_cycles ? max_cycles : UINT64_MAX;
+
+    while (c->halt == RV_RUNNING) {
+        if (c->instret >= insn_end || c->cycles >= cyc_end) {
+            c->halt = RV_HALT_LIMIT;
+            c->halt_pc = c->pc;
+            break;
+        }
+        step(c);
+    }
+    return c->halt;
+}
@@ -0,0 +1,163 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rv_core.h - PicoRV32 Instruction-Set Model for rvsim
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// RV32IM (+C optional) interpreter with the PicoRV32 IRQ extension as
+// configured in ice40_picorv32_top.v:
+//   ENABLE_IRQ=1, ENABLE_IRQ_QREGS=1, ENABLE_IRQ_TIMER=1, MASKED_IRQ=0,
+//   LATCHED_IRQ=all, PROGADDR_IRQ=0x10, STACKADDR=0x80000,
+//   ENABLE_REGS_DUALPORT=0, BARREL_SHIFTER=1, ENABLE_FAST_MUL=0
+//
+// Cycle estimate = PicoRV32 CPI for the class of instruction (single-port
+// register file column of the PicoRV32 CPI table) plus the wait states of
+// every memory transaction beyond the one cycle that table assumes.
+//
+// Decoded instructions are cached per fetch address and reused while the
+// fetched word is unchanged, so code written at run time (uploads,
+// self-modifying code) is decoded again without any invalidation.
+//
+//==============================================================================
+
+#ifndef RV_CORE_H
+#define RV_CORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "rv_soc.h"
+#include "rv_prof.h"
+
+#define RV_PROGADDR_RESET_HW   0x00080000u     // Bootloader ROM
+#define RV_PROGADDR_RESET_SIM  0x00000000u     // SIMULATION build: firmware in SRAM
+#define RV_PROGADDR_IRQ        0x00000010u
+#define RV_STACKADDR           0x00080000u
+
+// PicoRV32 IRQ numbers
+#define RV_IRQ_TIMER     0      // Internal timer and timer_peripheral share irq[0]
+#define RV_IRQ_EBREAK    1      // ecall/ebreak/illegal instruction
+#define RV_IRQ_BUSERROR  2
+
+typedef struct {
+    uint32_t alu_imm;
+    uint32_t alu_reg;
+    uint32_t jal;
+    uint32_t jalr;
+    uint32_t branch;            // not taken
+    uint32_t branch_taken;
+    uint32_t load;
+    uint32_t store;
+    uint32_t mul;
+    uint32_t div;
+    uint32_t irq_entry;         // irq_state 1 and 2 before fetching 0x10
+    uint32_t custom;            // getq/setq/maskirq/timer/retirq base
+} rv_cpi_t;
+
+extern const rv_cpi_t rv_cpi_default;
+
+typedef enum {
+    RV_RUNNING = 0,
+    RV_HALT_TRAP,               // ebreak/ecall/illegal with IRQ 1 masked or nested
+    RV_HALT_IDLE,               // j . / wfi loop with nothing left to wake it
+    RV_HALT_LIMIT,              // cycle/instruction limit reached
+    RV_HALT_USER,               // stopped by the host (exit string, signal)
+} rv_halt_t;
+
+// Retired-instruction record for lockstep checking against the RTL
+// (sim/verilator cosim). value/kind follow what PicoRV32 puts on its trace
+// port: the target for taken jumps/branches/retirq, otherwise reg_out or
+// alu_out_q - the result even when rd is x0, the store data (rs2) for stores
+// and the untaken target for branches that fall through.
+typedef enum {
+    RV_RET_VALUE = 0,           // Trace value word
+    RV_RET_BRANCH,              // Trace BRANCH word (value = target)
+    RV_RET_UNTRACED,            // ecall/ebreak/fence/wfi: never retired by the RTL
+} rv_ret_kind_t;
+
+typedef struct {
+    uint32_t pc;
+    uint32_t insn;
+    uint32_t next_pc;
+    uint32_t value;
+    uint32_t addr;              // Load/store address (trace ADDR word)
+    uint8_t  rd;                // 0 = no register write
+    uint8_t  kind;              // rv_ret_kind_t
+    bool     mem;               // Load or store: an ADDR word precedes value
+    bool     store;
+    bool     external;          // value comes from outside the core model (MMIO
+                                // load, getq q1, waitirq, timer): take the RTL's
+} rv_retire_t;
+
+// Decode cache entry: register fields, assembled immediate and the
+// operation (rv_core.c RV_OP_*, 0 = illegal) of the word in `insn`
+#define RV_DEC_ENTRIES   4096   // Direct-mapped on pc >> 2
+
+typedef struct {
+    uint32_t insn;
+    uint32_t imm;
+    uint8_t  op;
+    uint8_t  rd;
+    uint8_t  rs1;
+    uint8_t  rs2;
+} rv_dec_t;
+
+typedef struct rv_core {
+    uint32_t x[32];
+    uint32_t pc;
+
+    // PicoRV32 IRQ state
+    uint32_t q[4];
+    uint32_t irq_mask;
+    uint32_t irq_pending;
+    bool     irq_active;
+    bool     irq_delay;
+    uint64_t timer_deadline;    // Internal 'timer' instruction, 0 = stopped
+
+    bool     rvc;               // COMPRESSED_ISA
+
+    // Accounting
+    uint64_t cycles;
+    uint64_t instret;
+    uint64_t cyc_fetch_wait;    // Core (CPI) cycles = cycles - waits - idle
+    uint64_t cyc_data_wait;
+    uint64_t cyc_idle;          // Skipped in waitirq / idle loops
+    uint64_t irqs_taken;
+    uint64_t next_event;        // soc_next_event() cache
+
+    rv_cpi_t cpi;
+    rv_halt_t halt;
+    uint32_t halt_pc;
+    uint32_t halt_insn;
+
+    rv_soc_t *soc;
+    rv_prof_t *prof;            // Optional sampling profiler (NULL = off)
+
+    // Lockstep mode: IRQs are only entered through rv_core_enter_irq() and
+    // idle loops never skip ahead, so the model follows an external core.
+    bool     lockstep;
+    rv_retire_t *retire;        // Filled by every step when non-NULL
+
+    rv_dec_t dec[RV_DEC_ENTRIES];
+} rv_core_t;
+
+void rv_core_init(rv_core_t *c, rv_soc_t *soc, uint32_t reset_pc);
+
+// Execute one instruction (or take a pending IRQ). Returns c->halt.
+rv_halt_t rv_core_step(rv_core_t *c);
+
+// Run until halted or the given limits are hit (0 = unlimited)
+rv_halt_t rv_core_run(rv_core_t *c, uint64_t max_cycles, uint64_t max_insns);
+
+// Enter the IRQ handler now (q0 = pc, q1 = irqs), as PicoRV32 does between
+// two instructions. Used in lockstep mode when the RTL takes an interrupt.
+void rv_core_enter_irq(rv_core_t *c, uint32_t irqs);
+
+const char *rv_halt_name(rv_halt_t h);
+
+#endif // RV_CORE_H
@@ -0,0 +1,105 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rv_prof.c - Sampling Profiler for rvsim
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "rv_prof.h"
+
+#define TABLE_INITIAL 1024
+
+int rv_prof_init(rv_prof_t *p, uint64_t interval) {
+    memset(p, 0, sizeof(*p));
+    p->interval = interval ? interval : 1;
+    p->next = p->interval;
+    p->table_size = TABLE_INITIAL;
+    p->table = calloc(p->table_size, sizeof(rv_prof_entry_t));
+    return p->table ? 0 : -1;
+}
+
+void rv_prof_free(rv_prof_t *p) {
+    for (uint32_t i = 0; i < p->table_size; i++)
+        free(p->table[i].frames);
+    free(p->table);
+    p->table = NULL;
+}
+
+static uint32_t hash_frames(const uint32_t *f, uint32_t n) {
+    uint32_t h = 2166136261u;                   // FNV-1a over the words
+    for (uint32_t i = 0; i < n; i++) {
+        h ^= f[i];
+        h *= 16777619u;
+    }
+    return h | 1;                               // 0 marks an empty slot
+}
+
+static rv_prof_entry_t *lookup(rv_prof_entry_t *table, uint32_t size,
+                               uint32_t h, const uint32_t *f, uint32_t n) {
+    uint32_t i = h & (size - 1);
+    for (;;) {
+        rv_prof_entry_t *e = &table[i];
+        if (e->hash == 0) return e;
+        if (e->hash == h && e->depth == n && memcmp(e->frames, f, n * 4) == 0) return e;
+        i = (i + 1) & (size - 1);
+    }
+}
+
+static int grow(rv_prof_t *p) {
+    uint32_t size = p->table_size * 2;
+    rv_prof_entry_t *t = calloc(size, sizeof(rv_prof_entry_t));
+    if (!t) return -1;
+    for (uint32_t i = 0; i < p->table_size; i++) {
+        rv_prof_entry_t *e = &p->table[i];
+        if (e->hash) *lookup(t, size, e->hash, e->frames, e->depth) = *e;
+    }
+    free(p->table);
+    p->table = t;
+    p->table_size = size;
+    return 0;
+}
+
+void rv_prof_sample(rv_prof_t *p, uint32_t pc, uint64_t weight) {
+    uint32_t f[RV_PROF_MAX_DEPTH + 1];
+    uint32_t n = 0;
+    uint32_t d = p->depth < RV_PROF_MAX_DEPTH ? p->depth : RV_PROF_MAX_DEPTH;
+
+    f[n++] = pc;
+    while (d > 0) f[n++] = p->stack[--d];
+
+    p->samples += weight;
+    if (p->table_used * 2 >= p->table_size && grow(p) < 0) return;
+
+    uint32_t h = hash_frames(f, n);
+    rv_prof_entry_t *e = lookup(p->table, p->table_size, h, f, n);
+    if (e->hash == 0) {
+        e->frames = malloc(n * 4);
+        if (!e->frames) return;
+        memcpy(e->frames, f, n * 4);
+        e->hash = h;
+        e->depth = n;
+        p->table_used++;
+    }
+    e->count += weight;
+}
+
+int rv_prof_write(const rv_prof_t *p, FILE *f) {
+    fprintf(f, "# rvprof 1 source=rvsim interval=%llu samples=%llu\n",
+            (unsigned long long)p->interval, (unsigned long long)p->samples);
+    for (uint32_t i = 0; i < p->table_size; i++) {
+        const rv_prof_entry_t *e = &p->table[i];
+        if (!e->hash) continue;
+        fprintf(f, "S %llu", (unsigned long long)e->count);
+        for (uint32_t k = 0; k < e->depth; k++)
+            fprintf(f, " %08x", e->frames[k]);
+        fputc('\n', f);
+    }
+    return ferror(f) ? -1 : 0;
+}
@@ -0,0 +1,96 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rv_prof.h - Sampling Profiler for rvsim
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Samples the PC every N estimated cycles together with the call stack.
+// The stack comes from a shadow call stack maintained by the core (jal/jalr
+// with rd=ra push, ret pops, IRQ entry/retirq bracket the handler), so the
+// firmware does not need to be rebuilt with frame pointers.
+//
+// Output is the same text format the on-target sampler (lib/profiler)
+// streams over UART, consumed by tools/profile/rvprof.py:
+//
+//   # rvprof 1 source=rvsim interval=<cycles>
+//   S <count> <pc> <ret0> <ret1> ...       (hex, innermost frame first)
+//
+// Return addresses are stored as-is; the symbolizer looks up ret-4 (the
+// call instruction). IRQ frames store the interrupted PC + 4 for the same
+// reason.
+//
+//==============================================================================
+
+#ifndef RV_PROF_H
+#define RV_PROF_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define RV_PROF_MAX_DEPTH   64
+
+typedef struct rv_prof_entry {
+    uint32_t hash;
+    uint32_t depth;             // frames[0] = pc, frames[1..] = return addresses
+    uint32_t *frames;
+    uint64_t count;
+} rv_prof_entry_t;
+
+typedef struct rv_prof {
+    uint64_t interval;
+    uint64_t next;              // Next sample at this cycle count
+
+    // Shadow call stack (outermost first)
+    uint32_t stack[RV_PROF_MAX_DEPTH];
+    uint32_t depth;             // May exceed RV_PROF_MAX_DEPTH (frames dropped)
+    uint32_t irq_depth;         // depth at IRQ entry, restored by retirq
+
+    // Aggregated stacks (open addressing)
+    rv_prof_entry_t *table;
+    uint32_t table_size;
+    uint32_t table_used;
+
+    uint64_t samples;
+} rv_prof_t;
+
+int  rv_prof_init(rv_prof_t *p, uint64_t interval);
+void rv_prof_free(rv_prof_t *p);
+
+// Record 'weight' samples of the current stack at pc (idle skips cover
+// several sampling periods at once)
+void rv_prof_sample(rv_prof_t *p, uint32_t pc, uint64_t weight);
+int  rv_prof_write(const rv_prof_t *p, FILE *f);
+
+static inline void rv_prof_call(rv_prof_t *p, uint32_t ret) {
+    if (p->depth < RV_PROF_MAX_DEPTH) p->stack[p->depth] = ret;
+    p->depth++;
+}
+
+// Unwind to the frame that returns to 'target'. Unknown targets (longjmp,
+// hand-written assembly) leave the stack alone.
+static inline void rv_prof_ret(rv_prof_t *p, uint32_t target) {
+    uint32_t d = p->depth;
+    if (d == 0) return;
+    if (d > RV_PROF_MAX_DEPTH || p->stack[d - 1] == target) {
+        p->depth = d - 1;
+        return;
+    }
+    while (--d > 0)
+        if (p->stack[d - 1] == target) { p->depth = d - 1; return; }
+}
+
+static inline void rv_prof_irq_enter(rv_prof_t *p, uint32_t resume_pc) {
+    p->irq_depth = p->depth;
+    rv_prof_call(p, resume_pc + 4);
+}
+
+static inline void rv_prof_irq_exit(rv_prof_t *p) {
+    p->depth = p->irq_depth;
+}
+
+#endif // RV_PROF_H
@@ -0,0 +1,421 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rv_soc.c - SoC Memory Map and Peripheral Model for rvsim
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include "rv_soc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+// Wait states per access, derived from the RTL in hdl/ (see rv_soc.h)
+const soc_timing_t soc_timing_default = {
+    .sram_read  = 20,
+    .sram_write = 19,
+    .sram_rmw   = 34,
+    .boot_read  = 3,
+    .mmio       = 3,
+    .unmapped   = 1,
+};
+
+#define UART_CHAR_CYCLES (10u * SOC_UART_BIT_CYCLES)     // 8N1 frame
+
+void soc_init(rv_soc_t *soc) {
+    memset(soc, 0, sizeof(*soc));
+    soc->timing = soc_timing_default;
+}
+
+//==============================================================================
+// Image loading
+//==============================================================================
+
+static uint8_t *read_file(const char *path, long *len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "rvsim: cannot open %s\n", path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    *len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *buf = malloc(*len > 0 ? (size_t)*len : 1);
+    if (buf && *len > 0 && fread(buf, 1, (size_t)*len, f) != (size_t)*len) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    if (!buf) fprintf(stderr, "rvsim: cannot read %s\n", path);
+    return buf;
+}
+
+static uint16_t le16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+// Store callback: dst[addr] = byte, with bounds already checked by caller
+typedef int (*store_fn)(rv_soc_t *soc, uint32_t addr, uint8_t byte);
+
+static int store_sram(rv_soc_t *soc, uint32_t addr, uint8_t byte) {
+    if (addr >= SOC_SRAM_SIZE) return -1;
+    soc->sram[addr] = byte;
+    return 0;
+}
+
+static int store_boot(rv_soc_t *soc, uint32_t addr, uint8_t byte) {
+    // Accept either ROM-relative or absolute (0x80000-based) addresses
+    if (soc_is_boot(addr)) addr -= SOC_BOOT_BASE;
+    if (addr >= SOC_BOOT_SIZE) return -1;
+    soc->boot[addr] = byte;
+    return 0;
+}
+
+static int load_elf(rv_soc_t *soc, const uint8_t *f, long len, const char *path,
+                    store_fn store, bool use_vaddr, uint32_t *entry) {
+    if (len < 52 || f[4] != 1 || f[5] != 1 || le16(&f[18]) != 243) {
+        fprintf(stderr, "rvsim: %s: not a little-endian RV32 ELF\n", path);
+        return -1;
+    }
+    uint32_t phoff = soc_rd32(&f[28]);
+    uint16_t phentsize = le16(&f[42]);
+    uint16_t phnum = le16(&f[44]);
+    if (entry) *entry = soc_rd32(&f[24]);
+
+    for (uint16_t i = 0; i < phnum; i++) {
+        long ph = (long)phoff + (long)i * phentsize;
+        if (ph + 32 > len) break;
+        uint32_t type   = soc_rd32(&f[ph + 0]);
+        uint32_t offset = soc_rd32(&f[ph + 4]);
+        uint32_t vaddr  = soc_rd32(&f[ph + 8]);
+        uint32_t paddr  = soc_rd32(&f[ph + 12]);
+        uint32_t filesz = soc_rd32(&f[ph + 16]);
+        uint32_t base   = use_vaddr ? vaddr : paddr;
+
+        if (type != 1 || filesz == 0) continue;
+        if ((long)offset + (long)filesz > len) {
+            fprintf(stderr, "rvsim: %s: truncated segment\n", path);
+            return -1;
+        }
+        for (uint32_t b = 0; b < filesz; b++) {
+            if (store(soc, base + b, f[offset + b]) != 0) {
+                fprintf(stderr, "rvsim: %s: segment at 0x%08x outside target memory\n", path, base);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+// objcopy -O verilog (byte tokens, byte addresses) or $readmemh word hex
+// (8-digit tokens, word addresses)
+static int load_hex(rv_soc_t *soc, const uint8_t *f, long len, const char *path, store_fn store) {
+    uint32_t addr = 0;
+    long i = 0;
+    int count = 0;
+
+    while (i < len) {
+        if (isspace(f[i])) { i++; continue; }
+        if (f[i] == '/' && i + 1 < len && f[i + 1] == '/') {
+            while (i < len && f[i] != '\n') i++;
+            continue;
+        }
+        long start = i;
+        while (i < len && !isspace(f[i])) i++;
+        char tok[32];
+        long n = i - start;
+        if (n >= (long)sizeof(tok)) n = sizeof(tok) - 1;
+        memcpy(tok, &f[start], (size_t)n);
+        tok[n] = '\0';
+
+        if (tok[0] == '@') {
+            addr = (uint32_t)strtoul(tok + 1, NULL, 16);
+            continue;
+        }
+        uint32_t v = (uint32_t)strtoul(tok, NULL, 16);
+        if (n <= 2) {
+            if (store(soc, addr, (uint8_t)v) != 0) goto range;
+            addr++;
+        } else {
+            for (int b = 0; b < 4; b++)
+                if (store(soc, addr * 4 + b, (uint8_t)(v >> (8 * b))) != 0) goto range;
+            addr++;
+        }
+        count++;
+    }
+    if (count == 0) {
+        fprintf(stderr, "rvsim: %s: no data\n", path);
+        return -1;
+    }
+    return 0;
+
+range:
+    fprintf(stderr, "rvsim: %s: data outside target memory\n", path);
+    return -1;
+}
+
+static bool looks_like_hex(const uint8_t *f, long len) {
+    if (len == 0) return false;
+    for (long i = 0; i < len && i < 4096; i++) {
+        uint8_t c = f[i];
+        if (!(isxdigit(c) || isspace(c) || c == '@' || c == '/' || c == '_')) return false;
+    }
+    return true;
+}
+
+static int load_any(rv_soc_t *soc, const char *path, store_fn store, bool rom, uint32_t *entry) {
+    long len;
+    uint8_t *f = read_file(path, &len);
+    if (!f) return -1;
+
+    int rc;
+    if (len >= 4 && f[0] == 0x7F && f[1] == 'E' && f[2] == 'L' && f[3] == 'F') {
+        // The bootloader is linked at VMA 0x80000 with LMA 0
+        rc = load_elf(soc, f, len, path, store, rom, entry);
+    } else if (looks_like_hex(f, len)) {
+        rc = load_hex(soc, f, len, path, store);
+    } else {
+        rc = 0;
+        for (long b = 0; b < len && rc == 0; b++) rc = store(soc, (uint32_t)b, f[b]);
+        if (rc) fprintf(stderr, "rvsim: %s: image larger than target memory\n", path);
+    }
+    free(f);
+    return rc;
+}
+
+int soc_load_image(rv_soc_t *soc, const char *path, uint32_t *entry) {
+    if (entry) *entry = 0;
+    return load_any(soc, path, store_sram, false, entry);
+}
+
+int soc_load_rom(rv_soc_t *soc, const char *path) {
+    return load_any(soc, path, store_boot, true, NULL);
+}
+
+//==============================================================================
+// UART (uart.v + circular_buffer.v)
+//==============================================================================
+
+void soc_uart_push_rx(rv_soc_t *soc, const uint8_t *data, uint32_t len) {
+    if (soc->host_rx_pos == soc->host_rx_len) {
+        soc->host_rx_pos = soc->host_rx_len = 0;
+        // Start bit begins now; the byte lands in the FIFO after the stop bit
+        if (soc->rx_next_arrival < soc->now + UART_CHAR_CYCLES)
+            soc->rx_next_arrival = soc->now + UART_CHAR_CYCLES;
+    }
+    if (soc->host_rx_len + len > soc->host_rx_cap) {
+        uint32_t cap = soc->host_rx_cap ? soc->host_rx_cap : 256;
+        while (cap < soc->host_rx_len + len) cap *= 2;
+        soc->host_rx = realloc(soc->host_rx, cap);
+        soc->host_rx_cap = cap;
+    }
+    memcpy(soc->host_rx + soc->host_rx_len, data, len);
+    soc->host_rx_len += len;
+}
+
+static void rx_fifo_push(rv_soc_t *soc, uint8_t b) {
+    soc->rx_fifo[soc->rx_head] = b;
+    soc->rx_head = (soc->rx_head + 1) % SOC_UART_RX_FIFO;
+    soc->rx_count++;
+}
+
+static void uart_rx_advance(rv_soc_t *soc) {
+    while (soc->host_rx_pos < soc->host_rx_len) {
+        if (soc->uart_fast) {
+            if (soc->rx_count == SOC_UART_RX_FIFO) break;   // hold on host side
+        } else {
+            if (soc->rx_next_arrival > soc->now) break;
+            soc->rx_next_arrival += UART_CHAR_CYCLES;
+            if (soc->rx_count == SOC_UART_RX_FIFO) {
+                soc->host_rx_pos++;                         // wr_en gated by full
+                soc->rx_dropped++;
+                continue;
+            }
+        }
+        rx_fifo_push(soc, soc->host_rx[soc->host_rx_pos++]);
+        soc->uart_rx_bytes++;
+    }
+}
+
+//==============================================================================
+// Timer (timer_peripheral.v)
+//==============================================================================
+
+static void timer_advance(rv_soc_t *soc, uint64_t n) {
+    soc_timer_t *t = &soc->timer;
+
+    while (t->cr_enable && n) {
+        // psc_counter counts down to zero; the tick happens in that cycle
+        uint64_t to_tick = (uint64_t)t->psc_counter + 1;
+        if (n < to_tick) {
+            t->psc_counter -= (uint16_t)n;
+            return;
+        }
+        n -= to_tick;
+        t->psc_counter = t->psc_value;
+
+        if (t->cnt_value == 0) {
+            t->sr_uif = true;
+            soc->irq_lines |= 1u;               // irq[0], single-cycle pulse
+            t->cnt_value = t->arr_value;
+            if (t->cr_one_shot) t->cr_enable = false;
+        } else {
+            // Take all remaining whole ticks that only decrement in one step
+            uint64_t per = (uint64_t)t->psc_value + 1;
+            uint64_t k;
+            t->cnt_value--;
+            k = n / per;
+            if (k > t->cnt_value) k = t->cnt_value;
+            t->cnt_value -= (uint32_t)k;
+            n -= k * per;
+        }
+    }
+}
+
+static uint64_t timer_next_fire(const rv_soc_t *soc) {
+    const soc_timer_t *t = &soc->timer;
+    if (!t->cr_enable) return UINT64_MAX;
+    return soc->now + (uint64_t)t->psc_counter + 1 +
+           (uint64_t)t->cnt_value * ((uint64_t)t->psc_value + 1);
+}
+
+static uint32_t timer_reg(const soc_timer_t *t, uint32_t off) {
+    switch (off) {
+        case 0x00: return (t->cr_one_shot ? 2u : 0u) | (t->cr_enable ? 1u : 0u);
+        case 0x04: return t->sr_uif ? 1u : 0u;
+        case 0x08: return t->psc_value;
+        case 0x0C: return t->arr_value;
+        case 0x10: return t->cnt_value;
+        default:   return 0;
+    }
+}
+
+static void timer_write(soc_timer_t *t, uint32_t off, uint32_t data, uint32_t wstrb) {
+    switch (off) {
+        case 0x00:
+            if (wstrb & 1) {
+                bool en = data & 1;
+                if (en && !t->cr_enable) {
+                    t->cnt_value = t->arr_value;
+                    t->psc_counter = t->psc_value;
+                }
+                t->cr_enable = en;
+                t->cr_one_shot = (data >> 1) & 1;
+            }
+            break;
+        case 0x04:
+            if ((wstrb & 1) && (data & 1)) t->sr_uif = false;
+            break;
+        case 0x08:
+            if (wstrb & 1) t->psc_value = (uint16_t)((t->psc_value & 0xFF00) | (data & 0x00FF));
+            if (wstrb & 2) t->psc_value = (uint16_t)((t->psc_value & 0x00FF) | (data & 0xFF00));
+            break;
+        case 0x0C:
+            for (int b = 0; b < 4; b++) {
+                if (wstrb & (1u << b)) {
+                    uint32_t m = 0xFFu << (8 * b);
+                    t->arr_value = (t->arr_value & ~m) | (data & m);
+                }
+            }
+            break;
+        default:
+            break;                              // CNT is read-only
+    }
+}
+
+//==============================================================================
+// Scheduling
+//==============================================================================
+
+void soc_advance(rv_soc_t *soc, uint64_t now) {
+    if (now > soc->now) {
+        timer_advance(soc, now - soc->now);
+        soc->now = now;
+    }
+    if (soc->host_rx_pos == soc->host_rx_len && soc->rx_poll)
+        soc->rx_poll(soc->rx_ctx, soc);
+    uart_rx_advance(soc);
+}
+
+uint64_t soc_next_event(const rv_soc_t *soc) {
+    uint64_t next = timer_next_fire(soc);
+    if (soc->host_rx_pos < soc->host_rx_len && !soc->uart_fast && soc->rx_next_arrival < next)
+        next = soc->rx_next_arrival;
+    return next;
+}
+
+//==============================================================================
+// MMIO (mmio_peripherals.v)
+//==============================================================================
+
+uint32_t soc_mmio_read(rv_soc_t *soc, uint32_t addr) {
+    if ((addr & ~0xFu) == SOC_TIMER_BASE) {
+        // mmio_peripherals registers timer_rdata in the same edge the timer
+        // registers its own read mux, so a read returns the value latched
+        // by the previous timer access.
+        uint32_t v = soc->timer.rdata;
+        soc->timer.rdata = timer_reg(&soc->timer, addr & 0x1F);
+        return v;
+    }
+
+    switch (addr) {
+        case SOC_UART_TX_STATUS:
+            return (!soc->uart_fast && soc->now < soc->tx_busy_until) ? 1u : 0u;
+        case SOC_UART_RX_DATA:
+            if (soc->rx_count) {
+                uint8_t b = soc->rx_fifo[soc->rx_tail];
+                soc->rx_tail = (soc->rx_tail + 1) % SOC_UART_RX_FIFO;
+                soc->rx_count--;
+                return b;
+            }
+            return 0;
+        case SOC_UART_RX_STATUS:
+            return soc->rx_count ? 1u : 0u;
+        case SOC_LED_CONTROL:
+            return soc->led & 3u;
+        case SOC_MODE_CONTROL:
+            return 1u;                          // Tied to app mode in the top level
+        case SOC_BUTTON_INPUT:
+            return soc->buttons & 3u;
+        default:
+            return 0;
+    }
+}
+
+void soc_mmio_write(rv_soc_t *soc, uint32_t addr, uint32_t data, uint32_t wstrb, uint64_t *stall) {
+    *stall = 0;
+
+    if ((addr & ~0xFu) == SOC_TIMER_BASE) {
+        soc->timer.rdata = timer_reg(&soc->timer, addr & 0x1F);
+        timer_write(&soc->timer, addr & 0x1F, data, wstrb);
+        return;
+    }
+
+    switch (addr) {
+        case SOC_UART_TX_DATA:
+            // The RTL never acks a TX write while busy (the CPU would hang);
+            // the model stalls until the transmitter is free instead.
+            if (!soc->uart_fast) {
+                if (soc->now < soc->tx_busy_until) {
+                    *stall = soc->tx_busy_until - soc->now;
+                    soc->uart_stall_cycles += *stall;
+                }
+                soc->tx_busy_until = soc->now + *stall + UART_CHAR_CYCLES;
+            }
+            soc->uart_tx_bytes++;
+            if (soc->tx_hook) soc->tx_hook(soc->tx_ctx, (uint8_t)data);
+            break;
+        case SOC_LED_CONTROL:
+            if ((wstrb & 1) && (soc->led & 3u) != (data & 3u)) {
+                soc->led = data & 3u;
+                soc->led_changes++;
+            }
+            break;
+        default:
+            break;
+    }
+}
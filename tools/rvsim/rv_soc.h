@@ -0,0 +1,180 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rv_soc.h - SoC Memory Map and Peripheral Model for rvsim
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#ifndef RV_SOC_H
+#define RV_SOC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//==============================================================================
+// Memory Map (mem_controller.v)
+//==============================================================================
+
+#define SOC_SRAM_BASE       0x00000000u
+#define SOC_SRAM_SIZE       0x00080000u     // 512KB (K6R4016, 256K x 16)
+#define SOC_BOOT_BASE       0x00080000u     // Bootloader ROM, above SRAM
+#define SOC_BOOT_SIZE       0x00002000u     // 8KB BRAM
+#define SOC_MMIO_BASE       0x80000000u
+#define SOC_MMIO_END        0x800000FFu
+
+#define SOC_UART_TX_DATA    0x80000000u
+#define SOC_UART_TX_STATUS  0x80000004u
+#define SOC_UART_RX_DATA    0x80000008u
+#define SOC_UART_RX_STATUS  0x8000000Cu
+#define SOC_LED_CONTROL     0x80000010u
+#define SOC_MODE_CONTROL    0x80000014u
+#define SOC_BUTTON_INPUT    0x80000018u
+#define SOC_TIMER_BASE      0x80000020u
+
+#define SOC_CLK_HZ          50000000u
+#define SOC_UART_BIT_CYCLES 434u            // CLK_FREQ / BAUD_RATE in uart.v
+#define SOC_UART_RX_FIFO    256u            // circular_buffer ADDR_BITS=8
+
+//==============================================================================
+// Memory path cost model
+//
+// Wait states seen by PicoRV32 between mem_valid and mem_ready, counted from
+// the RTL state machines (mem_controller -> sram_proc_new -> sram_driver_new
+// with the 5-state SETUP/ACTIVE/RECOVERY/COOLDOWN driver):
+//
+//   SRAM read       : 2 x 16-bit reads + WAIT/SETUP/COMPLETE/DONE states
+//   SRAM write      : 2 x 16-bit writes (wstrb == 4'b1111)
+//   SRAM write RMW  : 2 x 16-bit reads + merge + 2 x 16-bit writes (sb/sh)
+//   Boot ROM read   : BOOT_WAIT + BOOT_WAIT2 (synchronous BRAM)
+//   MMIO            : mmio_valid -> mmio_ready -> cpu_mem_ready
+//   Unmapped        : answered from IDLE with zero
+//==============================================================================
+
+typedef struct {
+    uint32_t sram_read;
+    uint32_t sram_write;
+    uint32_t sram_rmw;
+    uint32_t boot_read;
+    uint32_t mmio;
+    uint32_t unmapped;
+} soc_timing_t;
+
+extern const soc_timing_t soc_timing_default;
+
+//==============================================================================
+// Peripheral state
+//==============================================================================
+
+typedef struct {
+    // Timer (timer_peripheral.v)
+    bool     cr_enable;
+    bool     cr_one_shot;
+    bool     sr_uif;
+    uint16_t psc_value;
+    uint16_t psc_counter;
+    uint32_t arr_value;
+    uint32_t cnt_value;
+    uint32_t rdata;             // Registered read data (see soc_mmio_read)
+} soc_timer_t;
+
+typedef struct rv_soc {
+    uint8_t  sram[SOC_SRAM_SIZE];
+    uint8_t  boot[SOC_BOOT_SIZE];
+
+    soc_timing_t timing;
+    uint64_t now;               // Current cycle (kept in step by the core)
+
+    // UART
+    bool     uart_fast;         // No line-rate pacing (TX never busy, RX instant)
+    uint64_t tx_busy_until;
+    uint8_t  rx_fifo[SOC_UART_RX_FIFO];
+    uint32_t rx_head, rx_tail, rx_count;
+    uint64_t rx_next_arrival;
+    uint8_t  *host_rx;          // Bytes waiting on the host side of the wire
+    uint32_t host_rx_len, host_rx_pos, host_rx_cap;
+    uint64_t rx_dropped;
+    void (*tx_hook)(void *ctx, uint8_t byte);
+    void *tx_ctx;
+    void (*rx_poll)(void *ctx, struct rv_soc *soc);
+    void *rx_ctx;
+
+    // LEDs / buttons
+    uint32_t led;
+    uint32_t buttons;           // bit0 = BUT1, bit1 = BUT2 (1 = pressed)
+    uint64_t led_changes;
+
+    soc_timer_t timer;
+    uint32_t irq_lines;         // Latched into PicoRV32 irq_pending by the core
+
+    // Statistics
+    uint64_t uart_tx_bytes;
+    uint64_t uart_rx_bytes;
+    uint64_t uart_stall_cycles;
+} rv_soc_t;
+
+void soc_init(rv_soc_t *soc);
+
+// Image loaders (return 0 on success, -1 on error with message on stderr)
+int  soc_load_image(rv_soc_t *soc, const char *path, uint32_t *entry);
+int  soc_load_rom(rv_soc_t *soc, const char *path);
+
+// Host side of the UART
+void soc_uart_push_rx(rv_soc_t *soc, const uint8_t *data, uint32_t len);
+
+// Advance peripherals to cycle 'now' (timer counting, UART RX arrival)
+void soc_advance(rv_soc_t *soc, uint64_t now);
+
+// Cycles until the next peripheral event that could raise an IRQ
+// (UINT64_MAX if nothing is scheduled). Used to skip idle loops.
+uint64_t soc_next_event(const rv_soc_t *soc);
+
+// MMIO accesses. addr is word aligned; extra stall cycles are returned
+// through *stall (UART TX writes while the transmitter is busy).
+uint32_t soc_mmio_read(rv_soc_t *soc, uint32_t addr);
+void     soc_mmio_write(rv_soc_t *soc, uint32_t addr, uint32_t data, uint32_t wstrb, uint64_t *stall);
+
+//==============================================================================
+// Fast-path helpers used by the core
+//==============================================================================
+
+static inline bool soc_is_boot(uint32_t addr) {
+    return addr - SOC_BOOT_BASE < SOC_BOOT_SIZE;
+}
+
+static inline bool soc_is_sram(uint32_t addr) {
+    return addr < SOC_SRAM_SIZE;
+}
+
+static inline bool soc_is_mmio(uint32_t addr) {
+    return addr >= SOC_MMIO_BASE && addr <= SOC_MMIO_END;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <string.h>
+static inline uint32_t soc_rd32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline void soc_wr32(uint8_t *p, uint32_t v) {
+    memcpy(p, &v, 4);
+}
+#else
+static inline uint32_t soc_rd32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void soc_wr32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+#endif
+
+#endif // RV_SOC_H
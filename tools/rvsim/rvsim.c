@@ -0,0 +1,310 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rvsim.c - Cycle-Approximate SoC Simulator (command line front end)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Runs firmware images against a host model of the SoC (rv_core + rv_soc)
+// and reports the number of 50 MHz board cycles the run would take.
+// UART TX goes to stdout, stdin feeds UART RX. Simulator messages go to
+// stderr so firmware output can be piped or diffed.
+//
+//==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "rv_core.h"
+#include "rv_soc.h"
+
+#ifndef RVSIM_ROM_DEFAULT
+#define RVSIM_ROM_DEFAULT "../../bootloader/bootloader.hex"
+#endif
+
+#define RUN_CHUNK 1000000ULL            // Instructions between host checks
+#define PROFILE_INTERVAL_DEFAULT 1009   // Prime, so sampling does not alias with loops
+
+typedef struct {
+    rv_core_t *core;
+    const char *exit_on;
+    size_t exit_len;
+    size_t match_pos;
+    bool matched;
+    bool stdin_open;
+    unsigned poll_div;
+} host_t;
+
+static volatile sig_atomic_t g_stop = 0;
+static struct termios g_saved_tio;
+static bool g_tio_saved = false;
+
+static void on_signal(int sig) {
+    (void)sig;
+    g_stop = 1;
+}
+
+static void restore_tty(void) {
+    if (g_tio_saved) tcsetattr(STDIN_FILENO, TCSANOW, &g_saved_tio);
+}
+
+static double host_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//==============================================================================
+// UART host side
+//==============================================================================
+
+static void uart_tx(void *ctx, uint8_t byte) {
+    host_t *h = ctx;
+    fputc(byte, stdout);
+    if (byte == '\n') fflush(stdout);
+
+    if (h->exit_len && !h->matched) {
+        // Restart-on-mismatch matcher (exit strings are short literals)
+        if (byte == (uint8_t)h->exit_on[h->match_pos]) {
+            if (++h->match_pos == h->exit_len) {
+                h->matched = true;
+                h->core->halt = RV_HALT_USER;
+                h->core->halt_pc = h->core->pc;
+            }
+        } else {
+            h->match_pos = (byte == (uint8_t)h->exit_on[0]) ? 1 : 0;
+        }
+    }
+}
+
+static void uart_rx_poll(void *ctx, rv_soc_t *soc) {
+    host_t *h = ctx;
+    uint8_t buf[256];
+    ssize_t n;
+
+    if (!h->stdin_open || (h->poll_div++ & 255)) return;
+    fflush(stdout);
+    n = read(STDIN_FILENO, buf, sizeof(buf));
+    if (n > 0) soc_uart_push_rx(soc, buf, (uint32_t)n);
+    else if (n == 0) h->stdin_open = false;
+}
+
+static int push_file(rv_soc_t *soc, const char *path) {
+    FILE *f = fopen(path, "rb");
+    uint8_t buf[4096];
+    size_t n;
+    if (!f) {
+        fprintf(stderr, "rvsim: cannot open %s\n", path);
+        return -1;
+    }
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) soc_uart_push_rx(soc, buf, (uint32_t)n);
+    fclose(f);
+    return 0;
+}
+
+static void push_escaped(rv_soc_t *soc, const char *s) {
+    for (; *s; s++) {
+        uint8_t b = (uint8_t)*s;
+        if (*s == '\\' && s[1]) {
+            s++;
+            switch (*s) {
+                case 'n': b = '\n'; break;
+                case 'r': b = '\r'; break;
+                case 't': b = '\t'; break;
+                default:  b = (uint8_t)*s; break;
+            }
+        }
+        soc_uart_push_rx(soc, &b, 1);
+    }
+}
+
+//==============================================================================
+// Report
+//==============================================================================
+
+static void report(const rv_core_t *c, const rv_soc_t *soc, double elapsed, bool verbose) {
+    double ms = c->cycles * 1000.0 / SOC_CLK_HZ;
+    double cpi = c->instret ? (double)(c->cycles - c->cyc_idle) / c->instret : 0.0;
+    double mips = elapsed > 0 ? c->instret / elapsed / 1e6 : 0.0;
+
+    fprintf(stderr, "\n[RVSIM] Stopped (%s) at pc=0x%08x", rv_halt_name(c->halt), c->halt_pc);
+    if (c->halt == RV_HALT_TRAP) fprintf(stderr, " insn=0x%08x", c->halt_insn);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "[RVSIM] Instructions: %llu\n", (unsigned long long)c->instret);
+    fprintf(stderr, "[RVSIM] Est. cycles:  %llu (%.3f ms @ %u MHz, CPI %.2f)\n",
+            (unsigned long long)c->cycles, ms, SOC_CLK_HZ / 1000000u, cpi);
+    if (verbose) {
+        fprintf(stderr, "[RVSIM]   core %llu | fetch wait %llu | data wait %llu | idle %llu | UART stall %llu\n",
+                (unsigned long long)(c->cycles - c->cyc_fetch_wait - c->cyc_data_wait - c->cyc_idle),
+                (unsigned long long)c->cyc_fetch_wait,
+                (unsigned long long)c->cyc_data_wait, (unsigned long long)c->cyc_idle,
+                (unsigned long long)soc->uart_stall_cycles);
+        fprintf(stderr, "[RVSIM]   IRQs %llu | UART tx %llu rx %llu (dropped %llu) | LED changes %llu\n",
+                (unsigned long long)c->irqs_taken, (unsigned long long)soc->uart_tx_bytes,
+                (unsigned long long)soc->uart_rx_bytes, (unsigned long long)soc->rx_dropped,
+                (unsigned long long)soc->led_changes);
+    }
+    fprintf(stderr, "[RVSIM] Host time:    %.3f s (%.1f MIPS)\n", elapsed, mips);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+        "Usage: %s [options] [firmware.elf|.hex|.bin]\n"
+        "\n"
+        "Options:\n"
+        "  --boot             Reset into the bootloader ROM (0x80000) like hardware\n"
+        "                     (default: start at 0x0 like the SIMULATION build)\n"
+        "  --rom FILE         Bootloader ROM image (default %s)\n"
+        "  --rvc              Enable compressed instructions (COMPRESSED_ISA=1)\n"
+        "  --uart-fast        Ignore UART line rate (TX never busy, RX instant)\n"
+        "  --input STR        Send STR to UART RX (\\n \\r \\t escapes)\n"
+        "  --input-file FILE  Send the contents of FILE to UART RX\n"
+        "  --no-stdin         Do not forward stdin to UART RX\n"
+        "  --exit-on STR      Stop when the firmware prints STR\n"
+        "  --max-cycles N     Stop after N estimated cycles\n"
+        "  --max-insns N      Stop after N instructions\n"
+        "  --buttons MASK     Button state (bit0 = BUT1, bit1 = BUT2 pressed)\n"
+        "  --profile FILE     Sample PC + call stack, write rvprof samples to FILE\n"
+        "  --profile-interval N  Cycles between samples (default %d)\n"
+        "  -v, --verbose      Print cycle breakdown\n"
+        "  -h, --help         Show this help\n",
+        prog, RVSIM_ROM_DEFAULT, PROFILE_INTERVAL_DEFAULT);
+}
+
+int main(int argc, char **argv) {
+    const char *firmware = NULL;
+    const char *rom = RVSIM_ROM_DEFAULT;
+    bool rom_given = false;
+    bool boot = false, rvc = false, uart_fast = false, use_stdin = true, verbose = false;
+    uint64_t max_cycles = 0, max_insns = 0;
+    uint32_t buttons = 0;
+    const char *profile = NULL;
+    uint64_t profile_interval = PROFILE_INTERVAL_DEFAULT;
+    const char *inputs[16];
+    const char *input_files[16];
+    int n_inputs = 0, n_input_files = 0;
+    host_t host;
+
+    memset(&host, 0, sizeof(host));
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        bool more = (i + 1 < argc);
+        if (!strcmp(a, "-h") || !strcmp(a, "--help")) { usage(argv[0]); return 0; }
+        else if (!strcmp(a, "--boot"))                    boot = true;
+        else if (!strcmp(a, "--rom") && more)             { rom = argv[++i]; rom_given = true; }
+        else if (!strcmp(a, "--rvc"))                     rvc = true;
+        else if (!strcmp(a, "--uart-fast"))               uart_fast = true;
+        else if (!strcmp(a, "--input") && more && n_inputs < 16)            inputs[n_inputs++] = argv[++i];
+        else if (!strcmp(a, "--input-file") && more && n_input_files < 16)  input_files[n_input_files++] = argv[++i];
+        else if (!strcmp(a, "--no-stdin"))                use_stdin = false;
+        else if (!strcmp(a, "--exit-on") && more)         host.exit_on = argv[++i];
+        else if (!strcmp(a, "--max-cycles") && more)      max_cycles = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(a, "--max-insns") && more)       max_insns = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(a, "--buttons") && more)         buttons = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(a, "--profile") && more)         profile = argv[++i];
+        else if (!strcmp(a, "--profile-interval") && more) profile_interval = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(a, "-v") || !strcmp(a, "--verbose")) verbose = true;
+        else if (a[0] != '-' && !firmware)                firmware = a;
+        else { usage(argv[0]); return 1; }
+    }
+
+    if (!firmware && !boot) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    static rv_soc_t soc;                // 520KB of memory, keep it off the stack
+    static rv_core_t core;
+    static rv_prof_t prof;
+    soc_init(&soc);
+    soc.uart_fast = uart_fast;
+    soc.buttons = buttons;
+
+    // The ROM is optional unless the user asked for it or boots from it
+    if (rom_given || boot || access(rom, R_OK) == 0) {
+        if (soc_load_rom(&soc, rom) != 0) return 1;
+    }
+    if (firmware && soc_load_image(&soc, firmware, NULL) != 0) return 1;
+
+    rv_core_init(&core, &soc, boot ? RV_PROGADDR_RESET_HW : RV_PROGADDR_RESET_SIM);
+    core.rvc = rvc;
+    if (profile) {
+        if (rv_prof_init(&prof, profile_interval) != 0) {
+            fprintf(stderr, "rvsim: out of memory for profiler\n");
+            return 1;
+        }
+        core.prof = &prof;
+    }
+
+    host.core = &core;
+    host.exit_len = host.exit_on ? strlen(host.exit_on) : 0;
+    host.stdin_open = use_stdin;
+    soc.tx_hook = uart_tx;
+    soc.tx_ctx = &host;
+    soc.rx_poll = uart_rx_poll;
+    soc.rx_ctx = &host;
+
+    for (int i = 0; i < n_inputs; i++) push_escaped(&soc, inputs[i]);
+    for (int i = 0; i < n_input_files; i++)
+        if (push_file(&soc, input_files[i]) != 0) return 1;
+
+    if (use_stdin) {
+        if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &g_saved_tio) == 0) {
+            struct termios t = g_saved_tio;
+            g_tio_saved = true;
+            t.c_lflag &= ~(ICANON | ECHO);      // Keep ISIG for Ctrl-C
+            t.c_iflag &= ~(ICRNL | IXON);
+            tcsetattr(STDIN_FILENO, TCSANOW, &t);
+            atexit(restore_tty);
+        }
+        fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    double t0 = host_seconds();
+    while (core.halt == RV_RUNNING) {
+        uint64_t chunk = RUN_CHUNK;
+        if (max_insns) {
+            if (core.instret >= max_insns) { core.halt = RV_HALT_LIMIT; core.halt_pc = core.pc; break; }
+            if (max_insns - core.instret < chunk) chunk = max_insns - core.instret;
+        }
+        rv_core_run(&core, max_cycles, chunk);
+        if (core.halt == RV_HALT_LIMIT && (!max_insns || core.instret < max_insns) &&
+            (!max_cycles || core.cycles < max_cycles))
+            core.halt = RV_RUNNING;         // chunk boundary, not a real limit
+        if (g_stop) { core.halt = RV_HALT_USER; core.halt_pc = core.pc; }
+    }
+    double elapsed = host_seconds() - t0;
+
+    fflush(stdout);
+    restore_tty();
+    report(&core, &soc, elapsed, verbose);
+
+    if (profile) {
+        FILE *f = fopen(profile, "w");
+        if (!f || rv_prof_write(&prof, f) != 0) {
+            fprintf(stderr, "rvsim: cannot write %s\n", profile);
+            if (f) fclose(f);
+            return 1;
+        }
+        fclose(f);
+        fprintf(stderr, "[RVSIM] Profile:      %llu samples every %llu cycles -> %s\n",
+                (unsigned long long)prof.samples, (unsigned long long)prof.interval, profile);
+        rv_prof_free(&prof);
+    }
+
+    return core.halt == RV_HALT_TRAP ? 2 : 0;
+}
@@ -0,0 +1,332 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rvsim_selftest.c - rvsim Core/SoC Self-Test (hand-assembled programs)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rv_core.h"
+#include "rv_soc.h"
+
+//==============================================================================
+// Minimal encoder
+//==============================================================================
+
+enum { ZERO, RA, SP, GP, TP, T0, T1, T2, S0, S1, A0, A1, A2, A3, A4, A5 };
+
+#define R(f7, rs2, rs1, f3, rd, op) (((f7) << 25) | ((rs2) << 20) | ((rs1) << 15) | ((f3) << 12) | ((rd) << 7) | (op))
+#define I(imm, rs1, f3, rd, op)     ((((uint32_t)(imm) & 0xFFF) << 20) | ((rs1) << 15) | ((f3) << 12) | ((rd) << 7) | (op))
+#define S(imm, rs2, rs1, f3)        (((((uint32_t)(imm) >> 5) & 0x7F) << 25) | ((rs2) << 20) | ((rs1) << 15) | ((f3) << 12) | (((uint32_t)(imm) & 0x1F) << 7) | 0x23)
+
+static uint32_t B(int32_t off, int rs2, int rs1, int f3) {
+    uint32_t i = (uint32_t)off;
+    return (((i >> 12) & 1) << 31) | (((i >> 5) & 0x3F) << 25) | ((uint32_t)rs2 << 20) | ((uint32_t)rs1 << 15) |
+           ((uint32_t)f3 << 12) | (((i >> 1) & 0xF) << 8) | (((i >> 11) & 1) << 7) | 0x63;
+}
+
+static uint32_t J(int32_t off, int rd) {
+    uint32_t i = (uint32_t)off;
+    return (((i >> 20) & 1) << 31) | (((i >> 1) & 0x3FF) << 21) | (((i >> 11) & 1) << 20) |
+           (((i >> 12) & 0xFF) << 12) | ((uint32_t)rd << 7) | 0x6F;
+}
+
+#define ADDI(rd, rs1, imm)  I(imm, rs1, 0, rd, 0x13)
+#define LUI(rd, imm20)      ((((uint32_t)(imm20)) << 12) | ((rd) << 7) | 0x37)
+#define ADD(rd, a, b)       R(0, b, a, 0, rd, 0x33)
+#define MUL(rd, a, b)       R(1, b, a, 0, rd, 0x33)
+#define DIV(rd, a, b)       R(1, b, a, 4, rd, 0x33)
+#define REM(rd, a, b)       R(1, b, a, 6, rd, 0x33)
+#define LW(rd, rs1, imm)    I(imm, rs1, 2, rd, 0x03)
+#define LB(rd, rs1, imm)    I(imm, rs1, 0, rd, 0x03)
+#define LBU(rd, rs1, imm)   I(imm, rs1, 4, rd, 0x03)
+#define SW(rs2, rs1, imm)   S(imm, rs2, rs1, 2)
+#define SB(rs2, rs1, imm)   S(imm, rs2, rs1, 0)
+#define BNE(a, b, off)      B(off, b, a, 1)
+#define GETQ(rd, q)         R(0, 0, q, 4, rd, 0x0B)
+#define RETIRQ              R(2, 0, 0, 0, 0, 0x0B)
+#define MASKIRQ(rd, rs1)    R(3, 0, rs1, 6, rd, 0x0B)
+#define JALR(rd, rs1, imm)  I(imm, rs1, 0, rd, 0x67)
+#define RET                 JALR(ZERO, RA, 0)
+#define EBREAK              0x00100073u
+
+static rv_soc_t soc;
+static rv_core_t core;
+static int failures;
+
+static void load(uint32_t addr, const uint32_t *prog, int n) {
+    for (int i = 0; i < n; i++) soc_wr32(&soc.sram[addr + 4 * i], prog[i]);
+}
+
+static void reset(void) {
+    soc_init(&soc);
+    rv_core_init(&core, &soc, 0);
+}
+
+static void check(const char *name, uint32_t got, uint32_t want) {
+    if (got != want) {
+        printf("FAIL: %s: got 0x%08x want 0x%08x\n", name, got, want);
+        failures++;
+    } else {
+        printf("PASS: %s\n", name);
+    }
+}
+
+//==============================================================================
+// Tests
+//==============================================================================
+
+static void test_alu_mul_div(void) {
+    const uint32_t p[] = {
+        ADDI(A0, ZERO, -7),
+        ADDI(A1, ZERO, 3),
+        MUL(A2, A0, A1),            // -21
+        DIV(A3, A0, A1),            // -2
+        REM(A4, A0, A1),            // -1
+        DIV(A5, A0, ZERO),          // -1 (div by zero)
+        EBREAK,
+    };
+    reset();
+    load(0, p, 7);
+    rv_core_run(&core, 0, 100);
+    check("mul", core.x[A2], (uint32_t)-21);
+    check("div", core.x[A3], (uint32_t)-2);
+    check("rem", core.x[A4], (uint32_t)-1);
+    check("div0", core.x[A5], 0xFFFFFFFFu);
+    check("ebreak traps with IRQs masked", core.halt, RV_HALT_TRAP);
+}
+
+static void test_memory_and_rom(void) {
+    // SRAM is linear through 0x40000; the ROM at 0x80000 ignores stores
+    const uint32_t p[] = {
+        LUI(T0, 0x40),              // t0 = 0x40000
+        ADDI(T1, ZERO, 0x5A),
+        SB(T1, T0, 1),
+        LBU(A0, T0, 1),             // reads SRAM byte back
+        LUI(T0, 0x80),              // t0 = 0x80000
+        SB(T1, T0, 1),              // dropped
+        LBU(A3, T0, 1),             // reads ROM byte 1
+        LUI(T2, 0x1),               // t2 = 0x1000
+        SW(T1, T2, 0),
+        ADDI(T1, ZERO, -1),
+        SB(T1, T2, 2),
+        LW(A1, T2, 0),              // 0x00FF005A
+        LB(A2, T2, 2),              // -1
+        EBREAK,
+    };
+    reset();
+    soc.boot[1] = 0xA5;
+    load(0, p, 14);
+    rv_core_run(&core, 0, 100);
+    check("sram read at 0x40000", core.x[A0], 0x5A);
+    check("sram byte write at 0x40000", soc.sram[0x40001], 0x5A);
+    check("rom read after rom write", core.x[A3], 0xA5);
+    check("byte RMW", core.x[A1], 0x00FF005Au);
+    check("lb sign extend", core.x[A2], 0xFFFFFFFFu);
+}
+
+static void test_cycle_model(void) {
+    // addi; sw; sb; lw; ebreak -- check the wait-state accounting exactly
+    const uint32_t p[] = {
+        ADDI(T0, ZERO, 0x100),
+        SW(ZERO, T0, 0),
+        SB(ZERO, T0, 0),
+        LW(A0, T0, 0),
+    };
+    const soc_timing_t *t = &soc_timing_default;
+    const rv_cpi_t *k = &rv_cpi_default;
+    uint64_t want = 4 * (t->sram_read - 1) +
+                    k->alu_imm + k->store + k->store + k->load +
+                    (t->sram_write - 1) + (t->sram_rmw - 1) + (t->sram_read - 1);
+    reset();
+    load(0, p, 4);
+    rv_core_run(&core, 0, 4);
+    check("cycle estimate", (uint32_t)core.cycles, (uint32_t)want);
+}
+
+static void test_timer_irq(void) {
+    // main: program timer (PSC=0, ARR=999), enable, unmask, spin on j .
+    // irq (0x10): count in s1, clear SR.UIF, retirq
+    const uint32_t p[] = {
+        J(0x30, ZERO),              // 0x00: j main
+        0, 0, 0,
+        ADDI(S1, S1, 1),            // 0x10: irq_vec
+        GETQ(A0, 1),
+        LUI(T0, 0x80000),
+        ADDI(T1, ZERO, 1),
+        SW(T1, T0, 0x24),           // SR = 1 (W1C)
+        RETIRQ,
+        0, 0,
+        LUI(T0, 0x80000),           // 0x30: main
+        SW(ZERO, T0, 0x28),         // PSC = 0
+        ADDI(T1, ZERO, 999),
+        SW(T1, T0, 0x2C),           // ARR = 999
+        ADDI(T1, ZERO, 1),
+        SW(T1, T0, 0x20),           // CR = enable
+        MASKIRQ(ZERO, ZERO),        // unmask all
+        J(0, ZERO),                 // j .
+    };
+    reset();
+    load(0, p, sizeof(p) / 4);
+    rv_core_run(&core, 100000, 0);
+    // 1000 cycles per period -> ~100 IRQs in 100000 cycles (minus setup)
+    check("timer irq count", (core.x[S1] >= 98 && core.x[S1] <= 100), 1);
+    check("irq q1 bitmask", core.x[A0], 1);
+    check("irqs_taken matches", (uint32_t)core.irqs_taken, core.x[S1]);
+}
+
+static void test_uart_tx(void) {
+    const uint32_t p[] = {
+        LUI(T0, 0x80000),
+        ADDI(T1, ZERO, 'O'),
+        SW(T1, T0, 0),
+        ADDI(T1, ZERO, 'K'),
+        SW(T1, T0, 0),              // stalls until the first byte is out
+        EBREAK,
+    };
+    reset();
+    load(0, p, 6);
+    rv_core_run(&core, 0, 100);
+    check("uart tx count", (uint32_t)soc.uart_tx_bytes, 2);
+    check("uart stall >= one char", soc.uart_stall_cycles >= 10 * SOC_UART_BIT_CYCLES - 100, 1);
+}
+
+static void test_lockstep_retire(void) {
+    const uint32_t p[] = {
+        J(0x20, ZERO),              // 0x00: j main
+        0, 0, 0,
+        GETQ(A0, 0),                // 0x10: irq_vec
+        RETIRQ,
+        0, 0,
+        ADDI(ZERO, ZERO, 7),        // 0x20: main - result traced although rd = x0
+        LUI(T0, 0x1),
+        ADDI(T1, ZERO, -2),
+        SB(T1, T0, 3),              // store data = rs2, not the lane copy
+        LW(A1, T0, 0),
+        BNE(A1, A1, 0x40),          // untaken: reg_out = pc + imm
+        BNE(A1, ZERO, 8),           // taken
+        0,
+        LUI(T0, 0x80000),           // 0x40
+        LW(A2, T0, 0x30),           // timer CNT: external
+        MASKIRQ(ZERO, ZERO),        // 0x48
+        ADDI(ZERO, ZERO, 0),
+        ADDI(ZERO, ZERO, 0),        // 0x50
+    };
+    rv_retire_t r[12];
+    reset();
+    load(0, p, sizeof(p) / 4);
+    core.lockstep = true;
+    for (int i = 0; i < 11; i++) {
+        core.retire = &r[i];
+        rv_core_step(&core);
+    }
+    check("retire x0 result", r[1].value, 7);
+    check("retire x0 no write", r[1].rd, 0);
+    check("retire store addr", r[4].addr, 0x1003);
+    check("retire store data", r[4].value, 0xFFFFFFFEu);
+    check("retire load value", r[5].value, 0xFE000000u);
+    check("retire untaken branch", r[6].kind == RV_RET_VALUE && r[6].value == 0x74, 1);
+    check("retire taken branch", r[7].kind == RV_RET_BRANCH && r[7].value == 0x40, 1);
+    check("retire mmio load external", r[9].mem && r[9].external, 1);
+
+    // Pending and unmasked, but only entered on request
+    core.irq_pending = 1;
+    core.retire = &r[11];
+    rv_core_step(&core);
+    check("lockstep ignores pending irq", core.pc, 0x50);
+    rv_core_enter_irq(&core, 1);
+    rv_core_step(&core);
+    rv_core_step(&core);
+    check("lockstep irq entry q0", core.x[A0], 0x50);
+    check("lockstep retirq", r[11].kind == RV_RET_BRANCH && r[11].value == 0x50 && !core.irq_active, 1);
+}
+
+static void test_profiler(void) {
+    // main calls f 50 times, f calls g, g spins 100 iterations
+    const uint32_t p[] = {
+        ADDI(S1, ZERO, 50),         // 0x00: main
+        J(0x1C, RA),                // 0x04: jal f
+        ADDI(S1, S1, -1),           // 0x08
+        BNE(S1, ZERO, -8),
+        EBREAK,                     // 0x10
+        0, 0, 0,
+        ADDI(SP, SP, -16),          // 0x20: f
+        SW(RA, SP, 12),
+        J(0x18, RA),                // 0x28: jal g
+        LW(RA, SP, 12),             // 0x2C
+        ADDI(SP, SP, 16),
+        RET,
+        0, 0,
+        ADDI(T0, ZERO, 100),        // 0x40: g
+        ADDI(T0, T0, -1),
+        BNE(T0, ZERO, -4),
+        RET,
+    };
+    static rv_prof_t prof;
+    uint64_t in_g = 0, bad = 0;
+
+    reset();
+    load(0, p, sizeof(p) / 4);
+    rv_prof_init(&prof, 97);
+    core.prof = &prof;
+    rv_core_run(&core, 0, 100000);
+
+    for (uint32_t i = 0; i < prof.table_size; i++) {
+        const rv_prof_entry_t *e = &prof.table[i];
+        if (!e->hash || e->frames[0] < 0x40) continue;
+        in_g += e->count;
+        if (e->depth != 3 || e->frames[1] != 0x2C || e->frames[2] != 0x08) bad += e->count;
+    }
+    check("profiler samples", prof.samples > 0 && prof.samples == core.cycles / 97, 1);
+    check("profiler hot spot in g", in_g * 10 > prof.samples * 9, 1);
+    check("profiler call stacks", (uint32_t)bad, 0);
+    check("profiler stack unwound", prof.depth, 0);
+    rv_prof_free(&prof);
+}
+
+static void bench(void) {
+    // Tight loop: 5 instructions/iteration, 4M iterations
+    const uint32_t p[] = {
+        LUI(A0, 0x3D1),             // a0 = 0x3D1000 (4M)
+        ADDI(A1, ZERO, 0),
+        ADD(A1, A1, A0),            // loop:
+        ADDI(A0, A0, -1),
+        LW(T0, ZERO, 0x100),
+        SW(T0, ZERO, 0x104),
+        BNE(A0, ZERO, -16),
+        EBREAK,
+    };
+    reset();
+    load(0, p, sizeof(p) / 4);
+    clock_t t0 = clock();
+    rv_core_run(&core, 0, 0);
+    double s = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    printf("INFO: %llu instructions in %.3f s (%.1f MIPS host)\n",
+           (unsigned long long)core.instret, s, s > 0 ? core.instret / s / 1e6 : 0.0);
+}
+
+int main(void) {
+    test_alu_mul_div();
+    test_memory_and_rom();
+    test_cycle_model();
+    test_timer_irq();
+    test_uart_tx();
+    test_lockstep_retire();
+    test_profiler();
+    bench();
+
+    if (failures) {
+        printf("\n%d test(s) FAILED\n", failures);
+        return 1;
+    }
+    printf("\nAll rvsim self-tests passed\n");
+    return 0;
+}
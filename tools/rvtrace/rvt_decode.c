@@ -0,0 +1,222 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rvt_decode.c - Binary Instruction Trace Reader / Execution Reconstruction
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include <stdio.h>
+#include <string.h>
+
+#include "rvt_decode.h"
+
+const char *const rvt_class_names[RVT_CLS_COUNT] = {
+    "lui/auipc", "alu-imm", "alu-reg", "mul", "div", "load", "store",
+    "branch", "jal", "jalr", "irq-custom", "system", "unknown",
+};
+
+//==============================================================================
+// Record layer
+//==============================================================================
+
+int rvt_reader_init(rvt_reader_t *r, const uint8_t *buf, size_t len, char *err, size_t errlen) {
+    memset(r, 0, sizeof(*r));
+    if (len < RVT_HEADER_BYTES || memcmp(buf, "RVTR", 4) != 0) {
+        snprintf(err, errlen, "not an rvtrace file (bad magic)");
+        return -1;
+    }
+    if (buf[4] != RVT_VERSION) {
+        snprintf(err, errlen, "unsupported trace version %u", buf[4]);
+        return -1;
+    }
+    r->buf = buf;
+    r->len = len;
+    r->version = buf[4];
+    r->flags = buf[5];
+    r->start_pc = (uint32_t)buf[8] | ((uint32_t)buf[9] << 8) |
+                  ((uint32_t)buf[10] << 16) | ((uint32_t)buf[11] << 24);
+    r->prev[RVT_KIND_BRANCH] = r->start_pc;
+    r->pos = RVT_HEADER_BYTES;
+    return 0;
+}
+
+static int read_leb(rvt_reader_t *r, uint64_t *v) {
+    uint64_t x = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (r->pos >= r->len) return -1;
+        uint8_t b = r->buf[r->pos++];
+        x |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            *v = x;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int rvt_read_record(rvt_reader_t *r, int *kind, bool *irq, uint32_t *value) {
+    for (;;) {
+        if (r->end || r->pos >= r->len) {
+            r->end = true;
+            return 0;           // Missing end marker: simulation was killed
+        }
+        uint8_t tag = r->buf[r->pos++];
+        int k = tag & 3;
+        uint32_t small = tag >> 3;
+
+        if (k == RVT_KIND_CTRL) {
+            if (small == RVT_CTRL_END) {
+                r->end = true;
+                r->complete = true;
+                return 0;
+            }
+            uint64_t delta;
+            if (read_leb(r, &delta) < 0) return -1;
+            if (small == RVT_CTRL_CYCLES) r->cycles += delta;
+            continue;           // Unknown control records carry one LEB128
+        }
+
+        uint64_t zz = small;
+        if (small == 31 && read_leb(r, &zz) < 0) return -1;
+        uint32_t z = (uint32_t)zz;
+        uint32_t delta = (z >> 1) ^ (0u - (z & 1));
+
+        r->prev[k] += delta;
+        *kind = k;
+        *irq = (tag >> 2) & 1;
+        *value = r->prev[k];
+        r->records++;
+        return 1;
+    }
+}
+
+//==============================================================================
+// Instruction reconstruction
+//==============================================================================
+
+uint32_t rvt_fetch(const rv_soc_t *image, uint32_t pc) {
+    uint32_t a = pc & ~3u, w;
+    if (soc_is_boot(a)) w = soc_rd32(&image->boot[a - SOC_BOOT_BASE]);
+    else if (soc_is_sram(a)) w = soc_rd32(&image->sram[a]);
+    else return 0;
+    if (pc & 2) {
+        uint32_t hi = 0;
+        if (soc_is_boot(a + 4)) hi = soc_rd32(&image->boot[a + 4 - SOC_BOOT_BASE]);
+        else if (soc_is_sram(a + 4)) hi = soc_rd32(&image->sram[a + 4]);
+        w = (w >> 16) | (hi << 16);
+    }
+    return w;
+}
+
+rvt_class_t rvt_classify(uint32_t insn) {
+    if ((insn & 3) != 3) {
+        // RV32C: classify by quadrant/funct3 (COMPRESSED_ISA builds)
+        uint32_t q = insn & 3, f3 = (insn >> 13) & 7;
+        if (q == 0) return f3 == 2 ? RVT_CLS_LOAD : f3 == 6 ? RVT_CLS_STORE : RVT_CLS_ALU_IMM;
+        if (q == 1) {
+            if (f3 == 1 || f3 == 5) return RVT_CLS_JAL;
+            if (f3 == 6 || f3 == 7) return RVT_CLS_BRANCH;
+            if (f3 == 3) return RVT_CLS_LUI;
+            return (f3 == 4 && ((insn >> 10) & 3) == 3) ? RVT_CLS_ALU_REG : RVT_CLS_ALU_IMM;
+        }
+        if (f3 == 2) return RVT_CLS_LOAD;
+        if (f3 == 6) return RVT_CLS_STORE;
+        if (f3 == 4) {
+            if (((insn >> 2) & 31) == 0 && ((insn >> 7) & 31) != 0) return RVT_CLS_JALR;
+            if (insn == 0x9002) return RVT_CLS_SYSTEM;
+            return RVT_CLS_ALU_REG;
+        }
+        return RVT_CLS_ALU_IMM;
+    }
+
+    switch (insn & 0x7F) {
+    case 0x37: case 0x17: return RVT_CLS_LUI;
+    case 0x13: return RVT_CLS_ALU_IMM;
+    case 0x33:
+        if ((insn >> 25) == 1) return ((insn >> 12) & 4) ? RVT_CLS_DIV : RVT_CLS_MUL;
+        return RVT_CLS_ALU_REG;
+    case 0x03: return RVT_CLS_LOAD;
+    case 0x23: return RVT_CLS_STORE;
+    case 0x63: return RVT_CLS_BRANCH;
+    case 0x6F: return RVT_CLS_JAL;
+    case 0x67: return RVT_CLS_JALR;
+    case 0x0B: return RVT_CLS_IRQ;
+    case 0x73: case 0x0F: return RVT_CLS_SYSTEM;
+    default: return RVT_CLS_UNKNOWN;
+    }
+}
+
+static bool is_control(rvt_class_t cls, uint32_t insn) {
+    return cls == RVT_CLS_BRANCH || cls == RVT_CLS_JAL || cls == RVT_CLS_JALR ||
+           (cls == RVT_CLS_IRQ && (insn >> 25) == 2);      // retirq
+}
+
+void rvt_decoder_init(rvt_decoder_t *d, const uint8_t *buf, size_t len, const rv_soc_t *image) {
+    char err[64];
+    memset(d, 0, sizeof(*d));
+    d->image = image;
+    if (rvt_reader_init(&d->rd, buf, len, err, sizeof(err)) == 0) d->pc = d->rd.start_pc;
+    else d->rd.end = true;
+    d->next_leader = true;
+}
+
+int rvt_next(rvt_decoder_t *d, rvt_insn_t *out) {
+    int kind, rc;
+    bool irq;
+    uint32_t value;
+
+    for (;;) {
+        rc = rvt_read_record(&d->rd, &kind, &irq, &value);
+        if (rc <= 0) return rc;
+        if (kind != RVT_KIND_ADDR) break;
+        d->pending_addr = value;
+        d->have_addr = true;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->irq = irq;
+    if (irq && !d->in_irq) {
+        d->pc = RVT_PROGADDR_IRQ;
+        out->irq_entry = true;
+        d->next_leader = true;
+    }
+    d->in_irq = irq;
+
+    out->pc = d->pc;
+    out->insn = rvt_fetch(d->image, d->pc);
+    out->len = ((out->insn & 3) == 3) ? 4 : 2;
+    if (out->len == 2) out->insn &= 0xFFFF;
+    out->cls = rvt_classify(out->insn);
+    out->leader = d->next_leader;
+    out->value = value;
+
+    if (out->cls == RVT_CLS_LOAD || out->cls == RVT_CLS_STORE) {
+        if (d->have_addr) {
+            out->has_addr = true;
+            out->addr = d->pending_addr;
+        } else {
+            d->desync++;
+        }
+    } else if (d->have_addr) {
+        d->desync++;            // Address record for a non-memory instruction
+    }
+    d->have_addr = false;
+
+    bool control = is_control(out->cls, out->insn);
+    if (kind == RVT_KIND_BRANCH) {
+        out->taken = true;
+        if (!control) d->desync++;
+        d->pc = value;
+    } else {
+        d->pc += out->len;
+        if (out->cls == RVT_CLS_JAL || out->cls == RVT_CLS_JALR) d->desync++;
+    }
+    // retirq leaves IRQ context; its own record is already flagged 0
+    d->next_leader = control;
+    d->instret++;
+    return 1;
+}
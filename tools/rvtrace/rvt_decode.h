@@ -0,0 +1,127 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rvt_decode.h - Binary Instruction Trace Reader / Execution Reconstruction
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Reads the delta-encoded trace written by sim/trace_sink.sv and replays it
+// against the program image to recover the PC, instruction, memory address
+// and data of every retired instruction.
+//
+// PicoRV32 trace semantics (ENABLE_TRACE=1):
+//   - one value or branch record per retired instruction, emitted when the
+//     next instruction is fetched
+//   - branch records carry the new PC (taken branches, jal, jalr, retirq)
+//   - an address record precedes the retire record of every load/store
+//   - the irq flag follows irq_active, so the first record with the flag set
+//     after one without it is the instruction at PROGADDR_IRQ
+//
+//==============================================================================
+
+#ifndef RVT_DECODE_H
+#define RVT_DECODE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rv_soc.h"
+
+#define RVT_VERSION         1
+#define RVT_HEADER_BYTES    12
+#define RVT_PROGADDR_IRQ    0x00000010u
+
+// Record kinds (tag bits [1:0])
+enum {
+    RVT_KIND_VALUE = 0,
+    RVT_KIND_BRANCH,
+    RVT_KIND_ADDR,
+    RVT_KIND_CTRL,
+};
+
+// Control codes (tag bits [7:3] of RVT_KIND_CTRL)
+enum {
+    RVT_CTRL_END = 0,
+    RVT_CTRL_CYCLES,
+};
+
+typedef enum {
+    RVT_CLS_LUI = 0,            // lui / auipc
+    RVT_CLS_ALU_IMM,
+    RVT_CLS_ALU_REG,
+    RVT_CLS_MUL,
+    RVT_CLS_DIV,
+    RVT_CLS_LOAD,
+    RVT_CLS_STORE,
+    RVT_CLS_BRANCH,
+    RVT_CLS_JAL,
+    RVT_CLS_JALR,
+    RVT_CLS_IRQ,                // PicoRV32 custom-0 (getq/setq/retirq/maskirq/...)
+    RVT_CLS_SYSTEM,             // ecall/ebreak/fence
+    RVT_CLS_UNKNOWN,
+    RVT_CLS_COUNT
+} rvt_class_t;
+
+extern const char *const rvt_class_names[RVT_CLS_COUNT];
+
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+    size_t pos;
+    uint8_t version;
+    uint8_t flags;
+    uint32_t start_pc;
+    uint32_t prev[3];           // Last value per record kind (delta base)
+    uint64_t cycles;            // Sum of cycle stamps so far
+    uint64_t records;
+    bool end;
+    bool complete;              // End record seen
+} rvt_reader_t;
+
+typedef struct {
+    uint32_t pc;
+    uint32_t insn;
+    uint32_t len;               // 2 or 4
+    rvt_class_t cls;
+    bool taken;                 // Branch record (control transfer happened)
+    bool irq;                   // Retired in IRQ context
+    bool irq_entry;             // First instruction of an IRQ handler
+    bool leader;                // First instruction of a basic block
+    bool has_addr;
+    uint32_t addr;              // Load/store address
+    uint32_t value;             // Result / load data / store data / target
+} rvt_insn_t;
+
+typedef struct {
+    rvt_reader_t rd;
+    const rv_soc_t *image;
+    uint32_t pc;
+    bool in_irq;
+    bool next_leader;
+    bool have_addr;
+    uint32_t pending_addr;
+    uint64_t instret;
+    uint64_t desync;            // Records that did not match the image
+} rvt_decoder_t;
+
+// Parse the header. Returns 0, or -1 with a message in err.
+int rvt_reader_init(rvt_reader_t *r, const uint8_t *buf, size_t len, char *err, size_t errlen);
+
+// Next raw record. Returns 1 with kind/irq/value set, 0 at end of trace,
+// -1 on a truncated record. Cycle stamps are folded into r->cycles.
+int rvt_read_record(rvt_reader_t *r, int *kind, bool *irq, uint32_t *value);
+
+void rvt_decoder_init(rvt_decoder_t *d, const uint8_t *buf, size_t len, const rv_soc_t *image);
+
+// Next retired instruction. Returns 1, 0 at end of trace, -1 on error.
+int rvt_next(rvt_decoder_t *d, rvt_insn_t *out);
+
+rvt_class_t rvt_classify(uint32_t insn);
+uint32_t rvt_fetch(const rv_soc_t *image, uint32_t pc);
+
+#endif // RVT_DECODE_H
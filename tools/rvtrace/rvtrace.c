@@ -0,0 +1,402 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rvtrace.c - Binary Instruction Trace Decoder (command line front end)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+//
+// Reconstructs the execution recorded by sim/trace_sink.sv (Verilator
+// 'sim_soc --trace FILE' or 'TRACE=FILE ./run_bootloader_test.sh') and
+// reports the instruction mix, branch behaviour, memory traffic and the
+// hottest basic blocks. Symbols come from the ELF images given with --image.
+//
+//==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "rvt_decode.h"
+
+#ifndef RVTRACE_ROM_DEFAULT
+#define RVTRACE_ROM_DEFAULT "../../bootloader/bootloader.hex"
+#endif
+
+#define TOP_DEFAULT 20
+
+//==============================================================================
+// ELF symbol table (functions and labels, for annotating block leaders)
+//==============================================================================
+
+typedef struct {
+    uint32_t addr;
+    char *name;
+} sym_t;
+
+static sym_t *g_syms;
+static size_t g_nsyms, g_cap_syms;
+
+static int sym_cmp(const void *a, const void *b) {
+    const sym_t *x = a, *y = b;
+    return (x->addr > y->addr) - (x->addr < y->addr);
+}
+
+static void load_symbols(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *b = malloc((size_t)len);
+    if (!b || fread(b, 1, (size_t)len, f) != (size_t)len || len < 52 ||
+        memcmp(b, "\177ELF", 4) != 0 || b[4] != 1) {
+        free(b);
+        fclose(f);
+        return;                 // Not ELF32: hex/bin images carry no symbols
+    }
+    fclose(f);
+
+    uint32_t shoff = soc_rd32(&b[32]);
+    uint32_t shentsize = b[46] | (b[47] << 8);
+    uint32_t shnum = b[48] | (b[49] << 8);
+
+    for (uint32_t i = 0; i < shnum; i++) {
+        const uint8_t *sh = &b[shoff + i * shentsize];
+        if ((long)(shoff + (i + 1) * shentsize) > len || soc_rd32(&sh[4]) != 2) continue;
+        uint32_t off = soc_rd32(&sh[16]), size = soc_rd32(&sh[20]);
+        uint32_t link = soc_rd32(&sh[24]);
+        if (link >= shnum || (long)(off + size) > len) continue;
+        const uint8_t *strsh = &b[shoff + link * shentsize];
+        uint32_t stroff = soc_rd32(&strsh[16]), strsize = soc_rd32(&strsh[20]);
+
+        for (uint32_t s = 16; s + 16 <= size; s += 16) {
+            const uint8_t *st = &b[off + s];
+            uint32_t name = soc_rd32(&st[0]);
+            uint32_t value = soc_rd32(&st[4]);
+            uint8_t type = st[12] & 0xF;
+            uint16_t shndx = st[14] | (st[15] << 8);
+            if (type > 2 || shndx == 0 || shndx >= 0xFF00 || name == 0 || name >= strsize) continue;
+            const char *n = (const char *)&b[stroff + name];
+            if (n[0] == '$' || n[0] == '.') continue;       // Mapping/local labels
+            if (g_nsyms == g_cap_syms) {
+                g_cap_syms = g_cap_syms ? g_cap_syms * 2 : 256;
+                g_syms = realloc(g_syms, g_cap_syms * sizeof(sym_t));
+            }
+            g_syms[g_nsyms].addr = value;
+            g_syms[g_nsyms].name = strdup(n);
+            g_nsyms++;
+        }
+    }
+    free(b);
+    qsort(g_syms, g_nsyms, sizeof(sym_t), sym_cmp);
+}
+
+static const char *symbolize(uint32_t pc, char *buf, size_t len) {
+    size_t lo = 0, hi = g_nsyms;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (g_syms[mid].addr <= pc) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == 0) return "";
+    const sym_t *s = &g_syms[lo - 1];
+    if (pc == s->addr) snprintf(buf, len, "%s", s->name);
+    else snprintf(buf, len, "%s+0x%x", s->name, pc - s->addr);
+    return buf;
+}
+
+//==============================================================================
+// Basic block table (open addressing, keyed by leader PC)
+//==============================================================================
+
+typedef struct {
+    uint32_t leader;
+    uint32_t used;
+    uint64_t hits;
+    uint64_t insns;
+} block_t;
+
+static block_t *g_blocks;
+static size_t g_nblocks, g_cap_blocks;
+
+static block_t *block_get(uint32_t leader) {
+    if (2 * (g_nblocks + 1) > g_cap_blocks) {
+        size_t old_cap = g_cap_blocks;
+        block_t *old = g_blocks;
+        g_cap_blocks = old_cap ? old_cap * 2 : 4096;
+        g_blocks = calloc(g_cap_blocks, sizeof(block_t));
+        g_nblocks = 0;
+        for (size_t i = 0; i < old_cap; i++) {
+            if (!old[i].used) continue;
+            block_t *b = block_get(old[i].leader);
+            *b = old[i];
+        }
+        free(old);
+    }
+    size_t mask = g_cap_blocks - 1;
+    size_t i = (leader * 2654435761u) & mask;
+    while (g_blocks[i].used && g_blocks[i].leader != leader) i = (i + 1) & mask;
+    if (!g_blocks[i].used) {
+        g_blocks[i].used = 1;
+        g_blocks[i].leader = leader;
+        g_nblocks++;
+    }
+    return &g_blocks[i];
+}
+
+static int block_cmp(const void *a, const void *b) {
+    const block_t *x = a, *y = b;
+    if (x->insns != y->insns) return x->insns < y->insns ? 1 : -1;
+    return (x->leader > y->leader) - (x->leader < y->leader);
+}
+
+//==============================================================================
+// Statistics
+//==============================================================================
+
+enum { REG_SRAM = 0, REG_ROM, REG_MMIO, REG_OTHER, REG_COUNT };
+static const char *const region_names[REG_COUNT] = { "SRAM", "ROM", "MMIO", "other" };
+
+typedef struct {
+    uint64_t instret;
+    uint64_t cls[RVT_CLS_COUNT];
+    uint64_t taken;             // Conditional branches taken
+    uint64_t loads[REG_COUNT];
+    uint64_t stores[REG_COUNT];
+    uint64_t irq_entries;
+    uint64_t irq_insns;
+} stats_t;
+
+static int region_of(uint32_t addr) {
+    if (soc_is_boot(addr)) return REG_ROM;
+    if (soc_is_sram(addr)) return REG_SRAM;
+    if (soc_is_mmio(addr)) return REG_MMIO;
+    return REG_OTHER;
+}
+
+static double pct(uint64_t n, uint64_t d) {
+    return d ? 100.0 * (double)n / (double)d : 0.0;
+}
+
+static void dump_insn(const rvt_insn_t *in) {
+    char sym[96];
+    const char *s = symbolize(in->pc, sym, sizeof(sym));
+    printf("%c %08x  %0*x  %-10s", in->irq ? 'I' : ' ', in->pc,
+           in->len == 2 ? 4 : 8, in->insn, rvt_class_names[in->cls]);
+    if (in->has_addr) printf(" [%08x]", in->addr);
+    if (in->taken) printf(" -> %08x", in->value);
+    else printf(" = %08x", in->value);
+    if (*s) printf("  <%s>", s);
+    printf("\n");
+}
+
+static void report(const char *path, size_t bytes, const rvt_decoder_t *d,
+                   const stats_t *st, int top) {
+    uint64_t n = st->instret;
+    uint64_t branches = st->cls[RVT_CLS_BRANCH];
+    char sym[96];
+
+    printf("Trace:        %s (%zu bytes, %llu records, %.2f bytes/insn)\n", path, bytes,
+           (unsigned long long)d->rd.records, n ? (double)bytes / (double)n : 0.0);
+    printf("Start PC:     0x%08x\n", d->rd.start_pc);
+    printf("Instructions: %llu\n", (unsigned long long)n);
+    if (d->rd.cycles)
+        printf("Cycles:       %llu (CPI %.2f)\n", (unsigned long long)d->rd.cycles,
+               n ? (double)d->rd.cycles / (double)n : 0.0);
+    printf("IRQ entries:  %llu (%llu instructions in handlers, %.1f%%)\n",
+           (unsigned long long)st->irq_entries, (unsigned long long)st->irq_insns,
+           pct(st->irq_insns, n));
+    if (d->desync)
+        printf("Desync:       %llu records did not match the image (wrong --image?)\n",
+               (unsigned long long)d->desync);
+
+    printf("\nInstruction mix:\n");
+    for (int c = 0; c < RVT_CLS_COUNT; c++) {
+        if (!st->cls[c]) continue;
+        printf("  %-12s %12llu  %5.1f%%\n", rvt_class_names[c],
+               (unsigned long long)st->cls[c], pct(st->cls[c], n));
+    }
+    printf("\nBranches:     %llu taken, %llu not taken (%.1f%% taken)\n",
+           (unsigned long long)st->taken, (unsigned long long)(branches - st->taken),
+           pct(st->taken, branches));
+
+    uint64_t mem = st->cls[RVT_CLS_LOAD] + st->cls[RVT_CLS_STORE];
+    if (mem) printf("\nMemory:       %10s %10s\n", "loads", "stores");
+    for (int r = 0; r < REG_COUNT && mem; r++) {
+        if (!st->loads[r] && !st->stores[r]) continue;
+        printf("  %-11s %10llu %10llu\n", region_names[r],
+               (unsigned long long)st->loads[r], (unsigned long long)st->stores[r]);
+    }
+
+    // Compact the hash table in place and sort by instructions executed
+    size_t nb = 0;
+    for (size_t i = 0; i < g_cap_blocks; i++)
+        if (g_blocks[i].used) g_blocks[nb++] = g_blocks[i];
+    qsort(g_blocks, nb, sizeof(block_t), block_cmp);
+    g_nblocks = nb;
+
+    printf("\nHot basic blocks (%zu distinct):\n", nb);
+    printf("  %-10s %10s %12s %6s %7s  %s\n", "leader", "hits", "insns", "len", "%insn", "symbol");
+    for (size_t i = 0; i < nb && (int)i < top; i++) {
+        const block_t *b = &g_blocks[i];
+        printf("  0x%08x %10llu %12llu %6.1f %6.1f%%  %s\n", b->leader,
+               (unsigned long long)b->hits, (unsigned long long)b->insns,
+               (double)b->insns / (double)b->hits, pct(b->insns, n),
+               symbolize(b->leader, sym, sizeof(sym)));
+    }
+}
+
+static int write_mix_csv(const char *path, const stats_t *st, uint64_t cycles) {
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+    fprintf(f, "class,count,percent\n");
+    for (int c = 0; c < RVT_CLS_COUNT; c++)
+        fprintf(f, "%s,%llu,%.3f\n", rvt_class_names[c],
+                (unsigned long long)st->cls[c], pct(st->cls[c], st->instret));
+    fprintf(f, "branch-taken,%llu,%.3f\n", (unsigned long long)st->taken,
+            pct(st->taken, st->instret));
+    fprintf(f, "total,%llu,100.000\n", (unsigned long long)st->instret);
+    if (cycles) fprintf(f, "cycles,%llu,\n", (unsigned long long)cycles);
+    return fclose(f);
+}
+
+static int write_blocks_csv(const char *path) {
+    FILE *f = fopen(path, "w");
+    char sym[96];
+    if (!f) return -1;
+    fprintf(f, "leader,hits,instructions,symbol\n");
+    for (size_t i = 0; i < g_nblocks; i++)
+        fprintf(f, "0x%08x,%llu,%llu,%s\n", g_blocks[i].leader,
+                (unsigned long long)g_blocks[i].hits, (unsigned long long)g_blocks[i].insns,
+                symbolize(g_blocks[i].leader, sym, sizeof(sym)));
+    return fclose(f);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+        "Usage: %s [options] trace.rvt\n"
+        "\n"
+        "Options:\n"
+        "  --image FILE       Program image (ELF/hex/bin) loaded into SRAM; ELF\n"
+        "                     symbols annotate the report (repeatable)\n"
+        "  --rom FILE         Bootloader ROM image (default %s)\n"
+        "  --dump N           Print the first N reconstructed instructions\n"
+        "  --top N            Basic blocks to list (default %d)\n"
+        "  --mix-csv FILE     Write the instruction mix as CSV\n"
+        "  --blocks-csv FILE  Write all basic blocks as CSV\n"
+        "  -h, --help         Show this help\n",
+        prog, RVTRACE_ROM_DEFAULT, TOP_DEFAULT);
+}
+
+int main(int argc, char **argv) {
+    const char *trace = NULL;
+    const char *rom = RVTRACE_ROM_DEFAULT;
+    bool rom_given = false;
+    const char *images[16];
+    int n_images = 0;
+    uint64_t dump = 0;
+    int top = TOP_DEFAULT;
+    const char *mix_csv = NULL, *blocks_csv = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        bool more = (i + 1 < argc);
+        if (!strcmp(a, "-h") || !strcmp(a, "--help")) { usage(argv[0]); return 0; }
+        else if (!strcmp(a, "--image") && more && n_images < 16) images[n_images++] = argv[++i];
+        else if (!strcmp(a, "--rom") && more)           { rom = argv[++i]; rom_given = true; }
+        else if (!strcmp(a, "--dump") && more)          dump = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(a, "--top") && more)           top = atoi(argv[++i]);
+        else if (!strcmp(a, "--mix-csv") && more)       mix_csv = argv[++i];
+        else if (!strcmp(a, "--blocks-csv") && more)    blocks_csv = argv[++i];
+        else if (a[0] != '-' && !trace)                 trace = a;
+        else { usage(argv[0]); return 1; }
+    }
+    if (!trace) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    static rv_soc_t image;              // 520KB, keep it off the stack
+    soc_init(&image);
+    if (rom_given || access(rom, R_OK) == 0) {
+        if (soc_load_rom(&image, rom) != 0) return 1;
+    }
+    for (int i = 0; i < n_images; i++) {
+        if (soc_load_image(&image, images[i], NULL) != 0) return 1;
+        load_symbols(images[i]);
+    }
+
+    FILE *f = fopen(trace, "rb");
+    if (!f) {
+        fprintf(stderr, "rvtrace: cannot open %s\n", trace);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *buf = malloc(len > 0 ? (size_t)len : 1);
+    if (!buf || fread(buf, 1, (size_t)len, f) != (size_t)len) {
+        fprintf(stderr, "rvtrace: cannot read %s\n", trace);
+        fclose(f);
+        return 1;
+    }
+    fclose(f);
+
+    char err[80];
+    rvt_reader_t probe;
+    if (rvt_reader_init(&probe, buf, (size_t)len, err, sizeof(err)) != 0) {
+        fprintf(stderr, "rvtrace: %s: %s\n", trace, err);
+        return 1;
+    }
+
+    rvt_decoder_t d;
+    rvt_insn_t in;
+    stats_t st;
+    uint32_t blk_pc = 0;
+    uint64_t blk_len = 0;
+    int rc;
+
+    memset(&st, 0, sizeof(st));
+    rvt_decoder_init(&d, buf, (size_t)len, &image);
+    while ((rc = rvt_next(&d, &in)) > 0) {
+        if (st.instret < dump) dump_insn(&in);
+        st.instret++;
+        st.cls[in.cls]++;
+        if (in.cls == RVT_CLS_BRANCH && in.taken) st.taken++;
+        if (in.has_addr) {
+            if (in.cls == RVT_CLS_LOAD) st.loads[region_of(in.addr)]++;
+            else st.stores[region_of(in.addr)]++;
+        }
+        if (in.irq_entry) st.irq_entries++;
+        if (in.irq) st.irq_insns++;
+        if (in.leader) {
+            if (blk_len) block_get(blk_pc)->insns += blk_len;
+            blk_pc = in.pc;
+            blk_len = 0;
+            block_get(blk_pc)->hits++;
+        }
+        blk_len++;
+    }
+    if (blk_len) block_get(blk_pc)->insns += blk_len;
+    if (rc < 0) fprintf(stderr, "rvtrace: %s: truncated record at offset %zu\n", trace, d.rd.pos);
+    else if (!d.rd.complete) fprintf(stderr, "rvtrace: warning: no end marker (simulation killed?)\n");
+
+    if (dump) printf("\n");
+    report(trace, (size_t)len, &d, &st, top);
+
+    if (mix_csv && write_mix_csv(mix_csv, &st, d.rd.cycles) != 0) {
+        fprintf(stderr, "rvtrace: cannot write %s\n", mix_csv);
+        return 1;
+    }
+    if (blocks_csv && write_blocks_csv(blocks_csv) != 0) {
+        fprintf(stderr, "rvtrace: cannot write %s\n", blocks_csv);
+        return 1;
+    }
+    free(buf);
+    return 0;
+}
@@ -0,0 +1,293 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// rvtrace_selftest.c - Trace Decoder Self-Test (encoder mirrors trace_sink.sv)
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rvt_decode.h"
+
+//==============================================================================
+// Minimal instruction encoder
+//==============================================================================
+
+enum { ZERO, RA, SP, GP, TP, T0, T1, T2 };
+
+#define R(f7, rs2, rs1, f3, rd, op) (((f7) << 25) | ((rs2) << 20) | ((rs1) << 15) | ((f3) << 12) | ((rd) << 7) | (op))
+#define I(imm, rs1, f3, rd, op)     ((((uint32_t)(imm) & 0xFFF) << 20) | ((rs1) << 15) | ((f3) << 12) | ((rd) << 7) | (op))
+#define S(imm, rs2, rs1, f3)        (((((uint32_t)(imm) >> 5) & 0x7F) << 25) | ((rs2) << 20) | ((rs1) << 15) | ((f3) << 12) | (((uint32_t)(imm) & 0x1F) << 7) | 0x23)
+
+static uint32_t B(int32_t off, int rs2, int rs1, int f3) {
+    uint32_t i = (uint32_t)off;
+    return (((i >> 12) & 1) << 31) | (((i >> 5) & 0x3F) << 25) | ((uint32_t)rs2 << 20) | ((uint32_t)rs1 << 15) |
+           ((uint32_t)f3 << 12) | (((i >> 1) & 0xF) << 8) | (((i >> 11) & 1) << 7) | 0x63;
+}
+
+static uint32_t J(int32_t off, int rd) {
+    uint32_t i = (uint32_t)off;
+    return (((i >> 20) & 1) << 31) | (((i >> 1) & 0x3FF) << 21) | (((i >> 11) & 1) << 20) |
+           (((i >> 12) & 0xFF) << 12) | ((uint32_t)rd << 7) | 0x6F;
+}
+
+#define ADDI(rd, rs1, imm)  I(imm, rs1, 0, rd, 0x13)
+#define LUI(rd, imm20)      ((((uint32_t)(imm20)) << 12) | ((rd) << 7) | 0x37)
+#define MUL(rd, a, b)       R(1, b, a, 0, rd, 0x33)
+#define DIV(rd, a, b)       R(1, b, a, 4, rd, 0x33)
+#define LW(rd, rs1, imm)    I(imm, rs1, 2, rd, 0x03)
+#define SW(rs2, rs1, imm)   S(imm, rs2, rs1, 2)
+#define BNE(a, b, off)      B(off, b, a, 1)
+#define RETIRQ              R(2, 0, 0, 0, 0, 0x0B)
+
+//==============================================================================
+// Trace encoder (same byte stream as sim/trace_sink.sv)
+//==============================================================================
+
+typedef struct {
+    uint8_t buf[4096];
+    size_t len;
+    uint32_t prev[3];
+    uint64_t cycle, stamp_cycle;
+    int since_stamp;
+} enc_t;
+
+static void put_byte(enc_t *e, uint8_t b) {
+    e->buf[e->len++] = b;
+}
+
+static void put_leb(enc_t *e, uint64_t v) {
+    while (v >= 128) {
+        put_byte(e, 0x80 | (v & 0x7F));
+        v >>= 7;
+    }
+    put_byte(e, (uint8_t)v);
+}
+
+static void enc_init(enc_t *e, uint32_t start_pc) {
+    memset(e, 0, sizeof(*e));
+    memcpy(e->buf, "RVTR\x01\x01\x00\x00", 8);
+    for (int i = 0; i < 4; i++) e->buf[8 + i] = (uint8_t)(start_pc >> (8 * i));
+    e->len = RVT_HEADER_BYTES;
+    e->prev[RVT_KIND_BRANCH] = start_pc;
+}
+
+static void enc_record(enc_t *e, int kind, int irq, uint32_t value, int stamp_interval) {
+    uint32_t delta = value - e->prev[kind];
+    uint32_t zz = (delta << 1) ^ (0u - (delta >> 31));
+    e->prev[kind] = value;
+    e->cycle += 5;
+    if (zz < 31) {
+        put_byte(e, (uint8_t)((zz << 3) | (irq << 2) | kind));
+    } else {
+        put_byte(e, (uint8_t)((31 << 3) | (irq << 2) | kind));
+        put_leb(e, zz);
+    }
+    if (kind != RVT_KIND_ADDR && ++e->since_stamp == stamp_interval) {
+        put_byte(e, (RVT_CTRL_CYCLES << 3) | RVT_KIND_CTRL);
+        put_leb(e, e->cycle - e->stamp_cycle);
+        e->stamp_cycle = e->cycle;
+        e->since_stamp = 0;
+    }
+}
+
+static void enc_finish(enc_t *e) {
+    put_byte(e, (RVT_CTRL_CYCLES << 3) | RVT_KIND_CTRL);
+    put_leb(e, e->cycle - e->stamp_cycle);
+    put_byte(e, (RVT_CTRL_END << 3) | RVT_KIND_CTRL);
+}
+
+#define VAL(v)      enc_record(&e, RVT_KIND_VALUE, irq, (v), 4)
+#define BR(t)       enc_record(&e, RVT_KIND_BRANCH, irq, (t), 4)
+#define ADDR(a)     enc_record(&e, RVT_KIND_ADDR, irq, (a), 4)
+
+static rv_soc_t image;
+static int failures;
+
+static void check(const char *name, uint32_t got, uint32_t want) {
+    if (got != want) {
+        printf("FAIL: %s: got 0x%08x want 0x%08x\n", name, got, want);
+        failures++;
+    } else {
+        printf("PASS: %s\n", name);
+    }
+}
+
+static void load(uint32_t addr, const uint32_t *prog, int n) {
+    for (int i = 0; i < n; i++) soc_wr32(&image.sram[addr + 4 * i], prog[i]);
+}
+
+//==============================================================================
+// Tests
+//==============================================================================
+
+static void test_varint_deltas(void) {
+    // Raw record layer: small, negative, and full-width deltas
+    static const uint32_t vals[] = { 0, 7, 3, 0x80000000u, 0x7FFFFFFFu, 0xFFFFFFFFu, 15, 16 };
+    enc_t e;
+    rvt_reader_t r;
+    char err[64];
+    int kind, ok = 1;
+    bool irq;
+    uint32_t v;
+
+    enc_init(&e, 0);
+    for (unsigned i = 0; i < sizeof(vals) / 4; i++)
+        enc_record(&e, RVT_KIND_VALUE, (int)(i & 1), vals[i], 1000);
+    enc_finish(&e);
+
+    check("header parses", (uint32_t)rvt_reader_init(&r, e.buf, e.len, err, sizeof(err)), 0);
+    for (unsigned i = 0; i < sizeof(vals) / 4; i++) {
+        if (rvt_read_record(&r, &kind, &irq, &v) != 1 || kind != RVT_KIND_VALUE ||
+            v != vals[i] || irq != (bool)(i & 1))
+            ok = 0;
+    }
+    check("zigzag/LEB128 deltas round-trip", (uint32_t)ok, 1);
+    check("end marker", (uint32_t)rvt_read_record(&r, &kind, &irq, &v), 0);
+    check("end marker complete", r.complete, 1);
+    check("cycles from stamps", (uint32_t)r.cycles, 5 * 8);
+
+    e.buf[0] = 'X';
+    check("bad magic rejected", (uint32_t)rvt_reader_init(&r, e.buf, e.len, err, sizeof(err)), (uint32_t)-1);
+}
+
+static void test_reconstruction(void) {
+    // 0x100: t0 = 3; t1 = 0x1000
+    // loop:  sw t0,0(t1); lw t2,0(t1); mul t2,t2,t2; addi t0,t0,-1; bne t0,zero,loop
+    //        div t2,t2,t0; jal zero,. (stop)
+    // 0x010: addi tp,tp,1; retirq     (IRQ handler at PROGADDR_IRQ)
+    const uint32_t main_prog[] = {
+        ADDI(T0, ZERO, 3),
+        LUI(T1, 1),
+        SW(T0, T1, 0),
+        LW(T2, T1, 0),
+        MUL(T2, T2, T2),
+        ADDI(T0, T0, -1),
+        BNE(T0, ZERO, -16),
+        DIV(T2, T2, T0),
+        J(0, ZERO),
+    };
+    static const uint32_t handler[] = { ADDI(TP, TP, 1), RETIRQ };
+    enc_t e;
+    int irq = 0;
+
+    soc_init(&image);
+    load(0x100, main_prog, sizeof(main_prog) / 4);
+    load(0x10, handler, 2);
+
+    enc_init(&e, 0x100);
+    VAL(3);
+    VAL(0x1000);
+    for (uint32_t t0 = 3; t0 > 0; t0--) {
+        ADDR(0x1000); VAL(t0);              // sw: store data
+        ADDR(0x1000); VAL(t0);              // lw: loaded value
+        VAL(t0 * t0);
+        if (t0 == 2) {                      // Interrupt taken after the mul
+            irq = 1;
+            VAL(1);
+            irq = 0;
+            BR(0x114);                      // retirq back to the addi
+        }
+        VAL(t0 - 1);
+        if (t0 > 1) BR(0x108);
+        else VAL(0);                        // Not taken
+    }
+    VAL(0xFFFFFFFFu);
+    BR(0x120);
+    enc_finish(&e);
+
+    rvt_decoder_t d;
+    rvt_insn_t in;
+    uint64_t cls[RVT_CLS_COUNT] = { 0 };
+    uint32_t leaders = 0, irq_entries = 0, irq_insns = 0, taken = 0, addr_ok = 1, path_ok = 1;
+    uint32_t n = 0;
+    static const uint32_t expect_pc[] = {
+        0x100, 0x104, 0x108, 0x10C, 0x110, 0x114, 0x118,
+        0x108, 0x10C, 0x110, 0x010, 0x014, 0x114, 0x118,
+        0x108, 0x10C, 0x110, 0x114, 0x118, 0x11C, 0x120,
+    };
+
+    rvt_decoder_init(&d, e.buf, e.len, &image);
+    while (rvt_next(&d, &in) > 0) {
+        if (n < sizeof(expect_pc) / 4 && in.pc != expect_pc[n]) path_ok = 0;
+        n++;
+        cls[in.cls]++;
+        leaders += in.leader;
+        irq_entries += in.irq_entry;
+        irq_insns += in.irq;
+        taken += in.cls == RVT_CLS_BRANCH && in.taken;
+        if ((in.cls == RVT_CLS_LOAD || in.cls == RVT_CLS_STORE) && (!in.has_addr || in.addr != 0x1000))
+            addr_ok = 0;
+    }
+
+    check("instructions reconstructed", n, sizeof(expect_pc) / 4);
+    check("PC path matches", path_ok, 1);
+    check("no desync", (uint32_t)d.desync, 0);
+    check("stores", (uint32_t)cls[RVT_CLS_STORE], 3);
+    check("loads", (uint32_t)cls[RVT_CLS_LOAD], 3);
+    check("mul/div", (uint32_t)(cls[RVT_CLS_MUL] << 8 | cls[RVT_CLS_DIV]), 0x301);
+    check("branches taken", taken, 2);
+    check("memory addresses attached", addr_ok, 1);
+    check("IRQ entries", irq_entries, 1);
+    check("IRQ handler instructions", irq_insns, 1);
+    // Leaders: 0x100, loop x2 after bne, handler, resume after retirq,
+    // fall-through after the final bne
+    check("basic block leaders", leaders, 6);
+    check("cycle total", (uint32_t)d.rd.cycles, (uint32_t)e.cycle);
+}
+
+static void test_desync_detection(void) {
+    // A branch record on a straight-line instruction means a wrong image
+    static const uint32_t prog[] = { ADDI(T0, ZERO, 1), ADDI(T0, T0, 1) };
+    enc_t e;
+    int irq = 0;
+    rvt_decoder_t d;
+    rvt_insn_t in;
+
+    soc_init(&image);
+    load(0, prog, 2);
+    load(0x40, prog, 2);
+    enc_init(&e, 0);
+    BR(0x40);
+    VAL(2);
+    enc_finish(&e);
+
+    rvt_decoder_init(&d, e.buf, e.len, &image);
+    while (rvt_next(&d, &in) > 0) { }
+    check("desync counted", (uint32_t)d.desync, 1);
+    check("resync to branch target", d.pc, 0x44);
+}
+
+static void test_truncated(void) {
+    enc_t e;
+    int irq = 0;
+    rvt_decoder_t d;
+    rvt_insn_t in;
+
+    soc_init(&image);
+    enc_init(&e, 0);
+    VAL(0x12345678);                        // Needs a LEB128 continuation
+    e.len -= 2;                             // Cut it off mid-varint
+    rvt_decoder_init(&d, e.buf, e.len, &image);
+    check("truncated record reported", (uint32_t)rvt_next(&d, &in), (uint32_t)-1);
+}
+
+int main(void) {
+    test_varint_deltas();
+    test_reconstruction();
+    test_desync_detection();
+    test_truncated();
+
+    if (failures) {
+        printf("\n%d test(s) FAILED\n", failures);
+        return 1;
+    }
+    printf("\nAll rvtrace self-tests passed\n");
+    return 0;
+}
@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+#===============================================================================
+# Olimex iCE40HX8K-EVB RISC-V Platform
+# trace2json.py - lib/trace UART Capture to Chrome Trace-Event JSON
+#
+# Copyright (c) October 2025 Michael Wolak
+# Email: mikewolak@gmail.com, mike@epromfoundry.com
+#
+# NOT FOR COMMERCIAL USE
+# Educational and research purposes only
+#===============================================================================
+#
+# Reads a raw UART capture containing one or more trace_dump() outputs
+# (binary frames between "@@TRACE BEGIN" / "@@TRACE END", any other
+# firmware output around them) and writes Chrome trace-event JSON for
+# chrome://tracing or ui.perfetto.dev. The frame format is described at the
+# top of lib/trace/trace.c; frames with a bad CRC are skipped and counted.
+#
+# Tracks: tid 0 = main code, tid 1 = interrupt handlers. Timestamps are in
+# microseconds from the first event of the capture (dumps follow each other
+# on one timeline). An end without its begin (overwritten in the ring) is
+# dropped so the viewer does not mis-nest the rest of the track.
+#
+# Usage:
+#   trace2json.py capture.bin -o trace.json
+#   trace2json.py capture.bin --text            # one event per line
+#===============================================================================
+
+import argparse
+import json
+import struct
+import sys
+import zlib
+
+SYNC = b'\xA5\x5A'
+TYPES = ('B', 'E', 'i', 'C')
+TRACKS = ('main', 'irq')
+
+
+class Dump:
+    def __init__(self):
+        self.tick_hz = 0
+        self.expected = 0
+        self.dropped = 0
+        self.events = []        # (ticks, track, type, name, arg or None)
+        self.complete = False
+
+
+def read_varint(data, pos):
+    value = shift = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return value, pos
+
+
+def frames(data):
+    """(type, payload) of every frame with a valid CRC, and the bad count"""
+    found = []
+    pos = 0
+    bad = 0
+    while True:
+        pos = data.find(SYNC, pos)
+        if pos < 0 or pos + 5 > len(data):
+            break
+        ftype = data[pos + 2]
+        (length,) = struct.unpack_from('<H', data, pos + 3)
+        end = pos + 5 + length + 4
+        if end > len(data):
+            bad += 1
+            pos += 1
+            continue
+        payload = data[pos + 5:pos + 5 + length]
+        (crc,) = struct.unpack_from('<I', data, pos + 5 + length)
+        if zlib.crc32(data[pos + 2:pos + 5 + length]) != crc:
+            bad += 1
+            pos += 1
+            continue
+        found.append((chr(ftype), payload))
+        pos = end
+    return found, bad
+
+
+def parse(data):
+    dumps = []
+    dump = None
+    names = {}
+    ticks = 0
+
+    found, bad = frames(data)
+    for ftype, p in found:
+        if ftype == 'H':
+            version = p[0]
+            if version != 1:
+                raise ValueError(f"unsupported trace version {version}")
+            dump = Dump()
+            dump.tick_hz, dump.expected, dump.dropped = struct.unpack_from('<III', p, 1)
+            dumps.append(dump)
+            names = {}
+            ticks = 0
+        elif dump is None:
+            continue
+        elif ftype == 'N':
+            ident, pos = read_varint(p, 0)
+            names[ident] = p[pos:].decode('utf-8', 'replace')
+        elif ftype == 'E':
+            pos = 0
+            while pos < len(p):
+                flags = p[pos]
+                ident, pos = read_varint(p, pos + 1)
+                dt, pos = read_varint(p, pos)
+                arg = None
+                if flags & 8:
+                    zz, pos = read_varint(p, pos)
+                    arg = (zz >> 1) ^ -(zz & 1)
+                ticks += dt
+                dump.events.append((ticks, (flags >> 2) & 1, TYPES[flags & 3],
+                                    names.get(ident, f"#{ident}"), arg))
+        elif ftype == 'Z':
+            (count,) = struct.unpack_from('<I', p, 0)
+            dump.complete = count == len(dump.events)
+    return dumps, bad
+
+
+def to_chrome(dumps):
+    out = [{"name": "thread_name", "ph": "M", "pid": 1, "tid": tid,
+            "args": {"name": name}} for tid, name in enumerate(TRACKS)]
+    offset = 0.0
+    dropped_ends = 0
+
+    for dump in dumps:
+        if not dump.events or not dump.tick_hz:
+            continue
+        scale = 1e6 / dump.tick_hz
+        base = dump.events[0][0]
+        depth = [0, 0]
+        last = offset
+        for ticks, track, ph, name, arg in dump.events:
+            ts = offset + (ticks - base) * scale
+            last = ts
+            if ph == 'B':
+                depth[track] += 1
+            elif ph == 'E':
+                if depth[track] == 0:
+                    dropped_ends += 1
+                    continue
+                depth[track] -= 1
+            ev = {"name": name, "ph": ph, "ts": round(ts, 3), "pid": 1, "tid": track}
+            if ph == 'C':
+                ev["args"] = {name: arg}
+            elif ph == 'i':
+                ev["s"] = "t"
+                if arg is not None:
+                    ev["args"] = {"arg": arg}
+            elif arg is not None:
+                ev["args"] = {"arg": arg}
+            out.append(ev)
+        # Next dump continues after this one
+        offset = last + 1.0
+    return out, dropped_ends
+
+
+def main():
+    ap = argparse.ArgumentParser(description="lib/trace UART capture to Chrome trace JSON")
+    ap.add_argument('capture', help="raw UART capture (binary)")
+    ap.add_argument('-o', '--output', help="JSON output file (default: stdout)")
+    ap.add_argument('--text', action='store_true',
+                    help="print 'ticks track type name arg' lines instead of JSON")
+    args = ap.parse_args()
+
+    with open(args.capture, 'rb') as f:
+        data = f.read()
+
+    try:
+        dumps, bad = parse(data)
+    except (ValueError, IndexError, struct.error) as e:
+        print(f"trace2json: {args.capture}: {e}", file=sys.stderr)
+        return 2
+
+    if not dumps:
+        print(f"trace2json: {args.capture}: no trace dump found", file=sys.stderr)
+        return 1
+
+    if args.text:
+        out = open(args.output, 'w') if args.output else sys.stdout
+        for dump in dumps:
+            for ticks, track, ph, name, arg in dump.events:
+                print(f"{ticks} {TRACKS[track]} {ph} {name}" +
+                      (f" {arg}" if arg is not None else ""), file=out)
+        if args.output:
+            out.close()
+    else:
+        events, dropped_ends = to_chrome(dumps)
+        doc = {"traceEvents": events, "displayTimeUnit": "ms"}
+        text = json.dumps(doc, indent=1)
+        if args.output:
+            with open(args.output, 'w') as f:
+                f.write(text + "\n")
+        else:
+            print(text)
+        if dropped_ends:
+            print(f"trace2json: {dropped_ends} end event(s) without begin dropped",
+                  file=sys.stderr)
+
+    for n, dump in enumerate(dumps):
+        state = "complete" if dump.complete else "INCOMPLETE"
+        print(f"trace2json: dump {n + 1}: {len(dump.events)} events at {dump.tick_hz} Hz, "
+              f"{dump.dropped} overwritten, {state}", file=sys.stderr)
+    if bad:
+        print(f"trace2json: {bad} corrupt frame(s) skipped", file=sys.stderr)
+    return 0 if all(d.complete for d in dumps) and not bad else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,388 @@
+#!/usr/bin/env python3
+#===============================================================================
+# Olimex iCE40HX8K-EVB RISC-V Platform
+# uartmux.py - Host Demultiplexer for lib/uartmux Channels
+#
+# Copyright (c) October 2025 Michael Wolak
+# Email: mikewolak@gmail.com, mike@epromfoundry.com
+#
+# NOT FOR COMMERCIAL USE
+# Educational and research purposes only
+#===============================================================================
+#
+# Attaches to a firmware built with lib/uartmux and splits the one UART into
+# its channels. The console is on this terminal; data, telemetry and trace
+# each get a pseudo-terminal with a fixed symlink:
+#
+#   uartmux.py /dev/ttyUSB0
+#     console     this terminal (Ctrl-] detaches and exits)
+#     data        /tmp/uartmux-data       fw_upload -p /tmp/uartmux-data ...
+#     telemetry   /tmp/uartmux-telemetry  cat /tmp/uartmux-telemetry
+#     trace       /tmp/uartmux-trace      cat /tmp/uartmux-trace > cap.bin
+#
+# Flow control is per channel: the host sends no more than the firmware's
+# advertised buffer space, and only returns credit for bytes a channel's
+# reader has taken, so a stalled reader stops its own channel only. Text
+# outside frames (firmware without uartmux, or a reset device) is shown on
+# the console and the host attaches again.
+#
+# Offline: split a capture of the firmware's output into channel files:
+#   uartmux.py --decode cap.bin --out DIR
+#
+# Wire format: top of lib/uartmux/uartmux.c.
+#===============================================================================
+
+import argparse
+import os
+import select
+import signal
+import struct
+import sys
+import termios
+import time
+import tty
+import zlib
+
+VERSION = 1
+CHANNELS = ('console', 'data', 'telemetry', 'trace')
+MTU = 64
+HOST_WINDOW = 1024          # Host receive space per channel
+
+END, ESC, ESC_END, ESC_ESC = 0xC0, 0xDB, 0xDC, 0xDD
+T_DATA, T_CREDIT, T_HELLO, T_BYE = 0, 1, 2, 3
+TYPE_NAMES = ('DATA', 'CREDIT', 'HELLO', 'BYE')
+
+DETACH_KEY = 0x1D           # Ctrl-]
+
+
+def frame(ftype, ch, payload=b''):
+    body = bytes([ftype << 4 | ch]) + payload
+    body += struct.pack('<I', zlib.crc32(body))
+    out = bytearray([END])
+    for b in body:
+        if b == END:
+            out += bytes([ESC, ESC_END])
+        elif b == ESC:
+            out += bytes([ESC, ESC_ESC])
+        else:
+            out.append(b)
+    out.append(END)
+    return bytes(out)
+
+
+def hello(window):
+    return frame(T_HELLO, 0, bytes([VERSION, len(CHANNELS)]) +
+                 b''.join(struct.pack('<H', window) for _ in CHANNELS))
+
+
+class Decoder:
+    """Splits the firmware's byte stream into text and frames (same rules
+    as the firmware's parser in lib/uartmux/uartmux.c)"""
+
+    def __init__(self):
+        self.in_frame = False
+        self.esc = False
+        self.body = bytearray()
+        self.bad = 0
+
+    def feed(self, data):
+        """Yields ('text', bytes) and ('frame', type, channel, payload)"""
+        text = bytearray()
+        for b in data:
+            if b == END:
+                if self.in_frame and self.body:
+                    if text:
+                        yield ('text', bytes(text))
+                        text = bytearray()
+                    f = self._finish()
+                    if f:
+                        yield f
+                    self.in_frame = False
+                else:
+                    self.in_frame = True
+                self.body = bytearray()
+                self.esc = False
+            elif not self.in_frame:
+                text.append(b)
+            elif self.esc:
+                self.esc = False
+                self.body.append(END if b == ESC_END else ESC if b == ESC_ESC else b)
+            elif b == ESC:
+                self.esc = True
+            elif len(self.body) < 1 + MTU + 4:
+                self.body.append(b)
+            else:
+                self.bad += 1
+                self.in_frame = False
+                self.body = bytearray()
+        if text:
+            yield ('text', bytes(text))
+
+    def _finish(self):
+        body = bytes(self.body)
+        if len(body) < 5 or zlib.crc32(body[:-4]) != struct.unpack('<I', body[-4:])[0]:
+            self.bad += 1
+            return None
+        return ('frame', body[0] >> 4, body[0] & 0x0F, body[1:-4])
+
+
+#-------------------------------------------------------------------------------
+# Offline decode
+#-------------------------------------------------------------------------------
+
+def decode(path, outdir):
+    with open(path, 'rb') as f:
+        data = f.read()
+    streams = [bytearray() for _ in CHANNELS]
+    counts = dict.fromkeys(TYPE_NAMES, 0)
+    dec = Decoder()
+    for ev in dec.feed(data):
+        if ev[0] == 'text':
+            streams[0] += ev[1]
+            continue
+        _, ftype, ch, payload = ev
+        if ftype == T_DATA and ch < len(CHANNELS):
+            streams[ch] += payload
+        if ftype < len(TYPE_NAMES):
+            counts[TYPE_NAMES[ftype]] += 1
+    os.makedirs(outdir, exist_ok=True)
+    for name, s in zip(CHANNELS, streams):
+        with open(os.path.join(outdir, name + '.bin'), 'wb') as f:
+            f.write(s)
+    print("uartmux: " + ", ".join(f"{k} {v}" for k, v in counts.items()) +
+          f", {dec.bad} bad frame(s)", file=sys.stderr)
+    return 1 if dec.bad else 0
+
+
+#-------------------------------------------------------------------------------
+# Live demultiplexer
+#-------------------------------------------------------------------------------
+
+def open_serial(port, baud):
+    fd = os.open(port, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    speed = getattr(termios, f'B{baud}')
+    attrs[4] = attrs[5] = speed
+    attrs[2] |= termios.CLOCAL | termios.CREAD
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+class Endpoint:
+    def __init__(self, name, rfd, wfd, path=None, keep=None):
+        self.name = name
+        self.rfd = rfd
+        self.wfd = wfd
+        self.path = path
+        self.keep = keep            # Slave end held open (no EIO on close)
+        self.pending = bytearray()  # Received, not yet written out
+
+
+def make_pty(name, prefix):
+    master, slave = os.openpty()
+    tty.setraw(slave)
+    os.set_blocking(master, False)
+    link = f"{prefix}-{name}"
+    try:
+        os.unlink(link)
+    except FileNotFoundError:
+        pass
+    os.symlink(os.ttyname(slave), link)
+    return Endpoint(name, master, master, link, slave)
+
+
+class Mux:
+    def __init__(self, fd, endpoints):
+        self.fd = fd
+        self.ep = endpoints
+        self.dec = Decoder()
+        self.attached = False
+        self.credit = [0] * len(CHANNELS)      # Host -> firmware
+        self.unacked = [0] * len(CHANNELS)     # Firmware -> host, delivered
+        self.hello_tries = 0
+        self.hello_time = 0.0
+
+    def send(self, data):
+        while data:
+            try:
+                n = os.write(self.fd, data)
+                data = data[n:]
+            except BlockingIOError:
+                select.select([], [self.fd], [], 1.0)
+
+    def attach(self):
+        self.attached = False
+        self.hello_tries = 3
+        self.hello_time = 0.0
+
+    def tick(self):
+        if not self.attached and self.hello_tries and time.time() - self.hello_time > 1.0:
+            self.hello_tries -= 1
+            self.hello_time = time.time()
+            self.send(hello(HOST_WINDOW))
+
+    def from_device(self, data):
+        for ev in self.dec.feed(data):
+            if ev[0] == 'text':
+                # Plain output: no uartmux firmware yet, or it was reset
+                self.ep[0].pending += ev[1]
+                if self.attached:
+                    note("device detached (plain output), attaching again")
+                    self.attach()
+                continue
+            _, ftype, ch, payload = ev
+            if ftype == T_HELLO and len(payload) >= 2 and payload[0] == VERSION:
+                n = min(payload[1], len(CHANNELS))
+                self.credit = [0] * len(CHANNELS)
+                for i in range(n):
+                    self.credit[i] = struct.unpack_from('<H', payload, 2 + 2 * i)[0]
+                self.unacked = [0] * len(CHANNELS)
+                if not self.attached:
+                    note("attached: " + ", ".join(f"{c} {w}" for c, w in zip(CHANNELS, self.credit)))
+                self.attached = True
+            elif ch >= len(CHANNELS):
+                continue
+            elif ftype == T_DATA:
+                self.ep[ch].pending += payload
+            elif ftype == T_CREDIT and len(payload) == 2:
+                self.credit[ch] += struct.unpack('<H', payload)[0]
+
+    def to_device(self, ch, data):
+        if not self.attached:
+            self.send(data)         # Plain firmware: pass keystrokes through
+            return
+        for i in range(0, len(data), MTU):
+            chunk = data[i:i + MTU]
+            self.send(frame(T_DATA, ch, chunk))
+            self.credit[ch] -= len(chunk)
+
+    def delivered(self, ch, n):
+        if not self.attached:
+            return
+        self.unacked[ch] += n
+        if self.unacked[ch] >= HOST_WINDOW // 2:
+            self.send(frame(T_CREDIT, ch, struct.pack('<H', self.unacked[ch])))
+            self.unacked[ch] = 0
+
+    def detach(self):
+        if self.attached:
+            self.send(frame(T_BYE, 0))
+
+
+def note(msg):
+    sys.stderr.write(f"\r\n[uartmux] {msg}\r\n")
+    sys.stderr.flush()
+
+
+def run(args):
+    fd = open_serial(args.port, args.baud)
+    eps = []
+    if args.console_pty or not sys.stdin.isatty():
+        eps.append(make_pty('console', args.prefix))
+    else:
+        eps.append(Endpoint('console', sys.stdin.fileno(), sys.stdout.fileno()))
+    for name in CHANNELS[1:]:
+        eps.append(make_pty(name, args.prefix))
+
+    mux = Mux(fd, eps)
+    saved = None
+    if eps[0].path is None:
+        saved = termios.tcgetattr(sys.stdin.fileno())
+        tty.setraw(sys.stdin.fileno())
+
+    for ep in eps:
+        if ep.path:
+            note(f"{ep.name:10s} {ep.path}")
+    if eps[0].path is None:
+        note("console on this terminal, Ctrl-] exits")
+
+    stop = []
+    signal.signal(signal.SIGTERM, lambda *a: stop.append(1))
+    mux.attach()
+    try:
+        while not stop:
+            mux.tick()
+            rl = [fd]
+            for ch, ep in enumerate(eps):
+                # Read a channel only while the firmware has room for it
+                if not mux.attached or mux.credit[ch] > 0:
+                    if mux.attached or ch == 0:
+                        rl.append(ep.rfd)
+            wl = [ep.wfd for ep in eps if ep.pending]
+            r, w, _ = select.select(rl, wl, [], 0.2)
+
+            if fd in r:
+                try:
+                    data = os.read(fd, 4096)
+                except BlockingIOError:
+                    data = None
+                except OSError as e:
+                    note(f"{args.port}: {e.strerror}")
+                    break
+                if data == b'':
+                    note(f"{args.port}: closed")
+                    break
+                if data:
+                    mux.from_device(data)
+
+            for ch, ep in enumerate(eps):
+                if ep.rfd in r:
+                    limit = mux.credit[ch] if mux.attached else 4096
+                    try:
+                        data = os.read(ep.rfd, max(1, min(limit, 4096)))
+                    except (BlockingIOError, OSError):
+                        data = b''
+                    if ch == 0 and ep.path is None and DETACH_KEY in data:
+                        stop.append(1)
+                        data = data[:data.index(DETACH_KEY)]
+                    if data:
+                        mux.to_device(ch, data)
+                if ep.pending and ep.wfd in w:
+                    try:
+                        n = os.write(ep.wfd, ep.pending)
+                    except BlockingIOError:
+                        n = 0
+                    del ep.pending[:n]
+                    mux.delivered(ch, n)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        try:
+            mux.detach()
+        except OSError:
+            pass
+        if saved:
+            termios.tcsetattr(sys.stdin.fileno(), termios.TCSADRAIN, saved)
+        for ep in eps:
+            if ep.path:
+                try:
+                    os.unlink(ep.path)
+                except FileNotFoundError:
+                    pass
+        note(f"detached ({mux.dec.bad} bad frame(s))")
+    return 0
+
+
+def main():
+    ap = argparse.ArgumentParser(description="lib/uartmux host demultiplexer")
+    ap.add_argument('port', nargs='?', help="serial port, e.g. /dev/ttyUSB0")
+    ap.add_argument('-b', '--baud', type=int, default=115200)
+    ap.add_argument('--prefix', default='/tmp/uartmux',
+                    help="channel symlinks are PREFIX-<channel> (default /tmp/uartmux)")
+    ap.add_argument('--console-pty', action='store_true',
+                    help="put the console on a pseudo-terminal too")
+    ap.add_argument('--decode', metavar='CAPTURE',
+                    help="split a capture of firmware output into channel files")
+    ap.add_argument('--out', default='.', help="directory for --decode output")
+    args = ap.parse_args()
+
+    if args.decode:
+        return decode(args.decode, args.out)
+    if not args.port:
+        ap.error("serial port required (or --decode CAPTURE)")
+    return run(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,336 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// elf_reloc.c - RV32 ELF Loader with Load-Time Relocation
+//
+// Resident apps (firmware APP=1) are linked at 0 with --emit-relocs and
+// --no-relax, so the final ELF still lists every place that holds an
+// address. Moving the image to `base` rewrites the absolute ones
+// (R_RISCV_32, HI20/LO12 lui pairs) that refer to symbols inside the image;
+// PC-relative references within the image stay valid as they are.
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "elf_reloc.h"
+
+// ELF constants (no <elf.h> on Windows/macOS)
+#define EI_CLASS        4
+#define EI_DATA         5
+#define ELFCLASS32      1
+#define ELFDATA2LSB     1
+#define EM_RISCV        243
+#define PT_LOAD         1
+#define SHT_SYMTAB      2
+#define SHT_RELA        4
+#define SHT_NOBITS      8
+#define SHF_ALLOC       0x2
+#define SHN_UNDEF       0
+#define SHN_LORESERVE   0xFF00
+
+// RISC-V relocation types
+#define R_RISCV_NONE            0
+#define R_RISCV_32              1
+#define R_RISCV_BRANCH          16
+#define R_RISCV_JAL             17
+#define R_RISCV_CALL            18
+#define R_RISCV_CALL_PLT        19
+#define R_RISCV_PCREL_HI20      23
+#define R_RISCV_PCREL_LO12_I    24
+#define R_RISCV_PCREL_LO12_S    25
+#define R_RISCV_HI20            26
+#define R_RISCV_LO12_I          27
+#define R_RISCV_LO12_S          28
+#define R_RISCV_ADD8            33
+#define R_RISCV_SUB64           40
+#define R_RISCV_ALIGN           43
+#define R_RISCV_RVC_BRANCH      44
+#define R_RISCV_RVC_JUMP        45
+#define R_RISCV_RELAX           51
+#define R_RISCV_SUB6            52
+#define R_RISCV_SET6            53
+#define R_RISCV_SET32           56
+#define R_RISCV_32_PCREL        57
+
+static uint16_t rd16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t rd32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void wr32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+typedef struct {
+    const uint8_t* elf;
+    size_t elf_size;
+    uint32_t phoff, shoff;
+    uint16_t phnum, shnum, phentsize, shentsize;
+    uint32_t lo;                    // Lowest load address (image offset 0)
+} elf_t;
+
+// Section header fields
+#define SH(e, i)        ((e)->elf + (e)->shoff + (size_t)(i) * (e)->shentsize)
+#define SH_TYPE(p)      rd32((p) + 4)
+#define SH_FLAGS(p)     rd32((p) + 8)
+#define SH_ADDR(p)      rd32((p) + 12)
+#define SH_OFFSET(p)    rd32((p) + 16)
+#define SH_SIZE(p)      rd32((p) + 20)
+#define SH_LINK(p)      rd32((p) + 24)
+#define SH_INFO(p)      rd32((p) + 28)
+
+// Program header fields
+#define PH(e, i)        ((e)->elf + (e)->phoff + (size_t)(i) * (e)->phentsize)
+#define PH_TYPE(p)      rd32((p) + 0)
+#define PH_OFFSET(p)    rd32((p) + 4)
+#define PH_VADDR(p)     rd32((p) + 8)
+#define PH_PADDR(p)     rd32((p) + 12)
+#define PH_FILESZ(p)    rd32((p) + 16)
+
+static bool in_file(const elf_t* e, uint32_t off, uint32_t len) {
+    return off <= e->elf_size && len <= e->elf_size - off;
+}
+
+// Image offset of a link-time (virtual) address, -1 if it is not loaded
+static long image_offset(const elf_t* e, uint32_t addr) {
+    for (int i = 0; i < e->phnum; i++) {
+        const uint8_t* ph = PH(e, i);
+        if (PH_TYPE(ph) != PT_LOAD) continue;
+        if (addr >= PH_VADDR(ph) && addr - PH_VADDR(ph) < PH_FILESZ(ph)) {
+            return (long)(PH_PADDR(ph) - e->lo + (addr - PH_VADDR(ph)));
+        }
+    }
+    return -1;
+}
+
+static bool is_pcrel(uint32_t type) {
+    switch (type) {
+        case R_RISCV_BRANCH:
+        case R_RISCV_JAL:
+        case R_RISCV_CALL:
+        case R_RISCV_CALL_PLT:
+        case R_RISCV_PCREL_HI20:
+        case R_RISCV_PCREL_LO12_I:
+        case R_RISCV_PCREL_LO12_S:
+        case R_RISCV_RVC_BRANCH:
+        case R_RISCV_RVC_JUMP:
+        case R_RISCV_32_PCREL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Relocations that never hold an address: label differences, relaxation hints
+static bool is_invariant(uint32_t type) {
+    return type == R_RISCV_NONE || type == R_RISCV_ALIGN || type == R_RISCV_RELAX ||
+           (type >= R_RISCV_ADD8 && type <= R_RISCV_SUB64) ||
+           (type >= R_RISCV_SUB6 && type <= R_RISCV_SET32);
+}
+
+// Apply one RELA section; returns the number of patched words, -1 on error
+static int apply_rela(const elf_t* e, const uint8_t* rela_sh, uint8_t* image,
+                      size_t image_size, uint32_t delta) {
+    const uint8_t* target_sh = SH(e, SH_INFO(rela_sh));
+    const uint8_t* sym_sh = SH(e, SH_LINK(rela_sh));
+    uint32_t sym_off = SH_OFFSET(sym_sh);
+    uint32_t sym_count = SH_SIZE(sym_sh) / 16;
+    uint32_t count = SH_SIZE(rela_sh) / 12;
+    int patched = 0;
+
+    if (!(SH_FLAGS(target_sh) & SHF_ALLOC) || SH_TYPE(target_sh) == SHT_NOBITS) {
+        return 0;   // Debug info and other sections that are not loaded
+    }
+    if (!in_file(e, SH_OFFSET(rela_sh), count * 12) || !in_file(e, sym_off, sym_count * 16)) {
+        printf("ERROR: Truncated relocation section\n");
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t* r = e->elf + SH_OFFSET(rela_sh) + i * 12;
+        uint32_t offset = rd32(r);
+        uint32_t type = rd32(r + 4) & 0xFF;
+        uint32_t sym = rd32(r + 4) >> 8;
+        int32_t addend = (int32_t)rd32(r + 8);
+
+        if (is_invariant(type)) continue;
+        if (sym >= sym_count) {
+            printf("ERROR: Bad symbol index %u\n", sym);
+            return -1;
+        }
+
+        const uint8_t* s = e->elf + sym_off + sym * 16;
+        uint16_t shndx = rd16(s + 14);
+        bool movable = shndx != SHN_UNDEF && shndx < SHN_LORESERVE &&
+                       shndx < e->shnum && (SH_FLAGS(SH(e, shndx)) & SHF_ALLOC);
+        uint32_t value = rd32(s + 4) + (uint32_t)addend;
+
+        if (is_pcrel(type)) {
+            // Moves with the image unless it points outside of it
+            if (movable || shndx == SHN_UNDEF) continue;
+            printf("ERROR: PC-relative reference at 0x%08X to absolute address 0x%08X\n",
+                   offset, value);
+            return -1;
+        }
+        if (!movable) continue;     // Absolute symbols (MMIO, sizes) stay put
+
+        long pos = image_offset(e, offset);
+        if (pos < 0 || (size_t)pos + 4 > image_size) {
+            printf("ERROR: Relocation at 0x%08X outside the loaded image\n", offset);
+            return -1;
+        }
+
+        uint8_t* p = image + pos;
+        uint32_t insn = rd32(p);
+        uint32_t moved = value + delta;
+        bool match;
+
+        switch (type) {
+            case R_RISCV_32:
+                match = insn == value;
+                insn = moved;
+                break;
+            case R_RISCV_HI20:
+                match = (insn & 0xFFFFF000) == ((value + 0x800) & 0xFFFFF000);
+                insn = (insn & 0x00000FFF) | ((moved + 0x800) & 0xFFFFF000);
+                break;
+            case R_RISCV_LO12_I:
+                match = (insn >> 20) == (value & 0xFFF);
+                insn = (insn & 0x000FFFFF) | ((moved & 0xFFF) << 20);
+                break;
+            case R_RISCV_LO12_S:
+                match = (((insn >> 25) << 5) | ((insn >> 7) & 0x1F)) == (value & 0xFFF);
+                insn = (insn & 0x01FFF07F) | (((moved >> 5) & 0x7F) << 25) | ((moved & 0x1F) << 7);
+                break;
+            default:
+                printf("ERROR: Unsupported relocation type %u at 0x%08X\n", type, offset);
+                return -1;
+        }
+
+        // The contents must still be what the relocation describes; a
+        // relaxed link (no --no-relax) rewrites instructions behind its back
+        if (!match) {
+            printf("ERROR: Relocation type %u at 0x%08X does not match the code "
+                             "(link with --no-relax, firmware APP=1)\n", type, offset);
+            return -1;
+        }
+        wr32(p, insn);
+        patched++;
+    }
+    return patched;
+}
+
+bool elf_is_elf(const uint8_t* data, size_t size) {
+    return size >= 4 && memcmp(data, "\177ELF", 4) == 0;
+}
+
+uint8_t* elf_load(const uint8_t* elf, size_t elf_size, uint32_t base,
+                  size_t* image_size, bool verbose) {
+    elf_t e;
+
+    if (elf_size < 52 || !elf_is_elf(elf, elf_size) ||
+        elf[EI_CLASS] != ELFCLASS32 || elf[EI_DATA] != ELFDATA2LSB) {
+        printf("ERROR: Not a little-endian 32-bit ELF file\n");
+        return NULL;
+    }
+    if (rd16(elf + 18) != EM_RISCV) {
+        printf("ERROR: ELF machine %u is not RISC-V\n", rd16(elf + 18));
+        return NULL;
+    }
+
+    e.elf = elf;
+    e.elf_size = elf_size;
+    e.phoff = rd32(elf + 28);
+    e.shoff = rd32(elf + 32);
+    e.phentsize = rd16(elf + 42);
+    e.phnum = rd16(elf + 44);
+    e.shentsize = rd16(elf + 46);
+    e.shnum = rd16(elf + 48);
+
+    if (e.phentsize < 32 || !in_file(&e, e.phoff, (uint32_t)e.phnum * e.phentsize) ||
+        (e.shnum && (e.shentsize < 40 || !in_file(&e, e.shoff, (uint32_t)e.shnum * e.shentsize)))) {
+        printf("ERROR: Truncated ELF headers\n");
+        return NULL;
+    }
+
+    // Extent of the loaded bytes (by load address, like objcopy -O binary)
+    uint32_t lo = 0xFFFFFFFF, hi = 0;
+    for (int i = 0; i < e.phnum; i++) {
+        const uint8_t* ph = PH(&e, i);
+        if (PH_TYPE(ph) != PT_LOAD || PH_FILESZ(ph) == 0) continue;
+        if (!in_file(&e, PH_OFFSET(ph), PH_FILESZ(ph))) {
+            printf("ERROR: Truncated ELF segment\n");
+            return NULL;
+        }
+        if (PH_PADDR(ph) < lo) lo = PH_PADDR(ph);
+        if (PH_PADDR(ph) + PH_FILESZ(ph) > hi) hi = PH_PADDR(ph) + PH_FILESZ(ph);
+    }
+    if (lo >= hi) {
+        printf("ERROR: ELF has no loadable data\n");
+        return NULL;
+    }
+    e.lo = lo;
+
+    uint8_t* image = calloc(1, hi - lo);
+    if (!image) {
+        printf("ERROR: Out of memory\n");
+        return NULL;
+    }
+    for (int i = 0; i < e.phnum; i++) {
+        const uint8_t* ph = PH(&e, i);
+        if (PH_TYPE(ph) != PT_LOAD || PH_FILESZ(ph) == 0) continue;
+        memcpy(image + (PH_PADDR(ph) - lo), elf + PH_OFFSET(ph), PH_FILESZ(ph));
+    }
+
+    uint32_t delta = base - lo;
+    int patched = 0, sections = 0;
+    if (delta != 0) {
+        for (int i = 0; i < e.shnum; i++) {
+            const uint8_t* sh = SH(&e, i);
+            if (SH_TYPE(sh) != SHT_RELA) continue;
+            if (SH_INFO(sh) >= e.shnum || SH_LINK(sh) >= e.shnum ||
+                SH_TYPE(SH(&e, SH_LINK(sh))) != SHT_SYMTAB) {
+                printf("ERROR: Bad relocation section %d\n", i);
+                free(image);
+                return NULL;
+            }
+            int n = apply_rela(&e, sh, image, hi - lo, delta);
+            if (n < 0) {
+                free(image);
+                return NULL;
+            }
+            if (n > 0) sections++;
+            patched += n;
+        }
+        if (sections == 0) {
+            printf("ERROR: ELF linked at 0x%08X has no relocations to move it to 0x%08X "
+                             "(build it with APP=1)\n", lo, base);
+            free(image);
+            return NULL;
+        }
+    }
+
+    if (verbose) {
+        printf("ELF: %u bytes loaded from 0x%08X", hi - lo, lo);
+        if (delta != 0) {
+            printf(", %d addresses relocated for 0x%08X", patched, base);
+        }
+        printf("\n");
+    }
+
+    *image_size = hi - lo;
+    return image;
+}
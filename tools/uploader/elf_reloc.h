@@ -0,0 +1,30 @@
+//==============================================================================
+// Olimex iCE40HX8K-EVB RISC-V Platform
+// elf_reloc.h - RV32 ELF Loader with Load-Time Relocation
+//
+// Copyright (c) October 2025 Michael Wolak
+// Email: mikewolak@gmail.com, mike@epromfoundry.com
+//
+// NOT FOR COMMERCIAL USE
+// Educational and research purposes only
+//==============================================================================
+
+#ifndef ELF_RELOC_H
+#define ELF_RELOC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// True when data starts with the ELF magic
+bool elf_is_elf(const uint8_t* data, size_t size);
+
+// Flatten the PT_LOAD segments of a little-endian RV32 ELF into one image
+// (as objcopy -O binary does) and move it to `base`. Non-zero bases need
+// the relocations kept by --emit-relocs (firmware APP=1 builds); linked-at-0
+// images are only flattened for base 0. Returns a malloc'd image, or NULL
+// after printing the reason.
+uint8_t* elf_load(const uint8_t* elf, size_t elf_size, uint32_t base,
+                  size_t* image_size, bool verbose);
+
+#endif // ELF_RELOC_H
@@ -17,6 +17,10 @@
 #include <stdbool.h>
 #include <time.h>
 
+#include "crc32.h"
+#include "elf_reloc.h"
+#include "app_image.h"
+
 // Platform-specific includes
 #ifdef _WIN32
     #include <windows.h>
@@ -50,7 +54,8 @@
 // Configuration
 #define DEFAULT_BAUD 115200
 #define CHUNK_SIZE 64
-#define MAX_PACKET_SIZE 524288  // 512KB to match SRAM size
+#define STREAM_BLOCK 1024       // --stream: bytes per write between progress updates
+#define MAX_PACKET_SIZE 0x7F000  // 508KB: SRAM below the bootloader's BSS/stack
 #define TIMEOUT_MS 2000
 
 // Color codes for terminal
@@ -93,31 +98,6 @@ typedef struct {
     #define INVALID_SERIAL -1
 #endif
 
-// CRC32 (PKZIP polynomial)
-static uint32_t crc32_table[256];
-static bool crc32_initialized = false;
-
-void init_crc32(void) {
-    if (crc32_initialized) return;
-
-    for (int i = 0; i < 256; i++) {
-        uint32_t crc = i;
-        for (int j = 0; j < 8; j++) {
-            crc = (crc >> 1) ^ (0xEDB88320 & (uint32_t)(-(int32_t)(crc & 1)));
-        }
-        crc32_table[i] = crc;
-    }
-    crc32_initialized = true;
-}
-
-uint32_t calculate_crc32(const uint8_t* data, size_t length) {
-    uint32_t crc = 0xFFFFFFFF;
-    for (size_t i = 0; i < length; i++) {
-        crc = (crc >> 8) ^ crc32_table[(crc ^ data[i]) & 0xFF];
-    }
-    return ~crc;
-}
-
 // Time utilities
 double get_time(void) {
 #ifdef _WIN32
@@ -159,7 +139,7 @@ void show_progress(progress_t* prog) {
 // Serial port functions
 #ifdef _WIN32
 
-serial_t serial_open(const char* port, int baud) {
+serial_t serial_open(const char* port, int baud, bool rtscts) {
     char full_port[32];
     snprintf(full_port, sizeof(full_port), "\\\\.\\%s", port);
 
@@ -175,7 +155,8 @@ serial_t serial_open(const char* port, int baud) {
     dcb.StopBits = ONESTOPBIT;
     dcb.Parity = NOPARITY;
     dcb.fDtrControl = DTR_CONTROL_DISABLE;
-    dcb.fRtsControl = RTS_CONTROL_DISABLE;
+    dcb.fOutxCtsFlow = rtscts ? TRUE : FALSE;
+    dcb.fRtsControl = rtscts ? RTS_CONTROL_HANDSHAKE : RTS_CONTROL_DISABLE;
     SetCommState(h, &dcb);
 
     COMMTIMEOUTS timeouts = {0};
@@ -223,7 +204,7 @@ void list_serial_ports(void) {
 
 #else  // Unix (Mac/Linux)
 
-serial_t serial_open(const char* port, int baud) {
+serial_t serial_open(const char* port, int baud, bool rtscts) {
     int fd = open(port, O_RDWR | O_NOCTTY);
     if (fd == -1) return INVALID_SERIAL;
 
@@ -248,7 +229,12 @@ serial_t serial_open(const char* port, int baud) {
     options.c_cflag &= ~CSTOPB;
     options.c_cflag &= ~CSIZE;
     options.c_cflag |= CS8;
-    options.c_cflag &= ~CRTSCTS;
+    // RTS/CTS: the kernel stops sending while the FPGA holds UART_RTS_N high
+    if (rtscts) {
+        options.c_cflag |= CRTSCTS;
+    } else {
+        options.c_cflag &= ~CRTSCTS;
+    }
 
     options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
     options.c_iflag &= ~(IXON | IXOFF | IXANY);
@@ -357,8 +343,19 @@ bool wait_for_ack(serial_t s, uint8_t expected_ack, bool verbose) {
     return false;
 }
 
-bool upload_firmware(serial_t s, const uint8_t* data, size_t size, bool verbose) {
-    init_crc32();
+// Write all of buf; with RTS/CTS a write can block or return short while
+// the FPGA holds the line off
+bool serial_write_all(serial_t s, const uint8_t* buf, size_t len) {
+    while (len > 0) {
+        int n = serial_write(s, buf, len);
+        if (n <= 0) return false;
+        buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool upload_firmware(serial_t s, const uint8_t* data, size_t size, bool verbose, bool stream) {
 
     progress_t prog = {
         .total_bytes = size + 5 + 5,  // Data + size + CRC
@@ -367,11 +364,12 @@ bool upload_firmware(serial_t s, const uint8_t* data, size_t size, bool verbose)
         .verbose = verbose
     };
 
-    uint32_t crc = calculate_crc32(data, size);
+    uint32_t crc = crc32(data, size);
     uint8_t expected_ack = 'A';
 
     if (!verbose) {
-        printf("\nUploading firmware (%zu bytes, CRC: 0x%08X)...\n", size, crc);
+        printf("\nUploading firmware (%zu bytes, CRC: 0x%08X%s)...\n", size, crc,
+               stream ? ", streaming" : "");
     }
 
     // Step 1: Send 'upload' command
@@ -400,9 +398,9 @@ bool upload_firmware(serial_t s, const uint8_t* data, size_t size, bool verbose)
         if (verbose) printf("Discarded %d bytes of echo\n", bytes_available);
     }
 
-    // Step 2: Send 'R' (Ready)
+    // Step 2: Send 'R' (Ready), or 'S' (Stream) for no per-chunk ACKs
     if (verbose) printf("\n[2] Ready Handshake\n");
-    if (!send_byte(s, 'R', verbose)) return false;
+    if (!send_byte(s, stream ? 'S' : 'R', verbose)) return false;
     if (!wait_for_ack(s, expected_ack++, verbose)) return false;
     prog.bytes_sent += 1;
     show_progress(&prog);
@@ -431,9 +429,26 @@ bool upload_firmware(serial_t s, const uint8_t* data, size_t size, bool verbose)
     prog.bytes_sent += 4;
     show_progress(&prog);
 
+    // Step 4 (stream): whole image, paced by CTS only. Blocks of
+    // STREAM_BLOCK bytes just keep the progress bar moving.
+    if (stream) {
+        if (verbose) printf("\n[4] Data Transfer (streaming, RTS/CTS)\n");
+        for (size_t i = 0; i < size; i += STREAM_BLOCK) {
+            size_t block = (i + STREAM_BLOCK > size) ? (size - i) : STREAM_BLOCK;
+            if (!serial_write_all(s, data + i, block)) return false;
+            prog.bytes_sent += block;
+            show_progress(&prog);
+        }
+        #ifdef _WIN32
+            FlushFileBuffers(s);
+        #else
+            tcdrain(s);
+        #endif
+    }
+
     // Step 4: Send data in chunks
-    if (verbose) printf("\n[4] Data Transfer\n");
-    for (size_t i = 0; i < size; i += CHUNK_SIZE) {
+    if (verbose && !stream) printf("\n[4] Data Transfer\n");
+    for (size_t i = 0; !stream && i < size; i += CHUNK_SIZE) {
         size_t chunk_size = (i + CHUNK_SIZE > size) ? (size - i) : CHUNK_SIZE;
 
         if (verbose) {
@@ -528,11 +543,15 @@ bool upload_firmware(serial_t s, const uint8_t* data, size_t size, bool verbose)
 // Main
 void print_usage(const char* prog) {
     printf("Firmware Uploader (%s)\n\n", PLATFORM);
-    printf("Usage: %s [options] <firmware.bin>\n\n", prog);
+    printf("Usage: %s [options] <firmware.bin|firmware.elf>\n\n", prog);
     printf("Options:\n");
     printf("  -p, --port <port>     Serial port (required)\n");
     printf("  -b, --baud <rate>     Baud rate (default: %d)\n", DEFAULT_BAUD);
     printf("  -v, --verbose         Verbose output (show all ACKs)\n");
+    printf("  -s, --stream          Stream the image with RTS/CTS, no chunk ACKs\n");
+    printf("                        (needs a UART_FLOW=1 bitstream, UART_RTS_N wired\n");
+    printf("                        to the adapter's CTS#)\n");
+    printf("  -a, --base <addr>     Relocate an APP=1 ELF for the launcher's load address\n");
     printf("  -l, --list            List available serial ports\n");
     printf("  -h, --help            Show this help\n\n");
     printf("Examples:\n");
@@ -541,6 +560,7 @@ void print_usage(const char* prog) {
     printf("  %s --list\n", prog);
 #else
     printf("  %s -p /dev/cu.usbserial-XXXXX firmware.bin\n", prog);
+    printf("  %s -p /dev/ttyUSB1 --base 0x42000 hexedit.app.elf\n", prog);
     printf("  %s --list\n", prog);
 #endif
 }
@@ -550,7 +570,10 @@ int main(int argc, char** argv) {
     const char* firmware = NULL;
     int baud = DEFAULT_BAUD;
     bool verbose = false;
+    bool stream = false;
     bool list_ports = false;
+    bool relocate = false;
+    uint32_t base = 0;
 
     // Parse arguments
     for (int i = 1; i < argc; i++) {
@@ -562,6 +585,12 @@ int main(int argc, char** argv) {
             baud = atoi(argv[i]);
         } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
             verbose = true;
+        } else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--stream") == 0) {
+            stream = true;
+        } else if (strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--base") == 0) {
+            if (++i >= argc) { print_usage(argv[0]); return 1; }
+            base = (uint32_t)strtoul(argv[i], NULL, 0);
+            relocate = true;
         } else if (strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--list") == 0) {
             list_ports = true;
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
@@ -593,14 +622,7 @@ int main(int argc, char** argv) {
     size_t size = ftell(f);
     fseek(f, 0, SEEK_SET);
 
-    if (size > MAX_PACKET_SIZE) {
-        printf(COLOR_RED "ERROR: Firmware too large (%zu bytes, max %d)" COLOR_RESET "\n",
-               size, MAX_PACKET_SIZE);
-        fclose(f);
-        return 1;
-    }
-
-    uint8_t* data = malloc(size);
+    uint8_t* data = malloc(size ? size : 1);
     if (!data) {
         printf(COLOR_RED "ERROR: Out of memory" COLOR_RESET "\n");
         fclose(f);
@@ -615,9 +637,38 @@ int main(int argc, char** argv) {
     }
     fclose(f);
 
+    // ELF: flatten the loadable segments, relocated for --base if given
+    if (elf_is_elf(data, size)) {
+        size_t image_size;
+        uint8_t* image = elf_load(data, size, base, &image_size, true);
+        free(data);
+        if (!image) {
+            return 1;
+        }
+        data = image;
+        size = image_size;
+
+        if (size >= sizeof(app_header_t) && ((const app_header_t*)data)->magic == APP_MAGIC) {
+            const app_header_t* hdr = (const app_header_t*)data;
+            printf("App image '%.*s', footprint 0x%08X - 0x%08X\n", APP_NAME_LEN, hdr->name,
+                   hdr->base, hdr->end);
+        }
+    } else if (relocate) {
+        printf(COLOR_RED "ERROR: --base needs the ELF (e.g. firmware/hexedit.app.elf)" COLOR_RESET "\n");
+        free(data);
+        return 1;
+    }
+
+    if (size > MAX_PACKET_SIZE) {
+        printf(COLOR_RED "ERROR: Firmware too large (%zu bytes, max %d)" COLOR_RESET "\n",
+               size, MAX_PACKET_SIZE);
+        free(data);
+        return 1;
+    }
+
     // Open serial port
-    printf("Connecting to %s at %d baud...\n", port, baud);
-    serial_t s = serial_open(port, baud);
+    printf("Connecting to %s at %d baud%s...\n", port, baud, stream ? " (RTS/CTS)" : "");
+    serial_t s = serial_open(port, baud, stream);
     if (s == INVALID_SERIAL) {
         printf(COLOR_RED "ERROR: Cannot open %s" COLOR_RESET "\n", port);
         free(data);
@@ -627,7 +678,7 @@ int main(int argc, char** argv) {
     printf(COLOR_GREEN "Connected." COLOR_RESET "\n");
 
     // Upload
-    bool success = upload_firmware(s, data, size, verbose);
+    bool success = upload_firmware(s, data, size, verbose, stream);
 
     // Cleanup
     serial_close(s);